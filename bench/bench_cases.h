@@ -0,0 +1,33 @@
+#ifndef BENCH_CASES_H
+#define BENCH_CASES_H
+
+#include <string>
+
+class BenchState;
+
+// Set from the command line by bench_main.cpp
+extern std::string bench_replay_path;  // --replay: recording for replay_headless (empty: a built-in route)
+
+// Actors
+void bench_actor_update_four_enemies(BenchState& state);
+
+// Physics & Tiles
+void bench_handle_fall_or_jump(BenchState& state);
+void bench_move_left(BenchState& state);
+void bench_move_right(BenchState& state);
+void bench_get_tile_at(BenchState& state);
+void bench_is_tile_solid(BenchState& state);
+
+// Audio
+void bench_synthesize_sound_cold(BenchState& state);
+void bench_synthesize_sound_cached(BenchState& state);
+
+// Graphics & Levels
+void bench_build_enemy_animation_sequence(BenchState& state);
+void bench_initialize_level_data(BenchState& state);
+
+// Macro: level loads and whole sessions
+void bench_load_tileset_cold(BenchState& state);
+void bench_replay_headless(BenchState& state);
+
+#endif // BENCH_CASES_H
@@ -0,0 +1,264 @@
+/**
+ * bench_harness.cpp - Timing loop, statistics and output for comic_bench
+ */
+
+#include "bench_harness.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+// Calibration stops growing a repetition past this many iterations
+constexpr uint64_t MAX_ITERATIONS_PER_REPETITION = uint64_t(1) << 30;
+
+BenchState::BenchState(const char* argument, uint64_t fixed_iterations, int warmup, int repetitions,
+                       double min_repetition_ms)
+    : argument_text(argument),
+      calibrate(fixed_iterations == 0),
+      warmup_repetitions(std::max(0, warmup)),
+      measured_repetitions(std::max(1, repetitions)),
+      min_repetition_ns(min_repetition_ms * 1e6),
+      phase(Phase::Starting),
+      iterations(fixed_iterations == 0 ? 1 : fixed_iterations),
+      remaining(0),
+      iteration_count(0),
+      warmups_done(0),
+      paused_ns(0.0),
+      skip_requested(false),
+      items_per_iteration(0.0) {
+    sample_ns.reserve(static_cast<size_t>(measured_repetitions));
+}
+
+bool BenchState::next_repetition() {
+    const Clock::time_point now = Clock::now();
+    if (skip_requested || phase == Phase::Done) {
+        return false;
+    }
+
+    if (phase == Phase::Starting) {
+        phase = calibrate ? Phase::Calibrating : Phase::WarmingUp;
+    } else {
+        const double elapsed_ns =
+            std::chrono::duration<double, std::nano>(now - repetition_start).count() - paused_ns;
+        switch (phase) {
+            case Phase::Calibrating:
+                if (elapsed_ns < min_repetition_ns && iterations < MAX_ITERATIONS_PER_REPETITION) {
+                    // Aim a little past the target, growing at most 10x per step
+                    const double scale = elapsed_ns > 0.0 ? 1.2 * min_repetition_ns / elapsed_ns : 10.0;
+                    const double grown = static_cast<double>(iterations) * std::min(10.0, std::max(2.0, scale));
+                    iterations = std::min(MAX_ITERATIONS_PER_REPETITION, static_cast<uint64_t>(grown));
+                } else {
+                    phase = Phase::WarmingUp;
+                }
+                break;
+            case Phase::WarmingUp:
+                ++warmups_done;
+                break;
+            case Phase::Measuring:
+                sample_ns.push_back(elapsed_ns / static_cast<double>(iterations));
+                if (static_cast<int>(sample_ns.size()) >= measured_repetitions) {
+                    phase = Phase::Done;
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (phase == Phase::WarmingUp && warmups_done >= warmup_repetitions) {
+        phase = Phase::Measuring;
+    }
+
+    remaining = iterations - 1;
+    ++iteration_count;
+    paused_ns = 0.0;
+    repetition_start = Clock::now();
+    return true;
+}
+
+void BenchState::pause_timing() {
+    pause_start = Clock::now();
+}
+
+void BenchState::resume_timing() {
+    paused_ns += std::chrono::duration<double, std::nano>(Clock::now() - pause_start).count();
+}
+
+void BenchState::skip(const std::string& reason) {
+    skip_requested = true;
+    skip_text = reason;
+    remaining = 0;
+}
+
+BenchResult summarize_bench(const std::string& name, BenchKind kind, const BenchState& state) {
+    BenchResult result;
+    result.name = name;
+    result.kind = kind;
+    result.label = state.get_label();
+    result.skipped = state.skipped();
+    result.skip_reason = state.skip_reason();
+    result.iterations = state.iterations_per_repetition();
+
+    std::vector<double> sorted = state.samples();
+    result.repetitions = sorted.size();
+    if (result.skipped || sorted.empty()) {
+        return result;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    const size_t count = sorted.size();
+    result.median_ns = count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    // Nearest rank: the smallest sample at or above 99% of the samples
+    const size_t p99_rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(count)));
+    result.p99_ns = sorted[std::max<size_t>(1, p99_rank) - 1];
+    result.min_ns = sorted.front();
+    result.max_ns = sorted.back();
+    result.mean_ns = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(count);
+    if (state.get_items_per_iteration() > 0.0 && result.median_ns > 0.0) {
+        result.items_per_second = state.get_items_per_iteration() * 1e9 / result.median_ns;
+    }
+    return result;
+}
+
+// ns as a short string in the largest unit that keeps it above 1
+static std::string format_duration(double ns) {
+    char text[32];
+    if (ns < 1e3) {
+        std::snprintf(text, sizeof(text), "%.2f ns", ns);
+    } else if (ns < 1e6) {
+        std::snprintf(text, sizeof(text), "%.2f us", ns / 1e3);
+    } else if (ns < 1e9) {
+        std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
+    } else {
+        std::snprintf(text, sizeof(text), "%.2f s", ns / 1e9);
+    }
+    return text;
+}
+
+void print_bench_header() {
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-40s %12s %12s %12s  %s", "Benchmark", "Median", "p99", "Min",
+                  "Iterations x repetitions");
+    std::cout << line << std::endl;
+    std::cout << std::string(std::char_traits<char>::length(line), '-') << std::endl;
+}
+
+void print_bench_result(const BenchResult& result) {
+    char line[256];
+    if (result.skipped) {
+        std::snprintf(line, sizeof(line), "%-40s skipped: %s", result.name.c_str(), result.skip_reason.c_str());
+        std::cout << line << std::endl;
+        return;
+    }
+    std::snprintf(line, sizeof(line), "%-40s %12s %12s %12s  %llu x %zu", result.name.c_str(),
+                  format_duration(result.median_ns).c_str(), format_duration(result.p99_ns).c_str(),
+                  format_duration(result.min_ns).c_str(), static_cast<unsigned long long>(result.iterations),
+                  result.repetitions);
+    std::cout << line;
+    if (result.items_per_second > 0.0) {
+        std::snprintf(line, sizeof(line), "  %.0f items/s", result.items_per_second);
+        std::cout << line;
+    }
+    if (!result.label.empty()) {
+        std::cout << "  (" << result.label << ")";
+    }
+    std::cout << std::endl;
+}
+
+static std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+static std::string json_number(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+bool write_bench_json(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write benchmark results: " << path << std::endl;
+        return false;
+    }
+
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::tm utc = {};
+#if defined(_WIN32)
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+#if defined(__clang__)
+    const std::string compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+#if defined(NDEBUG)
+    const char* build_type = "release";
+#else
+    const char* build_type = "debug";
+#endif
+
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": " << json_string(date) << ",\n";
+    out << "    \"compiler\": " << json_string(compiler) << ",\n";
+    out << "    \"build_type\": " << json_string(build_type) << ",\n";
+    out << "    \"time_unit\": \"ns\"\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {";
+        out << "\"name\": " << json_string(result.name);
+        out << ", \"kind\": " << (result.kind == BenchKind::Micro ? "\"micro\"" : "\"macro\"");
+        if (result.skipped) {
+            out << ", \"skipped\": " << json_string(result.skip_reason) << "}";
+            continue;
+        }
+        out << ", \"iterations\": " << result.iterations;
+        out << ", \"repetitions\": " << result.repetitions;
+        out << ", \"median_ns\": " << json_number(result.median_ns);
+        out << ", \"p99_ns\": " << json_number(result.p99_ns);
+        out << ", \"min_ns\": " << json_number(result.min_ns);
+        out << ", \"mean_ns\": " << json_number(result.mean_ns);
+        out << ", \"max_ns\": " << json_number(result.max_ns);
+        if (result.items_per_second > 0.0) {
+            out << ", \"items_per_second\": " << json_number(result.items_per_second);
+        }
+        if (!result.label.empty()) {
+            out << ", \"label\": " << json_string(result.label);
+        }
+        out << "}";
+    }
+    out << (results.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+    return static_cast<bool>(out);
+}
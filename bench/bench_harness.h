@@ -0,0 +1,152 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class BenchKind {
+    Micro,  // Sub-microsecond calls: iterations per repetition calibrated to --min-time
+    Macro   // Whole operations (a level load, a replay): one per repetition
+};
+
+class BenchState;
+
+// Benchmark case structure
+struct BenchCase {
+    std::string name;
+    void (*run)(BenchState&);
+    BenchKind kind;
+    const char* argument;  // Handed to run as state.argument() (e.g. a level name); may be null
+};
+
+/**
+ * BenchState - the timing loop of one benchmark
+ *
+ * The benchmark does its setup, then runs the operation under test once per
+ * keep_running() call that returns true:
+ *
+ *     while (state.keep_running()) {
+ *         bench_keep(get_tile_at(game, x, y));
+ *     }
+ *
+ * Iterations are grouped into repetitions. The clock is only read between
+ * repetitions (and around pause_timing/resume_timing), so the loop itself
+ * costs one decrement per iteration. Calibration and warmup repetitions are
+ * discarded; each measured repetition gives one ns-per-iteration sample.
+ */
+class BenchState {
+public:
+    BenchState(const char* argument, uint64_t fixed_iterations, int warmup, int repetitions,
+               double min_repetition_ms);
+
+    bool keep_running() {
+        if (remaining > 0) {
+            --remaining;
+            ++iteration_count;
+            return true;
+        }
+        return next_repetition();
+    }
+
+    // Exclude per-iteration setup or teardown (e.g. building a fresh system)
+    // from the measurement
+    void pause_timing();
+    void resume_timing();
+
+    // Mark the benchmark as not runnable here (no assets, no video); ends the loop
+    void skip(const std::string& reason);
+
+    // Items each iteration processes (e.g. ticks of a replay), for items/s
+    void set_items_per_iteration(double items) { items_per_iteration = items; }
+    // Extra detail printed after the result (e.g. the stage that was used)
+    void set_label(const std::string& text) { label = text; }
+
+    const char* argument() const { return argument_text; }
+    // Iterations run so far, counting calibration and warmup; handy for
+    // varying the input from one iteration to the next
+    uint64_t iteration() const { return iteration_count; }
+
+    bool skipped() const { return skip_requested; }
+    const std::string& skip_reason() const { return skip_text; }
+    const std::string& get_label() const { return label; }
+    double get_items_per_iteration() const { return items_per_iteration; }
+    uint64_t iterations_per_repetition() const { return iterations; }
+    // ns per iteration, one sample per measured repetition
+    const std::vector<double>& samples() const { return sample_ns; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Phase { Starting, Calibrating, WarmingUp, Measuring, Done };
+
+    bool next_repetition();
+
+    const char* argument_text;
+    bool calibrate;
+    int warmup_repetitions;
+    int measured_repetitions;
+    double min_repetition_ns;
+
+    Phase phase;
+    uint64_t iterations;      // Per repetition
+    uint64_t remaining;       // Left in the current repetition
+    uint64_t iteration_count;
+    int warmups_done;
+    Clock::time_point repetition_start;
+    Clock::time_point pause_start;
+    double paused_ns;
+    std::vector<double> sample_ns;
+
+    bool skip_requested;
+    std::string skip_text;
+    std::string label;
+    double items_per_iteration;
+};
+
+// Summary of one benchmark's samples (all in ns per iteration)
+struct BenchResult {
+    std::string name;
+    BenchKind kind = BenchKind::Micro;
+    std::string label;
+    bool skipped = false;
+    std::string skip_reason;
+    uint64_t iterations = 0;  // Per repetition
+    size_t repetitions = 0;
+    double median_ns = 0.0;
+    double p99_ns = 0.0;
+    double min_ns = 0.0;
+    double mean_ns = 0.0;
+    double max_ns = 0.0;
+    double items_per_second = 0.0;  // 0 unless the benchmark set items per iteration
+};
+
+BenchResult summarize_bench(const std::string& name, BenchKind kind, const BenchState& state);
+
+// Print a result as one table row (print_bench_header() first)
+void print_bench_header();
+void print_bench_result(const BenchResult& result);
+
+/**
+ * Write results as JSON: a "context" object (time, compiler, build type) and
+ * a "benchmarks" array with one object per result, times in ns per
+ * iteration. Returns false if the file cannot be written.
+ */
+bool write_bench_json(const std::string& path, const std::vector<BenchResult>& results);
+
+/**
+ * Keep the compiler from discarding a value the benchmark computes only to
+ * measure it (or from hoisting the computation out of the loop)
+ */
+template <typename T>
+inline void bench_keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* first_byte = reinterpret_cast<const volatile char*>(&value);
+    (void)*first_byte;
+#endif
+}
+
+#endif // BENCH_HARNESS_H
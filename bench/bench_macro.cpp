@@ -0,0 +1,118 @@
+/**
+ * bench_macro.cpp - Macrobenchmarks: level loads and whole sessions
+ */
+
+#include "bench_harness.h"
+#include "bench_cases.h"
+#include "../include/batch_runner.h"
+#include "../include/graphics.h"
+#include "../include/replay.h"
+#include <SDL2/SDL.h>
+#include <memory>
+
+// Ticks of the built-in replay route (about 18 minutes of play)
+constexpr uint64_t BENCH_REPLAY_TICKS = 10000;
+
+/**
+ * Hidden window and software renderer for the tileset loads, created on
+ * first use and kept for the rest of the run (as the tests' graphics
+ * fixtures do, so this works without a display server's GPU)
+ */
+static SDL_Renderer* bench_renderer(std::string* error) {
+    static SDL_Window* window = nullptr;
+    static SDL_Renderer* renderer = nullptr;
+    static std::string init_error;
+    static bool attempted = false;
+    if (!attempted) {
+        attempted = true;
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+            init_error = std::string("SDL video init failed: ") + SDL_GetError();
+        } else {
+            window = SDL_CreateWindow("comic_bench", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 64, 64,
+                                      SDL_WINDOW_HIDDEN);
+            renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : nullptr;
+            if (!renderer) {
+                init_error = std::string("SDL renderer creation failed: ") + SDL_GetError();
+            }
+        }
+    }
+    *error = init_error;
+    return renderer;
+}
+
+void bench_load_tileset_cold(BenchState& state) {
+    std::string error;
+    SDL_Renderer* renderer = bench_renderer(&error);
+    if (!renderer) {
+        state.skip(error);
+        return;
+    }
+    const std::string level_name = state.argument();
+
+    // A fresh GraphicsSystem per load, so nothing is cached but what the OS
+    // keeps of the files; building and tearing it down is not timed
+    std::unique_ptr<GraphicsSystem> graphics;
+    bool loaded = true;
+    while (loaded && state.keep_running()) {
+        state.pause_timing();
+        graphics.reset();
+        graphics = std::make_unique<GraphicsSystem>(renderer);
+        const bool initialized = graphics->initialize();
+        state.resume_timing();
+        if (!initialized) {
+            state.skip("graphics initialize failed");
+            break;
+        }
+        loaded = graphics->load_tileset(level_name);
+    }
+    if (!loaded) {
+        state.skip("tileset not found (extract the assets, or pass --root)");
+    }
+    state.pause_timing();
+    graphics.reset();
+    state.resume_timing();
+}
+
+// Pace right and left, jumping now and then and firing on every other tick
+static uint8_t bench_route_keys(uint64_t tick) {
+    uint8_t keys = (tick / 64) % 2 == 0 ? INPUT_RIGHT : INPUT_LEFT;
+    if (tick % 20 < 2) {
+        keys |= INPUT_JUMP;
+    }
+    if (tick % 2 == 1) {
+        keys |= INPUT_FIRE;
+    }
+    return keys;
+}
+
+void bench_replay_headless(BenchState& state) {
+    BatchJob job;
+    if (!bench_replay_path.empty()) {
+        ReplayRecording recording;
+        if (!recording.load(bench_replay_path)) {
+            state.skip("cannot load replay " + bench_replay_path);
+            return;
+        }
+        job.keys = recording.keys;
+        job.debug_mode = recording.debug_mode;
+        state.set_label(bench_replay_path);
+    } else {
+        // With full firepower (debug mode) the game lasts the whole route
+        for (uint64_t tick = 0; tick < BENCH_REPLAY_TICKS; ++tick) {
+            job.keys.push_back(bench_route_keys(tick));
+        }
+        job.debug_mode = true;
+        state.set_label("built-in route");
+    }
+    job.tick_count = job.keys.size();
+
+    uint64_t ticks_run = 0;
+    while (state.keep_running()) {
+        const BatchResult result = BatchRunner::run_job(job);
+        ticks_run = result.ticks_run;
+        bench_keep(result.checksum);
+    }
+    state.set_items_per_iteration(static_cast<double>(ticks_run));
+    state.set_label(state.get_label() + ", " + std::to_string(ticks_run) + " ticks");
+}
@@ -0,0 +1,171 @@
+#include "bench_harness.h"
+#include "bench_cases.h"
+#include "../include/level_loader.h"
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+std::string bench_replay_path;
+
+static const std::vector<BenchCase>& bench_registry() {
+    static const std::vector<BenchCase> benches = {
+        // Actors
+        {"actors/update_four_enemies", bench_actor_update_four_enemies, BenchKind::Micro, nullptr},
+
+        // Physics & Tiles
+        {"physics/handle_fall_or_jump", bench_handle_fall_or_jump, BenchKind::Micro, nullptr},
+        {"physics/move_left", bench_move_left, BenchKind::Micro, nullptr},
+        {"physics/move_right", bench_move_right, BenchKind::Micro, nullptr},
+        {"tiles/get_tile_at", bench_get_tile_at, BenchKind::Micro, nullptr},
+        {"tiles/is_tile_solid", bench_is_tile_solid, BenchKind::Micro, nullptr},
+
+        // Audio
+        {"audio/synthesize_sound_cold", bench_synthesize_sound_cold, BenchKind::Micro, nullptr},
+        {"audio/synthesize_sound_cached", bench_synthesize_sound_cached, BenchKind::Micro, nullptr},
+
+        // Graphics & Levels
+        {"graphics/build_enemy_animation_sequence", bench_build_enemy_animation_sequence, BenchKind::Micro, nullptr},
+        {"levels/initialize_level_data", bench_initialize_level_data, BenchKind::Micro, nullptr},
+
+        // Macro: a cold tileset load per level, then a whole headless session
+        {"macro/load_tileset_cold/lake", bench_load_tileset_cold, BenchKind::Macro, "lake"},
+        {"macro/load_tileset_cold/forest", bench_load_tileset_cold, BenchKind::Macro, "forest"},
+        {"macro/load_tileset_cold/space", bench_load_tileset_cold, BenchKind::Macro, "space"},
+        {"macro/load_tileset_cold/base", bench_load_tileset_cold, BenchKind::Macro, "base"},
+        {"macro/load_tileset_cold/cave", bench_load_tileset_cold, BenchKind::Macro, "cave"},
+        {"macro/load_tileset_cold/shed", bench_load_tileset_cold, BenchKind::Macro, "shed"},
+        {"macro/load_tileset_cold/castle", bench_load_tileset_cold, BenchKind::Macro, "castle"},
+        {"macro/load_tileset_cold/comp", bench_load_tileset_cold, BenchKind::Macro, "comp"},
+        {"macro/replay_headless", bench_replay_headless, BenchKind::Macro, nullptr},
+    };
+    return benches;
+}
+
+// Repetition defaults; --warmup/--repetitions override both kinds
+constexpr int MICRO_WARMUP = 3;
+constexpr int MICRO_REPETITIONS = 100;
+constexpr int MACRO_WARMUP = 1;
+constexpr int MACRO_REPETITIONS = 15;
+constexpr double DEFAULT_MIN_TIME_MS = 1.0;
+
+static bool matches_filter(const std::string& name, const std::string& filter) {
+    if (filter.empty()) {
+        return true;
+    }
+    return name.find(filter) != std::string::npos;
+}
+
+static void print_usage(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [--list] [--filter NAME] [--warmup N] [--repetitions N] [--min-time MS]"
+                 " [--json FILE] [--root DIR] [--replay FILE]"
+              << std::endl;
+    std::cout << "  --min-time MS   Shortest microbenchmark repetition (default " << DEFAULT_MIN_TIME_MS << ")"
+              << std::endl;
+    std::cout << "  --root DIR      Run from DIR, the directory holding assets/ (default: current directory)"
+              << std::endl;
+    std::cout << "  --replay FILE   Recording for macro/replay_headless (default: a built-in route)" << std::endl;
+}
+
+// Parse a non-negative count option value
+static bool parse_count(const char* text, int* value) {
+    char* end = nullptr;
+    const long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 0 || parsed > 1000000) {
+        return false;
+    }
+    *value = static_cast<int>(parsed);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string json_path;
+    bool list_only = false;
+    int warmup = -1;
+    int repetitions = -1;
+    double min_time_ms = DEFAULT_MIN_TIME_MS;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--list") {
+            list_only = true;
+        } else if (arg == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(std::string("--filter=").size());
+        } else if (arg == "--warmup" && has_value) {
+            if (!parse_count(argv[++i], &warmup)) {
+                std::cerr << "--warmup requires a non-negative count" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--repetitions" && has_value) {
+            if (!parse_count(argv[++i], &repetitions) || repetitions == 0) {
+                std::cerr << "--repetitions requires a positive count" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--min-time" && has_value) {
+            char* end = nullptr;
+            min_time_ms = std::strtod(argv[++i], &end);
+            if (end == argv[i] || *end != '\0' || min_time_ms < 0.0) {
+                std::cerr << "--min-time requires a duration in milliseconds" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (arg == "--root" && has_value) {
+            std::error_code error;
+            std::filesystem::current_path(argv[++i], error);
+            if (error) {
+                std::cerr << "Cannot change to --root directory " << argv[i] << ": " << error.message() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--replay" && has_value) {
+            bench_replay_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown argument or missing value: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (list_only) {
+        for (const auto& bench : bench_registry()) {
+            std::cout << bench.name << std::endl;
+        }
+        return 0;
+    }
+
+    initialize_level_data();
+
+    std::vector<BenchResult> results;
+    print_bench_header();
+    for (const auto& bench : bench_registry()) {
+        if (!matches_filter(bench.name, filter)) {
+            continue;
+        }
+        const bool micro = bench.kind == BenchKind::Micro;
+        BenchState state(bench.argument, micro ? 0 : 1,
+                         warmup >= 0 ? warmup : (micro ? MICRO_WARMUP : MACRO_WARMUP),
+                         repetitions > 0 ? repetitions : (micro ? MICRO_REPETITIONS : MACRO_REPETITIONS),
+                         min_time_ms);
+        bench.run(state);
+        results.push_back(summarize_bench(bench.name, bench.kind, state));
+        print_bench_result(results.back());
+    }
+
+    if (results.empty()) {
+        std::cerr << "No benchmarks match filter: " << filter << std::endl;
+        return 1;
+    }
+    if (!json_path.empty() && !write_bench_json(json_path, results)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+/**
+ * bench_micro.cpp - Microbenchmarks of the per-tick hot paths
+ *
+ * Each benchmark runs on the real compiled-in stages with no graphics or
+ * audio, and varies its input from one iteration to the next so the numbers
+ * are not those of one lucky tile or branch.
+ */
+
+#include "bench_harness.h"
+#include "bench_cases.h"
+#include "../include/audio.h"
+#include "../include/game_context.h"
+#include "../include/gameplay.h"
+#include "../include/graphics.h"
+#include "../include/level_loader.h"
+#include "../include/physics.h"
+#include "../include/snapshot.h"
+#include <memory>
+#include <vector>
+
+// Put a game on a stage the way a level load does, with enemies set up
+static void load_bench_stage(GameContext& game, uint8_t level_number, uint8_t stage_number) {
+    game.actors.initialize();
+    game.current_level_number = level_number;
+    game.current_stage_number = stage_number;
+    game.source_door_level_number = -1;
+    load_new_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
+}
+
+// One game per stage of every level, loaded once and shared by the benchmarks
+static const std::vector<std::unique_ptr<GameContext>>& bench_stages() {
+    static std::vector<std::unique_ptr<GameContext>> stages;
+    if (stages.empty()) {
+        for (uint8_t level = 0; level < 8; ++level) {
+            for (uint8_t stage = 0; stage < 3; ++stage) {
+                stages.push_back(std::make_unique<GameContext>());
+                load_bench_stage(*stages.back(), level, stage);
+            }
+        }
+    }
+    return stages;
+}
+
+// A stage per 256 iterations, like a player that stays put for a while
+static GameContext& bench_stage_for(uint64_t iteration) {
+    const auto& stages = bench_stages();
+    return *stages[(iteration >> 8) % stages.size()];
+}
+
+// Positions that walk the stage away from its edges (which would load the
+// next stage) and above the pit line (which would kill Comic)
+static int bench_x(uint64_t iteration) {
+    return 2 + static_cast<int>((iteration * 37) % (MAP_WIDTH - 6));
+}
+
+static int bench_y(uint64_t iteration) {
+    return static_cast<int>((iteration * 5) % (PLAYFIELD_HEIGHT - 5));
+}
+
+static int count_spawned_enemies(const GameContext& game) {
+    int spawned = 0;
+    for (uint8_t state : game.actors.get_enemies().state) {
+        spawned += state == ENEMY_STATE_SPAWNED ? 1 : 0;
+    }
+    return spawned;
+}
+
+// Let Comic stand still until all four enemy slots have
+// spawned; false if they do not within a couple of thousand ticks
+static bool spawn_all_enemies(GameContext& game) {
+    for (int tick = 0; tick < 2000; ++tick) {
+        if (count_spawned_enemies(game) == MAX_NUM_ENEMIES) {
+            return true;
+        }
+        game.comic_hp = MAX_HP;
+        game.actors.update(game, game.comic_x, game.comic_y, game.comic_facing, game.current_tiles(),
+                           game.camera_x);
+    }
+    return false;
+}
+
+void bench_actor_update_four_enemies(BenchState& state) {
+    // The first stage that uses all four enemy slots and gets them spawned
+    GameContext game;
+    bool found = false;
+    for (uint8_t level = 0; level < 8 && !found; ++level) {
+        for (uint8_t stage = 0; stage < 3 && !found; ++stage) {
+            const stage_t& descriptor = level_data_pointers[level]->stages[stage];
+            bool all_used = true;
+            for (const enemy_record_t& record : descriptor.enemies) {
+                all_used = all_used && record.behavior != ENEMY_BEHAVIOR_UNUSED;
+            }
+            if (all_used) {
+                load_bench_stage(game, level, stage);
+                found = spawn_all_enemies(game);
+            }
+        }
+    }
+    if (!found) {
+        state.skip("no stage gets all four enemy slots spawned");
+        return;
+    }
+    const uint8_t* tiles = game.current_tiles();
+    GameSnapshot all_spawned;
+    capture_snapshot(game, all_spawned);
+    state.set_label("level " + std::to_string(game.current_level_number) + " stage " +
+                    std::to_string(game.current_stage_number));
+
+    while (state.keep_running()) {
+        // Put the four back when one dies, despawns or hurts Comic
+        if (count_spawned_enemies(game) < MAX_NUM_ENEMIES || game.comic_hp < MAX_HP || game.player_is_dying) {
+            state.pause_timing();
+            restore_snapshot(game, all_spawned);
+            state.resume_timing();
+        }
+        game.actors.update(game, game.comic_x, game.comic_y, game.comic_facing, tiles, game.camera_x);
+    }
+}
+
+void bench_handle_fall_or_jump(BenchState& state) {
+    bench_stages();
+    while (state.keep_running()) {
+        const uint64_t i = state.iteration();
+        GameContext& game = bench_stage_for(i);
+        // Mostly airborne, rising and falling, steering now and then
+        game.player_is_dying = 0;
+        game.comic_x = bench_x(i);
+        game.comic_y = bench_y(i);
+        game.comic_y_vel = static_cast<int8_t>(static_cast<int>(i % 16) - 8);
+        game.comic_x_momentum = static_cast<int8_t>(static_cast<int>(i % 11) - 5);
+        game.comic_is_falling_or_jumping = (i & 3) != 0;
+        game.comic_jump_counter = static_cast<uint8_t>(i % 5);
+        game.key_state_jump = static_cast<uint8_t>(i & 1);
+        handle_fall_or_jump(game);
+        bench_keep(game.comic_y);
+    }
+}
+
+void bench_move_left(BenchState& state) {
+    bench_stages();
+    while (state.keep_running()) {
+        const uint64_t i = state.iteration();
+        GameContext& game = bench_stage_for(i);
+        game.comic_x = bench_x(i);
+        game.comic_y = bench_y(i);
+        bench_keep(move_left(game));
+    }
+}
+
+void bench_move_right(BenchState& state) {
+    bench_stages();
+    while (state.keep_running()) {
+        const uint64_t i = state.iteration();
+        GameContext& game = bench_stage_for(i);
+        game.comic_x = bench_x(i);
+        game.comic_y = bench_y(i);
+        bench_keep(move_right(game));
+    }
+}
+
+void bench_get_tile_at(BenchState& state) {
+    bench_stages();
+    while (state.keep_running()) {
+        const uint64_t i = state.iteration();
+        const GameContext& game = bench_stage_for(i);
+        bench_keep(get_tile_at(game, static_cast<uint8_t>(i * 37), static_cast<uint8_t>((i * 5) % MAP_HEIGHT)));
+    }
+}
+
+void bench_is_tile_solid(BenchState& state) {
+    bench_stages();
+    while (state.keep_running()) {
+        const uint64_t i = state.iteration();
+        const GameContext& game = bench_stage_for(i);
+        bench_keep(is_tile_solid(game, static_cast<uint8_t>(i * 13)));
+    }
+}
+
+// Every sound with a waveform, in turn
+static GameSound bench_sound(uint64_t iteration) {
+    constexpr uint64_t SOUNDS = static_cast<uint64_t>(GameSound::COUNT) - 1;  // Not UNUSED_0
+    return static_cast<GameSound>(1 + iteration % SOUNDS);
+}
+
+void bench_synthesize_sound_cold(BenchState& state) {
+    if (synthesize_game_sound(GameSound::FIRE, true) == 0) {
+        state.skip("built without SDL2_mixer");
+        return;
+    }
+    while (state.keep_running()) {
+        bench_keep(synthesize_game_sound(bench_sound(state.iteration()), true));
+    }
+}
+
+void bench_synthesize_sound_cached(BenchState& state) {
+    if (synthesize_game_sound(GameSound::FIRE, false) == 0) {
+        state.skip("built without SDL2_mixer");
+        return;
+    }
+    while (state.keep_running()) {
+        bench_keep(synthesize_game_sound(bench_sound(state.iteration()), false));
+    }
+}
+
+void bench_build_enemy_animation_sequence(BenchState& state) {
+    while (state.keep_running()) {
+        const uint64_t i = state.iteration();
+        const uint8_t frames = static_cast<uint8_t>(1 + i % 5);
+        const uint8_t type = (i & 8) ? ENEMY_ANIMATION_ALTERNATE : ENEMY_ANIMATION_LOOP;
+        bench_keep(build_enemy_animation_sequence(frames, type));
+    }
+}
+
+void bench_initialize_level_data(BenchState& state) {
+    while (state.keep_running()) {
+        initialize_level_data();
+    }
+}
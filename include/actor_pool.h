@@ -0,0 +1,81 @@
+#ifndef ACTOR_POOL_H
+#define ACTOR_POOL_H
+
+#include <cstdint>
+#include <vector>
+#include "graphics.h"
+#include "level.h"
+#include "physics.h"
+
+/**
+ * EnemyPool - All enemy slots, stored field by field
+ *
+ * The fields the per-tick passes read and write (position, velocity,
+ * animation, behavior, state, facing, restraint) are parallel arrays
+ * indexed by slot, so a pass over many enemies walks a few short byte
+ * arrays. The sprite references are only needed to set a slot up and to
+ * draw it, and are kept apart from them.
+ */
+struct EnemyPool {
+    /* Hot: simulated every tick */
+    std::vector<uint8_t> y;                          /* Y position (game units) */
+    std::vector<uint8_t> x;                          /* X position (game units) */
+    std::vector<int8_t> x_vel;                       /* Horizontal velocity */
+    std::vector<int8_t> y_vel;                       /* Vertical velocity */
+    std::vector<uint8_t> spawn_timer_and_animation;  /* Spawn timer when despawned, animation frame when spawned */
+    std::vector<uint8_t> num_animation_frames;       /* Cached from the sprite for fast access */
+    std::vector<uint8_t> behavior;                   /* AI behavior type (see ENEMY_BEHAVIOR_*) */
+    std::vector<uint8_t> state;                      /* Current state (ENEMY_STATE_*) */
+    std::vector<uint8_t> facing;                     /* 0=left, 5=right (in units of animation frames) */
+    std::vector<uint8_t> restraint;                  /* Movement throttle (ENEMY_RESTRAINT_*) */
+
+    /* Cold: sprite metadata and loaded texture frames */
+    std::vector<const shp_t*> sprite_descriptor;
+    std::vector<SpriteAnimationData*> animation_data;
+
+    int size() const { return static_cast<int>(state.size()); }
+
+    /* Change the number of slots; new slots are zeroed with no sprite */
+    void resize(int count);
+};
+
+/* Broadphase cells: 4×4 game units over the 256×20 map */
+constexpr int ACTOR_GRID_CELL_SIZE = 4;
+constexpr int ACTOR_GRID_COLUMNS = MAP_WIDTH / ACTOR_GRID_CELL_SIZE;
+constexpr int ACTOR_GRID_ROWS = PLAYFIELD_HEIGHT / ACTOR_GRID_CELL_SIZE;
+constexpr int ACTOR_GRID_CELLS = ACTOR_GRID_COLUMNS * ACTOR_GRID_ROWS;
+
+/**
+ * ActorGrid - Uniform grid of actor slots for collision broadphase
+ *
+ * Rebuilt from scratch whenever positions change (clearing it is one small
+ * array), then asked which slots sit in the cell of a point. Points below
+ * the map share the bottom row, so every position has a cell and a query
+ * for a point never misses a slot inserted at that point; callers still
+ * run their exact overlap test on what comes back.
+ */
+class ActorGrid {
+public:
+    /* Empty every cell and make room for slots 0..num_slots-1 */
+    void clear(int num_slots);
+
+    void insert(int slot, uint8_t x, uint8_t y);
+
+    static int cell_of(uint8_t x, uint8_t y) {
+        int row = y / ACTOR_GRID_CELL_SIZE;
+        if (row >= ACTOR_GRID_ROWS) {
+            row = ACTOR_GRID_ROWS - 1;
+        }
+        return row * ACTOR_GRID_COLUMNS + x / ACTOR_GRID_CELL_SIZE;
+    }
+
+    /* Walk the slots in a cell: for (s = first(c); s >= 0; s = next(s)) */
+    int first(int cell) const { return heads[cell]; }
+    int next(int slot) const { return links[slot]; }
+
+private:
+    int16_t heads[ACTOR_GRID_CELLS] = {};
+    std::vector<int16_t> links;
+};
+
+#endif /* ACTOR_POOL_H */
@@ -3,10 +3,13 @@
 
 #include <cstdint>
 #include <vector>
+#include "actor_pool.h"
 #include "graphics.h"
 #include "level.h"
 #include "physics.h"
 
+struct GameContext;
+
 /* Enemy state constants */
 constexpr uint8_t ENEMY_STATE_DESPAWNED = 0;      /* Not yet spawned */
 constexpr uint8_t ENEMY_STATE_SPAWNED = 1;        /* Active and moving */
@@ -62,28 +65,75 @@ struct fireball_t {
 };
 
 /**
- * enemy_t - Enemy state
+ * enemy_snapshot_t - The simulated state of one enemy slot
  *
- * Tracks position, velocity, animation, and behavior state of a single enemy.
+ * The sprite metadata is kept as its index into the level's shp table
+ * (ENEMY_SNAPSHOT_NO_SPRITE when the slot has none); textures are looked up
+ * again on restore.
  */
-struct enemy_t {
-    uint8_t y;                           /* Y position (game units) */
-    uint8_t x;                           /* X position (game units) */
-    int8_t x_vel;                        /* Horizontal velocity */
-    int8_t y_vel;                        /* Vertical velocity */
+constexpr uint8_t ENEMY_SNAPSHOT_NO_SPRITE = 0xFF;
 
-    /* Dual-use field: spawn timer when despawned, animation frame when spawned */
+struct enemy_snapshot_t {
+    uint8_t y;
+    uint8_t x;
+    int8_t x_vel;
+    int8_t y_vel;
     uint8_t spawn_timer_and_animation;
+    uint8_t num_animation_frames;
+    uint8_t behavior;
+    uint8_t state;
+    uint8_t facing;
+    uint8_t restraint;
+    uint8_t shp_index;
+};
 
-    uint8_t num_animation_frames;        /* Cached from sprite_descriptor for fast access */
-    uint8_t behavior;                    /* AI behavior type (see ENEMY_BEHAVIOR_*) */
-    uint8_t state;                       /* Current state (ENEMY_STATE_*) */
-    uint8_t facing;                      /* 0=left, 5=right (in units of animation frames) */
-    uint8_t restraint;                   /* Movement throttle (ENEMY_RESTRAINT_*) */
+/**
+ * ActorRenderOffsets - per-actor pixel nudges for one rendered frame
+ *
+ * Filled by RenderInterpolator (frame_pacer.h) to draw enemies and
+ * fireballs between their tick positions; zero offsets draw them snapped.
+ */
+struct ActorRenderOffsets {
+    int enemy_dx[MAX_NUM_ENEMIES] = {};
+    int enemy_dy[MAX_NUM_ENEMIES] = {};
+    int fireball_dx[MAX_NUM_FIREBALLS] = {};
+    int fireball_dy[MAX_NUM_FIREBALLS] = {};
+};
 
-    /* References to sprite metadata and textures */
-    const shp_t* sprite_descriptor;      /* Source sprite metadata (horizontal, animation type, etc.) */
-    SpriteAnimationData* animation_data; /* Loaded texture frames */
+/**
+ * ActorSnapshot - Everything ActorSystem carries from tick to tick
+ *
+ * Plain bytes (no pointers), so snapshots of two ticks can be compared and
+ * delta-compressed byte by byte. It holds the original game's slots,
+ * MAX_NUM_ENEMIES enemies and MAX_NUM_FIREBALLS fireballs, so a larger pool
+ * cannot be snapshotted (see ActorSystem::fits_snapshot).
+ */
+struct ActorSnapshot {
+    enemy_snapshot_t enemies[MAX_NUM_ENEMIES];
+    fireball_t fireballs[MAX_NUM_FIREBALLS];
+    uint8_t items_collected[8][3];
+    uint8_t comic_firepower;
+    uint8_t comic_has_corkscrew;
+    uint8_t fireball_meter;
+    uint8_t fireball_meter_counter;
+    uint8_t comic_has_boots;
+    uint8_t comic_has_lantern;
+    uint8_t comic_has_door_key;
+    uint8_t comic_has_teleport_wand;
+    uint8_t comic_has_gems;
+    uint8_t comic_has_crown;
+    uint8_t comic_has_gold;
+    uint8_t comic_num_treasures;
+    uint8_t item_animation_counter;
+    uint8_t current_item_type;
+    uint8_t current_item_x;
+    uint8_t current_item_y;
+    uint8_t tileset_last_passable;
+    uint8_t current_level_index;
+    uint8_t current_stage_index;
+    uint8_t spawned_this_tick;
+    uint8_t spawn_offset_cycle;
+    uint8_t enemy_respawn_counter_cycle;
 };
 
 /**
@@ -91,17 +141,37 @@ struct enemy_t {
  *
  * Handles enemy spawning, AI behavior, collision detection, animation,
  * and cleanup.
+ *
+ * The pool holds MAX_NUM_ENEMIES enemies and MAX_NUM_FIREBALLS fireballs
+ * unless configured for more (custom levels). Each tick runs the spawned
+ * enemies' behaviors in one pass per behavior type, then the spawning,
+ * despawning and player hits slot by slot; fireball and player collisions
+ * only test the enemies in nearby ActorGrid cells. With the original
+ * limits the results match the original game's slot-by-slot loop exactly.
  */
 class ActorSystem {
 public:
-    ActorSystem();
+    explicit ActorSystem(int max_enemies = MAX_NUM_ENEMIES, int max_fireballs = MAX_NUM_FIREBALLS);
     ~ActorSystem();
 
+    /* Resize the pool; every enemy is despawned with no sprite and every
+       fireball put out (set the stage up again afterwards) */
+    void set_pool_limits(int max_enemies, int max_fireballs);
+
+    int get_max_enemies() const { return enemies.size(); }
+    int get_max_fireballs() const { return static_cast<int>(fireballs.size()); }
+
+    /* Whether an ActorSnapshot can hold the whole pool */
+    bool fits_snapshot() const {
+        return enemies.size() <= MAX_NUM_ENEMIES && get_max_fireballs() <= MAX_NUM_FIREBALLS;
+    }
+
     /* Initialize the actor system */
     bool initialize();
 
-    /* Update all actors for one game tick */
+    /* Update all actors for one game tick of the given game */
     void update(
+        GameContext& game_context,
         uint8_t comic_x, uint8_t comic_y,
         uint8_t comic_facing,
         const uint8_t* tiles,
@@ -109,8 +179,8 @@ public:
         uint8_t fire_key = 0
     );
 
-    /* Get array of enemies */
-    const std::vector<enemy_t>& get_enemies() const { return enemies; }
+    /* Get the enemy slots (read-only) */
+    const EnemyPool& get_enemies() const { return enemies; }
 
     /* Get array of fireballs (read-only) */
     const std::vector<fireball_t>& get_fireballs() const { return fireballs; }
@@ -122,7 +192,8 @@ public:
     bool load_effect_sprites(GraphicsSystem* graphics_system);
 
     /* Render all active fireballs */
-    void render_fireballs(GraphicsSystem* graphics_system, int camera_x, int render_scale) const;
+    void render_fireballs(GraphicsSystem* graphics_system, int camera_x, int render_scale,
+                          const ActorRenderOffsets* offsets = nullptr) const;
 
     /* Reset fireballs (called on stage load) */
     void reset_fireballs();
@@ -148,16 +219,42 @@ public:
     /* Load item sprites from assets (call once after GraphicsSystem is ready) */
     bool load_item_sprites(GraphicsSystem* graphics_system);
 
+    /* Queue the decodes of the fireball, spark and item sprites ahead of the load_* calls */
+    static void request_sprites(GraphicsSystem* graphics_system);
+
     /* Render the current stage's item if not yet collected */
     void render_item(GraphicsSystem* graphics_system, int camera_x, int render_scale) const;
 
+    /* FNV-1a over what render_enemies, render_fireballs and render_item draw
+       from at camera_x: equal signatures draw the same actors */
+    uint64_t get_render_signature(int camera_x) const;
+
     /* Apply item effect (public for testing) */
-    void apply_item_effect(uint8_t item_type);
+    void apply_item_effect(GameContext& game_context, uint8_t item_type);
+
+    /* Copy the per-tick state into a snapshot / back out of one (graphics_system
+       may be null for headless simulation, as in setup_enemies_for_stage) */
+    void save_snapshot(ActorSnapshot& snapshot) const;
+    void restore_snapshot(const ActorSnapshot& snapshot, GraphicsSystem* graphics_system);
+
+    /* Look up the animation data of enemies set up without a graphics system
+       (a SimulationThread state), so they can be drawn, and again for every
+       slot once the texture budget has evicted an enemy sprite */
+    void bind_enemy_sprites(GraphicsSystem* graphics_system);
 
     /* Reset all enemies (called when loading a new stage) */
     void reset_for_stage();
 
-    /* Setup enemies for a stage from level data */
+    /* Streamed stages: game units of the map window's left edge, where the
+       stage record's item position (map units) is placed from */
+    void set_window_origin(int origin_units) { window_origin_units = origin_units; }
+    int get_window_origin() const { return window_origin_units; }
+    /* The map window moved shift_units to the right: move the enemies and
+       fireballs with it, despawning those it left behind */
+    void shift_window(int shift_units);
+
+    /* Setup enemies for a stage from level data (graphics_system may be null
+       for headless simulation: enemies are simulated but not drawn) */
     void setup_enemies_for_stage(
         const class level_t* level,
         int level_index,
@@ -165,27 +262,41 @@ public:
         GraphicsSystem* graphics_system
     );
 
+    /* Set one enemy slot up from a stage record of level (the slots past the
+       stage's MAX_NUM_ENEMIES records are for custom levels to fill); returns
+       false and leaves the slot unused if the record or its sprite is bad.
+       Call reset_for_stage() once every slot is set up. */
+    bool setup_enemy_slot(int slot, const class level_t* level, const enemy_record_t& record,
+                          GraphicsSystem* graphics_system);
+
     /* Render enemies for the current frame */
-    void render_enemies(GraphicsSystem* graphics_system, int camera_x, int render_scale) const;
+    void render_enemies(GraphicsSystem* graphics_system, int camera_x, int render_scale,
+                        const ActorRenderOffsets* offsets = nullptr) const;
 
     /* Check if a specific tile is solid */
     bool is_tile_solid(uint8_t tile_id) const;
 
-    /* Get tile at coordinates */
-    uint8_t get_tile_at(uint8_t x, uint8_t y) const;
+    /* Get tile at coordinates (game units of the window; outside it, passable) */
+    uint8_t get_tile_at(int x, int y) const;
 
 protected:
-    /* Enemy array (max 4 enemies per stage) */
-    std::vector<enemy_t> enemies;
+    /* Enemy slots (MAX_NUM_ENEMIES per stage in the original game) */
+    EnemyPool enemies;
 
     /* Fireball array (max MAX_NUM_FIREBALLS active projectiles) */
     std::vector<fireball_t> fireballs;
 
+    /* Per-tick scratch, sized with the pool */
+    std::vector<int> behavior_slots[ENEMY_BEHAVIOR_SHY];  /* Spawned slots per behavior (from BOUNCE), in slot order */
+    std::vector<uint8_t> enemy_ticked;     /* Slot ran its behavior this tick */
+    std::vector<uint8_t> enemy_near_player; /* Slot shares a grid cell with Comic's hitbox */
+    ActorGrid enemy_grid;
+
     /* Loaded fireball sprite frames (indexed 0/1, set by load_fireball_sprites) */
-    Sprite* fireball_sprite[FIREBALL_NUM_FRAMES];
+    SpriteId fireball_sprite[FIREBALL_NUM_FRAMES];
 
     /* Enemy spark effects: [0]=white, [1]=red; 3 animation frames each. */
-    Sprite* spark_sprites[2][3];
+    SpriteId spark_sprites[2][3];
 
     /* Fireball meter timing counter (cycles 2→1→2→1 each tick) */
     uint8_t fireball_meter_counter;
@@ -196,15 +307,20 @@ protected:
     uint8_t current_item_type;             /* Item type for current stage (from stage data) */
     uint8_t current_item_x;                /* Item X position in game units */
     uint8_t current_item_y;                /* Item Y position in game units */
+    int window_origin_units;               /* Map window's left edge (see set_window_origin) */
     
     /* Item sprite storage (all item types, even/odd frames) */
-    Sprite* item_sprites[15][2];           /* [item_type][0=even, 1=odd] */
+    SpriteId item_sprites[15][2];          /* [item_type][0=even, 1=odd] */
+    uint32_t bound_sprite_evictions;       /* Graphics get_enemy_sprite_evictions() at the last bind_enemy_sprites */
 
     /* Level and stage context */
     const uint8_t* current_tiles;
     int current_map_width_tiles;
     int current_map_height_tiles;
     uint8_t tileset_last_passable;
+    SolidityTable solidity;                /* Built from tileset_last_passable */
+    CollisionBitboard local_collision;     /* Used when the physics bitboard is for other tiles or solidity */
+    const CollisionBitboard* collision;    /* Bitboard of current_tiles for this update */
     uint8_t current_level_index;           /* Current level number (0=LAKE, 1=FOREST, etc.) */
     uint8_t current_stage_index;           /* Current stage number (0-2) */
 
@@ -214,6 +330,7 @@ protected:
     uint8_t enemy_respawn_counter_cycle;
 
     /* Global state updates (passed from game loop) */
+    GameContext* game;                     /* Game being updated (HP, lives, score) */
     uint8_t g_comic_x;
     uint8_t g_comic_y;
     uint8_t g_comic_facing;
@@ -221,10 +338,12 @@ protected:
 
     /* Private helper functions */
     bool maybe_spawn_enemy(int enemy_index);
-    void handle_single_enemy(int enemy_index);
-    void update_enemy_animation(enemy_t* enemy);
-    void check_enemy_despawn(enemy_t* enemy);
-    void check_enemy_player_collision(enemy_t* enemy);
+    void update_enemy_animation(int enemy_index);
+    void check_enemy_despawn(int enemy_index);
+    void check_enemy_player_collision(int enemy_index);
+    void run_behavior_passes();
+    void find_enemies_near_player();
+    void build_enemy_grid();
 
     /* Fireball helpers */
     void try_to_fire();
@@ -233,13 +352,14 @@ protected:
     /* Item helpers */
     void handle_item();
     void collect_item();
+    int item_window_x() const { return static_cast<int>(current_item_x) - window_origin_units; }
 
     /* AI behavior functions */
-    void enemy_behavior_bounce(enemy_t* enemy);
-    void enemy_behavior_leap(enemy_t* enemy);
-    void enemy_behavior_roll(enemy_t* enemy);
-    void enemy_behavior_seek(enemy_t* enemy);
-    void enemy_behavior_shy(enemy_t* enemy);
+    void enemy_behavior_bounce(int enemy_index);
+    void enemy_behavior_leap(int enemy_index);
+    void enemy_behavior_roll(int enemy_index);
+    void enemy_behavior_seek(int enemy_index);
+    void enemy_behavior_shy(int enemy_index);
 
     /* Collision detection helpers */
     bool check_horizontal_enemy_map_collision(uint8_t x, uint8_t y) const;
@@ -250,11 +370,11 @@ protected:
  * Input is base-100 units (e.g., award_points(3) adds 300 points).
  * Points are added into score_bytes[0] with full carry propagation into
  * score_bytes[1]/[2]. */
-void award_points(uint16_t points);
+void award_points(GameContext& game, uint16_t points);
 
 /* Award an extra life.
  * If already at max lives, refill HP and award the comic-c bonus points.
  */
-void award_extra_life();
+void award_extra_life(GameContext& game);
 
 #endif /* ACTORS_H */
@@ -0,0 +1,71 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * One image decode handed to AssetDecodePool. The decode function runs on a
+ * worker thread (path probing + IMG_Load, no renderer calls) and its surface
+ * is handed back to the render thread, which uploads it.
+ */
+struct DecodeJob {
+    std::function<SDL_Surface*()> decode;
+    SDL_Surface* surface = nullptr;  // Result; owned by the job until taken
+    bool done = false;               // Guarded by the pool mutex
+
+    ~DecodeJob();
+    // Transfer ownership of the decoded surface to the caller (nullptr if the
+    // decode failed or the surface was already taken).
+    SDL_Surface* take_surface();
+};
+
+// Shared by the requester and the pool; the job frees an untaken surface.
+using DecodeTicket = std::shared_ptr<DecodeJob>;
+
+/**
+ * AssetDecodePool - small worker pool for PNG decodes
+ *
+ * Jobs run in FIFO order, with urgent jobs going to the front of the queue.
+ * With zero workers every job runs inline in enqueue(), which is the blocking
+ * fallback used when threads are unavailable.
+ */
+class AssetDecodePool {
+public:
+    explicit AssetDecodePool(unsigned worker_count);
+    ~AssetDecodePool();
+    AssetDecodePool(const AssetDecodePool&) = delete;
+    AssetDecodePool& operator=(const AssetDecodePool&) = delete;
+
+    // Hardware threads minus one for the render thread, clamped to [1, 4]
+    static unsigned default_worker_count();
+
+    DecodeTicket enqueue(std::function<SDL_Surface*()> decode, bool urgent = false);
+    bool is_done(const DecodeTicket& ticket) const;
+    // Move a still-queued job to the front of the queue (no-op once started)
+    void promote(const DecodeTicket& ticket);
+    // Block until the job has finished. A job still sitting in the queue is
+    // pulled out and decoded on the calling thread instead of waiting its turn.
+    void wait(const DecodeTicket& ticket);
+
+    unsigned get_worker_count() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    void worker_main();
+    static void run_job(DecodeJob& job);
+
+    std::vector<std::thread> workers;
+    std::deque<DecodeTicket> queue;
+    mutable std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable job_finished;
+    bool stopping;
+};
+
+#endif // ASSET_LOADER_H
@@ -0,0 +1,76 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Asset pack file layout (written by tools/extract_assets.py --pack), all
+ * integers little-endian:
+ *
+ *   header   16 bytes  "CCPK", u32 version, u32 entry_count, u32 reserved
+ *   entries  32 bytes each, sorted by hash:
+ *              u64 name hash (FNV-1a 64 of the file name, e.g. "lake.tt2-00.png")
+ *              u64 data offset, u32 data size
+ *              u32 name offset, u16 name length
+ *              u16 format (AssetPackFormat), u16 width, u16 height
+ *   names    file names, not terminated
+ *   data     blobs, each 16-byte aligned
+ */
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr size_t ASSET_PACK_HEADER_SIZE = 16;
+constexpr size_t ASSET_PACK_ENTRY_SIZE = 32;
+
+enum class AssetPackFormat : uint16_t {
+    RAW = 0,     // File bytes as extracted (PNG)
+    RGBA32 = 1   // Pre-decoded pixels, width * height * 4 bytes
+};
+
+struct AssetPackBlob {
+    const uint8_t* data = nullptr;  // Points into the mapping
+    size_t size = 0;
+    AssetPackFormat format = AssetPackFormat::RAW;
+    uint16_t width = 0;
+    uint16_t height = 0;
+};
+
+uint64_t asset_pack_hash(const char* name, size_t length);
+
+/**
+ * AssetPack - read-only memory-mapped asset pack
+ *
+ * Lookups binary-search the hashed name table in the mapping and return
+ * pointers into it; nothing is copied. Lookups are safe from any thread
+ * once open() has returned.
+ */
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return base != nullptr; }
+    uint32_t get_entry_count() const { return entry_count; }
+
+    bool find(const std::string& name, AssetPackBlob& blob) const;
+    // Image entry as a surface, or nullptr if the pack has no such entry.
+    // RGBA32 entries wrap the mapped pixels, so the surface must be freed
+    // before the pack is closed; PNG entries are decoded from the mapping.
+    SDL_Surface* load_surface(const std::string& name) const;
+
+private:
+    const uint8_t* base;
+    size_t size;
+    uint32_t entry_count;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#endif
+};
+
+#endif // ASSET_PACK_H
@@ -1,7 +1,9 @@
 #ifndef AUDIO_H
 #define AUDIO_H
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 enum class GameSound : uint8_t {
     UNUSED_0 = 0,       // Reserved (no jump sound in original game)
@@ -35,7 +37,9 @@ enum class GameMusic : uint8_t {
 /**
  * Initialize the audio subsystem
  * 
- * Sets up SDL_mixer and synthesizes all game sound effects.
+ * Sets up SDL_mixer and registers all game sound effects. Each waveform is
+ * synthesized on its first play and cached per mixer format, so startup
+ * does not wait on synthesis.
  * Call once at startup before calling play_game_sound().
  * 
  * @return true if initialization successful, false on error
@@ -62,7 +66,9 @@ bool is_audio_system_ready();
  * 
  * Plays the specified sound effect. If a lower-priority sound is
  * already playing, it will be interrupted. If a higher-priority
- * sound is playing, the new sound will be ignored.
+ * sound is playing, the new sound will be ignored. In the low-latency
+ * path (set_audio_buffer_frames()), lower-priority sounds keep their voice
+ * and play alongside unless the pool is full.
  * 
  * @param sound The game sound to play
  * @return true if sound was played, false if rejected or error
@@ -102,4 +108,78 @@ bool is_game_music_playing();
  */
 GameMusic get_current_music();
 
+/**
+ * Select the low-latency voice path
+ *
+ * With frames in 256-512, initialize_audio_system() opens the device with
+ * that buffer size and mixes a fixed pool of voices (four effects, one music)
+ * in its own callback instead of using SDL_mixer channels. SOUND_PRIORITIES
+ * still gate which effects may play; an accepted effect takes a free voice or
+ * steals the lowest-priority one, and starts a fixed delay after the game
+ * tick that triggered it (see set_audio_tick_time()). 0 selects the default
+ * mixer path. Call before initialize_audio_system().
+ *
+ * @return false (and keeps the current setting) if frames is out of range
+ */
+bool set_audio_buffer_frames(int frames);
+
+/**
+ * Timestamp the current game tick (SDL_GetTicks() time the tick was due)
+ *
+ * The low-latency path schedules sounds against this instead of the time
+ * play_game_sound() happens to be called. Sounds played when no tick ran
+ * recently are scheduled against the current time.
+ */
+void set_audio_tick_time(uint32_t tick_ms);
+
+/**
+ * Measured behaviour of the low-latency path (all zero in the default path)
+ */
+struct AudioLatencyStats {
+    bool low_latency = false;
+    int sample_rate = 0;
+    int buffer_frames = 0;                    // Requested device buffer
+    int callback_frames = 0;                  // Frames the device last asked for
+    double output_latency_ms = 0.0;           // Device buffer duration
+    double average_trigger_latency_ms = 0.0;  // Game tick to sample leaving the device
+    double max_trigger_latency_ms = 0.0;
+    uint32_t voices_started = 0;
+    uint32_t voices_stolen = 0;
+    uint32_t sounds_rejected = 0;             // Blocked by a higher-priority sound
+    uint32_t late_starts = 0;                 // Started after their scheduled frame
+    uint32_t underruns = 0;                   // Callback arrived after the device ran dry
+};
+
+AudioLatencyStats get_audio_latency_stats();
+
+/**
+ * Synthesize a sound effect's waveform without playing it (for comic_bench)
+ *
+ * Builds and frees the chunk the first play of the sound would build. With
+ * drop_cached the PCM cached for the current mixer format is discarded first
+ * so the whole synthesis runs; the cache is kept while audio is initialized.
+ * Does not need initialize_audio_system().
+ *
+ * @return samples in the chunk, 0 if the sound has no waveform or there is no mixer support
+ */
+size_t synthesize_game_sound(GameSound sound, bool drop_cached);
+
+// One step of a synthesized sound: a square wave, or a rest (silence) when
+// frequency_hz is not positive
+struct FrequencyNote {
+    int frequency_hz;
+    uint16_t duration_ticks;  // Duration in ticks (at ~18.2 Hz = ~55ms per tick)
+};
+
+/**
+ * The PCM a sound made of these notes plays at a mixer format (for tests)
+ *
+ * Comes from the same cache as the game's sounds, so the buffer stays valid
+ * for the life of the process and a second call returns the same one.
+ * Does not need initialize_audio_system().
+ *
+ * @return interleaved 16-bit samples; empty without mixer support
+ */
+const std::vector<int16_t>& synthesize_notes(const std::vector<FrequencyNote>& notes, int sample_rate, int channels);
+
 #endif // AUDIO_H
@@ -0,0 +1,87 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gameplay.h"
+
+/**
+ * One simulation for BatchRunner: a game from the start of the first level,
+ * run for up to tick_count ticks or until game over or victory.
+ *
+ * The keys held on each tick come from input when it is set (called with the
+ * game before the tick and the tick number, e.g. for a route search that
+ * reacts to the state), otherwise from keys (INPUT_* bytes, one per tick;
+ * no keys once it runs out).
+ */
+struct BatchJob {
+    uint64_t tick_count = 0;
+    std::vector<uint8_t> keys;
+    std::function<uint8_t(const GameContext&, uint64_t)> input;
+    bool debug_mode = false;  // Start with the --debug firepower
+};
+
+// End state of one BatchJob
+struct BatchResult {
+    uint64_t ticks_run = 0;
+    TickOutcome outcome = TickOutcome::Continue;  // Continue: ran out of ticks
+    uint64_t checksum = 0;                        // gameplay_checksum() of the end state
+    uint8_t level_number = 0;
+    uint8_t stage_number = 0;
+    int comic_x = 0;
+    int comic_y = 0;
+    uint8_t comic_hp = 0;
+    uint8_t comic_num_lives = 0;
+    uint8_t comic_num_treasures = 0;
+};
+
+/**
+ * BatchRunner - many independent games stepped across a thread pool
+ *
+ * Each job gets its own GameContext with no graphics or audio, so jobs share
+ * nothing but the constant level data and throughput scales with the number
+ * of threads. The workers are started once and reused by every run(); the
+ * calling thread works through the jobs alongside them.
+ */
+class BatchRunner {
+public:
+    // thread_count 0 uses every hardware thread
+    explicit BatchRunner(unsigned thread_count = 0);
+    ~BatchRunner();
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    // Threads that run jobs, including the calling thread
+    unsigned get_thread_count() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Run every job; results are in job order and do not depend on the
+    // thread count
+    std::vector<BatchResult> run(const std::vector<BatchJob>& jobs);
+
+    // Run one job on the calling thread
+    static BatchResult run_job(const BatchJob& job);
+
+private:
+    void worker_main();
+    void run_claimed_jobs();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable batch_finished;
+    bool stopping;
+
+    // The batch being run (set by run() under the mutex)
+    const std::vector<BatchJob>* batch_jobs;
+    std::vector<BatchResult>* batch_results;
+    uint64_t batch_generation;  // Bumped for each run()
+    unsigned busy_workers;      // Workers still on the current batch
+    std::atomic<size_t> next_job;
+};
+
+#endif // BATCH_RUNNER_H
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <string>
 
+struct GameContext;
+
 /**
  * CheatSystem - Manages debug cheats and development tools
  * 
@@ -17,9 +19,12 @@ public:
     CheatSystem();
     ~CheatSystem();
     
-    // Initialize with debug mode enabled or disabled
-    bool initialize(bool debug_mode);
+    // Initialize with debug mode enabled or disabled; the cheats act on game
+    bool initialize(bool debug_mode, GameContext* game_context);
     
+    // Act on another context from now on (a SimulationThread's game)
+    void set_game(GameContext* game_context) { game = game_context; }
+
     // Process keyboard input for cheat activation
     void process_input(SDL_Keycode key);
     
@@ -57,6 +62,7 @@ private:
     void execute_item_grant();
     
     // State
+    GameContext* game;
     bool initialized;
     bool debug_enabled;
     
@@ -0,0 +1,83 @@
+#ifndef COLLISION_MAP_H
+#define COLLISION_MAP_H
+
+#include <cstdint>
+
+struct level_t;
+
+/**
+ * SolidityTable - one bit per tile ID, set when the tile blocks movement
+ *
+ * Built once per level from tileset_last_passable, with the level's door and
+ * door-frame tiles cleared, so a solidity check is a single bit test.
+ */
+struct SolidityTable {
+    uint64_t bits[4] = {0, 0, 0, 0};
+    uint8_t last_passable = 0xFF;
+
+    bool is_solid(uint8_t tile_id) const {
+        return (bits[tile_id >> 6] >> (tile_id & 63)) & 1;
+    }
+
+    bool operator==(const SolidityTable& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] &&
+               bits[2] == other.bits[2] && bits[3] == other.bits[3] &&
+               last_passable == other.last_passable;
+    }
+};
+
+// Tiles > last_passable are solid; door tiles of level (if given) are not.
+SolidityTable build_solidity_table(uint8_t last_passable, const level_t* level = nullptr);
+
+/**
+ * CollisionBitboard - solidity of a 128x10 stage packed into bits
+ *
+ * Kept both as row words (bit x of row y) and as column masks (bit y of
+ * column x), so probes that span several tiles in either direction are a
+ * mask-and-test. Coordinates are in tiles; cells outside the stage are
+ * passable, matching get_tile_at().
+ */
+class CollisionBitboard {
+public:
+    static constexpr int WIDTH = 128;
+    static constexpr int HEIGHT = 10;
+    static constexpr int ROW_WORDS = WIDTH / 64;
+
+    CollisionBitboard();
+
+    void build(const uint8_t* tiles, const SolidityTable& table);
+    void clear();
+
+    // The tile map and solidity the board was last built from
+    const uint8_t* get_source() const { return source; }
+    const SolidityTable& get_solidity() const { return solidity; }
+
+    bool is_solid(int tile_x, int tile_y) const {
+        if (static_cast<unsigned>(tile_x) >= WIDTH || static_cast<unsigned>(tile_y) >= HEIGHT) {
+            return false;
+        }
+        return (columns[tile_x] >> tile_y) & 1;
+    }
+    uint16_t get_column(int tile_x) const {
+        return static_cast<unsigned>(tile_x) < WIDTH ? columns[tile_x] : 0;
+    }
+
+    // Any solid tile in columns [first_x, last_x] of one row / in rows
+    // [first_y, last_y] of one column (inclusive; clipped to the stage)
+    bool any_solid_in_row(int tile_y, int first_x, int last_x) const;
+    bool any_solid_in_column(int tile_x, int first_y, int last_y) const;
+
+    // Nearest row at or below / at or above tile_y in the column that is
+    // solid (or open, for find_open_at_or_above); -1 if there is none
+    int find_solid_at_or_below(int tile_x, int tile_y) const;
+    int find_solid_at_or_above(int tile_x, int tile_y) const;
+    int find_open_at_or_above(int tile_x, int tile_y) const;
+
+private:
+    uint64_t rows[HEIGHT][ROW_WORDS];
+    uint16_t columns[WIDTH];
+    const uint8_t* source;
+    SolidityTable solidity;
+};
+
+#endif // COLLISION_MAP_H
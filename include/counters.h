@@ -0,0 +1,95 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * Runtime event counters, totalled over the whole run
+ *
+ * Subsystems bump these with count_event(); the debug overlay shows the
+ * interesting ones and --stats prints them all at exit. Totals are relaxed
+ * atomics, so batch worker threads can count too.
+ */
+enum class Counter : uint8_t {
+    // GraphicsSystem
+    RENDER_CALLS = 0,        // SDL_RenderCopy/RenderCopyEx/RenderGeometry calls
+    TEXTURE_SWITCHES,        // Render calls with a different texture from the one before
+    TEXTURES_CREATED,        // Textures uploaded from decoded surfaces
+    IMAGES_DECODED,          // IMG_Load / IMG_Load_RW surfaces
+    IMAGE_BYTES_DECODED,     // Pixel bytes of those surfaces
+
+    // play_game_sound, by the requested sound's priority (0-4)
+    SOUNDS_ACCEPTED_P0,
+    SOUNDS_ACCEPTED_P1,
+    SOUNDS_ACCEPTED_P2,
+    SOUNDS_ACCEPTED_P3,
+    SOUNDS_ACCEPTED_P4,
+    SOUNDS_REJECTED_P0,      // Refused while a higher-priority sound plays
+    SOUNDS_REJECTED_P1,
+    SOUNDS_REJECTED_P2,
+    SOUNDS_REJECTED_P3,
+    SOUNDS_REJECTED_P4,
+    WAVEFORMS_SYNTHESIZED,   // Sound/music PCM built (misses of the per-format cache)
+
+    // ActorSystem
+    ENEMIES_SPAWNED,         // maybe_spawn_enemy successes
+    ENEMIES_DESPAWNED,       // check_enemy_despawn: too far from Comic
+
+    // Windowed frame loop
+    FRAMES,
+    TICKS_RUN,
+    TICK_CAP_FRAMES,         // Frames that hit MAX_TICKS_PER_FRAME with ticks still due
+    TICKS_DROPPED,           // Ticks discarded by the MAX_ACCUMULATED_MS clamp
+    EARLY_TICKS,             // Ticks pulled forward by --early-tick
+    FRAMES_UNCHANGED,        // --render-on-change frames not drawn: nothing on screen had changed
+
+    // FrameCapture
+    CAPTURE_FRAMES,          // Frames read back and queued for the writer
+    CAPTURE_FRAMES_DROPPED,  // Skipped because every writer buffer was in flight
+
+    // FrameArena
+    FRAME_ARENA_OVERFLOWS,   // Allocations refused because the arena was full
+
+    // TileMap
+    MAP_CHUNKS_READ,         // Chunks of streamed maps read and decoded
+
+    COUNT
+};
+
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+
+// Priorities with their own accepted/rejected counters
+constexpr uint8_t COUNTED_SOUND_PRIORITIES = 5;
+
+extern std::atomic<uint64_t> g_counters[COUNTER_COUNT];
+
+inline void count_event(Counter counter, uint64_t amount = 1) {
+    g_counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+inline uint64_t get_counter(Counter counter) {
+    return g_counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+// Count an image decoded to a surface of this pitch and height
+inline void count_decoded_image(int pitch, int height) {
+    count_event(Counter::IMAGES_DECODED);
+    count_event(Counter::IMAGE_BYTES_DECODED, static_cast<uint64_t>(pitch) * static_cast<uint64_t>(height));
+}
+
+// Count a play_game_sound request against its priority (clamped to 0-4)
+void count_sound_request(uint8_t priority, bool accepted);
+
+// Lowercase name, as printed by --stats ("render_calls", "ticks_dropped", ...)
+const char* get_counter_name(Counter counter);
+
+// Zero every counter
+void reset_counters();
+
+// One "name value" line per counter
+void print_counters(std::ostream& out);
+
+#endif // COUNTERS_H
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include "level.h"
 
+struct GameContext;
+
 /**
  * doors.h - Door system for level transitions
  * 
@@ -32,7 +34,7 @@
  * - Y ranges from 0-20 (10 tiles * 2)
  * 
  * Input:
- *   Requires external variables:
+ *   Reads from the game context:
  *   - comic_x, comic_y: Player position in game units
  *   - key_state_open: 1 if open key is pressed, 0 otherwise
  *   - comic_has_door_key: 1 if player has door key, 0 otherwise
@@ -42,7 +44,7 @@
  *   Returns 1 if a door was activated, 0 otherwise
  *   If activated, may load new level/stage data
  */
-uint8_t check_door_activation();
+uint8_t check_door_activation(GameContext& game);
 
 enum class DoorAnimationPhase : uint8_t {
     NONE = 0,
@@ -58,21 +60,20 @@ enum class DoorAnimationRenderMode : uint8_t {
     HALF_CLOSED = 3
 };
 
-/* Door animation state used by the main loop.
+/* Door animation state (GameContext::door_anim_phase / door_anim_frame).
  * ENTERING frames: 0..3 (half-open, full-open, half-closed, closed)
  * EXITING frames:  0..4 (closed, half-open, full-open, half-closed, closed) */
-extern DoorAnimationPhase g_door_anim_phase;
-extern uint8_t g_door_anim_frame;
 
 /* Advance the door animation by one game tick.
  * Handles deferred stage/level transition at the end of ENTERING. */
-void update_door_animation_tick();
+void update_door_animation_tick(GameContext& game);
 
 /* Return the active door render state for this frame.
  * world_x/world_y are the upper-left door tile coordinates in game units.
  * draw_overlay_in_front controls whether the half-door overlay is rendered
  * before or after Comic. player_visible indicates whether Comic should render. */
 bool get_door_animation_render_state(
+	const GameContext& game,
 	uint8_t* world_x,
 	uint8_t* world_y,
 	DoorAnimationRenderMode* mode,
@@ -80,25 +81,22 @@ bool get_door_animation_render_state(
 	bool* player_visible
 );
 
-/* Testing hook: when set to true, activate_door will update the current
- * level/stage numbers and source_door_* flags but will NOT actually call
- * load_new_level()/load_new_stage(). This allows unit tests to exercise
- * door logic deterministically without dragging in asset loading or
- * clearing the source flags. Default is false in production. */
-extern bool g_skip_load_on_door;
-
 /**
  * activate_door - Perform door transition to target level/stage
  * 
  * Input:
  *   door: pointer to door descriptor with target level/stage
  * 
+ * When game.skip_load_on_door is set (unit tests), only the level/stage
+ * numbers and source_door_* flags are updated; nothing is loaded, so door
+ * logic can be tested without asset loading clearing the source flags.
+ * 
  * Marks the entry point as coming from a door, sets current level/stage
  * to the door's target, and loads the new level or stage as appropriate.
  * 
  * If the target is in a different level, loads entire level data.
  * If the target is in the same level, loads only the stage data.
  */
-void activate_door(const door_t *door);
+void activate_door(GameContext& game, const door_t *door);
 
 #endif /* DOORS_H */
@@ -0,0 +1,64 @@
+#ifndef FIXED_VECTOR_H
+#define FIXED_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+
+/**
+ * FixedVector - vector with its storage inline and a fixed capacity
+ *
+ * For the small per-frame and per-spawn lists of the hot paths, which a
+ * std::vector would put on the heap. Pushing onto a full vector does
+ * nothing and returns false; the elements are plain values (copied, never
+ * destroyed), so T should be trivially copyable.
+ */
+template <typename T, size_t Capacity>
+class FixedVector {
+public:
+    FixedVector() = default;
+    FixedVector(std::initializer_list<T> items) {
+        for (const T& item : items) {
+            push_back(item);
+        }
+    }
+
+    bool push_back(const T& item) {
+        if (count == Capacity) {
+            return false;
+        }
+        items[count++] = item;
+        return true;
+    }
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+
+    bool operator==(const FixedVector& other) const {
+        if (count != other.count) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (!(items[i] == other.items[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool operator!=(const FixedVector& other) const { return !(*this == other); }
+
+private:
+    T items[Capacity] = {};
+    size_t count = 0;
+};
+
+#endif // FIXED_VECTOR_H
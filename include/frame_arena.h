@@ -0,0 +1,81 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bytes of the render thread's arena (see frame_arena())
+constexpr size_t FRAME_ARENA_BYTES = 64 * 1024;
+
+/**
+ * FrameArena - bump allocator for data that lives for one frame
+ *
+ * Allocation moves a pointer through one buffer allocated up front, and
+ * reset() hands the whole buffer back at once, so transient strings and
+ * lists cost no heap traffic in the steady state. Nothing is destroyed:
+ * keep to trivially destructible types. When the buffer is used up,
+ * allocations return nullptr (format() an empty string) and are counted
+ * as Counter::FRAME_ARENA_OVERFLOWS.
+ *
+ * One thread only; the simulation and batch threads do not use it.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocate_array(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // printf into the arena; the string lives until the next reset
+    const char* format(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    // Give back everything allocated since the start (or since a mark)
+    void reset() { used = 0; }
+    size_t mark() const { return used; }
+    void rewind(size_t marker) { used = marker < used ? marker : used; }
+
+    size_t get_used() const { return used; }
+    size_t get_capacity() const { return capacity; }
+    // Most bytes in use at once since the arena was created
+    size_t get_high_water() const { return high_water; }
+
+private:
+    std::unique_ptr<uint8_t[]> buffer;
+    size_t capacity;
+    size_t used = 0;
+    size_t high_water = 0;
+};
+
+/*
+ * The render thread's arena. The main loop resets it at the top of every
+ * frame; screens that run their own loop take a FrameArenaScope per
+ * iteration instead.
+ */
+FrameArena& frame_arena();
+
+// Rewinds the arena to where it was on construction
+class FrameArenaScope {
+public:
+    explicit FrameArenaScope(FrameArena& scope_arena = frame_arena())
+        : arena(scope_arena), marker(scope_arena.mark()) {}
+    ~FrameArenaScope() { arena.rewind(marker); }
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+private:
+    FrameArena& arena;
+    size_t marker;
+};
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,159 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "spsc_queue.h"
+
+// What the captured frames are written as
+enum class CaptureFormat : uint8_t {
+    Y4M,       // YUV4MPEG2, 4:2:0 full-range BT.601 (ffmpeg, x264 and most encoders read it)
+    RAW_RGBA   // Bare RGBA32 frames (ffmpeg -f rawvideo -pix_fmt rgba -s WxH)
+};
+
+// Parse a --capture-format name ("y4m" or "raw"); false if unknown
+bool parse_capture_format(const char* name, CaptureFormat* format);
+
+// Frames in flight between the render thread and the writer thread
+constexpr int FRAME_CAPTURE_BUFFERS = 8;
+// Offscreen targets the frames are drawn into; each is read back this many
+// frames minus one after it was drawn, once the GPU has long finished it
+constexpr int FRAME_CAPTURE_TARGETS = 3;
+
+/**
+ * Convert an RGBA32 image to planar 4:2:0 YUV (Y, then U, then V planes) as
+ * full-range BT.601, averaging each 2x2 block for the chroma samples
+ *
+ * width and height must be even; out holds width * height * 3 / 2 bytes.
+ */
+void convert_rgba_to_i420(const uint8_t* rgba, int width, int height, int pitch, uint8_t* out);
+
+/**
+ * FrameWriter - writes captured frames out on a thread of its own
+ *
+ * The render thread takes a free frame buffer, fills it with an RGBA32 frame
+ * and submits it; the writer thread converts it (for Y4M), writes it and
+ * hands the buffer back. Both directions go through lock-free queues, so
+ * neither thread ever blocks the other: when every buffer is still queued
+ * the render thread either drops the frame or, for an offline render that
+ * must keep every frame, waits for the writer.
+ */
+class FrameWriter {
+public:
+    FrameWriter() = default;
+    ~FrameWriter();
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    /**
+     * Write to destination: a file path, or "|command" to pipe the frames
+     * into an external encoder's standard input. width and height are
+     * rounded down to even sizes for Y4M.
+     */
+    bool open(const char* destination, CaptureFormat format, int width, int height, int fps);
+
+    // Write to an already open stream (closed by finish() if close_stream)
+    bool open_stream(FILE* stream, bool close_stream, CaptureFormat format, int width, int height, int fps);
+
+    bool is_open() const { return writer.joinable(); }
+
+    // Render thread: a free buffer of get_frame_pitch() * height bytes, or
+    // nullptr when all are in flight (after waiting for one if wait is set)
+    uint8_t* acquire_frame(bool wait);
+    // Render thread: queue a buffer from acquire_frame() to be written
+    void submit_frame(uint8_t* frame);
+
+    int get_frame_pitch() const { return width * 4; }
+    int get_width() const { return width; }
+    int get_height() const { return height; }
+
+    /* Write the queued frames, stop the thread and close the output; false
+       if anything failed to write */
+    bool finish();
+
+    uint64_t get_frames_written() const { return frames_written.load(std::memory_order_relaxed); }
+
+private:
+    bool start(CaptureFormat format, int width, int height, int fps);
+    void thread_main();
+    bool write_frame(const uint8_t* frame);
+
+    FILE* stream = nullptr;
+    bool close_stream = false;
+    bool is_pipe = false;
+    CaptureFormat format = CaptureFormat::Y4M;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> frames[FRAME_CAPTURE_BUFFERS];
+    std::vector<uint8_t> converted;  // Writer thread only
+    SpscQueue<int, FRAME_CAPTURE_BUFFERS> filled;  // Render thread -> writer
+    SpscQueue<int, FRAME_CAPTURE_BUFFERS> free_frames;  // Writer -> render thread
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> write_failed{false};
+    std::atomic<uint64_t> frames_written{0};
+};
+
+/**
+ * FrameCapture - records what the window shows, without stalling on readback
+ *
+ * Each frame is drawn into one of a ring of FRAME_CAPTURE_TARGETS offscreen
+ * textures (begin_frame() binds it) and copied to the window by end_frame(),
+ * which also reads back the oldest texture in the ring, drawn two frames
+ * earlier, into a FrameWriter buffer. A frame still being drawn is never
+ * read back, so the readback does not wait for the GPU to finish it.
+ *
+ * GraphicsSystem::end_frame() returns to the capture target rather than the
+ * window; set it with GraphicsSystem::set_frame_target(get_frame_target())
+ * after begin_frame().
+ */
+class FrameCapture {
+public:
+    FrameCapture() = default;
+    ~FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /* Capture the renderer's output at fps frames per second to destination
+       (see FrameWriter::open); keep_every_frame waits for the writer instead
+       of dropping frames when it falls behind */
+    bool start(SDL_Renderer* renderer, const char* destination, CaptureFormat format, int fps,
+               bool keep_every_frame);
+
+    bool is_active() const { return renderer != nullptr; }
+
+    // Bind this frame's offscreen target; call before drawing anything
+    void begin_frame();
+    // The texture begin_frame() bound (null when not capturing)
+    SDL_Texture* get_frame_target() const;
+    // Read the oldest finished frame back and show this one in the window;
+    // call after drawing, before SDL_RenderPresent
+    void end_frame();
+
+    /* Read back the frames still in the ring, write everything out and free
+       the targets; false if the output could not be written */
+    bool stop();
+
+    uint64_t get_frames_captured() const { return frames_captured; }
+    uint64_t get_frames_dropped() const { return frames_dropped; }
+
+private:
+    void read_back(SDL_Texture* target);
+
+    SDL_Renderer* renderer = nullptr;
+    FrameWriter writer;
+    bool keep_every_frame = false;
+    int output_width = 0;
+    int output_height = 0;
+    SDL_Texture* targets[FRAME_CAPTURE_TARGETS] = {};
+    uint64_t frames_begun = 0;   // Frames drawn into the targets so far
+    uint64_t frames_read = 0;    // Of those, read back (or dropped)
+    uint64_t frames_captured = 0;
+    uint64_t frames_dropped = 0;
+};
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,194 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "actors.h"
+#include "game_context.h"
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+/**
+ * How the windowed loop spaces its frames
+ *
+ * VSYNC lets SDL_RenderPresent block on the display; FIXED sleeps most of
+ * the way to a target frame rate and spins the last couple of milliseconds
+ * for an even cadence; POWER_SAVER only sleeps, at a lower rate, and idles
+ * while the window is minimized.
+ */
+enum class PacingMode : uint8_t {
+    VSYNC = 0,
+    FIXED,
+    POWER_SAVER
+};
+
+constexpr int DEFAULT_FIXED_FPS = 60;
+constexpr int DEFAULT_POWER_SAVER_FPS = 30;
+
+// "vsync", "fixed" or "power-saver"; false for anything else
+bool parse_pacing_mode(const char* text, PacingMode* mode);
+const char* get_pacing_mode_name(PacingMode mode);
+
+// Present-to-present timing since FramePacer::start
+struct FramePacingStats {
+    uint64_t presents = 0;
+    double average_interval_ms = 0.0;
+    double jitter_ms = 0.0;           // Standard deviation of the interval
+    double max_interval_ms = 0.0;
+    double busy_percent = 0.0;        // Wall time not spent sleeping in the pacer
+};
+
+/**
+ * FramePacer - frame scheduling for the windowed loop
+ *
+ * Create the renderer with renderer_flags(mode), then start() the pacer
+ * with it; call mark_present() right after every SDL_RenderPresent and
+ * wait_for_next_frame() at the end of the frame.
+ */
+class FramePacer {
+public:
+    FramePacer();
+
+    // SDL_CreateRenderer flags for a mode (adds SDL_RENDERER_PRESENTVSYNC for VSYNC)
+    static uint32_t renderer_flags(PacingMode mode);
+
+    /**
+     * Begin pacing. target_fps 0 picks the mode's default (the display's
+     * refresh rate for VSYNC). VSYNC falls back to FIXED at the refresh rate
+     * when the renderer did not get vsync.
+     */
+    void start(PacingMode mode, int target_fps, SDL_Renderer* renderer, SDL_Window* window);
+
+    PacingMode get_mode() const { return mode; }
+    int get_target_fps() const { return target_fps; }
+
+    void mark_present();
+    void wait_for_next_frame();
+    // Sleep up to max_ms instead of drawing a frame (SceneChangeTracker),
+    // waking as soon as an input or window event arrives
+    void wait_for_wakeup(double max_ms);
+
+    FramePacingStats get_stats() const;
+
+private:
+    PacingMode mode;
+    int target_fps;
+    SDL_Window* window;
+    double ms_per_count;
+    uint64_t frame_period;      // Performance counts per frame
+    uint64_t next_deadline;     // 0 until the first frame
+    uint64_t first_present;
+    uint64_t last_present;
+    uint64_t presents;
+    double interval_sum_ms;
+    double interval_square_sum_ms;
+    double max_interval_ms;
+    double sleep_ms;
+
+    void sleep_for_ms(uint32_t ms);
+};
+
+/**
+ * RenderInterpolator - optional sub-tick smoothing for the windowed loop
+ *
+ * Logic runs at ~9.1 Hz, so the camera and actors normally snap one step
+ * per tick. With interpolation on, frames between ticks draw them part way
+ * from where they were before the last tick to where they are now, by the
+ * fraction of the next tick already accumulated. This costs up to one tick
+ * of display latency, so the original snap is the default.
+ */
+class RenderInterpolator {
+public:
+    RenderInterpolator();
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const { return enabled; }
+
+    // Before each gameplay tick: remember where everything was
+    void capture_previous(const GameContext& game);
+    // After the tick loop: fraction (0-1) of the next tick already elapsed
+    void set_blend(double fraction);
+    // Snap until the next tick (stage changes, rewinds, pauses)
+    void reset();
+
+    /**
+     * Pixel offsets to add to where the snapped positions would be drawn;
+     * all zero while disabled, before the first capture, across a stage
+     * change, or for anything that moved too far in one tick to be motion.
+     * The world shift (for GraphicsSystem::set_world_offset) places the
+     * camera; the others place Comic and the actors within the world.
+     */
+    int get_world_shift(const GameContext& game, int render_scale) const;
+    int get_comic_offset_x(const GameContext& game, int render_scale) const;
+    int get_comic_offset_y(const GameContext& game, int render_scale) const;
+    void get_actor_offsets(const GameContext& game, int render_scale, ActorRenderOffsets* offsets) const;
+
+private:
+    bool enabled;
+    bool valid;
+    double blend;
+    uint8_t level_number;
+    uint8_t stage_number;
+    int camera_x;
+    int comic_x;
+    int comic_y;
+    uint8_t enemy_x[MAX_NUM_ENEMIES];
+    uint8_t enemy_y[MAX_NUM_ENEMIES];
+    uint8_t enemy_state[MAX_NUM_ENEMIES];
+    uint8_t fireball_x[MAX_NUM_FIREBALLS];
+    uint8_t fireball_y[MAX_NUM_FIREBALLS];
+
+    bool applies_to(const GameContext& game) const;
+    int offset(int previous, int current, int render_scale) const;
+};
+
+// What a gameplay frame shows: the game, plus the renderer's own state
+struct SceneView {
+    uint64_t game = 0;                  // scene_signature()
+    const void* animation = nullptr;    // Comic's animation, and its frame
+    int animation_frame = 0;
+    uint8_t hud_frame = 0;              // HudState::inventory_frame
+    bool paused = false;
+
+    bool operator==(const SceneView& other) const;
+    bool operator!=(const SceneView& other) const { return !(*this == other); }
+};
+
+/**
+ * SceneChangeTracker - draws gameplay frames only when they would change
+ *
+ * Logic runs at ~9.1 Hz and, without interpolation, nothing on screen moves
+ * between ticks except Comic's timed animation frames. With the tracker on,
+ * the loop hands it the SceneView of each frame before drawing; if nothing
+ * differs from the frame last drawn, the loop draws nothing and sleeps
+ * until the next tick, the next animation frame or an event, whichever
+ * comes first. invalidate() forces the next frame for changes the view
+ * does not cover: window and render-target events, newly uploaded
+ * textures, the debug overlay.
+ */
+class SceneChangeTracker {
+public:
+    SceneChangeTracker();
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const { return enabled; }
+
+    void invalidate() { stale = true; }
+    // Whether a frame showing view needs drawing; a true answer counts as
+    // drawn. Always true while disabled. Frames not drawn are counted as
+    // Counter::FRAMES_UNCHANGED.
+    bool needs_frame(const SceneView& view);
+
+    /**
+     * How long the loop may sleep before it has to look again: until the
+     * next tick (ms_to_tick) or the next animation frame (a deadline from
+     * GraphicsSystem::update_animation on the now_ms clock; 0 for none),
+     * whichever is sooner, and never more than max_ms.
+     */
+    static double idle_ms(double ms_to_tick, uint32_t animation_deadline, uint32_t now_ms, double max_ms);
+
+private:
+    bool enabled;
+    bool stale;
+    SceneView drawn;
+};
+
+#endif // FRAME_PACER_H
@@ -0,0 +1,142 @@
+#ifndef GAME_CONTEXT_H
+#define GAME_CONTEXT_H
+
+#include <cstdint>
+#include "actors.h"
+#include "collision_map.h"
+#include "doors.h"
+#include "level.h"
+#include "physics.h"
+#include "tile_map.h"
+
+class GraphicsSystem;
+
+/**
+ * GameContext - the complete state of one game
+ *
+ * Everything the simulation reads or writes lives here, and the gameplay,
+ * physics, door and level loading functions operate on the context they are
+ * given, so any number of games can run in one process (one thread each at a
+ * time). Process-wide systems — the renderer, audio, the debug cheats — stay
+ * global; a context only refers to a graphics system if it is the game being
+ * drawn.
+ *
+ * Contexts are plain values: copying one copies the game.
+ */
+struct GameContext {
+    // Player
+    int comic_x = 20;
+    int comic_y = 2;
+    int8_t comic_y_vel = 0;
+    int8_t comic_x_momentum = 0;
+    uint8_t comic_facing = COMIC_FACING_RIGHT;
+    uint8_t comic_is_falling_or_jumping = 1;
+    uint8_t comic_jump_counter = 0;
+    uint8_t comic_jump_power = JUMP_POWER_DEFAULT;
+    int camera_x = 0;
+
+    // Gameplay keys (1 while held) and the edge-trigger history
+    uint8_t key_state_jump = 0;
+    uint8_t previous_key_state_jump = 0;
+    uint8_t key_state_left = 0;
+    uint8_t key_state_right = 0;
+    uint8_t key_state_open = 0;
+    uint8_t previous_key_state_open = 0;
+    uint8_t key_state_fire = 0;
+    uint8_t key_state_teleport = 0;
+    uint8_t previous_key_state_teleport = 0;
+    bool key_states_cleared = false;  // Set when the key states are reset, so a recording can replay the reset
+
+    // Lives, health and score
+    uint8_t comic_has_door_key = 0;
+    uint8_t comic_num_lives = 0;             // Counts up from 0 to 5, then subtracts 1
+    uint8_t lives_sequence_counter = 5;      // Lives still to award at game start
+    uint8_t lives_sequence_delay = 1;        // Ticks until the next award
+    bool lives_sequence_complete = false;
+    uint8_t comic_hp = 0;                    // 0 to MAX_HP
+    uint8_t comic_hp_pending_increase = MAX_HP;  // HP fills gradually at game start
+    uint8_t score_bytes[3] = {0, 0, 0};      // Base-100 encoding, least significant first
+    uint8_t score_10000_counter = 0;         // Carries into ten-thousands; 5 -> extra life
+    bool game_over_triggered = false;
+
+    // Level and stage
+    uint8_t current_level_number = LEVEL_NUMBER_FOREST;
+    uint8_t current_stage_number = 0;
+    const level_t* current_level_ptr = nullptr;
+    int8_t source_door_level_number = -1;    // Set when entering via door for reciprocal positioning
+    int8_t source_door_stage_number = -1;
+    uint8_t comic_y_checkpoint = 12;         // Respawn position
+    uint8_t comic_x_checkpoint = 14;
+    bool first_stage_loaded = false;         // The startup load has nothing to prefetch from
+
+    // Current stage tiles: a view of the stage's constant map, or
+    // scratch_tiles (init_test_level) while stage_map is null
+    uint8_t scratch_tiles[MAP_WIDTH_TILES * MAP_HEIGHT_TILES] = {};
+    const uint8_t* stage_map = nullptr;
+    SolidityTable level_solidity = build_solidity_table(0x3F);
+    const level_t* solidity_level = nullptr;  // Level level_solidity was built for
+    CollisionBitboard stage_collision;
+    uint32_t stage_tiles_revision = 0;        // Bumped whenever the current tiles change
+    // Streamed stage (level_loader.h): scratch_tiles is the window of this
+    // map that starts map_origin_x tiles in, and every x in game units
+    // (Comic, camera, actors) is relative to that window
+    const TileMap* tile_map = nullptr;
+    MapCoord map_origin_x = 0;
+    MapCoord checkpoint_map_origin_x = 0;     // Window comic_x_checkpoint is in
+    bool cheat_noclip = false;
+    uint64_t player_solid_mask = ~0ull;       // Cleared while noclip is active
+    bool ceiling_stick_flag = false;
+
+    // Player death sequence
+    bool player_is_dying = false;
+    bool player_death_too_bad_phase = false;
+    bool player_death_show_animation = true;
+    bool player_death_fall_clip_render = false;
+    uint8_t player_death_ticks_remaining = 0;
+
+    // Door animation (see doors.h)
+    DoorAnimationPhase door_anim_phase = DoorAnimationPhase::NONE;
+    uint8_t door_anim_frame = 0;
+    uint8_t door_exit_delay_ticks = 0;
+    uint8_t door_anim_world_x = DOOR_UNUSED;
+    uint8_t door_anim_world_y = DOOR_UNUSED;
+    uint8_t door_pending_level = 0;
+    uint8_t door_pending_stage = 0;
+    // Testing hook: activate_door updates the level/stage numbers and
+    // source_door_* but loads nothing and plays no animation
+    bool skip_load_on_door = false;
+
+    // Teleport
+    bool comic_is_teleporting = false;
+    uint8_t teleport_animation = 0;
+    uint8_t teleport_source_x = 0;
+    uint8_t teleport_source_y = 0;
+    uint8_t teleport_destination_x = 0;
+    uint8_t teleport_destination_y = 0;
+    uint8_t teleport_camera_counter = 0;
+    int8_t teleport_camera_vel = 0;
+    bool teleport_skip_tick = false;
+
+    // Carried from tick to tick (and read by the renderer)
+    int comic_run_cycle_frame = 0;           // Advanced once per tick, like comic_run_cycle
+    int run_frame_count = 3;                 // Frames in the run cycle animation
+    bool player_moved_last_tick = false;
+    bool player_airborne_from_walk_off = false;  // Airborne from walking off an edge (not a jump)
+    bool suppress_jump_animation = false;    // Cleared by the renderer each frame
+    bool beam_out_sequence_played = false;
+    uint8_t win_counter = 0;
+    uint8_t enemy_level_number = 0xFF;       // Stage the enemies were last set up for
+    uint8_t enemy_stage_number = 0xFF;
+
+    // Enemies, fireballs and items
+    ActorSystem actors;
+
+    // Loads textures for this game's stages; null when nothing draws it
+    GraphicsSystem* graphics = nullptr;
+
+    GameContext() { stage_collision.build(current_tiles(), level_solidity); }
+
+    const uint8_t* current_tiles() const { return stage_map ? stage_map : scratch_tiles; }
+};
+
+#endif // GAME_CONTEXT_H
@@ -0,0 +1,59 @@
+#ifndef GAMEPLAY_H
+#define GAMEPLAY_H
+
+#include <cstdint>
+#include "game_context.h"
+
+class Sequencer;
+
+// Outcome of one gameplay tick
+enum class TickOutcome {
+    Continue,
+    GameOver,
+    Victory
+};
+
+/**
+ * Advance the game by one ~9.1 Hz tick: physics, doors, teleport, actors and
+ * the start-of-game counters. Reads the context's key_state_* inputs and
+ * touches no renderer (and no other context), so it runs the same with or
+ * without a window. The HUD's animation counter is the caller's to advance.
+ */
+TickOutcome run_gameplay_tick(GameContext& game);
+
+// Initialize the level data, load the first playable level and put Comic at
+// its spawn point (falls back to the test level if the level cannot load)
+void load_starting_level(GameContext& game);
+
+// Set up enemies again if a door, stage edge or cheat changed the stage
+void sync_stage_enemies(GameContext& game);
+
+// Release every gameplay key and its edge-trigger history (pause, cutscenes)
+void clear_gameplay_key_states(GameContext& game);
+
+// Queue the end-of-game tally, one step a tick: the 20,000-point victory
+// bonus, then 10,000 points for each life left, taking the life away after
+// its points. Lives are counted as the tally reaches them, so a life the
+// tally's own points award is paid out too.
+void queue_victory_tally(Sequencer& sequencer, GameContext& game);
+
+// Edge-triggered door and teleport activation, run after physics each tick
+void process_door_input(GameContext& game);
+void process_teleport_input(GameContext& game, bool comic_has_teleport_wand);
+void begin_teleport(GameContext& game);
+void handle_teleport_tick(GameContext& game);
+
+// The keys held on this tick as INPUT_* bits (see replay.h), as recorded in a
+// replay; reports and clears a pending key state reset
+uint8_t current_input_keys(GameContext& game);
+// Hold exactly the keys in an INPUT_* byte
+void apply_input_keys(GameContext& game, uint8_t keys);
+
+// FNV-1a over the simulated state, so two runs can be compared at a glance
+uint64_t gameplay_checksum(const GameContext& game);
+// FNV-1a over what a gameplay frame draws from the game (stage, camera,
+// Comic, HUD values, doors, teleport and actors): an unchanged signature
+// draws the same frame
+uint64_t scene_signature(const GameContext& game);
+
+#endif // GAMEPLAY_H
@@ -0,0 +1,74 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+// Printable ASCII range baked into every atlas; other bytes draw as '?'.
+constexpr int GLYPH_ATLAS_FIRST_CHAR = 32;
+constexpr int GLYPH_ATLAS_LAST_CHAR = 126;
+constexpr int GLYPH_ATLAS_CHAR_COUNT = GLYPH_ATLAS_LAST_CHAR - GLYPH_ATLAS_FIRST_CHAR + 1;
+constexpr int GLYPH_ATLAS_WIDTH = 512;
+
+/**
+ * GlyphAtlas bakes one font (face + size + style) into a single white texture
+ * once, then draws text as coloured quads from it. Drawing never creates
+ * surfaces or textures; the vertex buffers are reused between calls.
+ *
+ * Glyphs are placed by their advance without kerning, which matches
+ * TTF_RenderText output for the monospace and DOS-style fonts we use.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // solid bakes the glyphs without antialiasing, like TTF_RenderText_Solid
+    bool build(SDL_Renderer* renderer, TTF_Font* font, bool solid = false);
+    void cleanup();
+    bool is_ready() const { return texture != nullptr; }
+    SDL_Renderer* get_renderer() const { return renderer; }
+
+    int get_line_skip() const { return line_skip; }
+    int get_height() const { return height; }
+
+    // Width in pixels of one line of text (no wrapping)
+    int measure_text(const char* text) const;
+    // Split text into rows no wider than max_width, breaking at spaces (or
+    // mid-word when a word alone is too wide) and at '\n', like
+    // TTF_RenderText_Blended_Wrapped.
+    void wrap_text(const std::string& text, int max_width, std::vector<std::string>& rows) const;
+    // Draw one line with its top-left corner at (x, y)
+    void render_text(int x, int y, const char* text, SDL_Color color);
+
+private:
+    struct Glyph {
+        SDL_Rect src = {0, 0, 0, 0};
+        int advance = 0;
+    };
+
+    const Glyph& glyph_for(char c) const;
+
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    Glyph glyphs[GLYPH_ATLAS_CHAR_COUNT];
+    int height;
+    int line_skip;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+// Shared atlases, one per renderer, font face/size/style and solid flag. The
+// atlas is keyed by the face rather than the TTF_Font pointer, so reopening
+// the same font (as the title screens do per screen) reuses the existing
+// atlas. Returns nullptr if the atlas cannot be built.
+GlyphAtlas* acquire_glyph_atlas(SDL_Renderer* renderer, TTF_Font* font, bool solid = false);
+// Destroy the shared atlases of renderer; call before it is destroyed, so a
+// later renderer at the same address does not get them.
+void release_glyph_atlases(SDL_Renderer* renderer);
+
+#endif // GLYPH_ATLAS_H
@@ -6,7 +6,17 @@
 #include <cstdint>
 #include <string>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
+#include "level.h"
+#include "glyph_atlas.h"
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include "fixed_vector.h"
+#include "original_assets.h"
+
+struct GameContext;
 
 // Original EGA resolution (used for letterbox scaling)
 constexpr int EGA_WIDTH = 320;
@@ -27,9 +37,28 @@ struct TextureInfo {
     int height;
 };
 
-// Tileset: contains multiple tile graphics (16x16 pixels each)
+// Tileset atlas layout: up to 128 tiles (.tt2-00 .. .tt2-7f) packed 16 per row
+constexpr int TILESET_MAX_TILES = 128;
+constexpr int TILESET_ATLAS_COLUMNS = 16;
+constexpr int TILESET_TABLE_SIZE = 256;  // Indexed directly by uint8_t tile id
+
+// Textures pump_asset_uploads() may create per frame from finished decodes
+constexpr int ASSET_UPLOADS_PER_FRAME = 8;
+
+// Map chunks the stage background keeps drawn: the view spans at most two
+// 64-unit chunks, and one more keeps the chunk it last scrolled off
+constexpr int STAGE_BACKGROUND_CHUNK_SLOTS = 3;
+
+// Tileset: all tile graphics (16x16 pixels each) packed into one atlas texture.
+// src_rects/present are flat tables indexed by tile id, so drawing a tile is an
+// array lookup plus one SDL_RenderCopy from the shared atlas.
 struct Tileset {
-    std::map<uint8_t, TextureInfo> tiles;  // tile_id -> TextureInfo
+    SDL_Texture* atlas = nullptr;
+    SDL_Rect src_rects[TILESET_TABLE_SIZE] = {};  // tile_id -> region of atlas
+    bool present[TILESET_TABLE_SIZE] = {};        // tile_id -> loaded?
+    int tile_count = 0;
+    
+    bool has_tile(uint8_t tile_id) const { return present[tile_id]; }
     void cleanup();
 };
 
@@ -40,6 +69,17 @@ struct Sprite {
     int height;
 };
 
+// Handle into GraphicsSystem's flat sprite registry, returned by load_sprite_id.
+// Resolving a handle is a bounds-checked vector index, so gameplay and UI code
+// keep SpriteIds rather than names (or Sprite pointers, which the registry may
+// move when it grows).
+using SpriteId = uint16_t;
+constexpr SpriteId INVALID_SPRITE_ID = 0xFFFF;
+
+// Handle into the tileset registry (one entry per level name)
+using TilesetId = uint8_t;
+constexpr TilesetId INVALID_TILESET_ID = 0xFF;
+
 // Sprite animation frame
 struct AnimationFrame {
     Sprite sprite;
@@ -56,17 +96,71 @@ struct Animation {
     Animation() : current_frame(0), frame_start_time(0), looping(true) {}
 };
 
+// Distinct frames an enemy animation can use (the original sprites have 3 or 4)
+constexpr size_t MAX_ENEMY_ANIMATION_FRAMES = 16;
+// Animation order of an enemy sprite, kept inline so spawning allocates nothing
+using EnemyAnimationSequence = FixedVector<uint8_t, MAX_ENEMY_ANIMATION_FRAMES * 2>;
+
 // Enemy sprite animation data
 // Note: Metadata (num_frames, horizontal orientation) is stored in the level's shp_t descriptor.
 // This struct only contains the loaded texture data.
 struct SpriteAnimationData {
     std::vector<TextureInfo> frames_left;   /* Left-facing animation frames */
     std::vector<TextureInfo> frames_right;  /* Right-facing animation frames */
-    std::vector<uint8_t> frame_sequence;    /* Animation order (indexes into frames_*) */
+    EnemyAnimationSequence frame_sequence;  /* Animation order (indexes into frames_*) */
+};
+
+// Draw layers for the batched sprite queue, back to front. Within a layer the
+// queue keeps submission order; a layer per kind of content (e.g. spark effects
+// drawn over their enemy) keeps same-texture sprites next to each other.
+enum class RenderLayer : uint8_t {
+    ENEMIES = 0,
+    ENEMY_EFFECTS,
+    FIREBALLS,
+    PLAYER,
+    TELEPORT,
+    ITEMS,
+    HUD
 };
 
-// Build animation frame sequence for enemy sprites
-std::vector<uint8_t> build_enemy_animation_sequence(
+// A sprite draw collected by the render queue until the next flush
+struct QueuedSprite {
+    SDL_Texture* texture;
+    SDL_Rect src;       // Only used when has_src is set; otherwise the whole texture
+    SDL_Rect dst;
+    bool has_src;
+    bool flip_h;
+    RenderLayer layer;
+    uint32_t sequence;  // Submission order, kept within a layer
+};
+
+// Per-frame render queue counters
+struct RenderQueueStats {
+    uint32_t draws = 0;    // Sprites submitted through the queue
+    uint32_t batches = 0;  // Draw calls issued for them
+    uint32_t render_calls = 0;      // Every GraphicsSystem render call (see Counter::RENDER_CALLS)
+    uint32_t texture_switches = 0;  // Of those, the ones with a new texture
+};
+
+// Texture residency is tracked per category (see set_texture_budget)
+enum class TextureCategory : uint8_t {
+    TILESETS = 0,
+    ENEMY_SPRITES,
+    SPRITES,
+    COUNT
+};
+
+struct TextureCacheStats {
+    size_t resident_bytes = 0;    // Estimated GPU bytes (width * height * 4)
+    uint32_t resident_count = 0;  // Tilesets / enemy sprites / sprites resident
+    uint32_t hits = 0;            // Blocking loads served from resident textures
+    uint32_t misses = 0;          // Blocking loads that had to decode or upload
+    uint32_t evictions = 0;
+};
+
+// Build animation frame sequence for enemy sprites (at most
+// MAX_ENEMY_ANIMATION_FRAMES distinct frames are used)
+EnemyAnimationSequence build_enemy_animation_sequence(
     uint8_t num_distinct_frames,
     uint8_t animation_type
 );
@@ -80,23 +174,82 @@ public:
     // Initialize - must be called after construction
     bool initialize();
     
-    // Tileset loading/management
+    // Tileset loading/management. The name-based calls are for loading; they
+    // intern the level name into a TilesetId that the id-based calls index.
     bool load_tileset(const std::string& level_name);
     Tileset* get_tileset(const std::string& level_name);
     void set_tileset_blackout(const std::string& level_name, bool blackout);
     bool is_tileset_blacked_out(const std::string& level_name) const;
+    TilesetId find_tileset_id(const std::string& level_name) const;
+    Tileset* get_tileset(TilesetId id);
+    void set_tileset_blackout(TilesetId id, bool blackout);
     
-    // Sprite loading
+    // Sprite loading. load_sprite_id loads a sprite once and returns its handle
+    // (INVALID_SPRITE_ID on failure); get_sprite(SpriteId) is the hot-path lookup.
+    SpriteId load_sprite_id(const std::string& sprite_name, const std::string& direction);
+    const Sprite* get_sprite(SpriteId id) const {
+        return id < sprites.size() ? &sprites[id] : nullptr;
+    }
+    // String-keyed wrappers for loading and debugging. The returned pointer is
+    // only valid until the next sprite is loaded.
     bool load_sprite(const std::string& sprite_name, const std::string& direction);
-    Sprite* get_sprite(const std::string& sprite_name, const std::string& direction);
+    SpriteId find_sprite_id(const std::string& sprite_name, const std::string& direction) const;
+    const Sprite* get_sprite(const std::string& sprite_name, const std::string& direction) const;
     
     // Enemy sprite loading
     SpriteAnimationData* load_enemy_sprite(const struct shp_t& sprite_desc);
     
+    // Asynchronous loading. request_* queues the PNG decodes on the worker pool
+    // and returns immediately (true if the asset is loaded or in flight; urgent
+    // requests jump the decode queue). pump_asset_uploads() turns finished
+    // decodes into textures on the render thread, up to max_uploads textures per
+    // call (always at least one request). load_tileset/load_enemy_sprite remain
+    // the blocking path: they complete a pending request or load on the spot.
+    // An urgent request for an asset already in flight promotes its decodes.
+    bool request_tileset(const std::string& level_name, bool urgent = false);
+    bool request_enemy_sprite(const struct shp_t& sprite_desc, bool urgent = false);
+    // True if loading the asset now would not wait on a decode: it is loaded,
+    // or every decode of its pending request has finished.
+    bool is_tileset_ready(const std::string& level_name) const;
+    bool is_enemy_sprite_ready(const struct shp_t& sprite_desc) const;
+    void pump_asset_uploads(int max_uploads = ASSET_UPLOADS_PER_FRAME);
+    size_t get_pending_asset_count() const;
+    // Sprites are only decoded ahead: load_sprite_id uploads a requested
+    // sprite (waiting for its decode if need be) and hands out its handle.
+    bool request_sprite(const std::string& sprite_name, const std::string& direction, bool urgent = false);
+    // Requested sprites whose decode has not finished yet
+    size_t get_pending_sprite_decodes() const;
+    // One image decode by file name (see load_asset_surface) on the worker
+    // pool; wait_asset_surface hands over the surface, nullptr if it failed.
+    DecodeTicket request_asset_surface(const std::string& filename, bool urgent = false);
+    SDL_Surface* wait_asset_surface(DecodeTicket& ticket);
+    // The decode workers, shared with the startup LoadGraph's worker tasks
+    AssetDecodePool& get_decode_pool();
+    
+    // Texture cache. Once the resident total exceeds the budget (0 = unlimited,
+    // the default) tilesets and enemy sprites are evicted least recently used
+    // first, skipping anything pinned since the last begin_texture_pins(); an
+    // evicted asset reloads on its next request. Plain sprites are held by
+    // value in UI and player animations, so they count against the budget but
+    // are never evicted. The budget is enforced from pump_asset_uploads(),
+    // after the frame has been drawn.
+    void set_texture_budget(size_t bytes);
+    size_t get_texture_budget() const;
+    void begin_texture_pins();
+    void pin_tileset(const std::string& level_name);
+    void pin_enemy_sprite(const struct shp_t& sprite_desc);
+    // Bumped whenever an evicted enemy sprite's SpriteAnimationData is freed;
+    // holders of load_enemy_sprite() pointers look them up again when it changes
+    uint32_t get_enemy_sprite_evictions() const { return enemy_sprite_evictions; }
+    TextureCacheStats get_texture_cache_stats(TextureCategory category) const;
+    size_t get_resident_texture_bytes() const;
+    
     // Animation management
     Animation create_animation(const std::vector<std::string>& sprite_names, const std::string& direction, int frame_duration_ms, bool looping = true);
     AnimationFrame* get_current_frame(Animation& anim);
-    void update_animation(Animation& anim, uint32_t current_time);
+    // Pick the frame shown at current_time; returns when the next frame is
+    // due (same clock), or 0 if the frame shown will not change again
+    uint32_t update_animation(Animation& anim, uint32_t current_time);
     
     // Rendering
     void render_tile(int screen_x, int screen_y, Tileset* tileset, uint8_t tile_id, int scale);
@@ -112,34 +265,221 @@ public:
                                        int width, int full_height, int clip_height,
                                        bool flip_h = false);
     
-    // Text rendering
+    // Batched sprite queue. Between begin_sprite_batch() and flush_sprite_batch()
+    // the render_sprite* calls are queued under the current layer instead of being
+    // drawn. flush_sprite_batch() sorts by layer, keeping submission order within
+    // a layer, and submits each run of adjacent same-texture sprites as one
+    // SDL_RenderGeometry call (horizontal flips are UV swaps). Flush before
+    // changing viewport, scale or render target.
+    void begin_sprite_batch();
+    void set_render_layer(RenderLayer layer);
+    void flush_sprite_batch();
+    // Counters for the last completed frame (reset by begin_frame)
+    RenderQueueStats get_render_queue_stats() const;
+    
+    // Stage background cache: the map chunks (32x10 tiles, see tile_map.h) in
+    // view pre-rendered at native tile resolution, one render-target texture
+    // each, keyed by their place on the map so a streamed stage's window can
+    // move under them. A chunk is redrawn when the game's stage tiles change
+    // (see get_stage_tiles_revision), when a different tileset is passed in, or
+    // after a blackout change. Both calls draw relative to the current viewport
+    // and return false if the cache is unavailable, in which case the caller
+    // should fall back to per-tile render_tile calls.
+    bool render_stage_background(const GameContext& game, Tileset* tileset, int camera_x, int scale);
+    // Copy a rectangle of world tiles (game units) from chunks already cached,
+    // e.g. to restore the wall columns beside an animating door.
+    bool render_stage_background_region(const GameContext& game, int world_x, int world_y,
+                                        int width_units, int height_units, int camera_x, int scale);
+    void invalidate_stage_background();
+    
+    // Horizontal pixel shift added to tiles, the stage background and sprites
+    // (sub-tick camera interpolation; 0 draws the snapped camera). Set it
+    // around the world drawing only, not the HUD or overlays.
+    void set_world_offset(int offset_x);
+    int get_world_offset() const { return world_offset_x; }
+    
+    // Renderer the system draws with, for callers that keep their own
+    // render-target layers (e.g. the cached HUD in UISystem).
+    SDL_Renderer* get_renderer() const;
+    
+    // Text rendering (debug font, drawn from its glyph atlas)
     void render_text(int screen_x, int screen_y, const std::string& text, SDL_Color color);
+    void render_text(int screen_x, int screen_y, const char* text, SDL_Color color);
+    // Whether a debug font was found; without one render_text draws nothing
+    bool has_text_font() const { return debug_atlas != nullptr; }
     
     // Debug rendering
-    void render_debug_overlay();
+    void render_debug_overlay(const GameContext& game);
     
     // Utility: Compute letterboxed destination rect for 320x200 EGA content
     static SDL_Rect compute_letterbox_rect(SDL_Renderer* renderer);
     
+    // Native-resolution render path: when enabled, gameplay frames are drawn at
+    // 1:1 into one EGA_WIDTH x EGA_HEIGHT target and upscaled once (nearest
+    // neighbour) into the letterbox rect, so fill cost is independent of window
+    // size. Enabling fails (and the direct path stays active) without render
+    // target support.
+    bool set_native_framebuffer_enabled(bool enabled);
+    bool is_native_framebuffer_enabled() const;
+    // Clear and bind the frame destination (native target or window).
+    void begin_frame();
+    // Upscale the native target into the window (no-op in direct mode). After this
+    // call, drawing happens in window space; the caller still presents.
+    void end_frame();
+    // Where end_frame() upscales to and leaves bound: the window (nullptr, the
+    // default) or an offscreen target such as a FrameCapture frame.
+    void set_frame_target(SDL_Texture* target);
+    // Rect the 320x200 gameplay frame (HUD background, playfield) is laid out in
+    // for the current frame: the letterbox rect, or {0, 0, 320, 200} when native.
+    SDL_Rect get_gameplay_frame_rect() const;
+    
     // Cleanup
     
 private:
     void cleanup();
+    // Stacked per-phase bars of the frame profiler's recent frames
+    void render_frame_time_graph(int x, int y);
+    void render_counters_panel(int x, int y);
     SDL_Renderer* renderer;
     bool img_inited;
     bool ttf_inited;
     TTF_Font* debug_font;  // Font for debug overlay text
-    std::map<std::string, Tileset> tilesets;
-    std::map<std::string, bool> tileset_blackout;
-    std::map<std::string, Sprite> sprites;
-    std::map<std::string, SpriteAnimationData*> enemy_sprites;  // Enemy sprite animation data
+    GlyphAtlas* debug_atlas;  // Shared atlas for debug_font (see acquire_glyph_atlas)
+    
+    // Tileset registry: entries are created by name on first use (a blackout
+    // may be configured before the tiles load) and never move.
+    struct TilesetEntry {
+        std::string name;
+        Tileset tileset;
+        bool loaded = false;
+        bool blackout = false;
+        size_t bytes = 0;             // Atlas size while loaded
+        uint32_t last_used = 0;       // use_clock stamp for LRU eviction
+        uint32_t pin_generation = 0;  // Pinned while equal to pin_generation
+    };
+    std::vector<std::unique_ptr<TilesetEntry>> tilesets;
+    std::unordered_map<std::string, TilesetId> tileset_ids;
+    TilesetId intern_tileset(const std::string& level_name);
+    
+    // Sprite registry: SpriteId indexes sprites; sprite_ids is load-time only
+    std::vector<Sprite> sprites;
+    std::unordered_map<std::string, SpriteId> sprite_ids;
+    
+    // Enemy sprite animation data, matched against shp_t descriptors without
+    // building string keys (stages reload their enemies on every door/teleport)
+    struct EnemySpriteEntry {
+        char filename[sizeof(shp_t::filename)];
+        uint8_t num_distinct_frames;
+        uint8_t horizontal;
+        uint8_t animation;
+        SpriteAnimationData* data;
+        size_t bytes = 0;
+        uint32_t last_used = 0;
+        uint32_t pin_generation = 0;
+        
+        bool matches(const shp_t& sprite_desc) const;
+    };
+    std::vector<EnemySpriteEntry> enemy_sprites;
+    
+    // Asynchronous loads waiting for their decodes (see request_tileset)
+    struct PendingTileset {
+        TilesetId id;
+        std::vector<DecodeTicket> tiles;
+    };
+    struct PendingEnemySprite {
+        EnemySpriteEntry key;  // data is unused until the sprite is finished
+        std::string name;
+        std::vector<DecodeTicket> left;
+        std::vector<DecodeTicket> right;
+    };
+    AssetPack asset_pack;  // Closed unless initialize() found assets.pak
+    OriginalAssetReader original_assets;  // Empty unless initialize() found original/
+    std::unique_ptr<AssetDecodePool> decode_pool;  // Created on first request
+    std::vector<PendingTileset> pending_tilesets;
+    std::vector<PendingEnemySprite> pending_enemy_sprites;
+    struct PendingSprite {
+        std::string key;  // sprite_ids key
+        std::string filename;
+        DecodeTicket ticket;
+    };
+    std::vector<PendingSprite> pending_sprites;
+    
+    // Texture cache state
+    size_t texture_budget;
+    TextureCacheStats texture_stats[static_cast<size_t>(TextureCategory::COUNT)];
+    uint32_t use_clock;
+    uint32_t pin_generation;
+    uint32_t enemy_sprite_evictions;
+    
+    // Stage background cache state
+    struct StageChunk {
+        SDL_Texture* texture = nullptr;
+        const void* source = nullptr;    // Map drawn from: the tile_map, or the tiles viewed
+        uint32_t revision = 0;           // ...and their get_stage_tiles_revision
+        int32_t chunk = -1;              // Chunk index on that map; -1 when stale
+        const Tileset* tileset = nullptr;
+        uint32_t last_used = 0;
+    };
+    StageChunk stage_chunks[STAGE_BACKGROUND_CHUNK_SLOTS];
+    uint32_t stage_chunk_clock;
+    const Tileset* stage_background_tileset;  // Last tileset drawn with, for region copies
+    bool stage_background_unsupported;  // Render targets unavailable; stop retrying
+    
+    // Batched sprite queue state
+    std::vector<QueuedSprite> sprite_queue;
+    std::vector<SDL_Vertex> batch_vertices;
+    std::vector<int> batch_indices;
+    RenderLayer current_layer;
+    bool batching;
+    RenderQueueStats frame_stats;       // Frame in progress
+    RenderQueueStats last_frame_stats;  // Last completed frame
+    
+    // Native 320x200 framebuffer (nullptr when the direct path is active)
+    SDL_Texture* native_frame;
+    bool native_frame_bound;
+    SDL_Texture* frame_target;
+    
+    // Texture of the last render call, for Counter::TEXTURE_SWITCHES
+    SDL_Texture* last_render_texture;
+    
+    int world_offset_x;
     
     // Helper functions
-    TextureInfo load_png(const std::string& filepath);
-    // Load N individual PNG frames: {base_path}-0.png, {base_path}-1.png, ...
-    std::vector<TextureInfo> load_animation_frames(
+    void count_render_call(SDL_Texture* texture);
+    void submit_sprite(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, bool flip_h);
+    void draw_sprite_run(const QueuedSprite* run, size_t count);
+    StageChunk* find_stage_chunk(const GameContext& game, const Tileset* tileset, int32_t chunk);
+    StageChunk* draw_stage_chunk(const GameContext& game, Tileset* tileset, int32_t chunk);
+    bool copy_stage_chunks(const GameContext& game, Tileset* tileset, int world_x, int world_y,
+                           int width_units, int height_units, int camera_x, int scale);
+    void invalidate_stage_chunks(const Tileset* tileset);
+    SDL_Surface* load_surface(const std::string& filepath);
+    TextureInfo load_png(const std::string& filename);
+    TextureInfo upload_surface(SDL_Surface* surface);
+    bool decodes_finished(const std::vector<DecodeTicket>& tickets) const;
+    bool finish_tileset(PendingTileset& pending);
+    TextureCacheStats& stats_for(TextureCategory category);
+    void enforce_texture_budget();
+    void evict_tileset(TilesetEntry& entry);
+    void evict_enemy_sprite(size_t index);
+    SpriteAnimationData* finish_enemy_sprite(PendingEnemySprite& pending);
+    // Queue decodes of N individual PNG frames: {base_path}-0.png, {base_path}-1.png, ...
+    std::vector<DecodeTicket> queue_animation_frames(
         const std::string& base_path,
         int expected_frames,
+        bool urgent
+    );
+    // Queue decodes of count frames of an original .shp file from first_frame on
+    std::vector<DecodeTicket> queue_shp_frames(
+        const std::string& shp_name,
+        int first_frame,
+        int count,
+        bool urgent
+    );
+    // Wait for the decodes and upload them; empty if any frame is missing
+    std::vector<TextureInfo> upload_animation_frames(
+        const std::string& base_path,
+        std::vector<DecodeTicket>& tickets,
         const std::string& label
     );
 
@@ -148,6 +488,12 @@ public: // made public for testing convenience
     // appropriate subdirectory.  This is used internally and also verified by
     // unit tests to prevent regressions when reorganizing the asset tree.
     std::string get_asset_path(const std::string& filename);
+    
+    // Decode an image by file name (e.g. "sys000.ega.png"). Tiles and
+    // full-screen images come straight from the original game files when
+    // initialize() found them, then from the asset pack, else loose files.
+    // Safe to call from decode workers; the caller frees the surface.
+    SDL_Surface* load_asset_surface(const std::string& filename);
 
 private:
 };
@@ -0,0 +1,65 @@
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One gameplay key press, from the event to the first frame showing its tick
+struct InputLatencySample {
+    uint8_t key = 0;          // INPUT_* bit
+    uint32_t event_ms = 0;    // SDL event timestamp
+    uint32_t poll_ms = 0;     // When SDL_PollEvent handed it over
+    uint64_t tick = 0;        // Gameplay tick that first read the key
+    uint32_t tick_ms = 0;     // When that tick ran
+    uint32_t present_ms = 0;  // First SDL_RenderPresent after the tick
+};
+
+/**
+ * InputLatencyTracker - input-to-photon timing for the windowed loop
+ *
+ * Keys only reach the game when the next ~9.1 Hz tick reads the key
+ * states, and the result only reaches the screen at the next present.
+ * Feed the tracker every gameplay key edge, every tick and every present;
+ * each press becomes a sample once a present follows the tick that read
+ * it. Presses released before any tick read them are counted as lost,
+ * which is the original game's behaviour for quick taps.
+ *
+ * All times are SDL_GetTicks milliseconds, the clock of event timestamps.
+ */
+class InputLatencyTracker {
+public:
+    void set_enabled(bool enable) { enabled = enable; }
+    bool is_enabled() const { return enabled; }
+
+    // SDL_KEYDOWN (not a repeat) for the keys in the INPUT_* mask
+    void record_press(uint8_t keys, uint32_t event_ms, uint32_t poll_ms);
+    // SDL_KEYUP for the keys in the mask
+    void record_release(uint8_t keys);
+    // A gameplay tick is about to read the key states
+    void record_tick(uint64_t tick, uint32_t now_ms);
+    // Right after SDL_RenderPresent
+    void record_present(uint32_t now_ms);
+    // The key states were cleared (pause, quick load, rewind): forget open presses
+    void discard_pending();
+
+    const std::vector<InputLatencySample>& get_samples() const { return samples; }
+    uint64_t get_lost_presses() const { return lost_presses; }
+
+    // "key,event_ms,poll_ms,tick,tick_ms,present_ms" rows, one per sample
+    bool write_csv(const std::string& path) const;
+
+private:
+    struct OpenPress {
+        InputLatencySample sample;
+        bool ticked = false;
+    };
+
+    bool enabled = false;
+    std::vector<OpenPress> open_presses;
+    std::vector<InputLatencySample> samples;
+    uint64_t lost_presses = 0;
+};
+
+#endif // INPUT_LATENCY_H
@@ -1,6 +1,7 @@
 #ifndef LEVEL_H
 #define LEVEL_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -93,6 +94,23 @@ struct enemy_record_t {
     uint8_t behavior;               /* ENEMY_BEHAVIOR_* constant (may include FAST flag) */
 };
 
+/**
+ * stage_tiles_t - Read-only view of a stage's 128×10 tile map
+ * 
+ * Points into the constant arrays of level_tiles.cpp instead of holding a
+ * copy. A fixed-size stand-in for std::span<const uint8_t, 1280>, which is
+ * not available in C++17; converts to const uint8_t* for existing callers.
+ */
+struct stage_tiles_t {
+    const uint8_t* data;
+
+    static constexpr size_t size() { return 128 * 10; }
+    const uint8_t* begin() const { return data; }
+    const uint8_t* end() const { return data + size(); }
+    uint8_t at(int tile_x, int tile_y) const { return data[tile_y * 128 + tile_x]; }
+    operator const uint8_t*() const { return data; }
+};
+
 /**
  * stage_t - Single stage descriptor
  * 
@@ -108,7 +126,7 @@ struct stage_t {
     uint8_t exit_r;                 /* Right exit: target stage number or EXIT_UNUSED */
     door_t doors[MAX_NUM_DOORS];    /* Up to 3 doors per stage */
     enemy_record_t enemies[MAX_NUM_ENEMIES]; /* Up to 4 enemies per stage */
-    uint8_t tiles[128 * 10];        /* 128×10 tile map (1280 bytes) */
+    stage_tiles_t tiles;            /* 128×10 tile map (view into level_tiles.cpp) */
 };
 
 /**
@@ -2,24 +2,29 @@
 #define LEVEL_LOADER_H
 
 #include "level.h"
+#include <cstdint>
 #include <string>
 
+struct GameContext;
+class GraphicsSystem;
+class TileMap;
+
 /**
  * Initialize all level data 
  * 
- * Populates runtime level structures with pre-generated compiled-in tile data.
- * Call this once at game startup before using any level data.
+ * The level tables and their tile maps are constant-initialised, so this only
+ * marks them ready. Call this once at game startup before using any level data.
  * 
  */
 void initialize_level_data();
 
 /**
- * Get runtime-initialized level data by name (case-insensitive)
+ * Get level data by name (case-insensitive)
  * Returns nullptr if level not found
  * 
- * The returned level_t contains fully loaded tile data for all stages.
+ * The returned level_t is read-only and views the tile data of all stages.
  */
-level_t* get_level_data(const std::string& level_name);
+const level_t* get_level_data(const std::string& level_name);
 
 /**
  * load_new_level - Load a new level's data and assets
@@ -27,9 +32,18 @@ level_t* get_level_data(const std::string& level_name);
  * Initializes the tileset for the current level and loads the first stage.
  * Called when a door leads to a different level.
  * 
- * Requires current_level_number to be set before calling.
+ * Requires game.current_level_number to be set before calling.
+ */
+void load_new_level(GameContext& game);
+
+/**
+ * load_level_graphics - Load the current level's tileset into game.graphics
+ * 
+ * Applies the castle blackout unless Comic has the Lantern. Part of
+ * load_new_level; also used when a level is restored from a snapshot.
+ * Does nothing without a graphics system.
  */
-void load_new_level();
+void load_level_graphics(GameContext& game);
 
 /**
  * load_new_stage - Load a new stage within the current level
@@ -38,8 +52,65 @@ void load_new_level();
  * Handles door entry positioning and camera setup.
  * Called for stage transitions within same level or at startup.
  * 
- * Requires current_level_ptr and current_stage_number to be set before calling.
+ * Requires game.current_level_ptr and game.current_stage_number to be set before calling.
+ */
+void load_new_stage(GameContext& game);
+
+/**
+ * PrefetchStats - effectiveness of the neighbour prefetcher
+ *
+ * A stage entry is a hit when its tileset and enemy sprites were ready
+ * (no decode left to wait on) at the moment the transition loaded them.
+ */
+struct PrefetchStats {
+    uint32_t stages_requested;  /* Neighbour stages queued for prefetch */
+    uint32_t escalations;       /* Door destinations promoted to urgent */
+    uint32_t hits;
+    uint32_t misses;
+};
+
+/**
+ * prefetch_stage_neighbours - Warm the assets of every stage reachable from here
+ *
+ * Queues background decodes for the tileset and enemy sprites of the left/right
+ * exits and door targets of the current stage, and pins them together with the
+ * current stage's assets in the texture cache (through game.graphics; without
+ * one only the statistics are kept). Called by load_new_stage.
+ */
+void prefetch_stage_neighbours(GameContext& game);
+
+/**
+ * prefetch_door_destination - Escalate one door target to high priority
+ *
+ * Called when a door opens, so the decodes finish during the door animation.
+ */
+void prefetch_door_destination(GameContext& game, uint8_t level_number, uint8_t stage_number);
+
+/**
+ * prefetch_starting_stage - Queue the decodes of the stage a new game starts on
+ *
+ * Startup calls this so the first stage's tileset and enemy sprites decode
+ * while the title sequence plays.
+ */
+void prefetch_starting_stage(GraphicsSystem* graphics);
+
+// Totals across every game context in the process
+PrefetchStats get_prefetch_stats();
+void reset_prefetch_stats();
+
+/**
+ * Streamed stage maps - wider maps played in place of a built-in stage
+ *
+ * initialize_level_data looks once for assets/maps/<stage .PT file>.cctm
+ * (say forest0.pt.cctm, see tile_map.h) and keeps any map it finds open for
+ * the rest of the process; stages without one keep their compiled-in 128x10
+ * map. A streamed stage still takes its exits, doors, item and enemies from
+ * its level_t record, with doors and the item in the map's first 256 units.
  */
-void load_new_stage();
+const TileMap* get_stage_tile_map(const level_t* level, int stage_number);
+// Stream a stage from this file instead; call before any game loads the stage
+bool attach_stage_tile_map(uint8_t level_number, uint8_t stage_number, const std::string& path);
+// Back to the compiled-in maps; no game may still be on a streamed stage
+void detach_stage_tile_maps();
 
 #endif /* LEVEL_LOADER_H */
@@ -0,0 +1,115 @@
+#ifndef LOAD_GRAPH_H
+#define LOAD_GRAPH_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include "asset_loader.h"
+
+// Where a LoadGraph task runs
+enum class LoadThread : uint8_t {
+    WORKER,  // On the worker pool, alongside the image decodes
+    RENDER   // On the render thread: anything touching the renderer or the game
+};
+
+// Index of a task in its LoadGraph, in the order the tasks were added
+using LoadTaskId = uint16_t;
+
+// How one task went, in milliseconds from the graph's origin
+struct LoadTaskTiming {
+    std::string name;
+    LoadThread thread = LoadThread::RENDER;
+    double start_ms = -1.0;  // -1 until the task has run
+    double end_ms = -1.0;
+    bool succeeded = false;
+};
+
+/**
+ * LoadGraph - startup loads as a dependency graph of tasks
+ *
+ * A task is a named step returning whether it succeeded. It runs once every
+ * task it depends on has finished; a failed dependency does not hold its
+ * dependents back, they see whatever it left. WORKER tasks are handed to an
+ * AssetDecodePool and run beside the image decodes; RENDER tasks run on the
+ * render thread, between frames from pump() or on demand from wait(). A
+ * RENDER task may have a ready check (say, that its decodes are done) so
+ * that pump() leaves it until running it would not block.
+ *
+ * The graph itself is driven from the render thread only. Every task's start
+ * and end is timed from the graph's origin, as is the first present, so
+ * print_report() shows what the first frame waited on.
+ */
+class LoadGraph {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<bool()>;
+    using ReadyCheck = std::function<bool()>;
+
+    // Without a pool, WORKER tasks run on the render thread like the rest
+    explicit LoadGraph(AssetDecodePool* worker_pool = nullptr, Clock::time_point origin = Clock::now());
+    ~LoadGraph();
+    LoadGraph(const LoadGraph&) = delete;
+    LoadGraph& operator=(const LoadGraph&) = delete;
+
+    // Dependencies are tasks added earlier, so the graph has no cycles
+    LoadTaskId add(const std::string& name, LoadThread thread, Task task,
+                   std::initializer_list<LoadTaskId> dependencies = {}, ReadyCheck ready = nullptr);
+    // A finished step that ran outside the graph (e.g. opening the window)
+    void record(const std::string& name, Clock::time_point start, Clock::time_point end);
+
+    // Hand every WORKER task whose dependencies are done to the pool, then
+    // run due RENDER tasks for up to budget_ms (at least one, if any is
+    // due). Returns is_finished().
+    bool pump(double budget_ms);
+    // Run a task now, with what it depends on first: waits for WORKER tasks
+    // and ignores ready checks. Returns whether the task succeeded.
+    bool wait(LoadTaskId id);
+    // wait() on every task; true if all of them succeeded
+    bool finish();
+    // Drop the tasks that have not started and wait for the WORKER tasks
+    // that have. Call before the pool goes away (the destructor does too).
+    void cancel();
+
+    bool is_done(LoadTaskId id) const;
+    bool is_finished() const;
+
+    double elapsed_ms() const;
+    // The first present; later calls are ignored
+    void mark_first_frame();
+    double get_first_frame_ms() const { return first_frame_ms; }
+    std::vector<LoadTaskTiming> get_timings() const;
+    // Time to first frame and every task's start, duration and thread
+    void print_report(std::ostream& out) const;
+
+private:
+    enum class State : uint8_t { WAITING, RUNNING, DONE };
+
+    struct Node {
+        LoadTaskTiming timing;  // Written by the worker running a WORKER task
+        Task task;
+        ReadyCheck ready;
+        std::vector<LoadTaskId> dependencies;
+        DecodeTicket ticket;  // WORKER task handed to the pool
+        State state = State::WAITING;
+    };
+
+    bool dependencies_done(const Node& node) const;
+    bool runs_on_worker(const Node& node) const;
+    void run_node(Node& node);
+    void dispatch(Node& node);
+    void collect_workers();
+
+    AssetDecodePool* pool;
+    Clock::time_point origin;
+    std::vector<std::unique_ptr<Node>> nodes;  // Boxed: workers write into them
+    std::atomic<bool> cancelled;
+    double first_frame_ms;
+};
+
+#endif // LOAD_GRAPH_H
@@ -0,0 +1,73 @@
+#ifndef ORIGINAL_ASSETS_H
+#define ORIGINAL_ASSETS_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Graphics data layouts of the original R5sw1991 files
+constexpr int EGA_TILE_SIZE = 16;                            // TT2 tiles and SHP frames are 16x16
+constexpr size_t EGA_TILE_PLANE_BYTES = 16 * 16 / 8 * 4;     // 128: four bit planes
+constexpr size_t EGA_SHP_FRAME_BYTES = EGA_TILE_PLANE_BYTES + 16 * 16 / 8;  // + 32-byte mask
+constexpr size_t EGA_TT2_HEADER_BYTES = 4;
+constexpr int EGA_SCREEN_WIDTH = 320;
+constexpr int EGA_SCREEN_HEIGHT = 200;
+constexpr size_t EGA_SCREEN_PLANE_BYTES = 320 * 200 / 8;     // 8000
+
+// The 16-colour EGA palette the original game runs with
+extern const SDL_Color EGA_PALETTE[16];
+
+/**
+ * Convert planar EGA pixels to one palette index per pixel. Plane p (0-3)
+ * holds bit p of every pixel and starts at p * pixel_count / 8; within a
+ * plane, the most significant bit is the leftmost pixel. pixel_count must be
+ * a multiple of 8. Uses an SSE2 bit-transpose where available, else a
+ * lookup-table SWAR kernel.
+ */
+void ega_planar_to_indices(const uint8_t* planes, size_t pixel_count, uint8_t* indices);
+
+/**
+ * Decode the RLE-compressed planes of a full-screen .EGA file (u16 plane
+ * size, then per plane: control byte c < 128 copies c literal bytes, c >= 128
+ * repeats the next byte c - 128 times). planes receives 4 * plane_size bytes.
+ * Returns false on truncated or malformed data.
+ */
+bool ega_rle_decode(const uint8_t* data, size_t size, uint8_t* planes, size_t plane_size);
+
+/**
+ * OriginalAssetReader - loads graphics straight from the original game files
+ *
+ * open() indexes a directory such as original/ once (file names are matched
+ * case-insensitively, as DOS stored them in upper case). Files are read on
+ * first use and kept; the load_* calls are safe from decode workers.
+ */
+class OriginalAssetReader {
+public:
+    bool open(const std::string& directory);
+    bool is_open() const { return !paths.empty(); }
+    // Whether the directory has the file, e.g. "forest.tt2" or "fb.shp"
+    bool has_file(const std::string& name) const;
+
+    // One tile of "{level_name}.tt2" as an opaque RGBA32 surface; nullptr if
+    // the tileset has fewer tiles.
+    SDL_Surface* load_tile(const std::string& level_name, int tile_index) const;
+    // One 16x16 frame of a .shp file as RGBA32 with its mask as alpha.
+    SDL_Surface* load_shp_frame(const std::string& shp_name, int frame_index) const;
+    // A full-screen .EGA image (e.g. "sys000.ega") as an 8-bit surface with
+    // the EGA palette, like the extracted PNGs.
+    SDL_Surface* load_fullscreen(const std::string& ega_name) const;
+
+private:
+    const std::vector<uint8_t>* get_file(const std::string& name) const;
+
+    std::unordered_map<std::string, std::string> paths;  // Lower-case name -> path
+    mutable std::mutex cache_mutex;
+    mutable std::unordered_map<std::string, std::unique_ptr<std::vector<uint8_t>>> cache;
+};
+
+#endif // ORIGINAL_ASSETS_H
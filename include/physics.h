@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <string>
+#include "collision_map.h"
 
 // Physics constants (from jsandas/comic-c physics.h)
 constexpr int COMIC_GRAVITY = 5;           // Gravity (units of 1/8 game units per tick)
@@ -20,6 +21,10 @@ constexpr int MAP_HEIGHT = 20;             // Map height in game units (10 * 2)
 constexpr int PLAYFIELD_WIDTH = 24;        // Visible playfield width in game units
 constexpr int PLAYFIELD_HEIGHT = 20;       // Visible playfield height in game units
 
+// Tile column across a whole streamed map (see tile_map.h), which may be far
+// wider than the MAP_WIDTH_TILES window that game units address
+using MapCoord = int32_t;
+
 // Player gameplay constants
 constexpr uint8_t MAX_HP = 6;              // Maximum health points
 
@@ -27,25 +32,47 @@ constexpr uint8_t MAX_HP = 6;              // Maximum health points
 constexpr uint8_t COMIC_FACING_LEFT = 0;
 constexpr uint8_t COMIC_FACING_RIGHT = 1;
 
-// Cheat system flags
-extern bool cheat_noclip;  // When true, disables collision detection
+struct GameContext;
+
+// Noclip cheat: sets cheat_noclip and masks player solidity
+void set_noclip(GameContext& game, bool enabled);
 
 // Functions
-void process_jump_input();
-void handle_fall_or_jump();
-bool move_left();
-bool move_right();
-void trigger_player_death(bool show_animation = true, bool fall_clip_render = false);
-void update_player_death_sequence();
-bool is_player_dying();
-bool should_show_player_death_animation();
-bool should_clip_player_death_render();
+void process_jump_input(GameContext& game);
+void handle_fall_or_jump(GameContext& game);
+bool move_left(GameContext& game);
+bool move_right(GameContext& game);
+void trigger_player_death(GameContext& game, bool show_animation = true, bool fall_clip_render = false);
+void update_player_death_sequence(GameContext& game);
+bool is_player_dying(const GameContext& game);
+bool should_show_player_death_animation(const GameContext& game);
+bool should_clip_player_death_render(const GameContext& game);
 
 // Tile system
-void init_test_level();
-void reset_level_tiles();
-bool load_stage_tiles(const std::string& level_name, int stage_number);
-uint8_t get_tile_at(uint8_t x, uint8_t y);
-bool is_tile_solid(uint8_t tile_id);
+void init_test_level(GameContext& game);
+void reset_level_tiles(GameContext& game);
+bool load_stage_tiles(GameContext& game, const std::string& level_name, int stage_number);
+// Tile under a point in game units of the current window; outside it, 0 (passable)
+uint8_t get_tile_at(const GameContext& game, int x, int y);
+// Tile by map column and row; columns outside the resident window read as 0
+uint8_t get_map_tile(const GameContext& game, MapCoord tile_x, int tile_y);
+// Incremented whenever the current stage tile map is replaced; lets render
+// caches detect that they need to be rebuilt.
+uint32_t get_stage_tiles_revision(const GameContext& game);
+bool is_tile_solid(const GameContext& game, uint8_t tile_id);
+// Rebuild the tile solidity table for a level (load_new_level does this once
+// per level; load_stage_tiles does it if the stage belongs to another level)
+void set_level_solidity(GameContext& game, const level_t* level);
+// Solidity bitboard of the current stage, rebuilt by load_stage_tiles. Not
+// affected by noclip, so enemies can share it.
+const CollisionBitboard& get_stage_collision(const GameContext& game);
+
+// Streamed stages: read the window of game.tile_map that starts at
+// first_tile_x (rounded down to a chunk, kept inside the map) and move
+// Comic, the camera and the actors with it, so they stay put on the map
+void move_map_window(GameContext& game, MapCoord first_tile_x);
+// Move the window a chunk when the view reaches its first or last chunk and
+// the map goes on that way. Not during doors or teleports. True if it moved.
+bool update_map_window(GameContext& game);
 
 #endif // PHYSICS_H
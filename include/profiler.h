@@ -0,0 +1,137 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Phases of a windowed frame timed by the frame profiler
+ *
+ * Times are exclusive: while a marker is open inside another (ACTORS inside
+ * TICKS), the time goes to the inner one, so the phases of a frame add up to
+ * its wall time.
+ */
+enum class ProfilePhase : uint8_t {
+    OTHER = 0,        // Frame time outside any marker (animation, viewports, HUD background)
+    EVENTS,           // SDL_PollEvent loop
+    TICKS,            // Gameplay tick loop, less the actor updates inside it
+    ACTORS,           // ActorSystem::update
+    TILES,            // Stage background
+    DOORS_TELEPORT,   // Door animation overlays and teleport sprites
+    ACTOR_RENDER,     // Enemies, fireballs, Comic and the item
+    HUD,              // UISystem::render_hud
+    DEBUG_OVERLAY,    // GraphicsSystem::render_debug_overlay
+    PRESENT,          // SDL_RenderPresent
+    UPLOADS,          // GraphicsSystem::pump_asset_uploads
+    SPIN,             // FramePacer spinning out the last ms to the frame deadline
+    IDLE,             // FramePacer sleep (kept last: the overlay graph leaves it out)
+    COUNT
+};
+
+constexpr size_t PROFILE_PHASE_COUNT = static_cast<size_t>(ProfilePhase::COUNT);
+
+// Frames held by the ring (about 17 seconds at 60 fps)
+constexpr size_t PROFILE_RING_FRAMES = 1024;
+
+// Short lowercase name, as used for the CSV columns ("actors", "present", ...)
+const char* get_profile_phase_name(ProfilePhase phase);
+
+// One frame's time per phase
+struct ProfileFrame {
+    uint64_t frame_number = 0;
+    uint32_t ticks = 0;                           // Gameplay ticks run in the frame
+    float phase_ms[PROFILE_PHASE_COUNT] = {};
+    float present_interval_ms = 0.0f;             // Since the previous SDL_RenderPresent (0 if none)
+
+    float total_ms() const;
+};
+
+// Read by every marker, on whatever thread it runs (batch workers, the
+// --threaded simulation); set by enable_frame_profiler()
+extern std::atomic<bool> g_frame_profiler_enabled;
+
+inline bool is_frame_profiler_enabled() {
+    return g_frame_profiler_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Turn the markers on or off. Frames are recorded on the thread that enabled
+ * the profiler (the render thread); markers hit on other threads, like a
+ * batch job's actor updates, time nothing.
+ */
+void enable_frame_profiler(bool enabled);
+
+// Open / close a phase (use PROFILE_SCOPE instead)
+void profiler_push(ProfilePhase phase);
+void profiler_pop();
+
+// Mark the start of a frame, publishing the one before it to the ring
+void profiler_begin_frame();
+// Count gameplay ticks run in the current frame
+void profiler_add_ticks(uint32_t ticks);
+// Record the present-to-present interval ending in the current frame
+void profiler_set_present_interval(float interval_ms);
+
+/**
+ * Copy up to max_frames of the newest published frames into out, oldest
+ * first. For the recording thread (the debug overlay); returns the count.
+ */
+size_t copy_recent_profile_frames(ProfileFrame* out, size_t max_frames);
+
+/**
+ * Stream every published frame to a CSV file (frame, total_ms, ticks, one
+ * column per phase in ms, then present_interval_ms) from a background thread that drains the ring,
+ * so the frame loop never waits on the disk. Enables the profiler. Returns
+ * false if the file cannot be created or the markers were compiled out.
+ */
+bool start_perf_log(const std::string& path);
+
+// Write the frames still in the ring, close the file and report any frames
+// the writer fell behind on
+void stop_perf_log();
+
+/**
+ * ProfileScope - times the rest of the enclosing block as one phase
+ *
+ * Disabled, a scope costs a relaxed load of g_frame_profiler_enabled and one
+ * branch. With ENABLE_FRAME_PROFILER off in CMake, PROFILE_SCOPE compiles to
+ * nothing.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase) : active(is_frame_profiler_enabled()) {
+        if (active) {
+            profiler_push(phase);
+        }
+    }
+    ~ProfileScope() {
+        if (active) {
+            profiler_pop();
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    bool active;
+};
+
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+
+// PROFILE_BEGIN/PROFILE_END bracket a phase that is not one block (the
+// stretches of the main loop); every PROFILE_BEGIN needs its PROFILE_END on
+// all paths, or the phase runs on to the end of the frame
+#if defined(COMIC_FRAME_PROFILER)
+#define PROFILE_SCOPE(phase) ProfileScope PROFILE_SCOPE_CONCAT(profile_scope_, __LINE__)(phase)
+#define PROFILE_BEGIN(phase) do { if (is_frame_profiler_enabled()) profiler_push(phase); } while (0)
+#define PROFILE_END() do { if (is_frame_profiler_enabled()) profiler_pop(); } while (0)
+#else
+#define PROFILE_SCOPE(phase) static_cast<void>(0)
+#define PROFILE_BEGIN(phase) static_cast<void>(0)
+#define PROFILE_END() static_cast<void>(0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,62 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Gameplay keys as the bits of one byte per tick
+constexpr uint8_t INPUT_LEFT = 0x01;
+constexpr uint8_t INPUT_RIGHT = 0x02;
+constexpr uint8_t INPUT_JUMP = 0x04;
+constexpr uint8_t INPUT_FIRE = 0x08;
+constexpr uint8_t INPUT_OPEN = 0x10;
+constexpr uint8_t INPUT_TELEPORT = 0x20;
+constexpr uint8_t INPUT_KEYS_MASK = 0x3F;
+// Key and edge-trigger states were reset (pause, cutscene) before this tick
+constexpr uint8_t INPUT_KEYS_CLEARED = 0x80;
+
+// A state checksum is kept after every this many ticks
+constexpr uint64_t REPLAY_CHECKSUM_INTERVAL = 256;
+
+/**
+ * ReplayRecording - the input of one gameplay session, tick by tick
+ *
+ * The game has no random state, so the start conditions plus the keys held
+ * on each tick reproduce a session exactly; the checksums catch a simulation
+ * that no longer does.
+ *
+ * File layout: "CCRP", version, flags (bit 0: debug mode), start level and
+ * stage; varint tick count; varint change count, then per change the varint
+ * number of ticks since the previous change and the new key byte; varint
+ * checksum count, the checksums and the final checksum as little-endian
+ * u64. Held keys cost nothing, so a session is a few bytes per second.
+ * There is a checksum for every checksum tick, so decode() rejects a tick
+ * count they do not account for before allocating the keys.
+ */
+struct ReplayRecording {
+    bool debug_mode = false;
+    uint8_t start_level = 0;
+    uint8_t start_stage = 0;
+    std::vector<uint8_t> keys;        // INPUT_* bits, one entry per tick
+    std::vector<uint64_t> checksums;  // After each checksum tick, in order
+    uint64_t final_checksum = 0;      // After the last tick
+
+    static bool is_checksum_tick(uint64_t tick) {
+        return (tick + 1) % REPLAY_CHECKSUM_INTERVAL == 0;
+    }
+
+    uint64_t tick_count() const { return keys.size(); }
+    void record_tick(uint8_t tick_keys) { keys.push_back(tick_keys); }
+    void record_checksum(uint64_t checksum) { checksums.push_back(checksum); }
+    // The checksum recorded after tick, if it is a checksum tick that was recorded
+    bool checksum_after(uint64_t tick, uint64_t* checksum) const;
+
+    std::vector<uint8_t> encode() const;
+    bool decode(const uint8_t* data, size_t size);
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+#endif // REPLAY_H
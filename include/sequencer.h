@@ -0,0 +1,89 @@
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+/**
+ * Sequencer - scripted sequences (title screens, beam in/out, end-of-game
+ * tallies) as queued steps driven from the main loop
+ *
+ * A sequence is written up front as a list of steps: run an action, switch
+ * the scene drawn every frame, wait some ticks or milliseconds, or wait for
+ * a fresh key press. Each frame the loop hands over key presses, calls
+ * update() to run every step that is due, then draw() and presents as
+ * usual, so frame pacing, the profiler and audio carry on while a sequence
+ * waits and nothing blocks.
+ *
+ * Timed waits follow on from the previous wait's deadline rather than from
+ * the frame that noticed it, so a run of one-tick waits keeps the tick
+ * cadence however the frames fall. After a longer stall (a key wait, a slow
+ * frame) timing starts again from the current frame instead of hurrying the
+ * missed steps through.
+ */
+class Sequencer {
+public:
+    using Action = std::function<void()>;
+    using Condition = std::function<bool()>;
+
+    // ms_per_tick: length of one wait_ticks() tick
+    explicit Sequencer(double ms_per_tick = 0.0);
+
+    void set_ms_per_tick(double tick_ms) { ms_per_tick = tick_ms; }
+
+    // Queue steps; they run in order, after any already queued
+    void run(Action action);
+    void show(Action scene);      // draw() calls scene every frame from here on
+    void wait_ticks(int ticks);
+    void wait_ms(double duration_ms);
+    void wait_for_key();          // Only keys pressed once the wait has begun count
+    // A loop: whenever the step is reached and condition() holds, queue_pass
+    // queues one pass of steps, which run before the condition is checked
+    // again and ahead of the steps queued after the loop
+    void repeat_while(Condition condition, Action queue_pass);
+
+    // A key went down (not a repeat); SDL_KEYDOWN handling calls this
+    void on_key_down();
+
+    // Run every step due by now_ms (SDL_GetTicks); returns is_active()
+    bool update(uint32_t now_ms);
+
+    // Draw the current scene, if there is one
+    void draw() const;
+
+    // Steps are left to run; once the last has the scene is dropped too
+    bool is_active() const { return !steps.empty(); }
+
+    // Drop every queued step and the scene (and whatever they hold)
+    void clear();
+
+private:
+    enum class StepType : uint8_t {
+        RUN,
+        REPEAT,
+        SHOW,
+        WAIT_MS,
+        WAIT_KEY
+    };
+
+    struct Step {
+        StepType type = StepType::RUN;
+        Action action;
+        Condition condition;  // REPEAT only
+        double duration_ms = 0.0;
+    };
+
+    void push(StepType type, Action action, double duration_ms);
+
+    double ms_per_tick;
+    std::deque<Step> steps;
+    Action scene;
+    bool waiting = false;      // The front step is a wait that has begun
+    bool key_pressed = false;  // A key went down during the current key wait
+    double wait_start_ms = 0.0;
+    bool has_deadline = false; // The previous step was a timed wait ending at last_deadline_ms
+    double last_deadline_ms = 0.0;
+};
+
+#endif // SEQUENCER_H
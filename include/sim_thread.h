@@ -0,0 +1,137 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include "game_context.h"
+#include "gameplay.h"
+#include "spsc_queue.h"
+
+/**
+ * TripleBuffer - latest-value handoff from one writer thread to one reader
+ *
+ * The writer fills the back buffer and publishes it; the reader swaps in the
+ * newest published buffer, if there is one, and reads it for as long as it
+ * likes. Neither side ever waits: states the reader did not get to in time
+ * are simply replaced.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer
+    T& back_buffer() { return slots[back]; }
+    void publish() { back = middle.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX_MASK; }
+
+    // Reader: true if a newer buffer was swapped in
+    bool consume() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& front_buffer() const { return slots[front]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH = 0x04;  // Set on middle by publish, cleared by consume
+
+    T slots[3];
+    uint8_t back = 0;                 // Writer only
+    std::atomic<uint8_t> middle{1};   // Slot index, plus FRESH
+    uint8_t front = 2;                // Reader only
+};
+
+// What the render thread tells the simulation thread
+enum class SimInputType : uint8_t {
+    KEY_DOWN,  // keys (INPUT_* bits) pressed; key also goes to the debug cheats
+    KEY_UP,    // keys released
+    PAUSE,     // Stop ticking and clear the key states
+    RESUME     // Clear the key states and tick again, a whole tick from now
+};
+
+struct SimInput {
+    SimInputType type = SimInputType::KEY_DOWN;
+    uint8_t keys = 0;
+    SDL_Keycode key = SDLK_UNKNOWN;
+};
+
+// One published tick, complete enough to draw a frame from
+struct SimRenderState {
+    GameContext game;               // After the tick; graphics is null and enemies have no animation data
+    uint64_t tick = 0;              // Ticks run so far
+    uint64_t published_counter = 0; // SDL_GetPerformanceCounter() at publish
+    TickOutcome outcome = TickOutcome::Continue;
+    bool finished = false;          // The simulation stopped after this state
+    bool show_debug_overlay = false;
+};
+
+// Queued inputs the render thread can get ahead of the simulation by
+constexpr size_t SIM_INPUT_CAPACITY = 256;
+
+/**
+ * SimulationThread - runs the gameplay ticks on a thread of their own
+ *
+ * The thread owns a GameContext with no graphics system and steps it on a
+ * steady ms_per_tick cadence from the high-resolution counter, so a stalled
+ * SDL_RenderPresent or a texture load on the render thread no longer delays
+ * ticks. Inputs arrive through a lock-free queue and are applied before each
+ * tick; every tick publishes a SimRenderState through a triple buffer.
+ *
+ * The debug cheats run on the simulation thread too: point g_cheats at
+ * get_game() before start().
+ */
+class SimulationThread {
+public:
+    // Run one tick of game; return false to end the simulation (a replay ran out)
+    using TickFunction = std::function<bool(GameContext& game, TickOutcome* outcome)>;
+
+    SimulationThread() = default;
+    ~SimulationThread();
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * Copy start_state and start ticking it; the first tick runs a whole
+     * tick from now. The copy's state before the first tick is published
+     * straight away.
+     */
+    void start(const GameContext& start_state, double ms_per_tick, TickFunction tick);
+
+    // Stop and join the thread; the game is the caller's again
+    void stop();
+    bool is_running() const { return thread.joinable(); }
+
+    // The simulation's own context: only the simulation thread may touch it
+    // between start() and stop()
+    GameContext* get_game() { return &game; }
+
+    // Render thread: false if the queue is full and the input was dropped
+    bool send(const SimInput& input) { return inputs.push(input); }
+
+    // Render thread: swap in the newest published state; true if there was one
+    bool consume_state() { return states.consume(); }
+    const SimRenderState& get_state() const { return states.front_buffer(); }
+
+private:
+    void thread_main();
+    void apply_input(const SimInput& input);
+    void publish(TickOutcome outcome, bool finished);
+
+    GameContext game;
+    double ms_per_tick = 0.0;
+    TickFunction tick_function;
+    uint64_t ticks = 0;
+    bool paused = false;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    SpscQueue<SimInput, SIM_INPUT_CAPACITY> inputs;
+    TripleBuffer<SimRenderState> states;
+};
+
+#endif // SIM_THREAD_H
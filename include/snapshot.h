@@ -0,0 +1,240 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "actors.h"
+#include "level.h"
+
+struct GameContext;
+
+// Level, stage or level index not set in a snapshot
+constexpr uint8_t SNAPSHOT_NONE = 0xFF;
+
+/**
+ * GameSnapshot - the complete simulated state of one GameContext
+ *
+ * Fixed-size plain bytes: pointers into the constant level data are kept as
+ * level and stage numbers, and caches (the collision bitboard, textures) are
+ * rebuilt on restore. Restoring a snapshot and running the same input
+ * reproduces the game exactly, so snapshots serve rewind, save states and
+ * comparing two runs tick by tick.
+ *
+ * capture_snapshot clears the whole struct first, so padding is zero and two
+ * equal states give equal bytes.
+ */
+struct GameSnapshot {
+    // Collision table of the current tiles and the pointers it came from
+    uint64_t level_solidity_bits[4];
+    uint8_t level_solidity_last_passable;
+    uint8_t current_level_index;   // current_level_ptr as a level_data_pointers index
+    uint8_t solidity_level_index;  // solidity_level, likewise
+    uint8_t stage_map_level;       // stage_map as a level and stage (SNAPSHOT_NONE: scratch_tiles)
+    uint8_t stage_map_stage;
+    uint8_t streamed_stage;        // tile_map as the current stage's streamed map; scratch_tiles is its window
+    int32_t map_origin_x;
+    int32_t checkpoint_map_origin_x;
+
+    // Player
+    int32_t comic_x;
+    int32_t comic_y;
+    int32_t camera_x;
+    int32_t comic_run_cycle_frame;
+    int32_t run_frame_count;
+    int8_t comic_y_vel;
+    int8_t comic_x_momentum;
+    uint8_t comic_facing;
+    uint8_t comic_is_falling_or_jumping;
+    uint8_t comic_jump_counter;
+    uint8_t comic_jump_power;
+
+    // Keys and their edge-trigger history
+    uint8_t key_state_jump;
+    uint8_t previous_key_state_jump;
+    uint8_t key_state_left;
+    uint8_t key_state_right;
+    uint8_t key_state_open;
+    uint8_t previous_key_state_open;
+    uint8_t key_state_fire;
+    uint8_t key_state_teleport;
+    uint8_t previous_key_state_teleport;
+    uint8_t key_states_cleared;
+
+    // Lives, health and score
+    uint8_t comic_has_door_key;
+    uint8_t comic_num_lives;
+    uint8_t lives_sequence_counter;
+    uint8_t lives_sequence_delay;
+    uint8_t lives_sequence_complete;
+    uint8_t comic_hp;
+    uint8_t comic_hp_pending_increase;
+    uint8_t score_bytes[3];
+    uint8_t score_10000_counter;
+    uint8_t game_over_triggered;
+
+    // Level and stage
+    uint8_t current_level_number;
+    uint8_t current_stage_number;
+    int8_t source_door_level_number;
+    int8_t source_door_stage_number;
+    uint8_t comic_y_checkpoint;
+    uint8_t comic_x_checkpoint;
+    uint8_t first_stage_loaded;
+    uint8_t cheat_noclip;
+    uint8_t ceiling_stick_flag;
+
+    // Player death sequence
+    uint8_t player_is_dying;
+    uint8_t player_death_too_bad_phase;
+    uint8_t player_death_show_animation;
+    uint8_t player_death_fall_clip_render;
+    uint8_t player_death_ticks_remaining;
+
+    // Door animation
+    uint8_t door_anim_phase;
+    uint8_t door_anim_frame;
+    uint8_t door_exit_delay_ticks;
+    uint8_t door_anim_world_x;
+    uint8_t door_anim_world_y;
+    uint8_t door_pending_level;
+    uint8_t door_pending_stage;
+
+    // Teleport
+    uint8_t comic_is_teleporting;
+    uint8_t teleport_animation;
+    uint8_t teleport_source_x;
+    uint8_t teleport_source_y;
+    uint8_t teleport_destination_x;
+    uint8_t teleport_destination_y;
+    uint8_t teleport_camera_counter;
+    int8_t teleport_camera_vel;
+    uint8_t teleport_skip_tick;
+
+    // Carried from tick to tick
+    uint8_t player_moved_last_tick;
+    uint8_t player_airborne_from_walk_off;
+    uint8_t suppress_jump_animation;
+    uint8_t beam_out_sequence_played;
+    uint8_t win_counter;
+    uint8_t enemy_level_number;
+    uint8_t enemy_stage_number;
+
+    // Enemies, fireballs and items
+    ActorSnapshot actors;
+
+    // The test level's tiles or a streamed stage's window; all zero while a stage map is viewed
+    uint8_t scratch_tiles[MAP_WIDTH_TILES * MAP_HEIGHT_TILES];
+
+    bool operator==(const GameSnapshot& other) const;
+    bool operator!=(const GameSnapshot& other) const { return !(*this == other); }
+
+    /**
+     * Save state file: "CCSS", version, varint snapshot size, then the
+     * snapshot delta-encoded against all zeroes (see encode_snapshot_delta).
+     * Files are only read back by a build with the same snapshot layout.
+     */
+    std::vector<uint8_t> encode() const;
+    bool decode(const uint8_t* data, size_t size);
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+// Copy the state of a game into a snapshot. Returns false, leaving the
+// snapshot cleared, if the game's actor pool is larger than a snapshot holds.
+bool capture_snapshot(const GameContext& game, GameSnapshot& snapshot);
+
+// Put a game back into the state of a snapshot. Stage tiles and collision are
+// rebuilt from the level data; if the game has a graphics system, a change of
+// level reloads its tileset. Returns false, leaving the game as it is, if its
+// actor pool is larger than a snapshot holds.
+bool restore_snapshot(GameContext& game, const GameSnapshot& snapshot);
+
+// Upper bound of encode_snapshot_delta's output
+constexpr size_t SNAPSHOT_MAX_ENCODED_SIZE = sizeof(GameSnapshot) + sizeof(GameSnapshot) / 2 + 16;
+
+/**
+ * Delta-encode snapshot against previous: the bytes are XORed and the result
+ * stored as (varint zero run, varint literal length, literal bytes) pairs, so
+ * the fields that did not change cost nothing. out must hold
+ * SNAPSHOT_MAX_ENCODED_SIZE bytes. Returns the encoded size.
+ */
+size_t encode_snapshot_delta(const GameSnapshot& previous, const GameSnapshot& snapshot, uint8_t* out);
+
+// Apply an encoded delta to snapshot in place (it must hold the previous
+// state). Returns false if the data is malformed.
+bool apply_snapshot_delta(GameSnapshot& snapshot, const uint8_t* data, size_t size);
+
+// The fields that differ between two snapshots, as "name: a -> b" lines
+std::vector<std::string> describe_snapshot_differences(const GameSnapshot& a, const GameSnapshot& b);
+
+// Default capacity of a SnapshotRing: an hour of ~9.1 Hz ticks
+constexpr size_t SNAPSHOT_RING_DEFAULT_TICKS = 32768;
+constexpr size_t SNAPSHOT_RING_DEFAULT_BYTES = 4 * 1024 * 1024;
+constexpr uint32_t SNAPSHOT_KEYFRAME_INTERVAL = 256;
+
+/**
+ * SnapshotRing - the snapshots of the most recent ticks, compressed
+ *
+ * Every keyframe_interval-th snapshot is stored whole (delta-encoded against
+ * zeroes), the rest as deltas against the previous tick, in one circular byte
+ * arena. When the arena or the tick capacity is full, the oldest ticks are
+ * dropped up to the next keyframe. All memory is allocated up front: push()
+ * never allocates, and get() decodes at most keyframe_interval deltas.
+ */
+class SnapshotRing {
+public:
+    explicit SnapshotRing(size_t max_ticks = SNAPSHOT_RING_DEFAULT_TICKS,
+                          size_t max_bytes = SNAPSHOT_RING_DEFAULT_BYTES,
+                          uint32_t keyframe_interval = SNAPSHOT_KEYFRAME_INTERVAL);
+
+    void clear();
+
+    // Store the snapshot of tick. A tick that does not follow the newest one
+    // starts the ring over.
+    void push(uint64_t tick, const GameSnapshot& snapshot);
+
+    // Decode the snapshot of tick; false if the ring does not hold it
+    bool get(uint64_t tick, GameSnapshot& snapshot) const;
+
+    // Drop the ticks after tick (e.g. after rewinding to it)
+    void truncate_after(uint64_t tick);
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    uint64_t oldest_tick() const { return first_tick; }
+    uint64_t newest_tick() const { return first_tick + count - 1; }
+    bool contains(uint64_t tick) const { return count > 0 && tick >= first_tick && tick - first_tick < count; }
+    // Encoded bytes held (excluding the fixed index and scratch space)
+    size_t bytes_used() const { return used_bytes; }
+
+    // The first tick held by both rings whose snapshots differ, assuming a
+    // divergence persists once it happens; false if they agree on every
+    // common tick (or share none)
+    static bool find_first_difference(const SnapshotRing& a, const SnapshotRing& b, uint64_t* tick);
+
+private:
+    struct Entry {
+        uint32_t offset;
+        uint16_t size;
+        bool keyframe;
+    };
+
+    const Entry& entry_at(size_t index) const { return entries[(first_entry + index) % entries.size()]; }
+    void drop_oldest();
+
+    std::vector<uint8_t> arena;
+    std::vector<Entry> entries;  // Circular, first_entry is the oldest
+    uint32_t keyframe_interval;
+    size_t first_entry;
+    size_t count;
+    uint64_t first_tick;
+    size_t write_offset;         // Arena offset after the newest entry
+    uint32_t ticks_since_keyframe;
+    size_t used_bytes;
+    GameSnapshot newest;         // Decoded newest snapshot, the base of the next delta
+    std::vector<uint8_t> scratch;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,48 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * SpscQueue - fixed-capacity lock-free queue for one producer thread and one
+ * consumer thread
+ *
+ * The indices only grow; an item is written before the head that publishes
+ * it, and read before the tail that frees its slot.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer: false, and nothing queued, when the queue is full
+    bool push(const T& item) {
+        const size_t head_index = head.load(std::memory_order_relaxed);
+        if (head_index - tail.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        items[head_index & (Capacity - 1)] = item;
+        head.store(head_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false when the queue is empty
+    bool pop(T* item) {
+        const size_t tail_index = tail.load(std::memory_order_relaxed);
+        if (tail_index == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        *item = items[tail_index & (Capacity - 1)];
+        tail.store(tail_index + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> items{};
+    alignas(64) std::atomic<size_t> head{0};  // Written by the producer
+    alignas(64) std::atomic<size_t> tail{0};  // Written by the consumer
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,72 @@
+#ifndef TILE_MAP_H
+#define TILE_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include "physics.h"
+
+/**
+ * Streamed tile map file layout, all integers little-endian:
+ *
+ *   header  24 bytes  "CCTM", u32 version, u32 width_tiles, u16 height_tiles,
+ *                     u16 chunk_width_tiles, u32 chunk_count, u32 reserved
+ *   chunks  8 bytes each: u32 data offset, u32 data size
+ *   data    one blob per chunk: (u8 count 1-255, u8 tile) runs covering the
+ *           chunk's rows top to bottom, chunk_width_tiles tiles each
+ *
+ * A map is MAP_HEIGHT_TILES high (stages do not scroll vertically) and a
+ * whole number of chunks wide, at least one window of MAP_WIDTH_TILES.
+ */
+constexpr uint32_t TILE_MAP_VERSION = 1;
+constexpr size_t TILE_MAP_HEADER_SIZE = 24;
+constexpr size_t TILE_MAP_CHUNK_ENTRY_SIZE = 8;
+constexpr int TILE_MAP_CHUNK_WIDTH = 32;  // Tiles; 64 game units
+constexpr int TILE_MAP_CHUNK_TILES = TILE_MAP_CHUNK_WIDTH * MAP_HEIGHT_TILES;
+constexpr int TILE_MAP_WINDOW_CHUNKS = MAP_WIDTH_TILES / TILE_MAP_CHUNK_WIDTH;
+static_assert(MAP_WIDTH_TILES % TILE_MAP_CHUNK_WIDTH == 0, "a map window is whole chunks");
+
+/**
+ * TileMap - a streamed map file, open for reading chunks
+ *
+ * open() reads the header only; a chunk's table entry and data are read when
+ * the chunk is asked for, so opening a map costs the same whatever its width.
+ * Nothing is cached here: a game keeps the chunks around its camera in its
+ * map window (see move_map_window), and the stage background caches their
+ * textures. Reads are safe from any thread.
+ */
+class TileMap {
+public:
+    TileMap();
+    ~TileMap();
+    TileMap(const TileMap&) = delete;
+    TileMap& operator=(const TileMap&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return file != nullptr; }
+    MapCoord get_width_tiles() const { return width_tiles; }
+    MapCoord get_chunk_count() const { return chunk_count; }
+
+    // Decode a chunk into out, TILE_MAP_CHUNK_WIDTH tiles per row with rows
+    // `stride` bytes apart. A missing or corrupt chunk reads as tile 0 and
+    // returns false.
+    bool read_chunk(MapCoord index, uint8_t* out, int stride = TILE_MAP_CHUNK_WIDTH) const;
+    // The MAP_WIDTH_TILES x MAP_HEIGHT_TILES window starting at a chunk
+    // boundary, in the layout of GameContext::scratch_tiles
+    bool read_window(MapCoord first_tile_x, uint8_t* out) const;
+
+private:
+    mutable std::mutex file_mutex;
+    std::FILE* file;
+    MapCoord width_tiles;
+    MapCoord chunk_count;
+};
+
+// Write tiles (MAP_HEIGHT_TILES rows of width_tiles) as a map file;
+// width_tiles must be a whole number of chunks and at least MAP_WIDTH_TILES
+bool write_tile_map(const std::string& path, const uint8_t* tiles, MapCoord width_tiles);
+
+#endif // TILE_MAP_H
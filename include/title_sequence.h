@@ -3,9 +3,12 @@
 
 #include <SDL2/SDL.h>
 #include <cstdint>
+#include <functional>
+#include <vector>
 
-// Forward declaration
+// Forward declarations
 class GraphicsSystem;
+class Sequencer;
 
 struct InputBindings {
     SDL_Keycode move_left;
@@ -56,9 +59,13 @@ bool save_input_bindings_to_file();
  *   - ESC: quit
  *   - Any other key: continue to title sequence
  *
+ * on_frame, if set, is called after every frame of the notice is presented
+ * (startup uses it to load in the background while the notice is up).
+ *
  * Returns false if the user chooses to quit or closes the window.
  */
-bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics);
+bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics,
+                        const std::function<void()>& on_frame = nullptr);
 
 /**
  * Title Sequence System
@@ -76,23 +83,56 @@ bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics);
  *   In SDL2 this is replicated by performing a multi-step color/palette
  *   transition on the rendered content, emulating the original palette
  *   register fades rather than using a simple full-screen alpha overlay.
+ *   Each faded register is a white mask drawn color-modulated over the
+ *   rest of the image (see split_palette_fade_layers()), so the textures
+ *   are uploaded once and a step only changes the modulation.
  * Timing:
  *   Original uses wait_n_ticks(14) ≈ 770 ms for the title screen delay.
  *   Each tick is ~55 ms (DOS 18.2 Hz timer).
  */
 
+// Palette registers the title fade-in recolors (background, items, title)
+constexpr int FADE_REGISTER_COUNT = 3;
+
+// A paletted image split for palette-register fades, as RGBA32 pixels
+struct PaletteFadeLayers {
+    std::vector<uint8_t> base;                       // Every other register in its color; these black
+    std::vector<uint8_t> masks[FADE_REGISTER_COUNT]; // Opaque white on the register's pixels, clear elsewhere
+};
+
+/**
+ * Split 8-bit indexed pixels into fade layers.
+ *
+ * Drawing the base and then each mask tinted (color modulated) with its
+ * register's color reproduces the image under any colors of the fading
+ * registers, so a fade step is a color change instead of a re-conversion
+ * and upload of the whole image. Indices outside the palette come out black.
+ *
+ * @param pixels    width x height indices, pitch bytes per row
+ * @param palette   palette_size colors
+ * @param registers FADE_REGISTER_COUNT palette indices
+ */
+void split_palette_fade_layers(const uint8_t* pixels, int width, int height, int pitch,
+                               const SDL_Color* palette, int palette_size,
+                               const uint8_t* registers, PaletteFadeLayers* layers);
+
 /**
- * Run the full title sequence.
+ * Queue the full title sequence on a sequencer.
+ *
+ * The screens are loaded (decoded side by side on the graphics worker
+ * pool) and their fade frames built straight away; the queued steps show
+ * them, and key presses handed to the sequencer advance the story and
+ * items screens. If a screen cannot be loaded the sequence is
+ * cut short there and gameplay follows as usual.
  *
- * Blocks until the sequence completes (key presses advance screens).
- * Returns true if the sequence completed normally, false if the user
- * quit (SDL_QUIT event) during the sequence.
+ * The steps draw with renderer and leave presenting to the loop driving the
+ * sequencer. Clear the sequencer before the renderer is destroyed.
  *
+ * @param sequencer Sequencer to queue the steps on (after any already queued)
  * @param renderer  The SDL renderer for drawing
  * @param graphics  The graphics system (for asset path resolution and texture loading)
- * @return true to continue to gameplay, false to exit the program
  */
-bool run_title_sequence(SDL_Renderer* renderer, GraphicsSystem* graphics);
+void queue_title_sequence(Sequencer& sequencer, SDL_Renderer* renderer, GraphicsSystem* graphics);
 
 /**
  * Get the HUD background texture created during the title sequence.
@@ -7,6 +7,30 @@
 #include "graphics.h"
 #include "physics.h"  // MAX_HP and other shared gameplay constants
 
+/**
+ * Everything the HUD displays. render_hud keeps the last drawn HudState and
+ * only redraws its cached layer when the new state differs.
+ */
+struct HudState {
+    uint8_t score_bytes[3] = {0, 0, 0};
+    uint8_t num_lives = 0;
+    uint8_t hp = 0;
+    uint8_t fireball_meter = 0;
+    uint8_t firepower = 0;
+    bool has_corkscrew = false;
+    bool has_door_key = false;
+    bool has_teleport_wand = false;
+    bool has_lantern = false;
+    bool has_gems = false;
+    bool has_crown = false;
+    bool has_gold = false;
+    bool has_boots = false;
+    uint8_t inventory_frame = 0;  // even/odd frame; 0 while no item is shown
+
+    bool operator==(const HudState& other) const;
+    bool operator!=(const HudState& other) const { return !(*this == other); }
+};
+
 /**
  * UISystem manages all HUD rendering during gameplay.
  * Displays score, lives, HP meter, fireball meter, and inventory items.
@@ -21,11 +45,16 @@ public:
     // Initialize UI system and load all required sprites
     bool initialize();
     
+    // Queue the decodes of the sprites initialize() loads, so it only uploads
+    static void request_sprites(GraphicsSystem* graphics);
+    
     // Cleanup UI resources
     void cleanup();
     
     // Update animation state (call once per game tick)
     void update();
+    // The counter update() toggles (make_hud_state's animation_counter)
+    uint8_t get_animation_counter() const { return inventory_animation_counter; }
     
     // Render all UI elements to the screen
     void render_hud(
@@ -44,7 +73,27 @@ public:
         uint8_t jump_power            // For boots detection (> 4 means boots)
     );
     
+    // Forget the cached HUD layer so the next render_hud redraws it (call on
+    // SDL_RENDER_TARGETS_RESET, when target texture contents are lost).
+    void invalidate_hud_cache();
+    
     // Public testable helper functions for HUD logic
+    static HudState make_hud_state(
+        const uint8_t score_bytes[3],
+        uint8_t num_lives,
+        uint8_t hp,
+        uint8_t fireball_meter,
+        uint8_t firepower,
+        bool has_corkscrew,
+        bool has_door_key,
+        bool has_teleport_wand,
+        bool has_lantern,
+        bool has_gems,
+        bool has_crown,
+        bool has_gold,
+        uint8_t jump_power,
+        uint8_t animation_counter
+    );
     static void score_bytes_to_digits(const uint8_t score_bytes[3], uint8_t digits[6]);
     static uint8_t fireball_meter_to_cell_state(uint8_t meter_value, uint8_t cell_index);
     static bool has_boots(uint8_t jump_power);
@@ -53,29 +102,41 @@ private:
     bool initialized;
     uint8_t inventory_animation_counter;
 
+    // Cached HUD layer: a transparent EGA_WIDTH x EGA_HEIGHT render target
+    // holding the last drawn HudState, blitted once per frame.
+    SDL_Texture* hud_cache;
+    HudState hud_cache_state;
+    bool hud_cache_valid;
+    bool hud_cache_unsupported;  // no render targets; draw directly every frame
+
     // Score digit sprites (0-9)
-    std::vector<Sprite*> score_digit_sprites;
+    std::vector<SpriteId> score_digit_sprites;
     
     // Life icon sprites
-    Sprite* life_icon_bright;
-    Sprite* life_icon_dark;
+    SpriteId life_icon_bright;
+    SpriteId life_icon_dark;
     
     // Meter sprites (full, half, empty)
-    Sprite* meter_full;
-    Sprite* meter_half;
-    Sprite* meter_empty;
+    SpriteId meter_full;
+    SpriteId meter_half;
+    SpriteId meter_empty;
     
     // Inventory item sprites
-    std::vector<Sprite*> blastola_cola_sprites;  // Base even/odd frames
-    std::vector<std::vector<Sprite*>> blastola_cola_inventory_sprites;  // Firepower 1-5, each even/odd
-    std::vector<Sprite*> corkscrew_sprites;      // even/odd frames
-    std::vector<Sprite*> door_key_sprites;       // even/odd frames
-    std::vector<Sprite*> boots_sprites;          // even/odd frames
-    std::vector<Sprite*> lantern_sprites;        // even/odd frames
-    std::vector<Sprite*> teleport_wand_sprites;  // even/odd frames
-    std::vector<Sprite*> gems_sprites;           // even/odd frames
-    std::vector<Sprite*> crown_sprites;          // even/odd frames
-    std::vector<Sprite*> gold_sprites;           // even/odd frames
+    std::vector<SpriteId> blastola_cola_sprites;  // Base even/odd frames
+    std::vector<std::vector<SpriteId>> blastola_cola_inventory_sprites;  // Firepower 1-5, each even/odd
+    std::vector<SpriteId> corkscrew_sprites;      // even/odd frames
+    std::vector<SpriteId> door_key_sprites;       // even/odd frames
+    std::vector<SpriteId> boots_sprites;          // even/odd frames
+    std::vector<SpriteId> lantern_sprites;        // even/odd frames
+    std::vector<SpriteId> teleport_wand_sprites;  // even/odd frames
+    std::vector<SpriteId> gems_sprites;           // even/odd frames
+    std::vector<SpriteId> crown_sprites;          // even/odd frames
+    std::vector<SpriteId> gold_sprites;           // even/odd frames
+    
+    // Draw every HUD component for `state` (queued as one sprite batch)
+    void draw_hud(const HudState& state);
+    // Redraw hud_cache from `state`; false if the cache cannot be used
+    bool rebuild_hud_cache(const HudState& state);
     
     // Render individual UI components
     void render_score(const uint8_t score_bytes[3]);
@@ -95,10 +156,10 @@ private:
     );
     
     // Helper to load sprite
-    Sprite* load_ui_sprite(const std::string& sprite_name);
+    SpriteId load_ui_sprite(const std::string& sprite_name);
     
     // Helper to render sprite at position without direction
-    void render_sprite_at(Sprite* sprite, int x, int y, int width, int height);
+    void render_sprite_at(SpriteId sprite_id, int x, int y, int width, int height);
 };
 
 #endif // UI_SYSTEM_H
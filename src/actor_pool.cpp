@@ -0,0 +1,33 @@
+/**
+ * actor_pool.cpp - Enemy slot storage and the collision broadphase grid
+ */
+
+#include "../include/actor_pool.h"
+#include <algorithm>
+
+void EnemyPool::resize(int count) {
+    const size_t n = static_cast<size_t>(std::max(count, 0));
+    y.resize(n, 0);
+    x.resize(n, 0);
+    x_vel.resize(n, 0);
+    y_vel.resize(n, 0);
+    spawn_timer_and_animation.resize(n, 0);
+    num_animation_frames.resize(n, 0);
+    behavior.resize(n, 0);
+    state.resize(n, 0);
+    facing.resize(n, 0);
+    restraint.resize(n, 0);
+    sprite_descriptor.resize(n, nullptr);
+    animation_data.resize(n, nullptr);
+}
+
+void ActorGrid::clear(int num_slots) {
+    std::fill(std::begin(heads), std::end(heads), static_cast<int16_t>(-1));
+    links.assign(static_cast<size_t>(std::max(num_slots, 0)), static_cast<int16_t>(-1));
+}
+
+void ActorGrid::insert(int slot, uint8_t x, uint8_t y) {
+    const int cell = cell_of(x, y);
+    links[slot] = heads[cell];
+    heads[cell] = static_cast<int16_t>(slot);
+}
@@ -2,50 +2,45 @@
 #include "level.h"
 #include "physics.h"
 #include "audio.h"
+#include "counters.h"
+#include "game_context.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
-// Global door key flag defined in main.cpp (used by doors.cpp)
-extern uint8_t comic_has_door_key;
-extern uint8_t comic_hp;
-extern uint8_t comic_hp_pending_increase;
-extern uint8_t comic_num_lives;
-
-// Score bytes from main.cpp for award_points()
-extern uint8_t score_bytes[3];
-extern uint8_t score_10000_counter;
-
 /**
  * award_points - Award points to the player's score
  * 
  * Adds points to the player's score using base-100 arithmetic with carry propagation.
  * Score is stored as three base-100 bytes where:
- *   score_bytes[0] = ones/tens (0-99)
- *   score_bytes[1] = hundreds/thousands (0-99)
- *   score_bytes[2] = ten-thousands/hundred-thousands (0-99)
+ *   game.score_bytes[0] = ones/tens (0-99)
+ *   game.score_bytes[1] = hundreds/thousands (0-99)
+ *   game.score_bytes[2] = ten-thousands/hundred-thousands (0-99)
  * Total score = byte[0] + (byte[1] * 100) + (byte[2] * 10000), max 999,999
  * 
  * Input points are base-100 units.
- * Example: award_points(3) adds 300 displayed points.
+ * Example: award_points(game, 3) adds 300 displayed points.
  */
-void award_points(uint16_t points) {
+void award_points(GameContext& game, uint16_t points) {
     // Points map to the least-significant base-100 byte and carry upward.
-    uint16_t sum0 = static_cast<uint16_t>(score_bytes[0]) + points;
-    score_bytes[0] = static_cast<uint8_t>(sum0 % 100);
+    uint16_t sum0 = static_cast<uint16_t>(game.score_bytes[0]) + points;
+    game.score_bytes[0] = static_cast<uint8_t>(sum0 % 100);
 
     uint16_t carry = sum0 / 100;
     if (carry > 0) {
-        uint16_t sum1 = static_cast<uint16_t>(score_bytes[1]) + carry;
-        score_bytes[1] = static_cast<uint8_t>(sum1 % 100);
+        uint16_t sum1 = static_cast<uint16_t>(game.score_bytes[1]) + carry;
+        game.score_bytes[1] = static_cast<uint8_t>(sum1 % 100);
 
         // Assembly parity: each carry from score byte 0 into byte 1 is one
         // ten-thousand increment; on 5 increments reset counter, then award life.
         for (uint16_t i = 0; i < carry; ++i) {
-            const uint8_t next = static_cast<uint8_t>(score_10000_counter + 1);
+            const uint8_t next = static_cast<uint8_t>(game.score_10000_counter + 1);
             if (next >= 5) {
-                score_10000_counter = 0;
-                award_extra_life();
+                game.score_10000_counter = 0;
+                award_extra_life(game);
             } else {
-                score_10000_counter = next;
+                game.score_10000_counter = next;
             }
         }
 
@@ -54,55 +49,58 @@ void award_points(uint16_t points) {
             return;
         }
 
-        uint16_t high = static_cast<uint16_t>(score_bytes[2]) + carry;
+        uint16_t high = static_cast<uint16_t>(game.score_bytes[2]) + carry;
         if (high >= 100) {
             // Saturate to max representable score.
-            score_bytes[0] = 99;
-            score_bytes[1] = 99;
-            score_bytes[2] = 99;
+            game.score_bytes[0] = 99;
+            game.score_bytes[1] = 99;
+            game.score_bytes[2] = 99;
         } else {
-            score_bytes[2] = static_cast<uint8_t>(high);
+            game.score_bytes[2] = static_cast<uint8_t>(high);
         }
     }
 }
 
-void award_extra_life() {
+void award_extra_life(GameContext& game) {
     constexpr uint8_t MAX_NUM_LIVES = 5;
 
     play_game_sound(GameSound::EXTRA_LIFE);
 
-    if (comic_num_lives >= MAX_NUM_LIVES) {
+    if (game.comic_num_lives >= MAX_NUM_LIVES) {
         // Match comic-c: full lives converts shield life-award into HP refill + bonus points.
-        comic_hp_pending_increase = MAX_HP;
-        award_points(75);
-        award_points(75);
-        award_points(75);
+        game.comic_hp_pending_increase = MAX_HP;
+        award_points(game, 75);
+        award_points(game, 75);
+        award_points(game, 75);
         return;
     }
 
-    comic_num_lives++;
+    game.comic_num_lives++;
 }
 
 /**
  * ActorSystem constructor
  */
-ActorSystem::ActorSystem()
-    : enemies(MAX_NUM_ENEMIES),
-      fireballs(MAX_NUM_FIREBALLS),
-      fireball_meter_counter(FIREBALL_METER_COUNTER_INIT),
+ActorSystem::ActorSystem(int max_enemies, int max_fireballs)
+    : fireball_meter_counter(FIREBALL_METER_COUNTER_INIT),
       item_animation_counter(0),
       current_item_type(ITEM_UNUSED),
       current_item_x(0),
       current_item_y(0),
+      window_origin_units(0),
+      bound_sprite_evictions(0),
       current_tiles(nullptr),
       current_map_width_tiles(128),
       current_map_height_tiles(10),
       tileset_last_passable(0x3E),
+      solidity(build_solidity_table(0x3E)),
+      collision(&local_collision),
       current_level_index(0),
       current_stage_index(0),
       spawned_this_tick(0),
       spawn_offset_cycle(PLAYFIELD_WIDTH),
       enemy_respawn_counter_cycle(RESPAWN_TIMER_MIN),
+      game(nullptr),
       g_comic_x(0),
       g_comic_y(0),
       g_comic_facing(COMIC_FACING_LEFT),
@@ -118,27 +116,18 @@ ActorSystem::ActorSystem()
       comic_has_crown(0),
       comic_has_gold(0),
       comic_num_treasures(0) {
-    for (auto& enemy : enemies) {
-        enemy.state = ENEMY_STATE_DESPAWNED;
-        enemy.spawn_timer_and_animation = 100;
-        enemy.sprite_descriptor = nullptr;
-        enemy.animation_data = nullptr;
-    }
-    fireball_sprite[0] = nullptr;
-    fireball_sprite[1] = nullptr;
+    set_pool_limits(max_enemies, max_fireballs);
+    fireball_sprite[0] = INVALID_SPRITE_ID;
+    fireball_sprite[1] = INVALID_SPRITE_ID;
     for (auto& spark_set : spark_sprites) {
         for (auto& spark_frame : spark_set) {
-            spark_frame = nullptr;
+            spark_frame = INVALID_SPRITE_ID;
         }
     }
-    for (auto& fb : fireballs) {
-        fb.x = FIREBALL_DEAD;
-        fb.y = FIREBALL_DEAD;
-    }
-    // Initialize item sprites to nullptr
+    // Initialize item sprites to no sprite
     for (int i = 0; i < 15; i++) {
-        item_sprites[i][0] = nullptr;
-        item_sprites[i][1] = nullptr;
+        item_sprites[i][0] = INVALID_SPRITE_ID;
+        item_sprites[i][1] = INVALID_SPRITE_ID;
     }
     // Initialize items_collected array to 0 (not collected)
     for (int level = 0; level < 8; level++) {
@@ -155,6 +144,31 @@ ActorSystem::~ActorSystem() {
     // Cleanup handled by SDL/graphics system
 }
 
+/**
+ * Resize the enemy and fireball pools (and the per-tick scratch with them)
+ */
+void ActorSystem::set_pool_limits(int max_enemies, int max_fireballs) {
+    max_enemies = std::max(max_enemies, 0);
+    max_fireballs = std::max(max_fireballs, 0);
+
+    enemies = EnemyPool();
+    enemies.resize(max_enemies);
+    for (int i = 0; i < max_enemies; i++) {
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = 100;
+    }
+    fireballs.assign(static_cast<size_t>(max_fireballs), fireball_t{});
+    reset_fireballs();
+
+    for (auto& slots : behavior_slots) {
+        slots.clear();
+        slots.reserve(static_cast<size_t>(max_enemies));
+    }
+    enemy_ticked.assign(static_cast<size_t>(max_enemies), 0);
+    enemy_near_player.assign(static_cast<size_t>(max_enemies), 0);
+    enemy_grid.clear(max_enemies);
+}
+
 /**
  * Initialize the actor system
  */
@@ -167,9 +181,9 @@ bool ActorSystem::initialize() {
  * Reset all enemies for a new stage
  */
 void ActorSystem::reset_for_stage() {
-    for (auto& enemy : enemies) {
-        enemy.state = ENEMY_STATE_DESPAWNED;
-        enemy.spawn_timer_and_animation = enemy_respawn_counter_cycle;
+    for (int i = 0; i < enemies.size(); i++) {
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = enemy_respawn_counter_cycle;
     }
     spawned_this_tick = 0;
     // NOTE: spawn_offset_cycle is intentionally NOT reset here.
@@ -180,6 +194,134 @@ void ActorSystem::reset_for_stage() {
     // across stage changes.
 }
 
+/**
+ * Copy the per-tick actor state into a snapshot
+ */
+void ActorSystem::save_snapshot(ActorSnapshot& snapshot) const {
+    const level_t* level = current_level_index < 8 ? level_data_pointers[current_level_index] : nullptr;
+    for (int i = 0; i < MAX_NUM_ENEMIES && i < enemies.size(); i++) {
+        enemy_snapshot_t& saved = snapshot.enemies[i];
+        saved.y = enemies.y[i];
+        saved.x = enemies.x[i];
+        saved.x_vel = enemies.x_vel[i];
+        saved.y_vel = enemies.y_vel[i];
+        saved.spawn_timer_and_animation = enemies.spawn_timer_and_animation[i];
+        saved.num_animation_frames = enemies.num_animation_frames[i];
+        saved.behavior = enemies.behavior[i];
+        saved.state = enemies.state[i];
+        saved.facing = enemies.facing[i];
+        saved.restraint = enemies.restraint[i];
+        saved.shp_index = ENEMY_SNAPSHOT_NO_SPRITE;
+        const shp_t* sprite_desc = enemies.sprite_descriptor[i];
+        if (level && sprite_desc >= level->shp && sprite_desc < level->shp + 4) {
+            saved.shp_index = static_cast<uint8_t>(sprite_desc - level->shp);
+        }
+    }
+    for (int i = 0; i < MAX_NUM_FIREBALLS && i < get_max_fireballs(); i++) {
+        snapshot.fireballs[i] = fireballs[i];
+    }
+    std::memcpy(snapshot.items_collected, items_collected, sizeof(items_collected));
+    snapshot.comic_firepower = comic_firepower;
+    snapshot.comic_has_corkscrew = comic_has_corkscrew;
+    snapshot.fireball_meter = fireball_meter;
+    snapshot.fireball_meter_counter = fireball_meter_counter;
+    snapshot.comic_has_boots = comic_has_boots;
+    snapshot.comic_has_lantern = comic_has_lantern;
+    snapshot.comic_has_door_key = comic_has_door_key;
+    snapshot.comic_has_teleport_wand = comic_has_teleport_wand;
+    snapshot.comic_has_gems = comic_has_gems;
+    snapshot.comic_has_crown = comic_has_crown;
+    snapshot.comic_has_gold = comic_has_gold;
+    snapshot.comic_num_treasures = comic_num_treasures;
+    snapshot.item_animation_counter = item_animation_counter;
+    snapshot.current_item_type = current_item_type;
+    snapshot.current_item_x = current_item_x;
+    snapshot.current_item_y = current_item_y;
+    snapshot.tileset_last_passable = tileset_last_passable;
+    snapshot.current_level_index = current_level_index;
+    snapshot.current_stage_index = current_stage_index;
+    snapshot.spawned_this_tick = spawned_this_tick;
+    snapshot.spawn_offset_cycle = spawn_offset_cycle;
+    snapshot.enemy_respawn_counter_cycle = enemy_respawn_counter_cycle;
+}
+
+/**
+ * Look up enemy animation data from the graphics system's cache
+ */
+void ActorSystem::bind_enemy_sprites(GraphicsSystem* graphics_system) {
+    if (!graphics_system) {
+        return;
+    }
+    // An eviction may have freed animation data a slot still points at
+    const uint32_t evictions = graphics_system->get_enemy_sprite_evictions();
+    const bool rebind_all = evictions != bound_sprite_evictions;
+    bound_sprite_evictions = evictions;
+    for (int i = 0; i < enemies.size(); i++) {
+        if (enemies.sprite_descriptor[i] && (rebind_all || !enemies.animation_data[i])) {
+            enemies.animation_data[i] = graphics_system->load_enemy_sprite(*enemies.sprite_descriptor[i]);
+        }
+    }
+}
+
+/**
+ * Put the actor state of a snapshot back
+ *
+ * Sprite textures are only looked up for slots whose sprite changed, so
+ * stepping back through ticks of one stage touches no texture cache.
+ */
+void ActorSystem::restore_snapshot(const ActorSnapshot& snapshot, GraphicsSystem* graphics_system) {
+    const level_t* level = snapshot.current_level_index < 8
+        ? level_data_pointers[snapshot.current_level_index] : nullptr;
+    for (int i = 0; i < MAX_NUM_ENEMIES && i < enemies.size(); i++) {
+        const enemy_snapshot_t& saved = snapshot.enemies[i];
+        const shp_t* sprite_desc = (level && saved.shp_index < 4) ? &level->shp[saved.shp_index] : nullptr;
+        if (enemies.sprite_descriptor[i] != sprite_desc) {
+            enemies.sprite_descriptor[i] = sprite_desc;
+            enemies.animation_data[i] = (sprite_desc && graphics_system)
+                ? graphics_system->load_enemy_sprite(*sprite_desc) : nullptr;
+        }
+        enemies.y[i] = saved.y;
+        enemies.x[i] = saved.x;
+        enemies.x_vel[i] = saved.x_vel;
+        enemies.y_vel[i] = saved.y_vel;
+        enemies.spawn_timer_and_animation[i] = saved.spawn_timer_and_animation;
+        enemies.num_animation_frames[i] = saved.num_animation_frames;
+        enemies.behavior[i] = saved.behavior;
+        enemies.state[i] = saved.state;
+        enemies.facing[i] = saved.facing;
+        enemies.restraint[i] = saved.restraint;
+    }
+    for (int i = 0; i < MAX_NUM_FIREBALLS && i < get_max_fireballs(); i++) {
+        fireballs[i] = snapshot.fireballs[i];
+    }
+    std::memcpy(items_collected, snapshot.items_collected, sizeof(items_collected));
+    comic_firepower = snapshot.comic_firepower;
+    comic_has_corkscrew = snapshot.comic_has_corkscrew;
+    fireball_meter = snapshot.fireball_meter;
+    fireball_meter_counter = snapshot.fireball_meter_counter;
+    comic_has_boots = snapshot.comic_has_boots;
+    comic_has_lantern = snapshot.comic_has_lantern;
+    comic_has_door_key = snapshot.comic_has_door_key;
+    comic_has_teleport_wand = snapshot.comic_has_teleport_wand;
+    comic_has_gems = snapshot.comic_has_gems;
+    comic_has_crown = snapshot.comic_has_crown;
+    comic_has_gold = snapshot.comic_has_gold;
+    comic_num_treasures = snapshot.comic_num_treasures;
+    item_animation_counter = snapshot.item_animation_counter;
+    current_item_type = snapshot.current_item_type;
+    current_item_x = snapshot.current_item_x;
+    current_item_y = snapshot.current_item_y;
+    if (tileset_last_passable != snapshot.tileset_last_passable) {
+        tileset_last_passable = snapshot.tileset_last_passable;
+        solidity = build_solidity_table(tileset_last_passable);
+    }
+    current_level_index = snapshot.current_level_index;
+    current_stage_index = snapshot.current_stage_index;
+    spawned_this_tick = snapshot.spawned_this_tick;
+    spawn_offset_cycle = snapshot.spawn_offset_cycle;
+    enemy_respawn_counter_cycle = snapshot.enemy_respawn_counter_cycle;
+}
+
 /**
  * Setup enemies for a stage from level data
  */
@@ -194,6 +336,7 @@ void ActorSystem::setup_enemies_for_stage(
 
     const stage_t& stage = level->stages[stage_number];
     tileset_last_passable = level->tileset_last_passable;
+    solidity = build_solidity_table(tileset_last_passable);
     current_level_index = static_cast<uint8_t>(level_index);
     current_stage_index = static_cast<uint8_t>(stage_number);
 
@@ -205,41 +348,76 @@ void ActorSystem::setup_enemies_for_stage(
     current_item_x = stage.item_x;
     current_item_y = stage.item_y;
 
-    // Initialize each enemy slot from stage data
+    // Queue the decodes for every sprite this stage uses before blocking on the
+    // first one, so the frames of different enemies decode in parallel
     for (int i = 0; i < MAX_NUM_ENEMIES; i++) {
         const enemy_record_t& record = stage.enemies[i];
-        enemy_t& enemy = enemies[i];
-
-        // Check if slot is used
-        if ((record.behavior & ~ENEMY_BEHAVIOR_FAST) >= ENEMY_BEHAVIOR_UNUSED) {
-            enemy.behavior = ENEMY_BEHAVIOR_UNUSED;
-            enemy.state = ENEMY_STATE_DESPAWNED;
-            enemy.spawn_timer_and_animation = 100;
-            enemy.sprite_descriptor = nullptr;
-            enemy.num_animation_frames = 0;
-            enemy.animation_data = nullptr;
-            continue;
+        if (graphics_system && (record.behavior & ~ENEMY_BEHAVIOR_FAST) < ENEMY_BEHAVIOR_UNUSED &&
+            record.shp_index < 4) {
+            graphics_system->request_enemy_sprite(level->shp[record.shp_index]);
         }
+    }
 
-        // Validate sprite descriptor index to avoid out-of-bounds access
-        if (record.shp_index >= 4) {
-            std::cerr << "Invalid sprite index " << static_cast<int>(record.shp_index) 
-                      << " for enemy slot " << i << " (max is 3)" << std::endl;
-            enemy.state = ENEMY_STATE_DESPAWNED;
-            enemy.spawn_timer_and_animation = 100;
-            enemy.sprite_descriptor = nullptr;
-            enemy.animation_data = nullptr;
+    // Initialize each enemy slot from stage data; slots past the stage's
+    // records stay unused until a custom level sets them up
+    for (int i = 0; i < enemies.size(); i++) {
+        if (i < MAX_NUM_ENEMIES) {
+            setup_enemy_slot(i, level, stage.enemies[i], graphics_system);
             continue;
         }
-        // Load animation data from sprite descriptor
-        const shp_t& sprite_desc = level->shp[record.shp_index];
-        enemy.sprite_descriptor = &sprite_desc;  // Store reference to source metadata
-        enemy.num_animation_frames = sprite_desc.num_distinct_frames;  // Cache for performance
-        enemy.behavior = record.behavior;
+        enemies.behavior[i] = ENEMY_BEHAVIOR_UNUSED;
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = 100;
+        enemies.sprite_descriptor[i] = nullptr;
+        enemies.num_animation_frames[i] = 0;
+        enemies.animation_data[i] = nullptr;
+    }
+
+    reset_for_stage();
+    reset_fireballs();
+}
 
+/**
+ * Setup one enemy slot from a stage record
+ */
+bool ActorSystem::setup_enemy_slot(int slot, const level_t* level, const enemy_record_t& record,
+                                   GraphicsSystem* graphics_system) {
+    if (!level || slot < 0 || slot >= enemies.size()) {
+        return false;
+    }
+    const int i = slot;
+
+    // Check if slot is used
+    if ((record.behavior & ~ENEMY_BEHAVIOR_FAST) >= ENEMY_BEHAVIOR_UNUSED) {
+        enemies.behavior[i] = ENEMY_BEHAVIOR_UNUSED;
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = 100;
+        enemies.sprite_descriptor[i] = nullptr;
+        enemies.num_animation_frames[i] = 0;
+        enemies.animation_data[i] = nullptr;
+        return false;
+    }
+
+    // Validate sprite descriptor index to avoid out-of-bounds access
+    if (record.shp_index >= 4) {
+        std::cerr << "Invalid sprite index " << static_cast<int>(record.shp_index) 
+                  << " for enemy slot " << i << " (max is 3)" << std::endl;
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = 100;
+        enemies.sprite_descriptor[i] = nullptr;
+        enemies.animation_data[i] = nullptr;
+        return false;
+    }
+    // Load animation data from sprite descriptor
+    const shp_t& sprite_desc = level->shp[record.shp_index];
+    enemies.sprite_descriptor[i] = &sprite_desc;  // Store reference to source metadata
+    enemies.num_animation_frames[i] = sprite_desc.num_distinct_frames;  // Cache for performance
+    enemies.behavior[i] = record.behavior;
+
+    if (graphics_system) {
         // Load sprite animation from graphics system
-        enemy.animation_data = graphics_system->load_enemy_sprite(sprite_desc);
-        if (!enemy.animation_data) {
+        enemies.animation_data[i] = graphics_system->load_enemy_sprite(sprite_desc);
+        if (!enemies.animation_data[i]) {
             std::string sprite_name = sprite_desc.filename;
             size_t null_pos = sprite_name.find('\0');
             if (null_pos != std::string::npos) {
@@ -250,34 +428,38 @@ void ActorSystem::setup_enemies_for_stage(
             }
             std::cerr << "Failed to load sprite animation data for "
                       << (sprite_name.empty() ? "<unknown>" : sprite_name) << std::endl;
-            enemy.state = ENEMY_STATE_DESPAWNED;
-            enemy.sprite_descriptor = nullptr;
-            enemy.animation_data = nullptr;
-            continue;
+            enemies.state[i] = ENEMY_STATE_DESPAWNED;
+            enemies.sprite_descriptor[i] = nullptr;
+            enemies.animation_data[i] = nullptr;
+            return false;
         }
-
-        enemy.num_animation_frames = static_cast<uint8_t>(enemy.animation_data->frame_sequence.size());
-        if (enemy.num_animation_frames == 0) {
-            std::cerr << "Invalid animation sequence for enemy sprite" << std::endl;
-            enemy.state = ENEMY_STATE_DESPAWNED;
-            enemy.sprite_descriptor = nullptr;
-            enemy.animation_data = nullptr;
-            continue;
-        }
-
-        // Set initial velocities and facing
-        // (state and spawn_timer_and_animation will be set by reset_for_stage())
-        enemy.x_vel = 0;
-        enemy.y_vel = 0;
-        enemy.facing = ENEMY_FACING_LEFT;
-        enemy.restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+        enemies.num_animation_frames[i] = static_cast<uint8_t>(enemies.animation_data[i]->frame_sequence.size());
+    } else {
+        // Headless simulation: only the length of the animation cycle
+        // matters; the enemy is simulated but never drawn.
+        enemies.animation_data[i] = nullptr;
+        enemies.num_animation_frames[i] = static_cast<uint8_t>(build_enemy_animation_sequence(
+            sprite_desc.num_distinct_frames, sprite_desc.animation).size());
+    }
+    if (enemies.num_animation_frames[i] == 0) {
+        std::cerr << "Invalid animation sequence for enemy sprite" << std::endl;
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.sprite_descriptor[i] = nullptr;
+        enemies.animation_data[i] = nullptr;
+        return false;
     }
 
-    reset_for_stage();
-    reset_fireballs();
+    // Set initial velocities and facing
+    // (state and spawn_timer_and_animation will be set by reset_for_stage())
+    enemies.x_vel[i] = 0;
+    enemies.y_vel[i] = 0;
+    enemies.facing[i] = ENEMY_FACING_LEFT;
+    enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    return true;
 }
 
-void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x, int render_scale) const {
+void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x, int render_scale,
+                                 const ActorRenderOffsets* offsets) const {
     if (!graphics_system) {
         return;
     }
@@ -287,46 +469,56 @@ void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x,
         return;
     }
 
-    for (const auto& enemy : enemies) {
-        if (enemy.state == ENEMY_STATE_DESPAWNED) {
+    for (int enemy_index = 0; enemy_index < enemies.size(); ++enemy_index) {
+        const uint8_t state = enemies.state[enemy_index];
+        if (state == ENEMY_STATE_DESPAWNED) {
             continue;
         }
 
+        const uint8_t enemy_x = enemies.x[enemy_index];
+        const uint8_t facing = enemies.facing[enemy_index];
+        const SpriteAnimationData* animation_data = enemies.animation_data[enemy_index];
+        const shp_t* sprite_descriptor = enemies.sprite_descriptor[enemy_index];
+
         // Cull enemies outside the visible viewport; 2-unit margin covers sprite width
-        if (static_cast<int>(enemy.x) < camera_x - 2 ||
-            static_cast<int>(enemy.x) >= camera_x + PLAYFIELD_WIDTH + 2) {
+        if (static_cast<int>(enemy_x) < camera_x - 2 ||
+            static_cast<int>(enemy_x) >= camera_x + PLAYFIELD_WIDTH + 2) {
             continue;
         }
 
-        if (!enemy.animation_data || enemy.animation_data->frames_left.empty()) {
+        if (!animation_data || animation_data->frames_left.empty()) {
             continue;
         }
 
-        const auto& sequence = enemy.animation_data->frame_sequence;
+        const auto& sequence = animation_data->frame_sequence;
         if (sequence.empty()) {
             continue;
         }
 
-        uint8_t sequence_index = enemy.spawn_timer_and_animation % sequence.size();
+        uint8_t sequence_index = enemies.spawn_timer_and_animation[enemy_index] % sequence.size();
         uint8_t frame_index = sequence[sequence_index];
 
         const TextureInfo* frame_info = nullptr;
         bool flip_h = false;
 
-        if (enemy.sprite_descriptor && enemy.sprite_descriptor->horizontal == ENEMY_HORIZONTAL_SEPARATE) {
-            const auto& right_frames = enemy.animation_data->frames_right;
-            if (enemy.facing == ENEMY_FACING_RIGHT && !right_frames.empty()) {
+        if (sprite_descriptor && sprite_descriptor->horizontal == ENEMY_HORIZONTAL_SEPARATE) {
+            const auto& right_frames = animation_data->frames_right;
+            if (facing == ENEMY_FACING_RIGHT && !right_frames.empty()) {
                 frame_info = &right_frames[frame_index % right_frames.size()];
             } else {
-                frame_info = &enemy.animation_data->frames_left[frame_index % enemy.animation_data->frames_left.size()];
+                frame_info = &animation_data->frames_left[frame_index % animation_data->frames_left.size()];
             }
         } else {
-            frame_info = &enemy.animation_data->frames_left[frame_index % enemy.animation_data->frames_left.size()];
-            flip_h = (enemy.facing == ENEMY_FACING_RIGHT);
+            frame_info = &animation_data->frames_left[frame_index % animation_data->frames_left.size()];
+            flip_h = (facing == ENEMY_FACING_RIGHT);
         }
 
-        const int enemy_screen_x = (static_cast<int>(enemy.x) - camera_x) * render_scale + render_scale;
-        const int enemy_screen_y = static_cast<int>(enemy.y) * render_scale + render_scale;
+        int enemy_screen_x = (static_cast<int>(enemy_x) - camera_x) * render_scale + render_scale;
+        int enemy_screen_y = static_cast<int>(enemies.y[enemy_index]) * render_scale + render_scale;
+        if (offsets && enemy_index < MAX_NUM_ENEMIES) {
+            enemy_screen_x += offsets->enemy_dx[enemy_index];
+            enemy_screen_y += offsets->enemy_dy[enemy_index];
+        }
 
         auto render_enemy_base = [&]() {
             if (!frame_info || !frame_info->texture) {
@@ -341,6 +533,7 @@ void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x,
             sprite.width = frame_info->width;
             sprite.height = frame_info->height;
 
+            graphics_system->set_render_layer(RenderLayer::ENEMIES);
             graphics_system->render_sprite_centered_scaled(
                 enemy_screen_x,
                 enemy_screen_y,
@@ -351,25 +544,25 @@ void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x,
             );
         };
 
-        if (enemy.state == ENEMY_STATE_SPAWNED) {
+        if (state == ENEMY_STATE_SPAWNED) {
             render_enemy_base();
             continue;
         }
 
         // Pit-fall sentinel: render enemy clamped at bottom for one frame,
         // with no spark effect, then despawn on the next update tick.
-        if (enemy.state == ENEMY_STATE_PIT_FALL_SENTINEL) {
+        if (state == ENEMY_STATE_PIT_FALL_SENTINEL) {
             render_enemy_base();
             continue;
         }
 
         // Dying enemy states: white spark (2..7) or red spark (8..13).
-        if (enemy.state >= ENEMY_STATE_WHITE_SPARK) {
+        if (state >= ENEMY_STATE_WHITE_SPARK) {
 
-            uint8_t normalized_state = enemy.state;
-            if (enemy.state >= ENEMY_STATE_RED_SPARK) {
+            uint8_t normalized_state = state;
+            if (state >= ENEMY_STATE_RED_SPARK) {
                 normalized_state = static_cast<uint8_t>(
-                    enemy.state - (ENEMY_STATE_RED_SPARK - ENEMY_STATE_WHITE_SPARK));
+                    state - (ENEMY_STATE_RED_SPARK - ENEMY_STATE_WHITE_SPARK));
             }
 
             // Match original layering: draw enemy below spark for first 3 spark frames.
@@ -377,15 +570,18 @@ void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x,
                 render_enemy_base();
             }
 
-            const uint8_t spark_set = (enemy.state >= ENEMY_STATE_RED_SPARK) ? 1 : 0;
+            const uint8_t spark_set = (state >= ENEMY_STATE_RED_SPARK) ? 1 : 0;
             const uint8_t spark_base = (spark_set == 0) ? ENEMY_STATE_WHITE_SPARK : ENEMY_STATE_RED_SPARK;
-            const uint8_t spark_frame = static_cast<uint8_t>((enemy.state - spark_base) % 3);
+            const uint8_t spark_frame = static_cast<uint8_t>((state - spark_base) % 3);
 
-            const Sprite* spark_sprite = spark_sprites[spark_set][spark_frame];
+            const Sprite* spark_sprite = graphics_system->get_sprite(spark_sprites[spark_set][spark_frame]);
             if (!spark_sprite || !spark_sprite->texture.texture) {
                 continue;
             }
 
+            // Sparks sit on their own layer so they stay above enemy sprites
+            // once the render queue groups draws by texture.
+            graphics_system->set_render_layer(RenderLayer::ENEMY_EFFECTS);
             graphics_system->render_sprite_centered_scaled(
                 enemy_screen_x,
                 enemy_screen_y,
@@ -397,25 +593,67 @@ void ActorSystem::render_enemies(GraphicsSystem* graphics_system, int camera_x,
     }
 }
 
+// Spark sets (white, red), three frames each
+static const char* const SPARK_SPRITE_NAMES[2] = {"white_spark", "red_spark"};
+
+// Item sprite names by item type (nullptr: unused type), even/odd frames each
+static const char* const ITEM_SPRITE_NAMES[15] = {
+    "corkscrew",    // 0
+    "doorkey",      // 1
+    "boots",        // 2
+    "lantern",      // 3
+    "teleportwand", // 4
+    "gems",         // 5
+    "crown",        // 6
+    "gold",         // 7
+    "cola",         // 8
+    nullptr,         // 9 (unused)
+    nullptr,         // 10 (unused)
+    nullptr,         // 11 (unused)
+    nullptr,         // 12 (unused)
+    nullptr,         // 13 (unused)
+    "shield"        // 14
+};
+static const char* const ITEM_FRAME_NAMES[2] = {"even", "odd"};
+
+void ActorSystem::request_sprites(GraphicsSystem* graphics_system) {
+    if (!graphics_system) {
+        return;
+    }
+    for (uint8_t i = 0; i < FIREBALL_NUM_FRAMES; i++) {
+        const char dir[2] = {static_cast<char>('0' + i), '\0'};
+        graphics_system->request_sprite("fireball", dir);
+    }
+    for (const char* name : SPARK_SPRITE_NAMES) {
+        for (int frame = 0; frame < 3; ++frame) {
+            const char dir[2] = {static_cast<char>('0' + frame), '\0'};
+            graphics_system->request_sprite(name, dir);
+        }
+    }
+    for (const char* name : ITEM_SPRITE_NAMES) {
+        for (const char* frame_name : ITEM_FRAME_NAMES) {
+            if (name) {
+                graphics_system->request_sprite(name, frame_name);
+            }
+        }
+    }
+}
+
 bool ActorSystem::load_effect_sprites(GraphicsSystem* graphics_system) {
     if (!graphics_system) {
         return false;
     }
 
     bool ok = true;
-    const char* names[2] = {"white_spark", "red_spark"};
     for (int set = 0; set < 2; ++set) {
         for (int frame = 0; frame < 3; ++frame) {
-            const std::string dir = std::to_string(frame);
-            if (!graphics_system->load_sprite(names[set], dir)) {
-                std::cerr << "Failed to load spark sprite " << names[set]
+            const char dir[2] = {static_cast<char>('0' + frame), '\0'};
+            spark_sprites[set][frame] = graphics_system->load_sprite_id(SPARK_SPRITE_NAMES[set], dir);
+            if (spark_sprites[set][frame] == INVALID_SPRITE_ID) {
+                std::cerr << "Failed to load spark sprite " << SPARK_SPRITE_NAMES[set]
                           << "_" << frame << std::endl;
                 ok = false;
             }
-            spark_sprites[set][frame] = graphics_system->get_sprite(names[set], dir);
-            if (!spark_sprites[set][frame]) {
-                ok = false;
-            }
         }
     }
 
@@ -426,21 +664,37 @@ bool ActorSystem::load_effect_sprites(GraphicsSystem* graphics_system) {
  * Main update function - called once per game tick
  */
 void ActorSystem::update(
+    GameContext& game_context,
     uint8_t comic_x, uint8_t comic_y,
     uint8_t comic_facing,
     const uint8_t* tiles,
     int camera_x,
     uint8_t fire_key) {
-    // Store global state for use by behavior functions
+    PROFILE_SCOPE(ProfilePhase::ACTORS);
+
+    // Store game state for use by behavior functions
+    game = &game_context;
     g_comic_x = comic_x;
     g_comic_y = comic_y;
     g_comic_facing = comic_facing;
     g_camera_x = camera_x;
     current_tiles = tiles;
 
-    auto despawn_enemy = [&](enemy_t& enemy) {
-        enemy.state = ENEMY_STATE_DESPAWNED;
-        enemy.spawn_timer_and_animation = enemy_respawn_counter_cycle;
+    // Share the physics bitboard only when it was packed from these tiles with
+    // the same table. The player's table clears the level's door tiles, which
+    // stay solid for enemies, so a level with doors packs its own.
+    const CollisionBitboard& stage_collision = get_stage_collision(*game);
+    if (tiles != nullptr && stage_collision.get_source() == tiles &&
+        stage_collision.get_solidity() == solidity) {
+        collision = &stage_collision;
+    } else {
+        local_collision.build(tiles, solidity);
+        collision = &local_collision;
+    }
+
+    auto despawn_enemy = [&](int i) {
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = enemy_respawn_counter_cycle;
 
         // Cycle respawn timer: 20→40→60→80→100→20
         enemy_respawn_counter_cycle += RESPAWN_TIMER_STEP;
@@ -451,51 +705,57 @@ void ActorSystem::update(
 
     spawned_this_tick = 0;
 
-    for (int i = 0; i < MAX_NUM_ENEMIES; i++) {
-        enemy_t& enemy = enemies[i];
+    // Behaviors only touch their own slot and read Comic, the camera and the
+    // map, so the spawned enemies can all move first, one behavior at a time;
+    // everything that shares state between slots (the one spawn per tick, the
+    // respawn timer cycle, hits on Comic) then runs in slot order as before
+    run_behavior_passes();
+    find_enemies_near_player();
+
+    for (int i = 0; i < enemies.size(); i++) {
+        // Handle spawned state (moved above)
+        if (enemy_ticked[i]) {
+            check_enemy_despawn(i);
+
+            if (enemies.state[i] != ENEMY_STATE_SPAWNED) {
+                continue;
+            }
+
+            if (enemy_near_player[i]) {
+                check_enemy_player_collision(i);
+            }
+            continue;
+        }
 
         // Handle despawned state
-        if (enemy.state == ENEMY_STATE_DESPAWNED) {
-            if (enemy.spawn_timer_and_animation > 0) {
-                enemy.spawn_timer_and_animation--;
+        if (enemies.state[i] == ENEMY_STATE_DESPAWNED) {
+            if (enemies.spawn_timer_and_animation[i] > 0) {
+                enemies.spawn_timer_and_animation[i]--;
             }
-            if (enemy.spawn_timer_and_animation == 0) {
+            if (enemies.spawn_timer_and_animation[i] == 0) {
                 maybe_spawn_enemy(i);
             }
             continue;
         }
 
-        if (enemy.state == ENEMY_STATE_PIT_FALL_SENTINEL) {
-            despawn_enemy(enemy);
+        if (enemies.state[i] == ENEMY_STATE_PIT_FALL_SENTINEL) {
+            despawn_enemy(i);
             continue;
         }
 
         // Handle death animation states (white spark or red spark)
-        if (enemy.state >= ENEMY_STATE_WHITE_SPARK) {
+        if (enemies.state[i] >= ENEMY_STATE_WHITE_SPARK) {
             // Still animating spark effect
-            if ((enemy.state == ENEMY_STATE_WHITE_SPARK + DEATH_ANIMATION_LAST_FRAME) ||
-                (enemy.state == ENEMY_STATE_RED_SPARK + DEATH_ANIMATION_LAST_FRAME)) {
+            if ((enemies.state[i] == ENEMY_STATE_WHITE_SPARK + DEATH_ANIMATION_LAST_FRAME) ||
+                (enemies.state[i] == ENEMY_STATE_RED_SPARK + DEATH_ANIMATION_LAST_FRAME)) {
                 // Animation finished; despawn
-                despawn_enemy(enemy);
+                despawn_enemy(i);
             } else {
                 // Advance animation frame
-                enemy.state++;
+                enemies.state[i]++;
             }
             continue;
         }
-
-        // Handle spawned state
-        if (enemy.state == ENEMY_STATE_SPAWNED) {
-            update_enemy_animation(&enemy);
-            handle_single_enemy(i);
-            check_enemy_despawn(&enemy);
-
-            if (enemy.state != ENEMY_STATE_SPAWNED) {
-                continue;
-            }
-
-            check_enemy_player_collision(&enemy);
-        }
     }
 
     // ---- Fireball system ----
@@ -539,14 +799,14 @@ void ActorSystem::update(
 /**
  * Update animation frame
  */
-void ActorSystem::update_enemy_animation(enemy_t* enemy) {
-    if (!enemy || enemy->num_animation_frames == 0) {
+void ActorSystem::update_enemy_animation(int i) {
+    if (enemies.num_animation_frames[i] == 0) {
         return;
     }
 
-    enemy->spawn_timer_and_animation++;
-    if (enemy->spawn_timer_and_animation >= enemy->num_animation_frames) {
-        enemy->spawn_timer_and_animation = 0;  // Loop animation
+    enemies.spawn_timer_and_animation[i]++;
+    if (enemies.spawn_timer_and_animation[i] >= enemies.num_animation_frames[i]) {
+        enemies.spawn_timer_and_animation[i] = 0;  // Loop animation
     }
 }
 
@@ -554,7 +814,7 @@ void ActorSystem::update_enemy_animation(enemy_t* enemy) {
  * Try to spawn an enemy from despawned state
  */
 bool ActorSystem::maybe_spawn_enemy(int enemy_index) {
-    if (enemy_index < 0 || enemy_index >= MAX_NUM_ENEMIES) {
+    if (enemy_index < 0 || enemy_index >= enemies.size()) {
         return false;
     }
 
@@ -563,12 +823,12 @@ bool ActorSystem::maybe_spawn_enemy(int enemy_index) {
         return false;
     }
 
-    enemy_t& enemy = enemies[enemy_index];
+    const int i = enemy_index;
 
     // Check if slot is used
-    if ((enemy.behavior & ~ENEMY_BEHAVIOR_FAST) >= ENEMY_BEHAVIOR_UNUSED) {
-        enemy.state = ENEMY_STATE_DESPAWNED;
-        enemy.spawn_timer_and_animation = 100;
+    if ((enemies.behavior[i] & ~ENEMY_BEHAVIOR_FAST) >= ENEMY_BEHAVIOR_UNUSED) {
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = 100;
         return false;
     }
 
@@ -605,148 +865,182 @@ bool ActorSystem::maybe_spawn_enemy(int enemy_index) {
         search_y = PLAYFIELD_HEIGHT - 2;
     }
 
-    bool solid_found = false;
-    while (search_y > 0) {
-        if (is_tile_solid(get_tile_at(spawn_x, static_cast<uint8_t>(search_y)))) {
-            solid_found = true;
-            break;
-        }
-        search_y -= 2;
+    // Both scans are column bit scans; search_y is always even
+    const int spawn_tile_x = spawn_x / 2;
+    const int solid_row = collision->find_solid_at_or_above(spawn_tile_x, search_y / 2);
+    if (solid_row < 1) {
+        return false;  // Rows scanned stop short of row 0 (search_y > 0)
     }
 
-    if (!solid_found) {
-        return false;
-    }
-
-    bool spawn_found = false;
-    uint8_t spawn_y = 0;
-    while (search_y >= 0) {
-        search_y -= 2;
-        if (search_y < 0) {
-            break;
-        }
-
-        if (!is_tile_solid(get_tile_at(spawn_x, static_cast<uint8_t>(search_y)))) {
-            spawn_y = static_cast<uint8_t>(search_y);
-            spawn_found = true;
-            break;
-        }
-    }
-
-    if (!spawn_found) {
+    const int open_row = collision->find_open_at_or_above(spawn_tile_x, solid_row - 1);
+    if (open_row < 0) {
         return false;
     }
+    const uint8_t spawn_y = static_cast<uint8_t>(open_row * 2);
 
     // Initialize spawned enemy
     spawned_this_tick = 1;
-    enemy.x = spawn_x;
-    enemy.y = spawn_y;
-    enemy.state = ENEMY_STATE_SPAWNED;
-    enemy.spawn_timer_and_animation = 0;  // Start animation at frame 0
+    enemies.x[i] = spawn_x;
+    enemies.y[i] = spawn_y;
+    enemies.state[i] = ENEMY_STATE_SPAWNED;
+    enemies.spawn_timer_and_animation[i] = 0;  // Start animation at frame 0
 
     // Initialize velocities based on behavior type
-    uint8_t behavior_type = enemy.behavior & ~ENEMY_BEHAVIOR_FAST;
+    uint8_t behavior_type = enemies.behavior[i] & ~ENEMY_BEHAVIOR_FAST;
     switch (behavior_type) {
         case ENEMY_BEHAVIOR_BOUNCE:
         case ENEMY_BEHAVIOR_SHY:
-            enemy.x_vel = -1;  // Start moving left
-            enemy.y_vel = -1;  // Start moving up
-            enemy.facing = ENEMY_FACING_LEFT;
+            enemies.x_vel[i] = -1;  // Start moving left
+            enemies.y_vel[i] = -1;  // Start moving up
+            enemies.facing[i] = ENEMY_FACING_LEFT;
             break;
 
         case ENEMY_BEHAVIOR_LEAP:
         case ENEMY_BEHAVIOR_ROLL:
         case ENEMY_BEHAVIOR_SEEK:
         default:
-            enemy.x_vel = 0;
-            enemy.y_vel = 0;
-            enemy.facing = ENEMY_FACING_LEFT;
+            enemies.x_vel[i] = 0;
+            enemies.y_vel[i] = 0;
+            enemies.facing[i] = ENEMY_FACING_LEFT;
             break;
     }
 
     // Set restraint based on speed flag
-    if (enemy.behavior & ENEMY_BEHAVIOR_FAST) {
-        enemy.restraint = ENEMY_RESTRAINT_MOVE_EVERY_TICK;
+    if (enemies.behavior[i] & ENEMY_BEHAVIOR_FAST) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_EVERY_TICK;
     } else {
-        enemy.restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
     }
 
+    count_event(Counter::ENEMIES_SPAWNED);
     return true;
 }
 
+// Index into behavior_slots of a behavior type (BOUNCE..SHY)
+static int behavior_pass(uint8_t behavior_type) {
+    return behavior_type - ENEMY_BEHAVIOR_BOUNCE;
+}
+
 /**
- * Handle a single spawned enemy's AI update
+ * Move every spawned enemy, one pass per behavior type
+ *
+ * Slots spawned at the start of the tick are sorted into per-behavior
+ * lists in slot order, so each pass runs one behavior function over its
+ * enemies back to back.
  */
-void ActorSystem::handle_single_enemy(int enemy_index) {
-    if (enemy_index < 0 || enemy_index >= MAX_NUM_ENEMIES) {
-        return;
+void ActorSystem::run_behavior_passes() {
+    for (auto& slots : behavior_slots) {
+        slots.clear();
+    }
+    for (int i = 0; i < enemies.size(); i++) {
+        enemy_ticked[i] = enemies.state[i] == ENEMY_STATE_SPAWNED ? 1 : 0;
+        if (!enemy_ticked[i]) {
+            continue;
+        }
+        update_enemy_animation(i);
+        const uint8_t behavior_type = enemies.behavior[i] & ~ENEMY_BEHAVIOR_FAST;
+        if (behavior_type >= ENEMY_BEHAVIOR_BOUNCE && behavior_type <= ENEMY_BEHAVIOR_SHY) {
+            behavior_slots[behavior_pass(behavior_type)].push_back(i);
+        }
     }
 
-    enemy_t& enemy = enemies[enemy_index];
-    uint8_t behavior_type = enemy.behavior & ~ENEMY_BEHAVIOR_FAST;
+    for (int i : behavior_slots[behavior_pass(ENEMY_BEHAVIOR_BOUNCE)]) {
+        enemy_behavior_bounce(i);
+    }
+    for (int i : behavior_slots[behavior_pass(ENEMY_BEHAVIOR_LEAP)]) {
+        enemy_behavior_leap(i);
+    }
+    for (int i : behavior_slots[behavior_pass(ENEMY_BEHAVIOR_ROLL)]) {
+        enemy_behavior_roll(i);
+    }
+    for (int i : behavior_slots[behavior_pass(ENEMY_BEHAVIOR_SEEK)]) {
+        enemy_behavior_seek(i);
+    }
+    for (int i : behavior_slots[behavior_pass(ENEMY_BEHAVIOR_SHY)]) {
+        enemy_behavior_shy(i);
+    }
+}
 
-    switch (behavior_type) {
-        case ENEMY_BEHAVIOR_BOUNCE:
-            enemy_behavior_bounce(&enemy);
-            break;
-        case ENEMY_BEHAVIOR_LEAP:
-            enemy_behavior_leap(&enemy);
-            break;
-        case ENEMY_BEHAVIOR_ROLL:
-            enemy_behavior_roll(&enemy);
-            break;
-        case ENEMY_BEHAVIOR_SEEK:
-            enemy_behavior_seek(&enemy);
-            break;
-        case ENEMY_BEHAVIOR_SHY:
-            enemy_behavior_shy(&enemy);
-            break;
-        default:
-            break;
+/**
+ * Put every spawned enemy into the broadphase grid
+ */
+void ActorSystem::build_enemy_grid() {
+    enemy_grid.clear(enemies.size());
+    for (int i = 0; i < enemies.size(); i++) {
+        if (enemies.state[i] == ENEMY_STATE_SPAWNED) {
+            enemy_grid.insert(i, enemies.x[i], enemies.y[i]);
+        }
     }
 }
 
 /**
- * Check if enemy should despawn due to distance
+ * Mark the enemies that may touch Comic this tick
+ *
+ * Comic's hitbox covers enemy positions x-1..x+1 and y..y+3; only enemies
+ * in the grid cells of those positions get the exact test.
  */
-void ActorSystem::check_enemy_despawn(enemy_t* enemy) {
-    if (!enemy) return;
+void ActorSystem::find_enemies_near_player() {
+    std::fill(enemy_near_player.begin(), enemy_near_player.end(), static_cast<uint8_t>(0));
+    build_enemy_grid();
+
+    int cells[12];
+    int num_cells = 0;
+    for (int x = g_comic_x - 1; x <= g_comic_x + 1; x++) {
+        for (int y = g_comic_y; y < g_comic_y + 4; y++) {
+            if (x < 0 || x > 0xFF || y > 0xFF) {
+                continue;
+            }
+            const int cell = ActorGrid::cell_of(static_cast<uint8_t>(x), static_cast<uint8_t>(y));
+            if (std::find(cells, cells + num_cells, cell) == cells + num_cells) {
+                cells[num_cells++] = cell;
+            }
+        }
+    }
+    for (int c = 0; c < num_cells; c++) {
+        for (int i = enemy_grid.first(cells[c]); i >= 0; i = enemy_grid.next(i)) {
+            enemy_near_player[i] = 1;
+        }
+    }
+}
 
-    int16_t x_diff = static_cast<int16_t>(static_cast<int>(enemy->x) - static_cast<int>(g_comic_x));
+/**
+ * Check if enemy should despawn due to distance
+ */
+void ActorSystem::check_enemy_despawn(int i) {
+    int16_t x_diff = static_cast<int16_t>(static_cast<int>(enemies.x[i]) - static_cast<int>(g_comic_x));
     if (x_diff < -ENEMY_DESPAWN_RADIUS || x_diff > ENEMY_DESPAWN_RADIUS) {
-        enemy->state = ENEMY_STATE_DESPAWNED;
-        enemy->spawn_timer_and_animation = enemy_respawn_counter_cycle;
+        enemies.state[i] = ENEMY_STATE_DESPAWNED;
+        enemies.spawn_timer_and_animation[i] = enemy_respawn_counter_cycle;
+        count_event(Counter::ENEMIES_DESPAWNED);
     }
 }
 
 /**
  * Check collision between enemy and player
  */
-void ActorSystem::check_enemy_player_collision(enemy_t* enemy) {
-    if (!enemy) return;
-
-    if (enemy->state != ENEMY_STATE_SPAWNED) {
+void ActorSystem::check_enemy_player_collision(int i) {
+    if (enemies.state[i] != ENEMY_STATE_SPAWNED) {
         return;
     }
 
-    if (is_player_dying()) {
+    if (is_player_dying(*game)) {
         return;
     }
 
-    int16_t x_diff = static_cast<int16_t>(static_cast<int>(enemy->x) - static_cast<int>(g_comic_x));
-    int16_t y_diff = static_cast<int16_t>(static_cast<int>(enemy->y) - static_cast<int>(g_comic_y));
+    int16_t x_diff = static_cast<int16_t>(static_cast<int>(enemies.x[i]) - static_cast<int>(g_comic_x));
+    int16_t y_diff = static_cast<int16_t>(static_cast<int>(enemies.y[i]) - static_cast<int>(g_comic_y));
 
     // Collision box: horizontal abs(enemy.x - comic.x) <= 1, vertical 0 <= (enemy.y - comic.y) < 4
     if (x_diff >= -1 && x_diff <= 1 && y_diff >= 0 && y_diff < 4) {
         // Collision! Start red spark death animation
-        enemy->state = ENEMY_STATE_RED_SPARK;
+        enemies.state[i] = ENEMY_STATE_RED_SPARK;
 
         // Shield absorbs six hits (HP 6 -> 0); next hit at 0 HP kills Comic.
-        if (comic_hp > 0) {
-            comic_hp--;
+        if (game->comic_hp > 0) {
+            game->comic_hp--;
             play_game_sound(GameSound::PLAYER_HIT);
         } else {
-            trigger_player_death();
+            trigger_player_death(*game);
         }
     }
 }
@@ -755,27 +1049,58 @@ void ActorSystem::check_enemy_player_collision(enemy_t* enemy) {
  * Check if a tile is solid
  */
 bool ActorSystem::is_tile_solid(uint8_t tile_id) const {
-    return tile_id > tileset_last_passable;
+    return solidity.is_solid(tile_id);
 }
 
 /**
  * Get tile at coordinates
  */
-uint8_t ActorSystem::get_tile_at(uint8_t x, uint8_t y) const {
-    if (!current_tiles) {
+uint8_t ActorSystem::get_tile_at(int x, int y) const {
+    if (!current_tiles || x < 0 || y < 0) {
         return 0;  // Passable if no tile data available
     }
 
     // Each tile is 2 game units
-    uint8_t tile_x = x / 2;
-    uint8_t tile_y = y / 2;
+    const int tile_x = x / 2;
+    const int tile_y = y / 2;
 
     if (tile_x >= current_map_width_tiles || tile_y >= current_map_height_tiles) {
         return 0;  // Out of bounds = passable
     }
 
-    uint16_t index = tile_y * current_map_width_tiles + tile_x;
-    return current_tiles[index];
+    return current_tiles[tile_y * current_map_width_tiles + tile_x];
+}
+
+/**
+ * Move the actors with a streamed map's window
+ */
+void ActorSystem::shift_window(int shift_units) {
+    window_origin_units += shift_units;
+    for (int i = 0; i < enemies.size(); i++) {
+        if (enemies.state[i] == ENEMY_STATE_DESPAWNED) {
+            continue;
+        }
+        const int x = enemies.x[i] - shift_units;
+        if (x < 0 || x >= MAP_WIDTH) {
+            enemies.state[i] = ENEMY_STATE_DESPAWNED;
+            enemies.spawn_timer_and_animation[i] = enemy_respawn_counter_cycle;
+            count_event(Counter::ENEMIES_DESPAWNED);
+            continue;
+        }
+        enemies.x[i] = static_cast<uint8_t>(x);
+    }
+    for (fireball_t& fireball : fireballs) {
+        if (fireball.x == FIREBALL_DEAD && fireball.y == FIREBALL_DEAD) {
+            continue;
+        }
+        const int x = fireball.x - shift_units;
+        if (x < 0 || x >= MAP_WIDTH) {
+            fireball.x = FIREBALL_DEAD;
+            fireball.y = FIREBALL_DEAD;
+            continue;
+        }
+        fireball.x = static_cast<uint8_t>(x);
+    }
 }
 
 /**
@@ -785,14 +1110,11 @@ uint8_t ActorSystem::get_tile_at(uint8_t x, uint8_t y) const {
  * also checks (x, y+1).
  */
 bool ActorSystem::check_horizontal_enemy_map_collision(uint8_t x, uint8_t y) const {
-    if (is_tile_solid(get_tile_at(x, y))) {
-        return true;
-    }
-    // If y is odd, enemy spans two vertical tiles - check the one below
-    if (y & 1) {
-        return is_tile_solid(get_tile_at(x, static_cast<uint8_t>(y + 1)));
+    // (y + 1) / 2 is the tile below exactly when y is odd
+    if (y == 0xFF) {
+        return collision->is_solid(x / 2, 0);  // y + 1 wraps to row 0, as in the original
     }
-    return false;
+    return collision->any_solid_in_column(x / 2, y / 2, (y + 1) / 2);
 }
 
 /**
@@ -802,14 +1124,11 @@ bool ActorSystem::check_horizontal_enemy_map_collision(uint8_t x, uint8_t y) con
  * also checks (x+1, y).
  */
 bool ActorSystem::check_vertical_enemy_map_collision(uint8_t x, uint8_t y) const {
-    if (is_tile_solid(get_tile_at(x, y))) {
-        return true;
+    // (x + 1) / 2 is the tile to the right exactly when x is odd
+    if (x == 0xFF) {
+        return collision->is_solid(127, y / 2) || collision->is_solid(0, y / 2);  // x + 1 wraps
     }
-    // If x is odd, enemy spans two horizontal tiles - check the one to the right
-    if (x & 1) {
-        return is_tile_solid(get_tile_at(static_cast<uint8_t>(x + 1), y));
-    }
-    return false;
+    return collision->any_solid_in_row(y / 2, x / 2, (x + 1) / 2);
 }
 
 // ============================================================================
@@ -820,50 +1139,48 @@ bool ActorSystem::check_vertical_enemy_map_collision(uint8_t x, uint8_t y) const
  * BOUNCE behavior: Diagonal bouncing with independent x/y velocities
  * Used by: Fire Ball, Brave Bird
  */
-void ActorSystem::enemy_behavior_bounce(enemy_t* enemy) {
-    if (!enemy) return;
-
+void ActorSystem::enemy_behavior_bounce(int i) {
     // Handle restraint (movement throttle)
-    if (enemy->restraint == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
         return;  // Skip this tick
     }
 
-    if (enemy->restraint == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;  // Skip next tick
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_SKIP_THIS_TICK;  // Skip next tick
     }
 
     // Horizontal movement
     uint8_t next_x;
     int16_t camera_rel_x;
 
-    if (enemy->x_vel > 0) {
+    if (enemies.x_vel[i] > 0) {
         // Moving right
-        enemy->facing = ENEMY_FACING_RIGHT;
-        next_x = static_cast<uint8_t>(enemy->x + 2);
-        if (check_horizontal_enemy_map_collision(next_x, enemy->y)) {
-            enemy->x_vel = -1;  // Bounce left
+        enemies.facing[i] = ENEMY_FACING_RIGHT;
+        next_x = static_cast<uint8_t>(enemies.x[i] + 2);
+        if (check_horizontal_enemy_map_collision(next_x, enemies.y[i])) {
+            enemies.x_vel[i] = -1;  // Bounce left
         } else {
-            enemy->x = static_cast<uint8_t>(enemy->x + 1);
-            camera_rel_x = static_cast<int16_t>(enemy->x) - static_cast<int16_t>(g_camera_x);
+            enemies.x[i] = static_cast<uint8_t>(enemies.x[i] + 1);
+            camera_rel_x = static_cast<int16_t>(enemies.x[i]) - static_cast<int16_t>(g_camera_x);
             if (camera_rel_x >= PLAYFIELD_WIDTH - 2) {
-                enemy->x_vel = -1;  // Hit right edge, bounce
+                enemies.x_vel[i] = -1;  // Hit right edge, bounce
             }
         }
     } else {
         // Moving left
-        enemy->facing = ENEMY_FACING_LEFT;
-        if (enemy->x == 0) {
-            enemy->x_vel = 1;  // Hit left edge, bounce
+        enemies.facing[i] = ENEMY_FACING_LEFT;
+        if (enemies.x[i] == 0) {
+            enemies.x_vel[i] = 1;  // Hit left edge, bounce
         } else {
-            next_x = static_cast<uint8_t>(enemy->x - 1);
-            if (check_horizontal_enemy_map_collision(next_x, enemy->y)) {
-                enemy->x_vel = 1;  // Bounce right
+            next_x = static_cast<uint8_t>(enemies.x[i] - 1);
+            if (check_horizontal_enemy_map_collision(next_x, enemies.y[i])) {
+                enemies.x_vel[i] = 1;  // Bounce right
             } else {
-                enemy->x = next_x;
-                camera_rel_x = static_cast<int16_t>(enemy->x) - static_cast<int16_t>(g_camera_x);
+                enemies.x[i] = next_x;
+                camera_rel_x = static_cast<int16_t>(enemies.x[i]) - static_cast<int16_t>(g_camera_x);
                 if (camera_rel_x <= 0) {
-                    enemy->x_vel = 1;  // Hit left edge, bounce
+                    enemies.x_vel[i] = 1;  // Hit left edge, bounce
                 }
             }
         }
@@ -872,33 +1189,33 @@ void ActorSystem::enemy_behavior_bounce(enemy_t* enemy) {
     // Vertical movement
     uint8_t next_y;
 
-    if (enemy->y_vel > 0) {
+    if (enemies.y_vel[i] > 0) {
         // Moving down
-        if (enemy->y >= PLAYFIELD_HEIGHT - 2) {
-            enemy->y_vel = -1;  // Hit bottom, bounce up
+        if (enemies.y[i] >= PLAYFIELD_HEIGHT - 2) {
+            enemies.y_vel[i] = -1;  // Hit bottom, bounce up
         } else {
-            next_y = static_cast<uint8_t>(enemy->y + 2);
-            if (check_vertical_enemy_map_collision(enemy->x, next_y)) {
-                enemy->y_vel = -1;  // Hit solid tile, bounce
+            next_y = static_cast<uint8_t>(enemies.y[i] + 2);
+            if (check_vertical_enemy_map_collision(enemies.x[i], next_y)) {
+                enemies.y_vel[i] = -1;  // Hit solid tile, bounce
             } else {
-                enemy->y = static_cast<uint8_t>(enemy->y + 1);
-                if (enemy->y >= PLAYFIELD_HEIGHT - 2) {
-                    enemy->y_vel = -1;
+                enemies.y[i] = static_cast<uint8_t>(enemies.y[i] + 1);
+                if (enemies.y[i] >= PLAYFIELD_HEIGHT - 2) {
+                    enemies.y_vel[i] = -1;
                 }
             }
         }
     } else {
         // Moving up
-        if (enemy->y == 0) {
-            enemy->y_vel = 1;  // Hit top, bounce down
+        if (enemies.y[i] == 0) {
+            enemies.y_vel[i] = 1;  // Hit top, bounce down
         } else {
-            next_y = static_cast<uint8_t>(enemy->y - 1);
-            if (check_vertical_enemy_map_collision(enemy->x, next_y)) {
-                enemy->y_vel = 1;  // Hit solid tile, bounce
+            next_y = static_cast<uint8_t>(enemies.y[i] - 1);
+            if (check_vertical_enemy_map_collision(enemies.x[i], next_y)) {
+                enemies.y_vel[i] = 1;  // Hit solid tile, bounce
             } else {
-                enemy->y = next_y;
-                if (enemy->y == 0) {
-                    enemy->y_vel = 1;
+                enemies.y[i] = next_y;
+                if (enemies.y[i] == 0) {
+                    enemies.y_vel[i] = 1;
                 }
             }
         }
@@ -925,51 +1242,49 @@ void ActorSystem::enemy_behavior_bounce(enemy_t* enemy) {
  *   Restraint only skips horizontal movement; gravity and .check_for_ground always run
  *   .check_for_ground: if y_vel>0, check y+3; on solid: snap y=(y+1)&0xfe, y_vel=0
  */
-void ActorSystem::enemy_behavior_leap(enemy_t* enemy) {
-    if (!enemy) return;
-
+void ActorSystem::enemy_behavior_leap(int i) {
     // proposed_y tracks vertical changes before committing (mirrors ax.lo in assembly)
-    uint8_t proposed_y = enemy->y;
+    uint8_t proposed_y = enemies.y[i];
 
-    if (enemy->y_vel < 0) {
+    if (enemies.y_vel[i] < 0) {
         // === .moving_up ===
         // Assembly: sar y_vel 3x (arithmetic) → y_vel/8, still negative (e.g. -7>>3 = -1)
         //           neg → positive upward delta; sub al, delta → proposed_y += delta (negative = up)
         // Simplified: proposed_y += (int8_t)(y_vel >> ENEMY_VELOCITY_SHIFT)
         // For y_vel=-7: delta=-1, proposed_y decreases by 1 (moves up 1 unit)
-        int8_t delta = static_cast<int8_t>(enemy->y_vel >> ENEMY_VELOCITY_SHIFT);
+        int8_t delta = static_cast<int8_t>(enemies.y_vel[i] >> ENEMY_VELOCITY_SHIFT);
         int16_t new_y = static_cast<int16_t>(proposed_y) + static_cast<int16_t>(delta);
 
         if (new_y < 0) {
             // Unsigned underflow → hit top of playfield (.undo_position_change)
-            proposed_y = enemy->y;  // restore original (no change)
+            proposed_y = enemies.y[i];  // restore original (no change)
         } else {
             uint8_t target_y = static_cast<uint8_t>(new_y);
-            if (!check_vertical_enemy_map_collision(enemy->x, target_y)) {
+            if (!check_vertical_enemy_map_collision(enemies.x[i], target_y)) {
                 proposed_y = target_y;  // accept upward movement
             }
-            // else: ceiling collision → .undo_position_change (proposed_y stays = enemy->y)
+            // else: ceiling collision → .undo_position_change (proposed_y stays = enemies.y[i])
         }
         // fall through to .apply_gravity
 
-    } else if (enemy->y_vel > 0) {
+    } else if (enemies.y_vel[i] > 0) {
         // === .moving_down ===
         // Assembly: sar y_vel 3x → y_vel/8; proposed_y += that; e.g. y_vel=8 → move down 1
-        int8_t vel_over_8 = static_cast<int8_t>(enemy->y_vel >> ENEMY_VELOCITY_SHIFT);
+        int8_t vel_over_8 = static_cast<int8_t>(enemies.y_vel[i] >> ENEMY_VELOCITY_SHIFT);
         uint8_t new_y = static_cast<uint8_t>(proposed_y + vel_over_8);
 
         // Despawn at or below the bottom of the playfield
         if (new_y >= PLAYFIELD_HEIGHT - 2) {
-            enemy->state = ENEMY_STATE_PIT_FALL_SENTINEL;
-            enemy->y = PLAYFIELD_HEIGHT - 2;
+            enemies.state[i] = ENEMY_STATE_PIT_FALL_SENTINEL;
+            enemies.y[i] = PLAYFIELD_HEIGHT - 2;
             return;
         }
 
         // .keep_moving_down: look-ahead check at new_y+1
         // Assembly: inc al; check_vertical; dec al; jnc .apply_gravity (accept move)
         //            else: .start_falling → .undo_position_change (restore original pos)
-        if (check_vertical_enemy_map_collision(enemy->x, static_cast<uint8_t>(new_y + 1))) {
-            proposed_y = enemy->y;  // collision: restore original (.undo_position_change)
+        if (check_vertical_enemy_map_collision(enemies.x[i], static_cast<uint8_t>(new_y + 1))) {
+            proposed_y = enemies.y[i];  // collision: restore original (.undo_position_change)
         } else {
             proposed_y = new_y;     // no collision: accept downward movement
         }
@@ -979,17 +1294,17 @@ void ActorSystem::enemy_behavior_leap(enemy_t* enemy) {
         // === y_vel == 0 ===
         // Assembly: ax = [si+enemy.y]; al += 2; check_vertical;
         //           if solid → .begin_leap; else → .start_falling
-        if (check_vertical_enemy_map_collision(enemy->x, static_cast<uint8_t>(enemy->y + 2))) {
+        if (check_vertical_enemy_map_collision(enemies.x[i], static_cast<uint8_t>(enemies.y[i] + 2))) {
             // .begin_leap: solid ground — initiate jump toward Comic
             // Assembly: cmp comic_x(ah), enemy.x(dh); jae (.unsigned >=) → x_vel=+1 else -1
             // jae means: if comic_x >= enemy.x → enemy is at/left-of Comic → move right (+1)
-            enemy->x_vel = (g_comic_x >= enemy->x) ? 1 : -1;
-            enemy->y_vel = ENEMY_JUMP_VELOCITY;  // -7
+            enemies.x_vel[i] = (g_comic_x >= enemies.x[i]) ? 1 : -1;
+            enemies.y_vel[i] = ENEMY_JUMP_VELOCITY;  // -7
             // Assembly jumps directly to .done: stores position (unchanged), no gravity this tick
             return;
         }
         // .start_falling → .undo_position_change → .apply_gravity
-        // proposed_y stays = enemy->y; y_vel stays = 0 (gravity below will set it to 2)
+        // proposed_y stays = enemies.y[i]; y_vel stays = 0 (gravity below will set it to 2)
         // CRITICAL: do NOT return here — must fall through to gravity + horizontal + ground check
     }
 
@@ -997,50 +1312,50 @@ void ActorSystem::enemy_behavior_leap(enemy_t* enemy) {
     // Runs for all paths except .begin_leap (which returned above).
     // Assembly: dl += 2; clamp to TERMINAL_VELOCITY; store y_vel
     {
-        int16_t new_vel = static_cast<int16_t>(enemy->y_vel) + ENEMY_GRAVITY;  // +2
-        enemy->y_vel = static_cast<int8_t>(new_vel > TERMINAL_VELOCITY ? TERMINAL_VELOCITY : new_vel);
+        int16_t new_vel = static_cast<int16_t>(enemies.y_vel[i]) + ENEMY_GRAVITY;  // +2
+        enemies.y_vel[i] = static_cast<int8_t>(new_vel > TERMINAL_VELOCITY ? TERMINAL_VELOCITY : new_vel);
     }
 
     // === Restraint — only gates horizontal movement; gravity and ground-check always run ===
     bool skip_horizontal = false;
-    if (enemy->restraint == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
         // .skip_this_tick: set restraint to MOVE, then fall to .check_for_ground (skip horizontal)
-        enemy->restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
         skip_horizontal = true;
-    } else if (enemy->restraint == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
+    } else if (enemies.restraint[i] == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
         // Slow enemy: transition MOVE → SKIP
-        enemy->restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;
+        enemies.restraint[i] = ENEMY_RESTRAINT_SKIP_THIS_TICK;
     }
     // ENEMY_RESTRAINT_MOVE_EVERY_TICK: no state change
 
     // === Horizontal movement (skipped when restraint was SKIP_THIS_TICK) ===
     if (!skip_horizontal) {
         int16_t camera_rel_x;
-        if (enemy->x_vel > 0) {
+        if (enemies.x_vel[i] > 0) {
             // Moving right: check tile at x+2, advance x by 1, bounce at right playfield edge
-            uint8_t next_x = static_cast<uint8_t>(enemy->x + 2);
+            uint8_t next_x = static_cast<uint8_t>(enemies.x[i] + 2);
             if (check_horizontal_enemy_map_collision(next_x, proposed_y)) {
-                enemy->x_vel = -1;  // wall → bounce left
+                enemies.x_vel[i] = -1;  // wall → bounce left
             } else {
-                enemy->x = static_cast<uint8_t>(enemy->x + 1);
-                camera_rel_x = static_cast<int16_t>(enemy->x) - static_cast<int16_t>(g_camera_x);
+                enemies.x[i] = static_cast<uint8_t>(enemies.x[i] + 1);
+                camera_rel_x = static_cast<int16_t>(enemies.x[i]) - static_cast<int16_t>(g_camera_x);
                 if (camera_rel_x >= PLAYFIELD_WIDTH - 2) {
-                    enemy->x_vel = -1;  // right playfield edge
+                    enemies.x_vel[i] = -1;  // right playfield edge
                 }
             }
-        } else if (enemy->x_vel < 0) {
+        } else if (enemies.x_vel[i] < 0) {
             // Moving left: check tile at x-1, advance x by -1, bounce at left playfield edge
-            if (enemy->x == 0) {
-                enemy->x_vel = 1;  // already at left edge
+            if (enemies.x[i] == 0) {
+                enemies.x_vel[i] = 1;  // already at left edge
             } else {
-                uint8_t next_x = static_cast<uint8_t>(enemy->x - 1);
+                uint8_t next_x = static_cast<uint8_t>(enemies.x[i] - 1);
                 if (check_horizontal_enemy_map_collision(next_x, proposed_y)) {
-                    enemy->x_vel = 1;  // wall → bounce right
+                    enemies.x_vel[i] = 1;  // wall → bounce right
                 } else {
-                    enemy->x = next_x;
-                    camera_rel_x = static_cast<int16_t>(enemy->x) - static_cast<int16_t>(g_camera_x);
+                    enemies.x[i] = next_x;
+                    camera_rel_x = static_cast<int16_t>(enemies.x[i]) - static_cast<int16_t>(g_camera_x);
                     if (camera_rel_x <= 0) {
-                        enemy->x_vel = 1;  // left playfield edge
+                        enemies.x_vel[i] = 1;  // left playfield edge
                     }
                 }
             }
@@ -1048,16 +1363,16 @@ void ActorSystem::enemy_behavior_leap(enemy_t* enemy) {
     }
 
     // === Commit vertical position (.done in assembly: "mov [si+enemy.y], dx") ===
-    enemy->y = proposed_y;
+    enemies.y[i] = proposed_y;
 
     // === .check_for_ground: landing detection ===
     // Assembly: dx = ax; if y_vel <= 0: goto .done (still rising/hovering)
     //           al += 3; check_vertical; if solid: .landed → inc dl; and dl, 0xfe; y_vel=0
-    if (enemy->y_vel > 0) {
-        if (check_vertical_enemy_map_collision(enemy->x, static_cast<uint8_t>(enemy->y + 3))) {
+    if (enemies.y_vel[i] > 0) {
+        if (check_vertical_enemy_map_collision(enemies.x[i], static_cast<uint8_t>(enemies.y[i] + 3))) {
             // .landed: snap to even tile boundary, stop vertical movement
-            enemy->y = static_cast<uint8_t>((enemy->y + 1) & 0xFE);
-            enemy->y_vel = 0;
+            enemies.y[i] = static_cast<uint8_t>((enemies.y[i] + 1) & 0xFE);
+            enemies.y_vel[i] = 0;
         }
     }
 }
@@ -1066,221 +1381,215 @@ void ActorSystem::enemy_behavior_leap(enemy_t* enemy) {
  * ROLL behavior: Ground-following movement
  * Used by: Glow Globe
  */
-void ActorSystem::enemy_behavior_roll(enemy_t* enemy) {
-    if (!enemy) return;
-
+void ActorSystem::enemy_behavior_roll(int i) {
     uint8_t next_x;
 
     // Vertical movement: falling or on ground
-    if (enemy->y_vel > 0) {
+    if (enemies.y_vel[i] > 0) {
         // Falling: check if near bottom and despawn
-        if (enemy->y + 1 >= PLAYFIELD_HEIGHT - 3) {
-            enemy->state = ENEMY_STATE_PIT_FALL_SENTINEL;
-            enemy->y = PLAYFIELD_HEIGHT - 2;
+        if (enemies.y[i] + 1 >= PLAYFIELD_HEIGHT - 3) {
+            enemies.state[i] = ENEMY_STATE_PIT_FALL_SENTINEL;
+            enemies.y[i] = PLAYFIELD_HEIGHT - 2;
             return;
         }
         // Move down one unit (maintains horizontal momentum from before falling)
-        enemy->y = static_cast<uint8_t>(enemy->y + 1);
+        enemies.y[i] = static_cast<uint8_t>(enemies.y[i] + 1);
     } else {
         // On ground: update direction toward Comic
-        if (enemy->x < g_comic_x) {
-            enemy->x_vel = 1;
-        } else if (enemy->x > g_comic_x) {
-            enemy->x_vel = -1;
+        if (enemies.x[i] < g_comic_x) {
+            enemies.x_vel[i] = 1;
+        } else if (enemies.x[i] > g_comic_x) {
+            enemies.x_vel[i] = -1;
         } else {
-            enemy->x_vel = 0;
+            enemies.x_vel[i] = 0;
         }
     }
 
     // Handle restraint (applies to both falling and rolling)
-    if (enemy->restraint == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
         return;
     }
 
-    if (enemy->restraint == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_SKIP_THIS_TICK;
     }
 
     // Horizontal movement
-    if (enemy->x_vel == 0) {
-        enemy->restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    if (enemies.x_vel[i] == 0) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
         return;
     }
 
-    if (enemy->x_vel > 0) {
+    if (enemies.x_vel[i] > 0) {
         // Moving right
-        next_x = static_cast<uint8_t>(enemy->x + 2);
-        if (!check_horizontal_enemy_map_collision(next_x, enemy->y)) {
-            enemy->x = static_cast<uint8_t>(enemy->x + 1);
+        next_x = static_cast<uint8_t>(enemies.x[i] + 2);
+        if (!check_horizontal_enemy_map_collision(next_x, enemies.y[i])) {
+            enemies.x[i] = static_cast<uint8_t>(enemies.x[i] + 1);
         }
     } else {
         // Moving left
-        if (enemy->x == 0) {
-            enemy->x_vel = 1;  // Hit left edge, reverse direction
+        if (enemies.x[i] == 0) {
+            enemies.x_vel[i] = 1;  // Hit left edge, reverse direction
         } else {
-            next_x = static_cast<uint8_t>(enemy->x - 1);
-            if (!check_horizontal_enemy_map_collision(next_x, enemy->y)) {
-                enemy->x = next_x;
+            next_x = static_cast<uint8_t>(enemies.x[i] - 1);
+            if (!check_horizontal_enemy_map_collision(next_x, enemies.y[i])) {
+                enemies.x[i] = next_x;
             }
         }
     }
 
     // Check for ground below
-    if (!check_vertical_enemy_map_collision(enemy->x, static_cast<uint8_t>(enemy->y + 3))) {
+    if (!check_vertical_enemy_map_collision(enemies.x[i], static_cast<uint8_t>(enemies.y[i] + 3))) {
         // No ground - start falling
-        enemy->y_vel = 1;
+        enemies.y_vel[i] = 1;
         return;
     }
 
     // On ground
-    enemy->y_vel = 0;
+    enemies.y_vel[i] = 0;
 }
 
 /**
  * SEEK behavior: Pathfinding toward player
  * Used by: Killer Bee
  */
-void ActorSystem::enemy_behavior_seek(enemy_t* enemy) {
-    if (!enemy) return;
-
+void ActorSystem::enemy_behavior_seek(int i) {
     uint8_t next_x, next_y;
     bool collision;
 
     // Handle restraint
-    if (enemy->restraint == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
         return;
     }
 
-    if (enemy->restraint == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_SKIP_THIS_TICK;
     }
 
     // Horizontal movement toward Comic (prioritized)
-    if (enemy->x != g_comic_x) {
-        if (enemy->x < g_comic_x) {
+    if (enemies.x[i] != g_comic_x) {
+        if (enemies.x[i] < g_comic_x) {
             // Move right
-            next_x = static_cast<uint8_t>(enemy->x + 1);
-            collision = check_horizontal_enemy_map_collision(static_cast<uint8_t>(next_x + 1), enemy->y);
+            next_x = static_cast<uint8_t>(enemies.x[i] + 1);
+            collision = check_horizontal_enemy_map_collision(static_cast<uint8_t>(next_x + 1), enemies.y[i]);
 
             if (!collision) {
-                enemy->x = next_x;
-                enemy->x_vel = 1;
+                enemies.x[i] = next_x;
+                enemies.x_vel[i] = 1;
             } else {
-                enemy->x_vel = -1;  // Blocked, try left next time
+                enemies.x_vel[i] = -1;  // Blocked, try left next time
             }
         } else {
             // Move left
-            if (enemy->x == 0) {
-                enemy->x_vel = 1;  // Hit left edge, reverse direction
+            if (enemies.x[i] == 0) {
+                enemies.x_vel[i] = 1;  // Hit left edge, reverse direction
             } else {
-                next_x = static_cast<uint8_t>(enemy->x - 1);
-                collision = check_horizontal_enemy_map_collision(next_x, enemy->y);
+                next_x = static_cast<uint8_t>(enemies.x[i] - 1);
+                collision = check_horizontal_enemy_map_collision(next_x, enemies.y[i]);
 
                 if (!collision) {
-                    enemy->x = next_x;
-                    enemy->x_vel = -1;
+                    enemies.x[i] = next_x;
+                    enemies.x_vel[i] = -1;
                 } else {
-                    enemy->x_vel = 1;  // Blocked, try right next time
+                    enemies.x_vel[i] = 1;  // Blocked, try right next time
                 }
             }
         }
 
-        enemy->facing = (enemy->x_vel < 0) ? ENEMY_FACING_LEFT : ENEMY_FACING_RIGHT;
+        enemies.facing[i] = (enemies.x_vel[i] < 0) ? ENEMY_FACING_LEFT : ENEMY_FACING_RIGHT;
         return;  // Continue to next tick after x movement
     }
 
     // Vertical movement when x is aligned
-    if (enemy->y != g_comic_y) {
-        if (enemy->y < g_comic_y) {
+    if (enemies.y[i] != g_comic_y) {
+        if (enemies.y[i] < g_comic_y) {
             // Move down
-            next_y = static_cast<uint8_t>(enemy->y + 1);
-            collision = check_vertical_enemy_map_collision(enemy->x, static_cast<uint8_t>(next_y + 1));
+            next_y = static_cast<uint8_t>(enemies.y[i] + 1);
+            collision = check_vertical_enemy_map_collision(enemies.x[i], static_cast<uint8_t>(next_y + 1));
 
             if (!collision) {
-                enemy->y = next_y;
-                enemy->y_vel = 1;
+                enemies.y[i] = next_y;
+                enemies.y_vel[i] = 1;
             } else {
-                enemy->y_vel = -1;
+                enemies.y_vel[i] = -1;
             }
         } else {
             // Move up
-            next_y = static_cast<uint8_t>(enemy->y - 1);
-            collision = check_vertical_enemy_map_collision(enemy->x, next_y);
+            next_y = static_cast<uint8_t>(enemies.y[i] - 1);
+            collision = check_vertical_enemy_map_collision(enemies.x[i], next_y);
 
             if (!collision) {
-                enemy->y = next_y;
-                enemy->y_vel = -1;
+                enemies.y[i] = next_y;
+                enemies.y_vel[i] = -1;
             } else {
-                enemy->y_vel = 1;
+                enemies.y_vel[i] = 1;
             }
         }
     }
 
-    enemy->facing = (enemy->x_vel < 0) ? ENEMY_FACING_LEFT : ENEMY_FACING_RIGHT;
+    enemies.facing[i] = (enemies.x_vel[i] < 0) ? ENEMY_FACING_LEFT : ENEMY_FACING_RIGHT;
 }
 
 /**
  * SHY behavior: Flees when Comic is facing toward, approaches otherwise
  * Used by: Shy Bird, Spinner
  */
-void ActorSystem::enemy_behavior_shy(enemy_t* enemy) {
-    if (!enemy) return;
-
+void ActorSystem::enemy_behavior_shy(int i) {
     uint8_t next_x, next_y;
     int8_t comic_facing_enemy;
     bool collision;
     int16_t camera_rel_x;
 
     // Handle restraint (movement throttle)
-    if (enemy->restraint == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_SKIP_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
         return;  // Skip this tick
     }
 
-    if (enemy->restraint == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
-        enemy->restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;  // Skip next tick
+    if (enemies.restraint[i] == ENEMY_RESTRAINT_MOVE_THIS_TICK) {
+        enemies.restraint[i] = ENEMY_RESTRAINT_SKIP_THIS_TICK;  // Skip next tick
     }
     // Determine if Comic is facing this enemy
-    if (g_comic_facing == COMIC_FACING_RIGHT && enemy->x > g_comic_x) {
+    if (g_comic_facing == COMIC_FACING_RIGHT && enemies.x[i] > g_comic_x) {
         comic_facing_enemy = 1;  // Comic facing enemy on right
-    } else if (g_comic_facing == COMIC_FACING_LEFT && enemy->x < g_comic_x) {
+    } else if (g_comic_facing == COMIC_FACING_LEFT && enemies.x[i] < g_comic_x) {
         comic_facing_enemy = 1;  // Comic facing enemy on left
     } else {
         comic_facing_enemy = 0;  // Comic facing away
     }
 
     // Horizontal movement
-    if (enemy->x_vel > 0) {
+    if (enemies.x_vel[i] > 0) {
         // Moving right
-        enemy->facing = ENEMY_FACING_RIGHT;
-        next_x = static_cast<uint8_t>(enemy->x + 2);
-        collision = check_horizontal_enemy_map_collision(next_x, enemy->y);
+        enemies.facing[i] = ENEMY_FACING_RIGHT;
+        next_x = static_cast<uint8_t>(enemies.x[i] + 2);
+        collision = check_horizontal_enemy_map_collision(next_x, enemies.y[i]);
         if (collision) {
-            enemy->x_vel = -1;
+            enemies.x_vel[i] = -1;
         } else {
-            enemy->x = static_cast<uint8_t>(enemy->x + 1);
-            camera_rel_x = static_cast<int16_t>(enemy->x) - static_cast<int16_t>(g_camera_x);
+            enemies.x[i] = static_cast<uint8_t>(enemies.x[i] + 1);
+            camera_rel_x = static_cast<int16_t>(enemies.x[i]) - static_cast<int16_t>(g_camera_x);
             if (camera_rel_x >= PLAYFIELD_WIDTH - 2) {
-                enemy->x_vel = -1;  // Hit right edge
+                enemies.x_vel[i] = -1;  // Hit right edge
             }
         }
     } else {
         // Moving left
-        enemy->facing = ENEMY_FACING_LEFT;
-        if (enemy->x == 0) {
-            enemy->x_vel = 1;
+        enemies.facing[i] = ENEMY_FACING_LEFT;
+        if (enemies.x[i] == 0) {
+            enemies.x_vel[i] = 1;
         } else {
-            next_x = static_cast<uint8_t>(enemy->x - 1);
-            collision = check_horizontal_enemy_map_collision(next_x, enemy->y);
+            next_x = static_cast<uint8_t>(enemies.x[i] - 1);
+            collision = check_horizontal_enemy_map_collision(next_x, enemies.y[i]);
             if (collision) {
-                enemy->x_vel = 1;
+                enemies.x_vel[i] = 1;
             } else {
-                enemy->x = next_x;
-                camera_rel_x = static_cast<int16_t>(enemy->x) - static_cast<int16_t>(g_camera_x);
+                enemies.x[i] = next_x;
+                camera_rel_x = static_cast<int16_t>(enemies.x[i]) - static_cast<int16_t>(g_camera_x);
                 if (camera_rel_x <= 0) {
-                    enemy->x_vel = 1;  // Hit left edge
+                    enemies.x_vel[i] = 1;  // Hit left edge
                 }
             }
         }
@@ -1289,46 +1598,46 @@ void ActorSystem::enemy_behavior_shy(enemy_t* enemy) {
     // Vertical movement depends on whether Comic is facing this enemy
     if (comic_facing_enemy) {
         // Comic is facing this enemy - always move up (flee upward unconditionally)
-        enemy->y_vel = -1;
+        enemies.y_vel[i] = -1;
     } else {
         // Comic is facing away - move toward Comic's y (approach)
-        if (enemy->y < g_comic_y) {
-            enemy->y_vel = 1;  // Move down
-        } else if (enemy->y > g_comic_y) {
-            enemy->y_vel = -1;  // Move up
+        if (enemies.y[i] < g_comic_y) {
+            enemies.y_vel[i] = 1;  // Move down
+        } else if (enemies.y[i] > g_comic_y) {
+            enemies.y_vel[i] = -1;  // Move up
         } else {
-            enemy->y_vel = 0;  // Aligned
+            enemies.y_vel[i] = 0;  // Aligned
         }
     }
 
     // Apply vertical movement
-    if (enemy->y_vel > 0) {
+    if (enemies.y_vel[i] > 0) {
         // Moving down
-        next_y = static_cast<uint8_t>(enemy->y + 2);
-        collision = check_vertical_enemy_map_collision(enemy->x, next_y);
+        next_y = static_cast<uint8_t>(enemies.y[i] + 2);
+        collision = check_vertical_enemy_map_collision(enemies.x[i], next_y);
         if (collision) {
-            enemy->y_vel = -1;  // Bounce up
+            enemies.y_vel[i] = -1;  // Bounce up
         } else {
-            enemy->y = static_cast<uint8_t>(enemy->y + 1);
-            if (enemy->y >= PLAYFIELD_HEIGHT - 2) {
-                enemy->y_vel = -1;
+            enemies.y[i] = static_cast<uint8_t>(enemies.y[i] + 1);
+            if (enemies.y[i] >= PLAYFIELD_HEIGHT - 2) {
+                enemies.y_vel[i] = -1;
             }
         }
-    } else if (enemy->y_vel < 0) {
+    } else if (enemies.y_vel[i] < 0) {
         // Moving up
-        if (enemy->y == 0) {
-            enemy->y_vel = 1;  // Bounce down from top
+        if (enemies.y[i] == 0) {
+            enemies.y_vel[i] = 1;  // Bounce down from top
         } else {
-            next_y = static_cast<uint8_t>(enemy->y - 1);
-            collision = check_vertical_enemy_map_collision(enemy->x, next_y);
+            next_y = static_cast<uint8_t>(enemies.y[i] - 1);
+            collision = check_vertical_enemy_map_collision(enemies.x[i], next_y);
             if (collision) {
                 // Hit a solid tile above - bounce back down
-                enemy->y_vel = 1;
+                enemies.y_vel[i] = 1;
             } else {
-                enemy->y = next_y;
+                enemies.y[i] = next_y;
                 // Hit the top of the playfield after moving - bounce back down
-                if (enemy->y == 0) {
-                    enemy->y_vel = 1;
+                if (enemies.y[i] == 0) {
+                    enemies.y_vel[i] = 1;
                 }
             }
         }
@@ -1361,12 +1670,11 @@ bool ActorSystem::load_fireball_sprites(GraphicsSystem* graphics_system) {
 
     bool ok = true;
     for (uint8_t i = 0; i < FIREBALL_NUM_FRAMES; i++) {
-        std::string dir = std::to_string(i);
-        if (!graphics_system->load_sprite("fireball", dir)) {
+        const char dir[2] = {static_cast<char>('0' + i), '\0'};
+        fireball_sprite[i] = graphics_system->load_sprite_id("fireball", dir);
+        if (fireball_sprite[i] == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load fireball sprite frame " << static_cast<int>(i) << std::endl;
             ok = false;
-        } else {
-            fireball_sprite[i] = graphics_system->get_sprite("fireball", dir);
         }
     }
     return ok;
@@ -1410,8 +1718,8 @@ void ActorSystem::try_to_fire() {
  *   - Apply corkscrew Y oscillation when comic_has_corkscrew is set
  *   - Advance animation frame
  *
- * Collision loop (all MAX_NUM_FIREBALLS slots):
- *   - For each active fireball × each SPAWNED enemy:
+ * Collision loop (all fireball slots):
+ *   - For each active fireball × each SPAWNED enemy in nearby grid cells:
  *     - Vertical overlap: 0 ≤ (fb.y − enemy.y) ≤ 1
  *     - Horizontal overlap: |fb.x − enemy.x| ≤ 1
  *     - Hit: enemy → ENEMY_STATE_WHITE_SPARK, fireball → FIREBALL_DEAD
@@ -1461,7 +1769,8 @@ void ActorSystem::handle_fireballs() {
         }
     }
 
-    // --- Collision pass (checks all MAX_NUM_FIREBALLS slots vs all enemies) ---
+    // --- Collision pass (checks all fireball slots vs the enemies near each) ---
+    build_enemy_grid();
     for (int i = 0; i < static_cast<int>(fireballs.size()); i++) {
         fireball_t& fb = fireballs[i];
 
@@ -1469,33 +1778,54 @@ void ActorSystem::handle_fireballs() {
             continue;
         }
 
-        for (int j = 0; j < MAX_NUM_ENEMIES; j++) {
-            enemy_t& enemy = enemies[j];
-
-            if (enemy.state != ENEMY_STATE_SPAWNED) {
-                continue;
+        // The tests below wrap around in 8 bits, so the enemies that can be
+        // hit sit at x = fb.x-1..fb.x+1 and y = fb.y-1..fb.y, modulo 256
+        int cells[6];
+        int num_cells = 0;
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 0; dy++) {
+                const int cell = ActorGrid::cell_of(static_cast<uint8_t>(fb.x + dx),
+                                                    static_cast<uint8_t>(fb.y + dy));
+                if (std::find(cells, cells + num_cells, cell) == cells + num_cells) {
+                    cells[num_cells++] = cell;
+                }
             }
+        }
 
-            // Vertical: 0 ≤ (fb.y − enemy.y) ≤ 1
-            int8_t y_diff = static_cast<int8_t>(static_cast<int>(fb.y) - static_cast<int>(enemy.y));
-            if (y_diff < 0 || y_diff > 1) {
-                continue;
-            }
+        // The lowest slot that overlaps is hit, as when every slot was tried in turn
+        int hit = -1;
+        for (int c = 0; c < num_cells; c++) {
+            for (int j = enemy_grid.first(cells[c]); j >= 0; j = enemy_grid.next(j)) {
+                if (enemies.state[j] != ENEMY_STATE_SPAWNED || (hit >= 0 && j > hit)) {
+                    continue;
+                }
 
-            // Horizontal: |fb.x − enemy.x| ≤ 1
-            int8_t x_diff = static_cast<int8_t>(static_cast<int>(fb.x) - static_cast<int>(enemy.x));
-            if (x_diff < -1 || x_diff > 1) {
-                continue;
-            }
+                // Vertical: 0 ≤ (fb.y − enemy.y) ≤ 1
+                int8_t y_diff = static_cast<int8_t>(static_cast<int>(fb.y) - static_cast<int>(enemies.y[j]));
+                if (y_diff < 0 || y_diff > 1) {
+                    continue;
+                }
 
-            // Collision!
-            enemy.state = ENEMY_STATE_WHITE_SPARK;
-            fb.x = FIREBALL_DEAD;
-            fb.y = FIREBALL_DEAD;
-            award_points(3);  // Award 300 points for killing an enemy with a fireball
-            play_game_sound(GameSound::ENEMY_HIT);
-            break; // Fireball consumed; check next fireball
+                // Horizontal: |fb.x − enemy.x| ≤ 1
+                int8_t x_diff = static_cast<int8_t>(static_cast<int>(fb.x) - static_cast<int>(enemies.x[j]));
+                if (x_diff < -1 || x_diff > 1) {
+                    continue;
+                }
+
+                hit = j;
+            }
         }
+        if (hit < 0) {
+            continue;
+        }
+
+        // Collision!
+        enemies.state[hit] = ENEMY_STATE_WHITE_SPARK;
+        fb.x = FIREBALL_DEAD;
+        fb.y = FIREBALL_DEAD;
+        award_points(*game, 3);  // Award 300 points for killing an enemy with a fireball
+        play_game_sound(GameSound::ENEMY_HIT);
+        // Fireball consumed; check next fireball
     }
 }
 
@@ -1503,7 +1833,8 @@ void ActorSystem::handle_fireballs() {
  * Render all active fireballs.
  * Fireball sprites are 16x8 px originals; rendered at 2× scale → 32x16 screen pixels.
  */
-void ActorSystem::render_fireballs(GraphicsSystem* graphics_system, int camera_x, int render_scale) const {
+void ActorSystem::render_fireballs(GraphicsSystem* graphics_system, int camera_x, int render_scale,
+                                   const ActorRenderOffsets* offsets) const {
     if (!graphics_system || comic_firepower == 0) {
         return;
     }
@@ -1514,7 +1845,9 @@ void ActorSystem::render_fireballs(GraphicsSystem* graphics_system, int camera_x
     const int sprite_w = 16 * scale;
     const int sprite_h = 8 * scale;
 
-    for (const auto& fb : fireballs) {
+    graphics_system->set_render_layer(RenderLayer::FIREBALLS);
+    for (size_t fireball_index = 0; fireball_index < fireballs.size(); ++fireball_index) {
+        const fireball_t& fb = fireballs[fireball_index];
         if (fb.x == FIREBALL_DEAD && fb.y == FIREBALL_DEAD) {
             continue;
         }
@@ -1525,7 +1858,7 @@ void ActorSystem::render_fireballs(GraphicsSystem* graphics_system, int camera_x
         }
 
         uint8_t frame_index = fb.animation % FIREBALL_NUM_FRAMES;
-        const Sprite* sprite = fireball_sprite[frame_index];
+        const Sprite* sprite = graphics_system->get_sprite(fireball_sprite[frame_index]);
         if (!sprite || !sprite->texture.texture) {
             continue;
         }
@@ -1533,6 +1866,10 @@ void ActorSystem::render_fireballs(GraphicsSystem* graphics_system, int camera_x
         // Screen position: same mapping as enemies (game unit × render_scale + render_scale offset)
         int screen_x = rel_x * render_scale + render_scale;
         int screen_y = static_cast<int>(fb.y) * render_scale + render_scale;
+        if (offsets && fireball_index < MAX_NUM_FIREBALLS) {
+            screen_x += offsets->fireball_dx[fireball_index];
+            screen_y += offsets->fireball_dy[fireball_index];
+        }
 
         graphics_system->render_sprite_centered_scaled(screen_x, screen_y, *sprite, sprite_w, sprite_h);
     }
@@ -1561,51 +1898,22 @@ bool ActorSystem::load_item_sprites(GraphicsSystem* graphics_system) {
         return false;
     }
 
-    // Item sprite names mapping (item_type → base filename)
-    const char* item_names[15] = {
-        "corkscrew",    // 0
-        "doorkey",      // 1
-        "boots",        // 2
-        "lantern",      // 3
-        "teleportwand", // 4
-        "gems",         // 5
-        "crown",        // 6
-        "gold",         // 7
-        "cola",         // 8
-        nullptr,         // 9 (unused)
-        nullptr,         // 10 (unused)
-        nullptr,         // 11 (unused)
-        nullptr,         // 12 (unused)
-        nullptr,         // 13 (unused)
-        "shield"        // 14
-    };
-
-    const char* frame_names[2] = {"even", "odd"};
-
     bool all_loaded = true;
 
     for (int item_type = 0; item_type < 15; item_type++) {
-        if (item_names[item_type] == nullptr) {
+        if (ITEM_SPRITE_NAMES[item_type] == nullptr) {
             continue; // Skip unused slots
         }
 
         for (int frame = 0; frame < 2; frame++) {
-            std::string sprite_name = item_names[item_type];
-            std::string frame_name = frame_names[frame];
+            std::string sprite_name = ITEM_SPRITE_NAMES[item_type];
+            std::string frame_name = ITEM_FRAME_NAMES[frame];
 
-            if (!graphics_system->load_sprite(sprite_name, frame_name)) {
+            item_sprites[item_type][frame] = graphics_system->load_sprite_id(sprite_name, frame_name);
+            if (item_sprites[item_type][frame] == INVALID_SPRITE_ID) {
                 std::cerr << "Warning: Failed to load item sprite: "
                           << sprite_name << "_" << frame_name << std::endl;
                 all_loaded = false;
-                continue;
-            }
-
-            // Get loaded sprite
-            item_sprites[item_type][frame] = graphics_system->get_sprite(sprite_name, frame_name);
-            if (!item_sprites[item_type][frame]) {
-                std::cerr << "Warning: Failed to retrieve item sprite: "
-                          << sprite_name << "_" << frame_name << std::endl;
-                all_loaded = false;
             }
         }
     }
@@ -1632,14 +1940,14 @@ void ActorSystem::handle_item() {
     }
 
     // Check if item is visible in playfield (camera bounds check)
-    int rel_x = static_cast<int>(current_item_x) - g_camera_x;
+    int rel_x = item_window_x() - g_camera_x;
     if (rel_x < 0 || rel_x > PLAYFIELD_WIDTH) {
         return; // Off-screen, don't check collision (but don't render either)
     }
 
     // Check collision with Comic
     // Horizontal: abs(item.x - comic_x) <= 1
-    int16_t x_diff = static_cast<int16_t>(static_cast<int>(current_item_x) - static_cast<int>(g_comic_x));
+    int16_t x_diff = static_cast<int16_t>(item_window_x() - static_cast<int>(g_comic_x));
     if (x_diff >= -1 && x_diff <= 1) {
         // Vertical: 0 <= (item.y - comic_y) < 4
         int16_t y_diff = static_cast<int16_t>(static_cast<int>(current_item_y) - static_cast<int>(g_comic_y));
@@ -1658,17 +1966,18 @@ void ActorSystem::collect_item() {
     items_collected[current_level_index][current_stage_index] = 1;
 
     // Items award 2000 points.
-    award_points(20);
+    award_points(*game, 20);
     play_game_sound(GameSound::ITEM_COLLECT);
 
     // Apply item effect
-    apply_item_effect(current_item_type);
+    apply_item_effect(*game, current_item_type);
 }
 
 /**
  * Apply the effect of collecting a specific item type.
  */
-void ActorSystem::apply_item_effect(uint8_t item_type) {
+void ActorSystem::apply_item_effect(GameContext& game_context, uint8_t item_type) {
+    game = &game_context;
     switch (item_type) {
         case ITEM_BLASTOLA_COLA:
             if (comic_firepower < MAX_NUM_FIREBALLS) {
@@ -1690,10 +1999,8 @@ void ActorSystem::apply_item_effect(uint8_t item_type) {
 
         case ITEM_DOOR_KEY:
             comic_has_door_key = 1;
-            // keep global state in sync so door system (which still reads the
-            // global variable) sees the change. some code paths reference the
-            // global directly rather than querying the ActorSystem.
-            ::comic_has_door_key = 1;
+            // The door system reads the key from the game context
+            game->comic_has_door_key = 1;
             break;
 
         case ITEM_TELEPORT_WAND:
@@ -1702,16 +2009,16 @@ void ActorSystem::apply_item_effect(uint8_t item_type) {
 
         case ITEM_SHIELD:
             // Match original behavior: full HP grants a life; otherwise refill HP.
-            if (comic_hp >= MAX_HP) {
-                award_extra_life();
+            if (game->comic_hp >= MAX_HP) {
+                award_extra_life(*game);
             } else {
-                comic_hp_pending_increase = static_cast<uint8_t>(MAX_HP - comic_hp);
+                game->comic_hp_pending_increase = static_cast<uint8_t>(MAX_HP - game->comic_hp);
             }
             break;
 
         case ITEM_GEMS:
             if (!comic_has_gems) {
-                award_extra_life();
+                award_extra_life(*game);
                 comic_has_gems = 1;
                 comic_num_treasures++;
             }
@@ -1719,7 +2026,7 @@ void ActorSystem::apply_item_effect(uint8_t item_type) {
 
         case ITEM_CROWN:
             if (!comic_has_crown) {
-                award_extra_life();
+                award_extra_life(*game);
                 comic_has_crown = 1;
                 comic_num_treasures++;
             }
@@ -1727,7 +2034,7 @@ void ActorSystem::apply_item_effect(uint8_t item_type) {
 
         case ITEM_GOLD:
             if (!comic_has_gold) {
-                award_extra_life();
+                award_extra_life(*game);
                 comic_has_gold = 1;
                 comic_num_treasures++;
             }
@@ -1739,6 +2046,38 @@ void ActorSystem::apply_item_effect(uint8_t item_type) {
     }
 }
 
+uint64_t ActorSystem::get_render_signature(int camera_x) const {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 0x100000001b3ull;
+        }
+    };
+    // Only what is on screen, culled as the render functions cull
+    for (int i = 0; i < enemies.size(); ++i) {
+        if (enemies.state[i] == ENEMY_STATE_DESPAWNED || static_cast<int>(enemies.x[i]) < camera_x - 2 ||
+            static_cast<int>(enemies.x[i]) >= camera_x + PLAYFIELD_WIDTH + 2) {
+            mix(ENEMY_STATE_DESPAWNED);
+            continue;
+        }
+        mix(enemies.x[i] | (enemies.y[i] << 8) | (enemies.state[i] << 16) | (enemies.facing[i] << 24));
+        mix(enemies.spawn_timer_and_animation[i]);
+        mix(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(enemies.animation_data[i])));
+    }
+    for (const fireball_t& fireball : fireballs) {
+        mix(fireball.x | (fireball.y << 8) | (fireball.animation << 16));
+    }
+    const int item_rel_x = item_window_x() - camera_x;
+    const bool item_shown = current_item_type != ITEM_UNUSED && current_level_index < 8 &&
+                            current_stage_index < 3 && items_collected[current_level_index][current_stage_index] == 0 &&
+                            item_rel_x >= 0 && item_rel_x <= PLAYFIELD_WIDTH;
+    mix(item_shown ? current_item_type | (current_item_x << 8) | (current_item_y << 16) |
+                         (item_animation_counter << 24)
+                   : ITEM_UNUSED);
+    return hash;
+}
+
 /**
  * Render the current stage's item if not yet collected.
  * Item sprites are 16×16 pixels (2 game units × 2 game units).
@@ -1762,7 +2101,7 @@ void ActorSystem::render_item(GraphicsSystem* graphics_system, int camera_x, int
     }
 
     // Check if item is visible in playfield
-    int rel_x = static_cast<int>(current_item_x) - camera_x;
+    int rel_x = item_window_x() - camera_x;
     if (rel_x < 0 || rel_x > PLAYFIELD_WIDTH) {
         return; // Off-screen
     }
@@ -1772,7 +2111,7 @@ void ActorSystem::render_item(GraphicsSystem* graphics_system, int camera_x, int
         return; // Invalid item type
     }
 
-    const Sprite* sprite = item_sprites[current_item_type][item_animation_counter];
+    const Sprite* sprite = graphics_system->get_sprite(item_sprites[current_item_type][item_animation_counter]);
     if (!sprite || !sprite->texture.texture) {
         return; // Sprite not loaded
     }
@@ -1787,5 +2126,6 @@ void ActorSystem::render_item(GraphicsSystem* graphics_system, int camera_x, int
     int screen_x = rel_x * render_scale + render_scale;
     int screen_y = static_cast<int>(current_item_y) * render_scale + render_scale;
 
+    graphics_system->set_render_layer(RenderLayer::ITEMS);
     graphics_system->render_sprite_centered_scaled(screen_x, screen_y, *sprite, sprite_w, sprite_h);
 }
\ No newline at end of file
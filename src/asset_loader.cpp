@@ -0,0 +1,147 @@
+#include "../include/asset_loader.h"
+#include <algorithm>
+
+DecodeJob::~DecodeJob() {
+    if (surface) {
+        SDL_FreeSurface(surface);
+        surface = nullptr;
+    }
+}
+
+SDL_Surface* DecodeJob::take_surface() {
+    SDL_Surface* result = surface;
+    surface = nullptr;
+    return result;
+}
+
+AssetDecodePool::AssetDecodePool(unsigned worker_count)
+    : stopping(false)
+{
+    workers.reserve(worker_count);
+    for (unsigned i = 0; i < worker_count; ++i) {
+        workers.emplace_back(&AssetDecodePool::worker_main, this);
+    }
+}
+
+AssetDecodePool::~AssetDecodePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // Unstarted jobs are dropped; their tickets report done with no surface.
+        for (const DecodeTicket& ticket : queue) {
+            ticket->done = true;
+        }
+        queue.clear();
+    }
+    work_available.notify_all();
+    job_finished.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned AssetDecodePool::default_worker_count() {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    if (hardware <= 1) {
+        return 1;
+    }
+    return std::min(4u, hardware - 1);
+}
+
+void AssetDecodePool::run_job(DecodeJob& job) {
+    if (job.decode) {
+        job.surface = job.decode();
+    }
+}
+
+DecodeTicket AssetDecodePool::enqueue(std::function<SDL_Surface*()> decode, bool urgent) {
+    DecodeTicket ticket = std::make_shared<DecodeJob>();
+    ticket->decode = std::move(decode);
+
+    if (workers.empty()) {
+        run_job(*ticket);
+        ticket->done = true;
+        return ticket;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (urgent) {
+            queue.push_front(ticket);
+        } else {
+            queue.push_back(ticket);
+        }
+    }
+    work_available.notify_one();
+    return ticket;
+}
+
+bool AssetDecodePool::is_done(const DecodeTicket& ticket) const {
+    if (!ticket) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    return ticket->done;
+}
+
+void AssetDecodePool::promote(const DecodeTicket& ticket) {
+    if (!ticket) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto queued = std::find(queue.begin(), queue.end(), ticket);
+    if (queued != queue.end() && queued != queue.begin()) {
+        queue.erase(queued);
+        queue.push_front(ticket);
+    }
+}
+
+void AssetDecodePool::wait(const DecodeTicket& ticket) {
+    if (!ticket) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (ticket->done) {
+        return;
+    }
+
+    auto queued = std::find(queue.begin(), queue.end(), ticket);
+    if (queued != queue.end()) {
+        queue.erase(queued);
+        lock.unlock();
+        run_job(*ticket);
+        lock.lock();
+        ticket->done = true;
+        return;
+    }
+
+    // Already running on a worker
+    job_finished.wait(lock, [&ticket]() { return ticket->done; });
+}
+
+void AssetDecodePool::worker_main() {
+    while (true) {
+        DecodeTicket ticket;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_available.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            ticket = queue.front();
+            queue.pop_front();
+        }
+
+        run_job(*ticket);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ticket->done = true;
+        }
+        job_finished.notify_all();
+    }
+}
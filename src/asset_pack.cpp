@@ -0,0 +1,228 @@
+#include "../include/asset_pack.h"
+#include "../include/counters.h"
+#include <SDL2/SDL_image.h>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char ASSET_PACK_MAGIC[4] = {'C', 'C', 'P', 'K'};
+
+static uint16_t read_u16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint64_t read_u64(const uint8_t* p) {
+    return static_cast<uint64_t>(read_u32(p)) |
+           (static_cast<uint64_t>(read_u32(p + 4)) << 32);
+}
+
+uint64_t asset_pack_hash(const char* name, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+AssetPack::AssetPack()
+    : base(nullptr),
+      size(0),
+      entry_count(0)
+#ifdef _WIN32
+      , file_handle(nullptr),
+      mapping_handle(nullptr)
+#endif
+{
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    mapping_handle = mapping;
+    base = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<const uint8_t*>(mapping);
+    size = static_cast<size_t>(st.st_size);
+#endif
+
+    if (size < ASSET_PACK_HEADER_SIZE ||
+        std::memcmp(base, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0) {
+        std::cerr << "Warning: Not an asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    const uint32_t version = read_u32(base + 4);
+    if (version != ASSET_PACK_VERSION) {
+        std::cerr << "Warning: Asset pack " << path << " has version " << version
+                  << ", expected " << ASSET_PACK_VERSION << std::endl;
+        close();
+        return false;
+    }
+    const uint32_t count = read_u32(base + 8);
+    if (count > (size - ASSET_PACK_HEADER_SIZE) / ASSET_PACK_ENTRY_SIZE) {
+        std::cerr << "Warning: Truncated asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    entry_count = count;
+    return true;
+}
+
+void AssetPack::close() {
+    if (base == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(mapping_handle));
+    CloseHandle(static_cast<HANDLE>(file_handle));
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(base), size);
+#endif
+    base = nullptr;
+    size = 0;
+    entry_count = 0;
+}
+
+bool AssetPack::find(const std::string& name, AssetPackBlob& blob) const {
+    if (base == nullptr) {
+        return false;
+    }
+
+    const uint64_t hash = asset_pack_hash(name.data(), name.size());
+    const uint8_t* entries = base + ASSET_PACK_HEADER_SIZE;
+
+    // Lower bound on the hash, then walk the (rare) run of equal hashes
+    uint32_t lo = 0;
+    uint32_t hi = entry_count;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (read_u64(entries + static_cast<size_t>(mid) * ASSET_PACK_ENTRY_SIZE) < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (uint32_t i = lo; i < entry_count; ++i) {
+        const uint8_t* entry = entries + static_cast<size_t>(i) * ASSET_PACK_ENTRY_SIZE;
+        if (read_u64(entry) != hash) {
+            break;
+        }
+        const uint64_t data_offset = read_u64(entry + 8);
+        const uint32_t data_size = read_u32(entry + 16);
+        const uint32_t name_offset = read_u32(entry + 20);
+        const uint16_t name_length = read_u16(entry + 24);
+        if (name_offset > size || name_length > size - name_offset ||
+            data_offset > size || data_size > size - data_offset) {
+            continue;  // Corrupt entry
+        }
+        if (name_length != name.size() ||
+            std::memcmp(base + name_offset, name.data(), name_length) != 0) {
+            continue;
+        }
+
+        blob.data = base + data_offset;
+        blob.size = data_size;
+        blob.format = static_cast<AssetPackFormat>(read_u16(entry + 26));
+        blob.width = read_u16(entry + 28);
+        blob.height = read_u16(entry + 30);
+        return true;
+    }
+    return false;
+}
+
+SDL_Surface* AssetPack::load_surface(const std::string& name) const {
+    AssetPackBlob blob;
+    if (!find(name, blob)) {
+        return nullptr;
+    }
+
+    if (blob.format == AssetPackFormat::RGBA32) {
+        const size_t pitch = static_cast<size_t>(blob.width) * 4;
+        if (blob.width == 0 || blob.height == 0 || blob.size < pitch * blob.height) {
+            std::cerr << "Warning: Bad RGBA entry in asset pack: " << name << std::endl;
+            return nullptr;
+        }
+        // SDL only reads through this pointer for surfaces it does not own.
+        return SDL_CreateRGBSurfaceWithFormatFrom(
+            const_cast<uint8_t*>(blob.data), blob.width, blob.height, 32,
+            static_cast<int>(pitch), SDL_PIXELFORMAT_RGBA32);
+    }
+
+    SDL_RWops* rw = SDL_RWFromConstMem(blob.data, static_cast<int>(blob.size));
+    if (rw == nullptr) {
+        return nullptr;
+    }
+    SDL_Surface* surface = IMG_Load_RW(rw, 1);
+    if (surface == nullptr) {
+        std::cerr << "Warning: Failed to decode " << name << " from asset pack ("
+                  << IMG_GetError() << ")" << std::endl;
+        return nullptr;
+    }
+    count_decoded_image(surface->pitch, surface->h);
+    return surface;
+}
@@ -2,11 +2,15 @@
 
 #if defined(HAVE_SDL2_MIXER)
 
+#include "counters.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace {
@@ -114,11 +118,6 @@ constexpr int FREQ_MATERIALIZE_900 = 900;
 
 
 // ===== Sound Definition Structure =====
-struct FrequencyNote {
-    int frequency_hz;
-    uint16_t duration_ticks;  // Duration in ticks (at ~18.2 Hz = ~55ms per tick)
-};
-
 // ===== Sound Sequences (matching original PC speaker sounds) =====
 // Each sound is a sequence of frequencies played in order
 
@@ -253,73 +252,117 @@ static uint16_t ticks_to_ms(uint16_t ticks) {
     return static_cast<uint16_t>((static_cast<uint64_t>(ticks) * 55) / 1);
 }
 
+constexpr int16_t SQUARE_WAVE_AMPLITUDE = 9000;
+
 /**
- * Synthesize a complete sound from a frequency sequence
+ * Fill frames of a square wave whose phase continues from first_frame
  * 
- * Concatenates synthesized square waves for each frequency/duration pair
- * into a single SDL_Chunk.
+ * Writes whole half-period runs with std::fill_n (which compilers vectorize)
+ * instead of deciding the sign per sample. All channels carry the same value,
+ * so a run of frames is one contiguous run of samples.
  */
-Mix_Chunk* create_sound_sequence_chunk(const std::vector<FrequencyNote>& sequence) {
-    if (sequence.empty()) {
-        return nullptr;
+static void fill_square_wave(int16_t* out, uint32_t first_frame, uint32_t frames,
+                             int period, int half_period, int channels) {
+    uint32_t phase = first_frame % static_cast<uint32_t>(period);
+    uint32_t done = 0;
+    while (done < frames) {
+        const bool high = phase < static_cast<uint32_t>(half_period);
+        uint32_t run = (high ? static_cast<uint32_t>(half_period) : static_cast<uint32_t>(period)) - phase;
+        run = std::min(run, frames - done);
+        std::fill_n(out + static_cast<size_t>(done) * channels, static_cast<size_t>(run) * channels,
+                    high ? SQUARE_WAVE_AMPLITUDE : static_cast<int16_t>(-SQUARE_WAVE_AMPLITUDE));
+        done += run;
+        phase += run;
+        if (phase >= static_cast<uint32_t>(period)) {
+            phase = 0;
+        }
     }
+}
 
-    // Calculate total frame count needed.
-    // A frame is one sample across all output channels.
-    uint32_t total_frames = 0;
+static uint32_t note_frame_count(const FrequencyNote& note, int sample_rate) {
+    uint16_t duration_ms = ticks_to_ms(note.duration_ticks);
+    return static_cast<uint32_t>((static_cast<uint64_t>(sample_rate) * duration_ms) / 1000);
+}
+
+// FNV-1a over the notes, so a cached waveform is never reused for an edited sequence
+static uint64_t hash_sequence(const std::vector<FrequencyNote>& sequence) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 0x100000001b3ull;
+        }
+    };
     for (const auto& note : sequence) {
-        uint16_t duration_ms = ticks_to_ms(note.duration_ticks);
-        uint32_t note_frames = (static_cast<uint64_t>(g_mixer_sample_rate) * duration_ms) / 1000;
-        total_frames += note_frames;
+        mix(static_cast<uint32_t>(note.frequency_hz));
+        mix(note.duration_ticks);
     }
+    return hash;
+}
 
-    if (total_frames == 0) {
-        return nullptr;
+// Synthesized PCM by (sample rate, channels, sequence hash). Kept for the life
+// of the process, so re-initializing audio with the same mixer format (as the
+// tests do, or after a device reset) does not synthesize again.
+std::map<std::tuple<int, int, uint64_t>, std::vector<int16_t>> g_pcm_cache;
+
+static const std::vector<int16_t>& synthesize_sequence(const std::vector<FrequencyNote>& sequence,
+                                                      int sample_rate, int channels) {
+    const auto key = std::make_tuple(sample_rate, channels, hash_sequence(sequence));
+    auto cached = g_pcm_cache.find(key);
+    if (cached != g_pcm_cache.end()) {
+        return cached->second;
     }
+    count_event(Counter::WAVEFORMS_SYNTHESIZED);
 
-    uint32_t byte_count = total_frames * static_cast<uint32_t>(g_mixer_channels) * sizeof(int16_t);
-    auto* sample_buffer = static_cast<int16_t*>(SDL_malloc(byte_count));
-    if (!sample_buffer) {
-        return nullptr;
+    // A frame is one sample across all output channels.
+    uint32_t total_frames = 0;
+    for (const auto& note : sequence) {
+        total_frames += note_frame_count(note, sample_rate);
     }
 
-    // Generate waveform for each frequency note
-    uint32_t current_frame = 0;
-    constexpr int16_t amplitude = 9000;
+    std::vector<int16_t>& samples = g_pcm_cache[key];
+    samples.assign(static_cast<size_t>(total_frames) * static_cast<size_t>(channels), 0);
 
+    uint32_t current_frame = 0;
     for (const auto& note : sequence) {
-        if (note.frequency_hz <= 0) {
-            continue;
+        const uint32_t note_frames = note_frame_count(note, sample_rate);
+        if (note.frequency_hz > 0) {
+            int period = std::max(1, sample_rate / note.frequency_hz);
+            int half_period = std::max(1, period / 2);
+            fill_square_wave(samples.data() + static_cast<size_t>(current_frame) * channels,
+                             current_frame, note_frames, period, half_period, channels);
         }
+        current_frame += note_frames;  // Non-positive frequencies are rests (left silent)
+    }
+    return samples;
+}
 
-        uint16_t duration_ms = ticks_to_ms(note.duration_ticks);
-        uint32_t note_frames = (static_cast<uint64_t>(g_mixer_sample_rate) * duration_ms) / 1000;
-        int period = std::max(1, g_mixer_sample_rate / note.frequency_hz);
-        int half_period = std::max(1, period / 2);
-
-        for (uint32_t i = 0; i < note_frames; ++i) {
-            if (current_frame < total_frames) {
-                int phase = static_cast<int>(current_frame % static_cast<uint32_t>(period));
-                int16_t value = (phase < half_period) ? amplitude : -amplitude;
-                uint32_t frame_offset = current_frame * static_cast<uint32_t>(g_mixer_channels);
-                for (int channel = 0; channel < g_mixer_channels; ++channel) {
-                    sample_buffer[frame_offset + static_cast<uint32_t>(channel)] = value;
-                }
-                current_frame++;
-            }
-        }
+/**
+ * Synthesize a complete sound from a frequency sequence
+ * 
+ * Concatenates synthesized square waves for each frequency/duration pair
+ * into a single SDL_Chunk. The chunk borrows the cached PCM, so freeing it
+ * leaves the cache intact.
+ */
+Mix_Chunk* create_sound_sequence_chunk(const std::vector<FrequencyNote>& sequence) {
+    if (sequence.empty()) {
+        return nullptr;
+    }
+
+    const std::vector<int16_t>& samples = synthesize_sequence(sequence, g_mixer_sample_rate, g_mixer_channels);
+    if (samples.empty()) {
+        return nullptr;
     }
 
     // Wrap in Mix_Chunk structure
     auto* chunk = static_cast<Mix_Chunk*>(SDL_malloc(sizeof(Mix_Chunk)));
     if (!chunk) {
-        SDL_free(sample_buffer);
         return nullptr;
     }
 
-    chunk->allocated = 1;
-    chunk->abuf = reinterpret_cast<uint8_t*>(sample_buffer);
-    chunk->alen = byte_count;
+    chunk->allocated = 0;  // Mix_FreeChunk must not free the cached samples
+    chunk->abuf = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(samples.data()));
+    chunk->alen = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
     chunk->volume = MIX_MAX_VOLUME;
     return chunk;
 }
@@ -404,6 +447,360 @@ static uint16_t calculate_sequence_duration_ms(const std::vector<FrequencyNote>&
     return total_ms;
 }
 
+/**
+ * Synthesize a sound or music chunk on first use
+ */
+static Mix_Chunk* get_sound_chunk(GameSound sound) {
+    LoadedSound& loaded_sound = g_sounds[static_cast<size_t>(sound)];
+    if (!loaded_sound.chunk) {
+        const std::vector<FrequencyNote>* sequence = get_sound_sequence(sound);
+        if (sequence) {
+            loaded_sound.chunk = create_sound_sequence_chunk(*sequence);
+            if (!loaded_sound.chunk) {
+                std::cerr << "Failed to synthesize sound #" << static_cast<int>(sound) << std::endl;
+            }
+        }
+    }
+    return loaded_sound.chunk;
+}
+
+static Mix_Chunk* get_music_chunk(GameMusic music) {
+    LoadedMusic& loaded_music = g_music[static_cast<size_t>(music)];
+    if (!loaded_music.chunk) {
+        const std::vector<FrequencyNote>* sequence = get_music_sequence(music);
+        if (sequence) {
+            loaded_music.chunk = create_sound_sequence_chunk(*sequence);
+            if (!loaded_music.chunk) {
+                std::cerr << "Failed to synthesize music #" << static_cast<int>(music) << std::endl;
+            }
+        }
+    }
+    return loaded_music.chunk;
+}
+
+// ===== Low-Latency Voice Mixer =====
+// Opt-in path (set_audio_buffer_frames): SDL_mixer only owns the device, and
+// mix_voices() renders a fixed pool of voices into a small buffer through the
+// music hook. The game thread decides which voice plays what and when, and
+// hands the decision over a single-producer / single-consumer command ring,
+// so the audio callback never takes a lock.
+constexpr int LOW_LATENCY_MIN_FRAMES = 256;
+constexpr int LOW_LATENCY_MAX_FRAMES = 512;
+constexpr int SFX_VOICE_COUNT = 4;
+constexpr int MUSIC_VOICE = SFX_VOICE_COUNT;  // Last voice loops the music track
+constexpr int VOICE_COUNT = SFX_VOICE_COUNT + 1;
+constexpr size_t VOICE_COMMAND_CAPACITY = 64;
+constexpr int MIX_BLOCK_SAMPLES = 1024;
+// A tick timestamp older than this is stale (e.g. sounds played from a menu
+// or cutscene loop that does not run game ticks); schedule against now instead.
+constexpr uint32_t MAX_TICK_LAG_MS = 250;
+
+int g_requested_buffer_frames = 0;  // 0 = SDL_mixer channels
+bool g_low_latency = false;
+
+struct VoiceCommand {
+    int voice;
+    const int16_t* samples;   // nullptr stops the voice
+    uint32_t frames;
+    uint64_t start_frame;     // Output frame the first sample lands on
+    uint64_t tick_frame;      // Output frame of the game tick that triggered it
+    bool loop;
+};
+
+// Audio-thread state of one voice
+struct Voice {
+    const int16_t* samples = nullptr;
+    uint32_t frames = 0;
+    uint32_t position = 0;
+    uint64_t start_frame = 0;
+    uint64_t tick_frame = 0;
+    bool loop = false;
+    bool started = false;
+};
+
+// Game-thread view of one effect voice, used for priority and stealing
+struct VoiceSlot {
+    uint8_t priority = 0;
+    uint64_t start_frame = 0;
+    uint64_t end_frame = 0;
+};
+
+std::array<VoiceCommand, VOICE_COMMAND_CAPACITY> g_voice_commands{};
+std::atomic<size_t> g_voice_command_head{0};  // Written by the game thread
+std::atomic<size_t> g_voice_command_tail{0};  // Written by the audio callback
+std::array<Voice, VOICE_COUNT> g_voices{};
+std::array<VoiceSlot, SFX_VOICE_COUNT> g_voice_slots{};
+
+// Output clock: frames rendered so far, and the SDL_GetTicks() time of the
+// callback that rendered them. Published under a sequence counter so the game
+// thread reads a consistent pair.
+std::atomic<uint64_t> g_frames_rendered{0};
+std::atomic<uint32_t> g_clock_sequence{0};
+std::atomic<uint64_t> g_clock_frame{0};
+std::atomic<uint32_t> g_clock_ms{0};
+uint32_t g_last_callback_ms = 0;  // Audio thread only
+
+uint32_t g_tick_ms = 0;
+bool g_tick_ms_valid = false;
+
+std::atomic<uint32_t> g_callback_frames{0};
+std::atomic<uint32_t> g_underruns{0};
+std::atomic<uint32_t> g_late_starts{0};
+std::atomic<uint32_t> g_latency_count{0};
+std::atomic<uint64_t> g_latency_sum_frames{0};
+std::atomic<uint64_t> g_latency_max_frames{0};
+uint32_t g_voices_started = 0;
+uint32_t g_voices_stolen = 0;
+uint32_t g_sounds_rejected = 0;
+
+static void reset_voice_mixer() {
+    g_voice_command_head.store(0, std::memory_order_relaxed);
+    g_voice_command_tail.store(0, std::memory_order_relaxed);
+    g_voices.fill(Voice());
+    g_voice_slots.fill(VoiceSlot());
+    g_frames_rendered.store(0, std::memory_order_relaxed);
+    g_clock_sequence.store(0, std::memory_order_relaxed);
+    g_clock_frame.store(0, std::memory_order_relaxed);
+    g_clock_ms.store(SDL_GetTicks(), std::memory_order_relaxed);
+    g_last_callback_ms = 0;
+    g_tick_ms_valid = false;
+    g_callback_frames.store(0, std::memory_order_relaxed);
+    g_underruns.store(0, std::memory_order_relaxed);
+    g_late_starts.store(0, std::memory_order_relaxed);
+    g_latency_count.store(0, std::memory_order_relaxed);
+    g_latency_sum_frames.store(0, std::memory_order_relaxed);
+    g_latency_max_frames.store(0, std::memory_order_relaxed);
+    g_voices_started = 0;
+    g_voices_stolen = 0;
+    g_sounds_rejected = 0;
+}
+
+static bool push_voice_command(const VoiceCommand& command) {
+    const size_t head = g_voice_command_head.load(std::memory_order_relaxed);
+    if (head - g_voice_command_tail.load(std::memory_order_acquire) >= VOICE_COMMAND_CAPACITY) {
+        return false;  // Callback has stalled; drop rather than block
+    }
+    g_voice_commands[head % VOICE_COMMAND_CAPACITY] = command;
+    g_voice_command_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+static void apply_voice_commands() {
+    size_t tail = g_voice_command_tail.load(std::memory_order_relaxed);
+    const size_t head = g_voice_command_head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+        const VoiceCommand& command = g_voice_commands[tail % VOICE_COMMAND_CAPACITY];
+        Voice& voice = g_voices[command.voice];
+        voice.samples = command.samples;
+        voice.frames = command.frames;
+        voice.position = 0;
+        voice.start_frame = command.start_frame;
+        voice.tick_frame = command.tick_frame;
+        voice.loop = command.loop;
+        voice.started = false;
+    }
+    g_voice_command_tail.store(tail, std::memory_order_release);
+}
+
+static void record_voice_start(const Voice& voice, uint64_t first_frame, uint32_t callback_frames) {
+    if (first_frame > voice.start_frame) {
+        g_late_starts.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Tick to first sample, plus the device buffer the sample still has to drain through
+    const uint64_t latency = first_frame - std::min(first_frame, voice.tick_frame) + callback_frames;
+    g_latency_sum_frames.fetch_add(latency, std::memory_order_relaxed);
+    g_latency_count.fetch_add(1, std::memory_order_relaxed);
+    if (latency > g_latency_max_frames.load(std::memory_order_relaxed)) {
+        g_latency_max_frames.store(latency, std::memory_order_relaxed);
+    }
+}
+
+// Add the voice's samples for output frames [block_first, block_first + block_frames)
+static void mix_voice_block(Voice& voice, int32_t* accum, uint64_t block_first,
+                            uint32_t block_frames, int channels, uint32_t callback_frames) {
+    if (voice.frames == 0) {
+        voice.samples = nullptr;
+        return;
+    }
+    const uint64_t block_end = block_first + block_frames;
+    uint64_t frame = std::max(block_first, voice.start_frame);
+    if (frame >= block_end) {
+        return;
+    }
+    if (!voice.started) {
+        voice.started = true;
+        record_voice_start(voice, frame, callback_frames);
+    }
+
+    while (frame < block_end && voice.samples != nullptr) {
+        const uint32_t run = static_cast<uint32_t>(
+            std::min<uint64_t>(block_end - frame, voice.frames - voice.position));
+        const int16_t* in = voice.samples + static_cast<size_t>(voice.position) * channels;
+        int32_t* out = accum + static_cast<size_t>(frame - block_first) * channels;
+        for (size_t i = 0; i < static_cast<size_t>(run) * channels; ++i) {
+            out[i] += in[i];
+        }
+        frame += run;
+        voice.position += run;
+        if (voice.position >= voice.frames) {
+            if (voice.loop) {
+                voice.position = 0;
+            } else {
+                voice.samples = nullptr;
+            }
+        }
+    }
+}
+
+static void mix_voices(void* /*udata*/, Uint8* stream, int len) {
+    const uint32_t now = SDL_GetTicks();
+    const int channels = g_mixer_channels;
+    const uint32_t frames = static_cast<uint32_t>(len) / (sizeof(int16_t) * static_cast<uint32_t>(channels));
+    const uint64_t first_frame = g_frames_rendered.load(std::memory_order_relaxed);
+
+    // The device drained a whole buffer while we were not called: it ran dry.
+    if (g_last_callback_ms != 0 && frames > 0) {
+        const uint32_t buffer_ms = static_cast<uint32_t>(
+            (static_cast<uint64_t>(frames) * 1000) / static_cast<uint32_t>(g_mixer_sample_rate));
+        if (now - g_last_callback_ms > 2 * buffer_ms + 1) {
+            g_underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    g_last_callback_ms = now;
+    g_callback_frames.store(frames, std::memory_order_relaxed);
+
+    const uint32_t sequence = g_clock_sequence.load(std::memory_order_relaxed);
+    g_clock_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    g_clock_frame.store(first_frame, std::memory_order_relaxed);
+    g_clock_ms.store(now, std::memory_order_relaxed);
+    g_clock_sequence.store(sequence + 2, std::memory_order_release);
+
+    apply_voice_commands();
+
+    int16_t* out = reinterpret_cast<int16_t*>(stream);
+    const uint32_t block_limit = static_cast<uint32_t>(MIX_BLOCK_SAMPLES / channels);
+    int32_t accum[MIX_BLOCK_SAMPLES];
+    for (uint32_t done = 0; done < frames;) {
+        const uint32_t block_frames = std::min(block_limit, frames - done);
+        const size_t block_samples = static_cast<size_t>(block_frames) * channels;
+        std::fill_n(accum, block_samples, 0);
+        for (Voice& voice : g_voices) {
+            if (voice.samples != nullptr) {
+                mix_voice_block(voice, accum, first_frame + done, block_frames, channels, frames);
+            }
+        }
+        for (size_t i = 0; i < block_samples; ++i) {
+            out[i] = static_cast<int16_t>(std::max(-32768, std::min(32767, accum[i])));
+        }
+        out += block_samples;
+        done += block_frames;
+    }
+
+    g_frames_rendered.store(first_frame + frames, std::memory_order_release);
+}
+
+// Output frame at which the current game tick happened, from the last
+// callback's (frame, time) pair
+static uint64_t current_tick_frame() {
+    uint32_t sequence;
+    uint64_t clock_frame;
+    uint32_t clock_ms;
+    do {
+        sequence = g_clock_sequence.load(std::memory_order_acquire);
+        clock_frame = g_clock_frame.load(std::memory_order_relaxed);
+        clock_ms = g_clock_ms.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 || sequence != g_clock_sequence.load(std::memory_order_relaxed));
+
+    const uint32_t now = SDL_GetTicks();
+    const uint32_t tick_ms = (g_tick_ms_valid && now - g_tick_ms <= MAX_TICK_LAG_MS) ? g_tick_ms : now;
+    const int64_t offset = static_cast<int64_t>(static_cast<int32_t>(tick_ms - clock_ms)) *
+                           g_mixer_sample_rate / 1000;
+    const int64_t frame = static_cast<int64_t>(clock_frame) + offset;
+    return frame > 0 ? static_cast<uint64_t>(frame) : 0;
+}
+
+// Sounds land one device buffer after their tick, so every sound of a tick
+// gets the same delay however late in the frame the game code triggered it.
+static uint64_t scheduled_start_frame(uint64_t tick_frame) {
+    return tick_frame + static_cast<uint64_t>(g_requested_buffer_frames);
+}
+
+static uint32_t chunk_frame_count(const Mix_Chunk* chunk) {
+    return chunk->alen / static_cast<uint32_t>(sizeof(int16_t) * g_mixer_channels);
+}
+
+/**
+ * Start an effect on the voice pool
+ *
+ * The original single-channel rule still decides whether a sound may play:
+ * it is rejected while a higher-priority sound is sounding. An accepted sound
+ * takes a free voice, or steals the lowest-priority (then oldest) voice, so
+ * equal or lower sounds overlap instead of cutting each other off.
+ */
+static bool play_low_latency_sound(const LoadedSound& sound) {
+    const uint64_t position = g_frames_rendered.load(std::memory_order_acquire);
+    int free_voice = -1;
+    int steal_voice = -1;
+    bool any_busy = false;
+    uint8_t highest_priority = 0;
+    for (int i = 0; i < SFX_VOICE_COUNT; ++i) {
+        const VoiceSlot& slot = g_voice_slots[i];
+        if (slot.end_frame <= position) {
+            if (free_voice < 0) {
+                free_voice = i;
+            }
+            continue;
+        }
+        any_busy = true;
+        highest_priority = std::max(highest_priority, slot.priority);
+        if (steal_voice < 0 || slot.priority < g_voice_slots[steal_voice].priority ||
+            (slot.priority == g_voice_slots[steal_voice].priority &&
+             slot.start_frame < g_voice_slots[steal_voice].start_frame)) {
+            steal_voice = i;
+        }
+    }
+    if (any_busy && sound.priority < highest_priority) {
+        ++g_sounds_rejected;
+        count_sound_request(sound.priority, false);
+        return false;
+    }
+
+    const int voice = free_voice >= 0 ? free_voice : steal_voice;
+    const uint64_t tick_frame = current_tick_frame();
+    const uint64_t start_frame = scheduled_start_frame(tick_frame);
+    const uint32_t frames = chunk_frame_count(sound.chunk);
+    const VoiceCommand command = {voice, reinterpret_cast<const int16_t*>(sound.chunk->abuf),
+                                  frames, start_frame, tick_frame, false};
+    if (!push_voice_command(command)) {
+        return false;
+    }
+
+    g_voice_slots[voice].priority = sound.priority;
+    g_voice_slots[voice].start_frame = start_frame;
+    g_voice_slots[voice].end_frame = std::max(start_frame, position) + frames;
+    ++g_voices_started;
+    if (free_voice < 0) {
+        ++g_voices_stolen;
+    }
+    count_sound_request(sound.priority, true);
+    return true;
+}
+
+static bool play_low_latency_music(const Mix_Chunk* chunk) {
+    const uint64_t tick_frame = current_tick_frame();
+    const VoiceCommand command = {MUSIC_VOICE, reinterpret_cast<const int16_t*>(chunk->abuf),
+                                  chunk_frame_count(chunk), scheduled_start_frame(tick_frame),
+                                  tick_frame, true};
+    return push_voice_command(command);
+}
+
+static void stop_low_latency_music() {
+    const VoiceCommand command = {MUSIC_VOICE, nullptr, 0, 0, 0, false};
+    push_voice_command(command);
+}
+
 static void cleanup_audio_init_failure(bool mixer_opened) {
     if (mixer_opened) {
         Mix_CloseAudio();
@@ -431,7 +828,8 @@ bool initialize_audio_system() {
         g_sdl_audio_initialized = true;
     }
 
-    if (Mix_OpenAudio(AUDIO_SAMPLE_RATE, AUDIO_S16SYS, AUDIO_CHANNELS, AUDIO_CHUNK_SIZE) < 0) {
+    const int chunk_size = g_requested_buffer_frames > 0 ? g_requested_buffer_frames : AUDIO_CHUNK_SIZE;
+    if (Mix_OpenAudio(AUDIO_SAMPLE_RATE, AUDIO_S16SYS, AUDIO_CHANNELS, chunk_size) < 0) {
         std::cerr << "Failed to initialize SDL_mixer audio: " << Mix_GetError() << std::endl;
         // if we initialized the subsystem just above, undo it so callers can retry
         cleanup_audio_init_failure(false);
@@ -463,7 +861,8 @@ bool initialize_audio_system() {
 
     Mix_AllocateChannels(8);
 
-    // Load all game sounds (skip UNUSED_0 which has no sequence)
+    // Register all game sounds (skip UNUSED_0 which has no sequence). The
+    // waveforms are synthesized on first play so startup never waits on them.
     for (size_t index = 0; index < SOUND_PRIORITIES.size(); ++index) {
         GameSound sound = static_cast<GameSound>(index);
         const std::vector<FrequencyNote>* sequence = get_sound_sequence(sound);
@@ -480,20 +879,12 @@ bool initialize_audio_system() {
             return false;
         }
 
-        Mix_Chunk* chunk = create_sound_sequence_chunk(*sequence);
-        if (!chunk) {
-            std::cerr << "Failed to synthesize sound #" << index << std::endl;
-            free_loaded_sounds();
-            cleanup_audio_init_failure(true);
-            return false;
-        }
-
-        g_sounds[index].chunk = chunk;
+        g_sounds[index].chunk = nullptr;
         g_sounds[index].total_duration_ms = calculate_sequence_duration_ms(*sequence);
         g_sounds[index].priority = SOUND_PRIORITIES[index];
     }
     
-    // Load all music tracks
+    // Register all music tracks
     for (size_t index = 0; index < static_cast<size_t>(GameMusic::COUNT); ++index) {
         GameMusic music = static_cast<GameMusic>(index);
         const std::vector<FrequencyNote>* sequence = get_music_sequence(music);
@@ -511,16 +902,7 @@ bool initialize_audio_system() {
             return false;
         }
 
-        Mix_Chunk* chunk = create_sound_sequence_chunk(*sequence);
-        if (!chunk) {
-            std::cerr << "Failed to synthesize music #" << index << std::endl;
-            free_loaded_sounds();
-            free_loaded_music();
-            cleanup_audio_init_failure(true);
-            return false;
-        }
-
-        g_music[index].chunk = chunk;
+        g_music[index].chunk = nullptr;
         g_music[index].total_duration_ms = calculate_sequence_duration_ms(*sequence);
     }
 
@@ -528,6 +910,13 @@ bool initialize_audio_system() {
     g_current_sound_end_tick = 0;
     g_current_music = GameMusic::NONE;
     g_music_channel = -1;
+
+    if (g_requested_buffer_frames > 0) {
+        reset_voice_mixer();
+        Mix_HookMusic(mix_voices, nullptr);
+        g_low_latency = true;
+    }
+
     g_audio_initialized = true;
     return true;
 }
@@ -537,6 +926,10 @@ void shutdown_audio_system() {
         return;
     }
 
+    if (g_low_latency) {
+        Mix_HookMusic(nullptr, nullptr);  // Returns once the callback is no longer running
+        g_low_latency = false;
+    }
     Mix_HaltChannel(SFX_CHANNEL);
     if (g_music_channel >= 0) {
         Mix_HaltChannel(g_music_channel);
@@ -572,13 +965,17 @@ bool play_game_sound(GameSound sound) {
     }
 
     const LoadedSound& requested_sound = g_sounds[sound_index];
-    if (!requested_sound.chunk) {
+    if (!get_sound_chunk(sound)) {
         return false;
     }
+    if (g_low_latency) {
+        return play_low_latency_sound(requested_sound);
+    }
 
     uint32_t now = SDL_GetTicks();
     bool channel_is_busy = Mix_Playing(SFX_CHANNEL) != 0 && now < g_current_sound_end_tick;
     if (channel_is_busy && requested_sound.priority < g_current_priority) {
+        count_sound_request(requested_sound.priority, false);
         return false;
     }
 
@@ -592,6 +989,7 @@ bool play_game_sound(GameSound sound) {
 
     g_current_priority = requested_sound.priority;
     g_current_sound_end_tick = now + requested_sound.total_duration_ms;
+    count_sound_request(requested_sound.priority, true);
     return true;
 }
 
@@ -612,9 +1010,16 @@ bool play_game_music(GameMusic music) {
     }
 
     const LoadedMusic& requested_music = g_music[music_index];
-    if (!requested_music.chunk) {
+    if (!get_music_chunk(music)) {
         return false;
     }
+    if (g_low_latency) {
+        if (!play_low_latency_music(requested_music.chunk)) {
+            return false;
+        }
+        g_current_music = music;
+        return true;
+    }
 
     // Stop current music if any
     if (g_music_channel >= 0 && Mix_Playing(g_music_channel)) {
@@ -636,6 +1041,9 @@ bool play_game_music(GameMusic music) {
 }
 
 void stop_game_music() {
+    if (g_low_latency && g_current_music != GameMusic::NONE) {
+        stop_low_latency_music();
+    }
     if (g_music_channel >= 0 && Mix_Playing(g_music_channel)) {
         Mix_HaltChannel(g_music_channel);
     }
@@ -643,6 +1051,9 @@ void stop_game_music() {
 }
 
 bool is_game_music_playing() {
+    if (g_audio_initialized && g_low_latency) {
+        return g_current_music != GameMusic::NONE;  // The music voice loops until stopped
+    }
     if (!g_audio_initialized || g_music_channel < 0) {
         return false;
     }
@@ -653,6 +1064,69 @@ GameMusic get_current_music() {
     return g_current_music;
 }
 
+bool set_audio_buffer_frames(int frames) {
+    if (frames != 0 && (frames < LOW_LATENCY_MIN_FRAMES || frames > LOW_LATENCY_MAX_FRAMES)) {
+        std::cerr << "Audio buffer must be " << LOW_LATENCY_MIN_FRAMES << "-" << LOW_LATENCY_MAX_FRAMES
+                  << " frames (got " << frames << ")" << std::endl;
+        return false;
+    }
+    g_requested_buffer_frames = frames;
+    return true;
+}
+
+void set_audio_tick_time(uint32_t tick_ms) {
+    g_tick_ms = tick_ms;
+    g_tick_ms_valid = true;
+}
+
+AudioLatencyStats get_audio_latency_stats() {
+    AudioLatencyStats stats;
+    if (!g_low_latency) {
+        return stats;
+    }
+    const double ms_per_frame = 1000.0 / g_mixer_sample_rate;
+    const uint32_t latency_count = g_latency_count.load(std::memory_order_relaxed);
+    stats.low_latency = true;
+    stats.sample_rate = g_mixer_sample_rate;
+    stats.buffer_frames = g_requested_buffer_frames;
+    stats.callback_frames = static_cast<int>(g_callback_frames.load(std::memory_order_relaxed));
+    stats.output_latency_ms = stats.callback_frames * ms_per_frame;
+    if (latency_count > 0) {
+        stats.average_trigger_latency_ms =
+            static_cast<double>(g_latency_sum_frames.load(std::memory_order_relaxed)) / latency_count * ms_per_frame;
+        stats.max_trigger_latency_ms =
+            static_cast<double>(g_latency_max_frames.load(std::memory_order_relaxed)) * ms_per_frame;
+    }
+    stats.voices_started = g_voices_started;
+    stats.voices_stolen = g_voices_stolen;
+    stats.sounds_rejected = g_sounds_rejected;
+    stats.late_starts = g_late_starts.load(std::memory_order_relaxed);
+    stats.underruns = g_underruns.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t synthesize_game_sound(GameSound sound, bool drop_cached) {
+    const std::vector<FrequencyNote>* sequence = get_sound_sequence(sound);
+    if (!sequence) {
+        return 0;
+    }
+    // A playing chunk may borrow the cached PCM, so only drop it while no mixer is open
+    if (drop_cached && !g_audio_initialized) {
+        g_pcm_cache.erase(std::make_tuple(g_mixer_sample_rate, g_mixer_channels, hash_sequence(*sequence)));
+    }
+    Mix_Chunk* chunk = create_sound_sequence_chunk(*sequence);
+    if (!chunk) {
+        return 0;
+    }
+    const size_t samples = chunk->alen / sizeof(int16_t);
+    SDL_free(chunk);  // Not Mix_FreeChunk: that needs the mixer open
+    return samples;
+}
+
+const std::vector<int16_t>& synthesize_notes(const std::vector<FrequencyNote>& notes, int sample_rate, int channels) {
+    return synthesize_sequence(notes, sample_rate, channels);
+}
+
 #else
 
 bool initialize_audio_system() {
@@ -686,4 +1160,30 @@ bool is_game_music_playing() {
 GameMusic get_current_music() {
     return GameMusic::NONE;
 }
+
+bool set_audio_buffer_frames(int frames) {
+    return frames == 0;
+}
+
+void set_audio_tick_time(uint32_t tick_ms) {
+    (void)tick_ms;
+}
+
+AudioLatencyStats get_audio_latency_stats() {
+    return AudioLatencyStats();
+}
+
+size_t synthesize_game_sound(GameSound sound, bool drop_cached) {
+    (void)sound;
+    (void)drop_cached;
+    return 0;
+}
+
+const std::vector<int16_t>& synthesize_notes(const std::vector<FrequencyNote>& notes, int sample_rate, int channels) {
+    (void)notes;
+    (void)sample_rate;
+    (void)channels;
+    static const std::vector<int16_t> no_samples;
+    return no_samples;
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "../include/batch_runner.h"
+#include <algorithm>
+
+BatchRunner::BatchRunner(unsigned thread_count)
+    : stopping(false), batch_jobs(nullptr), batch_results(nullptr),
+      batch_generation(0), busy_workers(0), next_job(0)
+{
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(thread_count - 1);
+    for (unsigned i = 1; i < thread_count; ++i) {
+        workers.emplace_back(&BatchRunner::worker_main, this);
+    }
+}
+
+BatchRunner::~BatchRunner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+BatchResult BatchRunner::run_job(const BatchJob& job) {
+    GameContext game;
+    game.actors.initialize();
+    if (job.debug_mode) {
+        game.actors.comic_firepower = 3;
+    }
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
+
+    BatchResult result;
+    while (result.ticks_run < job.tick_count) {
+        const uint64_t tick = result.ticks_run;
+        uint8_t keys = 0;
+        if (job.input) {
+            keys = job.input(game, tick);
+        } else if (tick < job.keys.size()) {
+            keys = job.keys[static_cast<size_t>(tick)];
+        }
+        apply_input_keys(game, keys);
+        result.outcome = run_gameplay_tick(game);
+        ++result.ticks_run;
+        if (result.outcome != TickOutcome::Continue) {
+            break;
+        }
+    }
+
+    result.checksum = gameplay_checksum(game);
+    result.level_number = game.current_level_number;
+    result.stage_number = game.current_stage_number;
+    result.comic_x = game.comic_x;
+    result.comic_y = game.comic_y;
+    result.comic_hp = game.comic_hp;
+    result.comic_num_lives = game.comic_num_lives;
+    result.comic_num_treasures = game.actors.comic_num_treasures;
+    return result;
+}
+
+// Claim jobs of the current batch until none are left
+void BatchRunner::run_claimed_jobs() {
+    const std::vector<BatchJob>& jobs = *batch_jobs;
+    std::vector<BatchResult>& results = *batch_results;
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+        results[i] = run_job(jobs[i]);
+    }
+}
+
+std::vector<BatchResult> BatchRunner::run(const std::vector<BatchJob>& jobs) {
+    std::vector<BatchResult> results(jobs.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch_jobs = &jobs;
+        batch_results = &results;
+        next_job = 0;
+        busy_workers = static_cast<unsigned>(workers.size());
+        ++batch_generation;
+    }
+    work_available.notify_all();
+
+    run_claimed_jobs();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    batch_finished.wait(lock, [this]() { return busy_workers == 0; });
+    batch_jobs = nullptr;
+    batch_results = nullptr;
+    return results;
+}
+
+void BatchRunner::worker_main() {
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_available.wait(lock, [&]() { return stopping || batch_generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = batch_generation;
+        }
+
+        run_claimed_jobs();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --busy_workers;
+        }
+        batch_finished.notify_all();
+    }
+}
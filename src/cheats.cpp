@@ -2,6 +2,8 @@
 #include "../include/level_loader.h"
 #include "../include/level.h"
 #include "../include/actors.h"
+#include "../include/game_context.h"
+#include "../include/physics.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -21,22 +23,9 @@ void print_cheat_menu() {
 // Global cheat system instance
 CheatSystem* g_cheats = nullptr;
 
-// External references to game state from main.cpp
-extern int comic_x;
-extern int comic_y;
-extern int8_t comic_y_vel;
-extern int8_t comic_x_momentum;
-extern uint8_t comic_is_falling_or_jumping;
-extern int camera_x;
-extern uint8_t current_level_number;
-extern uint8_t current_stage_number;
-extern ActorSystem* g_actor_system;  // Actor system for item granting
-
-// External reference to physics cheat flags
-extern bool cheat_noclip;
-
 CheatSystem::CheatSystem() 
-    : initialized(false)
+    : game(nullptr)
+    , initialized(false)
     , debug_enabled(false)
     , noclip_active(false)
     , debug_overlay_active(false)
@@ -56,12 +45,13 @@ CheatSystem::~CheatSystem() {
     cleanup();
 }
 
-bool CheatSystem::initialize(bool debug_mode) {
+bool CheatSystem::initialize(bool debug_mode, GameContext* game_context) {
     if (initialized) {
         return true;
     }
     
     debug_enabled = debug_mode;
+    game = game_context;
     
     if (debug_enabled) {
         print_cheat_menu();
@@ -84,7 +74,10 @@ void CheatSystem::cleanup() {
     awaiting_x_input = false;
     awaiting_y_input = false;
     awaiting_item_input = false;
-    cheat_noclip = false;
+    if (game) {
+        set_noclip(*game, false);
+    }
+    game = nullptr;
     
     initialized = false;
 }
@@ -141,7 +134,9 @@ void CheatSystem::process_input(SDL_Keycode key) {
 
 void CheatSystem::toggle_noclip() {
     noclip_active = !noclip_active;
-    cheat_noclip = noclip_active;
+    if (game) {
+        set_noclip(*game, noclip_active);
+    }
     
     std::cout << "[CHEAT] Noclip " << (noclip_active ? "enabled" : "disabled") << std::endl;
 }
@@ -277,50 +272,58 @@ void CheatSystem::handle_position_warp_input(SDL_Keycode key) {
 }
 
 void CheatSystem::execute_level_warp() {
+    if (!game) {
+        return;
+    }
+    
     std::cout << "[CHEAT] Warping to level " << static_cast<int>(target_level)
               << ", stage " << static_cast<int>(target_stage) << std::endl;
     
     // Set level/stage numbers
-    current_level_number = static_cast<uint8_t>(target_level);
-    current_stage_number = static_cast<uint8_t>(target_stage);
+    game->current_level_number = static_cast<uint8_t>(target_level);
+    game->current_stage_number = static_cast<uint8_t>(target_stage);
     
     // Load the new level and stage
     // Note: load_new_level() and load_new_stage() are void functions that handle their
     // own error logging. They log warnings if assets are missing but continue gracefully.
     // If tileset loading fails, the renderer will display fallback behavior.
-    load_new_level();
-    load_new_stage();
+    load_new_level(*game);
+    load_new_stage(*game);
     
     // Reset player to safe spawn position
-    comic_x = 20;
-    comic_y = 14;
-    comic_y_vel = 0;
-    comic_x_momentum = 0;
-    comic_is_falling_or_jumping = 0;
-    camera_x = 0;
+    game->comic_x = 20;
+    game->comic_y = 14;
+    game->comic_y_vel = 0;
+    game->comic_x_momentum = 0;
+    game->comic_is_falling_or_jumping = 0;
+    game->camera_x = 0;
     
     std::cout << "[CHEAT] Level warp complete" << std::endl;
 }
 
 void CheatSystem::execute_position_warp() {
+    if (!game) {
+        return;
+    }
+    
     std::cout << "[CHEAT] Warping to position (" << target_x << ", " << target_y << ")" << std::endl;
     
     // Set player position
-    comic_x = target_x;
-    comic_y = target_y;
-    comic_y_vel = 0;
-    comic_x_momentum = 0;
+    game->comic_x = target_x;
+    game->comic_y = target_y;
+    game->comic_y_vel = 0;
+    game->comic_x_momentum = 0;
     
     // Adjust camera to keep player visible
     // Camera follows player with some margin
     const int screen_width_units = 20;  // 320 pixels / 16 pixels per unit
     const int camera_margin = 5;  // Keep player at least 5 units from edge
     
-    if (comic_x < camera_x + camera_margin) {
-        camera_x = comic_x - camera_margin;
-        if (camera_x < 0) camera_x = 0;
-    } else if (comic_x > camera_x + screen_width_units - camera_margin) {
-        camera_x = comic_x - screen_width_units + camera_margin;
+    if (game->comic_x < game->camera_x + camera_margin) {
+        game->camera_x = game->comic_x - camera_margin;
+        if (game->camera_x < 0) game->camera_x = 0;
+    } else if (game->comic_x > game->camera_x + screen_width_units - camera_margin) {
+        game->camera_x = game->comic_x - screen_width_units + camera_margin;
     }
     
     std::cout << "[CHEAT] Position warp complete" << std::endl;
@@ -388,8 +391,8 @@ void CheatSystem::handle_item_grant_input(SDL_Keycode key) {
 }
 
 void CheatSystem::execute_item_grant() {
-    if (!g_actor_system) {
-        std::cout << "[CHEAT] Error: Actor system not available" << std::endl;
+    if (!game) {
+        std::cout << "[CHEAT] Error: No game to grant the item in" << std::endl;
         return;
     }
     
@@ -417,7 +420,7 @@ void CheatSystem::execute_item_grant() {
               << static_cast<int>(target_item) << ")" << std::endl;
     
     // Apply the item effect
-    g_actor_system->apply_item_effect(static_cast<uint8_t>(target_item));
+    game->actors.apply_item_effect(*game, static_cast<uint8_t>(target_item));
     
     std::cout << "[CHEAT] Item granted successfully" << std::endl;
 }
@@ -0,0 +1,149 @@
+#include "../include/collision_map.h"
+#include "../include/level.h"
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Index of the lowest / highest set bit; mask must be non-zero
+static int lowest_bit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static int highest_bit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return static_cast<int>(index);
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+SolidityTable build_solidity_table(uint8_t last_passable, const level_t* level) {
+    SolidityTable table;
+    table.last_passable = last_passable;
+    for (int tile = last_passable + 1; tile < 256; ++tile) {
+        table.bits[tile >> 6] |= 1ull << (tile & 63);
+    }
+
+    if (level != nullptr) {
+        auto clear = [&table](uint8_t tile) {
+            table.bits[tile >> 6] &= ~(1ull << (tile & 63));
+        };
+        clear(level->door_tile_ul);
+        clear(level->door_tile_ur);
+        clear(level->door_tile_ll);
+        clear(level->door_tile_lr);
+        for (uint8_t tile : level->door_frame_tiles) {
+            if (tile != 0) {
+                clear(tile);
+            }
+        }
+    }
+    return table;
+}
+
+CollisionBitboard::CollisionBitboard() : source(nullptr) {
+    clear();
+}
+
+void CollisionBitboard::clear() {
+    std::memset(rows, 0, sizeof(rows));
+    std::memset(columns, 0, sizeof(columns));
+    source = nullptr;
+    solidity = SolidityTable();
+}
+
+void CollisionBitboard::build(const uint8_t* tiles, const SolidityTable& table) {
+    clear();
+    source = tiles;
+    solidity = table;
+    if (tiles == nullptr) {
+        return;
+    }
+
+    for (int y = 0; y < HEIGHT; ++y) {
+        const uint8_t* row = tiles + y * WIDTH;
+        for (int x = 0; x < WIDTH; ++x) {
+            const uint64_t solid = table.is_solid(row[x]);
+            rows[y][x >> 6] |= solid << (x & 63);
+            columns[x] |= static_cast<uint16_t>(solid << y);
+        }
+    }
+}
+
+bool CollisionBitboard::any_solid_in_row(int tile_y, int first_x, int last_x) const {
+    if (static_cast<unsigned>(tile_y) >= HEIGHT) {
+        return false;
+    }
+    if (first_x < 0) {
+        first_x = 0;
+    }
+    if (last_x >= WIDTH) {
+        last_x = WIDTH - 1;
+    }
+    for (int word = first_x >> 6; word <= (last_x >> 6) && first_x <= last_x; ++word) {
+        const int lo = (word == first_x >> 6) ? (first_x & 63) : 0;
+        const int hi = (word == last_x >> 6) ? (last_x & 63) : 63;
+        const uint64_t span = (~0ull >> (63 - hi)) & (~0ull << lo);
+        if (rows[tile_y][word] & span) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CollisionBitboard::any_solid_in_column(int tile_x, int first_y, int last_y) const {
+    if (first_y < 0) {
+        first_y = 0;
+    }
+    if (last_y >= HEIGHT) {
+        last_y = HEIGHT - 1;
+    }
+    if (first_y > last_y) {
+        return false;
+    }
+    const uint32_t span = ((2u << last_y) - 1) & ~((1u << first_y) - 1);
+    return (get_column(tile_x) & span) != 0;
+}
+
+int CollisionBitboard::find_solid_at_or_below(int tile_x, int tile_y) const {
+    if (tile_y >= HEIGHT) {
+        return -1;
+    }
+    if (tile_y < 0) {
+        tile_y = 0;
+    }
+    const uint32_t below = get_column(tile_x) & ~((1u << tile_y) - 1);
+    return below ? lowest_bit(below) : -1;
+}
+
+int CollisionBitboard::find_solid_at_or_above(int tile_x, int tile_y) const {
+    if (tile_y < 0) {
+        return -1;
+    }
+    if (tile_y >= HEIGHT) {
+        tile_y = HEIGHT - 1;
+    }
+    const uint32_t above = get_column(tile_x) & ((2u << tile_y) - 1);
+    return above ? highest_bit(above) : -1;
+}
+
+int CollisionBitboard::find_open_at_or_above(int tile_x, int tile_y) const {
+    if (tile_y < 0) {
+        return -1;
+    }
+    if (tile_y >= HEIGHT) {
+        tile_y = HEIGHT - 1;
+    }
+    const uint32_t above = ~static_cast<uint32_t>(get_column(tile_x)) & ((2u << tile_y) - 1);
+    return above ? highest_bit(above) : -1;
+}
@@ -0,0 +1,72 @@
+/**
+ * counters.cpp - Runtime event counter totals and their names
+ */
+
+#include "../include/counters.h"
+#include <algorithm>
+#include <iomanip>
+
+// Static storage, so every counter starts at zero
+std::atomic<uint64_t> g_counters[COUNTER_COUNT];
+
+namespace {
+
+const char* const COUNTER_NAMES[] = {
+    "render_calls",
+    "texture_switches",
+    "textures_created",
+    "images_decoded",
+    "image_bytes_decoded",
+    "sounds_accepted_p0",
+    "sounds_accepted_p1",
+    "sounds_accepted_p2",
+    "sounds_accepted_p3",
+    "sounds_accepted_p4",
+    "sounds_rejected_p0",
+    "sounds_rejected_p1",
+    "sounds_rejected_p2",
+    "sounds_rejected_p3",
+    "sounds_rejected_p4",
+    "waveforms_synthesized",
+    "enemies_spawned",
+    "enemies_despawned",
+    "frames",
+    "ticks_run",
+    "tick_cap_frames",
+    "ticks_dropped",
+    "early_ticks",
+    "frames_unchanged",
+    "capture_frames",
+    "capture_frames_dropped",
+    "frame_arena_overflows",
+    "map_chunks_read",
+};
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == COUNTER_COUNT, "a name per Counter");
+
+}  // namespace
+
+void count_sound_request(uint8_t priority, bool accepted) {
+    const uint8_t level = std::min<uint8_t>(priority, COUNTED_SOUND_PRIORITIES - 1);
+    const Counter first = accepted ? Counter::SOUNDS_ACCEPTED_P0 : Counter::SOUNDS_REJECTED_P0;
+    count_event(static_cast<Counter>(static_cast<size_t>(first) + level));
+}
+
+const char* get_counter_name(Counter counter) {
+    const size_t index = static_cast<size_t>(counter);
+    return index < COUNTER_COUNT ? COUNTER_NAMES[index] : "unknown";
+}
+
+void reset_counters() {
+    for (auto& counter : g_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void print_counters(std::ostream& out) {
+    out << "Stats:" << std::endl;
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        const Counter counter = static_cast<Counter>(i);
+        out << "  " << std::left << std::setw(22) << get_counter_name(counter) << std::right
+            << get_counter(counter) << std::endl;
+    }
+}
@@ -1,20 +1,10 @@
 #include "../include/doors.h"
 #include "../include/physics.h"
+#include "../include/game_context.h"
+#include "../include/level_loader.h"
 #include "../include/audio.h"
 #include <cstdint>
 
-// Testing hook defined in header; see comment there.
-bool g_skip_load_on_door = false;
-
-DoorAnimationPhase g_door_anim_phase = DoorAnimationPhase::NONE;
-uint8_t g_door_anim_frame = 0;
-static uint8_t g_door_exit_delay_ticks = 0;
-
-static uint8_t g_door_anim_world_x = DOOR_UNUSED;
-static uint8_t g_door_anim_world_y = DOOR_UNUSED;
-static uint8_t g_door_pending_level = 0;
-static uint8_t g_door_pending_stage = 0;
-
 /**
  * doors.cpp - Door system implementation
  * 
@@ -24,43 +14,26 @@ static uint8_t g_door_pending_stage = 0;
  * Reference: jsandas/comic-c src/doors.c
  */
 
-/* External game state variables (defined in main.cpp) */
-extern int comic_x;
-extern int comic_y;
-extern uint8_t comic_has_door_key;
-extern uint8_t key_state_open;
-extern uint8_t current_level_number;
-extern uint8_t current_stage_number;
-extern const level_t* current_level_ptr;
-
-/* Source door tracking for proper reciprocal door positioning */
-extern int8_t source_door_level_number;
-extern int8_t source_door_stage_number;
+static void load_pending_door_destination(GameContext& game) {
+    const uint8_t target_level = game.door_pending_level;
+    game.current_stage_number = game.door_pending_stage;
+    game.current_level_number = target_level;
 
-/* External functions for level loading (defined in level_loader.cpp) */
-extern void load_new_level();
-extern void load_new_stage();
-
-static void load_pending_door_destination() {
-    const uint8_t target_level = g_door_pending_level;
-    current_stage_number = g_door_pending_stage;
-    current_level_number = target_level;
-
-    if (target_level != static_cast<uint8_t>(source_door_level_number)) {
-        load_new_level();
+    if (target_level != static_cast<uint8_t>(game.source_door_level_number)) {
+        load_new_level(game);
     } else {
-        load_new_stage();
+        load_new_stage(game);
     }
 
     // Keep door overlay position in bounds if reciprocal spawn resolution fails.
-    if (comic_x <= 0) {
-        g_door_anim_world_x = 0;
-    } else if (comic_x > 255) {
-        g_door_anim_world_x = 255;
+    if (game.comic_x <= 0) {
+        game.door_anim_world_x = 0;
+    } else if (game.comic_x > 255) {
+        game.door_anim_world_x = 255;
     } else {
-        g_door_anim_world_x = static_cast<uint8_t>(comic_x - 1);
+        game.door_anim_world_x = static_cast<uint8_t>(game.comic_x - 1);
     }
-    g_door_anim_world_y = static_cast<uint8_t>(comic_y);
+    game.door_anim_world_y = static_cast<uint8_t>(game.comic_y);
 }
 
 /**
@@ -75,26 +48,26 @@ static void load_pending_door_destination() {
  * 
  * Assembly reference: R5sw1991.asm:3952-3973
  */
-uint8_t check_door_activation() {
+uint8_t check_door_activation(GameContext& game) {
     /* Validate preconditions */
-    if (!current_level_ptr) {
+    if (!game.current_level_ptr) {
         return 0;  /* No level loaded */
     }
     
-    if (current_stage_number >= 3) {
+    if (game.current_stage_number >= 3) {
         return 0;  /* Invalid stage number */
     }
     
-    if (key_state_open != 1) {
+    if (game.key_state_open != 1) {
         return 0;  /* Open key not pressed */
     }
 
-    if (g_door_anim_phase != DoorAnimationPhase::NONE) {
+    if (game.door_anim_phase != DoorAnimationPhase::NONE) {
         return 0;  /* Ignore re-entry while a door sequence is active */
     }
     
     /* Get current stage data */
-    const stage_t* current_stage = &current_level_ptr->stages[current_stage_number];
+    const stage_t* current_stage = &game.current_level_ptr->stages[game.current_stage_number];
     
     /* Check all doors in the current stage */
     for (int i = 0; i < MAX_NUM_DOORS; i++) {
@@ -108,25 +81,26 @@ uint8_t check_door_activation() {
         /* Check Y coordinate: must be exact match
          * Both comic_y and door->y are in game units (same coordinate system).
          * Door activation only occurs when Comic's Y exactly equals the door's Y. */
-        if (comic_y != door->y) {
+        if (game.comic_y != door->y) {
             continue;
         }
         
         /* Check X coordinate: must be within 3 units
-         * Both comic_x and door->x are in game units
+         * Both comic_x and door->x are in game units (door->x from the
+         * left of a streamed map, comic_x from its window's left)
          * Comic is 2 units wide, so allows adjacent positioning */
-        int x_offset = comic_x - door->x;
+        int x_offset = game.comic_x - (door->x - game.map_origin_x * 2);
         if (x_offset < 0 || x_offset > 2) {
             continue;
         }
         
         /* Check if player has the Door Key */
-        if (comic_has_door_key != 1) {
+        if (game.comic_has_door_key != 1) {
             continue;  /* Door is locked, skip to next door */
         }
         
         /* All checks passed: activate this door */
-        activate_door(door);
+        activate_door(game, door);
         return 1;  /* Door was activated */
     }
     
@@ -134,50 +108,51 @@ uint8_t check_door_activation() {
     return 0;
 }
 
-void update_door_animation_tick() {
-    if (g_door_anim_phase == DoorAnimationPhase::NONE) {
+void update_door_animation_tick(GameContext& game) {
+    if (game.door_anim_phase == DoorAnimationPhase::NONE) {
         return;
     }
 
-    if (g_door_anim_phase == DoorAnimationPhase::ENTERING) {
-        if (g_door_anim_frame < 3) {
-            g_door_anim_frame++;
+    if (game.door_anim_phase == DoorAnimationPhase::ENTERING) {
+        if (game.door_anim_frame < 3) {
+            game.door_anim_frame++;
             return;
         }
 
-        load_pending_door_destination();
-        g_door_anim_phase = DoorAnimationPhase::EXIT_DELAY;
-        g_door_anim_frame = 0;
-        g_door_exit_delay_ticks = 3;
+        load_pending_door_destination(game);
+        game.door_anim_phase = DoorAnimationPhase::EXIT_DELAY;
+        game.door_anim_frame = 0;
+        game.door_exit_delay_ticks = 3;
         return;
     }
 
-    if (g_door_anim_phase == DoorAnimationPhase::EXIT_DELAY) {
-        if (g_door_exit_delay_ticks > 0) {
-            g_door_exit_delay_ticks--;
+    if (game.door_anim_phase == DoorAnimationPhase::EXIT_DELAY) {
+        if (game.door_exit_delay_ticks > 0) {
+            game.door_exit_delay_ticks--;
         }
 
-        if (g_door_exit_delay_ticks == 0) {
+        if (game.door_exit_delay_ticks == 0) {
             play_game_sound(GameSound::DOOR_OPEN);
-            g_door_anim_phase = DoorAnimationPhase::EXITING;
-            g_door_anim_frame = 0;
+            game.door_anim_phase = DoorAnimationPhase::EXITING;
+            game.door_anim_frame = 0;
         }
         return;
     }
 
-    if (g_door_anim_frame >= 4) {
-        g_door_anim_phase = DoorAnimationPhase::NONE;
-        g_door_anim_frame = 0;
-        g_door_exit_delay_ticks = 0;
-        g_door_anim_world_x = DOOR_UNUSED;
-        g_door_anim_world_y = DOOR_UNUSED;
+    if (game.door_anim_frame >= 4) {
+        game.door_anim_phase = DoorAnimationPhase::NONE;
+        game.door_anim_frame = 0;
+        game.door_exit_delay_ticks = 0;
+        game.door_anim_world_x = DOOR_UNUSED;
+        game.door_anim_world_y = DOOR_UNUSED;
         return;
     }
 
-    g_door_anim_frame++;
+    game.door_anim_frame++;
 }
 
 bool get_door_animation_render_state(
+    const GameContext& game,
     uint8_t* world_x,
     uint8_t* world_y,
     DoorAnimationRenderMode* mode,
@@ -185,22 +160,22 @@ bool get_door_animation_render_state(
     bool* player_visible
 ) {
     if (!world_x || !world_y || !mode || !draw_overlay_in_front || !player_visible ||
-        g_door_anim_phase == DoorAnimationPhase::NONE) {
+        game.door_anim_phase == DoorAnimationPhase::NONE) {
         return false;
     }
 
-    if (g_door_anim_world_x == DOOR_UNUSED || g_door_anim_world_y == DOOR_UNUSED) {
+    if (game.door_anim_world_x == DOOR_UNUSED || game.door_anim_world_y == DOOR_UNUSED) {
         return false;
     }
 
-    *world_x = g_door_anim_world_x;
-    *world_y = g_door_anim_world_y;
+    *world_x = game.door_anim_world_x;
+    *world_y = game.door_anim_world_y;
     *mode = DoorAnimationRenderMode::NONE;
     *draw_overlay_in_front = false;
     *player_visible = true;
 
-    if (g_door_anim_phase == DoorAnimationPhase::ENTERING) {
-        switch (g_door_anim_frame) {
+    if (game.door_anim_phase == DoorAnimationPhase::ENTERING) {
+        switch (game.door_anim_frame) {
             case 0:
                 *mode = DoorAnimationRenderMode::HALF_OPEN;
                 *draw_overlay_in_front = false;
@@ -223,13 +198,13 @@ bool get_door_animation_render_state(
         }
     }
 
-    if (g_door_anim_phase == DoorAnimationPhase::EXIT_DELAY) {
+    if (game.door_anim_phase == DoorAnimationPhase::EXIT_DELAY) {
         *mode = DoorAnimationRenderMode::NONE;
         *player_visible = false;
         return true;
     }
 
-    switch (g_door_anim_frame) {
+    switch (game.door_anim_frame) {
         case 0:
             *mode = DoorAnimationRenderMode::NONE;
             *player_visible = false;
@@ -273,7 +248,7 @@ bool get_door_animation_render_state(
  * 
  * Assembly reference: R5sw1991.asm:4618-4643
  */
-void activate_door(const door_t *door) {
+void activate_door(GameContext& game, const door_t *door) {
     /* Validate door target values before proceeding */
     if (door->target_stage >= 3) {
         return;  /* Invalid target stage */
@@ -284,28 +259,31 @@ void activate_door(const door_t *door) {
     }
     
     /* Save source for reciprocal spawn after destination stage is loaded. */
-    source_door_level_number = current_level_number;
-    source_door_stage_number = current_stage_number;
+    game.source_door_level_number = game.current_level_number;
+    game.source_door_stage_number = game.current_stage_number;
 
     /* Shortcut for unit tests: avoid loading anything (which would clear
      * source_door_* and may print warnings if reciprocal door data is
      * missing). The tests still need to see the level/stage numbers update. */
-    if (g_skip_load_on_door) {
-        g_door_anim_phase = DoorAnimationPhase::NONE;
-        g_door_anim_frame = 0;
-        g_door_exit_delay_ticks = 0;
-        current_stage_number = door->target_stage;
-        current_level_number = door->target_level;
+    if (game.skip_load_on_door) {
+        game.door_anim_phase = DoorAnimationPhase::NONE;
+        game.door_anim_frame = 0;
+        game.door_exit_delay_ticks = 0;
+        game.current_stage_number = door->target_stage;
+        game.current_level_number = door->target_level;
         return;
     }
 
     play_game_sound(GameSound::DOOR_OPEN);
 
-    g_door_pending_level = door->target_level;
-    g_door_pending_stage = door->target_stage;
-    g_door_anim_world_x = door->x;
-    g_door_anim_world_y = door->y;
-    g_door_anim_phase = DoorAnimationPhase::ENTERING;
-    g_door_anim_frame = 0;
-    g_door_exit_delay_ticks = 0;
+    game.door_pending_level = door->target_level;
+    game.door_pending_stage = door->target_stage;
+    game.door_anim_world_x = static_cast<uint8_t>(door->x - game.map_origin_x * 2);
+    game.door_anim_world_y = door->y;
+    game.door_anim_phase = DoorAnimationPhase::ENTERING;
+    game.door_anim_frame = 0;
+    game.door_exit_delay_ticks = 0;
+
+    /* Finish the destination's decodes while the door animation plays */
+    prefetch_door_destination(game, door->target_level, door->target_stage);
 }
@@ -0,0 +1,48 @@
+/**
+ * frame_arena.cpp - Per-frame bump allocator
+ */
+
+#include "../include/frame_arena.h"
+#include "../include/counters.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+FrameArena::FrameArena(size_t arena_capacity)
+    : buffer(new uint8_t[arena_capacity]), capacity(arena_capacity) {}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(buffer.get());
+    const uintptr_t aligned = (base + used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t offset = static_cast<size_t>(aligned - base);
+    if (offset > capacity || bytes > capacity - offset) {
+        count_event(Counter::FRAME_ARENA_OVERFLOWS);
+        return nullptr;
+    }
+    used = offset + bytes;
+    high_water = std::max(high_water, used);
+    return buffer.get() + offset;
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    const int length = std::vsnprintf(nullptr, 0, fmt, measure);
+    va_end(measure);
+
+    char* text = length >= 0 ? allocate_array<char>(static_cast<size_t>(length) + 1) : nullptr;
+    if (!text) {
+        va_end(args);
+        return "";
+    }
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return text;
+}
+
+FrameArena& frame_arena() {
+    static FrameArena arena(FRAME_ARENA_BYTES);
+    return arena;
+}
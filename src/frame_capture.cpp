@@ -0,0 +1,322 @@
+/**
+ * frame_capture.cpp - Offscreen frame capture with asynchronous readback
+ */
+
+#include "../include/frame_capture.h"
+#include "../include/counters.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+// How long the writer thread sleeps when there is nothing to write, and the
+// render thread when an offline render waits for a free buffer
+constexpr auto CAPTURE_IDLE_SLEEP = std::chrono::milliseconds(1);
+
+bool parse_capture_format(const char* name, CaptureFormat* format) {
+    if (std::strcmp(name, "y4m") == 0) {
+        *format = CaptureFormat::Y4M;
+    } else if (std::strcmp(name, "raw") == 0) {
+        *format = CaptureFormat::RAW_RGBA;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Full-range BT.601 in 8.8 fixed point; the offset keeps the sums positive
+static uint8_t to_luma(int r, int g, int b) {
+    return static_cast<uint8_t>((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+static uint8_t to_chroma(int sum) {
+    return static_cast<uint8_t>(std::min((sum + 128 * 256 + 128) >> 8, 255));
+}
+
+void convert_rgba_to_i420(const uint8_t* rgba, int width, int height, int pitch, uint8_t* out) {
+    uint8_t* y_plane = out;
+    uint8_t* u_plane = out + width * height;
+    uint8_t* v_plane = u_plane + (width / 2) * (height / 2);
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = rgba + y * pitch;
+        for (int x = 0; x < width; ++x) {
+            y_plane[y * width + x] = to_luma(row[x * 4], row[x * 4 + 1], row[x * 4 + 2]);
+        }
+    }
+
+    for (int y = 0; y < height / 2; ++y) {
+        const uint8_t* top = rgba + (y * 2) * pitch;
+        const uint8_t* bottom = top + pitch;
+        for (int x = 0; x < width / 2; ++x) {
+            const uint8_t* a = top + x * 8;
+            const uint8_t* b = bottom + x * 8;
+            const int r = (a[0] + a[4] + b[0] + b[4] + 2) / 4;
+            const int g = (a[1] + a[5] + b[1] + b[5] + 2) / 4;
+            const int bl = (a[2] + a[6] + b[2] + b[6] + 2) / 4;
+            u_plane[y * (width / 2) + x] = to_chroma(-43 * r - 85 * g + 128 * bl);
+            v_plane[y * (width / 2) + x] = to_chroma(128 * r - 107 * g - 21 * bl);
+        }
+    }
+}
+
+FrameWriter::~FrameWriter() {
+    finish();
+}
+
+bool FrameWriter::open(const char* destination, CaptureFormat frame_format, int frame_width,
+                       int frame_height, int fps) {
+    FILE* output = nullptr;
+    const bool pipe = destination[0] == '|';
+    if (pipe) {
+        output = popen(destination + 1, "w");
+    } else {
+        output = std::fopen(destination, "wb");
+    }
+    if (!output) {
+        std::cerr << "Could not open capture output " << destination << std::endl;
+        return false;
+    }
+    if (!open_stream(output, true, frame_format, frame_width, frame_height, fps)) {
+        pipe ? pclose(output) : std::fclose(output);
+        stream = nullptr;
+        return false;
+    }
+    is_pipe = pipe;
+    return true;
+}
+
+bool FrameWriter::open_stream(FILE* output, bool close_output, CaptureFormat frame_format,
+                              int frame_width, int frame_height, int fps) {
+    finish();
+    stream = output;
+    close_stream = close_output;
+    is_pipe = false;
+    return start(frame_format, frame_width, frame_height, fps);
+}
+
+bool FrameWriter::start(CaptureFormat frame_format, int frame_width, int frame_height, int fps) {
+    format = frame_format;
+    width = frame_width;
+    height = frame_height;
+    if (format == CaptureFormat::Y4M) {
+        width &= ~1;  // 4:2:0 chroma covers 2x2 blocks
+        height &= ~1;
+    }
+    if (width <= 0 || height <= 0) {
+        std::cerr << "Capture frame size " << frame_width << "x" << frame_height << " is too small" << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < FRAME_CAPTURE_BUFFERS; ++i) {
+        frames[i].assign(static_cast<size_t>(get_frame_pitch()) * height, 0);
+        free_frames.push(i);
+    }
+    if (format == CaptureFormat::Y4M) {
+        converted.assign(static_cast<size_t>(width) * height * 3 / 2, 0);
+        std::fprintf(stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XYSCSS=420JPEG\n", width, height,
+                     std::max(fps, 1));
+    }
+
+    stopping.store(false, std::memory_order_relaxed);
+    write_failed.store(false, std::memory_order_relaxed);
+    frames_written.store(0, std::memory_order_relaxed);
+    writer = std::thread(&FrameWriter::thread_main, this);
+    return true;
+}
+
+uint8_t* FrameWriter::acquire_frame(bool wait) {
+    int index = 0;
+    while (!free_frames.pop(&index)) {
+        if (!wait || !is_open() || write_failed.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        std::this_thread::sleep_for(CAPTURE_IDLE_SLEEP);
+    }
+    return frames[index].data();
+}
+
+void FrameWriter::submit_frame(uint8_t* frame) {
+    for (int i = 0; i < FRAME_CAPTURE_BUFFERS; ++i) {
+        if (frames[i].data() == frame) {
+            filled.push(i);  // Never full: there are only as many buffers as slots
+            return;
+        }
+    }
+}
+
+bool FrameWriter::write_frame(const uint8_t* frame) {
+    if (format == CaptureFormat::Y4M) {
+        convert_rgba_to_i420(frame, width, height, get_frame_pitch(), converted.data());
+        return std::fputs("FRAME\n", stream) >= 0 &&
+               std::fwrite(converted.data(), 1, converted.size(), stream) == converted.size();
+    }
+    const size_t size = static_cast<size_t>(get_frame_pitch()) * height;
+    return std::fwrite(frame, 1, size, stream) == size;
+}
+
+void FrameWriter::thread_main() {
+    while (true) {
+        // Read before popping: once it is set, every submitted frame is queued
+        const bool stop = stopping.load(std::memory_order_acquire);
+        int index = 0;
+        if (filled.pop(&index)) {
+            if (!write_failed.load(std::memory_order_relaxed)) {
+                if (write_frame(frames[index].data())) {
+                    frames_written.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    write_failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            free_frames.push(index);
+            continue;
+        }
+        if (stop) {
+            break;
+        }
+        std::this_thread::sleep_for(CAPTURE_IDLE_SLEEP);
+    }
+}
+
+bool FrameWriter::finish() {
+    if (!writer.joinable()) {
+        return !write_failed.load(std::memory_order_relaxed);
+    }
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+
+    bool ok = !write_failed.load(std::memory_order_relaxed) && std::fflush(stream) == 0;
+    if (close_stream) {
+        if (is_pipe) {
+            ok = pclose(stream) == 0 && ok;  // The encoder's exit status
+        } else {
+            ok = std::fclose(stream) == 0 && ok;
+        }
+    }
+    stream = nullptr;
+
+    // Back to an empty queue for the next open
+    int index = 0;
+    while (free_frames.pop(&index)) {
+    }
+    if (!ok) {
+        write_failed.store(true, std::memory_order_relaxed);
+        std::cerr << "Writing the captured frames failed" << std::endl;
+    }
+    return ok;
+}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(SDL_Renderer* capture_renderer, const char* destination, CaptureFormat format,
+                         int fps, bool keep_all_frames) {
+    stop();
+    if (!capture_renderer || !SDL_RenderTargetSupported(capture_renderer)) {
+        std::cerr << "Frame capture needs render target support" << std::endl;
+        return false;
+    }
+    if (SDL_GetRendererOutputSize(capture_renderer, &output_width, &output_height) != 0) {
+        std::cerr << "Could not get the renderer output size: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    for (SDL_Texture*& target : targets) {
+        target = SDL_CreateTexture(capture_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                   output_width, output_height);
+        if (!target) {
+            std::cerr << "Could not create a capture target: " << SDL_GetError() << std::endl;
+            for (SDL_Texture*& created : targets) {
+                if (created) {
+                    SDL_DestroyTexture(created);
+                    created = nullptr;
+                }
+            }
+            return false;
+        }
+    }
+    if (!writer.open(destination, format, output_width, output_height, fps)) {
+        for (SDL_Texture*& target : targets) {
+            SDL_DestroyTexture(target);
+            target = nullptr;
+        }
+        return false;
+    }
+
+    renderer = capture_renderer;
+    keep_every_frame = keep_all_frames;
+    frames_begun = 0;
+    frames_read = 0;
+    frames_captured = 0;
+    frames_dropped = 0;
+    return true;
+}
+
+SDL_Texture* FrameCapture::get_frame_target() const {
+    return renderer ? targets[frames_begun % FRAME_CAPTURE_TARGETS] : nullptr;
+}
+
+void FrameCapture::begin_frame() {
+    if (!renderer) {
+        return;
+    }
+    SDL_SetRenderTarget(renderer, get_frame_target());
+}
+
+void FrameCapture::read_back(SDL_Texture* target) {
+    uint8_t* frame = writer.acquire_frame(keep_every_frame);
+    if (!frame) {
+        ++frames_dropped;
+        count_event(Counter::CAPTURE_FRAMES_DROPPED);
+        return;
+    }
+    SDL_SetRenderTarget(renderer, target);
+    const SDL_Rect rect = {0, 0, writer.get_width(), writer.get_height()};
+    if (SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_RGBA32, frame, writer.get_frame_pitch()) != 0) {
+        // Keep the frame count (and so the video's timing) right with a black frame
+        std::memset(frame, 0, static_cast<size_t>(writer.get_frame_pitch()) * writer.get_height());
+    }
+    writer.submit_frame(frame);
+    ++frames_captured;
+    count_event(Counter::CAPTURE_FRAMES);
+}
+
+void FrameCapture::end_frame() {
+    if (!renderer) {
+        return;
+    }
+    if (frames_begun - frames_read >= FRAME_CAPTURE_TARGETS - 1) {
+        read_back(targets[frames_read % FRAME_CAPTURE_TARGETS]);
+        ++frames_read;
+    }
+
+    SDL_Texture* current = get_frame_target();
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_RenderSetViewport(renderer, nullptr);
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_RenderCopy(renderer, current, nullptr, nullptr);
+    ++frames_begun;
+}
+
+bool FrameCapture::stop() {
+    if (!renderer) {
+        return true;
+    }
+    while (frames_read < frames_begun) {
+        read_back(targets[frames_read % FRAME_CAPTURE_TARGETS]);
+        ++frames_read;
+    }
+    SDL_SetRenderTarget(renderer, nullptr);
+    for (SDL_Texture*& target : targets) {
+        SDL_DestroyTexture(target);
+        target = nullptr;
+    }
+    renderer = nullptr;
+    return writer.finish();
+}
@@ -0,0 +1,314 @@
+/**
+ * frame_pacer.cpp - Frame scheduling, sub-tick render interpolation and
+ * render-on-change
+ */
+
+#include "../include/frame_pacer.h"
+#include "../include/counters.h"
+#include "../include/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// FIXED mode sleeps until this close to the deadline, then spins
+constexpr double SPIN_THRESHOLD_MS = 2.0;
+// POWER_SAVER polls this slowly while the window is minimized
+constexpr uint32_t MINIMIZED_SLEEP_MS = 100;
+// Moves longer than this in one tick (stage loads, teleports) are not interpolated
+constexpr int MAX_INTERPOLATED_STEP = 4;
+
+bool parse_pacing_mode(const char* text, PacingMode* mode) {
+    if (std::strcmp(text, "vsync") == 0) {
+        *mode = PacingMode::VSYNC;
+    } else if (std::strcmp(text, "fixed") == 0) {
+        *mode = PacingMode::FIXED;
+    } else if (std::strcmp(text, "power-saver") == 0) {
+        *mode = PacingMode::POWER_SAVER;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* get_pacing_mode_name(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSYNC:
+            return "vsync";
+        case PacingMode::FIXED:
+            return "fixed";
+        case PacingMode::POWER_SAVER:
+            return "power-saver";
+    }
+    return "unknown";
+}
+
+FramePacer::FramePacer()
+    : mode(PacingMode::FIXED), target_fps(DEFAULT_FIXED_FPS), window(nullptr), ms_per_count(0.0),
+      frame_period(0), next_deadline(0), first_present(0), last_present(0), presents(0),
+      interval_sum_ms(0.0), interval_square_sum_ms(0.0), max_interval_ms(0.0), sleep_ms(0.0) {}
+
+uint32_t FramePacer::renderer_flags(PacingMode mode) {
+    uint32_t flags = SDL_RENDERER_ACCELERATED;
+    if (mode == PacingMode::VSYNC) {
+        flags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    return flags;
+}
+
+void FramePacer::start(PacingMode requested_mode, int requested_fps, SDL_Renderer* renderer,
+                       SDL_Window* pacing_window) {
+    *this = FramePacer();
+    mode = requested_mode;
+    window = pacing_window;
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+    ms_per_count = 1000.0 / static_cast<double>(frequency);
+
+    int refresh_rate = 0;
+    SDL_DisplayMode display_mode;
+    if (window && SDL_GetWindowDisplayMode(window, &display_mode) == 0) {
+        refresh_rate = display_mode.refresh_rate;
+    }
+
+    if (mode == PacingMode::VSYNC) {
+        SDL_RendererInfo info;
+        if (!renderer || SDL_GetRendererInfo(renderer, &info) != 0 || (info.flags & SDL_RENDERER_PRESENTVSYNC) == 0) {
+            std::cerr << "Warning: The renderer did not get vsync; pacing at a fixed frame rate instead." << std::endl;
+            mode = PacingMode::FIXED;
+            if (requested_fps <= 0) {
+                requested_fps = refresh_rate > 0 ? refresh_rate : DEFAULT_FIXED_FPS;
+            }
+        }
+    }
+
+    if (requested_fps > 0) {
+        target_fps = requested_fps;
+    } else if (mode == PacingMode::POWER_SAVER) {
+        target_fps = DEFAULT_POWER_SAVER_FPS;
+    } else if (mode == PacingMode::VSYNC) {
+        target_fps = refresh_rate > 0 ? refresh_rate : DEFAULT_FIXED_FPS;
+    } else {
+        target_fps = DEFAULT_FIXED_FPS;
+    }
+    frame_period = static_cast<uint64_t>(static_cast<double>(frequency) / target_fps);
+}
+
+void FramePacer::mark_present() {
+    const uint64_t now = SDL_GetPerformanceCounter();
+    if (presents == 0) {
+        first_present = now;
+    } else {
+        const double interval_ms = static_cast<double>(now - last_present) * ms_per_count;
+        interval_sum_ms += interval_ms;
+        interval_square_sum_ms += interval_ms * interval_ms;
+        max_interval_ms = std::max(max_interval_ms, interval_ms);
+        profiler_set_present_interval(static_cast<float>(interval_ms));
+    }
+    last_present = now;
+    ++presents;
+}
+
+void FramePacer::sleep_for_ms(uint32_t ms) {
+    PROFILE_SCOPE(ProfilePhase::IDLE);
+    const uint64_t before = SDL_GetPerformanceCounter();
+    SDL_Delay(ms);
+    sleep_ms += static_cast<double>(SDL_GetPerformanceCounter() - before) * ms_per_count;
+}
+
+void FramePacer::wait_for_next_frame() {
+    if (mode == PacingMode::VSYNC) {
+        return;  // SDL_RenderPresent already waited for the display
+    }
+    if (mode == PacingMode::POWER_SAVER && window && (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) != 0) {
+        sleep_for_ms(MINIMIZED_SLEEP_MS);
+        next_deadline = 0;
+        return;
+    }
+
+    uint64_t now = SDL_GetPerformanceCounter();
+    next_deadline = next_deadline == 0 ? now + frame_period : next_deadline + frame_period;
+    if (now >= next_deadline) {
+        // A frame ran long: start the cadence again from here instead of
+        // rushing frames out to catch up
+        next_deadline = now;
+        return;
+    }
+
+    // Sleep in whole milliseconds while there is time to spare
+    const double keep_ms = mode == PacingMode::FIXED ? SPIN_THRESHOLD_MS : 0.0;
+    double remaining_ms = static_cast<double>(next_deadline - now) * ms_per_count;
+    while (remaining_ms > keep_ms + 1.0) {
+        sleep_for_ms(static_cast<uint32_t>(remaining_ms - keep_ms));
+        now = SDL_GetPerformanceCounter();
+        remaining_ms = now >= next_deadline ? 0.0 : static_cast<double>(next_deadline - now) * ms_per_count;
+    }
+    if (mode != PacingMode::FIXED) {
+        return;
+    }
+
+    // Spin the last stretch; SDL_Delay overshoots by up to a scheduler quantum
+    PROFILE_SCOPE(ProfilePhase::SPIN);
+    while (SDL_GetPerformanceCounter() < next_deadline) {
+    }
+}
+
+void FramePacer::wait_for_wakeup(double max_ms) {
+    if (max_ms < 1.0) {
+        return;
+    }
+    PROFILE_SCOPE(ProfilePhase::IDLE);
+    const uint64_t before = SDL_GetPerformanceCounter();
+    // Leaves the event queued for the loop to poll
+    SDL_WaitEventTimeout(nullptr, static_cast<int>(max_ms));
+    sleep_ms += static_cast<double>(SDL_GetPerformanceCounter() - before) * ms_per_count;
+    // The next frame starts a fresh cadence instead of one from before the sleep
+    next_deadline = 0;
+}
+
+FramePacingStats FramePacer::get_stats() const {
+    FramePacingStats stats;
+    stats.presents = presents;
+    if (presents < 2) {
+        return stats;
+    }
+    const double intervals = static_cast<double>(presents - 1);
+    stats.average_interval_ms = interval_sum_ms / intervals;
+    const double variance = interval_square_sum_ms / intervals - stats.average_interval_ms * stats.average_interval_ms;
+    stats.jitter_ms = std::sqrt(std::max(0.0, variance));
+    stats.max_interval_ms = max_interval_ms;
+    const double wall_ms = static_cast<double>(last_present - first_present) * ms_per_count;
+    if (wall_ms > 0.0) {
+        stats.busy_percent = std::max(0.0, 100.0 * (1.0 - sleep_ms / wall_ms));
+    }
+    return stats;
+}
+
+RenderInterpolator::RenderInterpolator()
+    : enabled(false), valid(false), blend(1.0), level_number(0), stage_number(0), camera_x(0), comic_x(0),
+      comic_y(0), enemy_x(), enemy_y(), enemy_state(), fireball_x(), fireball_y() {}
+
+void RenderInterpolator::set_enabled(bool enable) {
+    enabled = enable;
+    valid = false;
+}
+
+void RenderInterpolator::capture_previous(const GameContext& game) {
+    if (!enabled) {
+        return;
+    }
+    level_number = game.current_level_number;
+    stage_number = game.current_stage_number;
+    camera_x = game.camera_x;
+    comic_x = game.comic_x;
+    comic_y = game.comic_y;
+    const auto& enemies = game.actors.get_enemies();
+    for (int i = 0; i < MAX_NUM_ENEMIES; ++i) {
+        const bool present = i < enemies.size();
+        enemy_x[i] = present ? enemies.x[i] : 0;
+        enemy_y[i] = present ? enemies.y[i] : 0;
+        enemy_state[i] = present ? enemies.state[i] : ENEMY_STATE_DESPAWNED;
+    }
+    const auto& fireballs = game.actors.get_fireballs();
+    for (size_t i = 0; i < MAX_NUM_FIREBALLS; ++i) {
+        const bool present = i < fireballs.size();
+        fireball_x[i] = present ? fireballs[i].x : FIREBALL_DEAD;
+        fireball_y[i] = present ? fireballs[i].y : FIREBALL_DEAD;
+    }
+    valid = true;
+}
+
+void RenderInterpolator::set_blend(double fraction) {
+    blend = std::clamp(fraction, 0.0, 1.0);
+}
+
+void RenderInterpolator::reset() {
+    valid = false;
+}
+
+bool RenderInterpolator::applies_to(const GameContext& game) const {
+    return enabled && valid && level_number == game.current_level_number &&
+           stage_number == game.current_stage_number;
+}
+
+int RenderInterpolator::offset(int previous, int current, int render_scale) const {
+    const int step = current - previous;
+    if (step == 0 || step > MAX_INTERPOLATED_STEP || step < -MAX_INTERPOLATED_STEP) {
+        return 0;
+    }
+    // Draw at previous + step * blend instead of at current
+    return static_cast<int>(std::lround(-step * (1.0 - blend) * render_scale));
+}
+
+int RenderInterpolator::get_world_shift(const GameContext& game, int render_scale) const {
+    // The world moves the opposite way to the camera
+    return applies_to(game) ? -offset(camera_x, game.camera_x, render_scale) : 0;
+}
+
+int RenderInterpolator::get_comic_offset_x(const GameContext& game, int render_scale) const {
+    return applies_to(game) ? offset(comic_x, game.comic_x, render_scale) : 0;
+}
+
+int RenderInterpolator::get_comic_offset_y(const GameContext& game, int render_scale) const {
+    return applies_to(game) ? offset(comic_y, game.comic_y, render_scale) : 0;
+}
+
+void RenderInterpolator::get_actor_offsets(const GameContext& game, int render_scale,
+                                           ActorRenderOffsets* offsets) const {
+    *offsets = ActorRenderOffsets();
+    if (!applies_to(game)) {
+        return;
+    }
+    const auto& enemies = game.actors.get_enemies();
+    for (int i = 0; i < MAX_NUM_ENEMIES && i < enemies.size(); ++i) {
+        // Only enemies that were already out and moving; spawns and deaths snap
+        if (enemy_state[i] != ENEMY_STATE_SPAWNED || enemies.state[i] != ENEMY_STATE_SPAWNED) {
+            continue;
+        }
+        offsets->enemy_dx[i] = offset(enemy_x[i], enemies.x[i], render_scale);
+        offsets->enemy_dy[i] = offset(enemy_y[i], enemies.y[i], render_scale);
+    }
+    const auto& fireballs = game.actors.get_fireballs();
+    for (size_t i = 0; i < MAX_NUM_FIREBALLS && i < fireballs.size(); ++i) {
+        if (fireball_x[i] == FIREBALL_DEAD || fireballs[i].x == FIREBALL_DEAD) {
+            continue;
+        }
+        offsets->fireball_dx[i] = offset(fireball_x[i], fireballs[i].x, render_scale);
+        offsets->fireball_dy[i] = offset(fireball_y[i], fireballs[i].y, render_scale);
+    }
+}
+
+bool SceneView::operator==(const SceneView& other) const {
+    return game == other.game && animation == other.animation && animation_frame == other.animation_frame &&
+           hud_frame == other.hud_frame && paused == other.paused;
+}
+
+SceneChangeTracker::SceneChangeTracker() : enabled(false), stale(true), drawn() {}
+
+void SceneChangeTracker::set_enabled(bool enable) {
+    enabled = enable;
+    stale = true;
+}
+
+bool SceneChangeTracker::needs_frame(const SceneView& view) {
+    if (!enabled) {
+        return true;
+    }
+    if (!stale && view == drawn) {
+        count_event(Counter::FRAMES_UNCHANGED);
+        return false;
+    }
+    stale = false;
+    drawn = view;
+    return true;
+}
+
+double SceneChangeTracker::idle_ms(double ms_to_tick, uint32_t animation_deadline, uint32_t now_ms,
+                                   double max_ms) {
+    double wait_ms = std::min(ms_to_tick, max_ms);
+    if (animation_deadline != 0) {
+        // Signed, so a deadline already passed comes out as no wait
+        const int32_t ms_to_frame = static_cast<int32_t>(animation_deadline - now_ms);
+        wait_ms = std::min(wait_ms, static_cast<double>(ms_to_frame));
+    }
+    return std::max(0.0, wait_ms);
+}
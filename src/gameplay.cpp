@@ -0,0 +1,544 @@
+/**
+ * gameplay.cpp - One game tick of a GameContext
+ *
+ * The per-tick game loop (physics, doors, teleport, actors and the
+ * start-of-game counters) and the input/checksum helpers shared by the
+ * windowed game, the headless modes and the batch runner.
+ */
+
+#include "../include/gameplay.h"
+#include "../include/audio.h"
+#include "../include/doors.h"
+#include "../include/level_loader.h"
+#include "../include/physics.h"
+#include "../include/player_teleport.h"
+#include "../include/replay.h"
+#include "../include/sequencer.h"
+#include <algorithm>
+#include <iostream>
+
+void process_door_input(GameContext& game) {
+    // Edge-triggered door activation: only trigger on rising edge of open key
+    // This prevents the door from immediately re-triggering when entering a new stage
+    // (since load_new_stage positions Comic at the reciprocal door location)
+    if (game.comic_is_falling_or_jumping == 0 &&
+        game.key_state_open && !game.previous_key_state_open) {
+        check_door_activation(game);
+    }
+    
+    game.previous_key_state_open = game.key_state_open;
+}
+
+void clear_gameplay_key_states(GameContext& game) {
+    game.key_state_jump = 0;
+    game.previous_key_state_jump = 0;
+    game.key_state_left = 0;
+    game.key_state_right = 0;
+    game.key_state_open = 0;
+    game.previous_key_state_open = 0;
+    game.key_state_fire = 0;
+    game.key_state_teleport = 0;
+    game.previous_key_state_teleport = 0;
+    game.key_states_cleared = true;
+}
+
+void begin_teleport(GameContext& game) {
+    constexpr uint8_t TELEPORT_DISTANCE = 6;
+
+    uint8_t dest_x = static_cast<uint8_t>(game.comic_x);
+    uint8_t dest_y = static_cast<uint8_t>(game.comic_y);
+    const int camera_rel_x = static_cast<int>(game.comic_x) - game.camera_x;
+
+    game.teleport_camera_counter = 0;
+
+    if (game.comic_facing == COMIC_FACING_LEFT) {
+        game.teleport_camera_vel = -1;
+
+        if (camera_rel_x >= TELEPORT_DISTANCE) {
+            dest_x = static_cast<uint8_t>(dest_x - TELEPORT_DISTANCE);
+
+            const int dest_camera_rel = camera_rel_x - TELEPORT_DISTANCE;
+            if (dest_camera_rel < (PLAYFIELD_WIDTH / 2 - 2)) {
+                const int camera_movement = (PLAYFIELD_WIDTH / 2 - 2) - dest_camera_rel;
+                game.teleport_camera_counter = static_cast<uint8_t>(
+                    std::min(game.camera_x, camera_movement));
+            }
+        }
+    } else {
+        game.teleport_camera_vel = 1;
+
+        if (camera_rel_x < (PLAYFIELD_WIDTH - TELEPORT_DISTANCE - 1)) {
+            dest_x = static_cast<uint8_t>(dest_x + TELEPORT_DISTANCE);
+
+            const int dest_camera_rel = camera_rel_x + TELEPORT_DISTANCE;
+            if (dest_camera_rel > (PLAYFIELD_WIDTH / 2)) {
+                const int max_camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
+                const int camera_movement = dest_camera_rel - (PLAYFIELD_WIDTH / 2);
+                if (game.camera_x + camera_movement <= max_camera_x) {
+                    game.teleport_camera_counter = static_cast<uint8_t>(camera_movement);
+                } else {
+                    game.teleport_camera_counter = static_cast<uint8_t>(max_camera_x - game.camera_x);
+                }
+            }
+        }
+    }
+
+    // Round destination to an even tile boundary and search down the column
+    // for a solid tile with two empty tiles above (safe landing).
+    dest_x &= 0xFE;
+
+    bool solid_found = false;
+    uint8_t search_y = static_cast<uint8_t>(PLAYFIELD_HEIGHT - 2);
+
+    while (search_y > 0 && !solid_found) {
+        if (is_tile_solid(game, get_tile_at(game, dest_x, search_y))) {
+            uint8_t nonsolid_count = 0;
+            uint8_t probe_y = search_y;
+
+            while (probe_y > 0) {
+                probe_y = static_cast<uint8_t>(probe_y - 2);
+
+                if (is_tile_solid(game, get_tile_at(game, dest_x, probe_y))) {
+                    break;
+                }
+
+                nonsolid_count++;
+                if (nonsolid_count >= 2) {
+                    dest_y = probe_y;
+                    solid_found = true;
+                    break;
+                }
+            }
+        }
+
+        if (!solid_found) {
+            search_y = static_cast<uint8_t>(search_y - 2);
+        }
+    }
+
+    if (!solid_found) {
+        dest_x = static_cast<uint8_t>(game.comic_x);
+        dest_y = static_cast<uint8_t>(game.comic_y);
+        game.teleport_camera_counter = 0;
+    }
+
+    game.teleport_animation = 0;
+    game.teleport_source_x = static_cast<uint8_t>(game.comic_x);
+    game.teleport_source_y = static_cast<uint8_t>(game.comic_y);
+    game.teleport_destination_x = dest_x;
+    game.teleport_destination_y = dest_y;
+    game.comic_is_teleporting = true;
+    game.teleport_skip_tick = true;
+
+    play_game_sound(GameSound::TELEPORT);
+}
+
+void process_teleport_input(GameContext& game, bool comic_has_teleport_wand) {
+    if (game.key_state_teleport && !game.previous_key_state_teleport && comic_has_teleport_wand) {
+        begin_teleport(game);
+    }
+
+    game.previous_key_state_teleport = game.key_state_teleport;
+}
+
+void handle_teleport_tick(GameContext& game) {
+    if (!game.comic_is_teleporting) {
+        return;
+    }
+
+    if (game.teleport_skip_tick) {
+        game.teleport_skip_tick = false;
+        return;
+    }
+
+    if (game.teleport_camera_counter > 0) {
+        const int max_camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
+        const int moved_camera_x = game.camera_x + game.teleport_camera_vel;
+        game.camera_x = std::max(0, std::min(moved_camera_x, max_camera_x));
+        game.teleport_camera_counter--;
+    }
+
+    game.teleport_animation++;
+
+    apply_teleport_destination_if_ready(
+        game.teleport_animation,
+        game.teleport_destination_x,
+        game.teleport_destination_y,
+        game.comic_x,
+        game.comic_y);
+
+    if (game.teleport_animation >= 6) {
+        game.comic_is_teleporting = false;
+    }
+}
+
+void sync_stage_enemies(GameContext& game) {
+    if (game.enemy_level_number == game.current_level_number &&
+        game.enemy_stage_number == game.current_stage_number) {
+        return;
+    }
+    game.enemy_level_number = game.current_level_number;
+    game.enemy_stage_number = game.current_stage_number;
+    if (game.current_level_ptr) {
+        game.actors.setup_enemies_for_stage(game.current_level_ptr, game.current_level_number, game.current_stage_number,
+                                            game.graphics);
+    }
+}
+
+// Tiles the actors move in: the stage's own map, or a streamed stage's window
+static const uint8_t* actor_tiles(const GameContext& game) {
+    if (game.tile_map) {
+        return game.current_tiles();
+    }
+    return game.current_level_ptr ? game.current_level_ptr->stages[game.current_stage_number].tiles.data : nullptr;
+}
+
+TickOutcome run_gameplay_tick(GameContext& game) {
+    ActorSystem& actor_system = game.actors;
+    sync_stage_enemies(game);
+
+    // Per-tick movement result must be cleared before any early-continue
+    // branches (death, door anim, teleport) to avoid stale run state.
+    game.player_moved_last_tick = false;
+
+    // Phase 5: advance run cycle unconditionally every tick before any
+    // early-return branches, matching assembly .tick behavior.
+    // Derive modulus from the actual run animation frame count so the
+    // counter stays consistent if the animation data ever changes.
+    if (game.run_frame_count > 0) {
+        game.comic_run_cycle_frame = (game.comic_run_cycle_frame + 1) % game.run_frame_count;
+    }
+
+    if (is_player_dying(game)) {
+        update_player_death_sequence(game);
+
+        if (game.game_over_triggered) {
+            return TickOutcome::GameOver;
+        }
+        return TickOutcome::Continue;
+    }
+
+    if (game.door_anim_phase != DoorAnimationPhase::NONE) {
+        update_door_animation_tick(game);
+        return TickOutcome::Continue;
+    }
+
+    // Process jump input once per tick (edge-triggered)
+    // Note: Jump input feeds comic_is_falling_or_jumping, so must be before physics
+    process_jump_input(game);
+
+    // Handle ongoing teleport animation (continues to next tick if active)
+    if (game.comic_is_teleporting) {
+        handle_teleport_tick(game);
+
+        actor_system.update(game, game.comic_x, game.comic_y, game.comic_facing, actor_tiles(game), game.camera_x,
+                            game.key_state_fire);
+        return TickOutcome::Continue;
+    }
+
+    // Update jump power from item system (boots affect jump height)
+    game.comic_jump_power = static_cast<uint8_t>(actor_system.get_jump_power());
+
+    // Update physics (once per tick)
+    const uint8_t was_falling_or_jumping = game.comic_is_falling_or_jumping;
+    handle_fall_or_jump(game);
+
+    // Detect landing this tick: was airborne, now grounded
+    // Assembly: on landing, jmp game_loop.check_pause_input skips ALL
+    // left/right movement AND the floor walk-off check for that tick.
+    const bool just_landed = (was_falling_or_jumping != 0) && (game.comic_is_falling_or_jumping == 0);
+    if (just_landed) {
+        game.player_airborne_from_walk_off = false;
+    }
+
+    // If physics transitioned from grounded to airborne using the
+    // no-floor path, suppress jump art for this render frame.
+    if (!was_falling_or_jumping && game.comic_is_falling_or_jumping &&
+        game.comic_jump_counter == 1 && game.comic_y_vel == 8) {
+        game.suppress_jump_animation = true;
+        game.player_airborne_from_walk_off = true;
+    }
+
+    // Ground movement (only when not in air AND did not just land this tick)
+    // Skipping on landing matches assembly: landing jumps past the left/right block
+    if (!game.comic_is_falling_or_jumping && !just_landed) {
+        if (game.key_state_left) {
+            game.player_moved_last_tick |= move_left(game);
+        }
+        if (game.key_state_right) {
+            game.player_moved_last_tick |= move_right(game);
+        }
+
+        // Match original game-loop floor check ordering: after
+        // horizontal movement, detect missing floor and begin
+        // falling immediately (no extra standing tick).
+        if (!game.comic_is_falling_or_jumping) {
+            const uint8_t foot_y = static_cast<uint8_t>(game.comic_y + 4);
+            uint8_t foot_tile = get_tile_at(game, static_cast<uint8_t>(game.comic_x), foot_y);
+            bool foot_solid = is_tile_solid(game, foot_tile);
+
+            if (!foot_solid && (game.comic_x & 1)) {
+                foot_tile = get_tile_at(game, static_cast<uint8_t>(game.comic_x + 1), foot_y);
+                foot_solid = is_tile_solid(game, foot_tile);
+            }
+
+            if (!foot_solid) {
+                game.comic_y_vel = 8;
+
+                if (game.comic_x_momentum > 0) {
+                    game.comic_x_momentum = 2;
+                } else if (game.comic_x_momentum < 0) {
+                    game.comic_x_momentum = -2;
+                } else if (game.key_state_right && !game.key_state_left) {
+                    game.comic_x_momentum = 2;
+                } else if (game.key_state_left && !game.key_state_right) {
+                    game.comic_x_momentum = -2;
+                }
+
+                game.comic_is_falling_or_jumping = 1;
+                game.comic_jump_counter = 1;
+                game.suppress_jump_animation = true;
+                game.player_airborne_from_walk_off = true;
+            }
+        }
+    }
+
+    // A streamed stage's window follows the camera before the actors move in it
+    update_map_window(game);
+    actor_system.update(game, game.comic_x, game.comic_y, game.comic_facing, actor_tiles(game), game.camera_x,
+                        game.key_state_fire);
+
+    // ========== PHASE 2: Door and Teleport Checks (After Physics/Actors) ==========
+    // Assembly order: check doors, then teleports, after physics has resolved position
+    // Process door input once per tick (edge-triggered)
+    // Door activation happens AFTER physics resolves, not before
+    process_door_input(game);
+
+    // Process teleport input once per tick (edge-triggered)
+    // Teleport activation happens AFTER physics resolves, not before
+    if (!game.comic_is_falling_or_jumping && !game.comic_is_teleporting) {
+        process_teleport_input(game, actor_system.comic_has_teleport_wand != 0);
+    } else {
+        game.previous_key_state_teleport = game.key_state_teleport;
+    }
+
+    if (!game.beam_out_sequence_played && actor_system.comic_num_treasures >= 3) {
+        game.beam_out_sequence_played = true;
+        game.win_counter = 20;
+    }
+
+    if (game.beam_out_sequence_played && game.win_counter > 0) {
+        game.win_counter--;
+        if (game.win_counter == 1) {
+            clear_gameplay_key_states(game);
+            return TickOutcome::Victory;
+        }
+    }
+    
+    // Lives count-up sequence: award 5 lives with 1-tick delay between each,
+    // then subtract 1 (the life currently in use)
+    if (!game.lives_sequence_complete) {
+        if (game.lives_sequence_counter > 0) {
+            game.lives_sequence_delay--;
+            if (game.lives_sequence_delay == 0) {
+                // Award a life
+                game.comic_num_lives++;
+                game.lives_sequence_counter--;
+                
+                if (game.lives_sequence_counter > 0) {
+                    // Still more lives to award (wait 1 tick)
+                    game.lives_sequence_delay = 1;
+                } else {
+                    // Awarded all 5, wait 3 ticks then subtract 1
+                    game.lives_sequence_delay = 3;
+                }
+            }
+        } else if (game.lives_sequence_delay > 0) {
+            // Waiting 3 ticks after awarding all 5 lives
+            game.lives_sequence_delay--;
+            if (game.lives_sequence_delay == 0) {
+                // Subtract 1 life (currently in use: 5→4)
+                if (game.comic_num_lives > 0) {
+                    game.comic_num_lives--;
+                }
+                game.lives_sequence_complete = true;
+            }
+        }
+    }
+    
+    // Gradually fill HP from 0 to MAX_HP at game startup
+    // Each tick, increment HP if pending increase is scheduled
+    if (game.comic_hp_pending_increase > 0) {
+        game.comic_hp_pending_increase--;
+        if (game.comic_hp < MAX_HP) {
+            game.comic_hp++;
+        }
+    }
+    
+    // Fireball meter charging is handled by ActorSystem::update()
+    // (charges at 1 unit per 2 ticks when not firing)
+    
+    // Game-over is handled by physics when Comic hits the bottom of playfield
+    // (sound triggered there).  No additional check needed here.
+    return TickOutcome::Continue;
+}
+
+void load_starting_level(GameContext& game) {
+    // Initialize all level data (tile data is compiled-in as hex arrays)
+    initialize_level_data();
+
+    // Load the first playable level (FOREST = level 1, stage 0)
+    // Level numbers: 0=LAKE, 1=FOREST, 2=SPACE, 3=BASE, 4=CAVE, 5=SHED, 6=CASTLE, 7=COMP
+    game.current_level_number = LEVEL_NUMBER_FOREST;  // Forest is the first playable level
+    game.current_stage_number = 0;
+    game.source_door_level_number = -1;  // Not entering via door
+    
+    // Set initial spawn position
+    game.comic_x = 14;
+    game.comic_y = 12;
+    game.comic_y_vel = 0;
+    
+    // Load the level and stage
+    load_new_level(game);
+    
+    if (!game.current_level_ptr) {
+        std::cerr << "Failed to load game level. Falling back to test level." << std::endl;
+        init_test_level(game);  // Fall back to test level if loading fails
+    }
+}
+
+void queue_victory_tally(Sequencer& sequencer, GameContext& game) {
+    // One tally step: the HUD is drawn from the game, so the score shows as it goes up
+    auto queue_tally_step = [&sequencer, &game]() {
+        sequencer.run([&game]() {
+            play_game_sound(GameSound::ITEM_COLLECT);
+            award_points(game, 10);
+        });
+        sequencer.wait_ticks(1);
+    };
+
+    // Base victory bonus: 20,000 points as twenty 1,000-point tally steps.
+    for (int step = 0; step < 20; ++step) {
+        queue_tally_step();
+    }
+
+    // Remaining lives bonus: 10,000 points per life, then decrement one life icon.
+    sequencer.repeat_while([&game]() { return game.comic_num_lives > 0; },
+                           [&sequencer, &game, queue_tally_step]() {
+        for (int step = 0; step < 10; ++step) {
+            queue_tally_step();
+        }
+        sequencer.run([&game]() { game.comic_num_lives--; });
+        sequencer.wait_ticks(3);
+    });
+}
+
+uint8_t current_input_keys(GameContext& game) {
+    uint8_t keys = 0;
+    keys |= game.key_state_left ? INPUT_LEFT : 0;
+    keys |= game.key_state_right ? INPUT_RIGHT : 0;
+    keys |= game.key_state_jump ? INPUT_JUMP : 0;
+    keys |= game.key_state_fire ? INPUT_FIRE : 0;
+    keys |= game.key_state_open ? INPUT_OPEN : 0;
+    keys |= game.key_state_teleport ? INPUT_TELEPORT : 0;
+    if (game.key_states_cleared) {
+        keys |= INPUT_KEYS_CLEARED;
+        game.key_states_cleared = false;
+    }
+    return keys;
+}
+
+void apply_input_keys(GameContext& game, uint8_t keys) {
+    if (keys & INPUT_KEYS_CLEARED) {
+        clear_gameplay_key_states(game);
+    }
+    game.key_state_left = (keys & INPUT_LEFT) ? 1 : 0;
+    game.key_state_right = (keys & INPUT_RIGHT) ? 1 : 0;
+    game.key_state_jump = (keys & INPUT_JUMP) ? 1 : 0;
+    game.key_state_fire = (keys & INPUT_FIRE) ? 1 : 0;
+    game.key_state_open = (keys & INPUT_OPEN) ? 1 : 0;
+    game.key_state_teleport = (keys & INPUT_TELEPORT) ? 1 : 0;
+}
+
+// FNV-1a over the simulated state, in a fixed field order
+uint64_t gameplay_checksum(const GameContext& game) {
+    const ActorSystem& actor_system = game.actors;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](int value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (static_cast<uint32_t>(value) >> (8 * i)) & 0xFF;
+            hash *= 0x100000001b3ull;
+        }
+    };
+    mix(game.current_level_number);
+    mix(game.current_stage_number);
+    mix(game.comic_x);
+    mix(game.comic_y);
+    mix(game.comic_y_vel);
+    mix(game.comic_x_momentum);
+    mix(game.comic_facing);
+    mix(game.comic_is_falling_or_jumping);
+    mix(game.comic_jump_counter);
+    mix(game.camera_x);
+    if (game.tile_map) {
+        mix(game.map_origin_x);  // Built-in stages keep their checksums
+    }
+    mix(game.comic_hp);
+    mix(game.comic_num_lives);
+    mix(game.score_bytes[0] | (game.score_bytes[1] << 8) | (game.score_bytes[2] << 16));
+    mix(actor_system.comic_num_treasures);
+    mix(actor_system.comic_firepower);
+    mix(actor_system.fireball_meter);
+    const EnemyPool& enemies = actor_system.get_enemies();
+    for (int i = 0; i < enemies.size(); i++) {
+        mix(enemies.x[i] | (enemies.y[i] << 8) | (enemies.state[i] << 16) | (enemies.behavior[i] << 24));
+        mix(enemies.spawn_timer_and_animation[i]);
+    }
+    for (const fireball_t& fireball : actor_system.get_fireballs()) {
+        mix(fireball.x | (fireball.y << 8));
+    }
+    return hash;
+}
+
+uint64_t scene_signature(const GameContext& game) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](int value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (static_cast<uint32_t>(value) >> (8 * i)) & 0xFF;
+            hash *= 0x100000001b3ull;
+        }
+    };
+    const ActorSystem& actor_system = game.actors;
+    // Stage and camera
+    mix(game.current_level_number | (game.current_stage_number << 8));
+    mix(static_cast<int>(game.stage_tiles_revision));
+    mix(game.map_origin_x);
+    mix(game.camera_x);
+    // Comic (the animation frame is the renderer's; see SceneChangeTracker)
+    mix(game.comic_x);
+    mix(game.comic_y);
+    mix(game.comic_facing | (game.comic_is_falling_or_jumping << 8) | (game.player_moved_last_tick << 16) |
+        (game.player_airborne_from_walk_off << 24));
+    mix(game.comic_run_cycle_frame);
+    mix(game.player_is_dying | (game.player_death_show_animation << 8) |
+        (game.player_death_fall_clip_render << 16));
+    // HUD
+    mix(game.score_bytes[0] | (game.score_bytes[1] << 8) | (game.score_bytes[2] << 16));
+    mix(game.comic_num_lives | (game.comic_hp << 8) | (game.comic_has_door_key << 16));
+    mix(actor_system.fireball_meter | (actor_system.comic_firepower << 8) |
+        (actor_system.comic_has_corkscrew << 16) | (actor_system.comic_has_boots << 24));
+    mix(actor_system.comic_has_teleport_wand | (actor_system.comic_has_lantern << 8) |
+        (actor_system.comic_has_gems << 16) | (actor_system.comic_has_crown << 24));
+    mix(actor_system.comic_has_gold);
+    // Doors and teleport
+    mix(static_cast<int>(game.door_anim_phase) | (game.door_anim_frame << 8) | (game.door_anim_world_x << 16) |
+        (game.door_anim_world_y << 24));
+    mix(game.comic_is_teleporting | (game.teleport_animation << 8));
+    mix(game.teleport_source_x | (game.teleport_source_y << 8) | (game.teleport_destination_x << 16) |
+        (game.teleport_destination_y << 24));
+    // Enemies, fireballs and the item
+    const uint64_t actors = actor_system.get_render_signature(game.camera_x);
+    mix(static_cast<int>(actors));
+    mix(static_cast<int>(actors >> 32));
+    return hash;
+}
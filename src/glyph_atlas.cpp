@@ -0,0 +1,300 @@
+#include "../include/glyph_atlas.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+GlyphAtlas::GlyphAtlas()
+    : renderer(nullptr),
+      texture(nullptr),
+      height(0),
+      line_skip(0)
+{
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    cleanup();
+}
+
+void GlyphAtlas::cleanup() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    renderer = nullptr;
+    height = 0;
+    line_skip = 0;
+    for (Glyph& glyph : glyphs) {
+        glyph = Glyph();
+    }
+    vertices.clear();
+    indices.clear();
+}
+
+bool GlyphAtlas::build(SDL_Renderer* target_renderer, TTF_Font* font, bool solid) {
+    cleanup();
+    if (target_renderer == nullptr || font == nullptr) {
+        return false;
+    }
+
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* glyph_surfaces[GLYPH_ATLAS_CHAR_COUNT] = {};
+
+    // Shelf-pack the glyphs left to right in rows of GLYPH_ATLAS_WIDTH.
+    int pen_x = 0;
+    int pen_y = 0;
+    int row_height = 0;
+    for (int i = 0; i < GLYPH_ATLAS_CHAR_COUNT; ++i) {
+        const Uint16 ch = static_cast<Uint16>(GLYPH_ATLAS_FIRST_CHAR + i);
+        int min_x = 0, max_x = 0, min_y = 0, max_y = 0, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &min_x, &max_x, &min_y, &max_y, &advance) == 0) {
+            glyphs[i].advance = advance;
+        }
+
+        SDL_Surface* surface = solid ? TTF_RenderGlyph_Solid(font, ch, white)
+                                     : TTF_RenderGlyph_Blended(font, ch, white);
+        if (surface == nullptr) {
+            // Blank glyphs (e.g. space) may not render; they still advance.
+            continue;
+        }
+        glyph_surfaces[i] = surface;
+
+        if (pen_x + surface->w > GLYPH_ATLAS_WIDTH) {
+            pen_x = 0;
+            pen_y += row_height;
+            row_height = 0;
+        }
+        glyphs[i].src = {pen_x, pen_y, surface->w, surface->h};
+        pen_x += surface->w;
+        row_height = std::max(row_height, surface->h);
+    }
+
+    const int atlas_height = std::max(1, pen_y + row_height);
+    SDL_Surface* atlas_surface = SDL_CreateRGBSurfaceWithFormat(
+        0, GLYPH_ATLAS_WIDTH, atlas_height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas_surface == nullptr) {
+        std::cerr << "Failed to create glyph atlas surface: " << SDL_GetError() << std::endl;
+        for (SDL_Surface* surface : glyph_surfaces) {
+            if (surface) SDL_FreeSurface(surface);
+        }
+        return false;
+    }
+    SDL_FillRect(atlas_surface, nullptr, SDL_MapRGBA(atlas_surface->format, 0, 0, 0, 0));
+
+    for (int i = 0; i < GLYPH_ATLAS_CHAR_COUNT; ++i) {
+        SDL_Surface* surface = glyph_surfaces[i];
+        if (surface == nullptr) {
+            continue;
+        }
+        // Copy coverage as-is rather than blending it onto the cleared atlas
+        // (a solid glyph's background is its colour key, so it stays clear).
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+        SDL_Rect dst = glyphs[i].src;
+        SDL_BlitSurface(surface, nullptr, atlas_surface, &dst);
+        SDL_FreeSurface(surface);
+    }
+
+    texture = SDL_CreateTextureFromSurface(target_renderer, atlas_surface);
+    SDL_FreeSurface(atlas_surface);
+    if (texture == nullptr) {
+        std::cerr << "Failed to create glyph atlas texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    renderer = target_renderer;
+    height = TTF_FontHeight(font);
+    line_skip = TTF_FontLineSkip(font);
+    return true;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::glyph_for(char c) const {
+    const int code = static_cast<unsigned char>(c);
+    if (code < GLYPH_ATLAS_FIRST_CHAR || code > GLYPH_ATLAS_LAST_CHAR) {
+        return glyphs['?' - GLYPH_ATLAS_FIRST_CHAR];
+    }
+    return glyphs[code - GLYPH_ATLAS_FIRST_CHAR];
+}
+
+int GlyphAtlas::measure_text(const char* text) const {
+    int width = 0;
+    for (const char* p = text; p && *p; ++p) {
+        width += glyph_for(*p).advance;
+    }
+    return width;
+}
+
+void GlyphAtlas::wrap_text(const std::string& text, int max_width,
+                           std::vector<std::string>& rows) const {
+    size_t line_start = 0;
+    while (line_start <= text.size()) {
+        size_t line_end = text.find('\n', line_start);
+        if (line_end == std::string::npos) {
+            line_end = text.size();
+        }
+        if (line_end == line_start) {
+            rows.push_back(std::string());
+        }
+
+        size_t row_start = line_start;
+        while (row_start < line_end) {
+            // Greedy fill, remembering the last space to break the row at.
+            size_t last_space = std::string::npos;
+            int row_width = 0;
+            size_t i = row_start;
+            while (i < line_end) {
+                const int advance = glyph_for(text[i]).advance;
+                if (text[i] == ' ') {
+                    last_space = i;
+                }
+                if (max_width > 0 && row_width + advance > max_width && i > row_start) {
+                    break;
+                }
+                row_width += advance;
+                ++i;
+            }
+
+            if (i >= line_end) {
+                rows.push_back(text.substr(row_start, line_end - row_start));
+                break;
+            }
+            if (last_space != std::string::npos && last_space > row_start) {
+                // The row ends at the first of the spaces before the break
+                size_t row_end = last_space;
+                while (row_end > row_start && text[row_end - 1] == ' ') {
+                    --row_end;
+                }
+                rows.push_back(text.substr(row_start, row_end - row_start));
+                row_start = last_space + 1;
+            } else {
+                rows.push_back(text.substr(row_start, i - row_start));
+                row_start = i;
+            }
+            while (row_start < line_end && text[row_start] == ' ') {
+                ++row_start;
+            }
+        }
+
+        line_start = line_end + 1;
+    }
+}
+
+void GlyphAtlas::render_text(int x, int y, const char* text, SDL_Color color) {
+    if (texture == nullptr || text == nullptr) {
+        return;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    int tex_w = 0;
+    int tex_h = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &tex_w, &tex_h);
+    if (tex_w <= 0 || tex_h <= 0) {
+        return;
+    }
+
+    vertices.clear();
+    indices.clear();
+    int pen_x = x;
+    for (const char* p = text; *p; ++p) {
+        const Glyph& glyph = glyph_for(*p);
+        if (glyph.src.w > 0 && glyph.src.h > 0) {
+            const float u0 = static_cast<float>(glyph.src.x) / tex_w;
+            const float v0 = static_cast<float>(glyph.src.y) / tex_h;
+            const float u1 = static_cast<float>(glyph.src.x + glyph.src.w) / tex_w;
+            const float v1 = static_cast<float>(glyph.src.y + glyph.src.h) / tex_h;
+            const float x0 = static_cast<float>(pen_x);
+            const float y0 = static_cast<float>(y);
+            const float x1 = static_cast<float>(pen_x + glyph.src.w);
+            const float y1 = static_cast<float>(y + glyph.src.h);
+
+            const int base = static_cast<int>(vertices.size());
+            vertices.push_back({{x0, y0}, color, {u0, v0}});
+            vertices.push_back({{x1, y0}, color, {u1, v0}});
+            vertices.push_back({{x1, y1}, color, {u1, v1}});
+            vertices.push_back({{x0, y1}, color, {u0, v1}});
+
+            const int quad_indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            indices.insert(indices.end(), quad_indices, quad_indices + 6);
+        }
+        pen_x += glyph.advance;
+    }
+
+    if (!vertices.empty()) {
+        SDL_RenderGeometry(renderer, texture,
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+#else
+    // No geometry API before SDL 2.0.18: tint the atlas and copy glyph by glyph.
+    SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(texture, color.a);
+    int pen_x = x;
+    for (const char* p = text; *p; ++p) {
+        const Glyph& glyph = glyph_for(*p);
+        if (glyph.src.w > 0 && glyph.src.h > 0) {
+            SDL_Rect dst = {pen_x, y, glyph.src.w, glyph.src.h};
+            SDL_RenderCopy(renderer, texture, &glyph.src, &dst);
+        }
+        pen_x += glyph.advance;
+    }
+#endif
+}
+
+// ============================================================================
+// SHARED ATLASES
+// ============================================================================
+
+static std::map<std::string, std::unique_ptr<GlyphAtlas>>& glyph_atlas_registry() {
+    static std::map<std::string, std::unique_ptr<GlyphAtlas>> registry;
+    return registry;
+}
+
+static std::string glyph_atlas_key(SDL_Renderer* renderer, TTF_Font* font, bool solid) {
+    const char* family = TTF_FontFaceFamilyName(font);
+    const char* style = TTF_FontFaceStyleName(font);
+
+    std::ostringstream key;
+    key << static_cast<const void*>(renderer) << '|'
+        << (family ? family : "") << '|'
+        << (style ? style : "") << '|'
+        << TTF_FontHeight(font) << '|'
+        << TTF_FontAscent(font) << '|'
+        << TTF_GetFontStyle(font) << '|'
+        << TTF_GetFontOutline(font) << '|'
+        << solid;
+    return key.str();
+}
+
+GlyphAtlas* acquire_glyph_atlas(SDL_Renderer* renderer, TTF_Font* font, bool solid) {
+    if (renderer == nullptr || font == nullptr) {
+        return nullptr;
+    }
+
+    auto& registry = glyph_atlas_registry();
+    const std::string key = glyph_atlas_key(renderer, font, solid);
+    auto it = registry.find(key);
+    if (it != registry.end()) {
+        return it->second.get();
+    }
+
+    std::unique_ptr<GlyphAtlas> atlas(new GlyphAtlas());
+    if (!atlas->build(renderer, font, solid)) {
+        return nullptr;
+    }
+
+    GlyphAtlas* result = atlas.get();
+    registry[key] = std::move(atlas);
+    return result;
+}
+
+void release_glyph_atlases(SDL_Renderer* renderer) {
+    auto& registry = glyph_atlas_registry();
+    for (auto it = registry.begin(); it != registry.end();) {
+        if (it->second->get_renderer() == renderer) {
+            it = registry.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -1,31 +1,35 @@
 #include "../include/graphics.h"
+#include "../include/game_context.h"
 #include "../include/cheats.h"
+#include "../include/counters.h"
 #include "../include/physics.h"
 #include "../include/level.h"
+#include "../include/profiler.h"
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <unordered_set>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
-
-// External game state (defined in main.cpp)
-extern int comic_x;
-extern int comic_y;
-extern int8_t comic_y_vel;
-extern int8_t comic_x_momentum;
-extern uint8_t comic_facing;
-extern uint8_t current_level_number;
-extern uint8_t current_stage_number;
-extern int camera_x;
+#include <cmath>
+#include <mutex>
 
 // Global graphics system
 GraphicsSystem* g_graphics = nullptr;
 
-GraphicsSystem::GraphicsSystem(SDL_Renderer* renderer) : renderer(renderer), img_inited(false), ttf_inited(false), debug_font(nullptr) {}
+GraphicsSystem::GraphicsSystem(SDL_Renderer* renderer)
+    : renderer(renderer), img_inited(false), ttf_inited(false), debug_font(nullptr),
+      debug_atlas(nullptr),
+      texture_budget(0), use_clock(0), pin_generation(1), enemy_sprite_evictions(0),
+      stage_chunk_clock(0), stage_background_tileset(nullptr),
+      stage_background_unsupported(false), current_layer(RenderLayer::ENEMIES),
+      batching(false), native_frame(nullptr),
+      native_frame_bound(false), frame_target(nullptr), last_render_texture(nullptr), world_offset_x(0) {}
 
 GraphicsSystem::~GraphicsSystem() {
     cleanup();
@@ -78,9 +82,39 @@ bool GraphicsSystem::initialize() {
         }
     }
     
+    // A single memory-mapped pack replaces per-file path probing when present
+    static const char* const pack_candidates[] = {
+        "assets/assets.pak", "../assets/assets.pak", "../../assets/assets.pak"
+    };
+    for (const char* pack_path : pack_candidates) {
+        if (asset_pack.open(pack_path)) {
+            std::cout << "Using asset pack " << pack_path << " ("
+                      << asset_pack.get_entry_count() << " entries)" << std::endl;
+            break;
+        }
+    }
+    
+    // The original game files, when present, are decoded directly
+    static const char* const original_candidates[] = {
+        "original", "../original", "../../original"
+    };
+    for (const char* original_dir : original_candidates) {
+        if (original_assets.open(original_dir)) {
+            std::cout << "Reading original game files from " << original_dir << std::endl;
+            break;
+        }
+    }
+    
     if (debug_font == nullptr) {
         std::cerr << "Warning: Could not load debug font, debug overlay will not display coordinates" << std::endl;
         std::cerr << "  Tried: Menlo, Courier, DejaVuSansMono, LiberationMono, and others" << std::endl;
+    } else {
+        // Bake the glyphs once so overlay text never allocates per frame;
+        // solid, as the overlay has always been drawn.
+        debug_atlas = acquire_glyph_atlas(renderer, debug_font, true);
+        if (debug_atlas == nullptr) {
+            std::cerr << "Warning: Could not build debug font atlas, debug overlay text disabled" << std::endl;
+        }
     }
     
     return true;
@@ -146,8 +180,9 @@ std::string GraphicsSystem::get_asset_path(const std::string& filename) {
     return std::string("assets/") + filename;
 }
 
-TextureInfo GraphicsSystem::load_png(const std::string& filepath) {
-    TextureInfo info = {nullptr, 0, 0};
+SDL_Surface* GraphicsSystem::load_surface(const std::string& filepath) {
+    // Called from decode workers as well as the render thread
+    static std::mutex logged_load_failures_mutex;
     static std::unordered_set<std::string> logged_load_failures;
     
     // Try multiple possible paths
@@ -157,16 +192,16 @@ TextureInfo GraphicsSystem::load_png(const std::string& filepath) {
         "../../" + filepath
     };
     
-    SDL_Surface* surface = nullptr;
-    
     for (const auto& path : possible_paths) {
         // Check if file exists
         std::ifstream f(path);
         if (f.good()) {
-            surface = IMG_Load(path.c_str());
+            SDL_Surface* surface = IMG_Load(path.c_str());
             if (surface) {
-                break;
+                count_decoded_image(surface->pitch, surface->h);
+                return surface;
             }
+            std::lock_guard<std::mutex> lock(logged_load_failures_mutex);
             if (logged_load_failures.insert(path).second) {
                 std::cerr << "Warning: Failed to load PNG: " << path
                           << " (" << IMG_GetError() << ")" << std::endl;
@@ -174,8 +209,46 @@ TextureInfo GraphicsSystem::load_png(const std::string& filepath) {
         }
     }
     
+    // Silently return null - caller will handle missing assets
+    return nullptr;
+}
+
+SDL_Surface* GraphicsSystem::load_asset_surface(const std::string& filename) {
+    // Names the extractor derives from original files map back to them:
+    // "{level}.tt2-{hex index}.png" and "{name}.ega.png"
+    if (original_assets.is_open()) {
+        const size_t tt2 = filename.find(".tt2-");
+        if (tt2 != std::string::npos && original_assets.has_file(filename.substr(0, tt2 + 4))) {
+            const int tile_index = static_cast<int>(std::strtol(filename.c_str() + tt2 + 5, nullptr, 16));
+            return original_assets.load_tile(filename.substr(0, tt2), tile_index);
+        }
+        const std::string png = ".png";
+        if (filename.size() > png.size() &&
+            filename.compare(filename.size() - png.size(), png.size(), png) == 0) {
+            const std::string stem = filename.substr(0, filename.size() - png.size());
+            if (stem.size() > 4 && stem.compare(stem.size() - 4, 4, ".ega") == 0 &&
+                original_assets.has_file(stem)) {
+                return original_assets.load_fullscreen(stem);
+            }
+        }
+    }
+    
+    // The pack is authoritative when present: a name it lacks is missing, and
+    // no loose-file paths are probed for it.
+    if (asset_pack.is_open()) {
+        return asset_pack.load_surface(filename);
+    }
+    return load_surface(get_asset_path(filename));
+}
+
+TextureInfo GraphicsSystem::load_png(const std::string& filename) {
+    return upload_surface(load_asset_surface(filename));
+}
+
+// Upload a decoded image and free the surface
+TextureInfo GraphicsSystem::upload_surface(SDL_Surface* surface) {
+    TextureInfo info = {nullptr, 0, 0};
     if (surface == nullptr) {
-        // Silently return null texture - caller will handle missing assets
         return info;
     }
     
@@ -185,6 +258,7 @@ TextureInfo GraphicsSystem::load_png(const std::string& filepath) {
         SDL_FreeSurface(surface);
         return info;
     }
+    count_event(Counter::TEXTURES_CREATED);
     
     info.width = surface->w;
     info.height = surface->h;
@@ -193,15 +267,13 @@ TextureInfo GraphicsSystem::load_png(const std::string& filepath) {
     return info;
 }
 
-std::vector<uint8_t> build_enemy_animation_sequence(
+EnemyAnimationSequence build_enemy_animation_sequence(
     uint8_t num_distinct_frames,
     uint8_t animation_type) {
-    std::vector<uint8_t> sequence;
-    if (num_distinct_frames == 0) {
-        return sequence;
-    }
+    EnemyAnimationSequence sequence;
+    num_distinct_frames = static_cast<uint8_t>(
+        std::min(static_cast<size_t>(num_distinct_frames), MAX_ENEMY_ANIMATION_FRAMES));
 
-    sequence.reserve(static_cast<size_t>(num_distinct_frames) * 2);
     for (uint8_t i = 0; i < num_distinct_frames; ++i) {
         sequence.push_back(i);
     }
@@ -215,26 +287,73 @@ std::vector<uint8_t> build_enemy_animation_sequence(
     return sequence;
 }
 
-std::vector<TextureInfo> GraphicsSystem::load_animation_frames(
+std::vector<DecodeTicket> GraphicsSystem::queue_animation_frames(
     const std::string& base_path,
     int expected_frames,
-    const std::string& label) {
-    std::vector<TextureInfo> frames;
-    if (renderer == nullptr) {
-        std::cerr << "Warning: Renderer unavailable; cannot load animation: " << label << std::endl;
-        return frames;
+    bool urgent) {
+    std::vector<DecodeTicket> tickets;
+    if (expected_frames <= 0) {
+        return tickets;
     }
 
-    if (expected_frames <= 0) {
-        return frames;
+    AssetDecodePool& pool = get_decode_pool();
+    tickets.reserve(static_cast<size_t>(expected_frames));
+    for (int i = 0; i < expected_frames; ++i) {
+        const std::string filename = base_path + "-" + std::to_string(i) + ".png";
+        tickets.push_back(pool.enqueue([this, filename]() -> SDL_Surface* {
+            if (asset_pack.is_open()) {
+                return asset_pack.load_surface(filename);
+            }
+
+            // Try multiple asset directory prefixes.  enemy frames live under assets/shp, so
+            // include that directory first.  We keep the generic locations as fallback.
+            static const std::string prefixes[] = {
+                "assets/shp/", "../assets/shp/", "../../assets/shp/",
+                "assets/", "../assets/", "../../assets/"
+            };
+
+            for (const auto& prefix : prefixes) {
+                std::string path = prefix + filename;
+                std::ifstream f(path);
+                if (!f.good()) {
+                    continue;
+                }
+                SDL_Surface* surface = IMG_Load(path.c_str());
+                if (surface != nullptr) {
+                    count_decoded_image(surface->pitch, surface->h);
+                    return surface;
+                }
+                std::cerr << "Warning: Failed to load animation frame: " << path
+                          << " (" << IMG_GetError() << ")" << std::endl;
+            }
+            return nullptr;
+        }, urgent));
     }
+    return tickets;
+}
 
-    // Try multiple asset directory prefixes.  enemy frames live under assets/shp, so
-    // include that directory first.  We keep the generic locations as fallback.
-    static const std::string prefixes[] = {
-        "assets/shp/", "../assets/shp/", "../../assets/shp/",
-        "assets/", "../assets/", "../../assets/"
-    };
+std::vector<DecodeTicket> GraphicsSystem::queue_shp_frames(
+    const std::string& shp_name,
+    int first_frame,
+    int count,
+    bool urgent) {
+    std::vector<DecodeTicket> tickets;
+    AssetDecodePool& pool = get_decode_pool();
+    tickets.reserve(static_cast<size_t>(std::max(count, 0)));
+    for (int i = 0; i < count; ++i) {
+        const int frame = first_frame + i;
+        tickets.push_back(pool.enqueue([this, shp_name, frame]() {
+            return original_assets.load_shp_frame(shp_name, frame);
+        }, urgent));
+    }
+    return tickets;
+}
+
+std::vector<TextureInfo> GraphicsSystem::upload_animation_frames(
+    const std::string& base_path,
+    std::vector<DecodeTicket>& tickets,
+    const std::string& label) {
+    std::vector<TextureInfo> frames;
 
     auto cleanup_frames = [](std::vector<TextureInfo>& f) {
         for (auto& info : f) {
@@ -245,29 +364,17 @@ std::vector<TextureInfo> GraphicsSystem::load_animation_frames(
         f.clear();
     };
 
-    for (int i = 0; i < expected_frames; ++i) {
-        std::string filename = base_path + "-" + std::to_string(i) + ".png";
-        SDL_Surface* surface = nullptr;
-
-        for (const auto& prefix : prefixes) {
-            std::string path = prefix + filename;
-            std::ifstream f(path);
-            if (!f.good()) {
-                continue;
-            }
-            surface = IMG_Load(path.c_str());
-            if (surface != nullptr) {
-                break;
-            }
-            std::cerr << "Warning: Failed to load animation frame: " << path
-                      << " (" << IMG_GetError() << ")" << std::endl;
-        }
+    AssetDecodePool& pool = get_decode_pool();
+    for (size_t i = 0; i < tickets.size(); ++i) {
+        pool.wait(tickets[i]);
+        SDL_Surface* surface = tickets[i]->take_surface();
 
         if (surface == nullptr) {
             std::cerr << "Error: Could not find frame " << i
-                      << " for '" << label << "' (tried " << filename << ")" << std::endl;
+                      << " for '" << label << "' (tried " << base_path << "-" << i
+                      << ".png)" << std::endl;
             cleanup_frames(frames);
-            return frames;
+            break;
         }
 
         int w = surface->w;
@@ -279,47 +386,364 @@ std::vector<TextureInfo> GraphicsSystem::load_animation_frames(
             std::cerr << "Error: Failed to create animation texture for '" << label
                       << "' frame " << i << ": " << SDL_GetError() << std::endl;
             cleanup_frames(frames);
-            return frames;
+            break;
         }
+        count_event(Counter::TEXTURES_CREATED);
 
         frames.push_back({texture, w, h});
     }
 
+    tickets.clear();
     return frames;
 }
 
-bool GraphicsSystem::load_tileset(const std::string& level_name) {
-    if (tilesets.find(level_name) != tilesets.end()) {
+AssetDecodePool& GraphicsSystem::get_decode_pool() {
+    if (!decode_pool) {
+        decode_pool.reset(new AssetDecodePool(AssetDecodePool::default_worker_count()));
+    }
+    return *decode_pool;
+}
+
+void GraphicsSystem::pump_asset_uploads(int max_uploads) {
+    // Blocking loads since the last frame may have gone over budget too
+    enforce_texture_budget();
+    if (pending_tilesets.empty() && pending_enemy_sprites.empty()) {
+        return;
+    }
+
+    // A tileset packs into one atlas texture; an enemy sprite uploads a
+    // texture per frame. Requests are always finished whole.
+    int uploads = 0;
+    for (size_t i = 0; i < pending_tilesets.size() && uploads < max_uploads;) {
+        if (!decodes_finished(pending_tilesets[i].tiles)) {
+            ++i;
+            continue;
+        }
+        PendingTileset pending = std::move(pending_tilesets[i]);
+        pending_tilesets.erase(pending_tilesets.begin() + static_cast<std::ptrdiff_t>(i));
+        finish_tileset(pending);
+        uploads += 1;
+    }
+    for (size_t i = 0; i < pending_enemy_sprites.size() && uploads < max_uploads;) {
+        const PendingEnemySprite& candidate = pending_enemy_sprites[i];
+        if (!decodes_finished(candidate.left) || !decodes_finished(candidate.right)) {
+            ++i;
+            continue;
+        }
+        const int cost = static_cast<int>(candidate.left.size() + candidate.right.size());
+        if (uploads > 0 && uploads + cost > max_uploads) {
+            break;
+        }
+        PendingEnemySprite pending = std::move(pending_enemy_sprites[i]);
+        pending_enemy_sprites.erase(pending_enemy_sprites.begin() + static_cast<std::ptrdiff_t>(i));
+        finish_enemy_sprite(pending);
+        uploads += cost;
+    }
+    enforce_texture_budget();
+}
+
+bool GraphicsSystem::decodes_finished(const std::vector<DecodeTicket>& tickets) const {
+    for (const DecodeTicket& ticket : tickets) {
+        if (!decode_pool->is_done(ticket)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GraphicsSystem::is_tileset_ready(const std::string& level_name) const {
+    const TilesetId id = find_tileset_id(level_name);
+    if (id == INVALID_TILESET_ID) {
+        return false;
+    }
+    if (tilesets[id]->loaded) {
         return true;
     }
-    
-    Tileset tileset;
-    int missing_count = 0;
-    int loaded_count = 0;
-    std::string first_missing;
-    
+    for (const PendingTileset& pending : pending_tilesets) {
+        if (pending.id == id) {
+            return decodes_finished(pending.tiles);
+        }
+    }
+    return false;
+}
+
+bool GraphicsSystem::is_enemy_sprite_ready(const shp_t& sprite_desc) const {
+    for (const EnemySpriteEntry& entry : enemy_sprites) {
+        if (entry.matches(sprite_desc)) {
+            return true;
+        }
+    }
+    for (const PendingEnemySprite& pending : pending_enemy_sprites) {
+        if (pending.key.matches(sprite_desc)) {
+            return decodes_finished(pending.left) && decodes_finished(pending.right);
+        }
+    }
+    return false;
+}
+
+size_t GraphicsSystem::get_pending_asset_count() const {
+    return pending_tilesets.size() + pending_enemy_sprites.size();
+}
+
+void GraphicsSystem::set_texture_budget(size_t bytes) {
+    texture_budget = bytes;
+}
+
+size_t GraphicsSystem::get_texture_budget() const {
+    return texture_budget;
+}
+
+void GraphicsSystem::begin_texture_pins() {
+    pin_generation++;
+}
+
+void GraphicsSystem::pin_tileset(const std::string& level_name) {
+    const TilesetId id = intern_tileset(level_name);
+    if (id == INVALID_TILESET_ID) {
+        return;
+    }
+    tilesets[id]->pin_generation = pin_generation;
+    tilesets[id]->last_used = ++use_clock;
+}
+
+void GraphicsSystem::pin_enemy_sprite(const shp_t& sprite_desc) {
+    // Pending requests carry the pin over to their entry when they finish
+    for (EnemySpriteEntry& entry : enemy_sprites) {
+        if (entry.matches(sprite_desc)) {
+            entry.pin_generation = pin_generation;
+            entry.last_used = ++use_clock;
+            return;
+        }
+    }
+    for (PendingEnemySprite& pending : pending_enemy_sprites) {
+        if (pending.key.matches(sprite_desc)) {
+            pending.key.pin_generation = pin_generation;
+            return;
+        }
+    }
+}
+
+TextureCacheStats& GraphicsSystem::stats_for(TextureCategory category) {
+    return texture_stats[static_cast<size_t>(category)];
+}
+
+TextureCacheStats GraphicsSystem::get_texture_cache_stats(TextureCategory category) const {
+    if (category >= TextureCategory::COUNT) {
+        return TextureCacheStats();
+    }
+    return texture_stats[static_cast<size_t>(category)];
+}
+
+size_t GraphicsSystem::get_resident_texture_bytes() const {
+    size_t total = 0;
+    for (const TextureCacheStats& stats : texture_stats) {
+        total += stats.resident_bytes;
+    }
+    return total;
+}
+
+void GraphicsSystem::evict_tileset(TilesetEntry& entry) {
+    invalidate_stage_chunks(&entry.tileset);
+    if (stage_background_tileset == &entry.tileset) {
+        stage_background_tileset = nullptr;
+    }
+    entry.tileset.cleanup();
+    entry.loaded = false;
+
+    TextureCacheStats& stats = stats_for(TextureCategory::TILESETS);
+    stats.resident_bytes -= std::min(stats.resident_bytes, entry.bytes);
+    stats.resident_count--;
+    stats.evictions++;
+    entry.bytes = 0;
+}
+
+void GraphicsSystem::evict_enemy_sprite(size_t index) {
+    EnemySpriteEntry& entry = enemy_sprites[index];
+    for (auto& frame : entry.data->frames_left) {
+        if (frame.texture) {
+            SDL_DestroyTexture(frame.texture);
+        }
+    }
+    for (auto& frame : entry.data->frames_right) {
+        if (frame.texture) {
+            SDL_DestroyTexture(frame.texture);
+        }
+    }
+    delete entry.data;
+    enemy_sprite_evictions++;
+
+    TextureCacheStats& stats = stats_for(TextureCategory::ENEMY_SPRITES);
+    stats.resident_bytes -= std::min(stats.resident_bytes, entry.bytes);
+    stats.resident_count--;
+    stats.evictions++;
+    enemy_sprites.erase(enemy_sprites.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void GraphicsSystem::enforce_texture_budget() {
+    if (texture_budget == 0) {
+        return;
+    }
+
+    while (get_resident_texture_bytes() > texture_budget) {
+        // Oldest unpinned tileset or enemy sprite; a linear scan is fine for
+        // the handful of entries a playthrough can hold.
+        TilesetEntry* oldest_tileset = nullptr;
+        size_t oldest_sprite = enemy_sprites.size();
+        uint32_t oldest_stamp = UINT32_MAX;
+        for (auto& entry : tilesets) {
+            if (entry->loaded && entry->pin_generation != pin_generation &&
+                entry->last_used < oldest_stamp) {
+                oldest_tileset = entry.get();
+                oldest_stamp = entry->last_used;
+            }
+        }
+        for (size_t i = 0; i < enemy_sprites.size(); ++i) {
+            const EnemySpriteEntry& entry = enemy_sprites[i];
+            if (entry.pin_generation != pin_generation && entry.last_used < oldest_stamp) {
+                oldest_tileset = nullptr;
+                oldest_sprite = i;
+                oldest_stamp = entry.last_used;
+            }
+        }
+
+        if (oldest_sprite < enemy_sprites.size()) {
+            evict_enemy_sprite(oldest_sprite);
+        } else if (oldest_tileset != nullptr) {
+            evict_tileset(*oldest_tileset);
+        } else {
+            break;  // Everything left is pinned or a plain sprite
+        }
+    }
+}
+
+TilesetId GraphicsSystem::intern_tileset(const std::string& level_name) {
+    auto it = tileset_ids.find(level_name);
+    if (it != tileset_ids.end()) {
+        return it->second;
+    }
+    if (tilesets.size() >= INVALID_TILESET_ID) {
+        std::cerr << "Error: Too many tilesets registered" << std::endl;
+        return INVALID_TILESET_ID;
+    }
+
+    const TilesetId id = static_cast<TilesetId>(tilesets.size());
+    tilesets.emplace_back(new TilesetEntry());
+    tilesets.back()->name = level_name;
+    tileset_ids[level_name] = id;
+    return id;
+}
+
+TilesetId GraphicsSystem::find_tileset_id(const std::string& level_name) const {
+    auto it = tileset_ids.find(level_name);
+    return it != tileset_ids.end() ? it->second : INVALID_TILESET_ID;
+}
+
+bool GraphicsSystem::request_tileset(const std::string& level_name, bool urgent) {
+    const TilesetId id = intern_tileset(level_name);
+    if (id == INVALID_TILESET_ID || renderer == nullptr) {
+        return false;
+    }
+    if (tilesets[id]->loaded) {
+        return true;
+    }
+    for (const PendingTileset& pending : pending_tilesets) {
+        if (pending.id == id) {
+            if (urgent) {
+                for (const DecodeTicket& ticket : pending.tiles) {
+                    decode_pool->promote(ticket);
+                }
+            }
+            return true;
+        }
+    }
+
     // Load all tiles (0x00-0x7F / 0-127) for the level
     // Some levels have up to 87 tiles, so we try to load 128 to be safe
     // Missing tiles beyond what exists is expected and not an error
-    for (int i = 0; i < 128; i++) {
+    AssetDecodePool& pool = get_decode_pool();
+    PendingTileset pending;
+    pending.id = id;
+    pending.tiles.reserve(TILESET_MAX_TILES);
+    for (int i = 0; i < TILESET_MAX_TILES; i++) {
         char tile_name[64];
         std::snprintf(tile_name, sizeof(tile_name), "%s.tt2-%02x.png", level_name.c_str(), i);
+        const std::string filename = tile_name;
+        pending.tiles.push_back(pool.enqueue(
+            [this, filename]() { return load_asset_surface(filename); },
+            urgent));
+    }
+    pending_tilesets.push_back(std::move(pending));
+    return true;
+}
+
+bool GraphicsSystem::load_tileset(const std::string& level_name) {
+    const TilesetId id = intern_tileset(level_name);
+    if (id == INVALID_TILESET_ID) {
+        return false;
+    }
+    if (tilesets[id]->loaded) {
+        tilesets[id]->last_used = ++use_clock;
+        stats_for(TextureCategory::TILESETS).hits++;
+        return true;
+    }
+    stats_for(TextureCategory::TILESETS).misses++;
+
+    // Complete an in-flight request, or issue one and wait for it; either way
+    // the decodes are spread over the worker pool.
+    if (!request_tileset(level_name)) {
+        return false;
+    }
+    for (size_t i = 0; i < pending_tilesets.size(); ++i) {
+        if (pending_tilesets[i].id == id) {
+            PendingTileset pending = std::move(pending_tilesets[i]);
+            pending_tilesets.erase(pending_tilesets.begin() + static_cast<std::ptrdiff_t>(i));
+            return finish_tileset(pending);
+        }
+    }
+    return false;
+}
+
+bool GraphicsSystem::finish_tileset(PendingTileset& pending) {
+    TilesetEntry& entry = *tilesets[pending.id];
+    const std::string& level_name = entry.name;
+
+    SDL_Surface* tile_surfaces[TILESET_MAX_TILES] = {};
+    int missing_count = 0;
+    int loaded_count = 0;
+    int cell_w = TILE_SIZE;
+    int cell_h = TILE_SIZE;
+    std::string first_missing;
+    
+    AssetDecodePool& pool = get_decode_pool();
+    for (int i = 0; i < TILESET_MAX_TILES && i < static_cast<int>(pending.tiles.size()); i++) {
+        pool.wait(pending.tiles[i]);
+        tile_surfaces[i] = pending.tiles[i]->take_surface();
         
-        std::string filepath = get_asset_path(tile_name);
-        TextureInfo texture = load_png(filepath);
-        
-        if (texture.texture != nullptr) {
-            tileset.tiles[i] = texture;
+        if (tile_surfaces[i] != nullptr) {
+            cell_w = std::max(cell_w, tile_surfaces[i]->w);
+            cell_h = std::max(cell_h, tile_surfaces[i]->h);
             loaded_count++;
         } else {
             missing_count++;
             if (first_missing.empty()) {
+                char tile_name[64];
+                std::snprintf(tile_name, sizeof(tile_name), "%s.tt2-%02x.png", level_name.c_str(), i);
                 first_missing = tile_name;
             }
         }
     }
+    pending.tiles.clear();
+    
+    auto free_tile_surfaces = [&tile_surfaces]() {
+        for (SDL_Surface*& surface : tile_surfaces) {
+            if (surface != nullptr) {
+                SDL_FreeSurface(surface);
+                surface = nullptr;
+            }
+        }
+    };
     
-    if (tileset.tiles.empty()) {
+    if (loaded_count == 0) {
         std::cerr << "Error: Failed to load any tiles for tileset: " << level_name << std::endl;
         return false;
     }
@@ -333,68 +757,204 @@ bool GraphicsSystem::load_tileset(const std::string& level_name) {
                   << std::endl;
     }
     
-    tilesets[level_name] = tileset;
+    // Pack every tile into one atlas surface (16 columns x 8 rows of cells)
+    // so the tile loop draws from a single texture instead of one per tile.
+    SDL_Surface* atlas_surface = SDL_CreateRGBSurfaceWithFormat(
+        0,
+        cell_w * TILESET_ATLAS_COLUMNS,
+        cell_h * (TILESET_MAX_TILES / TILESET_ATLAS_COLUMNS),
+        32,
+        SDL_PIXELFORMAT_RGBA32);
+    if (atlas_surface == nullptr) {
+        std::cerr << "Error: Failed to create atlas surface for tileset '" << level_name
+                  << "': " << SDL_GetError() << std::endl;
+        free_tile_surfaces();
+        return false;
+    }
+    
+    Tileset tileset;
+    for (int i = 0; i < TILESET_MAX_TILES; i++) {
+        SDL_Surface* tile_surface = tile_surfaces[i];
+        if (tile_surface == nullptr) {
+            continue;
+        }
+        
+        SDL_Rect cell = {
+            (i % TILESET_ATLAS_COLUMNS) * cell_w,
+            (i / TILESET_ATLAS_COLUMNS) * cell_h,
+            tile_surface->w,
+            tile_surface->h
+        };
+        // Copy pixels verbatim (including alpha) rather than blending onto the
+        // transparent atlas background.
+        SDL_SetSurfaceBlendMode(tile_surface, SDL_BLENDMODE_NONE);
+        SDL_Rect blit_dst = cell;
+        if (SDL_BlitSurface(tile_surface, nullptr, atlas_surface, &blit_dst) != 0) {
+            std::cerr << "Warning: Failed to pack tile " << i << " of tileset '"
+                      << level_name << "': " << SDL_GetError() << std::endl;
+            continue;
+        }
+        
+        tileset.src_rects[i] = cell;
+        tileset.present[i] = true;
+        tileset.tile_count++;
+    }
+    free_tile_surfaces();
+    
+    const int atlas_surface_w = atlas_surface->w;
+    const int atlas_surface_h = atlas_surface->h;
+    tileset.atlas = SDL_CreateTextureFromSurface(renderer, atlas_surface);
+    SDL_FreeSurface(atlas_surface);
+    if (tileset.atlas == nullptr) {
+        std::cerr << "Error: Failed to create atlas texture for tileset '" << level_name
+                  << "': " << SDL_GetError() << std::endl;
+        return false;
+    }
+    count_event(Counter::TEXTURES_CREATED);
+    
+    entry.tileset = tileset;
+    entry.loaded = true;
+    entry.bytes = static_cast<size_t>(atlas_surface_w) * atlas_surface_h * 4;
+    entry.last_used = ++use_clock;
+    TextureCacheStats& stats = stats_for(TextureCategory::TILESETS);
+    stats.resident_bytes += entry.bytes;
+    stats.resident_count++;
 
     // Apply any previously configured blackout state to newly loaded tiles.
-    auto blackout_it = tileset_blackout.find(level_name);
-    if (blackout_it != tileset_blackout.end()) {
-        set_tileset_blackout(level_name, blackout_it->second);
-    }
+    set_tileset_blackout(pending.id, entry.blackout);
 
     return true;
 }
 
 Tileset* GraphicsSystem::get_tileset(const std::string& level_name) {
-    auto it = tilesets.find(level_name);
-    if (it != tilesets.end()) {
-        return &it->second;
+    return get_tileset(find_tileset_id(level_name));
+}
+
+Tileset* GraphicsSystem::get_tileset(TilesetId id) {
+    if (id >= tilesets.size() || !tilesets[id]->loaded) {
+        return nullptr;
     }
-    return nullptr;
+    return &tilesets[id]->tileset;
 }
 
 void GraphicsSystem::set_tileset_blackout(const std::string& level_name, bool blackout) {
-    tileset_blackout[level_name] = blackout;
+    set_tileset_blackout(intern_tileset(level_name), blackout);
+}
 
-    auto tileset_it = tilesets.find(level_name);
-    if (tileset_it == tilesets.end()) {
+void GraphicsSystem::set_tileset_blackout(TilesetId id, bool blackout) {
+    if (id >= tilesets.size()) {
+        return;
+    }
+    TilesetEntry& entry = *tilesets[id];
+    entry.blackout = blackout;
+    if (!entry.loaded) {
         return;
     }
 
+    // The cached stage background was drawn with the old color modulation.
+    invalidate_stage_chunks(&entry.tileset);
+
     const uint8_t color = blackout ? 0 : 255;
-    for (auto& tile_entry : tileset_it->second.tiles) {
-        TextureInfo& tile_texture = tile_entry.second;
-        if (tile_texture.texture != nullptr) {
-            SDL_SetTextureColorMod(tile_texture.texture, color, color, color);
-        }
+    if (entry.tileset.atlas != nullptr) {
+        SDL_SetTextureColorMod(entry.tileset.atlas, color, color, color);
     }
 }
 
 bool GraphicsSystem::is_tileset_blacked_out(const std::string& level_name) const {
-    auto blackout_it = tileset_blackout.find(level_name);
-    if (blackout_it == tileset_blackout.end()) {
+    const TilesetId id = find_tileset_id(level_name);
+    if (id == INVALID_TILESET_ID) {
         return false;
     }
-    return blackout_it->second;
+    return tilesets[id]->blackout;
 }
 
-bool GraphicsSystem::load_sprite(const std::string& sprite_name, const std::string& direction) {
-    std::string key = direction.empty() ? sprite_name : (sprite_name + "_" + direction);
-    if (sprites.find(key) != sprites.end()) {
+static std::string sprite_registry_key(const std::string& sprite_name, const std::string& direction) {
+    return direction.empty() ? sprite_name : (sprite_name + "_" + direction);
+}
+
+static std::string sprite_file_name(const std::string& sprite_name, const std::string& direction) {
+    return "sprite-" + sprite_registry_key(sprite_name, direction) + ".png";
+}
+
+bool GraphicsSystem::request_sprite(const std::string& sprite_name, const std::string& direction, bool urgent) {
+    std::string key = sprite_registry_key(sprite_name, direction);
+    if (sprite_ids.count(key) != 0) {
         return true;
     }
+    for (const PendingSprite& pending : pending_sprites) {
+        if (pending.key == key) {
+            if (urgent) {
+                decode_pool->promote(pending.ticket);
+            }
+            return true;
+        }
+    }
+
+    PendingSprite pending;
+    pending.filename = sprite_file_name(sprite_name, direction);
+    pending.ticket = request_asset_surface(pending.filename, urgent);
+    pending.key = std::move(key);
+    pending_sprites.push_back(std::move(pending));
+    return true;
+}
+
+size_t GraphicsSystem::get_pending_sprite_decodes() const {
+    size_t decoding = 0;
+    for (const PendingSprite& pending : pending_sprites) {
+        if (!decode_pool->is_done(pending.ticket)) {
+            decoding++;
+        }
+    }
+    return decoding;
+}
+
+DecodeTicket GraphicsSystem::request_asset_surface(const std::string& filename, bool urgent) {
+    return get_decode_pool().enqueue([this, filename]() { return load_asset_surface(filename); }, urgent);
+}
+
+SDL_Surface* GraphicsSystem::wait_asset_surface(DecodeTicket& ticket) {
+    if (!ticket) {
+        return nullptr;
+    }
+    get_decode_pool().wait(ticket);
+    SDL_Surface* surface = ticket->take_surface();
+    ticket.reset();
+    return surface;
+}
+
+bool GraphicsSystem::load_sprite(const std::string& sprite_name, const std::string& direction) {
+    return load_sprite_id(sprite_name, direction) != INVALID_SPRITE_ID;
+}
+
+SpriteId GraphicsSystem::load_sprite_id(const std::string& sprite_name, const std::string& direction) {
+    std::string key = sprite_registry_key(sprite_name, direction);
+    auto it = sprite_ids.find(key);
+    if (it != sprite_ids.end()) {
+        stats_for(TextureCategory::SPRITES).hits++;
+        return it->second;
+    }
+    stats_for(TextureCategory::SPRITES).misses++;
+    if (sprites.size() >= INVALID_SPRITE_ID) {
+        std::cerr << "Error: Sprite registry full, cannot load " << key << std::endl;
+        return INVALID_SPRITE_ID;
+    }
     
+    // Finish a request (its decode is likely done by now), or load on the spot
     std::string filename;
-    if (direction.empty()) {
-        filename = "sprite-" + sprite_name + ".png";
+    TextureInfo texture = {nullptr, 0, 0};
+    auto pending = std::find_if(pending_sprites.begin(), pending_sprites.end(),
+                                [&key](const PendingSprite& request) { return request.key == key; });
+    if (pending != pending_sprites.end()) {
+        filename = pending->filename;
+        texture = upload_surface(wait_asset_surface(pending->ticket));
+        pending_sprites.erase(pending);
     } else {
-        filename = "sprite-" + sprite_name + "_" + direction + ".png";
+        filename = sprite_file_name(sprite_name, direction);
+        texture = load_png(filename);
     }
-    std::string filepath = get_asset_path(filename);
-    
-    TextureInfo texture = load_png(filepath);
     if (texture.texture == nullptr) {
         std::cerr << "Warning: Missing sprite asset: " << filename << std::endl;
-        return false;
+        return INVALID_SPRITE_ID;
     }
     
     Sprite sprite;
@@ -402,59 +962,151 @@ bool GraphicsSystem::load_sprite(const std::string& sprite_name, const std::stri
     sprite.width = texture.width;
     sprite.height = texture.height;
     
-    sprites[key] = sprite;
-    return true;
+    TextureCacheStats& stats = stats_for(TextureCategory::SPRITES);
+    stats.resident_bytes += static_cast<size_t>(texture.width) * texture.height * 4;
+    stats.resident_count++;
+    
+    const SpriteId id = static_cast<SpriteId>(sprites.size());
+    sprites.push_back(sprite);
+    sprite_ids[key] = id;
+    return id;
+}
+
+SpriteId GraphicsSystem::find_sprite_id(const std::string& sprite_name, const std::string& direction) const {
+    auto it = sprite_ids.find(sprite_registry_key(sprite_name, direction));
+    return it != sprite_ids.end() ? it->second : INVALID_SPRITE_ID;
+}
+
+const Sprite* GraphicsSystem::get_sprite(const std::string& sprite_name, const std::string& direction) const {
+    return get_sprite(find_sprite_id(sprite_name, direction));
+}
+
+bool GraphicsSystem::EnemySpriteEntry::matches(const shp_t& sprite_desc) const {
+    return num_distinct_frames == sprite_desc.num_distinct_frames &&
+           horizontal == sprite_desc.horizontal &&
+           animation == sprite_desc.animation &&
+           std::memcmp(filename, sprite_desc.filename, sizeof(filename)) == 0;
 }
 
-Sprite* GraphicsSystem::get_sprite(const std::string& sprite_name, const std::string& direction) {
-    std::string key = direction.empty() ? sprite_name : (sprite_name + "_" + direction);
-    auto it = sprites.find(key);
-    if (it != sprites.end()) {
-        return &it->second;
+static std::string enemy_sprite_name(const shp_t& sprite_desc) {
+    std::string sprite_name(sprite_desc.filename,
+                            strnlen(sprite_desc.filename, sizeof(sprite_desc.filename)));
+    while (!sprite_name.empty() && sprite_name.back() == ' ') {
+        sprite_name.pop_back();
     }
-    return nullptr;
+    return sprite_name;
 }
 
-SpriteAnimationData* GraphicsSystem::load_enemy_sprite(const shp_t& sprite_desc) {
-    if (sprite_desc.num_distinct_frames == 0) {
-        return nullptr;
+bool GraphicsSystem::request_enemy_sprite(const shp_t& sprite_desc, bool urgent) {
+    if (sprite_desc.num_distinct_frames == 0 || renderer == nullptr) {
+        return false;
     }
 
-    std::string sprite_name = sprite_desc.filename;
-    size_t null_pos = sprite_name.find('\0');
-    if (null_pos != std::string::npos) {
-        sprite_name = sprite_name.substr(0, null_pos);
+    // Check if already loaded or in flight (compares the raw descriptor; no allocation)
+    for (const EnemySpriteEntry& entry : enemy_sprites) {
+        if (entry.matches(sprite_desc)) {
+            return true;
+        }
     }
-    while (!sprite_name.empty() && sprite_name.back() == ' ') {
-        sprite_name.pop_back();
+    for (const PendingEnemySprite& pending : pending_enemy_sprites) {
+        if (pending.key.matches(sprite_desc)) {
+            if (urgent) {
+                for (const DecodeTicket& ticket : pending.left) {
+                    decode_pool->promote(ticket);
+                }
+                for (const DecodeTicket& ticket : pending.right) {
+                    decode_pool->promote(ticket);
+                }
+            }
+            return true;
+        }
     }
+
+    const std::string sprite_name = enemy_sprite_name(sprite_desc);
     if (sprite_name.empty()) {
+        return false;
+    }
+
+    PendingEnemySprite pending;
+    std::memcpy(pending.key.filename, sprite_desc.filename, sizeof(pending.key.filename));
+    pending.key.num_distinct_frames = sprite_desc.num_distinct_frames;
+    pending.key.horizontal = sprite_desc.horizontal;
+    pending.key.animation = sprite_desc.animation;
+    pending.key.data = nullptr;
+    pending.name = sprite_name;
+    if (original_assets.has_file(sprite_name)) {
+        // Decode straight from the .shp: left frames first, then the
+        // separately drawn right-facing frames if there are any
+        const int frames = sprite_desc.num_distinct_frames;
+        pending.left = queue_shp_frames(sprite_name, 0, frames, urgent);
+        if (sprite_desc.horizontal == ENEMY_HORIZONTAL_SEPARATE) {
+            pending.right = queue_shp_frames(sprite_name, frames, frames, urgent);
+        }
+        pending_enemy_sprites.push_back(std::move(pending));
+        return true;
+    }
+
+    // Decode per-frame PNGs: {sprite_name}-left-0.png, -1.png, etc.
+    pending.left = queue_animation_frames(sprite_name + "-left",
+                                          sprite_desc.num_distinct_frames, urgent);
+    if (sprite_desc.horizontal == ENEMY_HORIZONTAL_SEPARATE) {
+        pending.right = queue_animation_frames(sprite_name + "-right",
+                                               sprite_desc.num_distinct_frames, urgent);
+    }
+    pending_enemy_sprites.push_back(std::move(pending));
+    return true;
+}
+
+SpriteAnimationData* GraphicsSystem::load_enemy_sprite(const shp_t& sprite_desc) {
+    if (sprite_desc.num_distinct_frames == 0) {
         return nullptr;
     }
 
-    std::ostringstream cache_key;
-    cache_key << sprite_name << ":" << static_cast<int>(sprite_desc.num_distinct_frames)
-              << ":" << static_cast<int>(sprite_desc.horizontal)
-              << ":" << static_cast<int>(sprite_desc.animation);
+    for (EnemySpriteEntry& entry : enemy_sprites) {
+        if (entry.matches(sprite_desc)) {
+            entry.last_used = ++use_clock;
+            stats_for(TextureCategory::ENEMY_SPRITES).hits++;
+            return entry.data;
+        }
+    }
+    stats_for(TextureCategory::ENEMY_SPRITES).misses++;
 
-    // Check if already loaded
-    auto it = enemy_sprites.find(cache_key.str());
-    if (it != enemy_sprites.end()) {
-        return it->second;
+    if (renderer == nullptr) {
+        std::cerr << "Warning: Renderer unavailable; cannot load animation: "
+                  << enemy_sprite_name(sprite_desc) << std::endl;
+        return nullptr;
+    }
+
+    // Complete an in-flight request, or issue one and wait for it
+    if (!request_enemy_sprite(sprite_desc)) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < pending_enemy_sprites.size(); ++i) {
+        if (pending_enemy_sprites[i].key.matches(sprite_desc)) {
+            PendingEnemySprite pending = std::move(pending_enemy_sprites[i]);
+            pending_enemy_sprites.erase(pending_enemy_sprites.begin() + static_cast<std::ptrdiff_t>(i));
+            return finish_enemy_sprite(pending);
+        }
     }
+    return nullptr;
+}
 
-    // Load per-frame PNGs: {sprite_name}-left-0.png, -1.png, etc.
+SpriteAnimationData* GraphicsSystem::finish_enemy_sprite(PendingEnemySprite& pending) {
+    const EnemySpriteEntry& sprite_desc = pending.key;
+    const std::string& sprite_name = pending.name;
+
+    // Upload per-frame PNGs: {sprite_name}-left-0.png, -1.png, etc.
     auto* animation_data = new SpriteAnimationData();
-    animation_data->frames_left = load_animation_frames(
+    animation_data->frames_left = upload_animation_frames(
         sprite_name + "-left",
-        sprite_desc.num_distinct_frames,
+        pending.left,
         sprite_name + ":left"
     );
 
     if (sprite_desc.horizontal == ENEMY_HORIZONTAL_SEPARATE) {
-        animation_data->frames_right = load_animation_frames(
+        animation_data->frames_right = upload_animation_frames(
             sprite_name + "-right",
-            sprite_desc.num_distinct_frames,
+            pending.right,
             sprite_name + ":right"
         );
     }
@@ -501,11 +1153,11 @@ SpriteAnimationData* GraphicsSystem::load_enemy_sprite(const shp_t& sprite_desc)
         }
     }
 
-    // Clamp to uint8_t range before cast — enemy animations are defined in
-    // level_data.cpp with num_distinct_frames as uint8_t (max 255), so this
-    // is a safety guard rather than an expected runtime condition.
+    // Sequences use at most MAX_ENEMY_ANIMATION_FRAMES frames; the original
+    // sprites have 3 or 4, so this is a safety guard rather than an expected
+    // runtime condition.
     animation_data->frame_sequence = build_enemy_animation_sequence(
-        static_cast<uint8_t>(std::min(distinct_frames, static_cast<size_t>(255))),
+        static_cast<uint8_t>(std::min(distinct_frames, MAX_ENEMY_ANIMATION_FRAMES)),
         sprite_desc.animation
     );
 
@@ -524,7 +1176,20 @@ SpriteAnimationData* GraphicsSystem::load_enemy_sprite(const shp_t& sprite_desc)
         return nullptr;
     }
 
-    enemy_sprites[cache_key.str()] = animation_data;
+    EnemySpriteEntry entry = pending.key;
+    entry.data = animation_data;
+    entry.bytes = 0;
+    for (const TextureInfo& frame : animation_data->frames_left) {
+        entry.bytes += static_cast<size_t>(frame.width) * frame.height * 4;
+    }
+    for (const TextureInfo& frame : animation_data->frames_right) {
+        entry.bytes += static_cast<size_t>(frame.width) * frame.height * 4;
+    }
+    entry.last_used = ++use_clock;
+    TextureCacheStats& stats = stats_for(TextureCategory::ENEMY_SPRITES);
+    stats.resident_bytes += entry.bytes;
+    stats.resident_count++;
+    enemy_sprites.push_back(entry);
     return animation_data;
 }
 
@@ -535,8 +1200,9 @@ Animation GraphicsSystem::create_animation(const std::vector<std::string>& sprit
     int safe_duration_ms = frame_duration_ms > 0 ? frame_duration_ms : 1;
     
     for (const auto& sprite_name : sprite_names) {
-        if (load_sprite(sprite_name, direction)) {
-            Sprite* sprite = get_sprite(sprite_name, direction);
+        const SpriteId id = load_sprite_id(sprite_name, direction);
+        if (id != INVALID_SPRITE_ID) {
+            const Sprite* sprite = get_sprite(id);
             if (sprite) {
                 AnimationFrame frame;
                 frame.sprite = *sprite;
@@ -556,9 +1222,9 @@ AnimationFrame* GraphicsSystem::get_current_frame(Animation& anim) {
     return &anim.frames[anim.current_frame];
 }
 
-void GraphicsSystem::update_animation(Animation& anim, uint32_t current_time) {
+uint32_t GraphicsSystem::update_animation(Animation& anim, uint32_t current_time) {
     if (anim.frames.empty()) {
-        return;
+        return 0;
     }
 
     int total_duration = 0;
@@ -568,7 +1234,7 @@ void GraphicsSystem::update_animation(Animation& anim, uint32_t current_time) {
 
     if (total_duration <= 0) {
         anim.current_frame = 0;
-        return;
+        return 0;
     }
 
     uint32_t elapsed = current_time - anim.frame_start_time;
@@ -576,7 +1242,7 @@ void GraphicsSystem::update_animation(Animation& anim, uint32_t current_time) {
         elapsed %= static_cast<uint32_t>(total_duration);
     } else if (elapsed >= static_cast<uint32_t>(total_duration)) {
         anim.current_frame = static_cast<int>(anim.frames.size()) - 1;
-        return;
+        return 0;
     }
 
     uint32_t cursor = 0;
@@ -585,35 +1251,234 @@ void GraphicsSystem::update_animation(Animation& anim, uint32_t current_time) {
         cursor += static_cast<uint32_t>(frame_duration);
         if (elapsed < cursor) {
             anim.current_frame = static_cast<int>(i);
-            return;
+            // A looping animation of one frame never shows anything else
+            if (anim.looping && anim.frames.size() == 1) {
+                return 0;
+            }
+            return current_time + (cursor - elapsed);
         }
     }
 
     anim.current_frame = static_cast<int>(anim.frames.size()) - 1;
+    return 0;
 }
 
 void GraphicsSystem::render_tile(int screen_x, int screen_y, Tileset* tileset, uint8_t tile_id, int scale) {
-    if (tileset == nullptr) return;
+    if (tileset == nullptr || tileset->atlas == nullptr) return;
+    if (!tileset->present[tile_id]) return;
     
-    auto it = tileset->tiles.find(tile_id);
-    if (it == tileset->tiles.end()) return;
-    
-    const TextureInfo& texture = it->second;
     int pixel_size = scale * 2; // 2 game units per tile
-    SDL_Rect dst_rect = {screen_x, screen_y, pixel_size, pixel_size};
-    SDL_RenderCopy(renderer, texture.texture, nullptr, &dst_rect);
+    SDL_Rect dst_rect = {screen_x + world_offset_x, screen_y, pixel_size, pixel_size};
+    SDL_RenderCopy(renderer, tileset->atlas, &tileset->src_rects[tile_id], &dst_rect);
+    count_render_call(tileset->atlas);
+}
+
+// Pixels per game unit inside the stage background cache (16px tiles, 2 units each)
+constexpr int STAGE_BACKGROUND_UNIT_PIXELS = TILE_SIZE / 2;
+constexpr int STAGE_CHUNK_UNITS = TILE_MAP_CHUNK_WIDTH * 2;
+
+void GraphicsSystem::invalidate_stage_background() {
+    invalidate_stage_chunks(nullptr);
+}
+
+void GraphicsSystem::invalidate_stage_chunks(const Tileset* tileset) {
+    for (StageChunk& slot : stage_chunks) {
+        if (tileset == nullptr || slot.tileset == tileset) {
+            slot.chunk = -1;
+        }
+    }
+}
+
+// What a chunk's texture is drawn from: a streamed stage's chunks keep their
+// place on the map as its window moves, the compiled-in stages are one window
+static const void* stage_chunk_source(const GameContext& game) {
+    return game.tile_map ? static_cast<const void*>(game.tile_map) : game.current_tiles();
+}
+
+GraphicsSystem::StageChunk* GraphicsSystem::find_stage_chunk(const GameContext& game, const Tileset* tileset,
+                                                             int32_t chunk) {
+    const void* source = stage_chunk_source(game);
+    const uint32_t revision = get_stage_tiles_revision(game);
+    for (StageChunk& slot : stage_chunks) {
+        if (slot.chunk == chunk && slot.source == source && slot.revision == revision && slot.tileset == tileset) {
+            slot.last_used = ++stage_chunk_clock;
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+GraphicsSystem::StageChunk* GraphicsSystem::draw_stage_chunk(const GameContext& game, Tileset* tileset,
+                                                             int32_t chunk) {
+    if (StageChunk* cached = find_stage_chunk(game, tileset, chunk)) {
+        return cached;
+    }
+
+    // Redraw the least recently used slot; the chunks of this frame were just used
+    StageChunk* slot = &stage_chunks[0];
+    for (StageChunk& candidate : stage_chunks) {
+        if (candidate.last_used < slot->last_used) {
+            slot = &candidate;
+        }
+    }
+
+    if (slot->texture == nullptr) {
+        if (!SDL_RenderTargetSupported(renderer)) {
+            std::cerr << "Warning: Render targets unsupported; drawing stage tiles individually" << std::endl;
+            stage_background_unsupported = true;
+            return nullptr;
+        }
+
+        slot->texture = SDL_CreateTexture(
+            renderer,
+            SDL_PIXELFORMAT_RGBA32,
+            SDL_TEXTUREACCESS_TARGET,
+            STAGE_CHUNK_UNITS * STAGE_BACKGROUND_UNIT_PIXELS,
+            MAP_HEIGHT * STAGE_BACKGROUND_UNIT_PIXELS);
+        if (slot->texture == nullptr) {
+            std::cerr << "Warning: Failed to create stage background texture: "
+                      << SDL_GetError() << std::endl;
+            stage_background_unsupported = true;
+            return nullptr;
+        }
+        SDL_SetTextureBlendMode(slot->texture, SDL_BLENDMODE_BLEND);
+    }
+
+    // Switching targets resets the viewport and scale, so preserve the caller's.
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+    SDL_Rect previous_viewport;
+    SDL_RenderGetViewport(renderer, &previous_viewport);
+    float previous_scale_x = 1.0f;
+    float previous_scale_y = 1.0f;
+    SDL_RenderGetScale(renderer, &previous_scale_x, &previous_scale_y);
+    Uint8 prev_r = 0, prev_g = 0, prev_b = 0, prev_a = 0;
+    SDL_GetRenderDrawColor(renderer, &prev_r, &prev_g, &prev_b, &prev_a);
+
+    if (SDL_SetRenderTarget(renderer, slot->texture) != 0) {
+        std::cerr << "Warning: Failed to bind stage background target: "
+                  << SDL_GetError() << std::endl;
+        stage_background_unsupported = true;
+        return nullptr;
+    }
+
+    // Transparent clear so missing tiles show the HUD behind, as before.
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    // The cache is drawn in map coordinates, unshifted
+    const int saved_world_offset = world_offset_x;
+    world_offset_x = 0;
+    for (int ty = 0; ty < MAP_HEIGHT_TILES; ty++) {
+        for (int tx = 0; tx < TILE_MAP_CHUNK_WIDTH; tx++) {
+            const uint8_t tile = get_map_tile(game, chunk * TILE_MAP_CHUNK_WIDTH + tx, ty);
+            render_tile(tx * TILE_SIZE, ty * TILE_SIZE, tileset, tile, STAGE_BACKGROUND_UNIT_PIXELS);
+        }
+    }
+    world_offset_x = saved_world_offset;
+
+    SDL_SetRenderTarget(renderer, previous_target);
+    SDL_RenderSetViewport(renderer, &previous_viewport);
+    SDL_RenderSetScale(renderer, previous_scale_x, previous_scale_y);
+    SDL_SetRenderDrawColor(renderer, prev_r, prev_g, prev_b, prev_a);
+
+    slot->source = stage_chunk_source(game);
+    slot->revision = get_stage_tiles_revision(game);
+    slot->chunk = chunk;
+    slot->tileset = tileset;
+    slot->last_used = ++stage_chunk_clock;
+    return slot;
+}
+
+bool GraphicsSystem::render_stage_background(const GameContext& game, Tileset* tileset,
+                                             int camera_x, int scale) {
+    if (renderer == nullptr || tileset == nullptr || stage_background_unsupported) {
+        return false;
+    }
+    stage_background_tileset = tileset;
+
+    if (world_offset_x != 0) {
+        // A shifted camera shows part of a unit past one edge; the viewport clips the rest
+        const int margin = (std::abs(world_offset_x) + scale - 1) / scale;
+        return copy_stage_chunks(game, tileset, camera_x - margin, 0, PLAYFIELD_WIDTH + 2 * margin, MAP_HEIGHT,
+                                 camera_x, scale);
+    }
+    return copy_stage_chunks(game, tileset, camera_x, 0, PLAYFIELD_WIDTH, MAP_HEIGHT, camera_x, scale);
+}
+
+void GraphicsSystem::set_world_offset(int offset_x) {
+    world_offset_x = offset_x;
+}
+
+bool GraphicsSystem::render_stage_background_region(const GameContext& game, int world_x, int world_y,
+                                                    int width_units, int height_units,
+                                                    int camera_x, int scale) {
+    if (renderer == nullptr) {
+        return false;
+    }
+    return copy_stage_chunks(game, nullptr, world_x, world_y, width_units, height_units, camera_x, scale);
+}
+
+// Copy window units [world_x, world_x + width_units) from the chunks under
+// them, drawing missing chunks with tileset (without one, only cached chunks
+// drawn with stage_background_tileset are used)
+bool GraphicsSystem::copy_stage_chunks(const GameContext& game, Tileset* tileset, int world_x, int world_y,
+                                       int width_units, int height_units, int camera_x, int scale) {
+    // Clip to the window; the cache holds nothing beyond its edges.
+    const int x0 = std::max(world_x, 0);
+    const int y0 = std::max(world_y, 0);
+    const int x1 = std::min(world_x + width_units, MAP_WIDTH);
+    const int y1 = std::min(world_y + height_units, MAP_HEIGHT);
+    if (x1 <= x0 || y1 <= y0) {
+        return true;
+    }
+
+    const int origin_units = game.map_origin_x * 2;
+    const int32_t first_chunk = (origin_units + x0) / STAGE_CHUNK_UNITS;
+    const int32_t last_chunk = (origin_units + x1 - 1) / STAGE_CHUNK_UNITS;
+    if (last_chunk - first_chunk >= STAGE_BACKGROUND_CHUNK_SLOTS) {
+        return false;
+    }
+    StageChunk* slots[STAGE_BACKGROUND_CHUNK_SLOTS];
+    for (int32_t chunk = first_chunk; chunk <= last_chunk; chunk++) {
+        StageChunk* slot = tileset ? draw_stage_chunk(game, tileset, chunk)
+                                   : find_stage_chunk(game, stage_background_tileset, chunk);
+        if (slot == nullptr) {
+            return false;
+        }
+        slots[chunk - first_chunk] = slot;
+    }
+
+    for (int32_t chunk = first_chunk; chunk <= last_chunk; chunk++) {
+        const int chunk_x = chunk * STAGE_CHUNK_UNITS - origin_units;  // Left edge in window units
+        const int cx0 = std::max(x0, chunk_x);
+        const int cx1 = std::min(x1, chunk_x + STAGE_CHUNK_UNITS);
+        SDL_Texture* texture = slots[chunk - first_chunk]->texture;
+        SDL_Rect src_rect = {
+            (cx0 - chunk_x) * STAGE_BACKGROUND_UNIT_PIXELS,
+            y0 * STAGE_BACKGROUND_UNIT_PIXELS,
+            (cx1 - cx0) * STAGE_BACKGROUND_UNIT_PIXELS,
+            (y1 - y0) * STAGE_BACKGROUND_UNIT_PIXELS
+        };
+        SDL_Rect dst_rect = {
+            (cx0 - camera_x) * scale + world_offset_x,
+            y0 * scale,
+            (cx1 - cx0) * scale,
+            (y1 - y0) * scale
+        };
+        SDL_RenderCopy(renderer, texture, &src_rect, &dst_rect);
+        count_render_call(texture);
+    }
+    return true;
 }
 
 void GraphicsSystem::render_sprite(int screen_x, int screen_y, const Sprite& sprite, bool flip_h) {
     SDL_Rect dst_rect = {screen_x, screen_y, sprite.width, sprite.height};
-    SDL_RendererFlip flip = flip_h ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderCopyEx(renderer, sprite.texture.texture, nullptr, &dst_rect, 0, nullptr, flip);
+    submit_sprite(sprite.texture.texture, nullptr, dst_rect, flip_h);
 }
 
 void GraphicsSystem::render_sprite_scaled(int screen_x, int screen_y, const Sprite& sprite, int width, int height, bool flip_h) {
     SDL_Rect dst_rect = {screen_x, screen_y, width, height};
-    SDL_RendererFlip flip = flip_h ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderCopyEx(renderer, sprite.texture.texture, nullptr, &dst_rect, 0, nullptr, flip);
+    submit_sprite(sprite.texture.texture, nullptr, dst_rect, flip_h);
 }
 
 void GraphicsSystem::render_sprite_centered(int screen_x, int screen_y, const Sprite& sprite, bool flip_h) {
@@ -663,39 +1528,175 @@ void GraphicsSystem::render_sprite_top_clip_scaled(int screen_x, int screen_y, c
 
     SDL_Rect src_rect = {0, 0, tex_w, src_h};
     SDL_Rect dst_rect = {dest_x, dest_y, width, clamped_clip_height};
-    SDL_RendererFlip flip = flip_h ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderCopyEx(renderer, sprite.texture.texture, &src_rect, &dst_rect, 0, nullptr, flip);
+    submit_sprite(sprite.texture.texture, &src_rect, dst_rect, flip_h);
 }
 
-void GraphicsSystem::render_text(int screen_x, int screen_y, const std::string& text, SDL_Color color) {
-    if (debug_font == nullptr) {
-        return;  // Font not available
+void GraphicsSystem::submit_sprite(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& world_dst, bool flip_h) {
+    if (texture == nullptr) {
+        return;
     }
-    
-    SDL_Surface* surface = TTF_RenderText_Solid(debug_font, text.c_str(), color);
-    if (surface == nullptr) {
+    SDL_Rect dst = world_dst;
+    dst.x += world_offset_x;
+
+    if (!batching) {
+        SDL_RendererFlip flip = flip_h ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        SDL_RenderCopyEx(renderer, texture, src, &dst, 0, nullptr, flip);
+        count_render_call(texture);
         return;
     }
-    
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (texture == nullptr) {
-        SDL_FreeSurface(surface);
+
+    QueuedSprite queued;
+    queued.texture = texture;
+    queued.src = src ? *src : SDL_Rect{0, 0, 0, 0};
+    queued.dst = dst;
+    queued.has_src = src != nullptr;
+    queued.flip_h = flip_h;
+    queued.layer = current_layer;
+    queued.sequence = static_cast<uint32_t>(sprite_queue.size());
+    sprite_queue.push_back(queued);
+}
+
+void GraphicsSystem::begin_sprite_batch() {
+    sprite_queue.clear();
+    current_layer = RenderLayer::ENEMIES;
+    batching = true;
+}
+
+void GraphicsSystem::set_render_layer(RenderLayer layer) {
+    current_layer = layer;
+}
+
+void GraphicsSystem::flush_sprite_batch() {
+    batching = false;
+    if (sprite_queue.empty()) {
         return;
     }
-    
-    SDL_Rect dst_rect = {screen_x, screen_y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, nullptr, &dst_rect);
-    
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
+
+    std::sort(sprite_queue.begin(), sprite_queue.end(),
+              [](const QueuedSprite& a, const QueuedSprite& b) {
+                  // Submission order within a layer: overlapping sprites of
+                  // different textures must not reorder with their addresses
+                  if (a.layer != b.layer) {
+                      return a.layer < b.layer;
+                  }
+                  return a.sequence < b.sequence;
+              });
+
+    // Adjacent sprites that share a texture go out as one run
+    size_t run_start = 0;
+    for (size_t i = 1; i <= sprite_queue.size(); ++i) {
+        if (i == sprite_queue.size() || sprite_queue[i].texture != sprite_queue[run_start].texture) {
+            draw_sprite_run(&sprite_queue[run_start], i - run_start);
+            run_start = i;
+        }
+    }
+
+    frame_stats.draws += static_cast<uint32_t>(sprite_queue.size());
+    sprite_queue.clear();
 }
 
-void GraphicsSystem::render_debug_overlay() {
+void GraphicsSystem::draw_sprite_run(const QueuedSprite* run, size_t count) {
+    SDL_Texture* texture = run[0].texture;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    int tex_w = 0;
+    int tex_h = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &tex_w, &tex_h);
+    if (tex_w <= 0 || tex_h <= 0) {
+        return;
+    }
+
+    batch_vertices.clear();
+    batch_indices.clear();
+    const SDL_Color white = {255, 255, 255, 255};
+    for (size_t i = 0; i < count; ++i) {
+        const QueuedSprite& sprite = run[i];
+
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 1.0f;
+        float v1 = 1.0f;
+        if (sprite.has_src) {
+            u0 = static_cast<float>(sprite.src.x) / tex_w;
+            v0 = static_cast<float>(sprite.src.y) / tex_h;
+            u1 = static_cast<float>(sprite.src.x + sprite.src.w) / tex_w;
+            v1 = static_cast<float>(sprite.src.y + sprite.src.h) / tex_h;
+        }
+        if (sprite.flip_h) {
+            std::swap(u0, u1);
+        }
+
+        const float x0 = static_cast<float>(sprite.dst.x);
+        const float y0 = static_cast<float>(sprite.dst.y);
+        const float x1 = static_cast<float>(sprite.dst.x + sprite.dst.w);
+        const float y1 = static_cast<float>(sprite.dst.y + sprite.dst.h);
+
+        const int base = static_cast<int>(batch_vertices.size());
+        batch_vertices.push_back({{x0, y0}, white, {u0, v0}});
+        batch_vertices.push_back({{x1, y0}, white, {u1, v0}});
+        batch_vertices.push_back({{x1, y1}, white, {u1, v1}});
+        batch_vertices.push_back({{x0, y1}, white, {u0, v1}});
+
+        const int quad_indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+        batch_indices.insert(batch_indices.end(), quad_indices, quad_indices + 6);
+    }
+
+    SDL_RenderGeometry(renderer, texture,
+                       batch_vertices.data(), static_cast<int>(batch_vertices.size()),
+                       batch_indices.data(), static_cast<int>(batch_indices.size()));
+    count_render_call(texture);
+    frame_stats.batches++;
+#else
+    // SDL older than 2.0.18 has no geometry API; keep the sorted order but draw
+    // each sprite individually.
+    for (size_t i = 0; i < count; ++i) {
+        const QueuedSprite& sprite = run[i];
+        SDL_RendererFlip flip = sprite.flip_h ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        SDL_RenderCopyEx(renderer, texture, sprite.has_src ? &sprite.src : nullptr,
+                         &sprite.dst, 0, nullptr, flip);
+        count_render_call(texture);
+        frame_stats.batches++;
+    }
+#endif
+}
+
+void GraphicsSystem::count_render_call(SDL_Texture* texture) {
+    count_event(Counter::RENDER_CALLS);
+    frame_stats.render_calls++;
+    if (texture != last_render_texture) {
+        count_event(Counter::TEXTURE_SWITCHES);
+        frame_stats.texture_switches++;
+        last_render_texture = texture;
+    }
+}
+
+RenderQueueStats GraphicsSystem::get_render_queue_stats() const {
+    return last_frame_stats;
+}
+
+SDL_Renderer* GraphicsSystem::get_renderer() const {
+    return renderer;
+}
+
+void GraphicsSystem::render_text(int screen_x, int screen_y, const std::string& text, SDL_Color color) {
+    render_text(screen_x, screen_y, text.c_str(), color);
+}
+
+void GraphicsSystem::render_text(int screen_x, int screen_y, const char* text, SDL_Color color) {
+    if (debug_atlas == nullptr) {
+        return;  // Font not available
+    }
+    debug_atlas->render_text(screen_x, screen_y, text, color);
+}
+
+void GraphicsSystem::render_debug_overlay(const GameContext& game) {
+    PROFILE_SCOPE(ProfilePhase::DEBUG_OVERLAY);
+
     // Draw a semi-transparent debug indicator in top-left corner
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     
     // Background box
-    SDL_Rect bg_rect = {5, 5, 200, 100};
+    SDL_Rect bg_rect = {5, 5, 200, 160};
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);  // Semi-transparent black
     SDL_RenderFillRect(renderer, &bg_rect);
     
@@ -704,7 +1705,7 @@ void GraphicsSystem::render_debug_overlay() {
     SDL_RenderDrawRect(renderer, &bg_rect);
     
     // Draw noclip indicator if active
-    if (cheat_noclip) {
+    if (game.cheat_noclip) {
         SDL_Rect noclip_indicator = {10, 10, 20, 20};
         SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);  // Green square for noclip
         SDL_RenderFillRect(renderer, &noclip_indicator);
@@ -712,14 +1713,14 @@ void GraphicsSystem::render_debug_overlay() {
     
     // Draw simple bars to visualize velocity
     // Y velocity bar (vertical)
-    int vel_bar_height = std::abs(comic_y_vel) * 2;
+    int vel_bar_height = std::abs(game.comic_y_vel) * 2;
     if (vel_bar_height > 50) vel_bar_height = 50;
     SDL_Rect vel_bar = {40, 50 - vel_bar_height / 2, 10, vel_bar_height};
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);  // Red for velocity
     SDL_RenderFillRect(renderer, &vel_bar);
     
     // X momentum bar (horizontal)
-    int momentum_bar_width = std::abs(comic_x_momentum) * 3;
+    int momentum_bar_width = std::abs(game.comic_x_momentum) * 3;
     if (momentum_bar_width > 50) momentum_bar_width = 50;
     SDL_Rect momentum_bar = {60, 40, momentum_bar_width, 10};
     SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);  // Blue for momentum
@@ -729,15 +1730,198 @@ void GraphicsSystem::render_debug_overlay() {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     
     // Render coordinate information as text
-    if (debug_font != nullptr) {
-        std::ostringstream coord_text;
-        coord_text << "X: " << static_cast<int>(comic_x) << " Y: " << static_cast<int>(comic_y);
-        render_text(10, 70, coord_text.str(), {0, 255, 255, 255});  // Cyan text
+    // Formatted into stack buffers so the overlay does no heap allocation.
+    if (debug_atlas != nullptr) {
+        char text[64];
+        std::snprintf(text, sizeof(text), "X: %d Y: %d",
+                      static_cast<int>(game.comic_x), static_cast<int>(game.comic_y));
+        render_text(10, 70, text, {0, 255, 255, 255});  // Cyan text
         
-        std::ostringstream level_text;
-        level_text << "L" << static_cast<int>(current_level_number) 
-                   << " S" << static_cast<int>(current_stage_number);
-        render_text(10, 85, level_text.str(), {0, 255, 255, 255});  // Cyan text
+        std::snprintf(text, sizeof(text), "L%d S%d",
+                      static_cast<int>(game.current_level_number),
+                      static_cast<int>(game.current_stage_number));
+        render_text(10, 85, text, {0, 255, 255, 255});  // Cyan text
+        
+        std::snprintf(text, sizeof(text), "Sprites: %u in %u batches",
+                      static_cast<unsigned>(last_frame_stats.draws),
+                      static_cast<unsigned>(last_frame_stats.batches));
+        render_text(10, 100, text, {0, 255, 255, 255});  // Cyan text
+        
+        // Texture cache: resident KB, hits/misses, evictions per category
+        static const char* const category_labels[] = {"Tiles", "Enemy", "Sprite"};
+        for (size_t i = 0; i < static_cast<size_t>(TextureCategory::COUNT); ++i) {
+            const TextureCacheStats& stats = texture_stats[i];
+            std::snprintf(text, sizeof(text), "%s %uK %u/%u ev %u",
+                          category_labels[i],
+                          static_cast<unsigned>(stats.resident_bytes / 1024),
+                          static_cast<unsigned>(stats.hits),
+                          static_cast<unsigned>(stats.misses),
+                          static_cast<unsigned>(stats.evictions));
+            render_text(10, 115 + static_cast<int>(i) * 15, text, {255, 255, 0, 255});
+        }
+    }
+
+    render_counters_panel(210, 5);
+    if (is_frame_profiler_enabled()) {
+        render_frame_time_graph(5, 170);
+    }
+}
+
+void GraphicsSystem::render_counters_panel(int x, int y) {
+    if (debug_atlas == nullptr) {
+        return;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_Rect bg_rect = {x, y, 230, 115};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(renderer, &bg_rect);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    uint64_t sounds_accepted = 0;
+    uint64_t sounds_rejected = 0;
+    for (uint8_t priority = 0; priority < COUNTED_SOUND_PRIORITIES; ++priority) {
+        sounds_accepted += get_counter(static_cast<Counter>(static_cast<size_t>(Counter::SOUNDS_ACCEPTED_P0) + priority));
+        sounds_rejected += get_counter(static_cast<Counter>(static_cast<size_t>(Counter::SOUNDS_REJECTED_P0) + priority));
+    }
+
+    const SDL_Color white = {255, 255, 255, 255};
+    char text[64];
+    std::snprintf(text, sizeof(text), "Calls: %u, %u texture switches",
+                  static_cast<unsigned>(last_frame_stats.render_calls),
+                  static_cast<unsigned>(last_frame_stats.texture_switches));
+    render_text(x + 5, y + 5, text, white);
+    std::snprintf(text, sizeof(text), "Decoded: %llu img, %lluK; %llu tex",
+                  static_cast<unsigned long long>(get_counter(Counter::IMAGES_DECODED)),
+                  static_cast<unsigned long long>(get_counter(Counter::IMAGE_BYTES_DECODED) / 1024),
+                  static_cast<unsigned long long>(get_counter(Counter::TEXTURES_CREATED)));
+    render_text(x + 5, y + 20, text, white);
+    std::snprintf(text, sizeof(text), "Sounds: %llu played, %llu refused",
+                  static_cast<unsigned long long>(sounds_accepted),
+                  static_cast<unsigned long long>(sounds_rejected));
+    render_text(x + 5, y + 35, text, white);
+    std::snprintf(text, sizeof(text), "Enemies: %llu spawned, %llu despawned",
+                  static_cast<unsigned long long>(get_counter(Counter::ENEMIES_SPAWNED)),
+                  static_cast<unsigned long long>(get_counter(Counter::ENEMIES_DESPAWNED)));
+    render_text(x + 5, y + 50, text, white);
+    std::snprintf(text, sizeof(text), "Ticks: %llu in %llu frames",
+                  static_cast<unsigned long long>(get_counter(Counter::TICKS_RUN)),
+                  static_cast<unsigned long long>(get_counter(Counter::FRAMES)));
+    render_text(x + 5, y + 65, text, white);
+
+    // Red once the game has fallen behind real time
+    const uint64_t dropped = get_counter(Counter::TICKS_DROPPED);
+    const uint64_t capped = get_counter(Counter::TICK_CAP_FRAMES);
+    const SDL_Color lag_color = (dropped > 0 || capped > 0) ? SDL_Color{255, 80, 80, 255} : SDL_Color{0, 255, 0, 255};
+    std::snprintf(text, sizeof(text), "Tick cap hit: %llu frames",
+                  static_cast<unsigned long long>(capped));
+    render_text(x + 5, y + 80, text, lag_color);
+    std::snprintf(text, sizeof(text), "Ticks dropped: %llu",
+                  static_cast<unsigned long long>(dropped));
+    render_text(x + 5, y + 95, text, lag_color);
+}
+
+void GraphicsSystem::render_frame_time_graph(int x, int y) {
+    constexpr int GRAPH_FRAMES = 120;
+    constexpr int BAR_WIDTH = 2;
+    constexpr int GRAPH_HEIGHT = 150;
+    constexpr float GRAPH_MS = 33.3f;         // Full height: two 60 Hz frames
+    constexpr float FRAME_BUDGET_MS = 16.7f;  // Reference line
+    // One colour per ProfilePhase; IDLE is not drawn
+    static const SDL_Color phase_colors[PROFILE_PHASE_COUNT] = {
+        {128, 128, 128, 255}, {0, 160, 255, 255},  {255, 80, 80, 255},   {255, 160, 0, 255},
+        {80, 200, 80, 255},   {200, 0, 200, 255},  {255, 255, 80, 255},  {0, 220, 220, 255},
+        {160, 120, 255, 255}, {255, 255, 255, 255}, {255, 120, 180, 255}, {110, 70, 40, 255},
+        {0, 0, 0, 0},
+    };
+
+    ProfileFrame frames[GRAPH_FRAMES];
+    const size_t count = copy_recent_profile_frames(frames, GRAPH_FRAMES);
+
+    const int graph_width = GRAPH_FRAMES * BAR_WIDTH;
+    const int legend_x = x + graph_width + 10;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    // Tall enough for a legend row per phase plus the pacing rows
+    SDL_Rect bg_rect = {x, y, graph_width + 150, std::max(GRAPH_HEIGHT + 10, static_cast<int>(PROFILE_PHASE_COUNT + 1) * 14 + 10)};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(renderer, &bg_rect);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    // Stack the phases bottom-up; one SDL_RenderFillRects call per phase
+    const int base_y = y + 5 + GRAPH_HEIGHT;
+    constexpr float pixels_per_ms = GRAPH_HEIGHT / GRAPH_MS;
+    float stacked_ms[GRAPH_FRAMES] = {};
+    float average_ms[PROFILE_PHASE_COUNT] = {};
+    SDL_Rect bars[GRAPH_FRAMES];
+    for (size_t phase = 0; phase + 1 < PROFILE_PHASE_COUNT; ++phase) {
+        int bar_count = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const float ms = frames[i].phase_ms[phase];
+            average_ms[phase] += ms / static_cast<float>(count);
+            const int bottom = base_y - static_cast<int>(stacked_ms[i] * pixels_per_ms);
+            stacked_ms[i] = std::min(GRAPH_MS, stacked_ms[i] + ms);
+            const int top = base_y - static_cast<int>(stacked_ms[i] * pixels_per_ms);
+            if (bottom > top) {
+                bars[bar_count++] = {x + 5 + static_cast<int>(GRAPH_FRAMES - count + i) * BAR_WIDTH, top,
+                                     BAR_WIDTH, bottom - top};
+            }
+        }
+        const SDL_Color& color = phase_colors[phase];
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        if (bar_count > 0) {
+            SDL_RenderFillRects(renderer, bars, bar_count);
+        }
+    }
+
+    const int budget_y = base_y - static_cast<int>(FRAME_BUDGET_MS * pixels_per_ms);
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+    SDL_RenderDrawLine(renderer, x + 5, budget_y, x + 5 + graph_width, budget_y);
+
+    // Legend: colour and average ms over the graphed frames, then the
+    // present-to-present interval, its jitter and the share of the frame
+    // not spent sleeping
+    if (debug_atlas != nullptr) {
+        char text[48];
+        int row = 0;
+        for (size_t phase = 0; phase + 1 < PROFILE_PHASE_COUNT; ++phase) {
+            if (average_ms[phase] < 0.01f) {
+                continue;
+            }
+            const int row_y = y + 5 + row * 14;
+            const SDL_Color& color = phase_colors[phase];
+            SDL_Rect swatch = {legend_x, row_y + 2, 6, 6};
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_RenderFillRect(renderer, &swatch);
+            std::snprintf(text, sizeof(text), "%s %.2f", get_profile_phase_name(static_cast<ProfilePhase>(phase)),
+                          average_ms[phase]);
+            render_text(legend_x + 10, row_y, text, color);
+            ++row;
+        }
+
+        float interval_sum = 0.0f;
+        float interval_square_sum = 0.0f;
+        float frame_sum = 0.0f;
+        float idle_sum = 0.0f;
+        int intervals = 0;
+        for (size_t i = 0; i < count; ++i) {
+            frame_sum += frames[i].total_ms();
+            idle_sum += frames[i].phase_ms[static_cast<size_t>(ProfilePhase::IDLE)];
+            if (frames[i].present_interval_ms > 0.0f) {
+                interval_sum += frames[i].present_interval_ms;
+                interval_square_sum += frames[i].present_interval_ms * frames[i].present_interval_ms;
+                ++intervals;
+            }
+        }
+        if (intervals > 0) {
+            const float mean = interval_sum / static_cast<float>(intervals);
+            const float jitter = std::sqrt(std::max(0.0f, interval_square_sum / static_cast<float>(intervals) - mean * mean));
+            std::snprintf(text, sizeof(text), "present %.1f +-%.2f", mean, jitter);
+            render_text(legend_x, y + 5 + row * 14, text, {255, 255, 255, 255});
+            ++row;
+        }
+        if (frame_sum > 0.0f) {
+            std::snprintf(text, sizeof(text), "cpu %.0f%%", 100.0f * (1.0f - idle_sum / frame_sum));
+            render_text(legend_x, y + 5 + row * 14, text, {255, 255, 255, 255});
+        }
     }
 }
 
@@ -761,40 +1945,144 @@ SDL_Rect GraphicsSystem::compute_letterbox_rect(SDL_Renderer* renderer) {
     return rect;
 }
 
+bool GraphicsSystem::set_native_framebuffer_enabled(bool enabled) {
+    if (!enabled) {
+        if (native_frame) {
+            SDL_DestroyTexture(native_frame);
+            native_frame = nullptr;
+        }
+        native_frame_bound = false;
+        return true;
+    }
+
+    if (native_frame) {
+        return true;
+    }
+
+    if (renderer == nullptr || !SDL_RenderTargetSupported(renderer)) {
+        std::cerr << "Warning: Render targets unsupported; native framebuffer disabled" << std::endl;
+        return false;
+    }
+
+    native_frame = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                     SDL_TEXTUREACCESS_TARGET, EGA_WIDTH, EGA_HEIGHT);
+    if (native_frame == nullptr) {
+        std::cerr << "Warning: Failed to create native framebuffer: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    // Keep EGA pixels sharp when the frame is stretched to the window.
+    SDL_SetTextureScaleMode(native_frame, SDL_ScaleModeNearest);
+    return true;
+}
+
+bool GraphicsSystem::is_native_framebuffer_enabled() const {
+    return native_frame != nullptr;
+}
+
+void GraphicsSystem::begin_frame() {
+    last_frame_stats = frame_stats;
+    frame_stats = RenderQueueStats();
+    last_render_texture = nullptr;  // Whatever was bound last frame, the HUD and text drew since
+
+    if (native_frame) {
+        native_frame_bound = SDL_SetRenderTarget(renderer, native_frame) == 0;
+        if (!native_frame_bound) {
+            std::cerr << "Warning: Failed to bind native framebuffer: " << SDL_GetError() << std::endl;
+        }
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+}
+
+void GraphicsSystem::end_frame() {
+    if (!native_frame_bound) {
+        return;
+    }
+
+    SDL_RenderSetViewport(renderer, nullptr);
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_SetRenderTarget(renderer, frame_target);
+    native_frame_bound = false;
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_Rect dst = compute_letterbox_rect(renderer);
+    SDL_RenderCopy(renderer, native_frame, nullptr, &dst);
+    count_render_call(native_frame);
+}
+
+void GraphicsSystem::set_frame_target(SDL_Texture* target) {
+    frame_target = target;
+}
+
+SDL_Rect GraphicsSystem::get_gameplay_frame_rect() const {
+    if (native_frame_bound) {
+        return {0, 0, EGA_WIDTH, EGA_HEIGHT};
+    }
+    return compute_letterbox_rect(renderer);
+}
+
 void GraphicsSystem::cleanup() {
+    // Stop the decode workers first; dropped requests free their own surfaces
+    pending_tilesets.clear();
+    pending_enemy_sprites.clear();
+    pending_sprites.clear();
+    decode_pool.reset();
+    
+    // Clean up native framebuffer
+    set_native_framebuffer_enabled(false);
+    
+    // Clean up stage background cache
+    for (StageChunk& slot : stage_chunks) {
+        if (slot.texture) {
+            SDL_DestroyTexture(slot.texture);
+        }
+        slot = StageChunk();
+    }
+    stage_background_tileset = nullptr;
+    
     // Clean up tilesets
-    for (auto& pair : tilesets) {
-        pair.second.cleanup();
+    for (auto& entry : tilesets) {
+        entry->tileset.cleanup();
     }
     tilesets.clear();
+    tileset_ids.clear();
+    for (TextureCacheStats& stats : texture_stats) {
+        stats = TextureCacheStats();
+    }
     
     // Clean up sprites
-    for (auto& pair : sprites) {
-        if (pair.second.texture.texture) {
-            SDL_DestroyTexture(pair.second.texture.texture);
+    for (auto& sprite : sprites) {
+        if (sprite.texture.texture) {
+            SDL_DestroyTexture(sprite.texture.texture);
         }
     }
     sprites.clear();
+    sprite_ids.clear();
     
     // Clean up enemy sprites
-    for (auto& pair : enemy_sprites) {
-        if (pair.second) {
-            for (auto& frame : pair.second->frames_left) {
+    for (auto& entry : enemy_sprites) {
+        if (entry.data) {
+            for (auto& frame : entry.data->frames_left) {
                 if (frame.texture) {
                     SDL_DestroyTexture(frame.texture);
                 }
             }
-            for (auto& frame : pair.second->frames_right) {
+            for (auto& frame : entry.data->frames_right) {
                 if (frame.texture) {
                     SDL_DestroyTexture(frame.texture);
                 }
             }
-            delete pair.second;
+            delete entry.data;
         }
     }
     enemy_sprites.clear();
     
-    // Clean up fonts
+    // Clean up fonts. Atlases are textures on our renderer, so drop them
+    // (including the title screens' shared ones) before it goes away.
+    debug_atlas = nullptr;
+    release_glyph_atlases(renderer);
     if (debug_font != nullptr) {
         TTF_CloseFont(debug_font);
         debug_font = nullptr;
@@ -812,10 +2100,13 @@ void GraphicsSystem::cleanup() {
 }
 
 void Tileset::cleanup() {
-    for (auto& pair : tiles) {
-        if (pair.second.texture) {
-            SDL_DestroyTexture(pair.second.texture);
-        }
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+    for (int i = 0; i < TILESET_TABLE_SIZE; i++) {
+        present[i] = false;
+        src_rects[i] = {0, 0, 0, 0};
     }
-    tiles.clear();
+    tile_count = 0;
 }
@@ -0,0 +1,82 @@
+/**
+ * input_latency.cpp - Key press to present timing
+ */
+
+#include "../include/input_latency.h"
+#include "../include/replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+void InputLatencyTracker::record_press(uint8_t keys, uint32_t event_ms, uint32_t poll_ms) {
+    if (!enabled) {
+        return;
+    }
+    for (uint8_t key = INPUT_LEFT; key & INPUT_KEYS_MASK; key = static_cast<uint8_t>(key << 1)) {
+        if ((keys & key) == 0) {
+            continue;
+        }
+        OpenPress press;
+        press.sample.key = key;
+        press.sample.event_ms = event_ms;
+        press.sample.poll_ms = poll_ms;
+        open_presses.push_back(press);
+    }
+}
+
+void InputLatencyTracker::record_release(uint8_t keys) {
+    if (!enabled) {
+        return;
+    }
+    // A key let go before any tick looked at it never reached the game
+    const auto lost = std::remove_if(open_presses.begin(), open_presses.end(), [keys](const OpenPress& press) {
+        return !press.ticked && (press.sample.key & keys) != 0;
+    });
+    lost_presses += static_cast<uint64_t>(open_presses.end() - lost);
+    open_presses.erase(lost, open_presses.end());
+}
+
+void InputLatencyTracker::record_tick(uint64_t tick, uint32_t now_ms) {
+    for (auto& press : open_presses) {
+        if (!press.ticked) {
+            press.ticked = true;
+            press.sample.tick = tick;
+            press.sample.tick_ms = now_ms;
+        }
+    }
+}
+
+void InputLatencyTracker::record_present(uint32_t now_ms) {
+    size_t kept = 0;
+    for (auto& press : open_presses) {
+        if (!press.ticked) {
+            open_presses[kept++] = press;
+            continue;
+        }
+        samples.push_back(press.sample);
+        samples.back().present_ms = now_ms;
+    }
+    open_presses.resize(kept);
+}
+
+void InputLatencyTracker::discard_pending() {
+    open_presses.clear();
+}
+
+bool InputLatencyTracker::write_csv(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open latency log: " << path << std::endl;
+        return false;
+    }
+    file << "key,event_ms,poll_ms,tick,tick_ms,present_ms\n";
+    for (const auto& sample : samples) {
+        file << static_cast<int>(sample.key) << ',' << sample.event_ms << ',' << sample.poll_ms << ','
+             << sample.tick << ',' << sample.tick_ms << ',' << sample.present_ms << '\n';
+    }
+    if (!file) {
+        std::cerr << "Failed to write latency log: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -3,14 +3,19 @@
  * 
  * Contains the static data for all 8 levels in the game.
  * This data was originally in R3_levels.asm from the reference implementation.
+ *
+ * The tables are constexpr, so they are constant-initialised into read-only
+ * data along with the tile maps of level_tiles.cpp they point at; nothing is
+ * copied at startup and the pages can be shared between game processes.
  */
 
 #include "../include/level.h"
+#include "../include/level_tiles.h"
 #include <algorithm>
 #include <cctype>
 
 /* ===== LAKE Level Data ===== */
-const level_t level_data_lake = {
+constexpr level_t level_data_lake = {
     /* Filenames */
     .tt2_filename = "LAKE.TT2    ",
     .pt0_filename = "LAKE0.PT    ",
@@ -56,7 +61,8 @@ const level_t level_data_lake = {
                 {0, ENEMY_BEHAVIOR_UNUSED},
                 {1, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_LEAP}
-            }
+            },
+            .tiles = {lake_stage_0_tiles}
         },
         /* lake1 */
         {
@@ -75,7 +81,8 @@ const level_t level_data_lake = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_LEAP}
-            }
+            },
+            .tiles = {lake_stage_1_tiles}
         },
         /* lake2 */
         {
@@ -94,13 +101,14 @@ const level_t level_data_lake = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_LEAP}
-            }
+            },
+            .tiles = {lake_stage_2_tiles}
         }
     }
 };
 
 /* ===== FOREST Level Data ===== */
-const level_t level_data_forest = {
+constexpr level_t level_data_forest = {
     /* Filenames */
     .tt2_filename = "FOREST.TT2  ",
     .pt0_filename = "FOREST0.PT  ",
@@ -146,7 +154,8 @@ const level_t level_data_forest = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {0, ENEMY_BEHAVIOR_UNUSED},
                 {0, ENEMY_BEHAVIOR_UNUSED}
-            }
+            },
+            .tiles = {forest_stage_0_tiles}
         },
         /* forest1 */
         {
@@ -165,7 +174,8 @@ const level_t level_data_forest = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {0, ENEMY_BEHAVIOR_UNUSED},
                 {1, ENEMY_BEHAVIOR_SHY}
-            }
+            },
+            .tiles = {forest_stage_1_tiles}
         },
         /* forest2 */
         {
@@ -184,13 +194,14 @@ const level_t level_data_forest = {
                 {1, ENEMY_BEHAVIOR_SHY},
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_SHY}
-            }
+            },
+            .tiles = {forest_stage_2_tiles}
         }
     }
 };
 
 /* ===== SPACE Level Data ===== */
-const level_t level_data_space = {
+constexpr level_t level_data_space = {
     /* Filenames */
     .tt2_filename = "SPACE.TT2   ",
     .pt0_filename = "SPACE0.PT   ",
@@ -236,7 +247,8 @@ const level_t level_data_space = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {0, ENEMY_BEHAVIOR_BOUNCE}
-            }
+            },
+            .tiles = {space_stage_0_tiles}
         },
         /* space1 */
         {
@@ -255,7 +267,8 @@ const level_t level_data_space = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_BOUNCE}
-            }
+            },
+            .tiles = {space_stage_1_tiles}
         },
         /* space2 */
         {
@@ -274,13 +287,14 @@ const level_t level_data_space = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_BOUNCE | ENEMY_BEHAVIOR_FAST}
-            }
+            },
+            .tiles = {space_stage_2_tiles}
         }
     }
 };
 
 /* ===== BASE Level Data ===== */
-const level_t level_data_base = {
+constexpr level_t level_data_base = {
     /* Filenames */
     .tt2_filename = "BASE.TT2    ",
     .pt0_filename = "BASE0.PT    ",
@@ -326,7 +340,8 @@ const level_t level_data_base = {
                 {0, ENEMY_BEHAVIOR_LEAP},
                 {0, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_ROLL}
-            }
+            },
+            .tiles = {base_stage_0_tiles}
         },
         /* base1 */
         {
@@ -345,7 +360,8 @@ const level_t level_data_base = {
                 {0, ENEMY_BEHAVIOR_LEAP},
                 {0, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_ROLL}
-            }
+            },
+            .tiles = {base_stage_1_tiles}
         },
         /* base2 */
         {
@@ -364,13 +380,14 @@ const level_t level_data_base = {
                 {0, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_ROLL},
                 {1, ENEMY_BEHAVIOR_ROLL | ENEMY_BEHAVIOR_FAST}
-            }
+            },
+            .tiles = {base_stage_2_tiles}
         }
     }
 };
 
 /* ===== CAVE Level Data ===== */
-const level_t level_data_cave = {
+constexpr level_t level_data_cave = {
     /* Filenames */
     .tt2_filename = "CAVE.TT2    ",
     .pt0_filename = "CAVE0.PT    ",
@@ -416,7 +433,8 @@ const level_t level_data_cave = {
                 {0, ENEMY_BEHAVIOR_LEAP},
                 {0, ENEMY_BEHAVIOR_LEAP | ENEMY_BEHAVIOR_FAST},
                 {1, ENEMY_BEHAVIOR_SEEK}
-            }
+            },
+            .tiles = {cave_stage_0_tiles}
         },
         /* cave1 */
         {
@@ -435,7 +453,8 @@ const level_t level_data_cave = {
                 {0, ENEMY_BEHAVIOR_LEAP | ENEMY_BEHAVIOR_FAST},
                 {1, ENEMY_BEHAVIOR_SEEK},
                 {1, ENEMY_BEHAVIOR_SEEK}
-            }
+            },
+            .tiles = {cave_stage_1_tiles}
         },
         /* cave2 */
         {
@@ -454,13 +473,14 @@ const level_t level_data_cave = {
                 {0, ENEMY_BEHAVIOR_LEAP | ENEMY_BEHAVIOR_FAST},
                 {1, ENEMY_BEHAVIOR_SEEK},
                 {1, ENEMY_BEHAVIOR_SEEK}
-            }
+            },
+            .tiles = {cave_stage_2_tiles}
         }
     }
 };
 
 /* ===== SHED Level Data ===== */
-const level_t level_data_shed = {
+constexpr level_t level_data_shed = {
     /* Filenames */
     .tt2_filename = "SHED.TT2    ",
     .pt0_filename = "SHED0.PT    ",
@@ -506,7 +526,8 @@ const level_t level_data_shed = {
                 {0, ENEMY_BEHAVIOR_BOUNCE},
                 {1, ENEMY_BEHAVIOR_SEEK},
                 {2, ENEMY_BEHAVIOR_LEAP}
-            }
+            },
+            .tiles = {shed_stage_0_tiles}
         },
         /* shed1 */
         {
@@ -525,7 +546,8 @@ const level_t level_data_shed = {
                 {1, ENEMY_BEHAVIOR_SEEK},
                 {2, ENEMY_BEHAVIOR_LEAP},
                 {2, ENEMY_BEHAVIOR_LEAP}
-            }
+            },
+            .tiles = {shed_stage_1_tiles}
         },
         /* shed2 */
         {
@@ -544,13 +566,14 @@ const level_t level_data_shed = {
                 {1, ENEMY_BEHAVIOR_SEEK},
                 {2, ENEMY_BEHAVIOR_LEAP},
                 {2, ENEMY_BEHAVIOR_LEAP | ENEMY_BEHAVIOR_FAST}
-            }
+            },
+            .tiles = {shed_stage_2_tiles}
         }
     }
 };
 
 /* ===== CASTLE Level Data ===== */
-const level_t level_data_castle = {
+constexpr level_t level_data_castle = {
     /* Filenames */
     .tt2_filename = "CASTLE.TT2  ",
     .pt0_filename = "CASTLE0.PT  ",
@@ -596,7 +619,8 @@ const level_t level_data_castle = {
                 {1, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_LEAP | ENEMY_BEHAVIOR_FAST},
                 {3, ENEMY_BEHAVIOR_SEEK}
-            }
+            },
+            .tiles = {castle_stage_0_tiles}
         },
         /* castle1 */
         {
@@ -615,7 +639,8 @@ const level_t level_data_castle = {
                 {1, ENEMY_BEHAVIOR_LEAP},
                 {1, ENEMY_BEHAVIOR_LEAP | ENEMY_BEHAVIOR_FAST},
                 {2, ENEMY_BEHAVIOR_SHY}
-            }
+            },
+            .tiles = {castle_stage_1_tiles}
         },
         /* castle2 */
         {
@@ -634,13 +659,14 @@ const level_t level_data_castle = {
                 {2, ENEMY_BEHAVIOR_SHY | ENEMY_BEHAVIOR_FAST},
                 {3, ENEMY_BEHAVIOR_SEEK},
                 {3, ENEMY_BEHAVIOR_SEEK | ENEMY_BEHAVIOR_FAST}
-            }
+            },
+            .tiles = {castle_stage_2_tiles}
         }
     }
 };
 
 /* ===== COMP Level Data ===== */
-const level_t level_data_comp = {
+constexpr level_t level_data_comp = {
     /* Filenames */
     .tt2_filename = "COMP.TT2    ",
     .pt0_filename = "COMP0.PT    ",
@@ -686,7 +712,8 @@ const level_t level_data_comp = {
                 {1, ENEMY_BEHAVIOR_BOUNCE},
                 {2, ENEMY_BEHAVIOR_BOUNCE},
                 {0, ENEMY_BEHAVIOR_UNUSED}
-            }
+            },
+            .tiles = {comp_stage_0_tiles}
         },
         /* comp1 */
         {
@@ -705,7 +732,8 @@ const level_t level_data_comp = {
                 {1, ENEMY_BEHAVIOR_BOUNCE | ENEMY_BEHAVIOR_FAST},
                 {2, ENEMY_BEHAVIOR_BOUNCE | ENEMY_BEHAVIOR_FAST},
                 {0, ENEMY_BEHAVIOR_UNUSED}
-            }
+            },
+            .tiles = {comp_stage_1_tiles}
         },
         /* comp2 */
         {
@@ -724,7 +752,8 @@ const level_t level_data_comp = {
                 {1, ENEMY_BEHAVIOR_BOUNCE | ENEMY_BEHAVIOR_FAST},
                 {2, ENEMY_BEHAVIOR_BOUNCE | ENEMY_BEHAVIOR_FAST},
                 {0, ENEMY_BEHAVIOR_UNUSED}
-            }
+            },
+            .tiles = {comp_stage_2_tiles}
         }
     }
 };
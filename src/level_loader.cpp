@@ -1,90 +1,121 @@
 /**
  * level_loader.cpp - Runtime level data initialization
  * 
- * Initializes level data with pre-generated tile data from level_tiles.cpp.
- * Tile data is compiled directly into the executable as C++ hex arrays,
- * eliminating all runtime file I/O dependencies.
+ * Level tables (level_data.cpp) and tile maps (level_tiles.cpp) are compiled
+ * directly into the executable as constant data, eliminating all runtime file
+ * I/O dependencies and any startup copying.
  */
 
 #include "../include/level_loader.h"
-#include "../include/level_tiles.h"
 #include "../include/physics.h"
 #include "../include/graphics.h"
 #include "../include/actors.h"
+#include "../include/game_context.h"
+#include "../include/tile_map.h"
+#include <atomic>
+#include <cctype>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
 
-/* External game state (defined in main.cpp) */
-extern int comic_x;
-extern int comic_y;
-extern int8_t comic_y_vel;
-extern uint8_t current_level_number;
-extern uint8_t current_stage_number;
-extern const level_t* current_level_ptr;
-extern int8_t source_door_level_number;
-extern int8_t source_door_stage_number;
-extern uint8_t comic_x_checkpoint;
-extern uint8_t comic_y_checkpoint;
-extern int camera_x;
-extern GraphicsSystem* g_graphics;
-extern ActorSystem* g_actor_system;
-
-/* Runtime mutable copies of level data */
-static level_t runtime_levels[8];
-static bool levels_initialized = false;
+/* Process-wide: the level tables are shared by every game context */
+static std::atomic<bool> levels_initialized(false);
+
+/* Prefetcher statistics (contexts without graphics still count requests) */
+static std::atomic<uint32_t> prefetch_stages_requested(0);
+static std::atomic<uint32_t> prefetch_escalations(0);
+static std::atomic<uint32_t> prefetch_hits(0);
+static std::atomic<uint32_t> prefetch_misses(0);
 
 /* Names corresponding to level numbers */
 static const char* level_names[] = {
     "lake", "forest", "space", "base", "cave", "shed", "castle", "comp"
 };
 
-/* Pointers to source const data */
-static const level_t* source_levels[8] = {
-    &level_data_lake,
-    &level_data_forest,
-    &level_data_space,
-    &level_data_base,
-    &level_data_cave,
-    &level_data_shed,
-    &level_data_castle,
-    &level_data_comp
-};
-
-/* Pre-generated tile data arrays (from level_tiles.cpp) */
-static const uint8_t* tile_arrays[8][3] = {
-    {lake_stage_0_tiles, lake_stage_1_tiles, lake_stage_2_tiles},
-    {forest_stage_0_tiles, forest_stage_1_tiles, forest_stage_2_tiles},
-    {space_stage_0_tiles, space_stage_1_tiles, space_stage_2_tiles},
-    {base_stage_0_tiles, base_stage_1_tiles, base_stage_2_tiles},
-    {cave_stage_0_tiles, cave_stage_1_tiles, cave_stage_2_tiles},
-    {shed_stage_0_tiles, shed_stage_1_tiles, shed_stage_2_tiles},
-    {castle_stage_0_tiles, castle_stage_1_tiles, castle_stage_2_tiles},
-    {comp_stage_0_tiles, comp_stage_1_tiles, comp_stage_2_tiles}
-};
+/* Streamed maps standing in for built-in stages, opened once per process */
+static std::mutex stage_tile_maps_mutex;
+static std::unique_ptr<TileMap> stage_tile_maps[8][3];
+static bool stage_tile_maps_found = false;
 
-void initialize_level_data() {
-    if (levels_initialized) {
+/* Open assets/maps/<pt filename>.cctm for every stage that has one */
+static void find_stage_tile_maps() {
+    std::lock_guard<std::mutex> lock(stage_tile_maps_mutex);
+    if (stage_tile_maps_found) {
         return;
     }
-    
-    /* Copy const level data into runtime structures and populate with tile data */
-    for (int level_num = 0; level_num < 8; level_num++) {
-        /* Copy entire const level data into runtime mutable copy */
-        std::memcpy(&runtime_levels[level_num], source_levels[level_num], 
-                    sizeof(level_t));
-        
-        /* Overwrite tile data with pre-generated arrays for each of the 3 stages */
-        for (int stage_num = 0; stage_num < 3; stage_num++) {
-            std::memcpy(runtime_levels[level_num].stages[stage_num].tiles,
-                       tile_arrays[level_num][stage_num], 
-                       128 * 10);
+    stage_tile_maps_found = true;
+
+    static const char* const prefixes[] = {"assets/maps/", "../assets/maps/", "../../assets/maps/"};
+    for (int level = 0; level < 8; level++) {
+        const level_t& data = *level_data_pointers[level];
+        const char* pt_filenames[3] = {data.pt0_filename, data.pt1_filename, data.pt2_filename};
+        for (int stage = 0; stage < 3; stage++) {
+            /* Space-padded, e.g. "FOREST0.PT  " -> forest0.pt */
+            std::string name(pt_filenames[stage], strnlen(pt_filenames[stage], sizeof(data.pt0_filename)));
+            name.erase(name.find_last_not_of(' ') + 1);
+            for (char& c : name) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            for (const char* prefix : prefixes) {
+                std::unique_ptr<TileMap> map(new TileMap());
+                if (map->open(prefix + name + ".cctm")) {
+                    std::cout << "Streaming " << level_names[level] << " stage " << stage << " from "
+                              << prefix << name << ".cctm (" << map->get_width_tiles() << " tiles wide)"
+                              << std::endl;
+                    stage_tile_maps[level][stage] = std::move(map);
+                    break;
+                }
+            }
         }
     }
-    
+}
+
+void initialize_level_data() {
+    /* Nothing to copy: stages view the constant tile maps in place */
+    find_stage_tile_maps();
     levels_initialized = true;
 }
 
-level_t* get_level_data(const std::string& level_name) {
+const TileMap* get_stage_tile_map(const level_t* level, int stage_number) {
+    if (stage_number < 0 || stage_number >= 3) {
+        return nullptr;
+    }
+    for (int i = 0; i < 8; i++) {
+        if (level_data_pointers[i] == level) {
+            std::lock_guard<std::mutex> lock(stage_tile_maps_mutex);
+            return stage_tile_maps[i][stage_number].get();
+        }
+    }
+    return nullptr;
+}
+
+bool attach_stage_tile_map(uint8_t level_number, uint8_t stage_number, const std::string& path) {
+    if (level_number >= 8 || stage_number >= 3) {
+        return false;
+    }
+    find_stage_tile_maps();
+    std::unique_ptr<TileMap> map(new TileMap());
+    if (!map->open(path)) {
+        std::cerr << "Error: Failed to open tile map " << path << std::endl;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(stage_tile_maps_mutex);
+    stage_tile_maps[level_number][stage_number] = std::move(map);
+    return true;
+}
+
+void detach_stage_tile_maps() {
+    find_stage_tile_maps();
+    std::lock_guard<std::mutex> lock(stage_tile_maps_mutex);
+    for (auto& level : stage_tile_maps) {
+        for (std::unique_ptr<TileMap>& map : level) {
+            map.reset();
+        }
+    }
+}
+
+const level_t* get_level_data(const std::string& level_name) {
     if (!levels_initialized) {
         std::cerr << "Error: Level data not initialized. Call initialize_level_data() first." << std::endl;
         return nullptr;
@@ -96,54 +127,169 @@ level_t* get_level_data(const std::string& level_name) {
         return nullptr;
     }
     
-    /* Find which level this is */
-    for (int i = 0; i < 8; i++) {
-        if (source_levels[i] == result) {
-            return &runtime_levels[i];
+    return result;
+}
+
+/* Enemy sprite descriptors used by live slots of a stage (what
+ * ActorSystem::setup_enemies_for_stage will load) */
+template <typename Fn>
+static void for_each_stage_enemy_sprite(const level_t& level, uint8_t stage_number, Fn fn) {
+    const stage_t& stage = level.stages[stage_number];
+    for (int i = 0; i < MAX_NUM_ENEMIES; i++) {
+        const enemy_record_t& record = stage.enemies[i];
+        if ((record.behavior & ~ENEMY_BEHAVIOR_FAST) >= ENEMY_BEHAVIOR_UNUSED || record.shp_index >= 4) {
+            continue;
         }
+        fn(level.shp[record.shp_index]);
     }
-    
-    return nullptr;
 }
 
+static void prefetch_stage(GraphicsSystem* graphics, uint8_t level_number, uint8_t stage_number, bool urgent) {
+    if (!graphics || level_number >= 8 || stage_number >= 3) {
+        return;
+    }
+
+    /* Requested assets are also pinned in the texture cache until the next
+     * stage change picks a new pin set */
+    graphics->request_tileset(level_names[level_number], urgent);
+    graphics->pin_tileset(level_names[level_number]);
+    for_each_stage_enemy_sprite(*level_data_pointers[level_number], stage_number,
+        [graphics, urgent](const shp_t& sprite_desc) {
+            graphics->request_enemy_sprite(sprite_desc, urgent);
+            graphics->pin_enemy_sprite(sprite_desc);
+        });
+}
+
+/* Count a stage entry as a prefetch hit or miss before its assets are loaded */
+static void record_stage_entry(GameContext& game, uint8_t level_number, uint8_t stage_number) {
+    if (!game.first_stage_loaded) {
+        game.first_stage_loaded = true;
+        return;
+    }
+    GraphicsSystem* graphics = game.graphics;
+    if (!graphics || level_number >= 8 || stage_number >= 3) {
+        return;
+    }
+
+    bool ready = graphics->is_tileset_ready(level_names[level_number]);
+    for_each_stage_enemy_sprite(*level_data_pointers[level_number], stage_number,
+        [graphics, &ready](const shp_t& sprite_desc) {
+            if (!graphics->is_enemy_sprite_ready(sprite_desc)) {
+                ready = false;
+            }
+        });
+
+    if (ready) {
+        prefetch_hits++;
+    } else {
+        prefetch_misses++;
+    }
+}
+
+void prefetch_stage_neighbours(GameContext& game) {
+    if (!levels_initialized || game.current_level_number >= 8 || game.current_stage_number >= 3) {
+        return;
+    }
+
+    /* The current stage is needed right away; its neighbours may be soon */
+    if (game.graphics) {
+        game.graphics->begin_texture_pins();
+    }
+    prefetch_stage(game.graphics, game.current_level_number, game.current_stage_number, true);
+
+    const stage_t& stage = level_data_pointers[game.current_level_number]->stages[game.current_stage_number];
+    if (stage.exit_l != EXIT_UNUSED) {
+        prefetch_stage(game.graphics, game.current_level_number, stage.exit_l, false);
+        prefetch_stages_requested++;
+    }
+    if (stage.exit_r != EXIT_UNUSED) {
+        prefetch_stage(game.graphics, game.current_level_number, stage.exit_r, false);
+        prefetch_stages_requested++;
+    }
+    for (int i = 0; i < MAX_NUM_DOORS; i++) {
+        const door_t& door = stage.doors[i];
+        if (door.x == DOOR_UNUSED || door.y == DOOR_UNUSED) {
+            continue;
+        }
+        prefetch_stage(game.graphics, door.target_level, door.target_stage, false);
+        prefetch_stages_requested++;
+    }
+}
+
+void prefetch_door_destination(GameContext& game, uint8_t level_number, uint8_t stage_number) {
+    if (!levels_initialized) {
+        return;
+    }
+    prefetch_stage(game.graphics, level_number, stage_number, true);
+    prefetch_escalations++;
+}
+
+void prefetch_starting_stage(GraphicsSystem* graphics) {
+    initialize_level_data();
+    prefetch_stage(graphics, LEVEL_NUMBER_FOREST, 0, false);
+}
+
+PrefetchStats get_prefetch_stats() {
+    return {prefetch_stages_requested.load(), prefetch_escalations.load(),
+            prefetch_hits.load(), prefetch_misses.load()};
+}
+
+void reset_prefetch_stats() {
+    prefetch_stages_requested = 0;
+    prefetch_escalations = 0;
+    prefetch_hits = 0;
+    prefetch_misses = 0;
+}
+
+static void load_stage(GameContext& game, bool entry_recorded);
+
 /**
  * load_new_level - Load a new level's data and assets
  * 
  * Called when transitioning to a different level (via door or level change).
  * Loads the level's tileset graphics and initializes the first stage.
  */
-void load_new_level() {
+void load_new_level(GameContext& game) {
     if (!levels_initialized) {
         std::cerr << "Error: Level data not initialized!" << std::endl;
         return;
     }
     
     /* Validate level number */
-    if (current_level_number >= 8) {
-        std::cerr << "Error: Invalid level number: " << static_cast<int>(current_level_number) << std::endl;
+    if (game.current_level_number >= 8) {
+        std::cerr << "Error: Invalid level number: " << static_cast<int>(game.current_level_number) << std::endl;
         return;
     }
     
-    /* Set current level pointer to runtime data (includes populated tiles) */
-    current_level_ptr = &runtime_levels[current_level_number];
+    /* Set current level pointer (the constant table views its tile maps) */
+    game.current_level_ptr = level_data_pointers[game.current_level_number];
+    set_level_solidity(game, game.current_level_ptr);
+
+    if (game.current_stage_number < 3) {
+        record_stage_entry(game, game.current_level_number, game.current_stage_number);
+    }
     
     /* Load tileset graphics for this level */
-    if (g_graphics) {
-        std::string level_name = level_names[current_level_number];
-        if (!g_graphics->load_tileset(level_name)) {
-            std::cerr << "Warning: Failed to load tileset for level: " << level_name << std::endl;
-            /* Continue anyway - may work with existing tileset */
-        }
+    load_level_graphics(game);
+    
+    /* Load the current stage (its entry was recorded above) */
+    load_stage(game, game.current_stage_number < 3);
+}
 
-        const bool has_lantern =
-            (g_actor_system != nullptr) && (g_actor_system->comic_has_lantern == 1);
-        const bool should_blackout_tiles =
-            (current_level_number == LEVEL_NUMBER_CASTLE) && !has_lantern;
-        g_graphics->set_tileset_blackout(level_name, should_blackout_tiles);
+void load_level_graphics(GameContext& game) {
+    if (!game.graphics || game.current_level_number >= 8) {
+        return;
     }
-    
-    /* Load the current stage */
-    load_new_stage();
+    std::string level_name = level_names[game.current_level_number];
+    if (!game.graphics->load_tileset(level_name)) {
+        std::cerr << "Warning: Failed to load tileset for level: " << level_name << std::endl;
+        /* Continue anyway - may work with existing tileset */
+    }
+
+    const bool has_lantern = game.actors.comic_has_lantern == 1;
+    const bool should_blackout_tiles =
+        (game.current_level_number == LEVEL_NUMBER_CASTLE) && !has_lantern;
+    game.graphics->set_tileset_blackout(level_name, should_blackout_tiles);
 }
 
 /**
@@ -152,35 +298,43 @@ void load_new_level() {
  * Called when transitioning to a different stage (via door, stage boundary, or level load).
  * Loads the stage tile map into the physics system and positions Comic appropriately.
  */
-void load_new_stage() {
+void load_new_stage(GameContext& game) {
+    load_stage(game, false);
+}
+
+static void load_stage(GameContext& game, bool entry_recorded) {
     if (!levels_initialized) {
         std::cerr << "Error: Level data not initialized!" << std::endl;
         return;
     }
     
-    if (!current_level_ptr) {
+    if (!game.current_level_ptr) {
         std::cerr << "Error: No level loaded!" << std::endl;
         return;
     }
     
     /* Validate stage number */
-    if (current_stage_number >= 3) {
-        std::cerr << "Error: Invalid stage number: " << static_cast<int>(current_stage_number) << std::endl;
+    if (game.current_stage_number >= 3) {
+        std::cerr << "Error: Invalid stage number: " << static_cast<int>(game.current_stage_number) << std::endl;
         return;
     }
     
+    if (!entry_recorded) {
+        record_stage_entry(game, game.current_level_number, game.current_stage_number);
+    }
+    
     /* Load stage tiles into physics system */
-    std::string level_name = level_names[current_level_number];
-    if (!load_stage_tiles(level_name, current_stage_number)) {
+    std::string level_name = level_names[game.current_level_number];
+    if (!load_stage_tiles(game, level_name, game.current_stage_number)) {
         std::cerr << "Error: Failed to load stage tiles for " << level_name 
-                  << " stage " << static_cast<int>(current_stage_number) << std::endl;
+                  << " stage " << static_cast<int>(game.current_stage_number) << std::endl;
         return;
     }
     
     /* Handle entry positioning */
-    if (source_door_level_number >= 0) {
+    if (game.source_door_level_number >= 0) {
         /* Entering via door - find reciprocal door and position Comic there */
-        const stage_t& stage = current_level_ptr->stages[current_stage_number];
+        const stage_t& stage = game.current_level_ptr->stages[game.current_stage_number];
         
         /* Search for door that points back to source level/stage */
         bool found_door = false;
@@ -193,22 +347,22 @@ void load_new_stage() {
             }
             
             /* Check if this door links back to where we came from */
-            if (door.target_level == source_door_level_number && 
-                door.target_stage == source_door_stage_number) {
+            if (door.target_level == game.source_door_level_number && 
+                door.target_stage == game.source_door_stage_number) {
                 /* Found reciprocal door - position Comic in front of it */
-                comic_x = door.x + 1;  /* Center Comic in door (door is 2 units wide) */
-                comic_y = door.y;
-                comic_y_vel = 0;
+                game.comic_x = door.x + 1;  /* Center Comic in door (door is 2 units wide) */
+                game.comic_y = door.y;
+                game.comic_y_vel = 0;
 
                 /* Entering through a door establishes the new respawn checkpoint. */
-                comic_x_checkpoint = static_cast<uint8_t>(comic_x);
-                comic_y_checkpoint = static_cast<uint8_t>(comic_y);
+                game.comic_x_checkpoint = static_cast<uint8_t>(game.comic_x);
+                game.comic_y_checkpoint = static_cast<uint8_t>(game.comic_y);
                 
                 /* Set camera to follow Comic */
-                camera_x = comic_x - (PLAYFIELD_WIDTH / 2);
-                if (camera_x < 0) camera_x = 0;
-                if (camera_x > MAP_WIDTH - PLAYFIELD_WIDTH) {
-                    camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
+                game.camera_x = game.comic_x - (PLAYFIELD_WIDTH / 2);
+                if (game.camera_x < 0) game.camera_x = 0;
+                if (game.camera_x > MAP_WIDTH - PLAYFIELD_WIDTH) {
+                    game.camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
                 }
                 
                 found_door = true;
@@ -218,19 +372,22 @@ void load_new_stage() {
         
         if (!found_door) {
             std::cerr << "Warning: Could not find reciprocal door from level " 
-                      << static_cast<int>(source_door_level_number) 
-                      << " stage " << static_cast<int>(source_door_stage_number) << std::endl;
+                      << static_cast<int>(game.source_door_level_number) 
+                      << " stage " << static_cast<int>(game.source_door_stage_number) << std::endl;
         }
         
         /* Clear door entry flag */
-        source_door_level_number = -1;
-        source_door_stage_number = -1;
+        game.source_door_level_number = -1;
+        game.source_door_stage_number = -1;
     } else {
         /* Boundary transition or initial spawn - Comic position already set, update camera */
-        camera_x = comic_x - (PLAYFIELD_WIDTH / 2);
-        if (camera_x < 0) camera_x = 0;
-        if (camera_x > MAP_WIDTH - PLAYFIELD_WIDTH) {
-            camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
+        game.camera_x = game.comic_x - (PLAYFIELD_WIDTH / 2);
+        if (game.camera_x < 0) game.camera_x = 0;
+        if (game.camera_x > MAP_WIDTH - PLAYFIELD_WIDTH) {
+            game.camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
         }
     }
+    
+    /* Start decoding the neighbouring stages while this one is played */
+    prefetch_stage_neighbours(game);
 }
@@ -0,0 +1,235 @@
+/**
+ * load_graph.cpp - Startup loads as a dependency graph of tasks
+ */
+
+#include "../include/load_graph.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+LoadGraph::LoadGraph(AssetDecodePool* worker_pool, Clock::time_point graph_origin)
+    : pool(worker_pool), origin(graph_origin), cancelled(false), first_frame_ms(-1.0) {}
+
+LoadGraph::~LoadGraph() {
+    cancel();
+}
+
+LoadTaskId LoadGraph::add(const std::string& name, LoadThread thread, Task task,
+                          std::initializer_list<LoadTaskId> dependencies, ReadyCheck ready) {
+    std::unique_ptr<Node> node(new Node());
+    node->timing.name = name;
+    node->timing.thread = thread;
+    node->task = std::move(task);
+    node->ready = std::move(ready);
+    for (LoadTaskId dependency : dependencies) {
+        if (dependency < nodes.size()) {
+            node->dependencies.push_back(dependency);
+        }
+    }
+    nodes.push_back(std::move(node));
+    return static_cast<LoadTaskId>(nodes.size() - 1);
+}
+
+void LoadGraph::record(const std::string& name, Clock::time_point start, Clock::time_point end) {
+    std::unique_ptr<Node> node(new Node());
+    node->timing.name = name;
+    node->timing.start_ms = std::chrono::duration<double, std::milli>(start - origin).count();
+    node->timing.end_ms = std::chrono::duration<double, std::milli>(end - origin).count();
+    node->timing.succeeded = true;
+    node->state = State::DONE;
+    nodes.push_back(std::move(node));
+}
+
+double LoadGraph::elapsed_ms() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - origin).count();
+}
+
+bool LoadGraph::dependencies_done(const Node& node) const {
+    for (LoadTaskId dependency : node.dependencies) {
+        if (nodes[dependency]->state != State::DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoadGraph::runs_on_worker(const Node& node) const {
+    return pool != nullptr && node.timing.thread == LoadThread::WORKER;
+}
+
+void LoadGraph::run_node(Node& node) {
+    node.timing.start_ms = elapsed_ms();
+    node.timing.succeeded = node.task ? node.task() : true;
+    node.timing.end_ms = elapsed_ms();
+    node.task = nullptr;  // Let go of whatever it captured
+    node.state = State::DONE;
+}
+
+void LoadGraph::dispatch(Node& node) {
+    Node* target = &node;
+    node.state = State::RUNNING;
+    node.ticket = pool->enqueue([this, target]() -> SDL_Surface* {
+        if (!cancelled.load(std::memory_order_acquire)) {
+            target->timing.start_ms = elapsed_ms();
+            target->timing.succeeded = target->task ? target->task() : true;
+            target->timing.end_ms = elapsed_ms();
+        }
+        return nullptr;
+    });
+}
+
+void LoadGraph::collect_workers() {
+    for (const std::unique_ptr<Node>& node : nodes) {
+        if (node->state == State::RUNNING && pool->is_done(node->ticket)) {
+            node->ticket.reset();
+            node->task = nullptr;
+            node->state = State::DONE;
+        }
+    }
+}
+
+bool LoadGraph::pump(double budget_ms) {
+    const double deadline = elapsed_ms() + budget_ms;
+    bool ran_any = false;
+    while (true) {
+        if (pool) {
+            collect_workers();
+            for (const std::unique_ptr<Node>& node : nodes) {
+                if (node->state == State::WAITING && runs_on_worker(*node) && dependencies_done(*node)) {
+                    dispatch(*node);
+                }
+            }
+        }
+        if (ran_any && elapsed_ms() >= deadline) {
+            break;
+        }
+
+        Node* due = nullptr;
+        for (const std::unique_ptr<Node>& node : nodes) {
+            if (node->state == State::WAITING && !runs_on_worker(*node) && dependencies_done(*node) &&
+                (!node->ready || node->ready())) {
+                due = node.get();
+                break;
+            }
+        }
+        if (!due) {
+            break;
+        }
+        run_node(*due);
+        ran_any = true;
+    }
+    return is_finished();
+}
+
+bool LoadGraph::wait(LoadTaskId id) {
+    if (id >= nodes.size()) {
+        return false;
+    }
+    Node& node = *nodes[id];
+    if (node.state != State::DONE) {
+        for (LoadTaskId dependency : node.dependencies) {
+            wait(dependency);
+        }
+        if (node.state == State::WAITING && !runs_on_worker(node)) {
+            run_node(node);
+        } else {
+            if (node.state == State::WAITING) {
+                dispatch(node);
+            }
+            // A task still queued on the pool runs on this thread instead
+            pool->wait(node.ticket);
+            node.ticket.reset();
+            node.task = nullptr;
+            node.state = State::DONE;
+        }
+    }
+    return node.timing.succeeded;
+}
+
+bool LoadGraph::finish() {
+    bool all_succeeded = true;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!wait(static_cast<LoadTaskId>(i))) {
+            all_succeeded = false;
+        }
+    }
+    return all_succeeded;
+}
+
+void LoadGraph::cancel() {
+    cancelled.store(true, std::memory_order_release);
+    for (const std::unique_ptr<Node>& node : nodes) {
+        if (node->state == State::RUNNING) {
+            pool->wait(node->ticket);
+            node->ticket.reset();
+        }
+        node->task = nullptr;
+        node->ready = nullptr;
+        node->state = State::DONE;
+    }
+}
+
+bool LoadGraph::is_done(LoadTaskId id) const {
+    return id < nodes.size() && nodes[id]->state == State::DONE;
+}
+
+bool LoadGraph::is_finished() const {
+    for (const std::unique_ptr<Node>& node : nodes) {
+        if (node->state != State::DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LoadGraph::mark_first_frame() {
+    if (first_frame_ms < 0.0) {
+        first_frame_ms = elapsed_ms();
+    }
+}
+
+std::vector<LoadTaskTiming> LoadGraph::get_timings() const {
+    std::vector<LoadTaskTiming> timings;
+    timings.reserve(nodes.size());
+    for (const std::unique_ptr<Node>& node : nodes) {
+        // A WORKER task's timing is only settled once it is collected
+        timings.push_back(node->state == State::DONE ? node->timing : LoadTaskTiming{node->timing.name,
+                                                                                        node->timing.thread});
+    }
+    return timings;
+}
+
+void LoadGraph::print_report(std::ostream& out) const {
+    const std::vector<LoadTaskTiming> timings = get_timings();
+    double loads_done_ms = 0.0;
+    for (const LoadTaskTiming& timing : timings) {
+        loads_done_ms = std::max(loads_done_ms, timing.end_ms);
+    }
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    out << "Startup: first frame at " << first_frame_ms << " ms, loads done at " << loads_done_ms << " ms"
+        << std::endl;
+    out << "    start     time  thread  task" << std::endl;
+    for (const LoadTaskTiming& timing : timings) {
+        if (timing.start_ms < 0.0) {
+            out << "        -        -  " << std::setw(6) << std::left
+                << (timing.thread == LoadThread::WORKER ? "worker" : "render") << std::right << "  "
+                << timing.name << " (did not run)" << std::endl;
+            continue;
+        }
+        out << std::setw(9) << timing.start_ms << std::setw(9) << (timing.end_ms - timing.start_ms) << "  "
+            << std::setw(6) << std::left << (timing.thread == LoadThread::WORKER ? "worker" : "render")
+            << std::right << "  " << timing.name;
+        if (first_frame_ms >= 0.0 && timing.end_ms <= first_frame_ms) {
+            out << " (before first frame)";
+        }
+        if (!timing.succeeded) {
+            out << " (failed)";
+        }
+        out << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -2,65 +2,42 @@
 #include <SDL2/SDL_image.h>
 #include <algorithm>
 #include <iostream>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "../include/physics.h"
 #include "../include/graphics.h"
 #include "../include/level_loader.h"
 #include "../include/doors.h"
+#include "../include/game_context.h"
+#include "../include/gameplay.h"
 #include "../include/cheats.h"
 #include "../include/actors.h"
 #include "../include/audio.h"
+#include "../include/batch_runner.h"
 #include "../include/title_sequence.h"
 #include "../include/ui_system.h"
 #include "../include/player_teleport.h"
-
-// Game state
-int comic_x = 20;
-int comic_y = 2;
-int8_t comic_y_vel = 0;
-int8_t comic_x_momentum = 0;
-uint8_t comic_facing = 1; // 1 right, 0 left
-uint8_t comic_animation = 0;
-uint8_t comic_is_falling_or_jumping = 1;
-uint8_t comic_jump_counter = 0;
-uint8_t comic_jump_power = JUMP_POWER_DEFAULT;
-uint8_t key_state_jump = 0;
-uint8_t previous_key_state_jump = 0;
-uint8_t key_state_left = 0;
-uint8_t key_state_right = 0;
-uint8_t key_state_open = 0;  // Open key for doors
-uint8_t previous_key_state_open = 0;  // Track previous state for edge-triggered activation
-uint8_t key_state_fire = 0;  // Fire key (Left Ctrl)
-uint8_t key_state_teleport = 0;  // Teleport key (CapsLock-style binding)
-uint8_t previous_key_state_teleport = 0;  // Track previous teleport key state for edge trigger
-int camera_x = 0;
-
-// Item collection state
-uint8_t comic_has_door_key = 0;  // 1 if player has door key, 0 otherwise
-uint8_t comic_num_lives = 0;  // Number of lives remaining (counts up from 0 to 5, then subtracts 1)
-uint8_t lives_sequence_counter = 5;  // Lives count-up sequence: award 5 lives, then subtract 1
-uint8_t lives_sequence_delay = 1;  // Delay counter for lives animation (1 tick between each award)
-bool lives_sequence_complete = false;  // Flag to stop lives sequence after completion
-uint8_t comic_hp = 0;  // Current health points (0-6)
-uint8_t comic_hp_pending_increase = MAX_HP;  // HP fills gradually from 0 to MAX_HP at game start
-uint8_t score_bytes[3] = {0, 0, 0};  // Score in base-100 encoding
-uint8_t score_10000_counter = 0;  // Count carries into ten-thousands digit; 5 -> extra life
-// Note: Firepower, items, and treasures are managed by ActorSystem (authoritative state)
-
-// Level/stage transition tracking
-uint8_t current_level_number = 1;  // Current level (0=LAKE, 1=FOREST, etc.)
-uint8_t current_stage_number = 0;  // Current stage (0-2 per level)
-const level_t* current_level_ptr = nullptr;  // Pointer to current level data
-int8_t source_door_level_number = -1;  // Set when entering via door for reciprocal positioning
-int8_t source_door_stage_number = -1;
-
-// Checkpoint position (for respawn and boundary crossing)
-uint8_t comic_y_checkpoint = 12;  // Y position to respawn at
-uint8_t comic_x_checkpoint = 14;  // X position to respawn at
-
-// Game state
-bool game_over_triggered = false;  // Set when life depletion should transition to game-over sequence
+#include "../include/replay.h"
+#include "../include/sequencer.h"
+#include "../include/counters.h"
+#include "../include/frame_capture.h"
+#include "../include/frame_arena.h"
+#include "../include/frame_pacer.h"
+#include "../include/input_latency.h"
+#include "../include/load_graph.h"
+#include "../include/profiler.h"
+#include "../include/sim_thread.h"
+#include "../include/snapshot.h"
 
 enum class GameState {
     Playing,
@@ -70,25 +47,18 @@ enum class GameState {
     Exiting
 };
 
-// Teleport state
-bool comic_is_teleporting = false;
-uint8_t teleport_animation = 0;
-uint8_t teleport_source_x = 0;
-uint8_t teleport_source_y = 0;
-uint8_t teleport_destination_x = 0;
-uint8_t teleport_destination_y = 0;
-uint8_t teleport_camera_counter = 0;
-int8_t teleport_camera_vel = 0;
-bool teleport_skip_tick = false;
-
-// Global system pointers (for access from other modules)
-ActorSystem* g_actor_system = nullptr;  // Actor system pointer (for cheat access)
-
 // Level names (indexed by level number)
 static constexpr const char* level_names[] = {
     "lake", "forest", "space", "base", "cave", "shed", "castle", "comp"
 };
 
+// Milliseconds of startup loads run per frame while the notice and title are up
+constexpr double STARTUP_LOAD_BUDGET_MS = 4.0;
+
+// Debug mode quick save file (F6/F7) and rewind speed (F8), in ticks per tick
+static constexpr const char* QUICK_SAVE_PATH = "quicksave.state";
+constexpr int REWIND_TICKS_PER_TICK = 2;
+
 // Player animation state
 Animation comic_idle_right;
 Animation comic_idle_left;
@@ -99,214 +69,653 @@ Animation comic_jump_left;
 Animation comic_death;
 Animation* current_animation = nullptr;
 
-// Phase 5: run cycle frame counter, advanced once per game tick unconditionally
-// (mirrors assembly comic_run_cycle which increments at the top of every .tick)
-int comic_run_cycle_frame = 0;
-
-void process_door_input() {
-    // Edge-triggered door activation: only trigger on rising edge of open key
-    // This prevents the door from immediately re-triggering when entering a new stage
-    // (since load_new_stage positions Comic at the reciprocal door location)
-    if (comic_is_falling_or_jumping == 0 &&
-        key_state_open && !previous_key_state_open) {
-        check_door_activation();
+static bool key_matches_binding(SDL_Keycode key, SDL_Keycode binding) {
+    if (key == binding) {
+        return true;
+    }
+
+    // Treat left/right modifier variants as one DOS-style key class.
+    switch (binding) {
+        case SDLK_LCTRL:
+        case SDLK_RCTRL:
+            return key == SDLK_LCTRL || key == SDLK_RCTRL;
+        case SDLK_LALT:
+        case SDLK_RALT:
+            return key == SDLK_LALT || key == SDLK_RALT;
+        case SDLK_LSHIFT:
+        case SDLK_RSHIFT:
+            return key == SDLK_LSHIFT || key == SDLK_RSHIFT;
+        default:
+            return false;
     }
-    
-    previous_key_state_open = key_state_open;
 }
 
-void clear_gameplay_key_states() {
-    key_state_jump = 0;
-    previous_key_state_jump = 0;
-    key_state_left = 0;
-    key_state_right = 0;
-    key_state_open = 0;
-    previous_key_state_open = 0;
-    key_state_fire = 0;
-    key_state_teleport = 0;
-    previous_key_state_teleport = 0;
+// INPUT_* bits of the gameplay actions bound to a key
+static uint8_t bound_input_keys(SDL_Keycode key, const InputBindings& bindings) {
+    uint8_t keys = 0;
+    keys |= key_matches_binding(key, bindings.move_left) ? INPUT_LEFT : 0;
+    keys |= key_matches_binding(key, bindings.move_right) ? INPUT_RIGHT : 0;
+    keys |= key_matches_binding(key, bindings.jump) ? INPUT_JUMP : 0;
+    keys |= key_matches_binding(key, bindings.fire) ? INPUT_FIRE : 0;
+    keys |= key_matches_binding(key, bindings.open_door) ? INPUT_OPEN : 0;
+    keys |= key_matches_binding(key, bindings.teleport) ? INPUT_TELEPORT : 0;
+    return keys;
 }
 
-void begin_teleport() {
-    constexpr uint8_t TELEPORT_DISTANCE = 6;
+// ============================================================================
+// HEADLESS SIMULATION
+// ============================================================================
 
-    uint8_t dest_x = static_cast<uint8_t>(comic_x);
-    uint8_t dest_y = static_cast<uint8_t>(comic_y);
-    const int camera_rel_x = static_cast<int>(comic_x) - camera_x;
+struct ScriptedInput {
+    uint64_t tick;  // First tick the keys are held on
+    uint8_t keys;   // INPUT_* bits
+};
 
-    teleport_camera_counter = 0;
+/**
+ * Read an input script: one "<tick> <keys>" entry per line, in tick order,
+ * holding the keys from that tick until the next entry. Keys are letters
+ * L(eft) R(ight) J(ump) F(ire) O(pen door) T(eleport), or "-" for none;
+ * blank lines and lines starting with '#' are skipped.
+ */
+static bool load_input_script(const char* path, std::vector<ScriptedInput>& script) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open input script: " << path << std::endl;
+        return false;
+    }
 
-    if (comic_facing == COMIC_FACING_LEFT) {
-        teleport_camera_vel = -1;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        std::istringstream fields(line);
+        ScriptedInput entry = {0, 0};
+        std::string keys;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!(fields >> entry.tick >> keys) ||
+            (!script.empty() && entry.tick < script.back().tick)) {
+            std::cerr << path << ":" << line_number << ": expected \"<tick> <keys>\" in tick order" << std::endl;
+            return false;
+        }
+        for (char key : keys) {
+            switch (std::toupper(static_cast<unsigned char>(key))) {
+                case 'L': entry.keys |= INPUT_LEFT; break;
+                case 'R': entry.keys |= INPUT_RIGHT; break;
+                case 'J': entry.keys |= INPUT_JUMP; break;
+                case 'F': entry.keys |= INPUT_FIRE; break;
+                case 'O': entry.keys |= INPUT_OPEN; break;
+                case 'T': entry.keys |= INPUT_TELEPORT; break;
+                case '-': break;
+                default:
+                    std::cerr << path << ":" << line_number << ": unknown key '" << key << "'" << std::endl;
+                    return false;
+            }
+        }
+        script.push_back(entry);
+    }
+    return true;
+}
 
-        if (camera_rel_x >= TELEPORT_DISTANCE) {
-            dest_x = static_cast<uint8_t>(dest_x - TELEPORT_DISTANCE);
+// Input recording and playback for one gameplay session
+struct ReplaySession {
+    ReplayRecording recording;   // Being recorded (record_path) or played back
+    const char* record_path = nullptr;
+    bool replaying = false;
+    uint64_t tick = 0;           // Gameplay ticks run so far
+    uint64_t last_checksum = 0;  // State after the latest tick
+    bool diverged = false;
+};
 
-            const int dest_camera_rel = camera_rel_x - TELEPORT_DISTANCE;
-            if (dest_camera_rel < (PLAYFIELD_WIDTH / 2 - 2)) {
-                const int camera_movement = (PLAYFIELD_WIDTH / 2 - 2) - dest_camera_rel;
-                teleport_camera_counter = static_cast<uint8_t>(
-                    std::min(camera_x, camera_movement));
-            }
+/**
+ * Take this tick's keys from the replay, or record the keys the player
+ * holds. Returns false once a replay has run out of ticks.
+ */
+static bool begin_session_tick(ReplaySession& session, GameContext& game) {
+    if (session.replaying) {
+        if (session.tick >= session.recording.tick_count()) {
+            return false;
         }
-    } else {
-        teleport_camera_vel = 1;
+        apply_input_keys(game, session.recording.keys[session.tick]);
+    } else if (session.record_path) {
+        session.recording.record_tick(current_input_keys(game));
+    }
+    return true;
+}
 
-        if (camera_rel_x < (PLAYFIELD_WIDTH - TELEPORT_DISTANCE - 1)) {
-            dest_x = static_cast<uint8_t>(dest_x + TELEPORT_DISTANCE);
+// Checksum the state after the tick; a replay that disagrees with its
+// recording is reported and marked diverged.
+static void end_session_tick(ReplaySession& session, const GameContext& game) {
+    if (!session.replaying && !session.record_path) {
+        ++session.tick;
+        return;
+    }
+    session.last_checksum = gameplay_checksum(game);
+    if (ReplayRecording::is_checksum_tick(session.tick)) {
+        uint64_t expected = 0;
+        if (!session.replaying) {
+            session.recording.record_checksum(session.last_checksum);
+        } else if (session.recording.checksum_after(session.tick, &expected) &&
+                   expected != session.last_checksum && !session.diverged) {
+            std::cerr << "Replay diverged at tick " << session.tick << ": expected checksum "
+                      << std::hex << expected << ", got " << session.last_checksum << std::dec << std::endl;
+            session.diverged = true;
+        }
+    }
+    ++session.tick;
+}
 
-            const int dest_camera_rel = camera_rel_x + TELEPORT_DISTANCE;
-            if (dest_camera_rel > (PLAYFIELD_WIDTH / 2)) {
-                const int max_camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
-                const int camera_movement = dest_camera_rel - (PLAYFIELD_WIDTH / 2);
-                if (camera_x + camera_movement <= max_camera_x) {
-                    teleport_camera_counter = static_cast<uint8_t>(camera_movement);
-                } else {
-                    teleport_camera_counter = static_cast<uint8_t>(max_camera_x - camera_x);
-                }
-            }
+// Save a recording, or check a finished replay's final state. Returns false on failure.
+static bool finish_session(ReplaySession& session) {
+    if (session.record_path) {
+        session.recording.final_checksum = session.last_checksum;
+        if (!session.recording.save(session.record_path)) {
+            return false;
         }
+        std::cout << "Recorded " << session.recording.tick_count() << " tick(s) to "
+                  << session.record_path << std::endl;
+    }
+    if (session.replaying && !session.diverged &&
+        session.tick == session.recording.tick_count() &&
+        session.last_checksum != session.recording.final_checksum) {
+        std::cerr << "Replay diverged: final checksum " << std::hex << session.last_checksum
+                  << ", recorded " << session.recording.final_checksum << std::dec << std::endl;
+        session.diverged = true;
     }
+    return !session.diverged;
+}
 
-    // Round destination to an even tile boundary and search down the column
-    // for a solid tile with two empty tiles above (safe landing).
-    dest_x &= 0xFE;
+// Nearest-rank percentiles of per-frame (or per-tick) times
+static void print_time_percentiles(const char* label, std::vector<double>& times_ms) {
+    if (times_ms.empty()) {
+        return;
+    }
+    std::sort(times_ms.begin(), times_ms.end());
+    auto percentile = [&times_ms](double p) {
+        const size_t rank = static_cast<size_t>(p * static_cast<double>(times_ms.size() - 1) + 0.5);
+        return times_ms[rank];
+    };
+    std::cout << label << " p50 " << percentile(0.50) << " ms, p95 " << percentile(0.95)
+              << " ms, p99 " << percentile(0.99) << " ms, max " << times_ms.back() << " ms" << std::endl;
+}
 
-    bool solid_found = false;
-    uint8_t search_y = static_cast<uint8_t>(PLAYFIELD_HEIGHT - 2);
+// Milliseconds from one SDL_GetTicks time to a later one
+static double elapsed_ms(uint32_t from_ms, uint32_t to_ms) {
+    return std::max(0.0, static_cast<double>(static_cast<int32_t>(to_ms - from_ms)));
+}
+
+static void print_input_latency_report(const InputLatencyTracker& latency) {
+    const auto& samples = latency.get_samples();
+    std::cout << "Input latency: " << samples.size() << " press(es) shown, " << latency.get_lost_presses()
+              << " released before a tick read them" << std::endl;
+    std::vector<double> to_poll;
+    std::vector<double> to_tick;
+    std::vector<double> to_present;
+    for (const auto& sample : samples) {
+        to_poll.push_back(elapsed_ms(sample.event_ms, sample.poll_ms));
+        to_tick.push_back(elapsed_ms(sample.event_ms, sample.tick_ms));
+        to_present.push_back(elapsed_ms(sample.event_ms, sample.present_ms));
+    }
+    print_time_percentiles("  event to poll:", to_poll);
+    print_time_percentiles("  event to tick:", to_tick);
+    print_time_percentiles("  event to present:", to_present);
+}
 
-    while (search_y > 0 && !solid_found) {
-        if (is_tile_solid(get_tile_at(dest_x, search_y))) {
-            uint8_t nonsolid_count = 0;
-            uint8_t probe_y = search_y;
+/**
+ * Run the game logic for tick_count ticks with no window, renderer or audio
+ * device, as fast as the CPU allows. Input comes from the replay, the script
+ * or nothing; the run stops early on game over or victory. Returns non-zero
+ * if a replay diverged.
+ */
+static int run_headless(uint64_t tick_count, const char* input_script_path,
+                        ReplaySession& session, bool debug_mode) {
+    std::vector<ScriptedInput> script;
+    if (input_script_path && !load_input_script(input_script_path, script)) {
+        return 1;
+    }
+    if (session.replaying && (tick_count == 0 || tick_count > session.recording.tick_count())) {
+        tick_count = session.recording.tick_count();
+    }
 
-            while (probe_y > 0) {
-                probe_y = static_cast<uint8_t>(probe_y - 2);
+    GameContext game;
+    ActorSystem& actor_system = game.actors;
+    actor_system.initialize();
+    if (debug_mode) {
+        actor_system.comic_firepower = 3;
+    }
 
-                if (is_tile_solid(get_tile_at(dest_x, probe_y))) {
-                    break;
-                }
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
 
-                nonsolid_count++;
-                if (nonsolid_count >= 2) {
-                    dest_y = probe_y;
-                    solid_found = true;
-                    break;
-                }
-            }
+    const char* outcome_name = "running";
+    size_t next_input = 0;
+    std::vector<double> tick_times_ms;
+    if (session.replaying) {
+        tick_times_ms.reserve(static_cast<size_t>(tick_count));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    while (session.tick < tick_count && !session.diverged) {
+        while (next_input < script.size() && script[next_input].tick <= session.tick) {
+            apply_input_keys(game, script[next_input].keys);
+            ++next_input;
         }
-
-        if (!solid_found) {
-            search_y = static_cast<uint8_t>(search_y - 2);
+        const auto tick_start = std::chrono::steady_clock::now();
+        begin_session_tick(session, game);
+        const TickOutcome outcome = run_gameplay_tick(game);
+        end_session_tick(session, game);
+        if (session.replaying) {
+            tick_times_ms.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - tick_start).count());
+        }
+        if (outcome == TickOutcome::GameOver) {
+            outcome_name = "game over";
+            break;
+        }
+        if (outcome == TickOutcome::Victory) {
+            outcome_name = "victory";
+            break;
         }
     }
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    const uint64_t ticks_run = session.tick;
 
-    if (!solid_found) {
-        dest_x = static_cast<uint8_t>(comic_x);
-        dest_y = static_cast<uint8_t>(comic_y);
-        teleport_camera_counter = 0;
+    std::cout << "Headless: " << ticks_run << " tick(s) in " << elapsed_ms << " ms";
+    if (elapsed_ms > 0.0) {
+        std::cout << " (" << static_cast<uint64_t>(ticks_run / elapsed_ms) << " ticks/ms)";
     }
+    std::cout << ", " << outcome_name << std::endl;
+    std::cout << "State: level " << static_cast<int>(game.current_level_number)
+              << " stage " << static_cast<int>(game.current_stage_number)
+              << " x " << game.comic_x << " y " << game.comic_y
+              << " hp " << static_cast<int>(game.comic_hp)
+              << " lives " << static_cast<int>(game.comic_num_lives)
+              << " treasures " << static_cast<int>(actor_system.comic_num_treasures)
+              << " checksum " << std::hex << gameplay_checksum(game) << std::dec << std::endl;
+    print_time_percentiles("Tick time:", tick_times_ms);
+
+    return finish_session(session) ? 0 : 1;
+}
 
-    teleport_animation = 0;
-    teleport_source_x = static_cast<uint8_t>(comic_x);
-    teleport_source_y = static_cast<uint8_t>(comic_y);
-    teleport_destination_x = dest_x;
-    teleport_destination_y = dest_y;
-    comic_is_teleporting = true;
-    teleport_skip_tick = true;
-
-    play_game_sound(GameSound::TELEPORT);
+// Fuzz input for batch game `seed`: random keys, each held for 8 ticks
+static uint8_t fuzz_input_keys(uint64_t seed, uint64_t tick) {
+    uint64_t x = (seed + 1) * 0x9E3779B97F4A7C15ull ^ ((tick / 8) + 1) * 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 31;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 29;
+    return static_cast<uint8_t>(x) & INPUT_KEYS_MASK;
 }
 
-void process_teleport_input(bool comic_has_teleport_wand) {
-    if (key_state_teleport && !previous_key_state_teleport && comic_has_teleport_wand) {
-        begin_teleport();
+// The per-tick keys of the replay or input script; empty without either
+static bool load_session_keys(uint64_t tick_count, const char* input_script_path,
+                              const ReplaySession& session, std::vector<uint8_t>& keys) {
+    keys.clear();
+    if (session.replaying) {
+        keys = session.recording.keys;
+    } else if (input_script_path) {
+        std::vector<ScriptedInput> script;
+        if (!load_input_script(input_script_path, script)) {
+            return false;
+        }
+        keys.resize(static_cast<size_t>(tick_count), 0);
+        for (size_t i = 0; i < script.size() && script[i].tick < tick_count; ++i) {
+            std::fill(keys.begin() + static_cast<ptrdiff_t>(script[i].tick), keys.end(), script[i].keys);
+        }
     }
-
-    previous_key_state_teleport = key_state_teleport;
+    return true;
 }
 
-void handle_teleport_tick() {
-    if (!comic_is_teleporting) {
-        return;
+/**
+ * Run game_count independent games of tick_count ticks across thread_count
+ * threads and print the throughput and how the games ended. Every game plays
+ * the replay or script input if one is given, otherwise its own fuzz input.
+ * The combined checksum depends only on the games, not on the thread count.
+ */
+static int run_batch(uint64_t game_count, uint64_t tick_count, unsigned thread_count,
+                     const char* input_script_path, const ReplaySession& session, bool debug_mode) {
+    std::vector<uint8_t> keys;
+    if (!load_session_keys(tick_count, input_script_path, session, keys)) {
+        return 1;
     }
-
-    if (teleport_skip_tick) {
-        teleport_skip_tick = false;
-        return;
+    if (tick_count == 0) {
+        tick_count = keys.empty() ? 1000 : keys.size();
     }
 
-    if (teleport_camera_counter > 0) {
-        const int max_camera_x = MAP_WIDTH - PLAYFIELD_WIDTH;
-        const int moved_camera_x = camera_x + teleport_camera_vel;
-        camera_x = std::max(0, std::min(moved_camera_x, max_camera_x));
-        teleport_camera_counter--;
+    std::vector<BatchJob> jobs(static_cast<size_t>(game_count));
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].tick_count = tick_count;
+        jobs[i].debug_mode = debug_mode;
+        if (session.replaying || input_script_path) {
+            jobs[i].keys = keys;
+        } else {
+            jobs[i].input = [i](const GameContext&, uint64_t tick) { return fuzz_input_keys(i, tick); };
+        }
     }
 
-    teleport_animation++;
-
-    apply_teleport_destination_if_ready(
-        teleport_animation,
-        teleport_destination_x,
-        teleport_destination_y,
-        comic_x,
-        comic_y);
+    BatchRunner runner(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<BatchResult> results = runner.run(jobs);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    uint64_t total_ticks = 0;
+    uint64_t game_overs = 0;
+    uint64_t victories = 0;
+    uint64_t combined = 0xcbf29ce484222325ull;
+    for (const BatchResult& result : results) {
+        total_ticks += result.ticks_run;
+        game_overs += result.outcome == TickOutcome::GameOver ? 1 : 0;
+        victories += result.outcome == TickOutcome::Victory ? 1 : 0;
+        combined = (combined ^ result.checksum) * 0x100000001b3ull;
+    }
 
-    if (teleport_animation >= 6) {
-        comic_is_teleporting = false;
+    std::cout << "Batch: " << results.size() << " game(s), " << total_ticks << " tick(s) on "
+              << runner.get_thread_count() << " thread(s) in " << elapsed_ms << " ms";
+    if (elapsed_ms > 0.0) {
+        std::cout << " (" << static_cast<uint64_t>(total_ticks / elapsed_ms) << " ticks/ms, "
+                  << static_cast<uint64_t>(results.size() * 1000.0 / elapsed_ms) << " games/s)";
     }
+    std::cout << std::endl;
+    std::cout << "Outcomes: " << game_overs << " game over, " << victories << " victory, "
+              << (results.size() - game_overs - victories) << " running; checksum "
+              << std::hex << combined << std::dec << std::endl;
+    return 0;
 }
 
-static bool key_matches_binding(SDL_Keycode key, SDL_Keycode binding) {
-    if (key == binding) {
-        return true;
+/**
+ * Play the same input twice on two threads, keeping a snapshot of every
+ * tick, and report the first tick where the two games differ and how. A
+ * difference means state outside the GameContext (or uninitialized memory)
+ * reaches the simulation. Input is the replay or script, otherwise fuzz.
+ */
+static int run_determinism_check(uint64_t tick_count, const char* input_script_path,
+                                 const ReplaySession& session, bool debug_mode) {
+    std::vector<uint8_t> keys;
+    if (!load_session_keys(tick_count, input_script_path, session, keys)) {
+        return 1;
+    }
+    if (tick_count == 0) {
+        tick_count = keys.empty() ? 10000 : keys.size();
+    }
+    const bool fuzz = !session.replaying && !input_script_path;
+
+    // Room for every tick of both runs
+    const size_t ring_ticks = static_cast<size_t>(tick_count);
+    const size_t ring_bytes = std::max(SNAPSHOT_RING_DEFAULT_BYTES, ring_ticks * 256);
+    SnapshotRing rings[2] = {SnapshotRing(ring_ticks, ring_bytes), SnapshotRing(ring_ticks, ring_bytes)};
+    std::atomic<bool> unsnapshotted(false);
+    std::vector<BatchJob> jobs(2);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].tick_count = tick_count;
+        jobs[i].debug_mode = debug_mode;
+        SnapshotRing& ring = rings[i];
+        jobs[i].input = [&ring, &keys, &unsnapshotted, fuzz](const GameContext& game, uint64_t tick) -> uint8_t {
+            GameSnapshot snapshot;
+            if (capture_snapshot(game, snapshot)) {
+                ring.push(tick, snapshot);
+            } else {
+                unsnapshotted.store(true, std::memory_order_relaxed);
+            }
+            if (fuzz) {
+                return fuzz_input_keys(0, tick);
+            }
+            return tick < keys.size() ? keys[static_cast<size_t>(tick)] : 0;
+        };
+    }
+    BatchRunner runner(2);
+    const std::vector<BatchResult> results = runner.run(jobs);
+    if (unsnapshotted.load(std::memory_order_relaxed)) {
+        std::cerr << "Cannot check determinism: the actor pool is larger than a snapshot holds" << std::endl;
+        return 1;
     }
 
-    // Treat left/right modifier variants as one DOS-style key class.
-    switch (binding) {
-        case SDLK_LCTRL:
-        case SDLK_RCTRL:
-            return key == SDLK_LCTRL || key == SDLK_RCTRL;
-        case SDLK_LALT:
-        case SDLK_RALT:
-            return key == SDLK_LALT || key == SDLK_RALT;
-        case SDLK_LSHIFT:
-        case SDLK_RSHIFT:
-            return key == SDLK_LSHIFT || key == SDLK_RSHIFT;
-        default:
-            return false;
+    uint64_t tick = 0;
+    if (SnapshotRing::find_first_difference(rings[0], rings[1], &tick)) {
+        GameSnapshot first;
+        GameSnapshot second;
+        rings[0].get(tick, first);
+        rings[1].get(tick, second);
+        std::cerr << "Not deterministic: the runs differ before tick " << tick << std::endl;
+        for (const std::string& difference : describe_snapshot_differences(first, second)) {
+            std::cerr << "  " << difference << std::endl;
+        }
+        return 1;
+    }
+    if (results[0].checksum != results[1].checksum || results[0].ticks_run != results[1].ticks_run) {
+        std::cerr << "Not deterministic: the runs differ after the last tick" << std::endl;
+        return 1;
     }
+    std::cout << "Deterministic: " << results[0].ticks_run << " tick(s) played twice, "
+              << rings[0].size() << " snapshot(s) in " << rings[0].bytes_used() << " bytes each; checksum "
+              << std::hex << results[0].checksum << std::dec << std::endl;
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
+    // Startup times are reported from here (see LoadGraph)
+    const auto launch_time = std::chrono::steady_clock::now();
+
     // Parse command-line arguments
     bool debug_mode = false;
     bool skip_title = false;
+    bool native_res = false;
+    size_t texture_budget_mb = 0;
+    int audio_buffer_frames = 0;
+    bool headless = false;
+    uint64_t headless_ticks = 0;
+    const char* input_script_path = nullptr;
+    const char* replay_path = nullptr;
+    bool turbo = false;
+    int render_every = 60;
+    uint64_t batch_games = 0;
+    unsigned batch_threads = 0;
+    bool check_determinism = false;
+    const char* perf_log_path = nullptr;
+    bool print_stats = false;
+    PacingMode pacing_mode = PacingMode::FIXED;
+    int target_fps = 0;
+    bool interpolate = false;
+    bool render_on_change = false;
+    bool latency_report = false;
+    const char* latency_log_path = nullptr;
+    bool early_tick = false;
+    bool threaded = false;
+    const char* capture_path = nullptr;
+    CaptureFormat capture_format = CaptureFormat::Y4M;
+    ReplaySession session;
     for (int i = 1; i < argc; ++i) {
         if (std::strcmp(argv[i], "--debug") == 0) {
             debug_mode = true;
             std::cout << "Debug mode enabled" << std::endl;
         } else if (std::strcmp(argv[i], "--skip-title") == 0) {
             skip_title = true;
+        } else if (std::strcmp(argv[i], "--native-res") == 0) {
+            native_res = true;
+        } else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) {
+            texture_budget_mb = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--audio-buffer") == 0 && i + 1 < argc) {
+            audio_buffer_frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            headless_ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+            input_script_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            session.record_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--turbo") == 0) {
+            turbo = true;
+        } else if (std::strcmp(argv[i], "--render-every") == 0 && i + 1 < argc) {
+            render_every = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_games = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            batch_threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--check-determinism") == 0) {
+            check_determinism = true;
+        } else if (std::strcmp(argv[i], "--perf-log") == 0 && i + 1 < argc) {
+            perf_log_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
+        } else if (std::strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            if (!parse_pacing_mode(argv[++i], &pacing_mode)) {
+                std::cerr << "--pacing must be vsync, fixed or power-saver" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            target_fps = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--interpolate") == 0) {
+            interpolate = true;
+        } else if (std::strcmp(argv[i], "--render-on-change") == 0) {
+            render_on_change = true;
+        } else if (std::strcmp(argv[i], "--latency-report") == 0) {
+            latency_report = true;
+        } else if (std::strcmp(argv[i], "--latency-log") == 0 && i + 1 < argc) {
+            latency_log_path = argv[++i];
+            latency_report = true;
+        } else if (std::strcmp(argv[i], "--early-tick") == 0) {
+            early_tick = true;
+        } else if (std::strcmp(argv[i], "--threaded") == 0) {
+            threaded = true;
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capture_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--capture-format") == 0 && i + 1 < argc) {
+            if (!parse_capture_format(argv[++i], &capture_format)) {
+                std::cerr << "Unknown capture format " << argv[i] << " (use y4m or raw)" << std::endl;
+                return 1;
+            }
         } else if (std::strcmp(argv[i], "--help") == 0) {
             std::cout << "Captain Comic - Usage:" << std::endl;
             std::cout << "  --debug       Enable debug mode and cheat keys" << std::endl;
             std::cout << "  --skip-title  Skip the title sequence" << std::endl;
+            std::cout << "  --native-res  Render gameplay at 320x200 and upscale once per frame" << std::endl;
+            std::cout << "  --texture-budget <MB>  Evict least recently used level textures above this size" << std::endl;
+            std::cout << "  --audio-buffer <frames>  Low-latency voice mixer with a 256-512 frame buffer" << std::endl;
+            std::cout << "  --headless --ticks <N>  Simulate N ticks without a window and print the final state" << std::endl;
+            std::cout << "  --input <file>  Scripted input for --headless (\"<tick> <keys>\" lines, keys LRJFOT)" << std::endl;
+            std::cout << "  --record <file>  Record the gameplay input of this session" << std::endl;
+            std::cout << "  --replay <file>  Play a recorded session back (fails if the simulation diverges)" << std::endl;
+            std::cout << "  --turbo       With --replay: run uncapped, drawing every Nth frame (--render-every N, default 60)" << std::endl;
+            std::cout << "  --headless --batch <N>  Run N independent games in parallel (--threads T, default all cores)" << std::endl;
+            std::cout << "  --headless --check-determinism  Play the input twice and report the first tick where the games differ" << std::endl;
+            std::cout << "  --perf-log <file>  Write per-frame phase timings to a CSV file" << std::endl;
+            std::cout << "  --stats       Print the runtime counters (draw calls, decodes, sounds, dropped ticks) at exit" << std::endl;
+            std::cout << "  --pacing <mode>  Frame pacing: vsync, fixed (default, 60 fps) or power-saver (30 fps)" << std::endl;
+            std::cout << "  --fps <N>     Target frame rate for --pacing fixed or power-saver" << std::endl;
+            std::cout << "  --interpolate  Draw the camera and actors between ticks instead of snapping (adds up to a tick of latency)" << std::endl;
+            std::cout << "  --render-on-change  Draw gameplay frames only when something on screen changed, sleeping in between" << std::endl;
+            std::cout << "  --latency-report  Time each gameplay key press to the tick that read it and the frame that showed it" << std::endl;
+            std::cout << "  --latency-log <file>  Also write each press's timestamps to a CSV file" << std::endl;
+            std::cout << "  --early-tick  Run the next tick at once on a fresh jump or fire press (up to half a tick early)" << std::endl;
+            std::cout << "  --threaded    Run the gameplay ticks on their own thread, apart from rendering" << std::endl;
+            std::cout << "  --capture <file>  Record the window to a video file, or \"|command\" to pipe it to an encoder" << std::endl;
+            std::cout << "                With --replay: render every frame offline, as fast as the writer keeps up" << std::endl;
+            std::cout << "  --capture-format <fmt>  Captured frames as y4m (default, 4:2:0) or raw (RGBA32)" << std::endl;
             std::cout << "  --help        Show this help message" << std::endl;
             return 0;
         }
     }
     
+    if (replay_path) {
+        if (!session.recording.load(replay_path)) {
+            return 1;
+        }
+        if (session.record_path) {
+            std::cerr << "--record is ignored while replaying" << std::endl;
+            session.record_path = nullptr;
+        }
+        if (session.recording.start_level != LEVEL_NUMBER_FOREST || session.recording.start_stage != 0) {
+            std::cerr << "Replay starts at level " << static_cast<int>(session.recording.start_level)
+                      << " stage " << static_cast<int>(session.recording.start_stage)
+                      << "; only sessions from the start of the game can be played back" << std::endl;
+            return 1;
+        }
+        session.replaying = true;
+        debug_mode = session.recording.debug_mode;
+        skip_title = true;
+    } else {
+        turbo = false;
+        session.recording.debug_mode = debug_mode;
+        session.recording.start_level = LEVEL_NUMBER_FOREST;
+        session.recording.start_stage = 0;
+        if (session.record_path && debug_mode) {
+            std::cerr << "Warning: cheat keys are not recorded; using them makes the replay diverge" << std::endl;
+        }
+    }
+
+    if (threaded && (turbo || early_tick || latency_report)) {
+        std::cerr << "--threaded cannot be combined with --turbo, --early-tick or --latency-report" << std::endl;
+        return 1;
+    }
+    if (render_on_change && (interpolate || turbo || capture_path)) {
+        // Interpolated frames all differ, and turbo and capture want every frame drawn
+        std::cerr << "--render-on-change cannot be combined with --interpolate, --turbo or --capture" << std::endl;
+        return 1;
+    }
+    // Capturing a replay renders it offline: every frame advances the game by
+    // exactly one frame period, with no waiting, so the video plays back at
+    // the right speed however fast (or slowly) it was rendered
+    const bool offline_capture = capture_path && session.replaying;
+    if (capture_path && (turbo || headless || (offline_capture && threaded))) {
+        std::cerr << "--capture cannot be combined with --turbo or --headless, or with --threaded while replaying"
+                  << std::endl;
+        return 1;
+    }
+
+    if (headless) {
+        int code = 0;
+        if (check_determinism) {
+            code = run_determinism_check(headless_ticks, input_script_path, session, debug_mode);
+        } else if (batch_games > 0) {
+            code = run_batch(batch_games, headless_ticks, batch_threads, input_script_path, session, debug_mode);
+        } else {
+            code = run_headless(headless_ticks, input_script_path, session, debug_mode);
+        }
+        if (print_stats) {
+            print_counters(std::cout);
+        }
+        return code;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return 1;
     }
+    const auto sdl_ready = std::chrono::steady_clock::now();
 
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
+    // Startup loads; its worker tasks run on g_graphics' decode pool
+    std::unique_ptr<LoadGraph> startup;
+    SimulationThread sim_thread;
+    // Title, beam and end-of-game sequences, stepped by the main loop
+    Sequencer sequencer;
+    FrameCapture capture;
 
     auto cleanup_and_exit = [&](int code) {
-        g_actor_system = nullptr;
+        sim_thread.stop();  // Before the cheats and audio it uses go away
+        startup.reset();    // Waits for a load still running on the decode pool
+        if (capture.is_active()) {
+            // Before the renderer its targets belong to goes away
+            const bool written = capture.stop();
+            std::cout << "Capture: " << capture.get_frames_captured() << " frame(s) to " << capture_path;
+            if (capture.get_frames_dropped() > 0) {
+                std::cout << ", " << capture.get_frames_dropped() << " dropped";
+            }
+            std::cout << std::endl;
+            if (!written && code == 0) {
+                code = 1;
+            }
+        }
+        sequencer.clear();  // Its steps hold textures of the renderer
+        stop_perf_log();
+        if (print_stats) {
+            print_counters(std::cout);
+        }
 
         if (g_cheats) {
             delete g_cheats;
@@ -333,17 +742,19 @@ int main(int argc, char* argv[]) {
         return code;
     };
 
-    window = SDL_CreateWindow("Captain Comic", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 640, 480, SDL_WINDOW_SHOWN);
+    window = SDL_CreateWindow("Captain Comic", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 640, 480,
+                              offline_capture ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
     if (window == nullptr) {
         std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return cleanup_and_exit(1);
     }
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    renderer = SDL_CreateRenderer(window, -1, FramePacer::renderer_flags(pacing_mode));
     if (renderer == nullptr) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return cleanup_and_exit(1);
     }
+    const auto window_ready = std::chrono::steady_clock::now();
 
     // Initialize graphics system
     g_graphics = new GraphicsSystem(renderer);
@@ -352,183 +763,237 @@ int main(int argc, char* argv[]) {
         return cleanup_and_exit(1);
     }
 
-    if (!initialize_audio_system()) {
-        std::cerr << "Warning: Audio system initialization failed. Continuing without sound." << std::endl;
+    if (native_res && g_graphics->set_native_framebuffer_enabled(true)) {
+        std::cout << "Native 320x200 framebuffer enabled" << std::endl;
     }
-
-    // Load persisted key bindings if KEYS.DEF is present.
-    load_input_bindings_from_file();
-
-    // Run startup notice and title sequence.
-    // Both are skipped with --skip-title for faster iteration during development.
-    if (!skip_title) {
-        if (!run_startup_notice(renderer, g_graphics)) {
-            return cleanup_and_exit(0);
+    g_graphics->set_texture_budget(texture_budget_mb * 1024 * 1024);
+    const auto graphics_ready = std::chrono::steady_clock::now();
+
+    // Everything else loads as a graph of tasks (see LoadGraph): decodes and
+    // the audio device on the worker pool, uploads on this thread between
+    // frames. Only the key bindings are waited for before the first frame;
+    // the rest loads behind the startup notice and the title sequence.
+    startup.reset(new LoadGraph(&g_graphics->get_decode_pool(), launch_time));
+    LoadGraph& loads = *startup;
+    loads.record("sdl_init", launch_time, sdl_ready);
+    loads.record("window", sdl_ready, window_ready);
+    loads.record("graphics", window_ready, graphics_ready);
+
+    const LoadTaskId key_bindings_task = loads.add("key_bindings", LoadThread::WORKER, []() {
+        load_input_bindings_from_file();  // Without KEYS.DEF the defaults stay
+        return true;
+    });
+    const LoadTaskId audio_task = loads.add("audio", LoadThread::WORKER, [audio_buffer_frames]() {
+        if (audio_buffer_frames != 0 && !set_audio_buffer_frames(audio_buffer_frames)) {
+            std::cerr << "Warning: Using the default audio buffer." << std::endl;
         }
-
-        if (!run_title_sequence(renderer, g_graphics)) {
-            // User quit during title sequence
-            return cleanup_and_exit(0);
+        if (!initialize_audio_system()) {
+            std::cerr << "Warning: Audio system initialization failed. Continuing without sound." << std::endl;
+            return false;
         }
-    }
-
-    // Initialize cheat system
-    g_cheats = new CheatSystem();
-    g_cheats->initialize(debug_mode);
+        return true;
+    });
 
-    ActorSystem actor_system;
+    // The game being played (and drawn: its stages load through g_graphics)
+    GameContext game;
+    game.graphics = g_graphics;
+    ActorSystem& actor_system = game.actors;
     actor_system.initialize();
     if (debug_mode) {
         actor_system.comic_firepower = 3;  // Start with 3 fireball slots in debug mode for testing
     }
-    
-    // Make actor system accessible to cheat system
-    g_actor_system = &actor_system;
 
-    // Initialize UI system
+    // Initialize cheat system (cheats act on the game being played)
+    g_cheats = new CheatSystem();
+    g_cheats->initialize(debug_mode, &game);
+
     UISystem ui_system;
-    if (!ui_system.initialize()) {
-        std::cerr << "Warning: UI system initialization failed. HUD will not display properly."
-                  << std::endl;
-    }
-    // Pre-load player sprites and create animations
     const char* sprite_names[] = {
         "comic_standing", "comic_running_1", "comic_running_2", "comic_running_3", "comic_jumping"
     };
     const char* directions[] = {"right", "left"};
 
-    for (const char* sprite : sprite_names) {
-        for (const char* dir : directions) {
-            if (!g_graphics->load_sprite(sprite, dir)) {
-                std::cerr << "Failed to load sprite: " << sprite << " (" << dir << ")" << std::endl;
-                return cleanup_and_exit(1);
+    // Queue every sprite decode at once so they spread over the workers
+    const LoadTaskId sprite_decodes_task = loads.add("sprite_decodes", LoadThread::RENDER, [&]() {
+        char name[32];
+        for (const char* sprite : sprite_names) {
+            for (const char* dir : directions) {
+                g_graphics->request_sprite(sprite, dir);
             }
         }
-    }
-
-    for (int i = 0; i < 8; ++i) {
-        std::string death_sprite = "comic_death_" + std::to_string(i);
-        if (!g_graphics->load_sprite(death_sprite, "")) {
-            std::cerr << "Failed to load sprite: " << death_sprite << std::endl;
-            return cleanup_and_exit(1);
+        for (int i = 0; i < 8; ++i) {
+            std::snprintf(name, sizeof(name), "comic_death_%d", i);
+            g_graphics->request_sprite(name, "");
         }
-    }
-
-    std::array<Sprite*, 12> materialize_sprites = {};
-    bool materialize_sprites_loaded = true;
-    for (size_t i = 0; i < materialize_sprites.size(); ++i) {
-        std::string materialize_name = "materialize_" + std::to_string(i);
-        if (!g_graphics->load_sprite(materialize_name, "")) {
-            std::cerr << "Warning: Could not load beam-in sprite: " << materialize_name << std::endl;
-            materialize_sprites_loaded = false;
+        for (int i = 0; i < 12; ++i) {
+            std::snprintf(name, sizeof(name), "materialize_%d", i);
+            g_graphics->request_sprite(name, "");
         }
-        materialize_sprites[i] = g_graphics->get_sprite(materialize_name, "");
-        if (!materialize_sprites[i]) {
-            materialize_sprites_loaded = false;
+        for (const char* sprite : {"teleport_0", "teleport_1", "teleport_2", "pause", "game_over"}) {
+            g_graphics->request_sprite(sprite, "");
         }
-    }
-
-    if (!g_graphics->load_sprite("teleport_0", "") ||
-        !g_graphics->load_sprite("teleport_1", "") ||
-        !g_graphics->load_sprite("teleport_2", "")) {
-        std::cerr << "Warning: Could not load one or more teleport sprites." << std::endl;
-    }
-
-    std::array<Sprite*, 5> teleport_sprites = {
-        g_graphics->get_sprite("teleport_0", ""),
-        g_graphics->get_sprite("teleport_1", ""),
-        g_graphics->get_sprite("teleport_2", ""),
-        g_graphics->get_sprite("teleport_1", ""),
-        g_graphics->get_sprite("teleport_0", "")
-    };
-
-    if (!g_graphics->load_sprite("pause", "")) {
-        std::cerr << "Warning: Could not load pause sprite (sprite-pause.png)."
-                  << std::endl;
-    }
-    Sprite* pause_sprite = g_graphics->get_sprite("pause", "");
+        ActorSystem::request_sprites(g_graphics);
+        UISystem::request_sprites(g_graphics);
+        prefetch_starting_stage(g_graphics);
+        return true;
+    });
+    // Uploads wait until no sprite decode is left, so they never block a frame
+    auto sprite_decodes_done = []() { return g_graphics->get_pending_sprite_decodes() == 0; };
 
-    if (!g_graphics->load_sprite("game_over", "")) {
-        std::cerr << "Warning: Could not load game-over sprite (sprite-game_over.png)."
-                  << std::endl;
-    }
-    Sprite* game_over_sprite = g_graphics->get_sprite("game_over", "");
+    // Pre-load player sprites and create animations
+    const LoadTaskId player_sprites_task = loads.add("player_sprites", LoadThread::RENDER, [&]() {
+        for (const char* sprite : sprite_names) {
+            for (const char* dir : directions) {
+                if (!g_graphics->load_sprite(sprite, dir)) {
+                    std::cerr << "Failed to load sprite: " << sprite << " (" << dir << ")" << std::endl;
+                    return false;
+                }
+            }
+        }
 
-    // Load fireball sprites
-    if (!actor_system.load_fireball_sprites(g_graphics)) {
-        std::cerr << "Warning: Could not load fireball sprites. Fireballs will not render." << std::endl;
-    }
+        for (int i = 0; i < 8; ++i) {
+            char death_sprite[32];
+            std::snprintf(death_sprite, sizeof(death_sprite), "comic_death_%d", i);
+            if (!g_graphics->load_sprite(death_sprite, "")) {
+                std::cerr << "Failed to load sprite: " << death_sprite << std::endl;
+                return false;
+            }
+        }
 
-    if (!actor_system.load_effect_sprites(g_graphics)) {
-        std::cerr << "Warning: Could not load one or more enemy spark sprites." << std::endl;
-    }
+        comic_idle_right = g_graphics->create_animation({"comic_standing"}, "right", 100, true);
+        comic_idle_left = g_graphics->create_animation({"comic_standing"}, "left", 100, true);
+        comic_run_right = g_graphics->create_animation(
+            {"comic_running_1", "comic_running_2", "comic_running_3"}, "right", 100, true);
+        comic_run_left = g_graphics->create_animation(
+            {"comic_running_1", "comic_running_2", "comic_running_3"}, "left", 100, true);
+        comic_jump_right = g_graphics->create_animation({"comic_jumping"}, "right", 100, true);
+        comic_jump_left = g_graphics->create_animation({"comic_jumping"}, "left", 100, true);
+        comic_death = g_graphics->create_animation(
+            {
+                "comic_death_0", "comic_death_1", "comic_death_2", "comic_death_3",
+                "comic_death_4", "comic_death_5", "comic_death_6", "comic_death_7"
+            },
+            "",
+            110,
+            false
+        );
+        return true;
+    }, {sprite_decodes_task}, sprite_decodes_done);
+    current_animation = &comic_idle_right;
 
-    // Create animations
-    comic_idle_right = g_graphics->create_animation({"comic_standing"}, "right", 100, true);
-    comic_idle_left = g_graphics->create_animation({"comic_standing"}, "left", 100, true);
-    comic_run_right = g_graphics->create_animation(
-        {"comic_running_1", "comic_running_2", "comic_running_3"}, "right", 100, true);
-    comic_run_left = g_graphics->create_animation(
-        {"comic_running_1", "comic_running_2", "comic_running_3"}, "left", 100, true);
-    comic_jump_right = g_graphics->create_animation({"comic_jumping"}, "right", 100, true);
-    comic_jump_left = g_graphics->create_animation({"comic_jumping"}, "left", 100, true);
-    comic_death = g_graphics->create_animation(
-        {
-            "comic_death_0", "comic_death_1", "comic_death_2", "comic_death_3",
-            "comic_death_4", "comic_death_5", "comic_death_6", "comic_death_7"
-        },
-        "",
-        110,
-        false
-    );
+    // Sprites are kept as registry handles and resolved when drawn.
+    std::array<SpriteId, 12> materialize_sprites;
+    materialize_sprites.fill(INVALID_SPRITE_ID);
+    bool materialize_sprites_loaded = true;
+    std::array<SpriteId, 5> teleport_sprites;
+    teleport_sprites.fill(INVALID_SPRITE_ID);
+    SpriteId pause_sprite_id = INVALID_SPRITE_ID;
+    SpriteId game_over_sprite_id = INVALID_SPRITE_ID;
+    loads.add("effect_sprites", LoadThread::RENDER, [&]() {
+        for (size_t i = 0; i < materialize_sprites.size(); ++i) {
+            char materialize_name[32];
+            std::snprintf(materialize_name, sizeof(materialize_name), "materialize_%zu", i);
+            materialize_sprites[i] = g_graphics->load_sprite_id(materialize_name, "");
+            if (materialize_sprites[i] == INVALID_SPRITE_ID) {
+                std::cerr << "Warning: Could not load beam-in sprite: " << materialize_name << std::endl;
+                materialize_sprites_loaded = false;
+            }
+        }
 
-    current_animation = &comic_idle_right;
+        const SpriteId teleport_0 = g_graphics->load_sprite_id("teleport_0", "");
+        const SpriteId teleport_1 = g_graphics->load_sprite_id("teleport_1", "");
+        const SpriteId teleport_2 = g_graphics->load_sprite_id("teleport_2", "");
+        if (teleport_0 == INVALID_SPRITE_ID ||
+            teleport_1 == INVALID_SPRITE_ID ||
+            teleport_2 == INVALID_SPRITE_ID) {
+            std::cerr << "Warning: Could not load one or more teleport sprites." << std::endl;
+        }
+        teleport_sprites = {teleport_0, teleport_1, teleport_2, teleport_1, teleport_0};
 
-    bool quit = false;
-    GameState game_state = GameState::Playing;
-    bool pause_waiting_for_escape_release = false;
-    bool beam_out_sequence_played = false;
-    uint8_t win_counter = 0;
-    SDL_Event e;
+        pause_sprite_id = g_graphics->load_sprite_id("pause", "");
+        if (pause_sprite_id == INVALID_SPRITE_ID) {
+            std::cerr << "Warning: Could not load pause sprite (sprite-pause.png)."
+                      << std::endl;
+        }
 
-    // Initialize all level data (tile data is compiled-in as hex arrays)
-    initialize_level_data();
+        game_over_sprite_id = g_graphics->load_sprite_id("game_over", "");
+        if (game_over_sprite_id == INVALID_SPRITE_ID) {
+            std::cerr << "Warning: Could not load game-over sprite (sprite-game_over.png)."
+                      << std::endl;
+        }
+        return materialize_sprites_loaded;
+    }, {sprite_decodes_task}, sprite_decodes_done);
+
+    loads.add("actor_sprites", LoadThread::RENDER, [&]() {
+        bool ok = true;
+        if (!actor_system.load_fireball_sprites(g_graphics)) {
+            std::cerr << "Warning: Could not load fireball sprites. Fireballs will not render." << std::endl;
+            ok = false;
+        }
+        if (!actor_system.load_effect_sprites(g_graphics)) {
+            std::cerr << "Warning: Could not load one or more enemy spark sprites." << std::endl;
+            ok = false;
+        }
+        if (!actor_system.load_item_sprites(g_graphics)) {
+            std::cerr << "Warning: Some item sprites failed to load" << std::endl;
+            ok = false;
+        }
+        return ok;
+    }, {sprite_decodes_task}, sprite_decodes_done);
 
-    // Load the first playable level (FOREST = level 1, stage 0)
-    // Level numbers: 0=LAKE, 1=FOREST, 2=SPACE, 3=BASE, 4=CAVE, 5=SHED, 6=CASTLE, 7=COMP
-    current_level_number = LEVEL_NUMBER_FOREST;  // Forest is the first playable level
-    current_stage_number = 0;
-    source_door_level_number = -1;  // Not entering via door
-    
-    // Set initial spawn position
-    comic_x = 14;
-    comic_y = 12;
-    comic_y_vel = 0;
-    
-    // Load the level and stage
-    load_new_level();
-    
-    if (!current_level_ptr) {
-        std::cerr << "Failed to load game level. Falling back to test level." << std::endl;
-        init_test_level();  // Fall back to test level if loading fails
-    }
+    loads.add("hud_sprites", LoadThread::RENDER, [&]() {
+        if (!ui_system.initialize()) {
+            std::cerr << "Warning: UI system initialization failed. HUD will not display properly."
+                      << std::endl;
+            return false;
+        }
+        return true;
+    }, {sprite_decodes_task}, sprite_decodes_done);
 
     // Cache for tileset to avoid per-frame lookups
-    uint8_t cached_level_number = current_level_number;
-    uint8_t cached_stage_number = current_stage_number;
+    uint8_t cached_level_number = game.current_level_number;
+    uint8_t cached_stage_number = game.current_stage_number;
     Tileset* cached_tileset = nullptr;
-    if (current_level_number < 8) {
-        cached_tileset = g_graphics->get_tileset(level_names[current_level_number]);
+    loads.add("starting_stage", LoadThread::RENDER, [&]() {
+        load_starting_level(game);
+        cached_level_number = game.current_level_number;
+        cached_stage_number = game.current_stage_number;
+        if (game.current_level_number < 8) {
+            cached_tileset = g_graphics->get_tileset(level_names[game.current_level_number]);
+        }
+        if (game.current_level_ptr) {
+            actor_system.setup_enemies_for_stage(game.current_level_ptr, game.current_level_number,
+                                                 game.current_stage_number, g_graphics);
+        }
+        return cached_tileset != nullptr;
+    }, {sprite_decodes_task}, []() { return g_graphics->is_tileset_ready(level_names[LEVEL_NUMBER_FOREST]); });
+
+    // Run the startup notice, loading behind it; the title sequence is
+    // queued once the notice is dismissed. Both are skipped with
+    // --skip-title for faster iteration during development.
+    bool startup_reported = false;
+    auto note_present = [&]() {
+        if (startup_reported) {
+            return;
+        }
+        loads.mark_first_frame();
+        if (loads.is_finished()) {
+            loads.print_report(std::cout);
+            startup_reported = true;
+        }
+    };
+    loads.wait(key_bindings_task);
+    if (!skip_title && !run_startup_notice(renderer, g_graphics, [&]() {
+            note_present();
+            loads.pump(STARTUP_LOAD_BUDGET_MS);
+        })) {
+        return cleanup_and_exit(0);
     }
 
-    if (current_level_ptr) {
-        actor_system.setup_enemies_for_stage(current_level_ptr, current_level_number, current_stage_number, g_graphics);
-    }
-    
-    // Load item sprites
-    if (!actor_system.load_item_sprites(g_graphics)) {
-        std::cerr << "Warning: Some item sprites failed to load" << std::endl;
-    }
+    bool quit = false;
+    GameState game_state = GameState::Playing;
+    bool pause_waiting_for_escape_release = false;
+    SDL_Event e;
 
     // Tick timing - match original game's ~9.1 Hz tick rate.
     // The PC timer interrupt (IRQ 0) fires at 18.2065 Hz but game_tick_flag is
@@ -540,32 +1005,24 @@ int main(int argc, char* argv[]) {
     constexpr double MS_PER_TICK = 1000.0 / TICK_RATE; // ~109.86 ms per tick
     constexpr int MAX_TICKS_PER_FRAME = 5;
     constexpr double MAX_ACCUMULATED_MS = MS_PER_TICK * MAX_TICKS_PER_FRAME;
-    uint32_t last_tick_time = SDL_GetTicks();
+    // --early-tick pulls a tick forward by at most this much; the tick after
+    // it keeps its usual time, so the game runs no faster on average
+    constexpr double EARLY_TICK_MAX_LEAD_MS = MS_PER_TICK / 2.0;
+    // The accumulator advances on the high-resolution counter; SDL_GetTicks'
+    // whole milliseconds would make tick spacing wobble by up to a frame
+    const double ms_per_performance_count = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    uint64_t last_frame_counter = SDL_GetPerformanceCounter();
     double tick_accumulator = 0.0;
 
-    // Keep special sequences on the same cadence as gameplay logic for
+    // Special sequences run on the same cadence as gameplay logic for
     // faithful pacing in this implementation.
     constexpr double ANIMATION_TICK_MS = MS_PER_TICK;
-    auto wait_animation_ticks = [&](int ticks) -> bool {
-        const uint32_t duration_ms = static_cast<uint32_t>(ANIMATION_TICK_MS * ticks + 0.5);
-        uint32_t start = SDL_GetTicks();
-        while (SDL_GetTicks() - start < duration_ms) {
-            while (SDL_PollEvent(&e) != 0) {
-                if (e.type == SDL_QUIT) {
-                    quit = true;
-                    return false;
-                }
-            }
-            SDL_Delay(1);
-        }
-        return true;
-    };
+    sequencer.set_ms_per_tick(ANIMATION_TICK_MS);
 
-    auto render_beam_in_frame = [&](bool show_comic, Sprite* materialize_sprite, bool present_frame = true) {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
+    auto render_beam_in_frame = [&](bool show_comic, SpriteId materialize_sprite_id) {
+        g_graphics->begin_frame();
 
-        SDL_Rect gameplay_frame_rect = g_graphics->compute_letterbox_rect(renderer);
+        SDL_Rect gameplay_frame_rect = g_graphics->get_gameplay_frame_rect();
 
         SDL_Texture* hud_texture = get_hud_texture();
         if (hud_texture) {
@@ -584,26 +1041,28 @@ int main(int argc, char* argv[]) {
         playfield_viewport.h = render_scale * PLAYFIELD_HEIGHT;
         SDL_RenderSetViewport(renderer, &playfield_viewport);
 
-        const int OFFSCREEN_MARGIN_UNITS = 2;
-        const int min_visible_x = camera_x - OFFSCREEN_MARGIN_UNITS;
-        const int max_visible_x = camera_x + PLAYFIELD_WIDTH + OFFSCREEN_MARGIN_UNITS;
-
-        for (int ty = 0; ty < MAP_HEIGHT_TILES; ty++) {
-            for (int tx = 0; tx < MAP_WIDTH_TILES; tx++) {
-                int world_x = tx * 2;
-                if (world_x + 2 > min_visible_x && world_x < max_visible_x) {
-                    uint8_t tile = get_tile_at(tx * 2, ty * 2);
-                    int screen_x = (world_x - camera_x) * render_scale;
-                    int screen_y = ty * 2 * render_scale;
-                    g_graphics->render_tile(screen_x, screen_y, cached_tileset, tile, render_scale);
+        if (!g_graphics->render_stage_background(game, cached_tileset, game.camera_x, render_scale)) {
+            const int OFFSCREEN_MARGIN_UNITS = 2;
+            const int min_visible_x = game.camera_x - OFFSCREEN_MARGIN_UNITS;
+            const int max_visible_x = game.camera_x + PLAYFIELD_WIDTH + OFFSCREEN_MARGIN_UNITS;
+
+            for (int ty = 0; ty < MAP_HEIGHT_TILES; ty++) {
+                for (int tx = 0; tx < MAP_WIDTH_TILES; tx++) {
+                    int world_x = tx * 2;
+                    if (world_x + 2 > min_visible_x && world_x < max_visible_x) {
+                        uint8_t tile = get_tile_at(game, tx * 2, ty * 2);
+                        int screen_x = (world_x - game.camera_x) * render_scale;
+                        int screen_y = ty * 2 * render_scale;
+                        g_graphics->render_tile(screen_x, screen_y, cached_tileset, tile, render_scale);
+                    }
                 }
             }
         }
 
-        actor_system.render_item(g_graphics, camera_x, render_scale);
+        actor_system.render_item(g_graphics, game.camera_x, render_scale);
 
-        const int comic_screen_x = (comic_x - camera_x) * render_scale + render_scale;
-        const int comic_screen_y = comic_y * render_scale + render_scale * 2;
+        const int comic_screen_x = (game.comic_x - game.camera_x) * render_scale + render_scale;
+        const int comic_screen_y = game.comic_y * render_scale + render_scale * 2;
         const int comic_width = render_scale * 2;
         const int comic_height = render_scale * 4;
 
@@ -619,6 +1078,7 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        const Sprite* materialize_sprite = g_graphics->get_sprite(materialize_sprite_id);
         if (materialize_sprite) {
             g_graphics->render_sprite_centered_scaled(
                 comic_screen_x,
@@ -631,53 +1091,84 @@ int main(int argc, char* argv[]) {
         SDL_RenderSetViewport(renderer, &gameplay_frame_rect);
         SDL_RenderSetScale(renderer, letterbox_scale, letterbox_scale);
         ui_system.render_hud(
-            score_bytes,
-            comic_num_lives,
-            comic_hp,
+            game.score_bytes,
+            game.comic_num_lives,
+            game.comic_hp,
             actor_system.fireball_meter,
             actor_system.comic_firepower,
             actor_system.comic_has_corkscrew != 0,
-            comic_has_door_key != 0,
+            game.comic_has_door_key != 0,
             actor_system.comic_has_teleport_wand != 0,
             actor_system.comic_has_lantern != 0,
             actor_system.comic_has_gems != 0,
             actor_system.comic_has_crown != 0,
             actor_system.comic_has_gold != 0,
-            comic_jump_power
+            game.comic_jump_power
         );
         SDL_RenderSetScale(renderer, 1.0f, 1.0f);
         SDL_RenderSetViewport(renderer, nullptr);
 
-        if (present_frame) {
-            SDL_RenderPresent(renderer);
-        }
+        // Leave the renderer in window space so callers can draw overlays
+        // (e.g. GAME OVER) with compute_letterbox_rect before presenting.
+        g_graphics->end_frame();
+    };
+
+    // Queue a step showing the playfield with Comic and/or a beam sprite
+    auto show_beam_frame = [&](bool show_comic, SpriteId materialize_sprite_id) {
+        sequencer.show([&render_beam_in_frame, show_comic, materialize_sprite_id]() {
+            render_beam_in_frame(show_comic, materialize_sprite_id);
+        });
     };
 
-    auto play_beam_out_sequence = [&]() {
-        if (!materialize_sprites_loaded || quit) {
+    auto render_game_over_sprite = [&]() {
+        const Sprite* game_over_sprite = g_graphics->get_sprite(game_over_sprite_id);
+        if (!game_over_sprite) {
             return;
         }
 
-        play_game_sound(GameSound::MATERIALIZE);
+        SDL_Rect gameplay_frame_rect = g_graphics->compute_letterbox_rect(renderer);
+        const float letterbox_scale = static_cast<float>(gameplay_frame_rect.w) / EGA_WIDTH;
+
+        const int game_over_x_ega = 40;
+        const int game_over_y_ega = 64;
+        const int game_over_width_ega = 128;
+        const int game_over_height_ega = 48;
 
-        render_beam_in_frame(true, nullptr);
-        if (!wait_animation_ticks(1)) {
+        SDL_Rect game_over_rect = {
+            gameplay_frame_rect.x + static_cast<int>(game_over_x_ega * letterbox_scale),
+            gameplay_frame_rect.y + static_cast<int>(game_over_y_ega * letterbox_scale),
+            static_cast<int>(game_over_width_ega * letterbox_scale),
+            static_cast<int>(game_over_height_ega * letterbox_scale)
+        };
+        SDL_RenderCopy(renderer, game_over_sprite->texture.texture, nullptr, &game_over_rect);
+    };
+
+    auto show_game_over_frame = [&]() {
+        sequencer.show([&render_beam_in_frame, &render_game_over_sprite]() {
+            render_beam_in_frame(false, INVALID_SPRITE_ID);
+            render_game_over_sprite();
+        });
+    };
+
+    auto queue_beam_out_sequence = [&]() {
+        if (!materialize_sprites_loaded) {
             return;
         }
 
+        sequencer.run([]() { play_game_sound(GameSound::MATERIALIZE); });
+
+        show_beam_frame(true, INVALID_SPRITE_ID);
+        sequencer.wait_ticks(1);
+
         for (size_t frame = materialize_sprites.size(); frame > 0; --frame) {
             const size_t sprite_index = frame - 1;
             const bool show_comic = sprite_index >= 6;
-            render_beam_in_frame(show_comic, materialize_sprites[sprite_index]);
-            if (!wait_animation_ticks(1)) {
-                return;
-            }
+            show_beam_frame(show_comic, materialize_sprites[sprite_index]);
+            sequencer.wait_ticks(1);
         }
 
-        if (!quit) {
-            render_beam_in_frame(false, nullptr);
-            wait_animation_ticks(6);
-        }
+        show_beam_frame(false, INVALID_SPRITE_ID);
+        sequencer.wait_ticks(6);
     };
 
     auto render_fullscreen_texture = [&](SDL_Texture* texture) {
@@ -689,12 +1180,10 @@ int main(int argc, char* argv[]) {
         SDL_RenderClear(renderer);
         SDL_Rect dst = g_graphics->compute_letterbox_rect(renderer);
         SDL_RenderCopy(renderer, texture, nullptr, &dst);
-        SDL_RenderPresent(renderer);
     };
 
     auto load_fullscreen_texture = [&](const char* filename) -> SDL_Texture* {
-        const std::string path = g_graphics->get_asset_path(filename);
-        SDL_Surface* surface = IMG_Load(path.c_str());
+        SDL_Surface* surface = g_graphics->load_asset_surface(filename);
         if (!surface) {
             std::cerr << "Victory sequence: failed to load " << filename
                       << " (" << IMG_GetError() << ")" << std::endl;
@@ -711,194 +1200,301 @@ int main(int argc, char* argv[]) {
         return texture;
     };
 
-    auto wait_for_new_keypress = [&]() -> bool {
-        // Drain queued input so the player must press a fresh key, matching DOS flow.
-        while (SDL_PollEvent(&e) != 0) {
-            if (e.type == SDL_QUIT) {
+    // The high scores screen keeps its own loop for the name entry
+    auto queue_high_scores_screen = [&]() {
+        sequencer.run([&]() {
+            if (!run_high_scores_screen(renderer, g_graphics, game.score_bytes)) {
                 quit = true;
-                return false;
-            }
-        }
-
-        while (!quit) {
-            while (SDL_PollEvent(&e) != 0) {
-                if (e.type == SDL_QUIT) {
-                    quit = true;
-                    return false;
-                }
-                if (e.type == SDL_KEYDOWN && e.key.repeat == 0) {
-                    return true;
-                }
             }
-            SDL_Delay(1);
-        }
-
-        return false;
+        });
     };
 
-    auto play_victory_sequence = [&]() {
-        play_beam_out_sequence();
-        if (quit) {
-            return;
-        }
+    auto queue_victory_sequence = [&]() {
+        queue_beam_out_sequence();
+        sequencer.run([&game]() { clear_gameplay_key_states(game); });
+        show_beam_frame(false, INVALID_SPRITE_ID);
+        queue_victory_tally(sequencer, game);
 
-        clear_gameplay_key_states();
+        sequencer.run([]() { play_game_music(GameMusic::TITLE); });
 
-        // Base victory bonus: 20,000 points as twenty 1,000-point tally steps.
-        for (int step = 0; step < 20 && !quit; ++step) {
-            play_game_sound(GameSound::ITEM_COLLECT);
-            award_points(10);
-            render_beam_in_frame(false, nullptr);
-            wait_animation_ticks(1);
+        SDL_Texture* victory_texture = load_fullscreen_texture("sys002.ega.png");
+        if (victory_texture) {
+            // The steps showing it own it
+            std::shared_ptr<SDL_Texture> texture(victory_texture, SDL_DestroyTexture);
+            sequencer.show([&render_fullscreen_texture, texture]() {
+                render_fullscreen_texture(texture.get());
+            });
+            sequencer.wait_for_key();
         }
 
-        // Remaining lives bonus: 10,000 points per life, then decrement one life icon.
-        while (comic_num_lives > 0 && !quit) {
-            for (int step = 0; step < 10 && !quit; ++step) {
-                play_game_sound(GameSound::ITEM_COLLECT);
-                award_points(10);
-                render_beam_in_frame(false, nullptr);
-                wait_animation_ticks(1);
-            }
+        sequencer.run([]() { stop_game_music(); });
 
-            comic_num_lives--;
-            render_beam_in_frame(false, nullptr);
-            wait_animation_ticks(3);
-        }
+        show_game_over_frame();
+        sequencer.wait_for_key();
 
-        play_game_music(GameMusic::TITLE);
+        queue_high_scores_screen();
+    };
 
-        SDL_Texture* victory_texture = load_fullscreen_texture("sys002.ega.png");
-        if (victory_texture && !quit) {
-            render_fullscreen_texture(victory_texture);
-            wait_for_new_keypress();
-        }
+    auto queue_game_over_sequence = [&]() {
+        clear_gameplay_key_states(game);
+        pause_waiting_for_escape_release = false;
 
-        stop_game_music();
+        show_game_over_frame();
+        if (g_graphics->get_sprite(game_over_sprite_id)) {
+            sequencer.run([]() { play_game_sound(GameSound::GAME_OVER); });
+        }
+        sequencer.wait_ticks(1);
+        sequencer.wait_for_key();
 
-        if (!quit) {
-            render_beam_in_frame(false, nullptr, false);
+        queue_high_scores_screen();
+    };
 
-            if (game_over_sprite) {
-                SDL_Rect gameplay_frame_rect = g_graphics->compute_letterbox_rect(renderer);
-                const float letterbox_scale = static_cast<float>(gameplay_frame_rect.w) / EGA_WIDTH;
+    // Debug rewind (hold F8) and quick save/load (F6/F7) through snapshots of
+    // every tick; off while recording or replaying, which they would desync,
+    // and for an actor pool larger than a snapshot holds
+    const bool snapshots_enabled = debug_mode && !session.replaying && !session.record_path && !threaded &&
+                                   actor_system.fits_snapshot();
+    SnapshotRing rewind_ring(snapshots_enabled ? SNAPSHOT_RING_DEFAULT_TICKS : 1,
+                             snapshots_enabled ? SNAPSHOT_RING_DEFAULT_BYTES : 0);
+    GameSnapshot tick_snapshot;
+    GameSnapshot quick_save;
+    bool has_quick_save = false;
+    bool rewind_held = false;
+    uint64_t snapshot_tick = 0;
+
+    // Whatever is still loading when the title ends (or right away with
+    // --skip-title) is waited for here, before the beam-in and the first tick
+    bool startup_failed = false;
+    auto finish_startup = [&]() {
+        loads.finish();
+        if (!loads.wait(player_sprites_task)) {
+            std::cerr << "Startup failed: the player sprites did not load." << std::endl;
+            startup_failed = true;
+            quit = true;
+            return;
+        }
+        game.run_frame_count = static_cast<int>(comic_run_right.frames.size());
+        game.enemy_level_number = game.current_level_number;
+        game.enemy_stage_number = game.current_stage_number;
+        if (snapshots_enabled) {
+            capture_snapshot(game, tick_snapshot);
+            rewind_ring.push(snapshot_tick, tick_snapshot);
+        }
 
-                const int game_over_x_ega = 40;
-                const int game_over_y_ega = 64;
-                const int game_over_width_ega = 128;
-                const int game_over_height_ega = 48;
+        if (materialize_sprites_loaded && !turbo) {
+            show_beam_frame(false, INVALID_SPRITE_ID);
+            sequencer.wait_ticks(15);
 
-                SDL_Rect game_over_rect = {
-                    gameplay_frame_rect.x + static_cast<int>(game_over_x_ega * letterbox_scale),
-                    gameplay_frame_rect.y + static_cast<int>(game_over_y_ega * letterbox_scale),
-                    static_cast<int>(game_over_width_ega * letterbox_scale),
-                    static_cast<int>(game_over_height_ega * letterbox_scale)
-                };
+            sequencer.run([]() { play_game_sound(GameSound::MATERIALIZE); });
 
-                SDL_RenderCopy(renderer, game_over_sprite->texture.texture, nullptr, &game_over_rect);
-                SDL_RenderPresent(renderer);
+            for (size_t frame = 0; frame < materialize_sprites.size(); ++frame) {
+                bool show_comic = frame >= 6;
+                show_beam_frame(show_comic, materialize_sprites[frame]);
+                sequencer.wait_ticks(1);
             }
 
-            wait_for_new_keypress();
-        }
-
-        if (!quit) {
-            if (!run_high_scores_screen(renderer, g_graphics, score_bytes)) {
-                quit = true;
-            }
-        }
+            show_beam_frame(true, INVALID_SPRITE_ID);
+            sequencer.wait_ticks(1);
 
-        if (victory_texture) {
-            SDL_DestroyTexture(victory_texture);
+            sequencer.run([&game]() { clear_gameplay_key_states(game); });
         }
     };
 
-    auto play_game_over_sequence = [&]() {
-        clear_gameplay_key_states();
-        game_state = GameState::Playing;
-        pause_waiting_for_escape_release = false;
-
-        render_beam_in_frame(false, nullptr, false);
-
-        if (game_over_sprite && !quit) {
-            SDL_Rect gameplay_frame_rect = g_graphics->compute_letterbox_rect(renderer);
-            const float letterbox_scale = static_cast<float>(gameplay_frame_rect.w) / EGA_WIDTH;
+    // The title sequence and the beam-in play first, driven by the main loop;
+    // the title only needs its music, the rest keeps loading behind it
+    if (!skip_title) {
+        loads.wait(audio_task);
+        queue_title_sequence(sequencer, renderer, g_graphics);
+        sequencer.run([&finish_startup]() { finish_startup(); });
+    } else {
+        finish_startup();
+    }
 
-            const int game_over_x_ega = 40;
-            const int game_over_y_ega = 64;
-            const int game_over_width_ega = 128;
-            const int game_over_height_ega = 48;
+    // Replay timing: wall time for ticks per second, per-frame times for percentiles
+    auto session_start = std::chrono::steady_clock::now();
+    auto frame_start = session_start;
+    std::vector<double> frame_times_ms;
+    uint64_t frame_index = 0;
 
-            SDL_Rect game_over_rect = {
-                gameplay_frame_rect.x + static_cast<int>(game_over_x_ega * letterbox_scale),
-                gameplay_frame_rect.y + static_cast<int>(game_over_y_ega * letterbox_scale),
-                static_cast<int>(game_over_width_ega * letterbox_scale),
-                static_cast<int>(game_over_height_ega * letterbox_scale)
-            };
-            SDL_RenderCopy(renderer, game_over_sprite->texture.texture, nullptr, &game_over_rect);
-            SDL_RenderPresent(renderer);
-            play_game_sound(GameSound::GAME_OVER);
+    // Per-phase frame timing: streamed with --perf-log, graphed in the debug overlay
+    if (perf_log_path) {
+        if (!start_perf_log(perf_log_path)) {
+            return cleanup_and_exit(1);
         }
+    } else if (debug_mode) {
+        enable_frame_profiler(true);
+    }
 
-        if (!quit) {
-            wait_animation_ticks(1);
-            wait_for_new_keypress();
+    FramePacer pacer;
+    pacer.start(pacing_mode, target_fps, renderer, window);
+    std::cout << "Frame pacing: " << get_pacing_mode_name(pacer.get_mode());
+    if (pacer.get_mode() != PacingMode::VSYNC) {
+        std::cout << " at " << pacer.get_target_fps() << " fps";
+    }
+    std::cout << (interpolate ? ", interpolated" : "") << (render_on_change ? ", render on change" : "") << std::endl;
+    if (capture_path) {
+        if (!capture.start(renderer, capture_path, capture_format, pacer.get_target_fps(), offline_capture)) {
+            return cleanup_and_exit(1);
         }
-
-        if (!quit) {
-            if (!run_high_scores_screen(renderer, g_graphics, score_bytes)) {
-                quit = true;
-            }
+        std::cout << "Capturing to " << capture_path << (offline_capture ? " (offline)" : "") << std::endl;
+    }
+    // Offline capture runs on this clock instead of the wall clock
+    const double capture_frame_ms = 1000.0 / pacer.get_target_fps();
+    double capture_clock_ms = 0.0;
+    auto frame_time_ms = [&]() {
+        return offline_capture ? static_cast<uint32_t>(capture_clock_ms) : SDL_GetTicks();
+    };
+    auto begin_captured_frame = [&]() {
+        capture.begin_frame();
+        g_graphics->set_frame_target(capture.get_frame_target());
+    };
+    RenderInterpolator interpolator;
+    interpolator.set_enabled(interpolate);
+    SceneChangeTracker scene_tracker;
+    scene_tracker.set_enabled(render_on_change);
+    // The longest --render-on-change sleeps between looks at the game
+    constexpr double MAX_IDLE_MS = MS_PER_TICK;
+    uint32_t animation_deadline = 0;  // When Comic's animation next changes frame; 0 for never
+    // Upload textures for asset decodes that finished in the background; a
+    // new texture may show up in a frame that is otherwise unchanged. The
+    // texture budget may evict enemy sprites here, so the actors look theirs
+    // up again before the next draw.
+    auto pump_asset_uploads = [&]() {
+        const uint64_t textures_before = get_counter(Counter::TEXTURES_CREATED);
+        g_graphics->pump_asset_uploads();
+        actor_system.bind_enemy_sprites(g_graphics);
+        if (get_counter(Counter::TEXTURES_CREATED) != textures_before) {
+            scene_tracker.invalidate();
         }
     };
-
-    if (materialize_sprites_loaded && !quit) {
-        for (int frame = 0; frame < 15; ++frame) {
-            render_beam_in_frame(false, nullptr);
-            if (!wait_animation_ticks(1)) {
-                break;
+    ActorRenderOffsets actor_offsets;
+    InputLatencyTracker latency;
+    latency.set_enabled(latency_report);
+    bool early_tick_requested = false;
+
+    // --threaded: the simulation thread runs the ticks on its own copy of
+    // the game, and game becomes the copy of its latest tick being drawn
+    uint64_t drawn_tick = 0;
+    auto start_simulation_thread = [&]() {
+        g_cheats->set_game(sim_thread.get_game());
+        sim_thread.start(game, MS_PER_TICK, [&session](GameContext& sim_game, TickOutcome* outcome) {
+            if (!begin_session_tick(session, sim_game)) {
+                return false;  // Replay finished
             }
-        }
+            *outcome = run_gameplay_tick(sim_game);
+            end_session_tick(session, sim_game);
+            return !session.diverged;
+        });
+        std::cout << "Simulation thread started" << std::endl;
+    };
+    bool sim_thread_pending = threaded;  // Started once the beam-in is over
 
-        if (!quit) {
-            play_game_sound(GameSound::MATERIALIZE);
+    while (!quit) {
+        profiler_begin_frame();
+        count_event(Counter::FRAMES);
+        // Transient strings and lists of the last frame are done with
+        frame_arena().reset();
+        if (offline_capture) {
+            capture_clock_ms += capture_frame_ms;
+        }
 
-            for (size_t frame = 0; frame < materialize_sprites.size(); ++frame) {
-                bool show_comic = frame >= 6;
-                render_beam_in_frame(show_comic, materialize_sprites[frame]);
-                if (!wait_animation_ticks(1)) {
-                    break;
+        if (sequencer.is_active()) {
+            // A sequence is playing: no ticks run, and the time it takes is
+            // not owed to gameplay afterwards
+            PROFILE_BEGIN(ProfilePhase::EVENTS);
+            while (SDL_PollEvent(&e) != 0) {
+                if (e.type == SDL_QUIT) {
+                    quit = true;
+                } else if (e.type == SDL_RENDER_TARGETS_RESET) {
+                    g_graphics->invalidate_stage_background();
+                    ui_system.invalidate_hud_cache();
+                } else if (e.type == SDL_KEYDOWN && e.key.repeat == 0) {
+                    sequencer.on_key_down();
                 }
             }
-        }
+            PROFILE_END();
+
+            if (!quit && sequencer.update(frame_time_ms()) && !quit) {
+                begin_captured_frame();
+                sequencer.draw();
+                scene_tracker.invalidate();  // Gameplay frames draw over the sequence's
+                capture.end_frame();
+                PROFILE_BEGIN(ProfilePhase::PRESENT);
+                SDL_RenderPresent(renderer);
+                PROFILE_END();
+                pacer.mark_present();
+                note_present();
+
+                PROFILE_BEGIN(ProfilePhase::UPLOADS);
+                pump_asset_uploads();
+                PROFILE_END();
+                if (!offline_capture) {
+                    pacer.wait_for_next_frame();
+                }
+            }
+            // Startup loads carry on behind the title, a slice per frame
+            if (!quit && !loads.is_finished()) {
+                PROFILE_BEGIN(ProfilePhase::UPLOADS);
+                loads.pump(STARTUP_LOAD_BUDGET_MS);
+                PROFILE_END();
+            }
 
-        if (!quit) {
-            render_beam_in_frame(true, nullptr);
-            wait_animation_ticks(1);
+            tick_accumulator = 0.0;
+            last_frame_counter = SDL_GetPerformanceCounter();
+            session_start = std::chrono::steady_clock::now();
+            frame_start = session_start;
+            interpolator.reset();
+            continue;
+        }
+        if (game_state == GameState::Exiting) {
+            break;  // The end-of-game sequence is over
+        }
+        if (sim_thread_pending) {
+            sim_thread_pending = false;
+            start_simulation_thread();
         }
 
-        clear_gameplay_key_states();
-    }
-
-    // Persists between render frames; updated each tick when movement is attempted.
-    bool player_moved_last_tick = false;
-    // True while airborne due to walking off an edge (not a jump).
-    bool player_airborne_from_walk_off = false;
-
-    while (!quit) {
-        uint32_t current_time = SDL_GetTicks();
-        uint32_t delta_time = current_time - last_tick_time;
-        last_tick_time = current_time;
-        tick_accumulator += delta_time;
-        bool suppress_jump_animation_this_frame = false;
+        uint32_t current_time = frame_time_ms();
+        const uint64_t frame_counter = SDL_GetPerformanceCounter();
+        tick_accumulator += offline_capture
+            ? capture_frame_ms
+            : static_cast<double>(frame_counter - last_frame_counter) * ms_per_performance_count;
+        last_frame_counter = frame_counter;
+        game.suppress_jump_animation = false;
         if (tick_accumulator > MAX_ACCUMULATED_MS) {
+            // Whole ticks thrown away here leave the game behind real time
+            const int ticks_due = static_cast<int>(tick_accumulator / MS_PER_TICK);
+            if (!turbo && game_state == GameState::Playing && ticks_due > MAX_TICKS_PER_FRAME) {
+                count_event(Counter::TICKS_DROPPED, static_cast<uint64_t>(ticks_due - MAX_TICKS_PER_FRAME));
+            }
             tick_accumulator = MAX_ACCUMULATED_MS;
         }
+        if (turbo) {
+            tick_accumulator = MS_PER_TICK;  // Exactly one tick per loop, unthrottled
+        }
+        if (session.replaying) {
+            const auto now = std::chrono::steady_clock::now();
+            if (frame_index > 0) {
+                frame_times_ms.push_back(std::chrono::duration<double, std::milli>(now - frame_start).count());
+            }
+            frame_start = now;
+        }
+        ++frame_index;
 
+        PROFILE_BEGIN(ProfilePhase::EVENTS);
         while (SDL_PollEvent(&e) != 0) {
             if (e.type == SDL_QUIT) {
                 quit = true;
-            } else if (e.type == SDL_KEYDOWN) {
+            } else if (e.type == SDL_RENDER_TARGETS_RESET) {
+                // Render-target contents are lost; re-render the cached layers.
+                // A lost device (SDL_RENDER_DEVICE_RESET) destroys every texture,
+                // sprites, tiles and glyph atlases included; it is not recovered.
+                g_graphics->invalidate_stage_background();
+                ui_system.invalidate_hud_cache();
+                scene_tracker.invalidate();
+            } else if (e.type == SDL_WINDOWEVENT) {
+                scene_tracker.invalidate();  // Resized or exposed: the window needs a frame
+            } else if (e.type == SDL_KEYDOWN && !session.replaying) {
                 const InputBindings& bindings = get_input_bindings();
                 const SDL_Keycode key = e.key.keysym.sym;
 
@@ -917,7 +1513,11 @@ int main(int argc, char* argv[]) {
                     }
 
                     game_state = GameState::Playing;
-                    clear_gameplay_key_states();
+                    clear_gameplay_key_states(game);
+                    if (sim_thread.is_running()) {
+                        sim_thread.send({SimInputType::RESUME, 0, SDLK_UNKNOWN});
+                    }
+                    latency.discard_pending();
                     tick_accumulator = 0.0;
                     continue;
                 }
@@ -925,35 +1525,85 @@ int main(int argc, char* argv[]) {
                 if (key == SDLK_ESCAPE && e.key.repeat == 0) {
                     game_state = GameState::Paused;
                     pause_waiting_for_escape_release = true;
-                    clear_gameplay_key_states();
+                    clear_gameplay_key_states(game);
+                    if (sim_thread.is_running()) {
+                        sim_thread.send({SimInputType::PAUSE, 0, SDLK_UNKNOWN});
+                    }
+                    latency.discard_pending();
                     tick_accumulator = 0.0;
                     continue;
                 }
 
+                if (snapshots_enabled && e.key.repeat == 0) {
+                    if (key == SDLK_F6) {
+                        capture_snapshot(game, quick_save);
+                        has_quick_save = true;
+                        if (quick_save.save(QUICK_SAVE_PATH)) {
+                            std::cout << "Quick saved to " << QUICK_SAVE_PATH << std::endl;
+                        }
+                        continue;
+                    }
+                    if (key == SDLK_F7) {
+                        if (!has_quick_save) {
+                            has_quick_save = quick_save.load(QUICK_SAVE_PATH);
+                        }
+                        if (has_quick_save) {
+                            restore_snapshot(game, quick_save);
+                            clear_gameplay_key_states(game);
+                            latency.discard_pending();
+                            interpolator.reset();
+                            // Rewinding starts over from the loaded state
+                            rewind_ring.clear();
+                            snapshot_tick = 0;
+                            capture_snapshot(game, tick_snapshot);
+                            rewind_ring.push(snapshot_tick, tick_snapshot);
+                            std::cout << "Quick loaded" << std::endl;
+                        }
+                        continue;
+                    }
+                    if (key == SDLK_F8) {
+                        rewind_held = true;
+                        continue;
+                    }
+                }
+
+                if (sim_thread.is_running()) {
+                    // The simulation thread owns the game (and runs the cheat keys)
+                    sim_thread.send({SimInputType::KEY_DOWN, bound_input_keys(key, bindings), key});
+                    continue;
+                }
+
                 // Process regular gameplay keys
 
                 if (key_matches_binding(key, bindings.move_left)) {
-                    key_state_left = 1;
+                    game.key_state_left = 1;
                 }
                 if (key_matches_binding(key, bindings.move_right)) {
-                    key_state_right = 1;
+                    game.key_state_right = 1;
                 }
                 if (key_matches_binding(key, bindings.jump)) {
-                    key_state_jump = 1;
+                    game.key_state_jump = 1;
                 }
                 if (key_matches_binding(key, bindings.fire)) {
-                    key_state_fire = 1;
+                    game.key_state_fire = 1;
                 }
                 if (key_matches_binding(key, bindings.open_door)) {
-                    key_state_open = 1;
+                    game.key_state_open = 1;
                 }
                 if (key_matches_binding(key, bindings.teleport)) {
-                    key_state_teleport = 1;
+                    game.key_state_teleport = 1;
+                }
+                if (e.key.repeat == 0) {
+                    const uint8_t pressed = bound_input_keys(key, bindings);
+                    latency.record_press(pressed, e.key.timestamp, SDL_GetTicks());
+                    if (early_tick && (pressed & (INPUT_JUMP | INPUT_FIRE)) != 0) {
+                        early_tick_requested = true;
+                    }
                 }
                 
                 // Process cheat keys (only active if --debug flag set)
                 g_cheats->process_input(e.key.keysym.sym);
-            } else if (e.type == SDL_KEYUP) {
+            } else if (e.type == SDL_KEYUP && !session.replaying) {
                 const InputBindings& bindings = get_input_bindings();
                 const SDL_Keycode key = e.key.keysym.sym;
 
@@ -964,243 +1614,174 @@ int main(int argc, char* argv[]) {
                     continue;
                 }
 
+                if (sim_thread.is_running()) {
+                    sim_thread.send({SimInputType::KEY_UP, bound_input_keys(key, bindings), key});
+                    continue;
+                }
+
+                if (snapshots_enabled && key == SDLK_F8) {
+                    // The rewound key states are history; start from the keys held now
+                    rewind_held = false;
+                    clear_gameplay_key_states(game);
+                    latency.discard_pending();
+                    continue;
+                }
+
                 if (key_matches_binding(key, bindings.move_left)) {
-                    key_state_left = 0;
+                    game.key_state_left = 0;
                 }
                 if (key_matches_binding(key, bindings.move_right)) {
-                    key_state_right = 0;
+                    game.key_state_right = 0;
                 }
                 if (key_matches_binding(key, bindings.jump)) {
-                    key_state_jump = 0;
+                    game.key_state_jump = 0;
                 }
                 if (key_matches_binding(key, bindings.fire)) {
-                    key_state_fire = 0;
+                    game.key_state_fire = 0;
                 }
                 if (key_matches_binding(key, bindings.open_door)) {
-                    key_state_open = 0;
+                    game.key_state_open = 0;
                 }
                 if (key_matches_binding(key, bindings.teleport)) {
-                    key_state_teleport = 0;
+                    game.key_state_teleport = 0;
                 }
+                latency.record_release(bound_input_keys(key, bindings));
+            }
+        }
+        PROFILE_END();
+
+        // A fresh jump or fire press runs the tick due soonest right away
+        // instead of waiting up to a whole tick for it
+        double early_tick_lead_ms = 0.0;
+        if (early_tick_requested) {
+            early_tick_requested = false;
+            const double lead_ms = MS_PER_TICK - tick_accumulator;
+            if (game_state == GameState::Playing && !rewind_held && lead_ms > 0.0 &&
+                lead_ms <= EARLY_TICK_MAX_LEAD_MS) {
+                tick_accumulator = MS_PER_TICK;
+                early_tick_lead_ms = lead_ms;
+                count_event(Counter::EARLY_TICKS);
             }
         }
 
         // Process physics ticks at ~9.1 Hz (original game speed)
         // This decouples physics from rendering rate
-        if (game_state == GameState::Playing) {
+        if (sim_thread.is_running()) {
+            PROFILE_BEGIN(ProfilePhase::TICKS);
+            tick_accumulator = 0.0;  // The simulation thread keeps its own time
+            if (sim_thread.consume_state()) {
+                const SimRenderState& state = sim_thread.get_state();
+                const uint8_t drawn_level = game.current_level_number;
+                const uint8_t drawn_stage = game.current_stage_number;
+                interpolator.capture_previous(game);
+                game = state.game;
+                game.graphics = g_graphics;
+                // The simulation loads no textures; fetch the new stage's here
+                if (game.current_level_number != drawn_level) {
+                    load_level_graphics(game);
+                }
+                if (game.current_level_number != drawn_level || game.current_stage_number != drawn_stage) {
+                    prefetch_stage_neighbours(game);
+                }
+                game.actors.bind_enemy_sprites(g_graphics);
+                for (uint64_t tick = drawn_tick; tick < state.tick; ++tick) {
+                    ui_system.update();
+                }
+                profiler_add_ticks(static_cast<uint32_t>(state.tick - drawn_tick));
+                drawn_tick = state.tick;
+                if (state.finished) {
+                    sim_thread.stop();
+                    g_cheats->set_game(&game);
+                    if (state.outcome == TickOutcome::GameOver) {
+                        game_state = GameState::GameOver;
+                    } else if (state.outcome == TickOutcome::Victory) {
+                        game_state = GameState::Victory;
+                    } else {
+                        quit = true;  // Replay finished or diverged
+                    }
+                }
+            }
+            if (game_state == GameState::Playing) {
+                const double since_tick_ms = static_cast<double>(SDL_GetPerformanceCounter() -
+                    sim_thread.get_state().published_counter) * ms_per_performance_count;
+                interpolator.set_blend(since_tick_ms / MS_PER_TICK);
+            } else {
+                interpolator.reset();
+            }
+            PROFILE_END();
+        } else if (game_state == GameState::Playing) {
+            PROFILE_BEGIN(ProfilePhase::TICKS);
             int ticks_processed = 0;
             while (tick_accumulator >= MS_PER_TICK && ticks_processed < MAX_TICKS_PER_FRAME) {
                 tick_accumulator -= MS_PER_TICK;
                 ticks_processed++;
+                // When this tick was due, so its sounds keep the tick spacing
+                set_audio_tick_time(current_time - static_cast<uint32_t>(tick_accumulator));
 
-                // Per-tick movement result must be cleared before any early-continue
-                // branches (death, door anim, teleport) to avoid stale run state.
-                player_moved_last_tick = false;
-
-                // Phase 5: advance run cycle unconditionally every tick before any
-                // early-return branches, matching assembly .tick behavior.
-                // Derive modulus from the actual run animation frame count so the
-                // counter stays consistent if the animation data ever changes.
-                {
-                    const int run_frame_count = static_cast<int>(comic_run_right.frames.size());
-                    if (run_frame_count > 0) {
-                        comic_run_cycle_frame = (comic_run_cycle_frame + 1) % run_frame_count;
+                if (rewind_held) {
+                    // Step back instead of playing, down to the oldest tick held
+                    for (int step = 0; step < REWIND_TICKS_PER_TICK && rewind_ring.size() > 1; ++step) {
+                        rewind_ring.truncate_after(rewind_ring.newest_tick() - 1);
                     }
-                }
-
-                if (is_player_dying()) {
-                    update_player_death_sequence();
-                    ui_system.update();
-
-                    if (game_over_triggered) {
-                        game_state = GameState::GameOver;
-                        break;
+                    snapshot_tick = rewind_ring.newest_tick();
+                    if (rewind_ring.get(snapshot_tick, tick_snapshot)) {
+                        restore_snapshot(game, tick_snapshot);
                     }
+                    interpolator.reset();
                     continue;
                 }
 
-                if (g_door_anim_phase != DoorAnimationPhase::NONE) {
-                    update_door_animation_tick();
-                    ui_system.update();
-                    continue;
-                }
-
-                // Process jump input once per tick (edge-triggered)
-                // Note: Jump input feeds comic_is_falling_or_jumping, so must be before physics
-                process_jump_input();
-
-                // Handle ongoing teleport animation (continues to next tick if active)
-                if (comic_is_teleporting) {
-                    handle_teleport_tick();
-
-                    const uint8_t* tiles = current_level_ptr
-                        ? current_level_ptr->stages[current_stage_number].tiles
-                        : nullptr;
-                    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x, key_state_fire);
-                    ui_system.update();
-                    continue;
-                }
-
-                // Update jump power from item system (boots affect jump height)
-                comic_jump_power = static_cast<uint8_t>(actor_system.get_jump_power());
-
-                // Update physics (once per tick)
-                const uint8_t was_falling_or_jumping = comic_is_falling_or_jumping;
-                handle_fall_or_jump();
-
-                // Detect landing this tick: was airborne, now grounded
-                // Assembly: on landing, jmp game_loop.check_pause_input skips ALL
-                // left/right movement AND the floor walk-off check for that tick.
-                const bool just_landed = (was_falling_or_jumping != 0) && (comic_is_falling_or_jumping == 0);
-                if (just_landed) {
-                    player_airborne_from_walk_off = false;
-                }
-
-                // If physics transitioned from grounded to airborne using the
-                // no-floor path, suppress jump art for this render frame.
-                if (!was_falling_or_jumping && comic_is_falling_or_jumping &&
-                    comic_jump_counter == 1 && comic_y_vel == 8) {
-                    suppress_jump_animation_this_frame = true;
-                    player_airborne_from_walk_off = true;
-                }
-
-                // Ground movement (only when not in air AND did not just land this tick)
-                // Skipping on landing matches assembly: landing jumps past the left/right block
-                if (!comic_is_falling_or_jumping && !just_landed) {
-                    if (key_state_left) {
-                        player_moved_last_tick |= move_left();
-                    }
-                    if (key_state_right) {
-                        player_moved_last_tick |= move_right();
-                    }
-
-                    // Match original game-loop floor check ordering: after
-                    // horizontal movement, detect missing floor and begin
-                    // falling immediately (no extra standing tick).
-                    if (!comic_is_falling_or_jumping) {
-                        const uint8_t foot_y = static_cast<uint8_t>(comic_y + 4);
-                        uint8_t foot_tile = get_tile_at(static_cast<uint8_t>(comic_x), foot_y);
-                        bool foot_solid = is_tile_solid(foot_tile);
-
-                        if (!foot_solid && (comic_x & 1)) {
-                            foot_tile = get_tile_at(static_cast<uint8_t>(comic_x + 1), foot_y);
-                            foot_solid = is_tile_solid(foot_tile);
-                        }
-
-                        if (!foot_solid) {
-                            comic_y_vel = 8;
-
-                            if (comic_x_momentum > 0) {
-                                comic_x_momentum = 2;
-                            } else if (comic_x_momentum < 0) {
-                                comic_x_momentum = -2;
-                            } else if (key_state_right && !key_state_left) {
-                                comic_x_momentum = 2;
-                            } else if (key_state_left && !key_state_right) {
-                                comic_x_momentum = -2;
-                            }
-
-                            comic_is_falling_or_jumping = 1;
-                            comic_jump_counter = 1;
-                            suppress_jump_animation_this_frame = true;
-                            player_airborne_from_walk_off = true;
-                        }
-                    }
+                if (!begin_session_tick(session, game)) {
+                    quit = true;  // Replay finished
+                    break;
                 }
-
-                const uint8_t* tiles = current_level_ptr
-                    ? current_level_ptr->stages[current_stage_number].tiles
-                    : nullptr;
-                actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x, key_state_fire);
+                interpolator.capture_previous(game);
+                latency.record_tick(session.tick, SDL_GetTicks());
+                const TickOutcome outcome = run_gameplay_tick(game);
                 ui_system.update();
-
-                // ========== PHASE 2: Door and Teleport Checks (After Physics/Actors) ==========
-                // Assembly order: check doors, then teleports, after physics has resolved position
-                // Process door input once per tick (edge-triggered)
-                // Door activation happens AFTER physics resolves, not before
-                process_door_input();
-
-                // Process teleport input once per tick (edge-triggered)
-                // Teleport activation happens AFTER physics resolves, not before
-                if (!comic_is_falling_or_jumping && !comic_is_teleporting) {
-                    process_teleport_input(actor_system.comic_has_teleport_wand != 0);
-                } else {
-                    previous_key_state_teleport = key_state_teleport;
+                end_session_tick(session, game);
+                if (snapshots_enabled) {
+                    capture_snapshot(game, tick_snapshot);
+                    rewind_ring.push(++snapshot_tick, tick_snapshot);
                 }
-
-                if (!beam_out_sequence_played && actor_system.comic_num_treasures >= 3) {
-                    beam_out_sequence_played = true;
-                    win_counter = 20;
-                }
-
-                if (beam_out_sequence_played && win_counter > 0) {
-                    win_counter--;
-                    if (win_counter == 1) {
-                        clear_gameplay_key_states();
-                        tick_accumulator = 0.0;
-                        game_state = GameState::Victory;
-                        break;
-                    }
+                if (session.diverged) {
+                    quit = true;
+                    break;
                 }
-                
-                // Lives count-up sequence: award 5 lives with 1-tick delay between each,
-                // then subtract 1 (the life currently in use)
-                if (!lives_sequence_complete) {
-                    if (lives_sequence_counter > 0) {
-                        lives_sequence_delay--;
-                        if (lives_sequence_delay == 0) {
-                            // Award a life
-                            comic_num_lives++;
-                            lives_sequence_counter--;
-                            
-                            if (lives_sequence_counter > 0) {
-                                // Still more lives to award (wait 1 tick)
-                                lives_sequence_delay = 1;
-                            } else {
-                                // Awarded all 5, wait 3 ticks then subtract 1
-                                lives_sequence_delay = 3;
-                            }
-                        }
-                    } else if (lives_sequence_delay > 0) {
-                        // Waiting 3 ticks after awarding all 5 lives
-                        lives_sequence_delay--;
-                        if (lives_sequence_delay == 0) {
-                            // Subtract 1 life (currently in use: 5→4)
-                            if (comic_num_lives > 0) {
-                                comic_num_lives--;
-                            }
-                            lives_sequence_complete = true;
-                        }
-                    }
+                if (outcome == TickOutcome::GameOver) {
+                    game_state = GameState::GameOver;
+                    break;
                 }
-                
-                // Gradually fill HP from 0 to MAX_HP at game startup
-                // Each tick, increment HP if pending increase is scheduled
-                if (comic_hp_pending_increase > 0) {
-                    comic_hp_pending_increase--;
-                    if (comic_hp < MAX_HP) {
-                        comic_hp++;
-                    }
+                if (outcome == TickOutcome::Victory) {
+                    tick_accumulator = 0.0;
+                    game_state = GameState::Victory;
+                    break;
                 }
-                
-                // Fireball meter charging is handled by ActorSystem::update()
-                // (charges at 1 unit per 2 ticks when not firing)
-                
-                // Game-over is handled by physics when Comic hits the bottom of playfield
-                // (sound triggered there).  No additional check needed here.
             }
+            // The early tick's lead comes off the wait for the next one
+            tick_accumulator -= early_tick_lead_ms;
+            count_event(Counter::TICKS_RUN, static_cast<uint64_t>(ticks_processed));
+            if (ticks_processed == MAX_TICKS_PER_FRAME && tick_accumulator >= MS_PER_TICK) {
+                count_event(Counter::TICK_CAP_FRAMES);  // The rest wait for the next frame
+            }
+            interpolator.set_blend(tick_accumulator / MS_PER_TICK);
+            profiler_add_ticks(static_cast<uint32_t>(ticks_processed));
+            PROFILE_END();
         } else {
             tick_accumulator = 0.0;
+            interpolator.reset();
         }
 
-        if (game_state == GameState::Victory) {
-            play_victory_sequence();
+        if (session.replaying && (game_state == GameState::Victory || game_state == GameState::GameOver)) {
+            quit = true;  // The recording ends here; skip the interactive sequences
+        } else if (game_state == GameState::Victory) {
+            queue_victory_sequence();
             game_state = GameState::Exiting;
-            quit = true;
+            continue;
         } else if (game_state == GameState::GameOver) {
-            play_game_over_sequence();
+            queue_game_over_sequence();
             game_state = GameState::Exiting;
-            quit = true;
+            continue;
         }
 
         if (quit) {
@@ -1211,22 +1792,22 @@ int main(int argc, char* argv[]) {
         if (game_state == GameState::Playing) {
             current_time = SDL_GetTicks();
             Animation* previous_animation = current_animation;
-            if (is_player_dying()) {
-                if (should_show_player_death_animation()) {
+            if (is_player_dying(game)) {
+                if (should_show_player_death_animation(game)) {
                     current_animation = &comic_death;
-                } else if (should_clip_player_death_render()) {
-                    current_animation = comic_facing ? &comic_jump_right : &comic_jump_left;
+                } else if (should_clip_player_death_render(game)) {
+                    current_animation = game.comic_facing ? &comic_jump_right : &comic_jump_left;
                 } else {
                     current_animation = nullptr;
                 }
-            } else if (comic_is_falling_or_jumping && !suppress_jump_animation_this_frame
-                       && !player_airborne_from_walk_off) {
-                current_animation = comic_facing ? &comic_jump_right : &comic_jump_left;
+            } else if (game.comic_is_falling_or_jumping && !game.suppress_jump_animation
+                       && !game.player_airborne_from_walk_off) {
+                current_animation = game.comic_facing ? &comic_jump_right : &comic_jump_left;
             } else {
-                if (player_moved_last_tick) {
-                    current_animation = comic_facing ? &comic_run_right : &comic_run_left;
+                if (game.player_moved_last_tick) {
+                    current_animation = game.comic_facing ? &comic_run_right : &comic_run_left;
                 } else {
-                    current_animation = comic_facing ? &comic_idle_right : &comic_idle_left;
+                    current_animation = game.comic_facing ? &comic_idle_right : &comic_idle_left;
                 }
             }
 
@@ -1242,19 +1823,68 @@ int main(int argc, char* argv[]) {
                 if (is_run_anim) {
                     // Phase 5: run animation advances exactly once per game tick via
                     // comic_run_cycle_frame, not by wall-clock comparison.
-                    current_animation->current_frame = comic_run_cycle_frame;
+                    current_animation->current_frame = game.comic_run_cycle_frame;
                 } else {
-                    g_graphics->update_animation(*current_animation, current_time);
+                    animation_deadline = g_graphics->update_animation(*current_animation, current_time);
                 }
             }
         }
 
-        // Clear screen with black background
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
+        const bool show_debug_overlay = sim_thread.is_running() ? sim_thread.get_state().show_debug_overlay
+                                                                : g_cheats->should_show_debug_overlay();
+
+        // --render-on-change: draw only a frame that would differ from the
+        // last one drawn; otherwise sleep until a tick or animation frame is
+        // due, or an event comes in
+        if (scene_tracker.is_enabled()) {
+            if (show_debug_overlay) {
+                scene_tracker.invalidate();  // Its frame-time graph moves every frame
+            }
+            SceneView view;
+            view.game = scene_signature(game);
+            view.animation = current_animation;
+            view.animation_frame = current_animation ? current_animation->current_frame : 0;
+            view.hud_frame = UISystem::make_hud_state(
+                game.score_bytes, game.comic_num_lives, game.comic_hp, actor_system.fireball_meter,
+                actor_system.comic_firepower, actor_system.comic_has_corkscrew != 0, game.comic_has_door_key != 0,
+                actor_system.comic_has_teleport_wand != 0, actor_system.comic_has_lantern != 0,
+                actor_system.comic_has_gems != 0, actor_system.comic_has_crown != 0,
+                actor_system.comic_has_gold != 0, game.comic_jump_power,
+                ui_system.get_animation_counter()).inventory_frame;
+            view.paused = game_state == GameState::Paused;
+            if (!scene_tracker.needs_frame(view)) {
+                PROFILE_BEGIN(ProfilePhase::UPLOADS);
+                pump_asset_uploads();
+                PROFILE_END();
+                double ms_to_tick = MS_PER_TICK - tick_accumulator;
+                if (sim_thread.is_running()) {
+                    // The simulation thread's next tick; if it is late, look again shortly
+                    ms_to_tick = std::max(1.0, MS_PER_TICK - static_cast<double>(SDL_GetPerformanceCounter() -
+                        sim_thread.get_state().published_counter) * ms_per_performance_count);
+                }
+                const uint32_t animation_due = game_state == GameState::Playing ? animation_deadline : 0;
+                pacer.wait_for_wakeup(SceneChangeTracker::idle_ms(ms_to_tick, animation_due, SDL_GetTicks(),
+                                                                  MAX_IDLE_MS));
+                continue;
+            }
+        }
+
+        // Turbo replays only draw every render_every-th frame
+        if (turbo && frame_index % static_cast<uint64_t>(render_every) != 0) {
+            PROFILE_BEGIN(ProfilePhase::UPLOADS);
+            g_graphics->pump_asset_uploads();
+            actor_system.bind_enemy_sprites(g_graphics);
+            PROFILE_END();
+            continue;
+        }
+
+        // Clear screen with black background (binds the 320x200 target in
+        // --native-res mode)
+        begin_captured_frame();
+        g_graphics->begin_frame();
 
         // Keep gameplay aligned with the same letterboxed 320x200 frame used by HUD.
-        SDL_Rect gameplay_frame_rect = g_graphics->compute_letterbox_rect(renderer);
+        SDL_Rect gameplay_frame_rect = g_graphics->get_gameplay_frame_rect();
 
         // Render HUD background (sys003.ega) - should be behind all game elements
         SDL_Texture* hud_texture = get_hud_texture();
@@ -1280,51 +1910,58 @@ int main(int argc, char* argv[]) {
         playfield_viewport.w = render_scale * PLAYFIELD_WIDTH;
         playfield_viewport.h = render_scale * PLAYFIELD_HEIGHT;
         SDL_RenderSetViewport(renderer, &playfield_viewport);
+        // Sub-tick camera position (zero unless --interpolate)
+        g_graphics->set_world_offset(interpolator.get_world_shift(game, render_scale));
+        interpolator.get_actor_offsets(game, render_scale, &actor_offsets);
 
-        bool level_changed = current_level_number != cached_level_number;
-        bool stage_changed = current_stage_number != cached_stage_number;
+        bool level_changed = game.current_level_number != cached_level_number;
+        bool stage_changed = game.current_stage_number != cached_stage_number;
 
         // Update tileset cache if level changed
         if (level_changed) {
-            cached_level_number = current_level_number;
-            if (current_level_number < 8) {
-                cached_tileset = g_graphics->get_tileset(level_names[current_level_number]);
+            cached_level_number = game.current_level_number;
+            if (game.current_level_number < 8) {
+                cached_tileset = g_graphics->get_tileset(level_names[game.current_level_number]);
             }
         }
 
         if (level_changed || stage_changed) {
-            cached_stage_number = current_stage_number;
-            if (current_level_ptr) {
-                actor_system.setup_enemies_for_stage(current_level_ptr, current_level_number, current_stage_number, g_graphics);
-            }
+            cached_stage_number = game.current_stage_number;
+            sync_stage_enemies(game);
         }
 
         Tileset* tileset = cached_tileset;
 
-        // Render tiles with offscreen margin for seamless scrolling.
-        // The C code pre-renders into a 256-byte-wide buffer; we render tiles
-        // slightly outside the visible playfield and let viewport clipping
-        // hide any offscreen portions.
-        const int OFFSCREEN_MARGIN_UNITS = 2;
-        const int min_visible_x = camera_x - OFFSCREEN_MARGIN_UNITS;
-        const int max_visible_x = camera_x + PLAYFIELD_WIDTH + OFFSCREEN_MARGIN_UNITS;
-        
-        for (int ty = 0; ty < MAP_HEIGHT_TILES; ty++) {
-            for (int tx = 0; tx < MAP_WIDTH_TILES; tx++) {
-                int world_x = tx * 2; // Tile x in game units
-                
-                // Render tiles within visible range (with left margin for scrolling).
-                // Each tile is 2 units wide, so render if tile overlaps the range.
-                if (world_x + 2 > min_visible_x && world_x < max_visible_x) {
-                    uint8_t tile = get_tile_at(tx * 2, ty * 2);
-                    
-                    int screen_x = (world_x - camera_x) * render_scale;
-                    int screen_y = ty * 2 * render_scale;
-                    
-                    g_graphics->render_tile(screen_x, screen_y, tileset, tile, render_scale);
+        PROFILE_BEGIN(ProfilePhase::TILES);
+
+        // The C code pre-renders the stage into a 256-unit-wide offscreen buffer;
+        // the graphics system keeps the equivalent cached render target and draws
+        // the visible window with a single copy. If render targets are unavailable,
+        // draw the visible tiles individually (with a small offscreen margin and
+        // viewport clipping for seamless scrolling).
+        if (!g_graphics->render_stage_background(game, tileset, game.camera_x, render_scale)) {
+            const int OFFSCREEN_MARGIN_UNITS = 2;
+            const int min_visible_x = game.camera_x - OFFSCREEN_MARGIN_UNITS;
+            const int max_visible_x = game.camera_x + PLAYFIELD_WIDTH + OFFSCREEN_MARGIN_UNITS;
+
+            for (int ty = 0; ty < MAP_HEIGHT_TILES; ty++) {
+                for (int tx = 0; tx < MAP_WIDTH_TILES; tx++) {
+                    int world_x = tx * 2; // Tile x in game units
+
+                    // Render tiles within visible range (with left margin for scrolling).
+                    // Each tile is 2 units wide, so render if tile overlaps the range.
+                    if (world_x + 2 > min_visible_x && world_x < max_visible_x) {
+                        uint8_t tile = get_tile_at(game, tx * 2, ty * 2);
+
+                        int screen_x = (world_x - game.camera_x) * render_scale;
+                        int screen_y = ty * 2 * render_scale;
+
+                        g_graphics->render_tile(screen_x, screen_y, tileset, tile, render_scale);
+                    }
                 }
             }
         }
+        PROFILE_END();
 
         uint8_t door_world_x = 0;
         uint8_t door_world_y = 0;
@@ -1332,6 +1969,7 @@ int main(int argc, char* argv[]) {
         bool door_overlay_in_front = false;
         bool door_player_visible = true;
         const bool door_anim_active = get_door_animation_render_state(
+            game,
             &door_world_x,
             &door_world_y,
             &door_render_mode,
@@ -1350,12 +1988,12 @@ int main(int argc, char* argv[]) {
 
             const int tile_w = render_scale * 2;
             const int tile_h = render_scale * 2;
-            const int screen_x = (static_cast<int>(door_world_x) - camera_x) * render_scale;
+            const int screen_x = (static_cast<int>(door_world_x) - game.camera_x) * render_scale;
             const int screen_y = static_cast<int>(door_world_y) * render_scale;
 
             const bool can_draw_tiles =
                 tileset != nullptr &&
-                current_level_ptr != nullptr &&
+                game.current_level_ptr != nullptr &&
                 tile_w >= 2;
 
             Uint8 prev_r = 0;
@@ -1365,14 +2003,14 @@ int main(int argc, char* argv[]) {
             SDL_GetRenderDrawColor(renderer, &prev_r, &prev_g, &prev_b, &prev_a);
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 
-            SDL_Rect door_rect = {screen_x, screen_y, tile_w * 2, tile_h * 2};
+            SDL_Rect door_rect = {screen_x + g_graphics->get_world_offset(), screen_y, tile_w * 2, tile_h * 2};
             SDL_RenderFillRect(renderer, &door_rect);
 
             if (can_draw_tiles) {
-                const uint8_t tile_ul = current_level_ptr->door_tile_ul;
-                const uint8_t tile_ur = current_level_ptr->door_tile_ur;
-                const uint8_t tile_ll = current_level_ptr->door_tile_ll;
-                const uint8_t tile_lr = current_level_ptr->door_tile_lr;
+                const uint8_t tile_ul = game.current_level_ptr->door_tile_ul;
+                const uint8_t tile_ur = game.current_level_ptr->door_tile_ur;
+                const uint8_t tile_ll = game.current_level_ptr->door_tile_ll;
+                const uint8_t tile_lr = game.current_level_ptr->door_tile_lr;
 
                 auto redraw_world_tile = [&](int world_tile_x, int world_tile_y) {
                     if (world_tile_x < 0 || world_tile_y < 0) {
@@ -1383,12 +2021,23 @@ int main(int argc, char* argv[]) {
                         return;
                     }
 
-                    const int tile_screen_x = (world_tile_x - camera_x) * render_scale;
+                    const int tile_screen_x = (world_tile_x - game.camera_x) * render_scale;
                     const int tile_screen_y = world_tile_y * render_scale;
-                    const uint8_t tile_id = get_tile_at(world_tile_x, world_tile_y);
+                    const uint8_t tile_id = get_tile_at(game, world_tile_x, world_tile_y);
                     g_graphics->render_tile(tile_screen_x, tile_screen_y, tileset, tile_id, render_scale);
                 };
 
+                // Restore a 1-tile-wide, 2-tile-tall wall column beside the doorway,
+                // straight from the cached stage background when it is available.
+                auto redraw_world_column = [&](int world_tile_x, int world_tile_y) {
+                    if (g_graphics->render_stage_background_region(
+                            game, world_tile_x, world_tile_y, 2, 4, game.camera_x, render_scale)) {
+                        return;
+                    }
+                    redraw_world_tile(world_tile_x, world_tile_y);
+                    redraw_world_tile(world_tile_x, world_tile_y + 2);
+                };
+
                 int shift = 0;
                 if (door_render_mode == DoorAnimationRenderMode::HALF_OPEN ||
                     door_render_mode == DoorAnimationRenderMode::HALF_CLOSED) {
@@ -1408,31 +2057,37 @@ int main(int argc, char* argv[]) {
 
                 // Redraw the wall columns beside the doorway so the leaves slide
                 // behind the surrounding tiles instead of overlapping them.
-                redraw_world_tile(static_cast<int>(door_world_x) - 2, static_cast<int>(door_world_y));
-                redraw_world_tile(static_cast<int>(door_world_x) - 2, static_cast<int>(door_world_y) + 2);
-                redraw_world_tile(static_cast<int>(door_world_x) + 4, static_cast<int>(door_world_y));
-                redraw_world_tile(static_cast<int>(door_world_x) + 4, static_cast<int>(door_world_y) + 2);
+                redraw_world_column(static_cast<int>(door_world_x) - 2, static_cast<int>(door_world_y));
+                redraw_world_column(static_cast<int>(door_world_x) + 4, static_cast<int>(door_world_y));
             }
 
             SDL_SetRenderDrawColor(renderer, prev_r, prev_g, prev_b, prev_a);
         };
 
+        PROFILE_BEGIN(ProfilePhase::DOORS_TELEPORT);
         render_door_animation_overlay(false);
+        PROFILE_END();
 
-        actor_system.render_enemies(g_graphics, camera_x, render_scale);
-        actor_system.render_fireballs(g_graphics, camera_x, render_scale);
+        // Queue actor and player sprites so they are submitted grouped by texture.
+        PROFILE_BEGIN(ProfilePhase::ACTOR_RENDER);
+        g_graphics->begin_sprite_batch();
+        actor_system.render_enemies(g_graphics, game.camera_x, render_scale, &actor_offsets);
+        actor_system.render_fireballs(g_graphics, game.camera_x, render_scale, &actor_offsets);
 
         // Render player sprite
+        g_graphics->set_render_layer(RenderLayer::PLAYER);
         if (current_animation && door_player_visible) {
             AnimationFrame* frame = g_graphics->get_current_frame(*current_animation);
             if (frame) {
                 // Center player on screen relative to camera
                 // Player is 2 units wide, 4 units tall in game coords
-                int screen_x = (comic_x - camera_x) * render_scale + render_scale;  // Center X
-                int screen_y = comic_y * render_scale + render_scale * 2; // Center Y
+                int screen_x = (game.comic_x - game.camera_x) * render_scale + render_scale  // Center X
+                               + interpolator.get_comic_offset_x(game, render_scale);
+                int screen_y = game.comic_y * render_scale + render_scale * 2  // Center Y
+                               + interpolator.get_comic_offset_y(game, render_scale);
                 int player_width = render_scale * 2;
                 const int player_full_height = render_scale * 4;
-                if (should_clip_player_death_render()) {
+                if (should_clip_player_death_render(game)) {
                     // Compute how much of the sprite still fits within the playfield
                     // viewport so the sinking effect matches natural SDL clipping.
                     // sprite_top_y == comic_y * render_scale (center Y - half height).
@@ -1459,36 +2114,45 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // The front door overlay is drawn immediately, so submit everything
+        // that must appear beneath it first.
+        g_graphics->flush_sprite_batch();
+        PROFILE_END();
+        PROFILE_BEGIN(ProfilePhase::DOORS_TELEPORT);
         render_door_animation_overlay(true);
 
-        if (comic_is_teleporting) {
+        g_graphics->begin_sprite_batch();
+        g_graphics->set_render_layer(RenderLayer::TELEPORT);
+        if (game.comic_is_teleporting) {
             const uint8_t last_teleport_frame =
                 static_cast<uint8_t>(teleport_sprites.size() - 1);
-            const uint8_t source_frame = std::min(teleport_animation, last_teleport_frame);
-            if (teleport_sprites[source_frame]) {
-                int source_screen_x = (static_cast<int>(teleport_source_x) - camera_x) * render_scale + render_scale;
-                int source_screen_y = static_cast<int>(teleport_source_y) * render_scale + render_scale * 2;
+            const uint8_t source_frame = std::min(game.teleport_animation, last_teleport_frame);
+            const Sprite* source_sprite = g_graphics->get_sprite(teleport_sprites[source_frame]);
+            if (source_sprite) {
+                int source_screen_x = (static_cast<int>(game.teleport_source_x) - game.camera_x) * render_scale + render_scale;
+                int source_screen_y = static_cast<int>(game.teleport_source_y) * render_scale + render_scale * 2;
                 g_graphics->render_sprite_centered_scaled(
                     source_screen_x,
                     source_screen_y,
-                    *teleport_sprites[source_frame],
+                    *source_sprite,
                     render_scale * 2,
                     render_scale * 4
                 );
             }
 
-            if (teleport_animation >= 1) {
-                const uint8_t destination_phase = static_cast<uint8_t>(teleport_animation - 1);
+            if (game.teleport_animation >= 1) {
+                const uint8_t destination_phase = static_cast<uint8_t>(game.teleport_animation - 1);
                 const uint8_t dest_frame = std::min(destination_phase, last_teleport_frame);
-                if (teleport_sprites[dest_frame]) {
+                const Sprite* dest_sprite = g_graphics->get_sprite(teleport_sprites[dest_frame]);
+                if (dest_sprite) {
                     int destination_screen_x =
-                        (static_cast<int>(teleport_destination_x) - camera_x) * render_scale + render_scale;
+                        (static_cast<int>(game.teleport_destination_x) - game.camera_x) * render_scale + render_scale;
                     int destination_screen_y =
-                        static_cast<int>(teleport_destination_y) * render_scale + render_scale * 2;
+                        static_cast<int>(game.teleport_destination_y) * render_scale + render_scale * 2;
                     g_graphics->render_sprite_centered_scaled(
                         destination_screen_x,
                         destination_screen_y,
-                        *teleport_sprites[dest_frame],
+                        *dest_sprite,
                         render_scale * 2,
                         render_scale * 4
                     );
@@ -1496,40 +2160,42 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        PROFILE_END();
+
         // Assembly-faithful order: items are rendered after Comic, so with painter's
         // algorithm they appear on top when overlapping.
-        actor_system.render_item(g_graphics, camera_x, render_scale);
+        PROFILE_BEGIN(ProfilePhase::ACTOR_RENDER);
+        actor_system.render_item(g_graphics, game.camera_x, render_scale);
+        g_graphics->flush_sprite_batch();
+        PROFILE_END();
 
-        // Restore full renderer viewport before rendering debug overlay.
+        // Restore full renderer viewport before rendering the HUD.
+        g_graphics->set_world_offset(0);
         SDL_RenderSetViewport(renderer, nullptr);
-        
-        // Render debug overlay if enabled via F3 (in full window space)
-        if (g_cheats->should_show_debug_overlay()) {
-            g_graphics->render_debug_overlay();
-        }
 
         // Render HUD (score, lives, HP, fireball meter, inventory)
         // Draw in the same 320x200 letterboxed coordinate space as SYS003.
         SDL_RenderSetViewport(renderer, &gameplay_frame_rect);
         SDL_RenderSetScale(renderer, letterbox_scale, letterbox_scale);
         ui_system.render_hud(
-            score_bytes,
-            comic_num_lives,
-            comic_hp,
+            game.score_bytes,
+            game.comic_num_lives,
+            game.comic_hp,
             actor_system.fireball_meter,
             actor_system.comic_firepower,
             actor_system.comic_has_corkscrew != 0,
-            comic_has_door_key != 0,
+            game.comic_has_door_key != 0,
             actor_system.comic_has_teleport_wand != 0,
             actor_system.comic_has_lantern != 0,
             actor_system.comic_has_gems != 0,
             actor_system.comic_has_crown != 0,
             actor_system.comic_has_gold != 0,
-            comic_jump_power
+            game.comic_jump_power
         );
         SDL_RenderSetScale(renderer, 1.0f, 1.0f);
         SDL_RenderSetViewport(renderer, nullptr);
 
+        const Sprite* pause_sprite = g_graphics->get_sprite(pause_sprite_id);
         if (game_state == GameState::Paused && pause_sprite) {
             const int pause_x_ega = 40;
             const int pause_y_ega = 64;
@@ -1545,16 +2211,83 @@ int main(int argc, char* argv[]) {
             SDL_RenderCopy(renderer, pause_sprite->texture.texture, nullptr, &pause_rect);
         }
 
+        // Upscale the native frame into the window, if enabled.
+        g_graphics->end_frame();
+
+        // Render debug overlay if enabled via F3 (in full window space)
+        if (show_debug_overlay) {
+            g_graphics->render_debug_overlay(game);
+        }
+
+        // Show the captured frame in the window, reading an earlier one back
+        capture.end_frame();
+
         // Present
+        PROFILE_BEGIN(ProfilePhase::PRESENT);
         SDL_RenderPresent(renderer);
+        PROFILE_END();
+        pacer.mark_present();
+        latency.record_present(SDL_GetTicks());
+        note_present();
+
+        PROFILE_BEGIN(ProfilePhase::UPLOADS);
+        pump_asset_uploads();
+        PROFILE_END();
+
+        // Pace rendering (vsync, fixed or power-saver) while physics runs at ~9.1 Hz
+        if (turbo || offline_capture) {
+            continue;
+        }
+        pacer.wait_for_next_frame();
+    }
+    sim_thread.stop();
+    g_cheats->set_game(&game);
+
+    const PrefetchStats prefetch = get_prefetch_stats();
+    if (prefetch.hits + prefetch.misses > 0) {
+        std::cout << "Stage prefetch: " << prefetch.hits << " hit(s), "
+                  << prefetch.misses << " miss(es), "
+                  << prefetch.escalations << " door escalation(s)" << std::endl;
+    }
 
-        // Cap rendering to ~60 FPS while physics runs at ~9.1 Hz
-        if (tick_accumulator >= MS_PER_TICK) {
-            SDL_Delay(0);
-        } else {
-            SDL_Delay(16);
+    const AudioLatencyStats audio = get_audio_latency_stats();
+    if (audio.low_latency) {
+        std::cout << "Audio: " << audio.callback_frames << "-frame device buffer ("
+                  << audio.output_latency_ms << " ms), tick-to-output latency avg "
+                  << audio.average_trigger_latency_ms << " ms / max "
+                  << audio.max_trigger_latency_ms << " ms, "
+                  << audio.voices_started << " voice(s) started, "
+                  << audio.voices_stolen << " stolen, "
+                  << audio.late_starts << " late, "
+                  << audio.underruns << " underrun(s)" << std::endl;
+    }
+
+    if (session.replaying) {
+        const double elapsed_s = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - session_start).count();
+        std::cout << "Replay: " << session.tick << " of " << session.recording.tick_count() << " tick(s)";
+        if (elapsed_s > 0.0) {
+            std::cout << ", " << static_cast<uint64_t>(session.tick / elapsed_s) << " ticks/s";
         }
+        std::cout << std::endl;
+        print_time_percentiles("Frame time:", frame_times_ms);
+    }
+    if (print_stats) {
+        const FramePacingStats pacing = pacer.get_stats();
+        std::cout << "Pacing: " << get_pacing_mode_name(pacer.get_mode()) << ", " << pacing.presents
+                  << " present(s), interval avg " << pacing.average_interval_ms << " ms, jitter "
+                  << pacing.jitter_ms << " ms, max " << pacing.max_interval_ms << " ms, busy "
+                  << static_cast<int>(pacing.busy_percent + 0.5) << "%" << std::endl;
+    }
+    if (latency_report) {
+        print_input_latency_report(latency);
+        if (latency_log_path && latency.write_csv(latency_log_path)) {
+            std::cout << "Input latency log written to " << latency_log_path << std::endl;
+        }
+    }
+    if (!finish_session(session)) {
+        return cleanup_and_exit(1);
     }
 
-    return cleanup_and_exit(0);
+    return cleanup_and_exit(startup_failed ? 1 : 0);
 }
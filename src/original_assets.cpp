@@ -0,0 +1,273 @@
+#include "../include/original_assets.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EGA_DECODER_SSE2 1
+#endif
+
+const SDL_Color EGA_PALETTE[16] = {
+    {0x00, 0x00, 0x00, 0xff}, {0x00, 0x00, 0xaa, 0xff}, {0x00, 0xaa, 0x00, 0xff},
+    {0x00, 0xaa, 0xaa, 0xff}, {0xaa, 0x00, 0x00, 0xff}, {0xaa, 0x00, 0xaa, 0xff},
+    {0xaa, 0x55, 0x00, 0xff}, {0xaa, 0xaa, 0xaa, 0xff}, {0x55, 0x55, 0x55, 0xff},
+    {0x55, 0x55, 0xff, 0xff}, {0x55, 0xff, 0x55, 0xff}, {0x55, 0xff, 0xff, 0xff},
+    {0xff, 0x55, 0x55, 0xff}, {0xff, 0x55, 0xff, 0xff}, {0xff, 0xff, 0x55, 0xff},
+    {0xff, 0xff, 0xff, 0xff},
+};
+
+// ============================================================================
+// PLANAR DECODE
+// ============================================================================
+
+// spread[b] has byte i (in little-endian order) set to bit (7 - i) of b, so
+// one plane byte becomes eight 0/1 pixel lanes of a uint64_t.
+static const uint64_t* planar_spread_table() {
+    static const struct Table {
+        uint64_t spread[256];
+        Table() {
+            for (int b = 0; b < 256; ++b) {
+                uint64_t lanes = 0;
+                for (int i = 0; i < 8; ++i) {
+                    lanes |= static_cast<uint64_t>((b >> (7 - i)) & 1) << (8 * i);
+                }
+                spread[b] = lanes;
+            }
+        }
+    } table;
+    return table.spread;
+}
+
+static void planar_to_indices_swar(const uint8_t* planes, size_t plane_bytes,
+                                   size_t first, size_t last, uint8_t* indices) {
+    const uint64_t* spread = planar_spread_table();
+    for (size_t q = first; q < last; ++q) {
+        const uint64_t lanes = spread[planes[q]] |
+                               (spread[planes[plane_bytes + q]] << 1) |
+                               (spread[planes[2 * plane_bytes + q]] << 2) |
+                               (spread[planes[3 * plane_bytes + q]] << 3);
+        uint8_t* out = indices + q * 8;
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint8_t>(lanes >> (8 * i));
+        }
+    }
+}
+
+void ega_planar_to_indices(const uint8_t* planes, size_t pixel_count, uint8_t* indices) {
+    const size_t plane_bytes = pixel_count / 8;
+    size_t q = 0;
+
+#ifdef EGA_DECODER_SSE2
+    // 16 pixels per step: broadcast each plane byte across 8 lanes, test one
+    // bit per lane, and merge the four planes into bits 0-3.
+    const __m128i bit_select = _mm_setr_epi8(
+        static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+        static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    for (; q + 2 <= plane_bytes; q += 2) {
+        __m128i result = _mm_setzero_si128();
+        for (int p = 0; p < 4; ++p) {
+            const uint8_t* plane = planes + p * plane_bytes + q;
+            __m128i v = _mm_cvtsi32_si128(plane[0] | (plane[1] << 8));
+            v = _mm_unpacklo_epi8(v, v);
+            v = _mm_unpacklo_epi16(v, v);
+            v = _mm_unpacklo_epi32(v, v);
+            const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(v, bit_select), bit_select);
+            result = _mm_or_si128(result, _mm_and_si128(set, _mm_set1_epi8(static_cast<char>(1 << p))));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + q * 8), result);
+    }
+#endif
+
+    planar_to_indices_swar(planes, plane_bytes, q, plane_bytes, indices);
+}
+
+bool ega_rle_decode(const uint8_t* data, size_t size, uint8_t* planes, size_t plane_size) {
+    if (size < 2 || static_cast<size_t>(data[0] | (data[1] << 8)) != plane_size) {
+        return false;
+    }
+
+    size_t pos = 2;
+    for (int p = 0; p < 4; ++p) {
+        uint8_t* out = planes + p * plane_size;
+        size_t filled = 0;
+        while (filled < plane_size) {
+            if (pos >= size) {
+                return false;
+            }
+            const uint8_t control = data[pos++];
+            if (control < 128) {
+                if (size - pos < control) {
+                    return false;
+                }
+                const size_t count = std::min<size_t>(control, plane_size - filled);
+                std::copy(data + pos, data + pos + count, out + filled);
+                pos += control;
+                filled += count;
+            } else {
+                if (pos >= size) {
+                    return false;
+                }
+                const uint8_t value = data[pos++];
+                const size_t count = std::min<size_t>(control - 128, plane_size - filled);
+                std::fill(out + filled, out + filled + count, value);
+                filled += count;
+            }
+        }
+    }
+    return true;
+}
+
+// Opaque (mask == nullptr) or masked RGBA32 surface from 16x16 planar data.
+// Mask bits are packed like a plane; a set bit is transparent.
+static SDL_Surface* planar_tile_to_surface(const uint8_t* planes, const uint8_t* mask) {
+    constexpr size_t pixel_count = EGA_TILE_SIZE * EGA_TILE_SIZE;
+    uint8_t indices[pixel_count];
+    ega_planar_to_indices(planes, pixel_count, indices);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
+        0, EGA_TILE_SIZE, EGA_TILE_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr) {
+        return nullptr;
+    }
+
+    for (int y = 0; y < EGA_TILE_SIZE; ++y) {
+        uint8_t* row = static_cast<uint8_t*>(surface->pixels) + y * surface->pitch;
+        for (int x = 0; x < EGA_TILE_SIZE; ++x) {
+            const size_t i = static_cast<size_t>(y) * EGA_TILE_SIZE + x;
+            const SDL_Color& color = EGA_PALETTE[indices[i] & 0x0F];
+            const bool transparent = mask != nullptr && ((mask[i / 8] >> (7 - i % 8)) & 1);
+            row[x * 4 + 0] = color.r;
+            row[x * 4 + 1] = color.g;
+            row[x * 4 + 2] = color.b;
+            row[x * 4 + 3] = transparent ? 0 : 255;
+        }
+    }
+    return surface;
+}
+
+// ============================================================================
+// ORIGINAL FILES
+// ============================================================================
+
+static std::string to_lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool OriginalAssetReader::open(const std::string& directory) {
+    namespace fs = std::filesystem;
+    paths.clear();
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        cache.clear();
+    }
+
+    std::error_code ec;
+    fs::directory_iterator it(directory, ec);
+    if (ec) {
+        return false;
+    }
+    bool has_graphics = false;
+    for (const fs::directory_entry& entry : it) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+        const std::string name = to_lower(entry.path().filename().string());
+        const std::string ext = to_lower(entry.path().extension().string());
+        if (ext == ".tt2" || ext == ".shp" || ext == ".ega") {
+            has_graphics = true;
+        }
+        paths[name] = entry.path().string();
+    }
+    if (!has_graphics) {
+        paths.clear();
+    }
+    return has_graphics;
+}
+
+bool OriginalAssetReader::has_file(const std::string& name) const {
+    return paths.find(to_lower(name)) != paths.end();
+}
+
+const std::vector<uint8_t>* OriginalAssetReader::get_file(const std::string& name) const {
+    const std::string key = to_lower(name);
+    auto path = paths.find(key);
+    if (path == paths.end()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto cached = cache.find(key);
+    if (cached != cache.end()) {
+        return cached->second.get();
+    }
+
+    std::unique_ptr<std::vector<uint8_t>> data(new std::vector<uint8_t>());
+    std::ifstream file(path->second, std::ios::binary);
+    if (file) {
+        data->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    } else {
+        std::cerr << "Warning: Failed to read " << path->second << std::endl;
+    }
+    const std::vector<uint8_t>* result = data.get();
+    cache[key] = std::move(data);
+    return result;
+}
+
+SDL_Surface* OriginalAssetReader::load_tile(const std::string& level_name, int tile_index) const {
+    const std::vector<uint8_t>* file = get_file(level_name + ".tt2");
+    if (file == nullptr || tile_index < 0) {
+        return nullptr;
+    }
+    const size_t offset = EGA_TT2_HEADER_BYTES + static_cast<size_t>(tile_index) * EGA_TILE_PLANE_BYTES;
+    if (file->size() < offset + EGA_TILE_PLANE_BYTES) {
+        return nullptr;  // Past the last tile
+    }
+    return planar_tile_to_surface(file->data() + offset, nullptr);
+}
+
+SDL_Surface* OriginalAssetReader::load_shp_frame(const std::string& shp_name, int frame_index) const {
+    const std::vector<uint8_t>* file = get_file(shp_name);
+    if (file == nullptr || frame_index < 0) {
+        return nullptr;
+    }
+    const size_t offset = static_cast<size_t>(frame_index) * EGA_SHP_FRAME_BYTES;
+    if (file->size() < offset + EGA_SHP_FRAME_BYTES) {
+        return nullptr;
+    }
+    const uint8_t* frame = file->data() + offset;
+    return planar_tile_to_surface(frame, frame + EGA_TILE_PLANE_BYTES);
+}
+
+SDL_Surface* OriginalAssetReader::load_fullscreen(const std::string& ega_name) const {
+    const std::vector<uint8_t>* file = get_file(ega_name);
+    if (file == nullptr) {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> planes(4 * EGA_SCREEN_PLANE_BYTES);
+    if (!ega_rle_decode(file->data(), file->size(), planes.data(), EGA_SCREEN_PLANE_BYTES)) {
+        std::cerr << "Warning: Malformed EGA image: " << ega_name << std::endl;
+        return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
+        0, EGA_SCREEN_WIDTH, EGA_SCREEN_HEIGHT, 8, SDL_PIXELFORMAT_INDEX8);
+    if (surface == nullptr) {
+        return nullptr;
+    }
+    SDL_SetPaletteColors(surface->format->palette, EGA_PALETTE, 0, 16);
+
+    std::vector<uint8_t> indices(static_cast<size_t>(EGA_SCREEN_WIDTH) * EGA_SCREEN_HEIGHT);
+    ega_planar_to_indices(planes.data(), indices.size(), indices.data());
+    for (int y = 0; y < EGA_SCREEN_HEIGHT; ++y) {
+        std::copy(indices.begin() + static_cast<std::ptrdiff_t>(y) * EGA_SCREEN_WIDTH,
+                  indices.begin() + static_cast<std::ptrdiff_t>(y + 1) * EGA_SCREEN_WIDTH,
+                  static_cast<uint8_t*>(surface->pixels) + y * surface->pitch);
+    }
+    return surface;
+}
@@ -0,0 +1,227 @@
+/**
+ * profiler.cpp - Per-phase frame timing and the --perf-log writer
+ *
+ * Markers charge the performance-counter time since the previous marker to
+ * the phase on top of a small stack. At each frame start the finished frame
+ * is copied into a single-producer ring; the overlay reads the ring on the
+ * same thread, the CSV writer drains it from its own.
+ */
+
+#include "../include/profiler.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+std::atomic<bool> g_frame_profiler_enabled(false);
+
+namespace {
+
+constexpr int MAX_PHASE_DEPTH = 8;
+constexpr auto PERF_LOG_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+const char* const PHASE_NAMES[PROFILE_PHASE_COUNT] = {
+    "other", "events", "ticks", "actors", "tiles", "doors_teleport",
+    "actor_render", "hud", "debug_overlay", "present", "uploads", "spin", "idle",
+};
+
+// The frame being recorded; only touched by the recording thread
+thread_local bool t_recording_thread = false;
+ProfileFrame g_current_frame;
+bool g_frame_open = false;
+uint64_t g_last_mark = 0;
+double g_ms_per_count = 0.0;
+ProfilePhase g_phase_stack[MAX_PHASE_DEPTH];
+int g_phase_depth = 0;
+uint64_t g_next_frame_number = 0;
+
+// Published frames: slot n % PROFILE_RING_FRAMES holds frame n until it is
+// overwritten PROFILE_RING_FRAMES frames later; g_frames_published counts
+// the frames written so far
+ProfileFrame g_ring[PROFILE_RING_FRAMES];
+std::atomic<uint64_t> g_frames_published{0};
+
+// --perf-log writer
+std::FILE* g_perf_log = nullptr;
+std::thread g_perf_log_thread;
+std::atomic<bool> g_perf_log_stopping{false};
+uint64_t g_perf_log_next = 0;      // Next frame the writer expects
+uint64_t g_perf_log_dropped = 0;   // Frames overwritten before the writer got to them
+
+void charge_current_phase(uint64_t now) {
+    const ProfilePhase phase = g_phase_depth > 0 ? g_phase_stack[g_phase_depth - 1] : ProfilePhase::OTHER;
+    g_current_frame.phase_ms[static_cast<size_t>(phase)] +=
+        static_cast<float>(static_cast<double>(now - g_last_mark) * g_ms_per_count);
+    g_last_mark = now;
+}
+
+void write_perf_log_header() {
+    std::fputs("frame,total_ms,ticks", g_perf_log);
+    for (size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+        std::fprintf(g_perf_log, ",%s_ms", PHASE_NAMES[i]);
+    }
+    std::fputs(",present_interval_ms\n", g_perf_log);
+}
+
+void write_perf_log_frame(const ProfileFrame& frame) {
+    std::fprintf(g_perf_log, "%llu,%.4f,%u", static_cast<unsigned long long>(frame.frame_number),
+                 frame.total_ms(), frame.ticks);
+    for (size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+        std::fprintf(g_perf_log, ",%.4f", frame.phase_ms[i]);
+    }
+    std::fprintf(g_perf_log, ",%.4f\n", frame.present_interval_ms);
+}
+
+// Write out every frame published since the last drain
+void drain_perf_log() {
+    const uint64_t published = g_frames_published.load(std::memory_order_acquire);
+    if (published - g_perf_log_next > PROFILE_RING_FRAMES) {
+        g_perf_log_dropped += published - PROFILE_RING_FRAMES - g_perf_log_next;
+        g_perf_log_next = published - PROFILE_RING_FRAMES;
+    }
+    for (; g_perf_log_next < published; ++g_perf_log_next) {
+        const ProfileFrame frame = g_ring[g_perf_log_next % PROFILE_RING_FRAMES];
+        // The producer may have lapped us while copying; such a frame is lost
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (g_frames_published.load(std::memory_order_relaxed) - g_perf_log_next >= PROFILE_RING_FRAMES) {
+            ++g_perf_log_dropped;
+            continue;
+        }
+        write_perf_log_frame(frame);
+    }
+}
+
+void perf_log_main() {
+    while (!g_perf_log_stopping.load(std::memory_order_acquire)) {
+        drain_perf_log();
+        std::this_thread::sleep_for(PERF_LOG_POLL_INTERVAL);
+    }
+    drain_perf_log();
+}
+
+}  // namespace
+
+const char* get_profile_phase_name(ProfilePhase phase) {
+    const size_t index = static_cast<size_t>(phase);
+    return index < PROFILE_PHASE_COUNT ? PHASE_NAMES[index] : "unknown";
+}
+
+float ProfileFrame::total_ms() const {
+    float total = 0.0f;
+    for (float ms : phase_ms) {
+        total += ms;
+    }
+    return total;
+}
+
+void enable_frame_profiler(bool enabled) {
+    if (enabled) {
+        g_ms_per_count = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+        t_recording_thread = true;
+    }
+    g_frame_profiler_enabled.store(enabled, std::memory_order_relaxed);
+    g_frame_open = false;
+    g_phase_depth = 0;
+}
+
+void profiler_push(ProfilePhase phase) {
+    if (!t_recording_thread || !g_frame_open) {
+        return;
+    }
+    charge_current_phase(SDL_GetPerformanceCounter());
+    if (g_phase_depth < MAX_PHASE_DEPTH) {
+        g_phase_stack[g_phase_depth] = phase;
+    }
+    ++g_phase_depth;
+}
+
+void profiler_pop() {
+    if (!t_recording_thread || !g_frame_open || g_phase_depth == 0) {
+        return;
+    }
+    charge_current_phase(SDL_GetPerformanceCounter());
+    --g_phase_depth;
+}
+
+void profiler_begin_frame() {
+    if (!is_frame_profiler_enabled() || !t_recording_thread) {
+        return;
+    }
+    const uint64_t now = SDL_GetPerformanceCounter();
+    if (g_frame_open) {
+        charge_current_phase(now);
+        const uint64_t published = g_frames_published.load(std::memory_order_relaxed);
+        g_ring[published % PROFILE_RING_FRAMES] = g_current_frame;
+        g_frames_published.store(published + 1, std::memory_order_release);
+    }
+    g_current_frame = ProfileFrame();
+    g_current_frame.frame_number = g_next_frame_number++;
+    g_last_mark = now;
+    g_phase_depth = 0;
+    g_frame_open = true;
+}
+
+void profiler_add_ticks(uint32_t ticks) {
+    if (is_frame_profiler_enabled() && t_recording_thread) {
+        g_current_frame.ticks += ticks;
+    }
+}
+
+void profiler_set_present_interval(float interval_ms) {
+    if (is_frame_profiler_enabled() && t_recording_thread) {
+        g_current_frame.present_interval_ms = interval_ms;
+    }
+}
+
+size_t copy_recent_profile_frames(ProfileFrame* out, size_t max_frames) {
+    const uint64_t published = g_frames_published.load(std::memory_order_acquire);
+    size_t count = static_cast<size_t>(std::min<uint64_t>(published, PROFILE_RING_FRAMES));
+    count = std::min(count, max_frames);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = g_ring[(published - count + i) % PROFILE_RING_FRAMES];
+    }
+    return count;
+}
+
+bool start_perf_log(const std::string& path) {
+#if !defined(COMIC_FRAME_PROFILER)
+    std::cerr << "--perf-log: this build has the frame profiler compiled out (ENABLE_FRAME_PROFILER)" << std::endl;
+    (void)path;
+    return false;
+#else
+    if (g_perf_log) {
+        return true;
+    }
+    g_perf_log = std::fopen(path.c_str(), "w");
+    if (!g_perf_log) {
+        std::cerr << "Failed to create perf log: " << path << std::endl;
+        return false;
+    }
+    write_perf_log_header();
+    enable_frame_profiler(true);
+    g_perf_log_next = g_frames_published.load(std::memory_order_acquire);
+    g_perf_log_dropped = 0;
+    g_perf_log_stopping.store(false, std::memory_order_release);
+    g_perf_log_thread = std::thread(perf_log_main);
+    return true;
+#endif
+}
+
+void stop_perf_log() {
+    if (!g_perf_log) {
+        return;
+    }
+    g_perf_log_stopping.store(true, std::memory_order_release);
+    if (g_perf_log_thread.joinable()) {
+        g_perf_log_thread.join();
+    }
+    std::fclose(g_perf_log);
+    g_perf_log = nullptr;
+    if (g_perf_log_dropped > 0) {
+        std::cerr << "Perf log: " << g_perf_log_dropped << " frame(s) were overwritten before they were written"
+                  << std::endl;
+    }
+}
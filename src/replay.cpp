@@ -0,0 +1,209 @@
+#include "../include/replay.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+static const uint8_t REPLAY_MAGIC[4] = {'C', 'C', 'R', 'P'};
+constexpr uint8_t REPLAY_VERSION = 1;
+constexpr uint8_t REPLAY_FLAG_DEBUG = 0x01;
+
+static void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static void put_u64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// Bounds-checked reader over the file bytes; any overrun sets failed
+struct ReplayReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool failed = false;
+
+    uint8_t byte() {
+        if (pos >= size) {
+            failed = true;
+            return 0;
+        }
+        return data[pos++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+
+    uint64_t u64() {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(byte()) << (8 * i);
+        }
+        return value;
+    }
+};
+
+bool ReplayRecording::checksum_after(uint64_t tick, uint64_t* checksum) const {
+    if (!is_checksum_tick(tick)) {
+        return false;
+    }
+    const uint64_t index = tick / REPLAY_CHECKSUM_INTERVAL;
+    if (index >= checksums.size()) {
+        return false;
+    }
+    *checksum = checksums[index];
+    return true;
+}
+
+std::vector<uint8_t> ReplayRecording::encode() const {
+    std::vector<uint8_t> out(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    out.push_back(REPLAY_VERSION);
+    out.push_back(debug_mode ? REPLAY_FLAG_DEBUG : 0);
+    out.push_back(start_level);
+    out.push_back(start_stage);
+    put_varint(out, keys.size());
+
+    // Changes relative to "no keys held before tick 0"
+    std::vector<uint8_t> changes;
+    uint64_t change_count = 0;
+    uint8_t previous = 0;
+    uint64_t previous_tick = 0;
+    for (uint64_t tick = 0; tick < keys.size(); ++tick) {
+        if (keys[tick] != previous) {
+            put_varint(changes, tick - previous_tick);
+            changes.push_back(keys[tick]);
+            previous = keys[tick];
+            previous_tick = tick;
+            ++change_count;
+        }
+    }
+    put_varint(out, change_count);
+    out.insert(out.end(), changes.begin(), changes.end());
+
+    put_varint(out, checksums.size());
+    for (uint64_t checksum : checksums) {
+        put_u64(out, checksum);
+    }
+    put_u64(out, final_checksum);
+    return out;
+}
+
+bool ReplayRecording::decode(const uint8_t* data, size_t size) {
+    ReplayReader in = {data, size};
+    for (uint8_t expected : REPLAY_MAGIC) {
+        if (in.byte() != expected) {
+            std::cerr << "Not a replay file" << std::endl;
+            return false;
+        }
+    }
+    const uint8_t version = in.byte();
+    if (version != REPLAY_VERSION) {
+        std::cerr << "Unsupported replay version " << static_cast<int>(version) << std::endl;
+        return false;
+    }
+    const uint8_t flags = in.byte();
+    const uint8_t level = in.byte();
+    const uint8_t stage = in.byte();
+    const uint64_t tick_count = in.varint();
+    const uint64_t change_count = in.varint();
+    // Each change takes at least two bytes; reject counts the file cannot hold
+    if (in.failed || change_count > size / 2 || change_count > tick_count) {
+        std::cerr << "Truncated replay header" << std::endl;
+        return false;
+    }
+
+    // Read the changes first: tick_count is only trusted, and the keys only
+    // expanded, once the checksums show how long the recording really is
+    std::vector<std::pair<uint64_t, uint8_t>> changes;
+    changes.reserve(static_cast<size_t>(change_count));
+    uint64_t tick = 0;
+    for (uint64_t i = 0; i < change_count && !in.failed; ++i) {
+        const uint64_t change_tick = tick + in.varint();
+        const uint8_t new_keys = in.byte();
+        if (change_tick > tick_count || change_tick < tick || (i > 0 && change_tick == tick)) {
+            in.failed = true;
+            break;
+        }
+        changes.emplace_back(change_tick, new_keys);
+        tick = change_tick;
+    }
+
+    const uint64_t checksum_count = in.varint();
+    if (in.failed || checksum_count > size / 8) {
+        std::cerr << "Corrupt replay input stream" << std::endl;
+        return false;
+    }
+    // A recording keeps a checksum after every checksum tick it ran
+    if (tick_count / REPLAY_CHECKSUM_INTERVAL != checksum_count) {
+        std::cerr << "Replay tick count " << tick_count << " does not match its " << checksum_count
+                  << " checksums" << std::endl;
+        return false;
+    }
+    std::vector<uint64_t> decoded_checksums;
+    decoded_checksums.reserve(static_cast<size_t>(checksum_count));
+    for (uint64_t i = 0; i < checksum_count; ++i) {
+        decoded_checksums.push_back(in.u64());
+    }
+    const uint64_t decoded_final = in.u64();
+    if (in.failed) {
+        std::cerr << "Truncated replay checksums" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> decoded;
+    decoded.reserve(static_cast<size_t>(tick_count));
+    uint8_t held = 0;
+    for (const auto& change : changes) {
+        decoded.insert(decoded.end(), static_cast<size_t>(change.first - decoded.size()), held);
+        held = change.second;
+    }
+    decoded.insert(decoded.end(), static_cast<size_t>(tick_count - decoded.size()), held);
+
+    debug_mode = (flags & REPLAY_FLAG_DEBUG) != 0;
+    start_level = level;
+    start_stage = stage;
+    keys.swap(decoded);
+    checksums.swap(decoded_checksums);
+    final_checksum = decoded_final;
+    return true;
+}
+
+bool ReplayRecording::save(const std::string& path) const {
+    const std::vector<uint8_t> bytes = encode();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        std::cerr << "Failed to write replay: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayRecording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open replay: " << path << std::endl;
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!decode(bytes.data(), bytes.size())) {
+        std::cerr << "Failed to load replay: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
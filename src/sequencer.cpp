@@ -0,0 +1,140 @@
+/**
+ * sequencer.cpp - Scripted sequences stepped from the main loop
+ */
+
+#include "../include/sequencer.h"
+#include <utility>
+
+Sequencer::Sequencer(double tick_ms) : ms_per_tick(tick_ms) {}
+
+void Sequencer::push(StepType type, Action action, double duration_ms) {
+    Step step;
+    step.type = type;
+    step.action = std::move(action);
+    step.duration_ms = duration_ms;
+    steps.push_back(std::move(step));
+}
+
+void Sequencer::run(Action action) {
+    push(StepType::RUN, std::move(action), 0.0);
+}
+
+void Sequencer::show(Action new_scene) {
+    push(StepType::SHOW, std::move(new_scene), 0.0);
+}
+
+void Sequencer::wait_ticks(int ticks) {
+    push(StepType::WAIT_MS, nullptr, ms_per_tick * ticks);
+}
+
+void Sequencer::wait_ms(double duration_ms) {
+    push(StepType::WAIT_MS, nullptr, duration_ms);
+}
+
+void Sequencer::wait_for_key() {
+    push(StepType::WAIT_KEY, nullptr, 0.0);
+}
+
+void Sequencer::repeat_while(Condition condition, Action queue_pass) {
+    push(StepType::REPEAT, std::move(queue_pass), 0.0);
+    steps.back().condition = std::move(condition);
+}
+
+void Sequencer::on_key_down() {
+    if (waiting && !steps.empty() && steps.front().type == StepType::WAIT_KEY) {
+        key_pressed = true;
+    }
+}
+
+bool Sequencer::update(uint32_t now_ms) {
+    const double now = static_cast<double>(now_ms);
+    while (!steps.empty()) {
+        Step& step = steps.front();
+        switch (step.type) {
+            case StepType::RUN: {
+                // Off the queue first: the action may queue steps or clear()
+                Action action = std::move(step.action);
+                steps.pop_front();
+                if (action) {
+                    action();
+                }
+                break;
+            }
+            case StepType::REPEAT: {
+                if (!step.condition || !step.condition()) {
+                    steps.pop_front();
+                    break;
+                }
+                // Queue the pass on its own, then put this step and the
+                // rest back after it
+                const Action queue_pass = step.action;
+                std::deque<Step> rest;
+                rest.swap(steps);
+                if (queue_pass) {
+                    queue_pass();
+                }
+                if (steps.empty() && !rest.empty()) {
+                    rest.pop_front();  // An empty pass would loop forever
+                }
+                for (Step& later : rest) {
+                    steps.push_back(std::move(later));
+                }
+                break;
+            }
+            case StepType::SHOW:
+                scene = std::move(step.action);
+                steps.pop_front();
+                break;
+            case StepType::WAIT_MS: {
+                if (!waiting) {
+                    waiting = true;
+                    // Carry on from the last deadline unless this wait
+                    // would already be over by the time it was noticed
+                    const bool keep_cadence = has_deadline && last_deadline_ms + step.duration_ms > now;
+                    wait_start_ms = keep_cadence ? last_deadline_ms : now;
+                }
+                const double deadline = wait_start_ms + step.duration_ms;
+                if (now < deadline) {
+                    return true;
+                }
+                steps.pop_front();
+                waiting = false;
+                has_deadline = true;
+                last_deadline_ms = deadline;
+                break;
+            }
+            case StepType::WAIT_KEY:
+                if (!waiting) {
+                    // Keys handed over before this frame were for earlier steps
+                    waiting = true;
+                    key_pressed = false;
+                    return true;
+                }
+                if (!key_pressed) {
+                    return true;
+                }
+                steps.pop_front();
+                waiting = false;
+                key_pressed = false;
+                has_deadline = false;
+                break;
+        }
+    }
+    scene = nullptr;
+    has_deadline = false;
+    return false;
+}
+
+void Sequencer::draw() const {
+    if (scene) {
+        scene();
+    }
+}
+
+void Sequencer::clear() {
+    steps.clear();
+    scene = nullptr;
+    waiting = false;
+    key_pressed = false;
+    has_deadline = false;
+}
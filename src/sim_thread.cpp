@@ -0,0 +1,150 @@
+/**
+ * sim_thread.cpp - Gameplay ticks on their own thread
+ */
+
+#include "../include/sim_thread.h"
+#include "../include/audio.h"
+#include "../include/cheats.h"
+#include "../include/counters.h"
+#include "../include/replay.h"
+
+// Let the final stretch to a tick go by in yields rather than a sleep that
+// may overshoot it
+constexpr double SIM_YIELD_THRESHOLD_MS = 2.0;
+// Polling interval while paused
+constexpr uint32_t SIM_PAUSED_SLEEP_MS = 5;
+// Ticks the simulation may run back to back to catch up after a stall
+// (the windowed loop's MAX_TICKS_PER_FRAME); later ones are dropped
+constexpr uint64_t SIM_MAX_CATCH_UP_TICKS = 5;
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start(const GameContext& start_state, double tick_ms, TickFunction tick) {
+    stop();
+    game = start_state;
+    game.graphics = nullptr;  // Textures are the render thread's business
+    ms_per_tick = tick_ms;
+    tick_function = std::move(tick);
+    ticks = 0;
+    paused = false;
+    stopping.store(false, std::memory_order_relaxed);
+    publish(TickOutcome::Continue, false);
+    thread = std::thread(&SimulationThread::thread_main, this);
+}
+
+void SimulationThread::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    stopping.store(true, std::memory_order_relaxed);
+    thread.join();
+}
+
+// Set (1) or clear (0) the key states of the INPUT_* bits in keys
+static void set_key_states(GameContext& game, uint8_t keys, uint8_t value) {
+    if (keys & INPUT_LEFT) {
+        game.key_state_left = value;
+    }
+    if (keys & INPUT_RIGHT) {
+        game.key_state_right = value;
+    }
+    if (keys & INPUT_JUMP) {
+        game.key_state_jump = value;
+    }
+    if (keys & INPUT_FIRE) {
+        game.key_state_fire = value;
+    }
+    if (keys & INPUT_OPEN) {
+        game.key_state_open = value;
+    }
+    if (keys & INPUT_TELEPORT) {
+        game.key_state_teleport = value;
+    }
+}
+
+void SimulationThread::apply_input(const SimInput& input) {
+    switch (input.type) {
+        case SimInputType::KEY_DOWN:
+            set_key_states(game, input.keys, 1);
+            if (g_cheats) {
+                g_cheats->process_input(input.key);
+            }
+            break;
+        case SimInputType::KEY_UP:
+            set_key_states(game, input.keys, 0);
+            break;
+        case SimInputType::PAUSE:
+        case SimInputType::RESUME:
+            paused = input.type == SimInputType::PAUSE;
+            clear_gameplay_key_states(game);
+            break;
+    }
+}
+
+void SimulationThread::publish(TickOutcome outcome, bool finished) {
+    SimRenderState& state = states.back_buffer();
+    state.game = game;
+    state.tick = ticks;
+    state.outcome = outcome;
+    state.finished = finished;
+    state.show_debug_overlay = g_cheats && g_cheats->should_show_debug_overlay();
+    state.published_counter = SDL_GetPerformanceCounter();
+    states.publish();
+}
+
+void SimulationThread::thread_main() {
+    const double counts_per_ms = static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0;
+    const uint64_t period = static_cast<uint64_t>(ms_per_tick * counts_per_ms);
+    uint64_t next_tick = SDL_GetPerformanceCounter() + period;
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+        // Inputs that arrived while waiting count for the coming tick
+        SimInput input;
+        while (inputs.pop(&input)) {
+            const bool was_paused = paused;
+            apply_input(input);
+            if (was_paused && !paused) {
+                next_tick = SDL_GetPerformanceCounter() + period;
+            }
+        }
+        if (paused) {
+            SDL_Delay(SIM_PAUSED_SLEEP_MS);
+            continue;
+        }
+
+        const uint64_t now = SDL_GetPerformanceCounter();
+        if (now < next_tick) {
+            const double remaining_ms = static_cast<double>(next_tick - now) / counts_per_ms;
+            if (remaining_ms > SIM_YIELD_THRESHOLD_MS) {
+                SDL_Delay(static_cast<uint32_t>(remaining_ms - SIM_YIELD_THRESHOLD_MS) + 1);
+            } else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        if (now - next_tick >= period * SIM_MAX_CATCH_UP_TICKS) {
+            // Too far behind to catch up without a burst: give up the
+            // missed ticks and start the cadence again from here
+            count_event(Counter::TICKS_DROPPED, (now - next_tick) / period);
+            next_tick = now;
+        }
+        next_tick += period;
+
+        game.suppress_jump_animation = false;  // Per tick here; the renderer clears its copy per frame
+        set_audio_tick_time(SDL_GetTicks());
+        TickOutcome outcome = TickOutcome::Continue;
+        if (!tick_function(game, &outcome)) {
+            publish(TickOutcome::Continue, true);
+            break;
+        }
+        ++ticks;
+        count_event(Counter::TICKS_RUN);
+        const bool finished = outcome != TickOutcome::Continue;
+        publish(outcome, finished);
+        if (finished) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,745 @@
+#include "../include/snapshot.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include "../include/game_context.h"
+#include "../include/level_loader.h"
+
+static_assert(SNAPSHOT_MAX_ENCODED_SIZE <= 0xFFFF, "SnapshotRing entry sizes are 16-bit");
+
+static const uint8_t SNAPSHOT_MAGIC[4] = {'C', 'C', 'S', 'S'};
+constexpr uint8_t SNAPSHOT_VERSION = 2;
+
+// Base of keyframes and save state files
+static const GameSnapshot zero_snapshot = {};
+
+static const uint8_t* snapshot_bytes(const GameSnapshot& snapshot) {
+    return reinterpret_cast<const uint8_t*>(&snapshot);
+}
+
+static size_t put_varint(uint8_t* out, uint64_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = static_cast<uint8_t>(value);
+    return length;
+}
+
+static bool get_varint(const uint8_t* data, size_t size, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7) {
+        const uint8_t b = data[pos++];
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Index of a level in level_data_pointers, or SNAPSHOT_NONE
+static uint8_t level_index_of(const level_t* level) {
+    for (uint8_t i = 0; i < 8; ++i) {
+        if (level_data_pointers[i] == level) {
+            return i;
+        }
+    }
+    return SNAPSHOT_NONE;
+}
+
+static const level_t* level_at(uint8_t index) {
+    return index < 8 ? level_data_pointers[index] : nullptr;
+}
+
+bool GameSnapshot::operator==(const GameSnapshot& other) const {
+    return std::memcmp(this, &other, sizeof(GameSnapshot)) == 0;
+}
+
+bool capture_snapshot(const GameContext& game, GameSnapshot& snapshot) {
+    std::memset(&snapshot, 0, sizeof(snapshot));
+    if (!game.actors.fits_snapshot()) {
+        return false;
+    }
+
+    std::memcpy(snapshot.level_solidity_bits, game.level_solidity.bits, sizeof(snapshot.level_solidity_bits));
+    snapshot.level_solidity_last_passable = game.level_solidity.last_passable;
+    snapshot.current_level_index = level_index_of(game.current_level_ptr);
+    snapshot.solidity_level_index = level_index_of(game.solidity_level);
+    snapshot.stage_map_level = SNAPSHOT_NONE;
+    snapshot.stage_map_stage = SNAPSHOT_NONE;
+    if (game.stage_map) {
+        for (uint8_t level = 0; level < 8 && snapshot.stage_map_level == SNAPSHOT_NONE; ++level) {
+            for (uint8_t stage = 0; stage < 3; ++stage) {
+                if (level_data_pointers[level]->stages[stage].tiles.data == game.stage_map) {
+                    snapshot.stage_map_level = level;
+                    snapshot.stage_map_stage = stage;
+                    break;
+                }
+            }
+        }
+    } else {
+        std::memcpy(snapshot.scratch_tiles, game.scratch_tiles, sizeof(snapshot.scratch_tiles));
+    }
+    snapshot.streamed_stage = game.tile_map != nullptr;
+    snapshot.map_origin_x = game.map_origin_x;
+    snapshot.checkpoint_map_origin_x = game.checkpoint_map_origin_x;
+
+    snapshot.comic_x = game.comic_x;
+    snapshot.comic_y = game.comic_y;
+    snapshot.camera_x = game.camera_x;
+    snapshot.comic_run_cycle_frame = game.comic_run_cycle_frame;
+    snapshot.run_frame_count = game.run_frame_count;
+    snapshot.comic_y_vel = game.comic_y_vel;
+    snapshot.comic_x_momentum = game.comic_x_momentum;
+    snapshot.comic_facing = game.comic_facing;
+    snapshot.comic_is_falling_or_jumping = game.comic_is_falling_or_jumping;
+    snapshot.comic_jump_counter = game.comic_jump_counter;
+    snapshot.comic_jump_power = game.comic_jump_power;
+
+    snapshot.key_state_jump = game.key_state_jump;
+    snapshot.previous_key_state_jump = game.previous_key_state_jump;
+    snapshot.key_state_left = game.key_state_left;
+    snapshot.key_state_right = game.key_state_right;
+    snapshot.key_state_open = game.key_state_open;
+    snapshot.previous_key_state_open = game.previous_key_state_open;
+    snapshot.key_state_fire = game.key_state_fire;
+    snapshot.key_state_teleport = game.key_state_teleport;
+    snapshot.previous_key_state_teleport = game.previous_key_state_teleport;
+    snapshot.key_states_cleared = game.key_states_cleared;
+
+    snapshot.comic_has_door_key = game.comic_has_door_key;
+    snapshot.comic_num_lives = game.comic_num_lives;
+    snapshot.lives_sequence_counter = game.lives_sequence_counter;
+    snapshot.lives_sequence_delay = game.lives_sequence_delay;
+    snapshot.lives_sequence_complete = game.lives_sequence_complete;
+    snapshot.comic_hp = game.comic_hp;
+    snapshot.comic_hp_pending_increase = game.comic_hp_pending_increase;
+    std::memcpy(snapshot.score_bytes, game.score_bytes, sizeof(snapshot.score_bytes));
+    snapshot.score_10000_counter = game.score_10000_counter;
+    snapshot.game_over_triggered = game.game_over_triggered;
+
+    snapshot.current_level_number = game.current_level_number;
+    snapshot.current_stage_number = game.current_stage_number;
+    snapshot.source_door_level_number = game.source_door_level_number;
+    snapshot.source_door_stage_number = game.source_door_stage_number;
+    snapshot.comic_y_checkpoint = game.comic_y_checkpoint;
+    snapshot.comic_x_checkpoint = game.comic_x_checkpoint;
+    snapshot.first_stage_loaded = game.first_stage_loaded;
+    snapshot.cheat_noclip = game.cheat_noclip;
+    snapshot.ceiling_stick_flag = game.ceiling_stick_flag;
+
+    snapshot.player_is_dying = game.player_is_dying;
+    snapshot.player_death_too_bad_phase = game.player_death_too_bad_phase;
+    snapshot.player_death_show_animation = game.player_death_show_animation;
+    snapshot.player_death_fall_clip_render = game.player_death_fall_clip_render;
+    snapshot.player_death_ticks_remaining = game.player_death_ticks_remaining;
+
+    snapshot.door_anim_phase = static_cast<uint8_t>(game.door_anim_phase);
+    snapshot.door_anim_frame = game.door_anim_frame;
+    snapshot.door_exit_delay_ticks = game.door_exit_delay_ticks;
+    snapshot.door_anim_world_x = game.door_anim_world_x;
+    snapshot.door_anim_world_y = game.door_anim_world_y;
+    snapshot.door_pending_level = game.door_pending_level;
+    snapshot.door_pending_stage = game.door_pending_stage;
+
+    snapshot.comic_is_teleporting = game.comic_is_teleporting;
+    snapshot.teleport_animation = game.teleport_animation;
+    snapshot.teleport_source_x = game.teleport_source_x;
+    snapshot.teleport_source_y = game.teleport_source_y;
+    snapshot.teleport_destination_x = game.teleport_destination_x;
+    snapshot.teleport_destination_y = game.teleport_destination_y;
+    snapshot.teleport_camera_counter = game.teleport_camera_counter;
+    snapshot.teleport_camera_vel = game.teleport_camera_vel;
+    snapshot.teleport_skip_tick = game.teleport_skip_tick;
+
+    snapshot.player_moved_last_tick = game.player_moved_last_tick;
+    snapshot.player_airborne_from_walk_off = game.player_airborne_from_walk_off;
+    snapshot.suppress_jump_animation = game.suppress_jump_animation;
+    snapshot.beam_out_sequence_played = game.beam_out_sequence_played;
+    snapshot.win_counter = game.win_counter;
+    snapshot.enemy_level_number = game.enemy_level_number;
+    snapshot.enemy_stage_number = game.enemy_stage_number;
+
+    game.actors.save_snapshot(snapshot.actors);
+    return true;
+}
+
+bool restore_snapshot(GameContext& game, const GameSnapshot& snapshot) {
+    if (!game.actors.fits_snapshot()) {
+        return false;
+    }
+    const uint8_t previous_level_number = game.current_level_number;
+    const uint8_t* previous_tiles = game.current_tiles();
+
+    game.comic_x = snapshot.comic_x;
+    game.comic_y = snapshot.comic_y;
+    game.camera_x = snapshot.camera_x;
+    game.comic_run_cycle_frame = snapshot.comic_run_cycle_frame;
+    game.run_frame_count = snapshot.run_frame_count;
+    game.comic_y_vel = snapshot.comic_y_vel;
+    game.comic_x_momentum = snapshot.comic_x_momentum;
+    game.comic_facing = snapshot.comic_facing;
+    game.comic_is_falling_or_jumping = snapshot.comic_is_falling_or_jumping;
+    game.comic_jump_counter = snapshot.comic_jump_counter;
+    game.comic_jump_power = snapshot.comic_jump_power;
+
+    game.key_state_jump = snapshot.key_state_jump;
+    game.previous_key_state_jump = snapshot.previous_key_state_jump;
+    game.key_state_left = snapshot.key_state_left;
+    game.key_state_right = snapshot.key_state_right;
+    game.key_state_open = snapshot.key_state_open;
+    game.previous_key_state_open = snapshot.previous_key_state_open;
+    game.key_state_fire = snapshot.key_state_fire;
+    game.key_state_teleport = snapshot.key_state_teleport;
+    game.previous_key_state_teleport = snapshot.previous_key_state_teleport;
+    game.key_states_cleared = snapshot.key_states_cleared != 0;
+
+    game.comic_has_door_key = snapshot.comic_has_door_key;
+    game.comic_num_lives = snapshot.comic_num_lives;
+    game.lives_sequence_counter = snapshot.lives_sequence_counter;
+    game.lives_sequence_delay = snapshot.lives_sequence_delay;
+    game.lives_sequence_complete = snapshot.lives_sequence_complete != 0;
+    game.comic_hp = snapshot.comic_hp;
+    game.comic_hp_pending_increase = snapshot.comic_hp_pending_increase;
+    std::memcpy(game.score_bytes, snapshot.score_bytes, sizeof(game.score_bytes));
+    game.score_10000_counter = snapshot.score_10000_counter;
+    game.game_over_triggered = snapshot.game_over_triggered != 0;
+
+    game.current_level_number = snapshot.current_level_number;
+    game.current_stage_number = snapshot.current_stage_number;
+    game.current_level_ptr = level_at(snapshot.current_level_index);
+    game.source_door_level_number = snapshot.source_door_level_number;
+    game.source_door_stage_number = snapshot.source_door_stage_number;
+    game.comic_y_checkpoint = snapshot.comic_y_checkpoint;
+    game.comic_x_checkpoint = snapshot.comic_x_checkpoint;
+    game.first_stage_loaded = snapshot.first_stage_loaded != 0;
+    set_noclip(game, snapshot.cheat_noclip != 0);
+    game.ceiling_stick_flag = snapshot.ceiling_stick_flag != 0;
+
+    game.player_is_dying = snapshot.player_is_dying != 0;
+    game.player_death_too_bad_phase = snapshot.player_death_too_bad_phase != 0;
+    game.player_death_show_animation = snapshot.player_death_show_animation != 0;
+    game.player_death_fall_clip_render = snapshot.player_death_fall_clip_render != 0;
+    game.player_death_ticks_remaining = snapshot.player_death_ticks_remaining;
+
+    game.door_anim_phase = static_cast<DoorAnimationPhase>(snapshot.door_anim_phase);
+    game.door_anim_frame = snapshot.door_anim_frame;
+    game.door_exit_delay_ticks = snapshot.door_exit_delay_ticks;
+    game.door_anim_world_x = snapshot.door_anim_world_x;
+    game.door_anim_world_y = snapshot.door_anim_world_y;
+    game.door_pending_level = snapshot.door_pending_level;
+    game.door_pending_stage = snapshot.door_pending_stage;
+
+    game.comic_is_teleporting = snapshot.comic_is_teleporting != 0;
+    game.teleport_animation = snapshot.teleport_animation;
+    game.teleport_source_x = snapshot.teleport_source_x;
+    game.teleport_source_y = snapshot.teleport_source_y;
+    game.teleport_destination_x = snapshot.teleport_destination_x;
+    game.teleport_destination_y = snapshot.teleport_destination_y;
+    game.teleport_camera_counter = snapshot.teleport_camera_counter;
+    game.teleport_camera_vel = snapshot.teleport_camera_vel;
+    game.teleport_skip_tick = snapshot.teleport_skip_tick != 0;
+
+    game.player_moved_last_tick = snapshot.player_moved_last_tick != 0;
+    game.player_airborne_from_walk_off = snapshot.player_airborne_from_walk_off != 0;
+    game.suppress_jump_animation = snapshot.suppress_jump_animation != 0;
+    game.beam_out_sequence_played = snapshot.beam_out_sequence_played != 0;
+    game.win_counter = snapshot.win_counter;
+    game.enemy_level_number = snapshot.enemy_level_number;
+    game.enemy_stage_number = snapshot.enemy_stage_number;
+
+    game.actors.restore_snapshot(snapshot.actors, game.graphics);
+
+    // A streamed stage's map is the one its level and stage stream from
+    game.tile_map = snapshot.streamed_stage
+        ? get_stage_tile_map(game.current_level_ptr, game.current_stage_number)
+        : nullptr;
+    game.map_origin_x = snapshot.map_origin_x;
+    game.checkpoint_map_origin_x = snapshot.checkpoint_map_origin_x;
+    game.actors.set_window_origin(game.map_origin_x * 2);
+
+    // Tiles and collision, from the level data where possible
+    bool tiles_changed = false;
+    const level_t* map_level = level_at(snapshot.stage_map_level);
+    if (map_level && snapshot.stage_map_stage < 3) {
+        game.stage_map = map_level->stages[snapshot.stage_map_stage].tiles;
+    } else {
+        game.stage_map = nullptr;
+        if (std::memcmp(game.scratch_tiles, snapshot.scratch_tiles, sizeof(game.scratch_tiles)) != 0) {
+            std::memcpy(game.scratch_tiles, snapshot.scratch_tiles, sizeof(game.scratch_tiles));
+            tiles_changed = true;
+        }
+    }
+    tiles_changed = tiles_changed || game.current_tiles() != previous_tiles;
+    std::memcpy(game.level_solidity.bits, snapshot.level_solidity_bits, sizeof(game.level_solidity.bits));
+    game.level_solidity.last_passable = snapshot.level_solidity_last_passable;
+    game.solidity_level = level_at(snapshot.solidity_level_index);
+    game.stage_collision.build(game.current_tiles(), game.level_solidity);
+    if (tiles_changed) {
+        game.stage_tiles_revision++;
+    }
+
+    if (game.current_level_number != previous_level_number) {
+        load_level_graphics(game);
+    }
+    return true;
+}
+
+size_t encode_snapshot_delta(const GameSnapshot& previous, const GameSnapshot& snapshot, uint8_t* out) {
+    const uint8_t* a = snapshot_bytes(previous);
+    const uint8_t* b = snapshot_bytes(snapshot);
+    constexpr size_t n = sizeof(GameSnapshot);
+    size_t pos = 0;
+    size_t length = 0;
+    while (pos < n) {
+        const size_t run_start = pos;
+        while (pos < n && a[pos] == b[pos]) {
+            ++pos;
+        }
+        // A literal ends at two equal bytes in a row: a lone one is cheaper
+        // to copy than to start a new pair for
+        const size_t literal_start = pos;
+        while (pos < n && !(a[pos] == b[pos] && (pos + 1 == n || a[pos + 1] == b[pos + 1]))) {
+            ++pos;
+        }
+        length += put_varint(out + length, literal_start - run_start);
+        length += put_varint(out + length, pos - literal_start);
+        for (size_t i = literal_start; i < pos; ++i) {
+            out[length++] = a[i] ^ b[i];
+        }
+    }
+    return length;
+}
+
+bool apply_snapshot_delta(GameSnapshot& snapshot, const uint8_t* data, size_t size) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&snapshot);
+    constexpr size_t n = sizeof(GameSnapshot);
+    size_t pos = 0;
+    size_t in = 0;
+    while (in < size) {
+        uint64_t run = 0;
+        uint64_t literal = 0;
+        if (!get_varint(data, size, in, run) || !get_varint(data, size, in, literal) ||
+            run > n - pos || literal > n - pos - run || literal > size - in) {
+            return false;
+        }
+        pos += static_cast<size_t>(run);
+        for (uint64_t i = 0; i < literal; ++i) {
+            bytes[pos++] ^= data[in++];
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> GameSnapshot::encode() const {
+    std::vector<uint8_t> out(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 4);
+    out.push_back(SNAPSHOT_VERSION);
+    uint8_t varint[10];
+    out.insert(out.end(), varint, varint + put_varint(varint, sizeof(GameSnapshot)));
+    const size_t header = out.size();
+    out.resize(header + SNAPSHOT_MAX_ENCODED_SIZE);
+    out.resize(header + encode_snapshot_delta(zero_snapshot, *this, out.data() + header));
+    return out;
+}
+
+bool GameSnapshot::decode(const uint8_t* data, size_t size) {
+    if (size < 5 || std::memcmp(data, SNAPSHOT_MAGIC, 4) != 0) {
+        std::cerr << "Not a save state file" << std::endl;
+        return false;
+    }
+    if (data[4] != SNAPSHOT_VERSION) {
+        std::cerr << "Unsupported save state version " << static_cast<int>(data[4]) << std::endl;
+        return false;
+    }
+    size_t pos = 5;
+    uint64_t snapshot_size = 0;
+    if (!get_varint(data, size, pos, snapshot_size) || snapshot_size != sizeof(GameSnapshot)) {
+        std::cerr << "Save state is from a build with a different state layout" << std::endl;
+        return false;
+    }
+    GameSnapshot decoded = zero_snapshot;
+    if (!apply_snapshot_delta(decoded, data + pos, size - pos)) {
+        std::cerr << "Corrupt save state" << std::endl;
+        return false;
+    }
+    *this = decoded;
+    return true;
+}
+
+bool GameSnapshot::save(const std::string& path) const {
+    const std::vector<uint8_t> bytes = encode();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        std::cerr << "Failed to write save state: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GameSnapshot::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open save state: " << path << std::endl;
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!decode(bytes.data(), bytes.size())) {
+        std::cerr << "Failed to load save state: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+enum class FieldKind { Signed, Unsigned, Bytes };
+
+struct SnapshotField {
+    const char* name;
+    size_t offset;
+    size_t size;
+    FieldKind kind;
+};
+
+#define SNAPSHOT_FIELD(type, field, kind) {#field, offsetof(type, field), sizeof(type::field), FieldKind::kind}
+
+const SnapshotField game_fields[] = {
+    SNAPSHOT_FIELD(GameSnapshot, level_solidity_bits, Bytes),
+    SNAPSHOT_FIELD(GameSnapshot, level_solidity_last_passable, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, current_level_index, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, solidity_level_index, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, stage_map_level, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, stage_map_stage, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, streamed_stage, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, map_origin_x, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, checkpoint_map_origin_x, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_x, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_y, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, camera_x, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_run_cycle_frame, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, run_frame_count, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_y_vel, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_x_momentum, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_facing, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_is_falling_or_jumping, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_jump_counter, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_jump_power, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_state_jump, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, previous_key_state_jump, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_state_left, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_state_right, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_state_open, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, previous_key_state_open, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_state_fire, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_state_teleport, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, previous_key_state_teleport, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, key_states_cleared, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_has_door_key, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_num_lives, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, lives_sequence_counter, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, lives_sequence_delay, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, lives_sequence_complete, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_hp, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_hp_pending_increase, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, score_bytes, Bytes),
+    SNAPSHOT_FIELD(GameSnapshot, score_10000_counter, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, game_over_triggered, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, current_level_number, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, current_stage_number, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, source_door_level_number, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, source_door_stage_number, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, comic_y_checkpoint, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_x_checkpoint, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, first_stage_loaded, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, cheat_noclip, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, ceiling_stick_flag, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_is_dying, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_death_too_bad_phase, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_death_show_animation, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_death_fall_clip_render, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_death_ticks_remaining, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_anim_phase, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_anim_frame, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_exit_delay_ticks, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_anim_world_x, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_anim_world_y, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_pending_level, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, door_pending_stage, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, comic_is_teleporting, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_animation, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_source_x, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_source_y, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_destination_x, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_destination_y, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_camera_counter, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_camera_vel, Signed),
+    SNAPSHOT_FIELD(GameSnapshot, teleport_skip_tick, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_moved_last_tick, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, player_airborne_from_walk_off, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, suppress_jump_animation, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, beam_out_sequence_played, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, win_counter, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, enemy_level_number, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, enemy_stage_number, Unsigned),
+    SNAPSHOT_FIELD(GameSnapshot, scratch_tiles, Bytes),
+};
+
+const SnapshotField actor_fields[] = {
+    SNAPSHOT_FIELD(ActorSnapshot, items_collected, Bytes),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_firepower, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_corkscrew, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, fireball_meter, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, fireball_meter_counter, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_boots, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_lantern, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_door_key, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_teleport_wand, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_gems, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_crown, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_has_gold, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, comic_num_treasures, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, item_animation_counter, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, current_item_type, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, current_item_x, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, current_item_y, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, tileset_last_passable, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, current_level_index, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, current_stage_index, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, spawned_this_tick, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, spawn_offset_cycle, Unsigned),
+    SNAPSHOT_FIELD(ActorSnapshot, enemy_respawn_counter_cycle, Unsigned),
+};
+
+const SnapshotField enemy_fields[] = {
+    SNAPSHOT_FIELD(enemy_snapshot_t, y, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, x, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, x_vel, Signed),
+    SNAPSHOT_FIELD(enemy_snapshot_t, y_vel, Signed),
+    SNAPSHOT_FIELD(enemy_snapshot_t, spawn_timer_and_animation, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, num_animation_frames, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, behavior, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, state, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, facing, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, restraint, Unsigned),
+    SNAPSHOT_FIELD(enemy_snapshot_t, shp_index, Unsigned),
+};
+
+const SnapshotField fireball_fields[] = {
+    SNAPSHOT_FIELD(fireball_t, y, Unsigned),
+    SNAPSHOT_FIELD(fireball_t, x, Unsigned),
+    SNAPSHOT_FIELD(fireball_t, vel, Signed),
+    SNAPSHOT_FIELD(fireball_t, corkscrew_phase, Unsigned),
+    SNAPSHOT_FIELD(fireball_t, animation, Unsigned),
+    SNAPSHOT_FIELD(fireball_t, num_animation_frames, Unsigned),
+};
+
+#undef SNAPSHOT_FIELD
+
+std::string field_value(const uint8_t* bytes, const SnapshotField& field) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes + field.offset, field.size);
+    if (field.kind == FieldKind::Signed) {
+        const int shift = static_cast<int>(64 - 8 * field.size);
+        return std::to_string(static_cast<int64_t>(value << shift) >> shift);
+    }
+    return std::to_string(value);
+}
+
+template <size_t N>
+void describe_fields(const std::string& prefix, const SnapshotField (&fields)[N],
+                     const uint8_t* a, const uint8_t* b, std::vector<std::string>& out) {
+    for (const SnapshotField& field : fields) {
+        if (std::memcmp(a + field.offset, b + field.offset, field.size) == 0) {
+            continue;
+        }
+        std::ostringstream line;
+        line << prefix << field.name << ": ";
+        if (field.kind == FieldKind::Bytes) {
+            size_t differing = 0;
+            for (size_t i = 0; i < field.size; ++i) {
+                differing += a[field.offset + i] != b[field.offset + i] ? 1 : 0;
+            }
+            line << differing << " of " << field.size << " byte(s) differ";
+        } else {
+            line << field_value(a, field) << " -> " << field_value(b, field);
+        }
+        out.push_back(line.str());
+    }
+}
+
+} // namespace
+
+std::vector<std::string> describe_snapshot_differences(const GameSnapshot& a, const GameSnapshot& b) {
+    std::vector<std::string> out;
+    describe_fields("", game_fields, snapshot_bytes(a), snapshot_bytes(b), out);
+    const uint8_t* actors_a = reinterpret_cast<const uint8_t*>(&a.actors);
+    const uint8_t* actors_b = reinterpret_cast<const uint8_t*>(&b.actors);
+    for (int i = 0; i < MAX_NUM_ENEMIES; ++i) {
+        describe_fields("enemies[" + std::to_string(i) + "].", enemy_fields,
+                        reinterpret_cast<const uint8_t*>(&a.actors.enemies[i]),
+                        reinterpret_cast<const uint8_t*>(&b.actors.enemies[i]), out);
+    }
+    for (int i = 0; i < MAX_NUM_FIREBALLS; ++i) {
+        describe_fields("fireballs[" + std::to_string(i) + "].", fireball_fields,
+                        reinterpret_cast<const uint8_t*>(&a.actors.fireballs[i]),
+                        reinterpret_cast<const uint8_t*>(&b.actors.fireballs[i]), out);
+    }
+    describe_fields("actors.", actor_fields, actors_a, actors_b, out);
+    return out;
+}
+
+SnapshotRing::SnapshotRing(size_t max_ticks, size_t max_bytes, uint32_t keyframe_interval)
+    : arena(std::max(max_bytes, SNAPSHOT_MAX_ENCODED_SIZE)),
+      entries(std::max<size_t>(max_ticks, 1)),
+      keyframe_interval(std::max<uint32_t>(keyframe_interval, 1)),
+      first_entry(0), count(0), first_tick(0), write_offset(0),
+      ticks_since_keyframe(0), used_bytes(0), newest(zero_snapshot),
+      scratch(SNAPSHOT_MAX_ENCODED_SIZE) {}
+
+void SnapshotRing::clear() {
+    first_entry = 0;
+    count = 0;
+    first_tick = 0;
+    write_offset = 0;
+    ticks_since_keyframe = 0;
+    used_bytes = 0;
+}
+
+// Drop the oldest tick, and the deltas after it that no longer have a keyframe
+void SnapshotRing::drop_oldest() {
+    do {
+        used_bytes -= entry_at(0).size;
+        first_entry = (first_entry + 1) % entries.size();
+        ++first_tick;
+        --count;
+    } while (count > 0 && !entry_at(0).keyframe);
+    if (count == 0) {
+        clear();
+    }
+}
+
+void SnapshotRing::push(uint64_t tick, const GameSnapshot& snapshot) {
+    if (count > 0 && tick != newest_tick() + 1) {
+        clear();
+    }
+    bool keyframe = count == 0 || ticks_since_keyframe + 1 >= keyframe_interval;
+    size_t size = encode_snapshot_delta(keyframe ? zero_snapshot : newest, snapshot, scratch.data());
+
+    if (count == entries.size()) {
+        drop_oldest();
+    }
+    if (write_offset + size > arena.size()) {
+        // Wrap; what lies past the newest entry is the oldest
+        while (count > 0 && entry_at(0).offset >= write_offset) {
+            drop_oldest();
+        }
+        write_offset = 0;
+    }
+    while (count > 0 && entry_at(0).offset >= write_offset && entry_at(0).offset < write_offset + size) {
+        drop_oldest();
+    }
+    if (count == 0 && !keyframe) {
+        // The delta's base was dropped with the rest
+        keyframe = true;
+        size = encode_snapshot_delta(zero_snapshot, snapshot, scratch.data());
+    }
+
+    if (count == 0) {
+        first_tick = tick;
+    }
+    std::memcpy(arena.data() + write_offset, scratch.data(), size);
+    Entry& entry = entries[(first_entry + count) % entries.size()];
+    entry.offset = static_cast<uint32_t>(write_offset);
+    entry.size = static_cast<uint16_t>(size);
+    entry.keyframe = keyframe;
+    ++count;
+    write_offset += size;
+    used_bytes += size;
+    ticks_since_keyframe = keyframe ? 0 : ticks_since_keyframe + 1;
+    newest = snapshot;
+}
+
+bool SnapshotRing::get(uint64_t tick, GameSnapshot& snapshot) const {
+    if (!contains(tick)) {
+        return false;
+    }
+    const size_t index = static_cast<size_t>(tick - first_tick);
+    if (index == count - 1) {
+        snapshot = newest;
+        return true;
+    }
+    size_t keyframe = index;
+    while (!entry_at(keyframe).keyframe) {
+        --keyframe;
+    }
+    snapshot = zero_snapshot;
+    for (size_t i = keyframe; i <= index; ++i) {
+        const Entry& entry = entry_at(i);
+        if (!apply_snapshot_delta(snapshot, arena.data() + entry.offset, entry.size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SnapshotRing::truncate_after(uint64_t tick) {
+    if (count == 0 || tick >= newest_tick()) {
+        return;
+    }
+    if (tick < first_tick) {
+        clear();
+        return;
+    }
+    get(tick, newest);
+    const size_t new_count = static_cast<size_t>(tick - first_tick) + 1;
+    for (size_t i = new_count; i < count; ++i) {
+        used_bytes -= entry_at(i).size;
+    }
+    count = new_count;
+    const Entry& last = entry_at(count - 1);
+    write_offset = last.offset + last.size;
+    ticks_since_keyframe = 0;
+    for (size_t i = count - 1; !entry_at(i).keyframe; --i) {
+        ++ticks_since_keyframe;
+    }
+}
+
+bool SnapshotRing::find_first_difference(const SnapshotRing& a, const SnapshotRing& b, uint64_t* tick) {
+    if (a.empty() || b.empty()) {
+        return false;
+    }
+    uint64_t low = std::max(a.oldest_tick(), b.oldest_tick());
+    uint64_t high = std::min(a.newest_tick(), b.newest_tick());
+    if (low > high) {
+        return false;
+    }
+    GameSnapshot snapshot_a;
+    GameSnapshot snapshot_b;
+    auto differs = [&](uint64_t t) {
+        return !a.get(t, snapshot_a) || !b.get(t, snapshot_b) || snapshot_a != snapshot_b;
+    };
+    if (!differs(high)) {
+        return false;
+    }
+    if (differs(low)) {
+        *tick = low;
+        return true;
+    }
+    // low agrees, high differs
+    while (high - low > 1) {
+        const uint64_t middle = low + (high - low) / 2;
+        if (differs(middle)) {
+            high = middle;
+        } else {
+            low = middle;
+        }
+    }
+    *tick = high;
+    return true;
+}
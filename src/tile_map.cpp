@@ -0,0 +1,191 @@
+/**
+ * tile_map.cpp - Chunked, run-length compressed map files read chunk by chunk
+ */
+
+#include "../include/tile_map.h"
+#include "../include/counters.h"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+static const char TILE_MAP_MAGIC[4] = {'C', 'C', 'T', 'M'};
+
+// Worst case for a chunk's runs: every tile differs from the one before
+constexpr size_t TILE_MAP_MAX_CHUNK_BYTES = 2 * TILE_MAP_CHUNK_TILES;
+
+static uint16_t read_u16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static void put_u16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void put_u32(std::vector<uint8_t>& out, uint32_t value) {
+    put_u16(out, static_cast<uint16_t>(value));
+    put_u16(out, static_cast<uint16_t>(value >> 16));
+}
+
+TileMap::TileMap() : file(nullptr), width_tiles(0), chunk_count(0) {}
+
+TileMap::~TileMap() {
+    close();
+}
+
+bool TileMap::open(const std::string& path) {
+    close();
+    std::FILE* handle = std::fopen(path.c_str(), "rb");
+    if (handle == nullptr) {
+        return false;
+    }
+
+    uint8_t header[TILE_MAP_HEADER_SIZE];
+    if (std::fread(header, 1, sizeof(header), handle) != sizeof(header) ||
+        std::memcmp(header, TILE_MAP_MAGIC, sizeof(TILE_MAP_MAGIC)) != 0) {
+        std::cerr << "Not a tile map: " << path << std::endl;
+        std::fclose(handle);
+        return false;
+    }
+    const uint32_t version = read_u32(header + 4);
+    if (version != TILE_MAP_VERSION) {
+        std::cerr << "Unsupported tile map version " << version << ": " << path << std::endl;
+        std::fclose(handle);
+        return false;
+    }
+
+    const uint32_t width = read_u32(header + 8);
+    const uint16_t height = read_u16(header + 12);
+    const uint16_t chunk_width = read_u16(header + 14);
+    const uint32_t chunks = read_u32(header + 16);
+    if (height != MAP_HEIGHT_TILES || chunk_width != TILE_MAP_CHUNK_WIDTH ||
+        width % TILE_MAP_CHUNK_WIDTH != 0 || width < static_cast<uint32_t>(MAP_WIDTH_TILES) ||
+        width > 0x7FFFFFFFu || chunks != width / TILE_MAP_CHUNK_WIDTH) {
+        std::cerr << "Tile map " << path << " is " << width << "x" << height << " in chunks of "
+                  << chunk_width << "; expected a multiple of " << TILE_MAP_CHUNK_WIDTH << " by "
+                  << MAP_HEIGHT_TILES << std::endl;
+        std::fclose(handle);
+        return false;
+    }
+
+    file = handle;
+    width_tiles = static_cast<MapCoord>(width);
+    chunk_count = static_cast<MapCoord>(chunks);
+    return true;
+}
+
+void TileMap::close() {
+    if (file != nullptr) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    width_tiles = 0;
+    chunk_count = 0;
+}
+
+bool TileMap::read_chunk(MapCoord index, uint8_t* out, int stride) const {
+    for (int row = 0; row < MAP_HEIGHT_TILES; ++row) {
+        std::memset(out + row * stride, 0, TILE_MAP_CHUNK_WIDTH);
+    }
+    if (file == nullptr || index < 0 || index >= chunk_count) {
+        return false;
+    }
+
+    uint8_t packed[TILE_MAP_MAX_CHUNK_BYTES];
+    uint32_t packed_size = 0;
+    {
+        std::lock_guard<std::mutex> lock(file_mutex);
+        uint8_t entry[TILE_MAP_CHUNK_ENTRY_SIZE];
+        const long entry_offset = static_cast<long>(TILE_MAP_HEADER_SIZE + index * TILE_MAP_CHUNK_ENTRY_SIZE);
+        if (std::fseek(file, entry_offset, SEEK_SET) != 0 || std::fread(entry, 1, sizeof(entry), file) != sizeof(entry)) {
+            return false;
+        }
+        packed_size = read_u32(entry + 4);
+        if (packed_size > sizeof(packed) ||
+            std::fseek(file, static_cast<long>(read_u32(entry)), SEEK_SET) != 0 ||
+            std::fread(packed, 1, packed_size, file) != packed_size) {
+            return false;
+        }
+    }
+    count_event(Counter::MAP_CHUNKS_READ);
+
+    int written = 0;
+    for (uint32_t i = 0; i + 1 < packed_size; i += 2) {
+        const int count = packed[i];
+        if (count == 0 || written + count > TILE_MAP_CHUNK_TILES) {
+            return false;
+        }
+        for (int end = written + count; written < end; ++written) {
+            out[(written / TILE_MAP_CHUNK_WIDTH) * stride + written % TILE_MAP_CHUNK_WIDTH] = packed[i + 1];
+        }
+    }
+    return written == TILE_MAP_CHUNK_TILES;
+}
+
+bool TileMap::read_window(MapCoord first_tile_x, uint8_t* out) const {
+    const MapCoord first_chunk = first_tile_x / TILE_MAP_CHUNK_WIDTH;
+    bool complete = first_tile_x % TILE_MAP_CHUNK_WIDTH == 0;
+    for (int i = 0; i < TILE_MAP_WINDOW_CHUNKS; ++i) {
+        complete = read_chunk(first_chunk + i, out + i * TILE_MAP_CHUNK_WIDTH, MAP_WIDTH_TILES) && complete;
+    }
+    return complete;
+}
+
+bool write_tile_map(const std::string& path, const uint8_t* tiles, MapCoord width_tiles) {
+    if (width_tiles < MAP_WIDTH_TILES || width_tiles % TILE_MAP_CHUNK_WIDTH != 0) {
+        std::cerr << "Tile map width " << width_tiles << " is not a whole number of " << TILE_MAP_CHUNK_WIDTH
+                  << "-tile chunks" << std::endl;
+        return false;
+    }
+    const uint32_t chunks = static_cast<uint32_t>(width_tiles / TILE_MAP_CHUNK_WIDTH);
+
+    std::vector<uint8_t> table;
+    std::vector<uint8_t> data;
+    const uint32_t data_start = static_cast<uint32_t>(TILE_MAP_HEADER_SIZE + chunks * TILE_MAP_CHUNK_ENTRY_SIZE);
+    for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t chunk_start = data.size();
+        const uint8_t* column = tiles + static_cast<size_t>(chunk) * TILE_MAP_CHUNK_WIDTH;
+        int run = 0;
+        uint8_t run_tile = 0;
+        for (int i = 0; i < TILE_MAP_CHUNK_TILES; ++i) {
+            const uint8_t tile = column[static_cast<size_t>(i / TILE_MAP_CHUNK_WIDTH) * width_tiles +
+                                        i % TILE_MAP_CHUNK_WIDTH];
+            if (run > 0 && (tile != run_tile || run == 255)) {
+                data.push_back(static_cast<uint8_t>(run));
+                data.push_back(run_tile);
+                run = 0;
+            }
+            run_tile = tile;
+            ++run;
+        }
+        data.push_back(static_cast<uint8_t>(run));
+        data.push_back(run_tile);
+        put_u32(table, data_start + static_cast<uint32_t>(chunk_start));
+        put_u32(table, static_cast<uint32_t>(data.size() - chunk_start));
+    }
+
+    std::vector<uint8_t> header(TILE_MAP_MAGIC, TILE_MAP_MAGIC + sizeof(TILE_MAP_MAGIC));
+    put_u32(header, TILE_MAP_VERSION);
+    put_u32(header, static_cast<uint32_t>(width_tiles));
+    put_u16(header, MAP_HEIGHT_TILES);
+    put_u16(header, TILE_MAP_CHUNK_WIDTH);
+    put_u32(header, chunks);
+    put_u32(header, 0);
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        std::cerr << "Failed to write tile map: " << path << std::endl;
+        return false;
+    }
+    const bool written = std::fwrite(header.data(), 1, header.size(), out) == header.size() &&
+                         std::fwrite(table.data(), 1, table.size(), out) == table.size() &&
+                         std::fwrite(data.data(), 1, data.size(), out) == data.size();
+    return std::fclose(out) == 0 && written;
+}
@@ -1,12 +1,19 @@
 #include "../include/title_sequence.h"
+#include "../include/glyph_atlas.h"
 #include "../include/graphics.h"
 #include "../include/audio.h"
+#include "../include/fixed_vector.h"
+#include "../include/frame_arena.h"
+#include "../include/sequencer.h"
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <algorithm>
+#include <array>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -56,28 +63,22 @@ static constexpr const char* KEY_BINDINGS_MAGIC = "CCKB1";
 static constexpr const char* PREF_PATH_ORG = "jsandas";
 static constexpr const char* PREF_PATH_APP = "comic-modernization";
 
-// Paletted surfaces for title sequence screens (kept as-is, not converted to RGBA)
-static SDL_Surface* s_title_surface = nullptr;
-static SDL_Surface* s_story_surface = nullptr;
-static SDL_Surface* s_items_surface = nullptr;
-
 // ---------------------------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------------------------
 
 /**
- * Load a fullscreen EGA image (320x200 PNG) as a paletted SDL_Surface.
+ * Take a fullscreen EGA image (320x200 PNG) requested with
+ * request_asset_surface as a paletted SDL_Surface, waiting for its decode.
  * Preserves the indexed color palette from the original PNG file.
  * Returns nullptr on failure.
  */
-static SDL_Surface* load_fullscreen_paletted_surface(GraphicsSystem* graphics,
+static SDL_Surface* take_fullscreen_paletted_surface(GraphicsSystem* graphics, DecodeTicket& ticket,
                                                       const char* filename) {
-    std::string path = graphics->get_asset_path(filename);
-
-    SDL_Surface* surface = IMG_Load(path.c_str());
+    SDL_Surface* surface = graphics->wait_asset_surface(ticket);
     if (!surface) {
-        std::cerr << "Title sequence: failed to load " << filename
-                  << " (" << IMG_GetError() << ")" << std::endl;
+        // The decode ran on a worker, so there is no SDL error to show here
+        std::cerr << "Title sequence: failed to load " << filename << std::endl;
         return nullptr;
     }
 
@@ -117,8 +118,28 @@ static SDL_Texture* surface_to_texture(SDL_Renderer* renderer,
 
 // Note: Letterbox rect calculation now centralized in GraphicsSystem::compute_letterbox_rect()
 
+// Palette entry indices faded by the original (background, items, title)
+constexpr uint8_t PALETTE_REG_BACKGROUND = 2;
+constexpr uint8_t PALETTE_REG_ITEMS = 10;
+constexpr uint8_t PALETTE_REG_TITLE = 12;
+static const uint8_t FADE_REGISTERS[FADE_REGISTER_COUNT] = {
+    PALETTE_REG_BACKGROUND, PALETTE_REG_ITEMS, PALETTE_REG_TITLE
+};
+
+// Colors of the fading registers, in FADE_REGISTERS order
+using FadeColors = std::array<SDL_Color, FADE_REGISTER_COUNT>;
+
+// A paletted screen split for fading: the picture without the fading
+// registers, and a white mask of each register's pixels. Drawing the masks
+// over the base with color modulation recolors a register without touching
+// a pixel.
+struct FadeLayers {
+    SDL_Texture* base = nullptr;
+    std::array<SDL_Texture*, FADE_REGISTER_COUNT> masks = {};
+};
+
 /**
- * Display a paletted surface with the palette fade-in sequence from the original.
+ * Register colors for each step of the palette fade-in from the original.
  *
  * Replicates palette_fade_in() from the DOS code with six rendered steps:
  *   Step 1: All three entries (2,10,12) → dark gray (0x18)
@@ -126,44 +147,11 @@ static SDL_Texture* surface_to_texture(SDL_Renderer* renderer,
  *   Step 3: Background stays gray, items/title → white (0x1f)
  *   Step 4: Background→green (0x02), items→bright green (0x1a), title stays white
  *   Step 5: Title → bright red (0x1c), background/items restored
- *   Step 6: Restore all three entries to original colors and render final frame
- *
- * Each rendered step waits ~55ms (original: wait_n_ticks(1)).
+ *   Step 6: Restore all three entries to original colors
  *
- * Returns false ONLY if SDL_QUIT was received. Format/palette errors are treated
- * as non-fatal (logs warning, skips fade effect, returns true to continue).
+ * Each step is shown for ~55ms (original: wait_n_ticks(1)).
  */
-static bool fade_in_paletted_surface(SDL_Renderer* renderer, SDL_Surface* surface,
-                                     const char* filename) {
-    if (!surface || !surface->format || !surface->format->palette) {
-        std::cerr << "Warning: " << filename << ": surface is not paletted, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
-    }
-
-    SDL_Palette* pal = surface->format->palette;
-    SDL_Rect dst = GraphicsSystem::compute_letterbox_rect(renderer);
-
-    // Palette entry indices (from original DOS code)
-    constexpr int PALETTE_REG_BACKGROUND = 2;
-    constexpr int PALETTE_REG_ITEMS = 10;
-    constexpr int PALETTE_REG_TITLE = 12;
-
-    constexpr int REQUIRED_PALETTE_SIZE = PALETTE_REG_TITLE + 1;
-    if (pal->ncolors < REQUIRED_PALETTE_SIZE) {
-        std::cerr << "Warning: " << filename
-                  << ": palette has only " << pal->ncolors
-                  << " colors (need at least " << REQUIRED_PALETTE_SIZE
-                  << "), skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
-    }
-
-    // Store original palette colors for restoration.
-    SDL_Color orig_colors[3] = {
-        surface->format->palette->colors[PALETTE_REG_BACKGROUND],
-        surface->format->palette->colors[PALETTE_REG_ITEMS],
-        surface->format->palette->colors[PALETTE_REG_TITLE]
-    };
-
+static std::vector<FadeColors> get_fade_in_steps(const FadeColors& orig_colors) {
     // Helper: Convert 6-bit EGA color to 8-bit RGB
     auto ega_to_rgb = [](uint8_t ega_6bit) -> uint8_t {
         return (ega_6bit << 2) | (ega_6bit >> 4);
@@ -180,246 +168,249 @@ static bool fade_in_paletted_surface(SDL_Renderer* renderer, SDL_Surface* surfac
     const uint8_t dark_gray = ega_to_rgb(DARK_GRAY_6BIT);
     const uint8_t light_gray = ega_to_rgb(LIGHT_GRAY_6BIT);
     const uint8_t white = ega_to_rgb(WHITE_6BIT);
-    const uint8_t green = ega_to_rgb(GREEN_6BIT);
-    const uint8_t bright_green = ega_to_rgb(BRIGHT_GREEN_6BIT);
-    const uint8_t bright_red = ega_to_rgb(BRIGHT_RED_6BIT);
-
-    SDL_Event e;
-    // Step 1: All three to dark gray
-    if (PALETTE_REG_BACKGROUND < pal->ncolors) {
-        pal->colors[PALETTE_REG_BACKGROUND] = {dark_gray, dark_gray, dark_gray, 255};
-    }
-    if (PALETTE_REG_ITEMS < pal->ncolors) {
-        pal->colors[PALETTE_REG_ITEMS] = {dark_gray, dark_gray, dark_gray, 255};
-    }
-    if (PALETTE_REG_TITLE < pal->ncolors) {
-        pal->colors[PALETTE_REG_TITLE] = {dark_gray, dark_gray, dark_gray, 255};
-    }
-
-    SDL_Texture* tex = surface_to_texture(renderer, surface);
-    if (!tex) {
-        std::cerr << "Warning: " << filename << ": texture creation failed at step 1, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
-    }
-
-    // Render step 1
-    {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(tex);
-    }
-
-    // Process events during wait
-    auto wait_with_events = [&](int ms) -> bool {
-        uint32_t start = SDL_GetTicks();
-        while (SDL_GetTicks() - start < static_cast<uint32_t>(ms)) {
-            while (SDL_PollEvent(&e)) {
-                if (e.type == SDL_QUIT) return false;
-            }
-            SDL_Delay(16);
-        }
-        return true;
+    const SDL_Color dark_gray_color = {dark_gray, dark_gray, dark_gray, 255};
+    const SDL_Color light_gray_color = {light_gray, light_gray, light_gray, 255};
+    const SDL_Color white_color = {white, white, white, 255};
+    const SDL_Color green_color = {0, ega_to_rgb(GREEN_6BIT), 0, 255};
+    const SDL_Color bright_green_color = {0, ega_to_rgb(BRIGHT_GREEN_6BIT), 0, 255};
+    const SDL_Color bright_red_color = {ega_to_rgb(BRIGHT_RED_6BIT), 0, 0, 255};
+
+    return {
+        {dark_gray_color, dark_gray_color, dark_gray_color},
+        {light_gray_color, light_gray_color, light_gray_color},
+        {light_gray_color, white_color, white_color},
+        {green_color, bright_green_color, white_color},
+        {orig_colors[0], orig_colors[1], bright_red_color},
+        orig_colors
     };
+}
 
-    // Wait after step 1
-    if (!wait_with_events(FADE_STEP_DELAY_MS)) return false;
-
-    // Step 2: All three to light gray
-    if (PALETTE_REG_BACKGROUND < pal->ncolors) {
-        pal->colors[PALETTE_REG_BACKGROUND] = {light_gray, light_gray, light_gray, 255};
-    }
-    if (PALETTE_REG_ITEMS < pal->ncolors) {
-        pal->colors[PALETTE_REG_ITEMS] = {light_gray, light_gray, light_gray, 255};
-    }
-    if (PALETTE_REG_TITLE < pal->ncolors) {
-        pal->colors[PALETTE_REG_TITLE] = {light_gray, light_gray, light_gray, 255};
-    }
-
-    tex = surface_to_texture(renderer, surface);
-    if (!tex) {
-        std::cerr << "Warning: " << filename << ": texture creation failed at step 2, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
-    }
-
-    {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(tex);
-    }
-
-    if (!wait_with_events(FADE_STEP_DELAY_MS)) return false;
-
-    // Step 3: Background stays light gray, items and title go white
-    if (PALETTE_REG_BACKGROUND < pal->ncolors) {
-        pal->colors[PALETTE_REG_BACKGROUND] = {light_gray, light_gray, light_gray, 255};
-    }
-    if (PALETTE_REG_ITEMS < pal->ncolors) {
-        pal->colors[PALETTE_REG_ITEMS] = {white, white, white, 255};
-    }
-    if (PALETTE_REG_TITLE < pal->ncolors) {
-        pal->colors[PALETTE_REG_TITLE] = {white, white, white, 255};
-    }
-
-    tex = surface_to_texture(renderer, surface);
-    if (!tex) {
-        std::cerr << "Warning: " << filename << ": texture creation failed at step 3, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
-    }
-
-    {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(tex);
-    }
-
-    if (!wait_with_events(FADE_STEP_DELAY_MS)) return false;
-
-    // Step 4: Background → green, items → bright green, title stays white
-    if (PALETTE_REG_BACKGROUND < pal->ncolors) {
-        pal->colors[PALETTE_REG_BACKGROUND] = {0, green, 0, 255};
-    }
-    if (PALETTE_REG_ITEMS < pal->ncolors) {
-        pal->colors[PALETTE_REG_ITEMS] = {0, bright_green, 0, 255};
-    }
-    if (PALETTE_REG_TITLE < pal->ncolors) {
-        pal->colors[PALETTE_REG_TITLE] = {white, white, white, 255};
-    }
-
-    tex = surface_to_texture(renderer, surface);
-    if (!tex) {
-        std::cerr << "Warning: " << filename << ": texture creation failed at step 4, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
-    }
-
-    {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(tex);
-    }
-
-    if (!wait_with_events(FADE_STEP_DELAY_MS)) return false;
-
-    // Step 5: Title goes bright red, restore to original colors
-    if (PALETTE_REG_BACKGROUND < pal->ncolors) {
-        pal->colors[PALETTE_REG_BACKGROUND] = orig_colors[0];
-    }
-    if (PALETTE_REG_ITEMS < pal->ncolors) {
-        pal->colors[PALETTE_REG_ITEMS] = orig_colors[1];
-    }
-    if (PALETTE_REG_TITLE < pal->ncolors) {
-        pal->colors[PALETTE_REG_TITLE] = {bright_red, 0, 0, 255};
+/**
+ * Create a static texture from RGBA32 pixels, alpha blended.
+ */
+static SDL_Texture* create_layer_texture(SDL_Renderer* renderer, int width, int height,
+                                         const std::vector<uint8_t>& rgba) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                             SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!texture) {
+        return nullptr;
     }
-
-    tex = surface_to_texture(renderer, surface);
-    if (!tex) {
-        std::cerr << "Warning: " << filename << ": texture creation failed at step 5, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
+    if (SDL_UpdateTexture(texture, nullptr, rgba.data(), width * 4) != 0) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
     }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
 
-    {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(tex);
+/**
+ * Split a paletted surface into fade layers, uploaded once. The original
+ * register colors are returned in orig_colors.
+ *
+ * Returns false if the surface cannot be faded. Format/palette errors are
+ * treated as non-fatal (logs warning, the screen is shown without the fade).
+ */
+static bool build_fade_layers(SDL_Renderer* renderer, SDL_Surface* surface, const char* filename,
+                              FadeLayers* layers, FadeColors* orig_colors) {
+    if (!surface || !surface->format || !surface->format->palette ||
+        surface->format->BytesPerPixel != 1) {
+        std::cerr << "Warning: " << filename << ": surface is not paletted, skipping fade effect" << std::endl;
+        return false;
     }
 
-    if (!wait_with_events(FADE_STEP_DELAY_MS)) return false;
-
-    // Step 6: Restore all to original colors
-    if (PALETTE_REG_BACKGROUND < pal->ncolors) {
-        pal->colors[PALETTE_REG_BACKGROUND] = orig_colors[0];
-    }
-    if (PALETTE_REG_ITEMS < pal->ncolors) {
-        pal->colors[PALETTE_REG_ITEMS] = orig_colors[1];
+    const SDL_Palette* pal = surface->format->palette;
+    constexpr int REQUIRED_PALETTE_SIZE = PALETTE_REG_TITLE + 1;
+    if (pal->ncolors < REQUIRED_PALETTE_SIZE) {
+        std::cerr << "Warning: " << filename
+                  << ": palette has only " << pal->ncolors
+                  << " colors (need at least " << REQUIRED_PALETTE_SIZE
+                  << "), skipping fade effect" << std::endl;
+        return false;
     }
-    if (PALETTE_REG_TITLE < pal->ncolors) {
-        pal->colors[PALETTE_REG_TITLE] = orig_colors[2];
+    for (int i = 0; i < FADE_REGISTER_COUNT; ++i) {
+        (*orig_colors)[i] = pal->colors[FADE_REGISTERS[i]];
     }
 
-    tex = surface_to_texture(renderer, surface);
-    if (!tex) {
-        std::cerr << "Warning: " << filename << ": texture creation failed at step 6, skipping fade effect" << std::endl;
-        return true;  // Non-fatal: skip fade, continue sequence
+    PaletteFadeLayers pixels;
+    if (SDL_LockSurface(surface) != 0) {
+        std::cerr << "Warning: " << filename << ": could not lock surface, skipping fade effect" << std::endl;
+        return false;
     }
-
-    {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(tex);
+    split_palette_fade_layers(static_cast<const uint8_t*>(surface->pixels), surface->w, surface->h,
+                              surface->pitch, pal->colors, pal->ncolors, FADE_REGISTERS, &pixels);
+    SDL_UnlockSurface(surface);
+
+    layers->base = create_layer_texture(renderer, surface->w, surface->h, pixels.base);
+    bool created = layers->base != nullptr;
+    for (int i = 0; i < FADE_REGISTER_COUNT; ++i) {
+        layers->masks[i] = create_layer_texture(renderer, surface->w, surface->h, pixels.masks[i]);
+        created = created && layers->masks[i] != nullptr;
+    }
+    if (!created) {
+        std::cerr << "Warning: " << filename << ": fade layer creation failed ("
+                  << SDL_GetError() << "), skipping fade effect" << std::endl;
+        SDL_DestroyTexture(layers->base);
+        for (SDL_Texture* mask : layers->masks) {
+            SDL_DestroyTexture(mask);
+        }
+        *layers = FadeLayers();
+        return false;
     }
-
     return true;
 }
 
 /**
- * Display a texture (no fade) and render one frame.
+ * Draw fade layers letterboxed over a black screen with the fading registers
+ * in colors (presenting is up to the caller).
  */
-static void show_texture(SDL_Renderer* renderer, SDL_Texture* texture) {
+static void draw_fade_layers(SDL_Renderer* renderer, const FadeLayers& layers, const FadeColors& colors) {
     SDL_Rect dst = GraphicsSystem::compute_letterbox_rect(renderer);
 
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-    SDL_RenderPresent(renderer);
+    SDL_RenderCopy(renderer, layers.base, nullptr, &dst);
+    for (int i = 0; i < FADE_REGISTER_COUNT; ++i) {
+        SDL_SetTextureColorMod(layers.masks[i], colors[i].r, colors[i].g, colors[i].b);
+        SDL_RenderCopy(renderer, layers.masks[i], nullptr, &dst);
+    }
 }
 
 /**
- * Wait for a fixed number of milliseconds while processing events.
- * Returns false if SDL_QUIT received.
+ * Draw a texture letterboxed over a black screen (presenting is up to the caller).
  */
-static bool wait_ms(int duration_ms) {
-    uint32_t start = SDL_GetTicks();
-    SDL_Event e;
-    while (SDL_GetTicks() - start < static_cast<uint32_t>(duration_ms)) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) return false;
+static void draw_fullscreen_texture(SDL_Renderer* renderer, SDL_Texture* texture) {
+    SDL_Rect dst = GraphicsSystem::compute_letterbox_rect(renderer);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    if (texture) {
+        SDL_RenderCopy(renderer, texture, nullptr, &dst);
+    }
+}
+
+// Textures drawn by a queued title sequence. Every step holds a reference, so
+// they are destroyed once the sequence is over (or cleared).
+struct TitleSequenceTextures {
+    std::vector<SDL_Texture*> textures;
+
+    ~TitleSequenceTextures() {
+        for (SDL_Texture* texture : textures) {
+            SDL_DestroyTexture(texture);
         }
-        SDL_Delay(16);
     }
-    return true;
+
+    SDL_Texture* add(SDL_Texture* texture) {
+        if (texture) {
+            textures.push_back(texture);
+        }
+        return texture;
+    }
+};
+
+/**
+ * Queue a step that shows texture from here on.
+ */
+static void show_screen(Sequencer& sequencer, SDL_Renderer* renderer,
+                        const std::shared_ptr<TitleSequenceTextures>& owner, SDL_Texture* texture) {
+    sequencer.show([renderer, owner, texture]() {
+        draw_fullscreen_texture(renderer, texture);
+    });
 }
 
 /**
- * Wait until any key is pressed (blocking).
- * Returns false if SDL_QUIT received.
+ * Load a fullscreen screen from its requested decode and queue showing it,
+ * after its fade-in if fade is set and the fade can be built. Returns the
+ * screen's texture, or nullptr (and queues nothing) if it could not be loaded.
  */
-static bool wait_for_keypress(SDL_Renderer* renderer, SDL_Texture* texture) {
-    SDL_Rect dst = GraphicsSystem::compute_letterbox_rect(renderer);
-    SDL_Event e;
+static SDL_Texture* queue_screen(Sequencer& sequencer, SDL_Renderer* renderer, GraphicsSystem* graphics,
+                                 const std::shared_ptr<TitleSequenceTextures>& owner,
+                                 DecodeTicket& ticket, const char* filename, bool fade) {
+    SDL_Surface* surface = take_fullscreen_paletted_surface(graphics, ticket, filename);
+    if (!surface) {
+        return nullptr;
+    }
 
-    while (true) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) return false;
-            if (e.type == SDL_KEYDOWN) return true;
+    FadeLayers layers;
+    FadeColors orig_colors = {};
+    const bool faded = fade && build_fade_layers(renderer, surface, filename, &layers, &orig_colors);
+    if (faded) {
+        owner->add(layers.base);
+        for (SDL_Texture* mask : layers.masks) {
+            owner->add(mask);
         }
+    }
+    SDL_Texture* texture = owner->add(surface_to_texture(renderer, surface));
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        return nullptr;
+    }
 
-        // Keep presenting the current screen while waiting
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, texture, nullptr, &dst);
-        SDL_RenderPresent(renderer);
-
-        SDL_Delay(16);
+    if (faded) {
+        // Each step only changes the masks' color modulation
+        const std::vector<FadeColors> steps = get_fade_in_steps(orig_colors);
+        for (size_t step = 0; step < steps.size(); ++step) {
+            const FadeColors colors = steps[step];
+            sequencer.show([renderer, owner, layers, colors]() {
+                draw_fade_layers(renderer, layers, colors);
+            });
+            if (step + 1 < steps.size()) {
+                sequencer.wait_ms(FADE_STEP_DELAY_MS);
+            }
+        }
     }
+    show_screen(sequencer, renderer, owner, texture);
+    return texture;
 }
 
+// One source line laid out against a shared glyph atlas. Long lines wrap into
+// several rows, drawn left-aligned inside a block of width x height.
 struct RenderedTextLine {
-    SDL_Texture* texture = nullptr;
+    GlyphAtlas* atlas = nullptr;
+    std::vector<std::string> rows;
+    SDL_Color color = {255, 255, 255, 255};
     int width = 0;
     int height = 0;
 };
 
+// Source lines of a text screen: literals, or strings formatted into
+// frame_arena(), so building them for a frame allocates nothing
+constexpr size_t MAX_TEXT_LINES = 24;
+using TextLines = FixedVector<const char*, MAX_TEXT_LINES>;
+
+// Wrap `text` against `atlas` and fill in the block size. Returns false if
+// nothing could be laid out.
+static bool layout_text_line(GlyphAtlas* atlas,
+                             const std::string& text,
+                             SDL_Color color,
+                             int max_line_width,
+                             RenderedTextLine& line) {
+    line.atlas = atlas;
+    line.color = color;
+    line.rows.clear();
+    atlas->wrap_text(text, max_line_width, line.rows);
+    if (line.rows.empty()) {
+        return false;
+    }
+
+    line.width = 0;
+    for (const std::string& row : line.rows) {
+        line.width = std::max(line.width, atlas->measure_text(row.c_str()));
+    }
+    line.height = static_cast<int>(line.rows.size() - 1) * atlas->get_line_skip() +
+                  atlas->get_height();
+    return true;
+}
+
+static void draw_text_line(const RenderedTextLine& line, int x, int y) {
+    if (!line.atlas) {
+        return;
+    }
+    for (size_t i = 0; i < line.rows.size(); ++i) {
+        const int row_y = y + static_cast<int>(i) * line.atlas->get_line_skip();
+        line.atlas->render_text(x, row_y, line.rows[i].c_str(), line.color);
+    }
+}
+
 struct DosTextLayout {
     int left = 0;
     int top = 0;
@@ -465,66 +456,47 @@ static DosTextLayout compute_dos_text_layout(SDL_Renderer* renderer, TTF_Font* f
 }
 
 static void destroy_text_lines(std::vector<RenderedTextLine>& lines) {
-    for (RenderedTextLine& line : lines) {
-        if (line.texture) {
-            SDL_DestroyTexture(line.texture);
-            line.texture = nullptr;
-        }
-    }
+    // The atlas is shared (see acquire_glyph_atlas); only the layout is ours.
     lines.clear();
 }
 
-static std::vector<RenderedTextLine> build_text_lines(SDL_Renderer* renderer,
-                                                      TTF_Font* font,
-                                                      const std::vector<std::string>& lines,
-                                                      SDL_Color color,
-                                                      int max_line_width) {
-    std::vector<RenderedTextLine> rendered_lines;
-    rendered_lines.reserve(lines.size());
+// Lay `lines` out into `rendered_lines` (replacing what it held). Returns
+// false, leaving it empty, if the text could not be laid out.
+static bool build_text_lines(SDL_Renderer* renderer,
+                             TTF_Font* font,
+                             const TextLines& lines,
+                             SDL_Color color,
+                             int max_line_width,
+                             std::vector<RenderedTextLine>& rendered_lines) {
+    destroy_text_lines(rendered_lines);
+
+    GlyphAtlas* atlas = acquire_glyph_atlas(renderer, font);
+    if (!atlas) {
+        std::cerr << "Startup notice: failed to build glyph atlas" << std::endl;
+        return false;
+    }
 
-    for (const std::string& line_text : lines) {
-        if (line_text.empty()) {
-            // SDL_ttf cannot render empty strings ("Text has zero width").
-            // Treat empty lines as vertical spacers.
+    rendered_lines.reserve(lines.size());
+    for (const char* line_text : lines) {
+        if (line_text[0] == '\0') {
+            // Empty lines are vertical spacers.
             RenderedTextLine spacer;
-            spacer.texture = nullptr;
             spacer.width = 0;
-            spacer.height = TTF_FontLineSkip(font);
+            spacer.height = atlas->get_line_skip();
             rendered_lines.push_back(spacer);
             continue;
         }
 
-        SDL_Surface* surface = TTF_RenderText_Blended_Wrapped(
-            font,
-            line_text.c_str(),
-            color,
-            static_cast<Uint32>(max_line_width));
-        if (!surface) {
-            std::cerr << "Startup notice: failed to render text line: "
-                      << TTF_GetError() << std::endl;
-            destroy_text_lines(rendered_lines);
-            return rendered_lines;
-        }
-
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-        if (!texture) {
-            std::cerr << "Startup notice: failed to create text texture: "
-                      << SDL_GetError() << std::endl;
-            SDL_FreeSurface(surface);
+        RenderedTextLine rendered;
+        if (!layout_text_line(atlas, line_text, color, max_line_width, rendered)) {
+            std::cerr << "Startup notice: failed to lay out text line" << std::endl;
             destroy_text_lines(rendered_lines);
-            return rendered_lines;
+            return false;
         }
-
-        RenderedTextLine rendered;
-        rendered.texture = texture;
-        rendered.width = surface->w;
-        rendered.height = surface->h;
         rendered_lines.push_back(rendered);
-
-        SDL_FreeSurface(surface);
     }
 
-    return rendered_lines;
+    return !rendered_lines.empty();
 }
 
 static void render_text_lines_centered(SDL_Renderer* renderer,
@@ -551,9 +523,7 @@ static void render_text_lines_centered(SDL_Renderer* renderer,
         dst.x = (output_w - line.width) / 2;
         if (dst.x < 0) dst.x = 0;
         dst.y = y;
-        if (line.texture) {
-            SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
-        }
+        draw_text_line(line, dst.x, dst.y);
         y += line.height + line_spacing;
     }
 
@@ -626,15 +596,14 @@ static TTF_Font* open_startup_notice_font() {
 
 static bool run_modal_text_screen(SDL_Renderer* renderer,
                                   TTF_Font* font,
-                                  const std::vector<std::string>& lines) {
+                                  const TextLines& lines) {
     constexpr SDL_Color TEXT_COLOR = {170, 170, 170, 255};
     constexpr SDL_Color BACKGROUND = {0, 0, 0, 255};
 
     const DosTextLayout layout = compute_dos_text_layout(renderer, font);
 
-    std::vector<RenderedTextLine> rendered_lines =
-        build_text_lines(renderer, font, lines, TEXT_COLOR, layout.max_width);
-    if (rendered_lines.empty()) {
+    std::vector<RenderedTextLine> rendered_lines;
+    if (!build_text_lines(renderer, font, lines, TEXT_COLOR, layout.max_width, rendered_lines)) {
         return true;
     }
 
@@ -661,11 +630,14 @@ static bool run_modal_text_screen(SDL_Renderer* renderer,
     }
 }
 
-static std::vector<std::string> build_keyboard_setup_lines(const InputBindings& draft,
-                                                           int action_index,
-                                                           const std::string& status_line,
-                                                           bool is_confirm_mode) {
-    const std::vector<std::string> action_names = {
+// Fill `lines` with the keyboard setup screen; the formatted lines live in
+// frame_arena()
+static void build_keyboard_setup_lines(const InputBindings& draft,
+                                       int action_index,
+                                       const char* status_line,
+                                       bool is_confirm_mode,
+                                       TextLines& lines) {
+    static const char* const action_names[] = {
         "Move Left",
         "Move Right",
         "Jump",
@@ -674,7 +646,7 @@ static std::vector<std::string> build_keyboard_setup_lines(const InputBindings&
         "Teleport"
     };
 
-    const std::vector<SDL_Keycode> action_keys = {
+    const SDL_Keycode action_keys[] = {
         draft.move_left,
         draft.move_right,
         draft.jump,
@@ -683,32 +655,31 @@ static std::vector<std::string> build_keyboard_setup_lines(const InputBindings&
         draft.teleport
     };
 
-    std::vector<std::string> lines;
+    FrameArena& arena = frame_arena();
+    lines.clear();
     lines.push_back("Keyboard Setup");
     lines.push_back("");
 
-    const int total_actions = static_cast<int>(action_names.size());
+    const int total_actions = static_cast<int>(std::size(action_names));
     const bool prompt_for_action = !is_confirm_mode && action_index >= 0 && action_index < total_actions;
 
     if (!prompt_for_action) {
         lines.push_back("Review bindings");
         lines.push_back("Press Y to accept, N to reconfigure, ESC to cancel");
     } else {
-        lines.push_back("Press a key for: " + action_names[action_index]);
+        lines.push_back(arena.format("Press a key for: %s", action_names[action_index]));
         lines.push_back("ESC cancels and returns");
     }
 
     lines.push_back("");
-    for (size_t i = 0; i < action_names.size(); ++i) {
-        lines.push_back(action_names[i] + ": " + SDL_GetKeyName(action_keys[i]));
+    for (int i = 0; i < total_actions; ++i) {
+        lines.push_back(arena.format("%s: %s", action_names[i], SDL_GetKeyName(action_keys[i])));
     }
 
-    if (!status_line.empty()) {
+    if (status_line[0] != '\0') {
         lines.push_back("");
         lines.push_back(status_line);
     }
-
-    return lines;
 }
 
 static SDL_Keycode canonicalize_binding_key(SDL_Keycode key) {
@@ -830,6 +801,8 @@ static bool run_keyboard_setup_menu(SDL_Renderer* renderer, TTF_Font* font) {
     };
 
     while (true) {
+        // The screen's lines only need to last until they are laid out
+        FrameArenaScope frame_scope;
 
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) {
@@ -909,20 +882,17 @@ static bool run_keyboard_setup_menu(SDL_Renderer* renderer, TTF_Font* font) {
             !input_bindings_equal(cached_draft, draft);
 
         if (should_rebuild_cache) {
-            std::vector<std::string> lines =
-                build_keyboard_setup_lines(draft, action_index, status_line, is_confirm_mode);
+            TextLines lines;
+            build_keyboard_setup_lines(draft, action_index, status_line.c_str(), is_confirm_mode, lines);
 
             cached_layout = compute_dos_text_layout(renderer, font);
 
-            std::vector<RenderedTextLine> rendered =
-                build_text_lines(renderer, font, lines, TEXT_COLOR, cached_layout.max_width);
-            if (rendered.empty()) {
+            if (!build_text_lines(renderer, font, lines, TEXT_COLOR, cached_layout.max_width,
+                                  cached_rendered_lines)) {
                 clear_cached_lines();
                 return true;
             }
 
-            clear_cached_lines();
-            cached_rendered_lines = std::move(rendered);
             cache_valid = true;
             cached_draft = draft;
             cached_action_index = action_index;
@@ -1081,56 +1051,75 @@ static int find_insertion_rank(const std::vector<HighScoreEntry>& scores, uint32
     return MAX_HIGH_SCORES;
 }
 
-// Build a temporary scores list for display during name entry,
-// with a placeholder inserted at the given rank.
-static std::vector<HighScoreEntry> build_preview_list(
+// A leaderboard row as displayed; the name points into a HighScoreEntry or
+// frame_arena()
+struct HighScoreRow {
+    const char* name;
+    uint32_t score;
+};
+using HighScoreRows = FixedVector<HighScoreRow, MAX_HIGH_SCORES>;
+
+static void get_high_score_rows(const std::vector<HighScoreEntry>& scores, HighScoreRows& rows) {
+    rows.clear();
+    for (const HighScoreEntry& entry : scores) {
+        rows.push_back({entry.name.c_str(), entry.score});
+    }
+}
+
+// Build the scores list for display during name entry, with the name being
+// typed (and its cursor) inserted at the given rank.
+static void build_preview_list(
     const std::vector<HighScoreEntry>& scores,
     int rank,
     uint32_t player_score,
-    const std::string& current_input)
+    const char* placeholder_name,
+    HighScoreRows& preview)
 {
-    std::vector<HighScoreEntry> preview = scores;
-    const std::string placeholder_name = current_input.empty() ? "_" : current_input + "_";
-    preview.insert(preview.begin() + std::min(rank, static_cast<int>(preview.size())),
-                   HighScoreEntry{placeholder_name, player_score});
-    if (static_cast<int>(preview.size()) > MAX_HIGH_SCORES) {
-        preview.resize(static_cast<size_t>(MAX_HIGH_SCORES));
-    }
-    return preview;
+    preview.clear();
+    const size_t insert_at = static_cast<size_t>(std::min(rank, static_cast<int>(scores.size())));
+    for (size_t i = 0; i <= scores.size(); ++i) {
+        if (i == insert_at) {
+            preview.push_back({placeholder_name, player_score});
+        }
+        if (i < scores.size()) {
+            preview.push_back({scores[i].name.c_str(), scores[i].score});  // Dropped past MAX_HIGH_SCORES
+        }
+    }
 }
 
-// Build the text lines to display on the high scores screen.
+// Build the text lines to display on the high scores screen (formatted into
+// frame_arena()).
 // highlight_rank: 0-based index of the new entry (>= MAX_HIGH_SCORES = no highlight).
 // is_entering_name: true while the player is typing their name.
 // prompt_suffix: current name being typed (with cursor if is_entering_name).
-static std::vector<std::string> build_high_scores_lines(
-    const std::vector<HighScoreEntry>& scores,
+static void build_high_scores_lines(
+    const HighScoreRows& scores,
     int highlight_rank,
     bool is_entering_name,
-    const std::string& prompt_suffix)
+    const char* prompt_suffix,
+    TextLines& lines)
 {
-    std::vector<std::string> lines;
+    FrameArena& arena = frame_arena();
+    lines.clear();
     lines.push_back("HALL OF FAME");
     lines.push_back("");
 
     if (is_entering_name) {
-        lines.push_back("Enter your name: " + prompt_suffix);
+        lines.push_back(arena.format("Enter your name: %s", prompt_suffix));
         lines.push_back("");
     }
 
     for (int i = 0; i < MAX_HIGH_SCORES; ++i) {
-        char buf[80];
         if (i < static_cast<int>(scores.size())) {
             const bool is_new = (i == highlight_rank);
-            std::snprintf(buf, sizeof(buf), "%s%2d. %06u  %-15s",
-                          is_new ? ">>" : "  ",
-                          i + 1,
-                          scores[i].score,
-                          scores[i].name.c_str());
+            lines.push_back(arena.format("%s%2d. %06u  %-15s",
+                                         is_new ? ">>" : "  ",
+                                         i + 1,
+                                         static_cast<unsigned>(scores[static_cast<size_t>(i)].score),
+                                         scores[static_cast<size_t>(i)].name));
         } else {
-            std::snprintf(buf, sizeof(buf), "   %2d. ------  ---------------", i + 1);
+            lines.push_back(arena.format("   %2d. ------  ---------------", i + 1));
         }
-        lines.push_back(buf);
     }
 
     lines.push_back("");
@@ -1139,45 +1128,39 @@ static std::vector<std::string> build_high_scores_lines(
     } else {
         lines.push_back("Press any key to continue");
     }
-
-    return lines;
 }
 
-struct HighScoreRenderedLine {
-    SDL_Texture* tex = nullptr;
-    int w = 0;
-    int h = 0;
-};
+static bool text_lines_match(const std::vector<std::string>& cached, const TextLines& lines) {
+    if (cached.size() != lines.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (cached[i] != lines[i]) {
+            return false;
+        }
+    }
+    return true;
+}
 
 struct HighScoreTextCache {
     std::vector<std::string> lines;
-    std::vector<HighScoreRenderedLine> rendered;
+    std::vector<RenderedTextLine> rendered;
     int max_line_width = 0;
     int total_h = 0;
     int max_w = 0;
 
     void clear() {
-        for (HighScoreRenderedLine& line : rendered) {
-            if (line.tex) {
-                SDL_DestroyTexture(line.tex);
-                line.tex = nullptr;
-            }
-        }
         rendered.clear();
         lines.clear();
         max_line_width = 0;
         total_h = 0;
         max_w = 0;
     }
-
-    ~HighScoreTextCache() {
-        clear();
-    }
 };
 
 static void build_high_score_text_cache(SDL_Renderer* renderer,
                                         TTF_Font* font,
-                                        const std::vector<std::string>& lines,
+                                        const TextLines& lines,
                                         int max_line_width,
                                         HighScoreTextCache& cache) {
     constexpr SDL_Color COLOR_NORMAL  = {200, 200, 200, 255};
@@ -1186,32 +1169,30 @@ static void build_high_score_text_cache(SDL_Renderer* renderer,
     constexpr int LINE_GAP = 2;
 
     cache.clear();
-    cache.lines = lines;
+    cache.lines.assign(lines.begin(), lines.end());
     cache.max_line_width = max_line_width;
+
+    GlyphAtlas* atlas = acquire_glyph_atlas(renderer, font);
+    if (!atlas) {
+        return;
+    }
     cache.rendered.reserve(lines.size());
 
     for (size_t i = 0; i < lines.size(); ++i) {
-        HighScoreRenderedLine rl;
-        if (lines[i].empty()) {
-            rl.h = TTF_FontLineSkip(font) / 2;
+        RenderedTextLine rl;
+        if (lines[i][0] == '\0') {
+            rl.height = atlas->get_line_skip() / 2;
         } else {
             SDL_Color color = COLOR_NORMAL;
             if (i == 0) {
                 color = COLOR_TITLE;
-            } else if (!lines[i].empty() && lines[i][0] == '>') {
+            } else if (lines[i][0] == '>') {
                 color = COLOR_NEW;
             }
-            SDL_Surface* surf = TTF_RenderText_Blended_Wrapped(
-                font, lines[i].c_str(), color, static_cast<Uint32>(max_line_width));
-            if (surf) {
-                rl.tex = SDL_CreateTextureFromSurface(renderer, surf);
-                rl.w = surf->w;
-                rl.h = surf->h;
-                SDL_FreeSurface(surf);
-            }
+            layout_text_line(atlas, lines[i], color, max_line_width, rl);
         }
-        cache.total_h += rl.h + LINE_GAP;
-        cache.max_w = std::max(cache.max_w, rl.w);
+        cache.total_h += rl.height + LINE_GAP;
+        cache.max_w = std::max(cache.max_w, rl.width);
         cache.rendered.push_back(rl);
     }
 }
@@ -1222,7 +1203,7 @@ static void build_high_score_text_cache(SDL_Renderer* renderer,
 static void render_high_scores_frame(SDL_Renderer* renderer,
                                      SDL_Texture* bg_texture,
                                      TTF_Font* font,
-                                     const std::vector<std::string>& lines,
+                                     const TextLines& lines,
                                      HighScoreTextCache* text_cache = nullptr)
 {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
@@ -1246,7 +1227,7 @@ static void render_high_scores_frame(SDL_Renderer* renderer,
     HighScoreTextCache* cache = text_cache ? text_cache : &local_cache;
     if (cache->rendered.empty() ||
         cache->max_line_width != max_line_width ||
-        cache->lines != lines) {
+        !text_lines_match(cache->lines, lines)) {
         build_high_score_text_cache(renderer, font, lines, max_line_width, *cache);
     }
 
@@ -1277,13 +1258,11 @@ static void render_high_scores_frame(SDL_Renderer* renderer,
 
     // Blit each text line, centered horizontally.
     int y = top_y;
-    for (const HighScoreRenderedLine& rl : cache->rendered) {
-        if (rl.tex) {
-            SDL_Rect dst = {(output_w - rl.w) / 2, y, rl.w, rl.h};
-            if (dst.x < 0) dst.x = 0;
-            SDL_RenderCopy(renderer, rl.tex, nullptr, &dst);
-        }
-        y += rl.h + LINE_GAP;
+    for (const RenderedTextLine& rl : cache->rendered) {
+        int x = (output_w - rl.width) / 2;
+        if (x < 0) x = 0;
+        draw_text_line(rl, x, y);
+        y += rl.height + LINE_GAP;
     }
 
     SDL_RenderPresent(renderer);
@@ -1312,6 +1291,9 @@ static NameCaptureResult capture_name_input(SDL_Renderer* renderer,
     bool done = false;
 
     while (!done) {
+        // This frame's preview and lines
+        FrameArenaScope frame_scope;
+
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) {
                 result.user_quit = true;
@@ -1320,7 +1302,8 @@ static NameCaptureResult capture_name_input(SDL_Renderer* renderer,
             }
 
             if (e.type == SDL_TEXTINPUT) {
-                for (unsigned char c : std::string(e.text.text)) {
+                for (const char* text = e.text.text; *text != '\0'; ++text) {
+                    const unsigned char c = static_cast<unsigned char>(*text);
                     if (c >= 32u && c < 127u &&
                         static_cast<int>(name.size()) < MAX_NAME_LENGTH) {
                         name += static_cast<char>(c);
@@ -1347,11 +1330,11 @@ static NameCaptureResult capture_name_input(SDL_Renderer* renderer,
             break;
         }
 
-        const std::vector<HighScoreEntry> preview =
-            build_preview_list(scores, rank, player_score, name);
-        const std::string cursor = name.empty() ? "_" : name + "_";
-        const std::vector<std::string> display_lines =
-            build_high_scores_lines(preview, rank, true, cursor);
+        const char* cursor = frame_arena().format("%s_", name.c_str());
+        HighScoreRows preview;
+        build_preview_list(scores, rank, player_score, cursor, preview);
+        TextLines display_lines;
+        build_high_scores_lines(preview, rank, true, cursor, display_lines);
         render_high_scores_frame(renderer, bg_texture, font, display_lines, &text_cache);
         SDL_Delay(16);
     }
@@ -1493,7 +1476,8 @@ bool save_input_bindings_to_file() {
     return true;
 }
 
-bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics) {
+bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics,
+                        const std::function<void()>& on_frame) {
     (void)graphics;
 
     TTF_Font* font = open_startup_notice_font();
@@ -1502,7 +1486,7 @@ bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics) {
         return true;
     }
 
-    const std::vector<std::string> startup_lines = {
+    const TextLines startup_lines = {
         "Captain Comic",
         "",
         "Press K for Keyboard setup",
@@ -1517,9 +1501,8 @@ bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics) {
 
     const DosTextLayout layout = compute_dos_text_layout(renderer, font);
 
-    std::vector<RenderedTextLine> rendered_startup =
-        build_text_lines(renderer, font, startup_lines, TEXT_COLOR, layout.max_width);
-    if (rendered_startup.empty()) {
+    std::vector<RenderedTextLine> rendered_startup;
+    if (!build_text_lines(renderer, font, startup_lines, TEXT_COLOR, layout.max_width, rendered_startup)) {
         TTF_CloseFont(font);
         return true;
     }
@@ -1590,6 +1573,9 @@ bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics) {
                 layout.top,
                 layout.line_spacing,
                 BACKGROUND);
+            if (on_frame) {
+                on_frame();
+            }
             SDL_Delay(16);
         }
     }
@@ -1599,87 +1585,76 @@ bool run_startup_notice(SDL_Renderer* renderer, GraphicsSystem* graphics) {
     return true;
 }
 
-bool run_title_sequence(SDL_Renderer* renderer, GraphicsSystem* graphics) {
+void split_palette_fade_layers(const uint8_t* pixels, int width, int height, int pitch,
+                               const SDL_Color* palette, int palette_size,
+                               const uint8_t* registers, PaletteFadeLayers* layers) {
+    const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    layers->base.assign(size, 0);
+    for (auto& mask : layers->masks) {
+        mask.assign(size, 0);
+    }
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = pixels + static_cast<size_t>(y) * static_cast<size_t>(pitch);
+        for (int x = 0; x < width; ++x) {
+            const uint8_t index = row[x];
+            const size_t offset = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * 4;
+            uint8_t* base = &layers->base[offset];
+            base[3] = 255;
+
+            bool fading = false;
+            for (int i = 0; i < FADE_REGISTER_COUNT; ++i) {
+                if (index == registers[i]) {
+                    uint8_t* mask = &layers->masks[i][offset];
+                    mask[0] = mask[1] = mask[2] = mask[3] = 255;
+                    fading = true;
+                    break;
+                }
+            }
+            if (!fading && index < palette_size) {
+                base[0] = palette[index].r;
+                base[1] = palette[index].g;
+                base[2] = palette[index].b;
+            }
+        }
+    }
+}
+
+void queue_title_sequence(Sequencer& sequencer, SDL_Renderer* renderer, GraphicsSystem* graphics) {
+    // Screens are loaded and converted now; the steps only switch between them
+    auto owner = std::make_shared<TitleSequenceTextures>();
+    // The four screens decode side by side on the worker pool; a ticket left
+    // behind when the sequence is cut short frees its own surface
+    DecodeTicket title_ticket = graphics->request_asset_surface(TITLE_SCREEN_FILE, true);
+    DecodeTicket story_ticket = graphics->request_asset_surface(STORY_SCREEN_FILE, true);
+    DecodeTicket hud_ticket = graphics->request_asset_surface(GAME_UI_FILE, true);
+    DecodeTicket items_ticket = graphics->request_asset_surface(ITEMS_SCREEN_FILE, true);
+
     // ------------------------------------------------------------------
     // Step 1: Title screen (SYS000.EGA)
-    //   - Load image, display with palette fade-in, play title music, wait ~770 ms
+    //   - Display with palette fade-in, play title music, wait ~770 ms
     // ------------------------------------------------------------------
-    s_title_surface = load_fullscreen_paletted_surface(graphics, TITLE_SCREEN_FILE);
-    if (!s_title_surface) {
+    if (!queue_screen(sequencer, renderer, graphics, owner, title_ticket, TITLE_SCREEN_FILE, true)) {
         std::cerr << "Title sequence aborted: could not load title screen" << std::endl;
-        return true;
-    }
-
-    // Palette fade-in (darkens registers 2,10,12 then restores with color effects)
-    if (!fade_in_paletted_surface(renderer, s_title_surface, TITLE_SCREEN_FILE)) {
-        SDL_FreeSurface(s_title_surface);
-        s_title_surface = nullptr;
-        return false;
+        return;
     }
 
     // Start title music (loops until stopped)
-    play_game_music(GameMusic::TITLE);
-
-    // Create texture and display for ~770 ms (original: wait_n_ticks(14))
-    SDL_Texture* title_tex = surface_to_texture(renderer, s_title_surface);
-    if (!title_tex) {
-        SDL_FreeSurface(s_title_surface);
-        s_title_surface = nullptr;
-        stop_game_music();
-        return true;
-    }
+    sequencer.run([]() { play_game_music(GameMusic::TITLE); });
 
-    show_texture(renderer, title_tex);
-    SDL_DestroyTexture(title_tex);
-
-    if (!wait_ms(TITLE_DISPLAY_MS)) {
-        SDL_FreeSurface(s_title_surface);
-        s_title_surface = nullptr;
-        stop_game_music();
-        return false;
-    }
-
-    SDL_FreeSurface(s_title_surface);
-    s_title_surface = nullptr;
+    // Hold the title screen (original: wait_n_ticks(14))
+    sequencer.wait_ms(TITLE_DISPLAY_MS);
 
     // ------------------------------------------------------------------
     // Step 2: Story screen (SYS001.EGA)
-    //   - Load image, display with palette fade-in, wait for keypress
+    //   - Display with palette fade-in, wait for keypress
     // ------------------------------------------------------------------
-    s_story_surface = load_fullscreen_paletted_surface(graphics, STORY_SCREEN_FILE);
-    if (!s_story_surface) {
+    if (!queue_screen(sequencer, renderer, graphics, owner, story_ticket, STORY_SCREEN_FILE, true)) {
         std::cerr << "Title sequence aborted: could not load story screen" << std::endl;
-        stop_game_music();
-        return true;
-    }
-
-    if (!fade_in_paletted_surface(renderer, s_story_surface, STORY_SCREEN_FILE)) {
-        SDL_FreeSurface(s_story_surface);
-        s_story_surface = nullptr;
-        stop_game_music();
-        return false;
-    }
-
-    // Create texture for keypress waiting
-    SDL_Texture* story_tex = surface_to_texture(renderer, s_story_surface);
-    if (!story_tex) {
-        SDL_FreeSurface(s_story_surface);
-        s_story_surface = nullptr;
-        stop_game_music();
-        return true;
-    }
-
-    if (!wait_for_keypress(renderer, story_tex)) {
-        SDL_DestroyTexture(story_tex);
-        SDL_FreeSurface(s_story_surface);
-        s_story_surface = nullptr;
-        stop_game_music();
-        return false;
+        sequencer.run(stop_game_music);
+        return;
     }
-
-    SDL_DestroyTexture(story_tex);
-    SDL_FreeSurface(s_story_surface);
-    s_story_surface = nullptr;
+    sequencer.wait_for_key();
 
     // ------------------------------------------------------------------
     // Step 3: Game UI background (SYS003.EGA)
@@ -1687,7 +1662,7 @@ bool run_title_sequence(SDL_Renderer* renderer, GraphicsSystem* graphics) {
     //   - Original loads into both gameplay buffers; here we keep one
     //     texture that the game loop composites under the playfield.
     // ------------------------------------------------------------------
-    SDL_Surface* hud_surface = load_fullscreen_paletted_surface(graphics, GAME_UI_FILE);
+    SDL_Surface* hud_surface = take_fullscreen_paletted_surface(graphics, hud_ticket, GAME_UI_FILE);
     if (hud_surface) {
         SDL_Texture* hud_tex = surface_to_texture(renderer, hud_surface);
         SDL_FreeSurface(hud_surface);
@@ -1707,55 +1682,30 @@ bool run_title_sequence(SDL_Renderer* renderer, GraphicsSystem* graphics) {
     // Step 4: Items screen (SYS004.EGA)
     //   - Display WITHOUT palette fade effect, wait for keypress
     // ------------------------------------------------------------------
-    s_items_surface = load_fullscreen_paletted_surface(graphics, ITEMS_SCREEN_FILE);
-    if (!s_items_surface) {
+    if (!queue_screen(sequencer, renderer, graphics, owner, items_ticket, ITEMS_SCREEN_FILE, false)) {
         std::cerr << "Title sequence aborted: could not load items screen" << std::endl;
-        stop_game_music();
-        return true;
-    }
-
-    // Create texture directly (no fade effect for items screen)
-    SDL_Texture* items_tex = surface_to_texture(renderer, s_items_surface);
-    if (!items_tex) {
-        SDL_FreeSurface(s_items_surface);
-        s_items_surface = nullptr;
-        stop_game_music();
-        return true;
-    }
-
-    if (!wait_for_keypress(renderer, items_tex)) {
-        SDL_DestroyTexture(items_tex);
-        SDL_FreeSurface(s_items_surface);
-        s_items_surface = nullptr;
-        stop_game_music();
-        return false;
+        sequencer.run(stop_game_music);
+        return;
     }
-
-    SDL_DestroyTexture(items_tex);
-    SDL_FreeSurface(s_items_surface);
-    s_items_surface = nullptr;
+    sequencer.wait_for_key();
 
     // ------------------------------------------------------------------
     // Step 5: Display HUD graphic as transition (SYS003.EGA)
     //   - Show the game UI background that will be used during gameplay
-    //   - Convert and display the retained HUD texture before returning
     // ------------------------------------------------------------------
     if (s_hud_texture) {
-        show_texture(renderer, s_hud_texture);
+        sequencer.show([renderer]() {
+            draw_fullscreen_texture(renderer, s_hud_texture);
+        });
         // Hold HUD display briefly before transitioning to gameplay
-        if (!wait_ms(300)) {
-            stop_game_music();
-            return false;
-        }
+        sequencer.wait_ms(300);
     }
 
     // ------------------------------------------------------------------
     // Step 6: Cleanup and transition
     //   - Stop title music before entering gameplay
     // ------------------------------------------------------------------
-    stop_game_music();
-
-    return true;
+    sequencer.run(stop_game_music);
 }
 
 SDL_Texture* get_hud_texture() {
@@ -1767,8 +1717,7 @@ bool run_high_scores_screen(SDL_Renderer* renderer, GraphicsSystem* graphics,
     // Load background texture (sys005.ega.png).
     SDL_Texture* bg_texture = nullptr;
     if (graphics) {
-        const std::string path = graphics->get_asset_path(HIGH_SCORES_SCREEN_FILE);
-        SDL_Surface* surface = IMG_Load(path.c_str());
+        SDL_Surface* surface = graphics->load_asset_surface(HIGH_SCORES_SCREEN_FILE);
         if (surface) {
             bg_texture = SDL_CreateTextureFromSurface(renderer, surface);
             SDL_FreeSurface(surface);
@@ -1817,8 +1766,12 @@ bool run_high_scores_screen(SDL_Renderer* renderer, GraphicsSystem* graphics,
 
     // Display the final leaderboard and wait for a keypress.
     const int display_rank = qualifies ? rank : -1;
-    const std::vector<std::string> display_lines =
-        build_high_scores_lines(scores, display_rank, false, player_name);
+    // Built once and shown until a key is pressed; nothing else uses the
+    // arena until this returns to the frame loop
+    HighScoreRows rows;
+    get_high_score_rows(scores, rows);
+    TextLines display_lines;
+    build_high_scores_lines(rows, display_rank, false, player_name.c_str(), display_lines);
     HighScoreTextCache text_cache;
 
     SDL_Event e;
@@ -1853,18 +1806,6 @@ bool run_high_scores_screen(SDL_Renderer* renderer, GraphicsSystem* graphics,
 }
 
 void cleanup_title_sequence() {
-    if (s_title_surface) {
-        SDL_FreeSurface(s_title_surface);
-        s_title_surface = nullptr;
-    }
-    if (s_story_surface) {
-        SDL_FreeSurface(s_story_surface);
-        s_story_surface = nullptr;
-    }
-    if (s_items_surface) {
-        SDL_FreeSurface(s_items_surface);
-        s_items_surface = nullptr;
-    }
     if (s_hud_texture) {
         SDL_DestroyTexture(s_hud_texture);
         s_hud_texture = nullptr;
@@ -1,15 +1,20 @@
 #include "ui_system.h"
+#include "profiler.h"
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 
 UISystem::UISystem()
       : initialized(false),
         inventory_animation_counter(0),
-        life_icon_bright(nullptr),
-      life_icon_dark(nullptr),
-      meter_full(nullptr),
-      meter_half(nullptr),
-      meter_empty(nullptr)
+        hud_cache(nullptr),
+        hud_cache_valid(false),
+        hud_cache_unsupported(false),
+        life_icon_bright(INVALID_SPRITE_ID),
+      life_icon_dark(INVALID_SPRITE_ID),
+      meter_full(INVALID_SPRITE_ID),
+      meter_half(INVALID_SPRITE_ID),
+      meter_empty(INVALID_SPRITE_ID)
 {
 }
 
@@ -34,8 +39,8 @@ bool UISystem::initialize() {
     for (int i = 0; i < 10; i++) {
         std::ostringstream oss;
         oss << "score_digit_" << i;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load score digit sprite " << i << std::endl;
             return false;
         }
@@ -44,32 +49,32 @@ bool UISystem::initialize() {
     
     // Load life icon sprites
     life_icon_bright = load_ui_sprite("life_icon_bright");
-    if (!life_icon_bright) {
+    if (life_icon_bright == INVALID_SPRITE_ID) {
         std::cerr << "Failed to load life icon bright sprite" << std::endl;
         return false;
     }
     
     life_icon_dark = load_ui_sprite("life_icon_dark");
-    if (!life_icon_dark) {
+    if (life_icon_dark == INVALID_SPRITE_ID) {
         std::cerr << "Failed to load life icon dark sprite" << std::endl;
         return false;
     }
     
     // Load meter sprites
     meter_full = load_ui_sprite("meter_full");
-    if (!meter_full) {
+    if (meter_full == INVALID_SPRITE_ID) {
         std::cerr << "Failed to load meter full sprite" << std::endl;
         return false;
     }
     
     meter_half = load_ui_sprite("meter_half");
-    if (!meter_half) {
+    if (meter_half == INVALID_SPRITE_ID) {
         std::cerr << "Failed to load meter half sprite" << std::endl;
         return false;
     }
     
     meter_empty = load_ui_sprite("meter_empty");
-    if (!meter_empty) {
+    if (meter_empty == INVALID_SPRITE_ID) {
         std::cerr << "Failed to load meter empty sprite" << std::endl;
         return false;
     }
@@ -78,8 +83,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "cola_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load Blastola Cola sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -89,15 +94,15 @@ bool UISystem::initialize() {
     // Load firepower-specific Blastola Cola inventory sprites (1-5, even/odd).
     // If a variant is missing, fallback to base cola frames so HUD rendering still works.
     for (int firepower = 1; firepower <= 5; ++firepower) {
-        std::vector<Sprite*> firepower_frames;
+        std::vector<SpriteId> firepower_frames;
         firepower_frames.reserve(2);
 
         for (const char* suffix : {"even", "odd"}) {
             std::ostringstream oss;
             oss << "cola_inventory_" << firepower << "_" << suffix;
 
-            Sprite* sprite = load_ui_sprite(oss.str());
-            if (!sprite) {
+            SpriteId sprite = load_ui_sprite(oss.str());
+            if (sprite == INVALID_SPRITE_ID) {
                 if (blastola_cola_sprites.empty()) {
                     std::cerr << "Failed to load Blastola Cola inventory sprite: " << oss.str()
                               << std::endl;
@@ -124,8 +129,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "corkscrew_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load corkscrew sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -136,8 +141,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "doorkey_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load door key sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -148,8 +153,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "boots_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load boots sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -160,8 +165,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "lantern_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load lantern sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -172,8 +177,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "teleportwand_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load teleport wand sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -184,8 +189,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "gems_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load gems sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -196,8 +201,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "crown_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load crown sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -208,8 +213,8 @@ bool UISystem::initialize() {
     for (const char* suffix : {"even", "odd"}) {
         std::ostringstream oss;
         oss << "gold_" << suffix;
-        Sprite* sprite = load_ui_sprite(oss.str());
-        if (!sprite) {
+        SpriteId sprite = load_ui_sprite(oss.str());
+        if (sprite == INVALID_SPRITE_ID) {
             std::cerr << "Failed to load gold sprite: " << oss.str() << std::endl;
             return false;
         }
@@ -221,16 +226,24 @@ bool UISystem::initialize() {
 }
 
 void UISystem::cleanup() {
-    // Note: We don't own the Sprite pointers - they're owned by GraphicsSystem
+    // Note: We don't own the sprites - SpriteIds are handles into GraphicsSystem
     // Reset cached references so repeated cleanup/initialize cycles are safe.
     initialized = false;
     inventory_animation_counter = 0;
 
-    life_icon_bright = nullptr;
-    life_icon_dark = nullptr;
-    meter_full = nullptr;
-    meter_half = nullptr;
-    meter_empty = nullptr;
+    // The HUD layer is ours (created through the graphics renderer).
+    if (hud_cache) {
+        SDL_DestroyTexture(hud_cache);
+        hud_cache = nullptr;
+    }
+    hud_cache_valid = false;
+    hud_cache_unsupported = false;
+
+    life_icon_bright = INVALID_SPRITE_ID;
+    life_icon_dark = INVALID_SPRITE_ID;
+    meter_full = INVALID_SPRITE_ID;
+    meter_half = INVALID_SPRITE_ID;
+    meter_empty = INVALID_SPRITE_ID;
 
     score_digit_sprites.clear();
     blastola_cola_sprites.clear();
@@ -245,25 +258,49 @@ void UISystem::cleanup() {
     gold_sprites.clear();
 }
 
+void UISystem::request_sprites(GraphicsSystem* graphics) {
+    if (!graphics) {
+        return;
+    }
+    char name[32];
+    for (int i = 0; i < 10; i++) {
+        std::snprintf(name, sizeof(name), "score_digit_%d", i);
+        graphics->request_sprite(name, "");
+    }
+    for (const char* sprite : {"life_icon_bright", "life_icon_dark", "meter_full", "meter_half", "meter_empty"}) {
+        graphics->request_sprite(sprite, "");
+    }
+    for (const char* suffix : {"even", "odd"}) {
+        for (const char* item : {"cola", "corkscrew", "doorkey", "boots", "lantern",
+                                 "teleportwand", "gems", "crown", "gold"}) {
+            std::snprintf(name, sizeof(name), "%s_%s", item, suffix);
+            graphics->request_sprite(name, "");
+        }
+        for (int firepower = 1; firepower <= 5; ++firepower) {
+            std::snprintf(name, sizeof(name), "cola_inventory_%d_%s", firepower, suffix);
+            graphics->request_sprite(name, "");
+        }
+    }
+}
+
 void UISystem::update() {
     // Toggle animation counter once per game tick (~9 Hz)
     // This drives the even/odd frame alternation for inventory sprites
     inventory_animation_counter ^= 1;
 }
 
-Sprite* UISystem::load_ui_sprite(const std::string& sprite_name) {
-    if (!g_graphics) return nullptr;
+SpriteId UISystem::load_ui_sprite(const std::string& sprite_name) {
+    if (!g_graphics) return INVALID_SPRITE_ID;
     
     // UI sprites are not directional, so we use empty direction string
-    if (!g_graphics->load_sprite(sprite_name, "")) {
-        return nullptr;
-    }
-    
-    return g_graphics->get_sprite(sprite_name, "");
+    return g_graphics->load_sprite_id(sprite_name, "");
 }
 
-void UISystem::render_sprite_at(Sprite* sprite, int x, int y, int width, int height) {
-    if (!g_graphics || !sprite) return;
+void UISystem::render_sprite_at(SpriteId sprite_id, int x, int y, int width, int height) {
+    if (!g_graphics) return;
+    const Sprite* sprite = g_graphics->get_sprite(sprite_id);
+    if (!sprite) return;
+    g_graphics->set_render_layer(RenderLayer::HUD);
     g_graphics->render_sprite_scaled(x, y, *sprite, width, height, false);
 }
 
@@ -282,12 +319,109 @@ void UISystem::render_hud(
     bool has_gold,
     uint8_t jump_power)
 {
-    render_score(score_bytes);
-    render_lives(num_lives);
-    render_hp_meter(hp);
-    render_fireball_meter(fireball_meter);
-    render_inventory(firepower, has_corkscrew, has_door_key, has_teleport_wand,
-                    has_lantern, has_gems, has_crown, has_gold, jump_power);
+    PROFILE_SCOPE(ProfilePhase::HUD);
+
+    if (!g_graphics) return;
+
+    const HudState state = make_hud_state(
+        score_bytes, num_lives, hp, fireball_meter, firepower,
+        has_corkscrew, has_door_key, has_teleport_wand, has_lantern,
+        has_gems, has_crown, has_gold, jump_power, inventory_animation_counter);
+
+    // HUD inputs change at most once per game tick, so most frames are a
+    // single blit of the cached layer.
+    if (!hud_cache_valid || state != hud_cache_state) {
+        if (!rebuild_hud_cache(state)) {
+            draw_hud(state);
+            return;
+        }
+    }
+
+    SDL_Rect dst = {0, 0, EGA_WIDTH, EGA_HEIGHT};
+    SDL_RenderCopy(g_graphics->get_renderer(), hud_cache, nullptr, &dst);
+}
+
+void UISystem::invalidate_hud_cache() {
+    hud_cache_valid = false;
+}
+
+void UISystem::draw_hud(const HudState& state) {
+    g_graphics->begin_sprite_batch();
+    render_score(state.score_bytes);
+    render_lives(state.num_lives);
+    render_hp_meter(state.hp);
+    render_fireball_meter(state.fireball_meter);
+    // The boots icon is keyed on jump power; any value above the default works.
+    render_inventory(state.firepower, state.has_corkscrew, state.has_door_key,
+                    state.has_teleport_wand, state.has_lantern, state.has_gems,
+                    state.has_crown, state.has_gold, state.has_boots ? 5 : 4);
+    g_graphics->flush_sprite_batch();
+}
+
+bool UISystem::rebuild_hud_cache(const HudState& state) {
+    SDL_Renderer* renderer = g_graphics->get_renderer();
+    if (!renderer || hud_cache_unsupported) {
+        return false;
+    }
+
+    if (hud_cache == nullptr) {
+        if (!SDL_RenderTargetSupported(renderer)) {
+            std::cerr << "Warning: Render targets unsupported; drawing HUD directly" << std::endl;
+            hud_cache_unsupported = true;
+            return false;
+        }
+
+        hud_cache = SDL_CreateTexture(
+            renderer,
+            SDL_PIXELFORMAT_RGBA32,
+            SDL_TEXTUREACCESS_TARGET,
+            EGA_WIDTH,
+            EGA_HEIGHT);
+        if (hud_cache == nullptr) {
+            std::cerr << "Warning: Failed to create HUD cache texture: "
+                      << SDL_GetError() << std::endl;
+            hud_cache_unsupported = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(hud_cache, SDL_BLENDMODE_BLEND);
+    }
+
+    // The caller draws the HUD under a viewport and scale; switching targets
+    // loses both, so save them. The viewport is reported in scaled units, so
+    // restore the scale first.
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+    SDL_Rect previous_viewport;
+    SDL_RenderGetViewport(renderer, &previous_viewport);
+    float previous_scale_x = 1.0f;
+    float previous_scale_y = 1.0f;
+    SDL_RenderGetScale(renderer, &previous_scale_x, &previous_scale_y);
+    Uint8 prev_r = 0, prev_g = 0, prev_b = 0, prev_a = 0;
+    SDL_GetRenderDrawColor(renderer, &prev_r, &prev_g, &prev_b, &prev_a);
+
+    if (SDL_SetRenderTarget(renderer, hud_cache) != 0) {
+        std::cerr << "Warning: Failed to bind HUD cache target: "
+                  << SDL_GetError() << std::endl;
+        SDL_DestroyTexture(hud_cache);
+        hud_cache = nullptr;
+        hud_cache_unsupported = true;
+        return false;
+    }
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_RenderSetViewport(renderer, nullptr);
+
+    // Transparent clear: the HUD background is part of the stage frame.
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    draw_hud(state);
+
+    SDL_SetRenderTarget(renderer, previous_target);
+    SDL_RenderSetScale(renderer, previous_scale_x, previous_scale_y);
+    SDL_RenderSetViewport(renderer, &previous_viewport);
+    SDL_SetRenderDrawColor(renderer, prev_r, prev_g, prev_b, prev_a);
+
+    hud_cache_state = state;
+    hud_cache_valid = true;
+    return true;
 }
 
 void UISystem::render_score(const uint8_t score_bytes[3]) {
@@ -324,7 +458,7 @@ void UISystem::render_lives(uint8_t num_lives) {
     // Position: Y=180, X=48 + (life_count × 24) pixels
     // MAX_NUM_LIVES = 5
     
-    if (!life_icon_bright || !life_icon_dark) return;
+    if (life_icon_bright == INVALID_SPRITE_ID || life_icon_dark == INVALID_SPRITE_ID) return;
     
     constexpr uint8_t MAX_NUM_LIVES = 5;
     constexpr int START_X = 48;
@@ -350,7 +484,7 @@ void UISystem::render_hp_meter(uint8_t hp) {
     // Cell with index 'cell' shows full if hp > cell (i.e., hp >= cell + 1), otherwise empty
     // hp range: 0-6 (MAX_HP = 6)
     
-    if (!meter_full || !meter_empty) return;
+    if (meter_full == INVALID_SPRITE_ID || meter_empty == INVALID_SPRITE_ID) return;
     constexpr int METER_Y = 82;
     constexpr int CELL_WIDTH = 8;
     constexpr uint8_t MAX_CELLS = 6;
@@ -376,7 +510,8 @@ void UISystem::render_fireball_meter(uint8_t meter) {
     // Meter mapping: cells represent meter value pairs (1-2, 3-4, 5-6, etc.)
     // Odd meter values → half cell, even meter values → full cell
     
-    if (!meter_full || !meter_half || !meter_empty) return;
+    if (meter_full == INVALID_SPRITE_ID || meter_half == INVALID_SPRITE_ID ||
+        meter_empty == INVALID_SPRITE_ID) return;
     
     constexpr int METER_Y = 54;
     constexpr int CELL_WIDTH = 8;
@@ -541,6 +676,75 @@ void UISystem::score_bytes_to_digits(const uint8_t score_bytes[3], uint8_t digit
     }
 }
 
+/**
+ * Collect the HUD inputs into a comparable HudState.
+ *
+ * Inventory icons alternate even/odd frames every tick, so the animation
+ * frame is part of the state, but only while at least one icon is visible;
+ * with an empty inventory the cached HUD stays valid across ticks.
+ *
+ * @param animation_counter Inventory animation counter (see update())
+ * @return HudState; equal states draw identical HUDs
+ */
+HudState UISystem::make_hud_state(
+    const uint8_t score_bytes[3],
+    uint8_t num_lives,
+    uint8_t hp,
+    uint8_t fireball_meter,
+    uint8_t firepower,
+    bool has_corkscrew,
+    bool has_door_key,
+    bool has_teleport_wand,
+    bool has_lantern,
+    bool has_gems,
+    bool has_crown,
+    bool has_gold,
+    uint8_t jump_power,
+    uint8_t animation_counter)
+{
+    HudState state;
+    for (int i = 0; i < 3; i++) {
+        state.score_bytes[i] = score_bytes[i];
+    }
+    state.num_lives = num_lives;
+    state.hp = hp;
+    state.fireball_meter = fireball_meter;
+    state.firepower = firepower;
+    state.has_corkscrew = has_corkscrew;
+    state.has_door_key = has_door_key;
+    state.has_teleport_wand = has_teleport_wand;
+    state.has_lantern = has_lantern;
+    state.has_gems = has_gems;
+    state.has_crown = has_crown;
+    state.has_gold = has_gold;
+    state.has_boots = has_boots(jump_power);
+
+    const bool any_item_shown = firepower > 0 || has_corkscrew || has_door_key ||
+                                has_teleport_wand || has_lantern || has_gems ||
+                                has_crown || has_gold || state.has_boots;
+    state.inventory_frame = any_item_shown ? (animation_counter % 2) : 0;
+    return state;
+}
+
+bool HudState::operator==(const HudState& other) const {
+    return score_bytes[0] == other.score_bytes[0] &&
+           score_bytes[1] == other.score_bytes[1] &&
+           score_bytes[2] == other.score_bytes[2] &&
+           num_lives == other.num_lives &&
+           hp == other.hp &&
+           fireball_meter == other.fireball_meter &&
+           firepower == other.firepower &&
+           has_corkscrew == other.has_corkscrew &&
+           has_door_key == other.has_door_key &&
+           has_teleport_wand == other.has_teleport_wand &&
+           has_lantern == other.has_lantern &&
+           has_gems == other.has_gems &&
+           has_crown == other.has_crown &&
+           has_gold == other.has_gold &&
+           has_boots == other.has_boots &&
+           inventory_frame == other.inventory_frame;
+}
+
 /**
  * Determine the display state of a fireball meter cell.
  * 
@@ -2,28 +2,27 @@
 #include "test_cases.h"
 #include <vector>
 
-static void setup_test_enemy(std::vector<enemy_t>& enemies, int index, uint8_t behavior) {
-    enemy_t& enemy = enemies[index];
-    enemy.state = ENEMY_STATE_DESPAWNED;
-    enemy.spawn_timer_and_animation = 0;  // Ready to spawn
-    enemy.x = 0;
-    enemy.y = 0;
-    enemy.x_vel = 0;
-    enemy.y_vel = 0;
-    enemy.behavior = behavior;
-    enemy.num_animation_frames = 2;
-    enemy.facing = ENEMY_FACING_LEFT;
-    enemy.restraint = (behavior & ENEMY_BEHAVIOR_FAST) ? 
-                      ENEMY_RESTRAINT_MOVE_EVERY_TICK : 
-                      ENEMY_RESTRAINT_MOVE_THIS_TICK;
-    enemy.sprite_descriptor = nullptr;   // Tests don't need actual level data
-    enemy.animation_data = nullptr;      // Tests don't need actual sprite data
+static void setup_test_enemy(EnemyPool& enemies, int index, uint8_t behavior) {
+    enemies.state[index] = ENEMY_STATE_DESPAWNED;
+    enemies.spawn_timer_and_animation[index] = 0;  // Ready to spawn
+    enemies.x[index] = 0;
+    enemies.y[index] = 0;
+    enemies.x_vel[index] = 0;
+    enemies.y_vel[index] = 0;
+    enemies.behavior[index] = behavior;
+    enemies.num_animation_frames[index] = 2;
+    enemies.facing[index] = ENEMY_FACING_LEFT;
+    enemies.restraint[index] = (behavior & ENEMY_BEHAVIOR_FAST) ? 
+                               ENEMY_RESTRAINT_MOVE_EVERY_TICK : 
+                               ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    enemies.sprite_descriptor[index] = nullptr;   // Tests don't need actual level data
+    enemies.animation_data[index] = nullptr;      // Tests don't need actual sprite data
 }
 
 static void reset_actor_state(ActorSystem& actor_system) {
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
-    for (auto& enemy : enemies) {
-        enemy.state = ENEMY_STATE_DESPAWNED;
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
+    for (uint8_t& state : enemies.state) {
+        state = ENEMY_STATE_DESPAWNED;
     }
     auto& fireballs = const_cast<std::vector<fireball_t>&>(actor_system.get_fireballs());
     for (auto& fireball : fireballs) {
@@ -38,7 +37,7 @@ void test_actor_spawn_one_per_tick() {
     actor_system.initialize();
     reset_actor_state(actor_system);
     
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     // Set up 4 enemies ready to spawn
     for (int i = 0; i < MAX_NUM_ENEMIES; i++) {
@@ -53,11 +52,11 @@ void test_actor_spawn_one_per_tick() {
     }
     
     // First update - should spawn exactly 1 enemy
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x);
     
     int spawned = 0;
-    for (const auto& enemy : enemies) {
-        if (enemy.state == ENEMY_STATE_SPAWNED) spawned++;
+    for (uint8_t state : enemies.state) {
+        if (state == ENEMY_STATE_SPAWNED) spawned++;
     }
     check(spawned == 1, "actor_spawn: should spawn exactly 1 enemy per tick");
     
@@ -75,7 +74,7 @@ void test_actor_spawn_offset_cycling() {
             tiles[tile_y * 128 + tile_x] = 0x40;
         }
     }
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     // Spawn offset should cycle: 24→26→28→30→24...
     std::vector<uint8_t> spawn_positions;
@@ -85,10 +84,10 @@ void test_actor_spawn_offset_cycling() {
         setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
         
         // Trigger spawn
-        actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x);
+        actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x);
         
-        if (enemies[0].state == ENEMY_STATE_SPAWNED) {
-            spawn_positions.push_back(enemies[0].x);
+        if (enemies.state[0] == ENEMY_STATE_SPAWNED) {
+            spawn_positions.push_back(enemies.x[0]);
         }
     }
     
@@ -112,23 +111,23 @@ void test_actor_despawn_distance() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     // Manually spawn enemy
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
-    enemies[0].state = ENEMY_STATE_SPAWNED;
-    enemies[0].x = comic_x;
-    enemies[0].y = static_cast<uint8_t>(comic_y - 2);
-    enemies[0].restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
+    enemies.x[0] = test_game.comic_x;
+    enemies.y[0] = static_cast<uint8_t>(test_game.comic_y - 2);
+    enemies.restraint[0] = ENEMY_RESTRAINT_SKIP_THIS_TICK;
     
-    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
-    check(enemies[0].state == ENEMY_STATE_SPAWNED, "actor_despawn: enemy should remain spawned when close");
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
+    check(enemies.state[0] == ENEMY_STATE_SPAWNED, "actor_despawn: enemy should remain spawned when close");
     
     // Move Comic far away (> ENEMY_DESPAWN_RADIUS = 30)
-    comic_x += 35;
-    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+    test_game.comic_x += 35;
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     
-    check(enemies[0].state == ENEMY_STATE_DESPAWNED, "actor_despawn: enemy should despawn when far from Comic");
+    check(enemies.state[0] == ENEMY_STATE_DESPAWNED, "actor_despawn: enemy should despawn when far from Comic");
     
     delete[] tiles;
 }
@@ -140,19 +139,19 @@ void test_actor_player_collision() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     // Manually position enemy at Comic's location to trigger collision
     //Collision box: horizontal abs(enemy.x - comic.x) <= 1, vertical 0 <= (enemy.y - comic.y) < 4
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
-    enemies[0].state = ENEMY_STATE_SPAWNED;
-    enemies[0].x = comic_x;
-    enemies[0].y = static_cast<uint8_t>(comic_y + 1);
-    enemies[0].restraint = ENEMY_RESTRAINT_SKIP_THIS_TICK;
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
+    enemies.x[0] = test_game.comic_x;
+    enemies.y[0] = static_cast<uint8_t>(test_game.comic_y + 1);
+    enemies.restraint[0] = ENEMY_RESTRAINT_SKIP_THIS_TICK;
     
-    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     
-    check(enemies[0].state == ENEMY_STATE_RED_SPARK, "actor_collision: enemy should enter RED_SPARK state on collision");
+    check(enemies.state[0] == ENEMY_STATE_RED_SPARK, "actor_collision: enemy should enter RED_SPARK state on collision");
     
     delete[] tiles;
 }
@@ -164,22 +163,22 @@ void test_actor_death_animation() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
-    enemies[0].state = ENEMY_STATE_RED_SPARK;
+    enemies.state[0] = ENEMY_STATE_RED_SPARK;
     
     // Advance through animation frames (RED_SPARK: 8→9→10→11→12→13)
     for (int i = 0; i < 5; i++) {
-        actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+        actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     }
     
-    check(enemies[0].state != ENEMY_STATE_DESPAWNED, "actor_death_anim: should still be in death animation");
+    check(enemies.state[0] != ENEMY_STATE_DESPAWNED, "actor_death_anim: should still be in death animation");
     
     // One more tick should complete the animation
-    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     
-    check(enemies[0].state == ENEMY_STATE_DESPAWNED, "actor_death_anim: should despawn after animation completes");
+    check(enemies.state[0] == ENEMY_STATE_DESPAWNED, "actor_death_anim: should despawn after animation completes");
     
     delete[] tiles;
 }
@@ -191,21 +190,21 @@ void test_actor_respawn_timer_cycling() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
     
     // Complete death animation to trigger despawn
-    enemies[0].state = ENEMY_STATE_RED_SPARK + 5;
-    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+    enemies.state[0] = ENEMY_STATE_RED_SPARK + 5;
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     
-    check(enemies[0].state == ENEMY_STATE_DESPAWNED, "actor_respawn_cycle: should despawn after death");    
-    uint8_t timer1 = enemies[0].spawn_timer_and_animation;
+    check(enemies.state[0] == ENEMY_STATE_DESPAWNED, "actor_respawn_cycle: should despawn after death");    
+    uint8_t timer1 = enemies.spawn_timer_and_animation[0];
     
     // Trigger another death to advance the cycle
-    enemies[0].state = ENEMY_STATE_RED_SPARK + 5;
-    actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
-    uint8_t timer2 = enemies[0].spawn_timer_and_animation;
+    enemies.state[0] = ENEMY_STATE_RED_SPARK + 5;
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
+    uint8_t timer2 = enemies.spawn_timer_and_animation[0];
     
     // Timer should increase: 20→40→60→80→100→20
     check(timer2 > timer1 || (timer1 == 100 && timer2 == 20), 
@@ -221,20 +220,20 @@ void test_actor_animation_frames() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
-    enemies[0].num_animation_frames = 4;  // 4-frame animation
-    enemies[0].state = ENEMY_STATE_SPAWNED;
-    enemies[0].spawn_timer_and_animation = 0;
+    enemies.num_animation_frames[0] = 4;  // 4-frame animation
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
+    enemies.spawn_timer_and_animation[0] = 0;
     
     // Advance animation
     for (int i = 0; i < 5; i++) {
-        actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+        actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     }
     
     // Animation should loop (frame 0, 1, 2, 3, 0...)
-    check(enemies[0].spawn_timer_and_animation < 4, 
+    check(enemies.spawn_timer_and_animation[0] < 4, 
           "actor_animation: frame index should stay within num_animation_frames");
     
     delete[] tiles;
@@ -247,30 +246,30 @@ void test_actor_behavior_bounce_movement() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     // Set up BOUNCE enemy
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
-    enemies[0].state = ENEMY_STATE_SPAWNED;
-    enemies[0].x = 10;
-    enemies[0].y = 10;
-    enemies[0].x_vel = 1;  // Moving right
-    enemies[0].y_vel = -1; // Moving up
-    enemies[0].restraint = ENEMY_RESTRAINT_MOVE_THIS_TICK;
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
+    enemies.x[0] = 10;
+    enemies.y[0] = 10;
+    enemies.x_vel[0] = 1;  // Moving right
+    enemies.y_vel[0] = -1; // Moving up
+    enemies.restraint[0] = ENEMY_RESTRAINT_MOVE_THIS_TICK;
 
-    comic_x = 0;
-    comic_y = 0;
+    test_game.comic_x = 0;
+    test_game.comic_y = 0;
     
-    uint8_t start_x = enemies[0].x;
-    uint8_t start_y = enemies[0].y;
+    uint8_t start_x = enemies.x[0];
+    uint8_t start_y = enemies.y[0];
     
     // Run a few ticks
     for (int i = 0; i < 5; i++) {
-        actor_system.update(comic_x, comic_y, comic_facing, tiles, camera_x);
+        actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles, test_game.camera_x);
     }
     
     // Enemy should have moved (BOUNCE behavior causes diagonal movement)
-    bool moved = (enemies[0].x != start_x) || (enemies[0].y != start_y);
+    bool moved = (enemies.x[0] != start_x) || (enemies.y[0] != start_y);
     check(moved, "actor_bounce: enemy should move in diagonal pattern");
     
     delete[] tiles;
@@ -283,20 +282,20 @@ void test_actor_restraint_throttling() {
     reset_actor_state(actor_system);
     
     const uint8_t* tiles = new uint8_t[128 * 10]();
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     
     // Slow enemy (no FAST flag)
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
-    enemies[0].state = ENEMY_STATE_SPAWNED;
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
     
     // Fast enemy (FAST flag set)
     setup_test_enemy(enemies, 1, ENEMY_BEHAVIOR_BOUNCE | ENEMY_BEHAVIOR_FAST);
-    enemies[1].state = ENEMY_STATE_SPAWNED;
+    enemies.state[1] = ENEMY_STATE_SPAWNED;
     
     // Check restraint values
-    check(enemies[0].restraint == ENEMY_RESTRAINT_MOVE_THIS_TICK, 
+    check(enemies.restraint[0] == ENEMY_RESTRAINT_MOVE_THIS_TICK, 
           "actor_restraint: slow enemy should have MOVE_THIS_TICK");
-    check(enemies[1].restraint == ENEMY_RESTRAINT_MOVE_EVERY_TICK, 
+    check(enemies.restraint[1] == ENEMY_RESTRAINT_MOVE_EVERY_TICK, 
           "actor_restraint: fast enemy should have MOVE_EVERY_TICK");
     
     delete[] tiles;
@@ -311,18 +310,18 @@ void test_fireball_meter_depletion_timing() {
     actor_system.comic_firepower = 1;
     actor_system.fireball_meter = 3;
 
-    comic_x = 10;
-    comic_y = 10;
-    comic_facing = COMIC_FACING_RIGHT;
-    camera_x = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 0;
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 1);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 1);
     check(actor_system.fireball_meter == 2, "fireball_meter: should decrement on first firing tick");
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 1);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 1);
     check(actor_system.fireball_meter == 2, "fireball_meter: should not decrement on second firing tick");
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 1);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 1);
     check(actor_system.fireball_meter == 1, "fireball_meter: should decrement on third firing tick");
 }
 
@@ -332,16 +331,16 @@ void test_fireball_meter_recharge_timing() {
     actor_system.initialize();
 
     std::vector<uint8_t> tiles(128 * 10, 0);
-    comic_x = 10;
-    comic_y = 10;
-    comic_facing = COMIC_FACING_RIGHT;
-    camera_x = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 0;
 
     // Advance once so the counter reaches the recharge phase.
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 0);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 0);
     actor_system.fireball_meter = 10;
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 0);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 0);
     check(actor_system.fireball_meter == 11, "fireball_meter: should recharge every other tick when idle");
 }
 
@@ -352,10 +351,10 @@ void test_fireball_offscreen_deactivates() {
 
     std::vector<uint8_t> tiles(128 * 10, 0);
     actor_system.comic_firepower = 1;
-    comic_x = 10;
-    comic_y = 10;
-    comic_facing = COMIC_FACING_LEFT;
-    camera_x = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_LEFT;
+    test_game.camera_x = 0;
 
     auto& fireballs = const_cast<std::vector<fireball_t>&>(actor_system.get_fireballs());
     fireballs[0].x = 1;
@@ -365,7 +364,7 @@ void test_fireball_offscreen_deactivates() {
     fireballs[0].animation = 0;
     fireballs[0].num_animation_frames = FIREBALL_NUM_FRAMES;
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 0);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 0);
     check(fireballs[0].x == FIREBALL_DEAD && fireballs[0].y == FIREBALL_DEAD,
           "fireball_offscreen: should deactivate when leaving camera bounds");
 }
@@ -377,10 +376,10 @@ void test_fireball_collision_sets_white_spark() {
 
     std::vector<uint8_t> tiles(128 * 10, 0);
     actor_system.comic_firepower = 1;
-    comic_x = 10;
-    comic_y = 0;
-    comic_facing = COMIC_FACING_RIGHT;
-    camera_x = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 0;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 0;
 
     auto& fireballs = const_cast<std::vector<fireball_t>&>(actor_system.get_fireballs());
     fireballs[0].x = 10;
@@ -390,15 +389,15 @@ void test_fireball_collision_sets_white_spark() {
     fireballs[0].animation = 0;
     fireballs[0].num_animation_frames = FIREBALL_NUM_FRAMES;
 
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
-    enemies[0].state = ENEMY_STATE_SPAWNED;
-    enemies[0].x = 10;
-    enemies[0].y = 5;
-    enemies[0].behavior = 0;
-    enemies[0].num_animation_frames = 0;
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
+    enemies.x[0] = 10;
+    enemies.y[0] = 5;
+    enemies.behavior[0] = 0;
+    enemies.num_animation_frames[0] = 0;
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 0);
-    check(enemies[0].state == ENEMY_STATE_WHITE_SPARK,
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 0);
+    check(enemies.state[0] == ENEMY_STATE_WHITE_SPARK,
           "fireball_collision: enemy should enter WHITE_SPARK on hit");
     check(fireballs[0].x == FIREBALL_DEAD && fireballs[0].y == FIREBALL_DEAD,
           "fireball_collision: fireball should deactivate on hit");
@@ -412,10 +411,10 @@ void test_fireball_corkscrew_motion() {
     std::vector<uint8_t> tiles(128 * 10, 0);
     actor_system.comic_firepower = 1;
     actor_system.comic_has_corkscrew = 1;
-    comic_x = 10;
-    comic_y = 10;
-    comic_facing = COMIC_FACING_RIGHT;
-    camera_x = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 0;
 
     auto& fireballs = const_cast<std::vector<fireball_t>&>(actor_system.get_fireballs());
     fireballs[0].x = 10;
@@ -425,11 +424,11 @@ void test_fireball_corkscrew_motion() {
     fireballs[0].animation = 0;
     fireballs[0].num_animation_frames = FIREBALL_NUM_FRAMES;
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 0);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 0);
     check(fireballs[0].y == 6 && fireballs[0].corkscrew_phase == 1,
           "fireball_corkscrew: should move down and flip to phase 1");
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x, 0);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x, 0);
     check(fireballs[0].y == 5 && fireballs[0].corkscrew_phase == 2,
           "fireball_corkscrew: should move up and flip to phase 2");
 }
@@ -446,17 +445,17 @@ void test_item_collection_tracking() {
           "item_collection: should not have boots initially");
 
     // Simulate collecting Blastola Cola
-    actor_system.apply_item_effect(ITEM_BLASTOLA_COLA);
+    actor_system.apply_item_effect(test_game, ITEM_BLASTOLA_COLA);
     check(actor_system.comic_firepower == 1, 
           "item_collection: Blastola Cola should increase firepower to 1");
 
     // Collect second Blastola Cola
-    actor_system.apply_item_effect(ITEM_BLASTOLA_COLA);
+    actor_system.apply_item_effect(test_game, ITEM_BLASTOLA_COLA);
     check(actor_system.comic_firepower == 2, 
           "item_collection: second Blastola Cola should increase firepower to 2");
 
     // Collect Boots
-    actor_system.apply_item_effect(ITEM_BOOTS);
+    actor_system.apply_item_effect(test_game, ITEM_BOOTS);
     check(actor_system.comic_has_boots == 1, 
           "item_collection: should have boots after collection");
 }
@@ -467,11 +466,11 @@ void test_actor_door_key_sync() {
     actor_system.initialize();
 
     // Reset global state
-    comic_has_door_key = 0;
+    test_game.comic_has_door_key = 0;
 
-    actor_system.apply_item_effect(ITEM_DOOR_KEY);
+    actor_system.apply_item_effect(test_game, ITEM_DOOR_KEY);
     check(actor_system.comic_has_door_key == 1, "actor system should have door key flag set");
-    check(comic_has_door_key == 1, "global door key variable should be synced by ActorSystem");
+    check(test_game.comic_has_door_key == 1, "global door key variable should be synced by ActorSystem");
 }
 
 void test_actor_spawn_avoids_solid_tiles() {
@@ -491,22 +490,68 @@ void test_actor_spawn_avoids_solid_tiles() {
         tiles[tile_y * 128 + spawn_tile_x] = 0x40;
     }
 
-    comic_x = 10;
-    comic_y = 10;
-    comic_facing = COMIC_FACING_RIGHT;
-    camera_x = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 0;
 
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x);
 
-    check(enemies[0].state == ENEMY_STATE_SPAWNED,
+    check(enemies.state[0] == ENEMY_STATE_SPAWNED,
           "actor_spawn_solidity: enemy should spawn when a valid spawn column exists");
-    check(!actor_system.is_tile_solid(actor_system.get_tile_at(enemies[0].x, enemies[0].y)),
+    check(!actor_system.is_tile_solid(actor_system.get_tile_at(enemies.x[0], enemies.y[0])),
           "actor_spawn_solidity: spawned enemy should not be placed inside a solid tile");
 }
 
+void test_actor_door_tiles_stay_solid_for_enemies() {
+    reset_physics_state();
+    ActorSystem actor_system;
+    actor_system.initialize();
+    reset_actor_state(actor_system);
+
+    // Doors are passable for the player but, as in the original, solid for enemies
+    level_t level{};
+    level.tileset_last_passable = 0x20;
+    level.door_tile_ul = 0x30;
+    level.door_tile_ur = 0x30;
+    level.door_tile_ll = 0x30;
+    level.door_tile_lr = 0x30;
+    for (stage_t& stage : level.stages) {
+        for (enemy_record_t& record : stage.enemies) {
+            record.behavior = ENEMY_BEHAVIOR_UNUSED;
+        }
+    }
+    actor_system.setup_enemies_for_stage(&level, 0, 0, nullptr);
+
+    std::vector<uint8_t> tiles(128 * 10, 0x30);
+    const int spawn_tile_x = 13;
+    for (int tile_y = 0; tile_y <= 3; ++tile_y) {
+        tiles[tile_y * 128 + spawn_tile_x] = 0x00;
+    }
+    set_level_solidity(test_game, &level);
+    test_game.stage_collision.build(tiles.data(), test_game.level_solidity);
+    check(!is_tile_solid(test_game, 0x30), "actor_door_solidity: door tiles should be passable for the player");
+
+    test_game.comic_x = 10;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 0;
+
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
+    setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_BOUNCE);
+
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x);
+
+    check(enemies.state[0] == ENEMY_STATE_SPAWNED,
+          "actor_door_solidity: enemy should spawn on a floor of door tiles");
+    check(actor_system.get_tile_at(enemies.x[0], enemies.y[0]) == 0x00,
+          "actor_door_solidity: enemy should spawn in the open column above the door tiles");
+    reset_level_tiles(test_game);
+}
+
 void test_actor_pit_fall_despawns_without_spark() {
     reset_physics_state();
     ActorSystem actor_system;
@@ -514,28 +559,94 @@ void test_actor_pit_fall_despawns_without_spark() {
     reset_actor_state(actor_system);
 
     std::vector<uint8_t> tiles(128 * 10, 0x00); // passable map so pit behavior is reachable
-    auto& enemies = const_cast<std::vector<enemy_t>&>(actor_system.get_enemies());
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
 
     setup_test_enemy(enemies, 0, ENEMY_BEHAVIOR_ROLL);
-    enemies[0].state = ENEMY_STATE_SPAWNED;
-    enemies[0].x = 12;
-    enemies[0].y = static_cast<uint8_t>(PLAYFIELD_HEIGHT - 3);
-    enemies[0].y_vel = 1;
-    enemies[0].restraint = ENEMY_RESTRAINT_MOVE_EVERY_TICK;
+    enemies.state[0] = ENEMY_STATE_SPAWNED;
+    enemies.x[0] = 12;
+    enemies.y[0] = static_cast<uint8_t>(PLAYFIELD_HEIGHT - 3);
+    enemies.y_vel[0] = 1;
+    enemies.restraint[0] = ENEMY_RESTRAINT_MOVE_EVERY_TICK;
 
-    actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x);
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x);
 
-        check(enemies[0].state == ENEMY_STATE_PIT_FALL_SENTINEL,
+        check(enemies.state[0] == ENEMY_STATE_PIT_FALL_SENTINEL,
             "actor_pit_fall: enemy should enter pit-fall sentinel (no spark) at bottom edge");
-        check(enemies[0].y == PLAYFIELD_HEIGHT - 2,
+        check(enemies.y[0] == PLAYFIELD_HEIGHT - 2,
             "actor_pit_fall: enemy should clamp to the bottom of the playfield before despawn");
 
-        actor_system.update(comic_x, comic_y, comic_facing, tiles.data(), camera_x);
+        actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing, tiles.data(), test_game.camera_x);
 
-        check(enemies[0].state == ENEMY_STATE_DESPAWNED,
+        check(enemies.state[0] == ENEMY_STATE_DESPAWNED,
             "actor_pit_fall: enemy should despawn on the tick after bottom-edge clamp");
 }
 
+void test_actor_pool_broadphase() {
+    ActorGrid grid;
+    grid.clear(3);
+    grid.insert(0, 5, 5);
+    grid.insert(1, 7, 6);
+    grid.insert(2, 5, 30);  // Below the map: shares the bottom row
+    int in_cell = 0;
+    for (int slot = grid.first(ActorGrid::cell_of(4, 4)); slot >= 0; slot = grid.next(slot)) {
+        in_cell |= 1 << slot;
+    }
+    check(in_cell == 3, "actor_pool: a cell should hold the slots inserted in it");
+    check(grid.first(ActorGrid::cell_of(6, 200)) == 2 && grid.next(2) < 0,
+          "actor_pool: points below the map should share the bottom row");
+
+    reset_physics_state();
+    ActorSystem default_system;
+    check(default_system.get_max_enemies() == MAX_NUM_ENEMIES &&
+          default_system.get_max_fireballs() == MAX_NUM_FIREBALLS,
+          "actor_pool: the default pool should have the original limits");
+
+    ActorSystem actor_system(24, 8);
+    actor_system.initialize();
+    reset_actor_state(actor_system);
+    check(actor_system.get_max_enemies() == 24 && actor_system.get_fireballs().size() == 8,
+          "actor_pool: the pool should take the configured limits");
+
+    std::vector<uint8_t> tiles(128 * 10, 0x00);
+    test_game.comic_x = 100;
+    test_game.comic_y = 10;
+    test_game.comic_facing = COMIC_FACING_RIGHT;
+    test_game.camera_x = 90;
+    test_game.comic_hp = MAX_HP;
+    actor_system.comic_firepower = 1;
+
+    auto& enemies = const_cast<EnemyPool&>(actor_system.get_enemies());
+    auto place_enemy = [&](int slot, uint8_t x, uint8_t y) {
+        setup_test_enemy(enemies, slot, 0);  // No behavior: stays put
+        enemies.state[slot] = ENEMY_STATE_SPAWNED;
+        enemies.num_animation_frames[slot] = 0;
+        enemies.spawn_timer_and_animation[slot] = 100;
+        enemies.x[slot] = x;
+        enemies.y[slot] = y;
+    };
+    place_enemy(10, 104, 6);
+    place_enemy(17, 105, 6);
+    place_enemy(20, 96, 8);
+    place_enemy(22, 100, 11);
+    place_enemy(3, 100, 16);
+
+    auto& fireballs = const_cast<std::vector<fireball_t>&>(actor_system.get_fireballs());
+    fireballs[0] = fireball_t{6, 105, 0, 2, 0, FIREBALL_NUM_FRAMES};
+    fireballs[6] = fireball_t{9, 95, 0, 2, 0, FIREBALL_NUM_FRAMES};
+
+    actor_system.update(test_game, test_game.comic_x, test_game.comic_y, test_game.comic_facing,
+                        tiles.data(), test_game.camera_x);
+
+    check(enemies.state[10] == ENEMY_STATE_WHITE_SPARK && enemies.state[17] == ENEMY_STATE_SPAWNED,
+          "actor_pool: a fireball over two enemies should hit the lower slot only");
+    check(enemies.state[20] == ENEMY_STATE_WHITE_SPARK && fireballs[6].x == FIREBALL_DEAD,
+          "actor_pool: fireballs should hit enemies in the next grid cell");
+    check(enemies.state[22] == ENEMY_STATE_RED_SPARK && test_game.comic_hp == MAX_HP - 1,
+          "actor_pool: enemies past the original slots should hit Comic");
+    check(enemies.state[3] == ENEMY_STATE_SPAWNED,
+          "actor_pool: enemies clear of Comic and the fireballs should be left alone");
+}
+
 void test_item_blastola_cola_firepower() {
     reset_physics_state();
     ActorSystem actor_system;
@@ -547,13 +658,13 @@ void test_item_blastola_cola_firepower() {
 
     // Collect 5 Blastola Colas (max firepower)
     for (int i = 0; i < 5; i++) {
-        actor_system.apply_item_effect(ITEM_BLASTOLA_COLA);
+        actor_system.apply_item_effect(test_game, ITEM_BLASTOLA_COLA);
     }
     check(actor_system.comic_firepower == 5, 
           "blastola_cola: should reach max firepower of 5");
 
     // Try to collect a 6th (should not exceed max)
-    actor_system.apply_item_effect(ITEM_BLASTOLA_COLA);
+    actor_system.apply_item_effect(test_game, ITEM_BLASTOLA_COLA);
     check(actor_system.comic_firepower == 5, 
           "blastola_cola: firepower should not exceed 5");
 }
@@ -569,7 +680,7 @@ void test_item_boots_jump_power() {
           "boots_jump: should have default jump power initially");
 
     // Collect Boots
-    actor_system.apply_item_effect(ITEM_BOOTS);
+    actor_system.apply_item_effect(test_game, ITEM_BOOTS);
     int boots_jump_power = actor_system.get_jump_power();
     check(boots_jump_power == JUMP_POWER_WITH_BOOTS, 
           "boots_jump: should have increased jump power with boots");
@@ -585,7 +696,7 @@ void test_item_corkscrew_flag() {
     check(actor_system.comic_has_corkscrew == 0, 
           "corkscrew: should not have corkscrew initially");
 
-    actor_system.apply_item_effect(ITEM_CORKSCREW);
+    actor_system.apply_item_effect(test_game, ITEM_CORKSCREW);
     check(actor_system.comic_has_corkscrew == 1, 
           "corkscrew: should have corkscrew after collection");
 }
@@ -606,28 +717,28 @@ void test_item_treasure_counting() {
           "treasures: should not have gold initially");
 
     // Collect Gems
-    actor_system.apply_item_effect(ITEM_GEMS);
+    actor_system.apply_item_effect(test_game, ITEM_GEMS);
     check(actor_system.comic_has_gems == 1, 
           "treasures: should have gems after collection");
     check(actor_system.comic_num_treasures == 1, 
           "treasures: treasure count should be 1 after gems");
 
     // Collect Crown
-    actor_system.apply_item_effect(ITEM_CROWN);
+    actor_system.apply_item_effect(test_game, ITEM_CROWN);
     check(actor_system.comic_has_crown == 1, 
           "treasures: should have crown after collection");
     check(actor_system.comic_num_treasures == 2, 
           "treasures: treasure count should be 2 after crown");
 
     // Collect Gold
-    actor_system.apply_item_effect(ITEM_GOLD);
+    actor_system.apply_item_effect(test_game, ITEM_GOLD);
     check(actor_system.comic_has_gold == 1, 
           "treasures: should have gold after collection");
     check(actor_system.comic_num_treasures == 3, 
           "treasures: treasure count should be 3 after gold");
 
     // Collecting same treasure again should not increase count
-    actor_system.apply_item_effect(ITEM_GEMS);
+    actor_system.apply_item_effect(test_game, ITEM_GEMS);
     check(actor_system.comic_num_treasures == 3, 
           "treasures: duplicate collection should not increase count");
 }
@@ -640,55 +751,55 @@ void test_item_special_items() {
     // Door Key
     check(actor_system.comic_has_door_key == 0, 
           "special_items: should not have door key initially");
-    actor_system.apply_item_effect(ITEM_DOOR_KEY);
+    actor_system.apply_item_effect(test_game, ITEM_DOOR_KEY);
     check(actor_system.comic_has_door_key == 1, 
           "special_items: should have door key after collection");
 
     // Teleport Wand
     check(actor_system.comic_has_teleport_wand == 0, 
           "special_items: should not have teleport wand initially");
-    actor_system.apply_item_effect(ITEM_TELEPORT_WAND);
+    actor_system.apply_item_effect(test_game, ITEM_TELEPORT_WAND);
     check(actor_system.comic_has_teleport_wand == 1, 
           "special_items: should have teleport wand after collection");
 
     // Lantern
     check(actor_system.comic_has_lantern == 0, 
           "special_items: should not have lantern initially");
-    actor_system.apply_item_effect(ITEM_LANTERN);
+    actor_system.apply_item_effect(test_game, ITEM_LANTERN);
     check(actor_system.comic_has_lantern == 1, 
           "special_items: should have lantern after collection");
 
     // Shield (not full HP): schedule refill to MAX_HP
-    comic_num_lives = 2;
-    comic_hp = static_cast<uint8_t>(MAX_HP - 2);
-    comic_hp_pending_increase = 0;
-    actor_system.apply_item_effect(ITEM_SHIELD);
-    check(comic_hp_pending_increase == 2,
+    test_game.comic_num_lives = 2;
+    test_game.comic_hp = static_cast<uint8_t>(MAX_HP - 2);
+    test_game.comic_hp_pending_increase = 0;
+    actor_system.apply_item_effect(test_game, ITEM_SHIELD);
+    check(test_game.comic_hp_pending_increase == 2,
         "special_items: shield should schedule refill when HP is not full");
-    check(comic_num_lives == 2,
+    check(test_game.comic_num_lives == 2,
         "special_items: shield should not award extra life when HP is not full");
 
     // Shield (full HP, below cap): award extra life
-    comic_hp = MAX_HP;
-    comic_hp_pending_increase = 0;
-    actor_system.apply_item_effect(ITEM_SHIELD);
-    check(comic_num_lives == 3,
+    test_game.comic_hp = MAX_HP;
+    test_game.comic_hp_pending_increase = 0;
+    actor_system.apply_item_effect(test_game, ITEM_SHIELD);
+    check(test_game.comic_num_lives == 3,
         "special_items: shield should award extra life when HP is full");
-    check(comic_hp_pending_increase == 0,
+    check(test_game.comic_hp_pending_increase == 0,
         "special_items: full-HP shield below max lives should not schedule HP refill");
 
     // Shield (full HP, at cap): keep max lives and award comic-c bonus path.
-    comic_num_lives = 5;
-    comic_hp = MAX_HP;
-    comic_hp_pending_increase = 0;
-    score_bytes[0] = 0;
-    score_bytes[1] = 0;
-    score_bytes[2] = 0;
-    actor_system.apply_item_effect(ITEM_SHIELD);
-    check(comic_num_lives == 5,
+    test_game.comic_num_lives = 5;
+    test_game.comic_hp = MAX_HP;
+    test_game.comic_hp_pending_increase = 0;
+    test_game.score_bytes[0] = 0;
+    test_game.score_bytes[1] = 0;
+    test_game.score_bytes[2] = 0;
+    actor_system.apply_item_effect(test_game, ITEM_SHIELD);
+    check(test_game.comic_num_lives == 5,
         "special_items: shield at max lives should not increase life count");
-    check(comic_hp_pending_increase == MAX_HP,
+    check(test_game.comic_hp_pending_increase == MAX_HP,
         "special_items: shield at max lives should set pending HP refill");
-    check(score_bytes[0] == 25 && score_bytes[1] == 2 && score_bytes[2] == 0,
+    check(test_game.score_bytes[0] == 25 && test_game.score_bytes[1] == 2 && test_game.score_bytes[2] == 0,
         "special_items: shield at max lives should award 22500 points");
 }
@@ -0,0 +1,258 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/counters.h"
+#include "../include/fixed_vector.h"
+#include "../include/frame_arena.h"
+#include "../include/graphics.h"
+#include "../include/ui_system.h"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Allocation-counting hook: comic_tests replaces the global operator new, so
+// a test can tell whether the code it runs touched the heap. Counts are per
+// thread, so the asset decode workers do not show up in the test's count.
+// ---------------------------------------------------------------------------
+
+static thread_local uint64_t thread_heap_allocations = 0;
+
+uint64_t heap_allocations_on_this_thread() {
+    return thread_heap_allocations;
+}
+
+static void* counted_allocate(size_t size) {
+    ++thread_heap_allocations;
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+static void* counted_allocate_aligned(size_t size, std::align_val_t alignment) {
+    ++thread_heap_allocations;
+    const size_t align = static_cast<size_t>(alignment);
+    // aligned_alloc wants the size to be a multiple of the alignment
+    const size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+#ifdef _MSC_VER
+    void* block = _aligned_malloc(rounded, align);
+#else
+    void* block = std::aligned_alloc(align, rounded);
+#endif
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+// MSVC cannot free an _aligned_malloc block with free()
+static void free_aligned(void* block) {
+#ifdef _MSC_VER
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+void* operator new(size_t size) { return counted_allocate(size); }
+void* operator new[](size_t size) { return counted_allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return counted_allocate_aligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return counted_allocate_aligned(size, alignment); }
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+void operator delete[](void* block, size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { free_aligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { free_aligned(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { free_aligned(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { free_aligned(block); }
+
+// ---------------------------------------------------------------------------
+
+void test_frame_arena_bump_and_reset() {
+    reset_counters();
+    FrameArena arena(256);
+
+    void* small = arena.allocate(3, 1);
+    auto* wide = arena.allocate_array<uint64_t>(4);
+    check(small != nullptr && wide != nullptr, "frame_arena: allocations should fit");
+    check(reinterpret_cast<uintptr_t>(wide) % alignof(uint64_t) == 0, "frame_arena: arrays should be aligned");
+    check(arena.get_used() == 8 + 4 * sizeof(uint64_t), "frame_arena: used should include the alignment padding");
+
+    const char* text = arena.format("L%d S%d", 3, 2);
+    check(std::strcmp(text, "L3 S2") == 0, "frame_arena: format should print into the arena");
+
+    const size_t before_scope = arena.get_used();
+    {
+        FrameArenaScope scope(arena);
+        check(arena.allocate(64) != nullptr, "frame_arena: scoped allocation should fit");
+    }
+    check(arena.get_used() == before_scope, "frame_arena: a scope should rewind what it allocated");
+
+    check(arena.allocate(512) == nullptr, "frame_arena: an allocation past the end should fail");
+    check(std::strcmp(arena.format("%0300d", 1), "") == 0, "frame_arena: format past the end should be empty");
+    check(get_counter(Counter::FRAME_ARENA_OVERFLOWS) == 2, "frame_arena: failed allocations should be counted");
+
+    const size_t high_water = arena.get_high_water();
+    arena.reset();
+    check(arena.get_used() == 0 && arena.get_high_water() == high_water,
+          "frame_arena: reset should free everything but keep the high-water mark");
+    check(arena.allocate(256, 1) != nullptr, "frame_arena: the whole buffer should be usable after reset");
+
+    const uint64_t allocations_before = heap_allocations_on_this_thread();
+    std::unique_ptr<int> boxed(new int(7));
+    const uint64_t allocations = heap_allocations_on_this_thread() - allocations_before;
+    check(allocations == 1, "frame_arena: the allocation hook should see operator new");
+
+    FixedVector<int, 2> list = {1, 2, 3};
+    check(list.size() == 2 && list.full() && list[1] == 2, "fixed_vector: pushes past capacity should be dropped");
+    reset_counters();
+}
+
+// Run right and left, jumping and firing now and then
+static uint8_t allocation_route_keys(uint64_t tick) {
+    uint8_t keys = (tick / 120) % 2 == 0 ? INPUT_RIGHT : INPUT_LEFT;
+    if (tick % 25 < 3) {
+        keys |= INPUT_JUMP;
+    }
+    if (tick % 7 == 0) {
+        keys |= INPUT_FIRE;
+    }
+    return keys;
+}
+
+void test_zero_alloc_gameplay_ticks_after_warmup() {
+    static GameContext game;  // Static: a context is too large for some test thread stacks
+    game = GameContext();
+    game.actors.initialize();
+    game.actors.comic_firepower = 3;  // Fireballs in flight every few ticks
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
+
+    uint64_t tick = 0;
+    for (; tick < 300; ++tick) {
+        apply_input_keys(game, allocation_route_keys(tick));
+        run_gameplay_tick(game);
+    }
+
+    const uint64_t enemies_spawned = get_counter(Counter::ENEMIES_SPAWNED);
+    const uint64_t allocations_before = heap_allocations_on_this_thread();
+    for (; tick < 2000; ++tick) {
+        apply_input_keys(game, allocation_route_keys(tick));
+        if (run_gameplay_tick(game) != TickOutcome::Continue) {
+            break;
+        }
+    }
+    // Read the count before check(), whose message strings allocate
+    const uint64_t allocations = heap_allocations_on_this_thread() - allocations_before;
+    check(tick > 1000, "zero_alloc: the route should keep the game going");
+    check(get_counter(Counter::ENEMIES_SPAWNED) > enemies_spawned, "zero_alloc: enemies should respawn after warmup");
+    check(allocations == 0, "zero_alloc: gameplay ticks after warmup should not allocate");
+}
+
+void test_zero_alloc_render_frame_after_warmup() {
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        check(false, std::string("SDL video init failed: ") + SDL_GetError());
+        return;
+    }
+    SDL_Window* window = SDL_CreateWindow("test_zero_alloc", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                          640, 480, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : nullptr;
+    if (renderer == nullptr) {
+        check(false, std::string("SDL renderer creation failed: ") + SDL_GetError());
+        if (window) {
+            SDL_DestroyWindow(window);
+        }
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return;
+    }
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 4, 4);
+
+    // No assets in the test tree: an in-memory atlas stands in for the
+    // forest tileset, so every stage tile has something to draw
+    Tileset tileset;
+    tileset.atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                      TILESET_ATLAS_COLUMNS * TILE_SIZE,
+                                      TILESET_MAX_TILES / TILESET_ATLAS_COLUMNS * TILE_SIZE);
+    for (int tile = 0; tile < TILESET_MAX_TILES; ++tile) {
+        tileset.src_rects[tile] = {(tile % TILESET_ATLAS_COLUMNS) * TILE_SIZE,
+                                   (tile / TILESET_ATLAS_COLUMNS) * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+        tileset.present[tile] = true;
+    }
+    tileset.tile_count = TILESET_MAX_TILES;
+
+    {
+        static GameContext game;
+        game = GameContext();
+        game.actors.initialize();
+        load_starting_level(game);
+        sync_stage_enemies(game);
+
+        GraphicsSystem graphics(renderer);
+        graphics.initialize();
+        graphics.set_native_framebuffer_enabled(true);
+        GraphicsSystem* const previous_graphics = g_graphics;
+        g_graphics = &graphics;  // UISystem draws through the global
+        UISystem ui;
+        const Sprite sprite = {{texture, 4, 4}, 4, 4};
+        const SDL_Color white = {255, 255, 255, 255};
+        constexpr int render_scale = 8;
+
+        uint64_t allocations_before = 0;
+        for (int frame = 0; frame < 40; ++frame) {
+            if (frame == 10) {
+                allocations_before = heap_allocations_on_this_thread();
+            }
+            if (frame == 25) {
+                game.score_bytes[0]++;  // The HUD layer redraws mid-measurement
+            }
+            frame_arena().reset();
+            apply_input_keys(game, allocation_route_keys(static_cast<uint64_t>(frame)));
+            run_gameplay_tick(game);
+            ui.update();
+
+            // The gameplay frame of main(): stage, queued sprites, HUD, overlay
+            graphics.begin_frame();
+            graphics.render_stage_background(game, &tileset, game.camera_x, render_scale);
+            graphics.begin_sprite_batch();
+            game.actors.render_enemies(&graphics, game.camera_x, render_scale);
+            game.actors.render_fireballs(&graphics, game.camera_x, render_scale);
+            graphics.set_render_layer(RenderLayer::PLAYER);
+            graphics.render_sprite_centered_scaled((game.comic_x - game.camera_x) * render_scale,
+                                                   game.comic_y * render_scale, sprite,
+                                                   render_scale * 2, render_scale * 4);
+            graphics.flush_sprite_batch();
+            ui.render_hud(game.score_bytes, game.comic_num_lives, game.comic_hp, game.actors.fireball_meter,
+                          game.actors.comic_firepower, game.actors.comic_has_corkscrew != 0,
+                          game.comic_has_door_key != 0, game.actors.comic_has_teleport_wand != 0,
+                          game.actors.comic_has_lantern != 0, game.actors.comic_has_gems != 0,
+                          game.actors.comic_has_crown != 0, game.actors.comic_has_gold != 0,
+                          game.comic_jump_power);
+            graphics.render_text(8, 180, frame_arena().format("x=%d y=%d", game.comic_x, game.comic_y), white);
+            graphics.render_debug_overlay(game);
+            graphics.end_frame();
+            SDL_RenderPresent(renderer);
+        }
+        const uint64_t allocations = heap_allocations_on_this_thread() - allocations_before;
+        check(graphics.has_text_font(), "zero_alloc: text drawing needs a debug font to measure");
+        check(allocations == 0, "zero_alloc: render frames after warmup should not allocate");
+
+        ui.cleanup();
+        g_graphics = previous_graphics;
+    }
+
+    tileset.cleanup();
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+}
@@ -1,5 +1,6 @@
 #include "test_helpers.h"
 #include "test_cases.h"
+#include "../include/counters.h"
 
 #if defined(HAVE_SDL2_MIXER)
 #include <SDL2/SDL.h>
@@ -145,6 +146,134 @@ void test_audio_music_playback() {
     quit_sdl_audio();
 }
 
+void test_audio_low_latency_voice_pool() {
+    reset_physics_state();
+    check(init_sdl_audio(), "audio_low_latency: SDL audio init should succeed");
+    check(!set_audio_buffer_frames(64), "audio_low_latency: too small a buffer should be refused");
+    check(set_audio_buffer_frames(256), "audio_low_latency: 256-frame buffer should be accepted");
+    check(initialize_audio_system(), "audio_low_latency: initialization should succeed");
+    check(get_audio_latency_stats().low_latency, "audio_low_latency: stats should report the voice path");
+    check(Mix_Playing(0) == 0, "audio_low_latency: effects should not use SDL_mixer channels");
+
+    // Four effect voices: equal priorities overlap, the fifth steals the oldest
+    for (int i = 0; i < 5; ++i) {
+        check(play_game_sound(GameSound::FIRE), "audio_low_latency: FIRE should get a voice");
+    }
+    AudioLatencyStats stats = get_audio_latency_stats();
+    check(stats.voices_started == 5, "audio_low_latency: five voices should have started");
+    check(stats.voices_stolen == 1, "audio_low_latency: the fifth FIRE should steal a voice");
+
+    check(play_game_sound(GameSound::PLAYER_DIE), "audio_low_latency: higher priority should steal a voice");
+    check(!play_game_sound(GameSound::ENEMY_HIT),
+          "audio_low_latency: lower priority should be blocked while PLAYER_DIE sounds");
+    check(get_audio_latency_stats().sounds_rejected == 1, "audio_low_latency: rejection should be counted");
+
+    check(play_game_music(GameMusic::TITLE), "audio_low_latency: music should start on its own voice");
+    check(is_game_music_playing(), "audio_low_latency: music should report playing");
+    stop_game_music();
+    check(!is_game_music_playing(), "audio_low_latency: music should stop");
+
+    shutdown_audio_system();
+    check(set_audio_buffer_frames(0), "audio_low_latency: default path should be restorable");
+    quit_sdl_audio();
+}
+
+// The per-sample generator synthesis used before the run-based kernel, with
+// rests keeping their slot in the timeline instead of being dropped
+static std::vector<int16_t> reference_square_waves(const std::vector<FrequencyNote>& notes, int sample_rate,
+                                                   int channels) {
+    auto note_frames = [sample_rate](const FrequencyNote& note) {
+        const uint16_t duration_ms = static_cast<uint16_t>(note.duration_ticks * 55);
+        return static_cast<uint32_t>((static_cast<uint64_t>(sample_rate) * duration_ms) / 1000);
+    };
+    uint32_t total_frames = 0;
+    for (const FrequencyNote& note : notes) {
+        total_frames += note_frames(note);
+    }
+    std::vector<int16_t> samples(static_cast<size_t>(total_frames) * channels, 0);
+    uint32_t current_frame = 0;
+    for (const FrequencyNote& note : notes) {
+        const uint32_t frames = note_frames(note);
+        if (note.frequency_hz <= 0) {
+            current_frame += frames;
+            continue;
+        }
+        const int period = std::max(1, sample_rate / note.frequency_hz);
+        const int half_period = std::max(1, period / 2);
+        for (uint32_t i = 0; i < frames; ++i) {
+            const int phase = static_cast<int>(current_frame % static_cast<uint32_t>(period));
+            const int16_t value = phase < half_period ? 9000 : -9000;
+            for (int channel = 0; channel < channels; ++channel) {
+                samples[static_cast<size_t>(current_frame) * channels + channel] = value;
+            }
+            current_frame++;
+        }
+    }
+    return samples;
+}
+
+void test_audio_synthesis_matches_per_sample_generator() {
+    // 440 Hz at 22050 Hz has a 50-frame period; a 1-tick note is 1212 frames,
+    // so it ends 12 frames into a period and the next note carries the phase
+    const std::vector<FrequencyNote> melody = {{440, 1}, {523, 2}, {262, 1}};
+    const std::vector<FrequencyNote> with_rests = {{310, 2}, {0, 1}, {-1, 1}, {466, 3}};
+    const std::vector<FrequencyNote> above_nyquist = {{20000, 1}, {11025, 1}};
+
+    const std::vector<int16_t>& mono = synthesize_notes(melody, 22050, 1);
+    check(!mono.empty() && mono == reference_square_waves(melody, 22050, 1),
+          "audio_synthesis: a melody should match the per-sample generator");
+    check((22050 * 55 / 1000) % (22050 / 440) != 0, "audio_synthesis: the first note should end mid-period");
+    check(synthesize_notes(melody, 44100, 2) == reference_square_waves(melody, 44100, 2),
+          "audio_synthesis: stereo should match the per-sample generator");
+
+    const std::vector<int16_t>& rests = synthesize_notes(with_rests, 44100, 2);
+    check(rests == reference_square_waves(with_rests, 44100, 2),
+          "audio_synthesis: rests should match the per-sample generator");
+    const size_t rest_start = static_cast<size_t>(44100 * 110 / 1000) * 2;
+    const size_t rest_end = rest_start + static_cast<size_t>(44100 * 55 / 1000) * 2 * 2;
+    check(std::all_of(rests.begin() + rest_start, rests.begin() + rest_end, [](int16_t v) { return v == 0; }),
+          "audio_synthesis: rests should keep their slot as silence");
+    check(rests[rest_end] != 0 && rests.back() != 0, "audio_synthesis: the note after a rest should sound");
+
+    check(synthesize_notes(above_nyquist, 22050, 1) == reference_square_waves(above_nyquist, 22050, 1),
+          "audio_synthesis: one-frame periods should match the per-sample generator");
+}
+
+void test_audio_synthesis_reuses_cached_waveform() {
+    reset_physics_state();
+    const std::vector<FrequencyNote> notes = {{392, 1}, {0, 1}, {784, 1}};
+    reset_counters();
+    const std::vector<int16_t>& first = synthesize_notes(notes, 11025, 1);
+    const uint64_t built = get_counter(Counter::WAVEFORMS_SYNTHESIZED);
+    const std::vector<int16_t>& second = synthesize_notes(notes, 11025, 1);
+    check(built <= 1 && &first == &second, "audio_cache: the same notes and format should share one buffer");
+    check(get_counter(Counter::WAVEFORMS_SYNTHESIZED) == built, "audio_cache: a cached waveform should not rebuild");
+    check(&synthesize_notes(notes, 11025, 2) != &first, "audio_cache: another channel count should get its own buffer");
+
+    // Build FIRE for the mixer's format with the mixer closed, then play it
+    // twice and across a re-initialization: every chunk borrows that PCM
+    check(init_sdl_audio(), "audio_cache: SDL audio init should succeed");
+    check(initialize_audio_system(), "audio_cache: initialization should succeed");
+    shutdown_audio_system();
+    reset_counters();
+    check(synthesize_game_sound(GameSound::FIRE, true) > 0, "audio_cache: FIRE should synthesize");
+    check(get_counter(Counter::WAVEFORMS_SYNTHESIZED) == 1, "audio_cache: dropping the cache should rebuild FIRE");
+
+    check(initialize_audio_system(), "audio_cache: initialization should succeed");
+    check(play_game_sound(GameSound::FIRE), "audio_cache: FIRE should play");
+    wait_for_sfx_channel_idle(500);
+    check(play_game_sound(GameSound::FIRE), "audio_cache: FIRE should play again");
+    wait_for_sfx_channel_idle(500);
+    shutdown_audio_system();
+    check(initialize_audio_system(), "audio_cache: re-initialization should succeed");
+    check(play_game_sound(GameSound::FIRE), "audio_cache: FIRE should play after re-initialization");
+    wait_for_sfx_channel_idle(500);
+    check(get_counter(Counter::WAVEFORMS_SYNTHESIZED) == 1, "audio_cache: playing FIRE should reuse its cached PCM");
+    shutdown_audio_system();
+    quit_sdl_audio();
+    reset_counters();
+}
+
 #else
 
 void test_audio_init_shutdown_idempotency() {
@@ -178,4 +307,17 @@ void test_audio_music_playback() {
     reset_physics_state();
 }
 
+void test_audio_low_latency_voice_pool() {
+    reset_physics_state();
+    check(!set_audio_buffer_frames(256), "audio_no_mixer: low-latency mode should be unavailable");
+}
+
+void test_audio_synthesis_matches_per_sample_generator() {
+    check(synthesize_notes({{440, 1}}, 22050, 1).empty(), "audio_no_mixer: nothing should be synthesized");
+}
+
+void test_audio_synthesis_reuses_cached_waveform() {
+    reset_physics_state();
+}
+
 #endif
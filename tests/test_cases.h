@@ -3,6 +3,7 @@
 
 // Physics & Doors
 void test_physics_tiles();
+void test_collision_bitboard_matches_tile_probes();
 void test_jump_edge_trigger();
 void test_jump_recharge();
 void test_jump_height();
@@ -21,12 +22,14 @@ void test_door_state_update_different_level();
 void test_door_animation_phase_progression_and_render_state();
 void test_door_destination_load_deferred_until_entering_complete();
 void test_door_entry_sets_checkpoint_for_respawn();
+void test_stage_prefetch_covers_exits_and_doors();
 void test_stage_left_exit_blocked();
 void test_stage_right_exit_blocked();
 void test_stage_left_edge_detection();
 void test_stage_right_edge_detection();
 void test_cave_level_solidity();
 void test_problematic_levels_have_solid_tiles();
+void test_streamed_stage_map_window_follows_comic();
 
 // Graphics & Assets
 void test_animation_looping();
@@ -34,10 +37,20 @@ void test_animation_non_looping();
 void test_animation_zero_duration();
 void test_enemy_animation_sequence();
 void test_tileset_blackout_state_tracking();
+void test_registry_handles_resolve_by_id();
+void test_asset_decode_pool_completes_jobs();
+void test_asset_pack_lookup_by_name_hash();
+void test_load_graph_orders_tasks_and_reports();
+void test_ega_planar_decode_matches_reference();
 void test_asset_path_resolution();
 void test_tileset_blackout_state_tracks_unloaded_tileset();
+void test_texture_cache_evicts_unpinned_lru();
+void test_enemy_sprite_eviction_rebinds_actors();
+void test_glyph_atlas_measures_and_wraps();
 void test_runtime_level_tiles_populated();
 void test_playfield_viewport_height_matches_render_scale();
+void test_stage_background_cache_tracks_tile_revision();
+void test_sprite_batch_groups_draws_by_texture();
 
 // Actors & Items
 void test_actor_spawn_one_per_tick();
@@ -51,7 +64,9 @@ void test_actor_behavior_bounce_movement();
 void test_actor_restraint_throttling();
 void test_actor_door_key_sync();
 void test_actor_spawn_avoids_solid_tiles();
+void test_actor_door_tiles_stay_solid_for_enemies();
 void test_actor_pit_fall_despawns_without_spark();
+void test_actor_pool_broadphase();
 void test_fireball_meter_depletion_timing();
 void test_fireball_meter_recharge_timing();
 void test_fireball_offscreen_deactivates();
@@ -72,6 +87,9 @@ void test_audio_priority_blocking();
 void test_audio_enemy_hit_interrupts_fire();
 void test_audio_all_sounds_playable();
 void test_audio_music_playback();
+void test_audio_low_latency_voice_pool();
+void test_audio_synthesis_matches_per_sample_generator();
+void test_audio_synthesis_reuses_cached_waveform();
 
 // UI & Score
 void test_ui_score_base100_encoding();
@@ -79,6 +97,7 @@ void test_ui_fireball_meter_cell_mapping();
 void test_ui_boots_detection();
 void test_ui_score_edge_cases();
 void test_ui_meter_all_states();
+void test_ui_hud_state_change_detection();
 void test_award_points_no_carry();
 void test_award_points_accumulates_in_byte0();
 void test_award_points_carry_into_byte1();
@@ -89,5 +108,53 @@ void test_award_points_large_carry_saturation();
 void test_award_points_awards_extra_life_every_50000();
 void test_award_points_awards_extra_life_after_500_internal_units();
 void test_high_score_bytes_conversion();
+void test_title_fade_layers_split();
+
+// Replay
+void test_replay_round_trip();
+void test_replay_rejects_corrupt_data();
+
+// Game contexts
+void test_game_contexts_are_independent();
+void test_batch_runner_matches_sequential();
+
+// Snapshots
+void test_snapshot_restore_reproduces_game();
+void test_snapshot_ring_rewind();
+void test_snapshot_ring_hour_budget();
+void test_snapshot_ring_finds_divergence();
+void test_snapshot_rejects_corrupt_state();
+void test_snapshot_refuses_enlarged_pool();
+
+// Frame profiler
+void test_profiler_records_exclusive_phase_times();
+void test_profiler_perf_log_writes_csv();
+
+// Runtime counters
+void test_counters_sound_priorities_and_reset();
+void test_counters_enemy_spawns_and_despawns();
+
+// Frame pacing, render interpolation and render-on-change
+void test_frame_pacer_fixed_mode_spaces_presents();
+void test_render_interpolator_offsets_and_snaps();
+void test_scene_change_tracker_skips_unchanged_frames();
+
+// Input latency
+void test_input_latency_press_to_present();
+
+// Simulation thread
+void test_sim_thread_queue_and_triple_buffer();
+void test_sim_thread_matches_sequential_ticks();
+void test_sequencer_waits_and_keys();
+void test_victory_tally_pays_awarded_lives();
+
+// Frame capture
+void test_frame_capture_i420_conversion();
+void test_frame_capture_writer_y4m_stream();
+
+// Frame arena and steady-state allocations
+void test_frame_arena_bump_and_reset();
+void test_zero_alloc_gameplay_ticks_after_warmup();
+void test_zero_alloc_render_frame_after_warmup();
 
 #endif // TEST_CASES_H
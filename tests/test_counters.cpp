@@ -0,0 +1,51 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/counters.h"
+#include <cstring>
+#include <set>
+#include <sstream>
+
+void test_counters_sound_priorities_and_reset() {
+    reset_counters();
+    count_sound_request(0, true);
+    count_sound_request(2, false);
+    count_sound_request(2, false);
+    count_sound_request(200, true);  // Above the counted range: lands on the top priority
+    check(get_counter(Counter::SOUNDS_ACCEPTED_P0) == 1, "counters: accepted sound should count at its priority");
+    check(get_counter(Counter::SOUNDS_REJECTED_P2) == 2, "counters: rejected sound should count at its priority");
+    check(get_counter(Counter::SOUNDS_ACCEPTED_P4) == 1, "counters: out-of-range priority should clamp to the top");
+
+    std::set<std::string> names;
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        const char* name = get_counter_name(static_cast<Counter>(i));
+        check(std::strlen(name) > 0 && std::strcmp(name, "unknown") != 0, "counters: every counter should be named");
+        names.insert(name);
+    }
+    check(names.size() == COUNTER_COUNT, "counters: names should be unique");
+
+    std::ostringstream dump;
+    print_counters(dump);
+    check(dump.str().find("sounds_rejected_p2") != std::string::npos, "counters: dump should list every counter");
+
+    reset_counters();
+    check(get_counter(Counter::SOUNDS_REJECTED_P2) == 0, "counters: reset should zero the counters");
+}
+
+void test_counters_enemy_spawns_and_despawns() {
+    reset_counters();
+    GameContext game;
+    game.actors.initialize();
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
+    // Run right across the stage, leaving the enemies behind
+    for (int tick = 0; tick < 600; ++tick) {
+        apply_input_keys(game, INPUT_RIGHT | (tick % 30 < 3 ? INPUT_JUMP : 0));
+        run_gameplay_tick(game);
+    }
+    check(get_counter(Counter::ENEMIES_SPAWNED) > 0, "counters: enemies spawned should be counted");
+    check(get_counter(Counter::ENEMIES_DESPAWNED) > 0, "counters: enemies left behind should be counted as despawned");
+    check(get_counter(Counter::ENEMIES_DESPAWNED) <= get_counter(Counter::ENEMIES_SPAWNED),
+          "counters: no more despawns than spawns");
+    reset_counters();
+}
@@ -0,0 +1,68 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/frame_capture.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+void test_frame_capture_i420_conversion() {
+    // 4x2: a white 2x2 block on the left, a red one on the right
+    const int width = 4;
+    const int height = 2;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 255);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 2; x < 4; ++x) {
+            uint8_t* pixel = &rgba[(y * width + x) * 4];
+            pixel[0] = 255;
+            pixel[1] = 0;
+            pixel[2] = 0;
+        }
+    }
+    std::vector<uint8_t> out(static_cast<size_t>(width) * height * 3 / 2, 0);
+    convert_rgba_to_i420(rgba.data(), width, height, width * 4, out.data());
+
+    check(out[0] == 255 && out[1] == 255, "frame_capture: white should have full luma");
+    check(out[2] == 76 || out[2] == 77, "frame_capture: red luma should be about 0.299");
+    const uint8_t* u_plane = &out[width * height];
+    const uint8_t* v_plane = u_plane + 2;
+    check(u_plane[0] == 128 && v_plane[0] == 128, "frame_capture: white should have neutral chroma");
+    check(u_plane[1] < 128 && v_plane[1] == 255, "frame_capture: red should have low U and full V");
+}
+
+void test_frame_capture_writer_y4m_stream() {
+    FILE* stream = std::tmpfile();
+    check(stream != nullptr, "frame_capture: tmpfile should open");
+    if (!stream) {
+        return;
+    }
+
+    FrameWriter writer;
+    // An odd size is rounded down to even for 4:2:0
+    check(writer.open_stream(stream, false, CaptureFormat::Y4M, 5, 3, 60), "frame_capture: writer should start");
+    check(writer.get_width() == 4 && writer.get_height() == 2, "frame_capture: Y4M sizes should be even");
+
+    const int frame_count = FRAME_CAPTURE_BUFFERS * 3;
+    for (int i = 0; i < frame_count; ++i) {
+        uint8_t* frame = writer.acquire_frame(true);
+        check(frame != nullptr, "frame_capture: a waiting acquire should get a buffer");
+        if (!frame) {
+            break;
+        }
+        std::memset(frame, 255, static_cast<size_t>(writer.get_frame_pitch()) * writer.get_height());
+        writer.submit_frame(frame);
+    }
+    check(writer.finish(), "frame_capture: every frame should be written");
+    check(writer.get_frames_written() == static_cast<uint64_t>(frame_count),
+          "frame_capture: no frame should be lost when waiting for buffers");
+
+    std::rewind(stream);
+    char header[128] = {};
+    check(std::fgets(header, sizeof(header), stream) != nullptr, "frame_capture: stream header");
+    check(std::string(header).rfind("YUV4MPEG2 W4 H2 F60:1", 0) == 0, "frame_capture: Y4M header fields");
+    const long header_size = std::ftell(stream);
+    std::fseek(stream, 0, SEEK_END);
+    const long frame_size = static_cast<long>(std::strlen("FRAME\n")) + 4 * 2 * 3 / 2;
+    check(std::ftell(stream) - header_size == frame_size * frame_count, "frame_capture: one Y4M frame per submit");
+    std::fclose(stream);
+}
@@ -0,0 +1,125 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/counters.h"
+#include "../include/frame_pacer.h"
+#include "../include/gameplay.h"
+#include <SDL2/SDL.h>
+
+void test_frame_pacer_fixed_mode_spaces_presents() {
+    PacingMode mode = PacingMode::VSYNC;
+    check(parse_pacing_mode("power-saver", &mode) && mode == PacingMode::POWER_SAVER,
+          "frame_pacer: power-saver should parse");
+    check(!parse_pacing_mode("turbo", &mode) && mode == PacingMode::POWER_SAVER,
+          "frame_pacer: unknown modes should be rejected and leave the mode alone");
+    check(FramePacer::renderer_flags(PacingMode::VSYNC) & SDL_RENDERER_PRESENTVSYNC,
+          "frame_pacer: vsync mode should ask the renderer for vsync");
+
+    FramePacer pacer;
+    pacer.start(PacingMode::FIXED, 100, nullptr, nullptr);
+    check(pacer.get_mode() == PacingMode::FIXED && pacer.get_target_fps() == 100, "frame_pacer: fixed keeps its rate");
+    const uint64_t begin = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < 6; ++frame) {
+        pacer.mark_present();
+        pacer.wait_for_next_frame();
+    }
+    const double elapsed_ms = static_cast<double>(SDL_GetPerformanceCounter() - begin) * 1000.0 /
+                              static_cast<double>(SDL_GetPerformanceFrequency());
+    const FramePacingStats stats = pacer.get_stats();
+    check(stats.presents == 6, "frame_pacer: every present should be counted");
+    check(elapsed_ms >= 59.0, "frame_pacer: six frames at 100 fps should take at least 60 ms");
+    check(stats.average_interval_ms >= 9.5, "frame_pacer: presents should be a frame period apart");
+    check(stats.max_interval_ms >= stats.average_interval_ms, "frame_pacer: max interval is at least the average");
+
+    // Without vsync on the renderer, vsync mode falls back to fixed pacing
+    pacer.start(PacingMode::VSYNC, 0, nullptr, nullptr);
+    check(pacer.get_mode() == PacingMode::FIXED && pacer.get_target_fps() == DEFAULT_FIXED_FPS,
+          "frame_pacer: vsync without a renderer should fall back to fixed");
+}
+
+void test_render_interpolator_offsets_and_snaps() {
+    GameContext game;
+    game.camera_x = 10;
+    game.comic_x = 20;
+    game.comic_y = 8;
+
+    RenderInterpolator interpolator;
+    interpolator.capture_previous(game);
+    game.camera_x = 11;
+    game.comic_x = 22;
+    interpolator.set_blend(0.5);
+    check(interpolator.get_world_shift(game, 8) == 0 && interpolator.get_comic_offset_x(game, 8) == 0,
+          "render_interpolator: disabled should never offset");
+
+    interpolator.set_enabled(true);
+    check(interpolator.get_comic_offset_x(game, 8) == 0, "render_interpolator: no offsets before a capture");
+    game.camera_x = 10;
+    game.comic_x = 20;
+    interpolator.capture_previous(game);
+    game.camera_x = 11;
+    game.comic_x = 22;
+    interpolator.set_blend(0.25);
+    // Comic moved 2 units right; a quarter of the way there he is 1.5 units (12 px) short
+    check(interpolator.get_comic_offset_x(game, 8) == -12, "render_interpolator: comic should lag by the unblended step");
+    check(interpolator.get_comic_offset_y(game, 8) == 0, "render_interpolator: no vertical motion, no offset");
+    // Camera one unit right: the world is drawn 6 px further right than snapped
+    check(interpolator.get_world_shift(game, 8) == 6, "render_interpolator: world shift opposes the camera");
+    interpolator.set_blend(1.0);
+    check(interpolator.get_comic_offset_x(game, 8) == 0, "render_interpolator: full blend draws the current position");
+
+    interpolator.set_blend(0.0);
+    game.comic_x = 60;  // Teleport-sized jump
+    check(interpolator.get_comic_offset_x(game, 8) == 0, "render_interpolator: large steps should snap");
+    game.comic_x = 22;
+    game.current_stage_number = static_cast<uint8_t>(game.current_stage_number + 1);
+    check(interpolator.get_comic_offset_x(game, 8) == 0, "render_interpolator: stage changes should snap");
+    game.current_stage_number = static_cast<uint8_t>(game.current_stage_number - 1);
+    interpolator.reset();
+    check(interpolator.get_comic_offset_x(game, 8) == 0, "render_interpolator: reset should snap until the next tick");
+}
+
+void test_scene_change_tracker_skips_unchanged_frames() {
+    static GameContext game;  // Static: a context is too large for some test thread stacks
+    game = GameContext();
+    game.actors.initialize();
+    load_starting_level(game);
+    sync_stage_enemies(game);
+
+    const uint64_t scene = scene_signature(game);
+    check(scene_signature(game) == scene, "scene_tracker: the signature should be stable");
+    game.key_state_jump = 1;
+    game.comic_y_vel = 3;
+    check(scene_signature(game) == scene, "scene_tracker: state that is not drawn should not count");
+    game.camera_x += 1;
+    check(scene_signature(game) != scene, "scene_tracker: a camera move should count");
+    game.camera_x -= 1;
+    game.comic_hp = static_cast<uint8_t>(game.comic_hp + 1);
+    check(scene_signature(game) != scene, "scene_tracker: a HUD change should count");
+    game.comic_hp = static_cast<uint8_t>(game.comic_hp - 1);
+    game.door_anim_frame = static_cast<uint8_t>(game.door_anim_frame + 1);
+    check(scene_signature(game) != scene, "scene_tracker: a door animation step should count");
+
+    reset_counters();
+    SceneView view;
+    view.game = scene;
+    SceneChangeTracker tracker;
+    check(tracker.needs_frame(view) && tracker.needs_frame(view), "scene_tracker: disabled should draw every frame");
+
+    tracker.set_enabled(true);
+    check(tracker.needs_frame(view), "scene_tracker: the first frame should be drawn");
+    check(!tracker.needs_frame(view), "scene_tracker: an unchanged frame should be skipped");
+    tracker.invalidate();
+    check(tracker.needs_frame(view), "scene_tracker: invalidate should force a frame");
+    view.animation_frame = 1;
+    check(tracker.needs_frame(view), "scene_tracker: a new animation frame should be drawn");
+    view.paused = true;
+    check(tracker.needs_frame(view) && !tracker.needs_frame(view), "scene_tracker: pausing should be drawn once");
+    check(get_counter(Counter::FRAMES_UNCHANGED) == 2, "scene_tracker: skipped frames should be counted");
+    reset_counters();
+
+    check(SceneChangeTracker::idle_ms(50.0, 0, 1000, 110.0) == 50.0, "scene_tracker: sleep until the tick");
+    check(SceneChangeTracker::idle_ms(50.0, 1020, 1000, 110.0) == 20.0,
+          "scene_tracker: an animation frame due first should cut the sleep short");
+    check(SceneChangeTracker::idle_ms(500.0, 0, 1000, 110.0) == 110.0, "scene_tracker: sleeps should be capped");
+    check(SceneChangeTracker::idle_ms(50.0, 990, 1000, 110.0) == 0.0,
+          "scene_tracker: an animation frame already due should not wait");
+}
@@ -0,0 +1,98 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/batch_runner.h"
+
+// Walk right, jumping now and then, firing on the way back left
+static uint8_t route_keys(uint64_t tick) {
+    uint8_t keys = (tick / 150) % 2 == 0 ? INPUT_RIGHT : INPUT_LEFT | INPUT_FIRE;
+    if (tick % 40 < 4) {
+        keys |= INPUT_JUMP;
+    }
+    return keys;
+}
+
+static void start_game(GameContext& game) {
+    game.actors.initialize();
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
+}
+
+void test_game_contexts_are_independent() {
+    constexpr uint64_t TICKS = 1500;
+    BatchJob walker;
+    walker.tick_count = TICKS;
+    walker.input = [](const GameContext&, uint64_t tick) { return route_keys(tick); };
+    BatchJob idler;
+    idler.tick_count = TICKS;
+    const BatchResult walker_solo = BatchRunner::run_job(walker);
+    const BatchResult idler_solo = BatchRunner::run_job(idler);
+    check(walker_solo.checksum != idler_solo.checksum,
+          "game context: different input should give different games");
+
+    // Step both games tick by tick in one thread; neither may see the other
+    GameContext walking;
+    GameContext idling;
+    start_game(walking);
+    start_game(idling);
+    bool walking_done = false;
+    bool idling_done = false;
+    for (uint64_t tick = 0; tick < TICKS; ++tick) {
+        if (!walking_done) {
+            apply_input_keys(walking, route_keys(tick));
+            walking_done = run_gameplay_tick(walking) != TickOutcome::Continue;
+        }
+        if (!idling_done) {
+            apply_input_keys(idling, 0);
+            idling_done = run_gameplay_tick(idling) != TickOutcome::Continue;
+        }
+    }
+    check(gameplay_checksum(walking) == walker_solo.checksum,
+          "game context: interleaved game should match its solo run");
+    check(gameplay_checksum(idling) == idler_solo.checksum,
+          "game context: idle game should be unaffected by the other context");
+    check(walking.comic_x == walker_solo.comic_x && walking.comic_y == walker_solo.comic_y,
+          "game context: interleaved game should end at the solo position");
+}
+
+void test_batch_runner_matches_sequential() {
+    std::vector<BatchJob> jobs(24);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].tick_count = 400 + 50 * i;
+        if (i % 2 == 0) {
+            // Recorded keys, offset per job
+            for (uint64_t tick = 0; tick < jobs[i].tick_count; ++tick) {
+                jobs[i].keys.push_back(route_keys(tick + 17 * i));
+            }
+        } else {
+            // Input that reacts to the game: turn around near the stage edges
+            jobs[i].input = [i](const GameContext& game, uint64_t tick) -> uint8_t {
+                const uint8_t jump = ((tick + i) % 30 < 3) ? INPUT_JUMP : 0;
+                return static_cast<uint8_t>((game.comic_x < 200 ? INPUT_RIGHT : INPUT_LEFT) | jump);
+            };
+        }
+    }
+    jobs[3].debug_mode = true;
+
+    std::vector<BatchResult> sequential;
+    for (const BatchJob& job : jobs) {
+        sequential.push_back(BatchRunner::run_job(job));
+    }
+
+    BatchRunner runner(4);
+    check(runner.get_thread_count() == 4, "batch runner: should report its thread count");
+    for (int round = 0; round < 2; ++round) {
+        const std::vector<BatchResult> parallel = runner.run(jobs);
+        check(parallel.size() == jobs.size(), "batch runner: one result per job");
+        bool all_match = parallel.size() == sequential.size();
+        for (size_t i = 0; all_match && i < parallel.size(); ++i) {
+            all_match = parallel[i].checksum == sequential[i].checksum &&
+                        parallel[i].ticks_run == sequential[i].ticks_run &&
+                        parallel[i].outcome == sequential[i].outcome;
+        }
+        check(all_match, "batch runner: parallel results should match sequential runs in job order");
+    }
+    check(sequential[0].ticks_run == jobs[0].tick_count || sequential[0].outcome != TickOutcome::Continue,
+          "batch runner: a job runs until its tick count or the game ends");
+    check(runner.run({}).empty(), "batch runner: an empty batch should return no results");
+}
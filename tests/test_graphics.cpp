@@ -1,10 +1,21 @@
 #include "test_helpers.h"
 #include "test_cases.h"
 #include "../include/physics.h"
+#include "../include/asset_loader.h"
+#include "../include/asset_pack.h"
+#include "../include/glyph_atlas.h"
+#include "../include/load_graph.h"
+#include "../include/original_assets.h"
+#include "../include/level_tiles.h"
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <sstream>
 
 namespace {
 bool write_minimal_png(const std::filesystem::path& path) {
@@ -36,17 +47,20 @@ void test_animation_looping() {
     GraphicsSystem graphics(nullptr);
     Animation anim = make_animation({100, 200, 100}, true);
 
-    graphics.update_animation(anim, 50);
+    check(graphics.update_animation(anim, 50) == 100, "looping: next frame should be due at 100ms");
     check(anim.current_frame == 0, "looping: frame at 50ms should be 0");
 
-    graphics.update_animation(anim, 150);
+    check(graphics.update_animation(anim, 150) == 300, "looping: next frame should be due at 300ms");
     check(anim.current_frame == 1, "looping: frame at 150ms should be 1");
 
     graphics.update_animation(anim, 310);
     check(anim.current_frame == 2, "looping: frame at 310ms should be 2");
 
-    graphics.update_animation(anim, 450);
+    check(graphics.update_animation(anim, 450) == 500, "looping: next frame should be due after the loop");
     check(anim.current_frame == 0, "looping: frame at 450ms should loop to 0");
+
+    Animation still = make_animation({100}, true);
+    check(graphics.update_animation(still, 50) == 0, "looping: one frame should never be due to change");
 }
 
 void test_animation_non_looping() {
@@ -60,7 +74,7 @@ void test_animation_non_looping() {
     graphics.update_animation(anim, 150);
     check(anim.current_frame == 1, "non-looping: frame at 150ms should be 1");
 
-    graphics.update_animation(anim, 450);
+    check(graphics.update_animation(anim, 450) == 0, "non-looping: a finished animation should not be due");
     check(anim.current_frame == 2, "non-looping: frame at 450ms should clamp to 2");
 }
 
@@ -76,20 +90,24 @@ void test_animation_zero_duration() {
 
 void test_enemy_animation_sequence() {
     reset_physics_state();
-    std::vector<uint8_t> loop_sequence = build_enemy_animation_sequence(3, ENEMY_ANIMATION_LOOP);
-    check(loop_sequence == std::vector<uint8_t>({0, 1, 2}),
+    EnemyAnimationSequence loop_sequence = build_enemy_animation_sequence(3, ENEMY_ANIMATION_LOOP);
+    check(loop_sequence == EnemyAnimationSequence({0, 1, 2}),
         "enemy loop sequence should be 0,1,2 for 3 frames");
 
-    std::vector<uint8_t> alternate_sequence = build_enemy_animation_sequence(3, ENEMY_ANIMATION_ALTERNATE);
-    check(alternate_sequence == std::vector<uint8_t>({0, 1, 2, 1}),
+    EnemyAnimationSequence alternate_sequence = build_enemy_animation_sequence(3, ENEMY_ANIMATION_ALTERNATE);
+    check(alternate_sequence == EnemyAnimationSequence({0, 1, 2, 1}),
         "enemy alternate sequence should be 0,1,2,1 for 3 frames");
 
-    std::vector<uint8_t> alternate_sequence_four = build_enemy_animation_sequence(4, ENEMY_ANIMATION_ALTERNATE);
-    check(alternate_sequence_four == std::vector<uint8_t>({0, 1, 2, 3, 2, 1}),
+    EnemyAnimationSequence alternate_sequence_four = build_enemy_animation_sequence(4, ENEMY_ANIMATION_ALTERNATE);
+    check(alternate_sequence_four == EnemyAnimationSequence({0, 1, 2, 3, 2, 1}),
         "enemy alternate sequence should be 0,1,2,3,2,1 for 4 frames");
 
-    std::vector<uint8_t> empty_sequence = build_enemy_animation_sequence(0, ENEMY_ANIMATION_LOOP);
+    EnemyAnimationSequence empty_sequence = build_enemy_animation_sequence(0, ENEMY_ANIMATION_LOOP);
     check(empty_sequence.empty(), "enemy sequence should be empty for 0 frames");
+
+    EnemyAnimationSequence clamped_sequence = build_enemy_animation_sequence(255, ENEMY_ANIMATION_ALTERNATE);
+    check(clamped_sequence.size() == MAX_ENEMY_ANIMATION_FRAMES * 2 - 2,
+        "enemy sequence should use at most MAX_ENEMY_ANIMATION_FRAMES frames");
 }
 
 void test_tileset_blackout_state_tracking() {
@@ -120,6 +138,261 @@ void test_tileset_blackout_state_tracking() {
           "blackout: castle state must remain false after forest was set");
 }
 
+void test_registry_handles_resolve_by_id() {
+    GraphicsSystem graphics(nullptr);
+
+    // Unknown names and out-of-range handles resolve to nothing.
+    check(graphics.find_sprite_id("comic_standing", "right") == INVALID_SPRITE_ID,
+          "registry: unloaded sprite should have no id");
+    check(graphics.get_sprite(INVALID_SPRITE_ID) == nullptr,
+          "registry: invalid sprite id should resolve to nullptr");
+    check(graphics.get_sprite(static_cast<SpriteId>(0)) == nullptr,
+          "registry: id past the end should resolve to nullptr");
+
+    // Configuring a tileset interns its name before any tiles load.
+    graphics.set_tileset_blackout("castle", true);
+    const TilesetId castle = graphics.find_tileset_id("castle");
+    check(castle != INVALID_TILESET_ID, "registry: blackout should intern the tileset name");
+    check(graphics.get_tileset(castle) == nullptr,
+          "registry: interned but unloaded tileset should resolve to nullptr");
+
+    graphics.set_tileset_blackout("forest", true);
+    const TilesetId forest = graphics.find_tileset_id("forest");
+    check(forest != castle, "registry: each level name should get its own id");
+    check(graphics.find_tileset_id("castle") == castle,
+          "registry: ids should stay stable as the registry grows");
+
+    // Id-based setters address the same entry as the name-based ones.
+    graphics.set_tileset_blackout(castle, false);
+    check(!graphics.is_tileset_blacked_out("castle"),
+          "registry: id-based blackout should update the named entry");
+    check(graphics.is_tileset_blacked_out("forest"),
+          "registry: id-based blackout should not touch other entries");
+}
+
+void test_asset_decode_pool_completes_jobs() {
+    // Zero workers: jobs run inline and are finished on return.
+    AssetDecodePool inline_pool(0);
+    int inline_runs = 0;
+    DecodeTicket inline_ticket = inline_pool.enqueue([&inline_runs]() -> SDL_Surface* {
+        ++inline_runs;
+        return nullptr;
+    });
+    check(inline_pool.is_done(inline_ticket) && inline_runs == 1,
+          "decode pool: inline job should finish inside enqueue");
+    check(inline_ticket->take_surface() == nullptr,
+          "decode pool: failed decode should yield no surface");
+
+    // Worker pool: every job runs exactly once, whether a worker picks it up
+    // or wait() pulls it off the queue.
+    std::atomic<int> runs(0);
+    std::vector<DecodeTicket> tickets;
+    {
+        AssetDecodePool pool(2);
+        for (int i = 0; i < 16; ++i) {
+            tickets.push_back(pool.enqueue([&runs]() -> SDL_Surface* {
+                ++runs;
+                return nullptr;
+            }, i % 4 == 0));
+        }
+        for (const DecodeTicket& ticket : tickets) {
+            pool.wait(ticket);
+            check(pool.is_done(ticket), "decode pool: wait should leave the job finished");
+        }
+    }
+    check(runs.load() == 16, "decode pool: each job should run exactly once");
+
+    // Without a renderer the async requests refuse, like the blocking loaders.
+    GraphicsSystem graphics(nullptr);
+    check(!graphics.request_tileset("castle"),
+          "decode pool: request_tileset should fail without a renderer");
+    check(graphics.get_pending_asset_count() == 0,
+          "decode pool: failed request should leave nothing pending");
+}
+
+void test_load_graph_orders_tasks_and_reports() {
+    // Each task logs its name once its dependencies are logged
+    std::mutex log_mutex;
+    std::vector<std::string> log;
+    auto logged = [&log_mutex, &log](const std::string& name) {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        return std::find(log.begin(), log.end(), name) != log.end();
+    };
+    auto task = [&log_mutex, &log](const std::string& name) {
+        return [&log_mutex, &log, name]() {
+            std::lock_guard<std::mutex> lock(log_mutex);
+            log.push_back(name);
+            return name != "bad";
+        };
+    };
+
+    AssetDecodePool pool(2);
+    bool gate_open = false;
+    bool order_ok = true;
+    {
+        LoadGraph graph(&pool);
+        const LoadGraph::Clock::time_point opened = LoadGraph::Clock::now();
+        graph.record("window", opened, opened);
+        const LoadTaskId decode = graph.add("decode", LoadThread::WORKER, task("decode"));
+        const LoadTaskId bad = graph.add("bad", LoadThread::WORKER, task("bad"));
+        const LoadTaskId upload = graph.add("upload", LoadThread::RENDER, [&]() {
+            order_ok = order_ok && logged("decode");
+            return task("upload")();
+        }, {decode});
+        const LoadTaskId gated = graph.add("gated", LoadThread::RENDER, [&]() {
+            order_ok = order_ok && logged("upload") && logged("bad");
+            return task("gated")();
+        }, {upload, bad}, [&gate_open]() { return gate_open; });
+        const LoadTaskId last = graph.add("last", LoadThread::RENDER, task("last"), {gated});
+
+        for (int i = 0; i < 1000 && !graph.is_done(upload); ++i) {
+            graph.pump(1.0);
+            SDL_Delay(1);
+        }
+        check(graph.is_done(upload), "load graph: pump should run a task once its dependencies are done");
+        for (int i = 0; i < 1000 && !graph.is_done(bad); ++i) {
+            graph.pump(1.0);
+            SDL_Delay(1);
+        }
+        graph.pump(1.0);
+        check(!graph.is_done(gated) && !graph.is_finished(),
+              "load graph: pump should leave a task whose ready check fails");
+
+        graph.mark_first_frame();
+        check(graph.wait(last), "load graph: wait should run a task and what it depends on");
+        check(graph.is_done(gated), "load graph: wait should ignore ready checks");
+        check(!graph.finish() && graph.is_finished(), "load graph: finish should report the failed task");
+        check(order_ok, "load graph: dependencies should run first");
+
+        std::ostringstream report;
+        graph.print_report(report);
+        const std::string text = report.str();
+        check(text.find("Startup: first frame at") == 0, "load graph: report should lead with the first frame");
+        check(text.find("window (before first frame)") != std::string::npos,
+              "load graph: report should flag what loaded before the first frame");
+        const size_t bad_line = text.find("worker  bad");
+        check(bad_line != std::string::npos && text.find("(failed)", bad_line) < text.find('\n', bad_line),
+              "load graph: report should show the thread and flag failures");
+        check(text.find("render  last") != std::string::npos, "load graph: report should list every task");
+    }
+    check(log.size() == 5, "load graph: each task should run exactly once");
+
+    // Cancelling drops what has not started
+    bool ran = false;
+    {
+        LoadGraph graph(&pool);
+        graph.add("never", LoadThread::RENDER, [&ran]() { ran = true; return true; });
+        graph.cancel();
+        check(graph.is_finished(), "load graph: cancel should settle every task");
+    }
+    check(!ran, "load graph: cancel should drop tasks that have not started");
+}
+
+void test_asset_pack_lookup_by_name_hash() {
+    namespace fs = std::filesystem;
+    check(asset_pack_hash("a", 1) == 0xaf63dc4c8601ec8cull,
+          "asset pack: name hash should be FNV-1a 64 (matches extract_assets.py)");
+
+    // One 2x1 RGBA entry, laid out as tools/extract_assets.py writes it.
+    const std::string name = "lake.tt2-00.png";
+    const uint8_t pixels[8] = {255, 0, 0, 255, 0, 255, 0, 255};
+    const uint32_t name_offset = static_cast<uint32_t>(ASSET_PACK_HEADER_SIZE + ASSET_PACK_ENTRY_SIZE);
+    const uint32_t data_offset = 64;
+    std::vector<uint8_t> pack(data_offset + sizeof(pixels), 0);
+    auto put = [&pack](size_t offset, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            pack[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    };
+    std::memcpy(pack.data(), "CCPK", 4);
+    put(4, ASSET_PACK_VERSION, 4);
+    put(8, 1, 4);
+    put(16, asset_pack_hash(name.data(), name.size()), 8);
+    put(24, data_offset, 8);
+    put(32, sizeof(pixels), 4);
+    put(36, name_offset, 4);
+    put(40, name.size(), 2);
+    put(42, static_cast<uint16_t>(AssetPackFormat::RGBA32), 2);
+    put(44, 2, 2);
+    put(46, 1, 2);
+    std::memcpy(pack.data() + name_offset, name.data(), name.size());
+    std::memcpy(pack.data() + data_offset, pixels, sizeof(pixels));
+
+    const fs::path path = fs::temp_directory_path() / "comic_asset_pack_test.pak";
+    {
+        std::ofstream out(path.string(), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+    }
+
+    {
+        AssetPack asset_pack;
+        check(asset_pack.open(path.string()), "asset pack: well-formed pack should open");
+        check(asset_pack.get_entry_count() == 1, "asset pack: entry count should come from the header");
+
+        AssetPackBlob blob;
+        check(asset_pack.find(name, blob), "asset pack: entry should be found by name");
+        check(blob.format == AssetPackFormat::RGBA32 && blob.width == 2 && blob.height == 1 &&
+                  blob.size == sizeof(pixels),
+              "asset pack: entry metadata should round-trip");
+        check(blob.data != nullptr && std::memcmp(blob.data, pixels, sizeof(pixels)) == 0,
+              "asset pack: blob should point at the stored pixels");
+        check(!asset_pack.find("lake.tt2-01.png", blob),
+              "asset pack: unknown names should not be found");
+    }
+
+    // Corrupt the magic: the pack must be rejected rather than trusted.
+    {
+        std::ofstream out(path.string(), std::ios::binary | std::ios::in);
+        out.write("XXXX", 4);
+    }
+    {
+        AssetPack asset_pack;
+        check(!asset_pack.open(path.string()) && !asset_pack.is_open(),
+              "asset pack: bad magic should fail to open");
+    }
+    fs::remove(path);
+}
+
+void test_ega_planar_decode_matches_reference() {
+    // Straightforward per-pixel reference, as extract_assets.py decodes
+    auto reference = [](const std::vector<uint8_t>& planes, size_t pixel_count) {
+        std::vector<uint8_t> indices(pixel_count);
+        for (size_t i = 0; i < pixel_count; ++i) {
+            uint8_t color = 0;
+            for (size_t p = 0; p < 4; ++p) {
+                color |= ((planes[p * pixel_count / 8 + i / 8] >> (7 - i % 8)) & 1) << p;
+            }
+            indices[i] = color;
+        }
+        return indices;
+    };
+
+    // 16x16 tile, a full 320-pixel row, and an odd byte count that leaves a
+    // tail for the scalar path
+    uint32_t seed = 12345;
+    for (size_t pixel_count : {size_t(256), size_t(320), size_t(24)}) {
+        std::vector<uint8_t> planes(pixel_count / 2);
+        for (uint8_t& byte : planes) {
+            seed = seed * 1103515245u + 12345u;
+            byte = static_cast<uint8_t>(seed >> 16);
+        }
+        std::vector<uint8_t> indices(pixel_count, 0xFF);
+        ega_planar_to_indices(planes.data(), pixel_count, indices.data());
+        check(indices == reference(planes, pixel_count),
+              "EGA decode: planar conversion should match the per-pixel reference");
+    }
+
+    // Plane size 3: plane 0 literal, planes 1-3 runs
+    const uint8_t rle[] = {3, 0, 3, 0x11, 0x22, 0x33, 0x83, 0xAA, 0x83, 0xBB, 0x82, 0xCC, 0x01, 0xDD, 0x83, 0xEE};
+    uint8_t planes[12] = {};
+    check(ega_rle_decode(rle, sizeof(rle), planes, 3), "EGA RLE: well-formed data should decode");
+    const uint8_t expected[12] = {0x11, 0x22, 0x33, 0xAA, 0xAA, 0xAA, 0xBB, 0xBB, 0xBB, 0xCC, 0xCC, 0xDD};
+    check(std::memcmp(planes, expected, sizeof(expected)) == 0,
+          "EGA RLE: literals and runs should fill each plane in turn");
+    check(!ega_rle_decode(rle, sizeof(rle) - 6, planes, 3), "EGA RLE: truncated data should fail");
+    check(!ega_rle_decode(rle, sizeof(rle), planes, 8000), "EGA RLE: plane size mismatch should fail");
+}
+
 void test_asset_path_resolution() {
     reset_physics_state();
     namespace fs = std::filesystem;
@@ -233,9 +506,14 @@ void test_tileset_blackout_state_tracks_unloaded_tileset() {
         Tileset* castle_tileset = graphics.get_tileset("castle");
         check(castle_tileset != nullptr, "castle tileset should be retrievable after load");
 
-        if (castle_tileset != nullptr && !castle_tileset->tiles.empty()) {
-            SDL_Texture* sample_texture = castle_tileset->tiles.begin()->second.texture;
-            check(sample_texture != nullptr, "sample castle tile texture should be non-null");
+        if (castle_tileset != nullptr && castle_tileset->tile_count > 0) {
+            check(castle_tileset->has_tile(0x00), "castle atlas should contain tile 0x00");
+            check(!castle_tileset->has_tile(0x01), "castle atlas should not contain missing tile 0x01");
+            check(castle_tileset->src_rects[0x00].w == 1 && castle_tileset->src_rects[0x00].h == 1,
+                  "atlas source rect should match the loaded tile dimensions");
+
+            SDL_Texture* sample_texture = castle_tileset->atlas;
+            check(sample_texture != nullptr, "castle atlas texture should be non-null");
 
             if (sample_texture != nullptr) {
                 Uint8 r = 255;
@@ -262,6 +540,295 @@ void test_tileset_blackout_state_tracks_unloaded_tileset() {
     fs::remove_all(base);
 }
 
+void test_texture_cache_evicts_unpinned_lru() {
+    reset_physics_state();
+    namespace fs = std::filesystem;
+
+    fs::path base = fs::temp_directory_path() / "comic_texture_cache_test";
+    fs::path original_cwd = fs::current_path();
+    fs::remove_all(base);
+    fs::create_directories(base / "assets" / "tiles");
+
+    const char* const levels[] = {"castle", "forest", "lake"};
+    for (const char* level : levels) {
+        if (!write_minimal_png(base / "assets" / "tiles" / (std::string(level) + ".tt2-00.png"))) {
+            check(false, "failed to create tile fixture for texture cache test");
+            fs::remove_all(base);
+            return;
+        }
+    }
+
+    fs::current_path(base);
+
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        check(false, std::string("SDL video init failed: ") + SDL_GetError());
+        fs::current_path(original_cwd);
+        fs::remove_all(base);
+        return;
+    }
+
+    SDL_Window* window = SDL_CreateWindow(
+        "test_texture_cache",
+        SDL_WINDOWPOS_UNDEFINED,
+        SDL_WINDOWPOS_UNDEFINED,
+        64,
+        64,
+        SDL_WINDOW_HIDDEN);
+    if (window == nullptr) {
+        check(false, std::string("SDL window creation failed: ") + SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        fs::current_path(original_cwd);
+        fs::remove_all(base);
+        return;
+    }
+
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if (renderer == nullptr) {
+        check(false, std::string("SDL renderer creation failed: ") + SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        fs::current_path(original_cwd);
+        fs::remove_all(base);
+        return;
+    }
+
+    {
+        GraphicsSystem graphics(renderer);
+        check(graphics.initialize(), "graphics initialize should succeed for texture cache test");
+
+        for (const char* level : levels) {
+            check(graphics.load_tileset(level), "texture cache: fixture tileset should load");
+        }
+        const TextureCacheStats loaded = graphics.get_texture_cache_stats(TextureCategory::TILESETS);
+        check(loaded.resident_count == 3 && loaded.misses == 3,
+              "texture cache: three first loads should be three resident misses");
+        const size_t per_tileset = loaded.resident_bytes / 3;
+
+        // Castle is the least recently used, but pinned; forest is next in line.
+        graphics.begin_texture_pins();
+        graphics.pin_tileset("castle");
+        graphics.pin_tileset("lake");
+        graphics.set_texture_budget(per_tileset * 2);
+        graphics.pump_asset_uploads();
+
+        const TextureCacheStats evicted = graphics.get_texture_cache_stats(TextureCategory::TILESETS);
+        check(evicted.evictions == 1 && evicted.resident_count == 2,
+              "texture cache: going over budget should evict one tileset");
+        check(graphics.get_tileset("forest") == nullptr,
+              "texture cache: the unpinned tileset should be the one evicted");
+        check(graphics.get_tileset("castle") != nullptr && graphics.get_tileset("lake") != nullptr,
+              "texture cache: pinned tilesets should stay resident");
+
+        // An evicted tileset reloads on demand.
+        check(graphics.load_tileset("forest"), "texture cache: evicted tileset should reload");
+        check(graphics.get_texture_cache_stats(TextureCategory::TILESETS).misses == 4,
+              "texture cache: reloading an evicted tileset should count as a miss");
+        check(graphics.load_tileset("lake") &&
+                  graphics.get_texture_cache_stats(TextureCategory::TILESETS).hits == 1,
+              "texture cache: loading a resident tileset should count as a hit");
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    fs::current_path(original_cwd);
+    fs::remove_all(base);
+}
+
+void test_enemy_sprite_eviction_rebinds_actors() {
+    reset_physics_state();
+    namespace fs = std::filesystem;
+
+    fs::path base = fs::temp_directory_path() / "comic_enemy_eviction_test";
+    fs::path original_cwd = fs::current_path();
+    fs::remove_all(base);
+    fs::create_directories(base / "assets" / "shp");
+
+    const char* const names[] = {"foo.shp", "bar.shp"};
+    level_t level{};
+    for (int i = 0; i < 2; ++i) {
+        if (!write_minimal_png(base / "assets" / "shp" / (std::string(names[i]) + "-left-0.png"))) {
+            check(false, "failed to create enemy sprite fixture for eviction test");
+            fs::remove_all(base);
+            return;
+        }
+        level.shp[i].num_distinct_frames = 1;
+        level.shp[i].horizontal = ENEMY_HORIZONTAL_DUPLICATED;
+        std::strncpy(level.shp[i].filename, names[i], sizeof(level.shp[i].filename));
+    }
+    for (stage_t& stage : level.stages) {
+        for (enemy_record_t& record : stage.enemies) {
+            record.behavior = ENEMY_BEHAVIOR_UNUSED;
+        }
+    }
+    level.stages[0].enemies[0].shp_index = 0;
+    level.stages[0].enemies[0].behavior = ENEMY_BEHAVIOR_BOUNCE;
+
+    fs::current_path(base);
+
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        check(false, std::string("SDL video init failed: ") + SDL_GetError());
+        fs::current_path(original_cwd);
+        fs::remove_all(base);
+        return;
+    }
+
+    SDL_Window* window = SDL_CreateWindow(
+        "test_enemy_eviction",
+        SDL_WINDOWPOS_UNDEFINED,
+        SDL_WINDOWPOS_UNDEFINED,
+        64,
+        64,
+        SDL_WINDOW_HIDDEN);
+    if (window == nullptr) {
+        check(false, std::string("SDL window creation failed: ") + SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        fs::current_path(original_cwd);
+        fs::remove_all(base);
+        return;
+    }
+
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if (renderer == nullptr) {
+        check(false, std::string("SDL renderer creation failed: ") + SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        fs::current_path(original_cwd);
+        fs::remove_all(base);
+        return;
+    }
+
+    {
+        GraphicsSystem graphics(renderer);
+        check(graphics.initialize(), "graphics initialize should succeed for enemy eviction test");
+
+        ActorSystem actors;
+        actors.initialize();
+        actors.setup_enemies_for_stage(&level, 0, 0, &graphics);
+        check(actors.get_enemies().animation_data[0] != nullptr,
+              "enemy eviction: the stage's enemy should get its sprite");
+
+        // The actor's sprite is the least recently used and unpinned
+        check(graphics.load_enemy_sprite(level.shp[1]) != nullptr, "enemy eviction: fixture sprite should load");
+        const TextureCacheStats loaded = graphics.get_texture_cache_stats(TextureCategory::ENEMY_SPRITES);
+        graphics.begin_texture_pins();
+        graphics.set_texture_budget(loaded.resident_bytes / 2);
+        graphics.pump_asset_uploads();
+        check(graphics.get_texture_cache_stats(TextureCategory::ENEMY_SPRITES).evictions >= 1,
+              "enemy eviction: going over budget should evict the actor's sprite");
+
+        actors.bind_enemy_sprites(&graphics);
+        check(graphics.get_texture_cache_stats(TextureCategory::ENEMY_SPRITES).misses == loaded.misses + 1,
+              "enemy eviction: binding should reload the evicted sprite");
+        graphics.set_texture_budget(0);
+        check(actors.get_enemies().animation_data[0] == graphics.load_enemy_sprite(level.shp[0]),
+              "enemy eviction: the actor should point at the reloaded sprite");
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    fs::current_path(original_cwd);
+    fs::remove_all(base);
+}
+
+void test_glyph_atlas_measures_and_wraps() {
+    // Any monospace face will do; the checks are in units of one advance
+    const char* const font_candidates[] = {
+        "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf",
+        "/usr/share/fonts/truetype/liberation/LiberationMono-Regular.ttf",
+        "/System/Library/Fonts/Menlo.ttc",
+        "C:\\Windows\\Fonts\\consola.ttf",
+    };
+
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0 || TTF_Init() < 0) {
+        check(false, std::string("SDL video/TTF init failed: ") + SDL_GetError());
+        return;
+    }
+    TTF_Font* font = nullptr;
+    for (const char* path : font_candidates) {
+        if ((font = TTF_OpenFont(path, 12)) != nullptr) {
+            break;
+        }
+    }
+    if (font == nullptr) {
+        std::cout << "  (no monospace font installed; glyph atlas checks skipped)" << std::endl;
+        TTF_Quit();
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return;
+    }
+
+    SDL_Window* windows[2] = {};
+    SDL_Renderer* renderers[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        windows[i] = SDL_CreateWindow("test_glyph_atlas", SDL_WINDOWPOS_UNDEFINED,
+                                      SDL_WINDOWPOS_UNDEFINED, 64, 64, SDL_WINDOW_HIDDEN);
+        renderers[i] = windows[i] ? SDL_CreateRenderer(windows[i], -1, SDL_RENDERER_SOFTWARE) : nullptr;
+    }
+    SDL_Renderer* first = renderers[0];
+    SDL_Renderer* second = renderers[1];
+    GlyphAtlas* atlas = first ? acquire_glyph_atlas(first, font) : nullptr;
+    check(atlas != nullptr && atlas->is_ready(), "glyph atlas: should build for an installed font");
+
+    if (atlas != nullptr && second != nullptr) {
+        const int w = atlas->measure_text("M");
+        check(w > 0, "glyph atlas: a glyph should advance");
+        check(atlas->measure_text("MMMM") == 4 * w && atlas->measure_text("a b") == 3 * w,
+              "glyph atlas: a line should measure the sum of its advances");
+        check(atlas->measure_text("") == 0 && atlas->measure_text(nullptr) == 0,
+              "glyph atlas: empty text should measure zero");
+        check(atlas->measure_text("\x01\xFF") == 2 * atlas->measure_text("?"),
+              "glyph atlas: bytes outside printable ASCII should measure as '?'");
+
+        auto wrap = [atlas](const std::string& text, int max_width) {
+            std::vector<std::string> rows;
+            atlas->wrap_text(text, max_width, rows);
+            return rows;
+        };
+        using Rows = std::vector<std::string>;
+        check(wrap("aaa bbb ccc", 7 * w) == Rows({"aaa bbb", "ccc"}),
+              "glyph atlas: wrapping should break at the last space that fits");
+        check(wrap("aaa   bbb", 4 * w) == Rows({"aaa", "bbb"}) && wrap("aaa  bbb", 5 * w) == Rows({"aaa", "bbb"}),
+              "glyph atlas: the spaces at a break should be dropped");
+        check(wrap("abcdefghij", 4 * w) == Rows({"abcd", "efgh", "ij"}),
+              "glyph atlas: a word wider than a row should break mid-word");
+        check(wrap("one\n\ntwo", 10 * w) == Rows({"one", "", "two"}),
+              "glyph atlas: newlines should break rows, keeping blank lines");
+        check(wrap("aaa bbb ccc", 0) == Rows({"aaa bbb ccc"}),
+              "glyph atlas: a zero width should not wrap");
+        check(wrap("ab", w / 2) == Rows({"a", "b"}),
+              "glyph atlas: every row should keep at least one glyph");
+
+        // Shared per renderer, face and rendering; releasing one renderer's
+        // atlases leaves the others'
+        check(acquire_glyph_atlas(first, font) == atlas, "glyph atlas: the same font should share its atlas");
+        GlyphAtlas* solid = acquire_glyph_atlas(first, font, true);
+        check(solid != nullptr && solid != atlas, "glyph atlas: a solid atlas should be separate");
+        GlyphAtlas* other = acquire_glyph_atlas(second, font);
+        check(other != nullptr && other != atlas && other->get_renderer() == second,
+              "glyph atlas: another renderer should get its own atlas");
+        release_glyph_atlases(first);
+        check(other->is_ready() && acquire_glyph_atlas(second, font) == other,
+              "glyph atlas: releasing a renderer should keep other renderers' atlases");
+        GlyphAtlas* rebuilt = acquire_glyph_atlas(first, font);
+        check(rebuilt != nullptr && rebuilt->is_ready() && rebuilt->get_renderer() == first,
+              "glyph atlas: a released renderer should get a new atlas");
+        release_glyph_atlases(first);
+        release_glyph_atlases(second);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        if (renderers[i]) SDL_DestroyRenderer(renderers[i]);
+        if (windows[i]) SDL_DestroyWindow(windows[i]);
+    }
+    TTF_CloseFont(font);
+    TTF_Quit();
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+}
+
 // Regression: viewport height must be derived from render_scale * PLAYFIELD_HEIGHT
 // so that it always agrees with the game-unit coordinate system used for sprites.
 // Previously, playfield_viewport.h = floor(160 * letterbox_scale) could produce a
@@ -318,17 +885,17 @@ void test_playfield_viewport_height_matches_render_scale() {
 void test_runtime_level_tiles_populated() {
     reset_physics_state();
     initialize_level_data();
-    current_level_number = LEVEL_NUMBER_FOREST;
-    current_stage_number = 0;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    current_level_ptr = nullptr;
+    test_game.current_level_number = LEVEL_NUMBER_FOREST;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.current_level_ptr = nullptr;
 
-    load_new_level();
-    check(current_level_ptr != nullptr, "current_level_ptr should be set after load_new_level");
+    load_new_level(test_game);
+    check(test_game.current_level_ptr != nullptr, "current_level_ptr should be set after load_new_level");
 
     bool any_non_zero = false;
-    const uint8_t* tiles = current_level_ptr->stages[current_stage_number].tiles;
+    const uint8_t* tiles = test_game.current_level_ptr->stages[test_game.current_stage_number].tiles;
     for (int i = 0; i < 128 * 10; ++i) {
         if (tiles[i] != 0) {
             any_non_zero = true;
@@ -337,5 +904,141 @@ void test_runtime_level_tiles_populated() {
     }
 
     check(any_non_zero, "current level tiles should be populated (non-zero)");
+    check(tiles == forest_stage_0_tiles,
+          "stage tiles should view the compiled-in map rather than a copy");
+    check(get_tile_at(test_game, 10, 4) == forest_stage_0_tiles[2 * 128 + 5],
+          "physics should read the stage map in place");
     reset_door_state();
 }
+
+void test_stage_background_cache_tracks_tile_revision() {
+    reset_physics_state();
+
+    // Every replacement of the stage tile map must bump the revision so the cached
+    // background texture is rebuilt for the new stage.
+    const uint32_t initial_revision = get_stage_tiles_revision(test_game);
+    check(load_stage_tiles(test_game, "forest", 0), "forest stage 0 should load");
+    const uint32_t forest_revision = get_stage_tiles_revision(test_game);
+    check(forest_revision != initial_revision,
+          "stage tile revision should change after load_stage_tiles");
+
+    check(load_stage_tiles(test_game, "forest", 0), "reloading forest stage 0 should succeed");
+    check(get_stage_tiles_revision(test_game) != forest_revision,
+          "reloading the same stage should still bump the revision");
+
+    const uint32_t before_reset = get_stage_tiles_revision(test_game);
+    reset_level_tiles(test_game);
+    check(get_stage_tiles_revision(test_game) != before_reset,
+          "reset_level_tiles should bump the stage tile revision");
+
+    // Without a renderer there is no cache; callers must fall back to render_tile.
+    GraphicsSystem graphics(nullptr);
+    Tileset empty_tileset;
+    check(!graphics.render_stage_background(test_game, &empty_tileset, 0, 8),
+          "stage background should be unavailable without a renderer");
+    check(!graphics.render_stage_background_region(test_game, 0, 0, 2, 4, 0, 8),
+          "stage background region copy should fail before the cache is built");
+}
+
+void test_sprite_batch_groups_draws_by_texture() {
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        check(false, std::string("SDL video init failed: ") + SDL_GetError());
+        return;
+    }
+
+    SDL_Window* window = SDL_CreateWindow(
+        "test_sprite_batch",
+        SDL_WINDOWPOS_UNDEFINED,
+        SDL_WINDOWPOS_UNDEFINED,
+        64,
+        64,
+        SDL_WINDOW_HIDDEN);
+    if (window == nullptr) {
+        check(false, std::string("SDL window creation failed: ") + SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return;
+    }
+
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if (renderer == nullptr) {
+        check(false, std::string("SDL renderer creation failed: ") + SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return;
+    }
+
+    SDL_Texture* texture_a = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                               SDL_TEXTUREACCESS_STATIC, 4, 4);
+    SDL_Texture* texture_b = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                               SDL_TEXTUREACCESS_STATIC, 4, 4);
+    check(texture_a != nullptr && texture_b != nullptr, "batch test textures should be created");
+    uint8_t red[4 * 4 * 4];
+    uint8_t green[4 * 4 * 4];
+    for (int i = 0; i < 4 * 4; ++i) {
+        const uint8_t red_pixel[4] = {255, 0, 0, 255};
+        const uint8_t green_pixel[4] = {0, 255, 0, 255};
+        std::memcpy(red + i * 4, red_pixel, 4);
+        std::memcpy(green + i * 4, green_pixel, 4);
+    }
+    SDL_UpdateTexture(texture_a, nullptr, red, 4 * 4);
+    SDL_UpdateTexture(texture_b, nullptr, green, 4 * 4);
+
+    {
+        GraphicsSystem graphics(renderer);
+        Sprite sprite_a = {{texture_a, 4, 4}, 4, 4};
+        Sprite sprite_b = {{texture_b, 4, 4}, 4, 4};
+
+        graphics.begin_frame();
+        graphics.begin_sprite_batch();
+        graphics.set_render_layer(RenderLayer::ENEMIES);
+        graphics.render_sprite_scaled(0, 0, sprite_a, 8, 8);
+        graphics.render_sprite_scaled(8, 0, sprite_b, 8, 8, true);
+        graphics.render_sprite_scaled(16, 0, sprite_a, 8, 8, true);
+        graphics.render_sprite_top_clip_scaled(24, 24, sprite_a, 8, 8, 4);
+        graphics.flush_sprite_batch();
+
+        // Drawing outside a batch is immediate and not counted by the queue.
+        graphics.render_sprite_scaled(0, 16, sprite_b, 8, 8);
+
+        // begin_frame publishes the counters of the frame that just finished.
+        graphics.begin_frame();
+        const RenderQueueStats stats = graphics.get_render_queue_stats();
+        check(stats.draws == 4, "render queue should count every queued sprite");
+        check(stats.batches == 3,
+              "adjacent same-texture sprites should share a batch, in submission order");
+        check(stats.render_calls == 4,
+              "render calls should count each batch and the immediate draw");
+        check(stats.texture_switches >= 2 && stats.texture_switches <= stats.render_calls,
+              "texture switches should count the changes between render calls");
+
+        graphics.begin_frame();
+        check(graphics.get_render_queue_stats().draws == 0,
+              "render queue counters should reset for an empty frame");
+
+        // Overlapping sprites draw in the order they were queued, whichever
+        // of their textures has the lower address
+        auto top_pixel = [&](const Sprite& first, const Sprite& second, uint8_t* pixel) {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            graphics.begin_sprite_batch();
+            graphics.set_render_layer(RenderLayer::ENEMIES);
+            graphics.render_sprite_scaled(0, 0, first, 8, 8);
+            graphics.render_sprite_scaled(0, 0, second, 8, 8);
+            graphics.flush_sprite_batch();
+            const SDL_Rect at = {4, 4, 1, 1};
+            SDL_RenderReadPixels(renderer, &at, SDL_PIXELFORMAT_RGBA32, pixel, 4);
+        };
+        uint8_t pixel[4] = {};
+        top_pixel(sprite_a, sprite_b, pixel);
+        check(pixel[0] == 0 && pixel[1] == 255, "overlapping sprites should draw in submission order (b on a)");
+        top_pixel(sprite_b, sprite_a, pixel);
+        check(pixel[0] == 255 && pixel[1] == 0, "overlapping sprites should draw in submission order (a on b)");
+    }
+
+    SDL_DestroyTexture(texture_a);
+    SDL_DestroyTexture(texture_b);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+}
@@ -8,44 +8,7 @@
 
 // Global variables
 int failures = 0;
-int comic_x = 0;
-int comic_y = 0;
-int8_t comic_y_vel = 0;
-int8_t comic_x_momentum = 0;
-uint8_t comic_facing = 1;
-uint8_t comic_animation = 0;
-uint8_t comic_is_falling_or_jumping = 0;
-uint8_t comic_jump_counter = 0;
-uint8_t comic_jump_power = JUMP_POWER_DEFAULT;
-uint8_t key_state_jump = 0;
-uint8_t previous_key_state_jump = 0;
-uint8_t key_state_left = 0;
-uint8_t key_state_right = 0;
-uint8_t key_state_open = 0;
-int camera_x = 0;
-
-uint8_t comic_has_door_key = 0;
-uint8_t current_level_number = 1;
-uint8_t current_stage_number = 0;
-const level_t* current_level_ptr = nullptr;
-int8_t source_door_level_number = -1;
-int8_t source_door_stage_number = -1;
-
-// Door animation globals are provided by doors.cpp via extern declarations in test_helpers.h
-
-uint8_t comic_y_checkpoint = 12;
-uint8_t comic_x_checkpoint = 14;
-
-ActorSystem* g_actor_system = nullptr;
-
-bool game_over_triggered = false;
-uint8_t comic_num_lives = 0;
-
-uint8_t comic_hp = MAX_HP;
-uint8_t comic_hp_pending_increase = 0;
-
-uint8_t score_bytes[3] = {0, 0, 0};
-uint8_t score_10000_counter = 0;
+GameContext test_game;
 
 // Helper implementations
 void check(bool condition, const std::string& message) {
@@ -70,53 +33,52 @@ Animation make_animation(const std::vector<int>& durations, bool looping) {
 }
 
 void reset_physics_state() {
-    init_test_level();
-    comic_x = 4;
-    comic_y = 14;
-    comic_y_vel = 0;
-    comic_x_momentum = 0;
-    comic_facing = 1; // RIGHT
-    comic_animation = 0;
-    comic_is_falling_or_jumping = 0;
-    comic_jump_power = JUMP_POWER_DEFAULT;
-    comic_jump_counter = comic_jump_power;
-    key_state_jump = 0;
-    previous_key_state_jump = 0;
-    key_state_left = 0;
-    key_state_right = 0;
-    key_state_open = 0;
-    camera_x = 0;
+    init_test_level(test_game);
+    test_game.comic_x = 4;
+    test_game.comic_y = 14;
+    test_game.comic_y_vel = 0;
+    test_game.comic_x_momentum = 0;
+    test_game.comic_facing = 1; // RIGHT
+    test_game.comic_is_falling_or_jumping = 0;
+    test_game.comic_jump_power = JUMP_POWER_DEFAULT;
+    test_game.comic_jump_counter = test_game.comic_jump_power;
+    test_game.key_state_jump = 0;
+    test_game.previous_key_state_jump = 0;
+    test_game.key_state_left = 0;
+    test_game.key_state_right = 0;
+    test_game.key_state_open = 0;
+    test_game.camera_x = 0;
     
     // Reset door/level state too
-    comic_has_door_key = 0;
-    current_level_number = 1;
-    current_stage_number = 0;
-    current_level_ptr = nullptr;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
+    test_game.comic_has_door_key = 0;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.current_level_ptr = nullptr;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
     
-    game_over_triggered = false;
-    comic_num_lives = 3;
-    comic_hp = MAX_HP;
-    comic_hp_pending_increase = 0;
+    test_game.game_over_triggered = false;
+    test_game.comic_num_lives = 3;
+    test_game.comic_hp = MAX_HP;
+    test_game.comic_hp_pending_increase = 0;
     
-    score_bytes[0] = 0;
-    score_bytes[1] = 0;
-    score_bytes[2] = 0;
-    score_10000_counter = 0;
+    test_game.score_bytes[0] = 0;
+    test_game.score_bytes[1] = 0;
+    test_game.score_bytes[2] = 0;
+    test_game.score_10000_counter = 0;
 }
 
 void reset_door_state() {
-    comic_has_door_key = 0;
-    key_state_open = 0;
-    current_level_number = 1;
-    current_stage_number = 0;
-    current_level_ptr = nullptr;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    g_door_anim_phase = DoorAnimationPhase::NONE;
-    g_door_anim_frame = 0;
-    g_skip_load_on_door = true;
+    test_game.comic_has_door_key = 0;
+    test_game.key_state_open = 0;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.current_level_ptr = nullptr;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.door_anim_phase = DoorAnimationPhase::NONE;
+    test_game.door_anim_frame = 0;
+    test_game.skip_load_on_door = true;
 }
 
 level_t* create_test_level_with_door(uint8_t door_x, uint8_t door_y, uint8_t target_level, uint8_t target_stage) {
@@ -138,22 +100,22 @@ level_t* create_test_level_with_door(uint8_t door_x, uint8_t door_y, uint8_t tar
 }
 
 void simulate_tick() {
-    process_jump_input();
-    handle_fall_or_jump();
+    process_jump_input(test_game);
+    handle_fall_or_jump(test_game);
 }
 
 int measure_jump_height(uint8_t jump_power) {
     reset_physics_state();
-    comic_jump_power = jump_power;
-    comic_jump_counter = comic_jump_power;
-    int start_y = comic_y;
-    int min_y = comic_y;
-    key_state_jump = 1;
+    test_game.comic_jump_power = jump_power;
+    test_game.comic_jump_counter = test_game.comic_jump_power;
+    int start_y = test_game.comic_y;
+    int min_y = test_game.comic_y;
+    test_game.key_state_jump = 1;
     simulate_tick();
     for (int tick = 0; tick < 200; ++tick) {
         simulate_tick();
-        min_y = std::min(min_y, comic_y);
-        if (comic_is_falling_or_jumping == 0 && tick > 0) {
+        min_y = std::min(min_y, test_game.comic_y);
+        if (test_game.comic_is_falling_or_jumping == 0 && tick > 0) {
             break;
         }
     }
@@ -161,8 +123,8 @@ int measure_jump_height(uint8_t jump_power) {
 }
 
 void advance_death_sequence_until_complete(int max_ticks) {
-    for (int i = 0; i < max_ticks && is_player_dying(); ++i) {
-        update_player_death_sequence();
+    for (int i = 0; i < max_ticks && is_player_dying(test_game); ++i) {
+        update_player_death_sequence(test_game);
     }
 }
 
@@ -0,0 +1,55 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/input_latency.h"
+#include "../include/replay.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+void test_input_latency_press_to_present() {
+    InputLatencyTracker latency;
+    latency.record_press(INPUT_JUMP, 100, 105);
+    latency.record_tick(0, 120);
+    latency.record_present(130);
+    check(latency.get_samples().empty(), "input_latency: disabled should record nothing");
+
+    latency.set_enabled(true);
+    latency.record_press(INPUT_JUMP | INPUT_RIGHT, 100, 105);
+    latency.record_present(110);  // No tick has read the keys yet
+    check(latency.get_samples().empty(), "input_latency: a present before the tick shows nothing");
+    latency.record_tick(7, 190);
+    latency.record_tick(8, 300);  // The keys belong to the first tick that read them
+    latency.record_present(205);
+    const auto& samples = latency.get_samples();
+    check(samples.size() == 2, "input_latency: each pressed key should be a sample");
+    check(samples.size() == 2 && samples[0].tick == 7 && samples[0].tick_ms == 190 && samples[0].present_ms == 205,
+          "input_latency: a sample should hold the consuming tick and the next present");
+    check(samples.size() == 2 && samples[0].event_ms == 100 && samples[0].poll_ms == 105,
+          "input_latency: a sample should keep the event and poll times");
+
+    // A tap released before any tick read it never reaches the game
+    latency.record_press(INPUT_FIRE, 400, 401);
+    latency.record_release(INPUT_FIRE);
+    latency.record_tick(9, 420);
+    latency.record_present(430);
+    check(latency.get_lost_presses() == 1 && latency.get_samples().size() == 2,
+          "input_latency: released taps should be counted as lost");
+
+    latency.record_press(INPUT_LEFT, 500, 500);
+    latency.discard_pending();
+    latency.record_tick(10, 510);
+    latency.record_present(520);
+    check(latency.get_samples().size() == 2, "input_latency: discarded presses should not be sampled");
+
+    const std::string path = "test_input_latency.csv";
+    check(latency.write_csv(path), "input_latency: the CSV log should be written");
+    std::ifstream file(path);
+    std::string header;
+    std::string row;
+    std::getline(file, header);
+    std::getline(file, row);
+    check(header == "key,event_ms,poll_ms,tick,tick_ms,present_ms", "input_latency: CSV header");
+    check(row == "2,100,105,7,190,205", "input_latency: CSV row per sample");
+    file.close();
+    std::remove(path.c_str());
+}
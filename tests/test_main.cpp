@@ -8,6 +8,7 @@ static const std::vector<TestCase>& test_registry() {
     static const std::vector<TestCase> tests = {
         // Physics & Tiles
         {"physics_tiles", test_physics_tiles},
+        {"collision_bitboard_matches_tile_probes", test_collision_bitboard_matches_tile_probes},
         {"jump_edge_trigger", test_jump_edge_trigger},
         {"jump_recharge", test_jump_recharge},
         {"jump_height", test_jump_height},
@@ -26,12 +27,14 @@ static const std::vector<TestCase>& test_registry() {
         {"door_animation_phase_progression_and_render_state", test_door_animation_phase_progression_and_render_state},
         {"door_destination_load_deferred_until_entering_complete", test_door_destination_load_deferred_until_entering_complete},
         {"door_entry_sets_checkpoint_for_respawn", test_door_entry_sets_checkpoint_for_respawn},
+        {"stage_prefetch_covers_exits_and_doors", test_stage_prefetch_covers_exits_and_doors},
         {"stage_left_exit_blocked", test_stage_left_exit_blocked},
         {"stage_right_exit_blocked", test_stage_right_exit_blocked},
         {"stage_left_edge_detection", test_stage_left_edge_detection},
         {"stage_right_edge_detection", test_stage_right_edge_detection},
         {"cave_level_solidity", test_cave_level_solidity},
         {"problematic_levels_have_solid_tiles", test_problematic_levels_have_solid_tiles},
+        {"streamed_stage_map_window_follows_comic", test_streamed_stage_map_window_follows_comic},
 
         // Graphics & Assets
         {"animation_looping", test_animation_looping},
@@ -39,11 +42,21 @@ static const std::vector<TestCase>& test_registry() {
         {"animation_zero_duration", test_animation_zero_duration},
         {"enemy_animation_sequence", test_enemy_animation_sequence},
         {"tileset_blackout_state_tracking", test_tileset_blackout_state_tracking},
+        {"registry_handles_resolve_by_id", test_registry_handles_resolve_by_id},
+        {"asset_decode_pool_completes_jobs", test_asset_decode_pool_completes_jobs},
+        {"asset_pack_lookup_by_name_hash", test_asset_pack_lookup_by_name_hash},
+        {"load_graph_orders_tasks_and_reports", test_load_graph_orders_tasks_and_reports},
+        {"ega_planar_decode_matches_reference", test_ega_planar_decode_matches_reference},
         {"asset_path_resolution", test_asset_path_resolution},
         {"tileset_blackout_state_tracks_unloaded_tileset",
          test_tileset_blackout_state_tracks_unloaded_tileset},
+        {"texture_cache_evicts_unpinned_lru", test_texture_cache_evicts_unpinned_lru},
+        {"enemy_sprite_eviction_rebinds_actors", test_enemy_sprite_eviction_rebinds_actors},
+        {"glyph_atlas_measures_and_wraps", test_glyph_atlas_measures_and_wraps},
         {"runtime_level_tiles_populated", test_runtime_level_tiles_populated},
         {"playfield_viewport_height_matches_render_scale", test_playfield_viewport_height_matches_render_scale},
+        {"stage_background_cache_tracks_tile_revision", test_stage_background_cache_tracks_tile_revision},
+        {"sprite_batch_groups_draws_by_texture", test_sprite_batch_groups_draws_by_texture},
 
         // Actors & Items
         {"actor_spawn_one_per_tick", test_actor_spawn_one_per_tick},
@@ -57,7 +70,9 @@ static const std::vector<TestCase>& test_registry() {
         {"actor_restraint_throttling", test_actor_restraint_throttling},
         {"actor_door_key_sync", test_actor_door_key_sync},
         {"actor_spawn_avoids_solid_tiles", test_actor_spawn_avoids_solid_tiles},
+        {"actor_door_tiles_stay_solid_for_enemies", test_actor_door_tiles_stay_solid_for_enemies},
         {"actor_pit_fall_despawns_without_spark", test_actor_pit_fall_despawns_without_spark},
+        {"actor_pool_broadphase", test_actor_pool_broadphase},
         {"fireball_meter_depletion_timing", test_fireball_meter_depletion_timing},
         {"fireball_meter_recharge_timing", test_fireball_meter_recharge_timing},
         {"fireball_offscreen_deactivates", test_fireball_offscreen_deactivates},
@@ -78,6 +93,9 @@ static const std::vector<TestCase>& test_registry() {
         {"audio_enemy_hit_interrupts_fire", test_audio_enemy_hit_interrupts_fire},
         {"audio_all_sounds_playable", test_audio_all_sounds_playable},
         {"audio_music_playback", test_audio_music_playback},
+        {"audio_low_latency_voice_pool", test_audio_low_latency_voice_pool},
+        {"audio_synthesis_matches_per_sample_generator", test_audio_synthesis_matches_per_sample_generator},
+        {"audio_synthesis_reuses_cached_waveform", test_audio_synthesis_reuses_cached_waveform},
 
         // UI & Score
         {"ui_score_base100_encoding", test_ui_score_base100_encoding},
@@ -85,6 +103,7 @@ static const std::vector<TestCase>& test_registry() {
         {"ui_boots_detection", test_ui_boots_detection},
         {"ui_score_edge_cases", test_ui_score_edge_cases},
         {"ui_meter_all_states", test_ui_meter_all_states},
+        {"ui_hud_state_change_detection", test_ui_hud_state_change_detection},
         {"award_points_no_carry", test_award_points_no_carry},
         {"award_points_accumulates_in_byte0", test_award_points_accumulates_in_byte0},
         {"award_points_carry_into_byte1", test_award_points_carry_into_byte1},
@@ -94,7 +113,45 @@ static const std::vector<TestCase>& test_registry() {
         {"award_points_large_carry_saturation", test_award_points_large_carry_saturation},
         {"award_points_awards_extra_life_every_50000", test_award_points_awards_extra_life_every_50000},
         {"award_points_awards_extra_life_after_500_internal_units", test_award_points_awards_extra_life_after_500_internal_units},
-        {"high_score_bytes_conversion", test_high_score_bytes_conversion}
+        {"high_score_bytes_conversion", test_high_score_bytes_conversion},
+        {"title_fade_layers_split", test_title_fade_layers_split},
+
+        // Replay
+        {"replay_round_trip", test_replay_round_trip},
+        {"replay_rejects_corrupt_data", test_replay_rejects_corrupt_data},
+
+        // Game contexts
+        {"game_contexts_are_independent", test_game_contexts_are_independent},
+        {"batch_runner_matches_sequential", test_batch_runner_matches_sequential},
+
+        // Snapshots
+        {"snapshot_restore_reproduces_game", test_snapshot_restore_reproduces_game},
+        {"snapshot_ring_rewind", test_snapshot_ring_rewind},
+        {"snapshot_ring_hour_budget", test_snapshot_ring_hour_budget},
+        {"snapshot_ring_finds_divergence", test_snapshot_ring_finds_divergence},
+        {"snapshot_rejects_corrupt_state", test_snapshot_rejects_corrupt_state},
+        {"snapshot_refuses_enlarged_pool", test_snapshot_refuses_enlarged_pool},
+
+        // Frame profiler
+        {"profiler_records_exclusive_phase_times", test_profiler_records_exclusive_phase_times},
+        {"profiler_perf_log_writes_csv", test_profiler_perf_log_writes_csv},
+
+        // Runtime counters
+        {"counters_sound_priorities_and_reset", test_counters_sound_priorities_and_reset},
+        {"counters_enemy_spawns_and_despawns", test_counters_enemy_spawns_and_despawns},
+        {"frame_pacer_fixed_mode_spaces_presents", test_frame_pacer_fixed_mode_spaces_presents},
+        {"render_interpolator_offsets_and_snaps", test_render_interpolator_offsets_and_snaps},
+        {"scene_change_tracker_skips_unchanged_frames", test_scene_change_tracker_skips_unchanged_frames},
+        {"input_latency_press_to_present", test_input_latency_press_to_present},
+        {"sim_thread_queue_and_triple_buffer", test_sim_thread_queue_and_triple_buffer},
+        {"sim_thread_matches_sequential_ticks", test_sim_thread_matches_sequential_ticks},
+        {"sequencer_waits_and_keys", test_sequencer_waits_and_keys},
+        {"victory_tally_pays_awarded_lives", test_victory_tally_pays_awarded_lives},
+        {"frame_capture_i420_conversion", test_frame_capture_i420_conversion},
+        {"frame_capture_writer_y4m_stream", test_frame_capture_writer_y4m_stream},
+        {"frame_arena_bump_and_reset", test_frame_arena_bump_and_reset},
+        {"zero_alloc_gameplay_ticks_after_warmup", test_zero_alloc_gameplay_ticks_after_warmup},
+        {"zero_alloc_render_frame_after_warmup", test_zero_alloc_render_frame_after_warmup}
     };
     return tests;
 }
@@ -1,45 +1,123 @@
 #include "test_helpers.h"
 #include "test_cases.h"
+#include "../include/counters.h"
+#include "../include/snapshot.h"
+#include "../include/tile_map.h"
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <vector>
 
 void test_physics_tiles() {
     reset_physics_state();
-    init_test_level();
+    init_test_level(test_game);
 
-    uint8_t ground_tile = get_tile_at(0, 18); // tile_y = 9 (ground row)
+    uint8_t ground_tile = get_tile_at(test_game, 0, 18); // tile_y = 9 (ground row)
     check(ground_tile == 0x3F, "ground tile should be 0x3F");
 
-    uint8_t out_of_bounds = get_tile_at(255, 30); // tile_y = 15 (out of bounds)
+    uint8_t out_of_bounds = get_tile_at(test_game, 255, 30); // tile_y = 15 (out of bounds)
     check(out_of_bounds == 0, "out-of-bounds tile should be 0");
 
-    check(is_tile_solid(0x3F), "tile 0x3F should be solid");
-    check(!is_tile_solid(0x3E), "tile 0x3E should be passable");
+    check(is_tile_solid(test_game, 0x3F), "tile 0x3F should be solid");
+    check(!is_tile_solid(test_game, 0x3E), "tile 0x3E should be passable");
+}
+
+void test_collision_bitboard_matches_tile_probes() {
+    level_t level{};
+    level.tileset_last_passable = 0x20;
+    level.door_tile_ul = 0x30;
+    level.door_tile_ur = 0x31;
+    level.door_tile_ll = 0x30;
+    level.door_tile_lr = 0x31;
+    level.door_frame_tiles[0] = 0x32;
+    const SolidityTable table = build_solidity_table(level.tileset_last_passable, &level);
+    check(!table.is_solid(0x20) && table.is_solid(0x21) && table.is_solid(0xFF),
+          "solidity table: tiles above tileset_last_passable should be solid");
+    check(!table.is_solid(0x30) && !table.is_solid(0x31) && !table.is_solid(0x32) && !table.is_solid(0),
+          "solidity table: door and door frame tiles should be passable");
+
+    std::vector<uint8_t> tiles(MAP_WIDTH_TILES * MAP_HEIGHT_TILES);
+    uint32_t seed = 99;
+    for (uint8_t& tile : tiles) {
+        seed = seed * 1103515245u + 12345u;
+        tile = static_cast<uint8_t>(seed >> 24) & 0x3F;
+    }
+    CollisionBitboard board;
+    board.build(tiles.data(), table);
+    auto solid = [&](int x, int y) {
+        return x >= 0 && x < MAP_WIDTH_TILES && y >= 0 && y < MAP_HEIGHT_TILES &&
+               table.is_solid(tiles[y * MAP_WIDTH_TILES + x]);
+    };
+
+    bool rows_match = true;
+    bool columns_match = true;
+    for (int y = 0; y < MAP_HEIGHT_TILES; ++y) {
+        for (int x = 0; x < MAP_WIDTH_TILES; ++x) {
+            rows_match &= board.is_solid(x, y) == solid(x, y);
+            for (int last = x; last < std::min(x + 70, MAP_WIDTH_TILES + 1); last += 3) {
+                bool expected = false;
+                for (int i = x; i <= last; ++i) {
+                    expected |= solid(i, y);
+                }
+                rows_match &= board.any_solid_in_row(y, x, last) == expected;
+            }
+            int below = -1;
+            for (int i = y; i < MAP_HEIGHT_TILES && below < 0; ++i) {
+                below = solid(x, i) ? i : -1;
+            }
+            int above = -1;
+            int open = -1;
+            for (int i = y; i >= 0; --i) {
+                if (above < 0 && solid(x, i)) {
+                    above = i;
+                }
+                if (open < 0 && !solid(x, i)) {
+                    open = i;
+                }
+            }
+            columns_match &= board.find_solid_at_or_below(x, y) == below &&
+                             board.find_solid_at_or_above(x, y) == above &&
+                             board.find_open_at_or_above(x, y) == open &&
+                             board.any_solid_in_column(x, y, y + 1) == (solid(x, y) || solid(x, y + 1));
+        }
+    }
+    check(rows_match, "collision bitboard: row probes should match per-tile checks");
+    check(columns_match, "collision bitboard: column scans should match per-tile checks");
+    check(!board.is_solid(MAP_WIDTH_TILES, 0) && !board.any_solid_in_row(MAP_HEIGHT_TILES, 0, 127),
+          "collision bitboard: cells outside the stage should be passable");
+
+    // Noclip masks the player's checks but not the shared stage bitboard
+    init_test_level(test_game);
+    set_noclip(test_game, true);
+    check(!is_tile_solid(test_game, 0x3F), "noclip: tiles should not be solid for the player");
+    check(get_stage_collision(test_game).is_solid(0, 9), "noclip: stage bitboard should keep its solids");
+    set_noclip(test_game, false);
+    check(is_tile_solid(test_game, 0x3F), "noclip: clearing it should restore solidity");
 }
 
 void test_jump_edge_trigger() {
     reset_physics_state();
 
-    key_state_jump = 1;
+    test_game.key_state_jump = 1;
     simulate_tick();
-    check(comic_is_falling_or_jumping == 1, "jump should start on key press edge");
+    check(test_game.comic_is_falling_or_jumping == 1, "jump should start on key press edge");
 
-    comic_is_falling_or_jumping = 0;
-    comic_y = 14;
-    comic_y_vel = 0;
-    comic_jump_counter = comic_jump_power;
-    key_state_jump = 1;
+    test_game.comic_is_falling_or_jumping = 0;
+    test_game.comic_y = 14;
+    test_game.comic_y_vel = 0;
+    test_game.comic_jump_counter = test_game.comic_jump_power;
+    test_game.key_state_jump = 1;
     simulate_tick();
-    check(comic_is_falling_or_jumping == 0, "holding jump should not retrigger");
+    check(test_game.comic_is_falling_or_jumping == 0, "holding jump should not retrigger");
 }
 
 void test_jump_recharge() {
     reset_physics_state();
 
-    comic_jump_counter = 1;
-    key_state_jump = 0;
+    test_game.comic_jump_counter = 1;
+    test_game.key_state_jump = 0;
     simulate_tick();
-    check(comic_jump_counter == comic_jump_power, "jump counter should recharge on release");
+    check(test_game.comic_jump_counter == test_game.comic_jump_power, "jump counter should recharge on release");
 }
 
 void test_jump_height() {
@@ -55,173 +133,173 @@ void test_jump_height() {
 
 void test_space_level_uses_lower_gravity() {
     reset_physics_state();
-    comic_x = 4;
-    comic_y = 6;
-    comic_is_falling_or_jumping = 1;
-    comic_jump_counter = 1;
-    comic_y_vel = 0;
-    key_state_jump = 0;
-    key_state_left = 0;
-    key_state_right = 0;
-
-    current_level_number = LEVEL_NUMBER_FOREST;
-    handle_fall_or_jump();
-    check(comic_y_vel == COMIC_GRAVITY,
+    test_game.comic_x = 4;
+    test_game.comic_y = 6;
+    test_game.comic_is_falling_or_jumping = 1;
+    test_game.comic_jump_counter = 1;
+    test_game.comic_y_vel = 0;
+    test_game.key_state_jump = 0;
+    test_game.key_state_left = 0;
+    test_game.key_state_right = 0;
+
+    test_game.current_level_number = LEVEL_NUMBER_FOREST;
+    handle_fall_or_jump(test_game);
+    check(test_game.comic_y_vel == COMIC_GRAVITY,
         "normal levels should apply COMIC_GRAVITY");
 
     reset_physics_state();
-    comic_x = 4;
-    comic_y = 6;
-    comic_is_falling_or_jumping = 1;
-    comic_jump_counter = 1;
-    comic_y_vel = 0;
-    key_state_jump = 0;
-    key_state_left = 0;
-    key_state_right = 0;
-
-    current_level_number = LEVEL_NUMBER_SPACE;
-    handle_fall_or_jump();
-    check(comic_y_vel == COMIC_GRAVITY_SPACE,
+    test_game.comic_x = 4;
+    test_game.comic_y = 6;
+    test_game.comic_is_falling_or_jumping = 1;
+    test_game.comic_jump_counter = 1;
+    test_game.comic_y_vel = 0;
+    test_game.key_state_jump = 0;
+    test_game.key_state_left = 0;
+    test_game.key_state_right = 0;
+
+    test_game.current_level_number = LEVEL_NUMBER_SPACE;
+    handle_fall_or_jump(test_game);
+    check(test_game.comic_y_vel == COMIC_GRAVITY_SPACE,
         "space level should apply COMIC_GRAVITY_SPACE");
 }
 
 void test_jump_top_clamped_to_playfield() {
     reset_physics_state();
-    comic_x = 4;
-    comic_y = 0;
-    comic_is_falling_or_jumping = 1;
-    comic_jump_counter = 2;
-    comic_y_vel = -16;
-    key_state_jump = 1;
-    key_state_left = 0;
-    key_state_right = 0;
-    current_level_number = LEVEL_NUMBER_FOREST;
-
-    handle_fall_or_jump();
-
-    check(comic_y == 0,
+    test_game.comic_x = 4;
+    test_game.comic_y = 0;
+    test_game.comic_is_falling_or_jumping = 1;
+    test_game.comic_jump_counter = 2;
+    test_game.comic_y_vel = -16;
+    test_game.key_state_jump = 1;
+    test_game.key_state_left = 0;
+    test_game.key_state_right = 0;
+    test_game.current_level_number = LEVEL_NUMBER_FOREST;
+
+    handle_fall_or_jump(test_game);
+
+    check(test_game.comic_y == 0,
         "jump top clamp: player y should stay at top boundary (0)");
-    check(!is_player_dying(),
+    check(!is_player_dying(test_game),
         "jump top clamp: top clamp should not trigger death state");
 }
 
 void test_player_death_sequence_respawn() {
     reset_physics_state();
-    game_over_triggered = false;
-    comic_num_lives = 3;
-    comic_hp = 1;
-    comic_x = 50;
-    comic_y = 9;
-    comic_x_momentum = 3;
-    comic_y_vel = 4;
-    comic_is_falling_or_jumping = 0;
-    comic_jump_counter = 0;
-    key_state_jump = 1;
-    previous_key_state_jump = 1;
-    comic_x_checkpoint = 22;
-    comic_y_checkpoint = 12;
-
-    trigger_player_death(true);
-    check(is_player_dying(), "death: player should enter dying state after trigger");
-    check(should_show_player_death_animation(),
+    test_game.game_over_triggered = false;
+    test_game.comic_num_lives = 3;
+    test_game.comic_hp = 1;
+    test_game.comic_x = 50;
+    test_game.comic_y = 9;
+    test_game.comic_x_momentum = 3;
+    test_game.comic_y_vel = 4;
+    test_game.comic_is_falling_or_jumping = 0;
+    test_game.comic_jump_counter = 0;
+    test_game.key_state_jump = 1;
+    test_game.previous_key_state_jump = 1;
+    test_game.comic_x_checkpoint = 22;
+    test_game.comic_y_checkpoint = 12;
+
+    trigger_player_death(test_game, true);
+    check(is_player_dying(test_game), "death: player should enter dying state after trigger");
+    check(should_show_player_death_animation(test_game),
         "death: animation phase should be active immediately after trigger");
 
     int animation_ticks = 0;
-    while (is_player_dying() && should_show_player_death_animation() && animation_ticks < 64) {
-        update_player_death_sequence();
+    while (is_player_dying(test_game) && should_show_player_death_animation(test_game) && animation_ticks < 64) {
+        update_player_death_sequence(test_game);
         animation_ticks++;
     }
 
     check(animation_ticks > 0, "death: animation phase should consume at least one tick");
-    check(is_player_dying() && !should_show_player_death_animation(),
+    check(is_player_dying(test_game) && !should_show_player_death_animation(test_game),
         "death: sequence should transition into too-bad wait phase");
 
     advance_death_sequence_until_complete();
 
-    check(!is_player_dying(), "death: sequence should complete for respawn path");
-    check(comic_num_lives == 2, "death: lives should decrement by one on respawn path");
-    check(!game_over_triggered, "death: game_over flag should remain false when lives remain");
-    check(comic_x == comic_x_checkpoint && comic_y == comic_y_checkpoint,
+    check(!is_player_dying(test_game), "death: sequence should complete for respawn path");
+    check(test_game.comic_num_lives == 2, "death: lives should decrement by one on respawn path");
+    check(!test_game.game_over_triggered, "death: game_over flag should remain false when lives remain");
+    check(test_game.comic_x == test_game.comic_x_checkpoint && test_game.comic_y == test_game.comic_y_checkpoint,
         "death: respawn path should restore checkpoint position");
-    check(comic_hp == MAX_HP, "death: respawn path should restore full HP");
-    check(comic_is_falling_or_jumping == 1,
+    check(test_game.comic_hp == MAX_HP, "death: respawn path should restore full HP");
+    check(test_game.comic_is_falling_or_jumping == 1,
         "death: respawn path should place player into falling state");
-    check(comic_jump_counter == comic_jump_power,
+    check(test_game.comic_jump_counter == test_game.comic_jump_power,
         "death: respawn path should reset jump counter to jump power");
-    check(key_state_jump == 0 && previous_key_state_jump == 0,
+    check(test_game.key_state_jump == 0 && test_game.previous_key_state_jump == 0,
         "death: respawn path should clear jump input edge state");
 }
 
 void test_player_death_sequence_game_over() {
     reset_physics_state();
-    game_over_triggered = false;
-    comic_num_lives = 0;
-    comic_hp = 2;
-    comic_x = 41;
-    comic_y = 8;
-    comic_x_checkpoint = 20;
-    comic_y_checkpoint = 12;
-
-    trigger_player_death(false);
-    check(is_player_dying(), "game_over: player should enter dying state");
-    check(!should_show_player_death_animation(),
+    test_game.game_over_triggered = false;
+    test_game.comic_num_lives = 0;
+    test_game.comic_hp = 2;
+    test_game.comic_x = 41;
+    test_game.comic_y = 8;
+    test_game.comic_x_checkpoint = 20;
+    test_game.comic_y_checkpoint = 12;
+
+    trigger_player_death(test_game, false);
+    check(is_player_dying(test_game), "game_over: player should enter dying state");
+    check(!should_show_player_death_animation(test_game),
         "game_over: animation visibility should be off when trigger requested no animation");
 
     advance_death_sequence_until_complete();
 
-    check(!is_player_dying(), "game_over: death sequence should finish");
-    check(comic_num_lives == 0, "game_over: lives should remain zero");
-    check(game_over_triggered, "game_over: zero lives should trigger game-over flag");
-    check(comic_x == 41 && comic_y == 8,
+    check(!is_player_dying(test_game), "game_over: death sequence should finish");
+    check(test_game.comic_num_lives == 0, "game_over: lives should remain zero");
+    check(test_game.game_over_triggered, "game_over: zero lives should trigger game-over flag");
+    check(test_game.comic_x == 41 && test_game.comic_y == 8,
         "game_over: zero-lives path should not respawn to checkpoint");
-    check(comic_hp == 2, "game_over: zero-lives path should not reset HP");
+    check(test_game.comic_hp == 2, "game_over: zero-lives path should not reset HP");
 }
 
 void test_player_death_sequence_last_life_allows_one_more_play() {
     reset_physics_state();
-    game_over_triggered = false;
-    comic_num_lives = 1;
-    comic_hp = 2;
-    comic_x = 41;
-    comic_y = 8;
-    comic_x_checkpoint = 20;
-    comic_y_checkpoint = 12;
+    test_game.game_over_triggered = false;
+    test_game.comic_num_lives = 1;
+    test_game.comic_hp = 2;
+    test_game.comic_x = 41;
+    test_game.comic_y = 8;
+    test_game.comic_x_checkpoint = 20;
+    test_game.comic_y_checkpoint = 12;
 
-    trigger_player_death(false);
-    check(is_player_dying(), "last_life: player should enter dying state");
+    trigger_player_death(test_game, false);
+    check(is_player_dying(test_game), "last_life: player should enter dying state");
 
     advance_death_sequence_until_complete();
 
-    check(!is_player_dying(), "last_life: death sequence should finish");
-    check(comic_num_lives == 0,
+    check(!is_player_dying(test_game), "last_life: death sequence should finish");
+    check(test_game.comic_num_lives == 0,
         "last_life: one remaining life should be consumed on respawn path");
-    check(!game_over_triggered,
+    check(!test_game.game_over_triggered,
         "last_life: game over should not trigger until the next death at zero lives");
-    check(comic_x == comic_x_checkpoint && comic_y == comic_y_checkpoint,
+    check(test_game.comic_x == test_game.comic_x_checkpoint && test_game.comic_y == test_game.comic_y_checkpoint,
         "last_life: player should respawn at checkpoint when starting death with one life");
-    check(comic_hp == MAX_HP,
+    check(test_game.comic_hp == MAX_HP,
         "last_life: respawn should refill HP");
 }
 
 void test_teleport_does_not_update_respawn_checkpoint() {
     reset_physics_state();
 
-    comic_x_checkpoint = 22;
-    comic_y_checkpoint = 12;
+    test_game.comic_x_checkpoint = 22;
+    test_game.comic_y_checkpoint = 12;
 
-    comic_x = 40;
-    comic_y = 8;
+    test_game.comic_x = 40;
+    test_game.comic_y = 8;
 
     apply_teleport_destination_if_ready(
         3,
         60,
         6,
-        comic_x,
-        comic_y);
+        test_game.comic_x,
+        test_game.comic_y);
 
-    check(comic_x == 60 && comic_y == 6,
+    check(test_game.comic_x == 60 && test_game.comic_y == 6,
         "teleport_checkpoint: teleport frame should move player to destination");
-    check(comic_x_checkpoint == 22 && comic_y_checkpoint == 12,
+    check(test_game.comic_x_checkpoint == 22 && test_game.comic_y_checkpoint == 12,
         "teleport_checkpoint: teleport should not modify respawn checkpoint");
 }
 
@@ -229,64 +307,64 @@ void test_door_activation_alignment_x() {
     reset_physics_state();
     reset_door_state();
     level_t* level = create_test_level_with_door(10, 8, 1, 1);
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
     
     // Test activation at exact door position
-    comic_x = 10;
-    comic_y = 8;
-    uint8_t result = check_door_activation();
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    uint8_t result = check_door_activation(test_game);
     check(result == 1, "door should activate at exact position (x=10, y=8)");
     
     // Test activation 1 unit to the right
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
-    comic_x = 11;
-    comic_y = 8;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
+    test_game.comic_x = 11;
+    test_game.comic_y = 8;
+    result = check_door_activation(test_game);
     check(result == 1, "door should activate 1 unit offset (x=11, y=8)");
     
     // Test activation 2 units to the right (boundary)
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
-    comic_x = 12;
-    comic_y = 8;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
+    test_game.comic_x = 12;
+    test_game.comic_y = 8;
+    result = check_door_activation(test_game);
     check(result == 1, "door should activate 2 units offset (x=12, y=8)");
     
     // Test no activation 3 units away (too far)
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
-    comic_x = 13;
-    comic_y = 8;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
+    test_game.comic_x = 13;
+    test_game.comic_y = 8;
+    result = check_door_activation(test_game);
     check(result == 0, "door should not activate 3 units away (x=13, y=8)");
     
     // Test no activation to the left
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
-    comic_x = 9;
-    comic_y = 8;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
+    test_game.comic_x = 9;
+    test_game.comic_y = 8;
+    result = check_door_activation(test_game);
     check(result == 0, "door should not activate left of position (x=9, y=8)");
 }
 
@@ -294,40 +372,40 @@ void test_door_activation_alignment_y() {
     reset_physics_state();
     reset_door_state();
     level_t* level = create_test_level_with_door(10, 8, 1, 1);
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
     
     // Test exact Y match
-    comic_x = 10;
-    comic_y = 8;
-    uint8_t result = check_door_activation();
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    uint8_t result = check_door_activation(test_game);
     check(result == 1, "door should activate at exact Y (y=8)");
     
     // Test Y one unit above
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
-    comic_x = 10;
-    comic_y = 7;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 7;
+    result = check_door_activation(test_game);
     check(result == 0, "door should not activate above door (y=7)");
     
     // Test Y one unit below
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    key_state_open = 1;
-    comic_x = 10;
-    comic_y = 9;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.key_state_open = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 9;
+    result = check_door_activation(test_game);
     check(result == 0, "door should not activate below door (y=9)");
 }
 
@@ -335,28 +413,28 @@ void test_door_key_requirement() {
     reset_physics_state();
     reset_door_state();
     level_t* level = create_test_level_with_door(10, 8, 1, 1);
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_x = 10;
-    comic_y = 8;
-    key_state_open = 1;
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.key_state_open = 1;
     
     // Test without key
-    comic_has_door_key = 0;
-    uint8_t result = check_door_activation();
+    test_game.comic_has_door_key = 0;
+    uint8_t result = check_door_activation(test_game);
     check(result == 0, "door should not activate without key");
     
     // Test with key
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    comic_x = 10;
-    comic_y = 8;
-    key_state_open = 1;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.key_state_open = 1;
+    result = check_door_activation(test_game);
     check(result == 1, "door should activate with key");
 }
 
@@ -364,28 +442,28 @@ void test_door_open_key_requirement() {
     reset_physics_state();
     reset_door_state();
     level_t* level = create_test_level_with_door(10, 8, 1, 1);
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    comic_x = 10;
-    comic_y = 8;
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
     
     // Test without open key pressed
-    key_state_open = 0;
-    uint8_t result = check_door_activation();
+    test_game.key_state_open = 0;
+    uint8_t result = check_door_activation(test_game);
     check(result == 0, "check_door_activation should return 0 when open key not pressed");
     
     // Test with open key pressed
     reset_door_state();
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    comic_x = 10;
-    comic_y = 8;
-    key_state_open = 1;
-    result = check_door_activation();
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.key_state_open = 1;
+    result = check_door_activation(test_game);
     check(result == 1, "check_door_activation should return 1 when open key pressed");
 }
 
@@ -393,31 +471,31 @@ void test_door_state_update_same_level() {
     reset_physics_state();
     reset_door_state();
     level_t* level = create_test_level_with_door(10, 8, 1, 1);  // Target same level, stage 1
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    comic_x = 10;
-    comic_y = 8;
-    key_state_open = 1;
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.key_state_open = 1;
     
     // Before activation
-    check(source_door_level_number == -1, "source_door_level_number should start as -1");
-    check(source_door_stage_number == -1, "source_door_stage_number should start as -1");
-    check(current_stage_number == 0, "current_stage_number should start as 0");
+    check(test_game.source_door_level_number == -1, "source_door_level_number should start as -1");
+    check(test_game.source_door_stage_number == -1, "source_door_stage_number should start as -1");
+    check(test_game.current_stage_number == 0, "current_stage_number should start as 0");
     
     // Activate door (will call load_new_stage due to same level)
-    uint8_t result = check_door_activation();
+    uint8_t result = check_door_activation(test_game);
     check(result == 1, "door activation to same level stage should succeed");
     
     // After activation, verify state was set
-    check(source_door_level_number == 1, 
+    check(test_game.source_door_level_number == 1, 
           "source_door_level_number should be 1 (origin level)");
-    check(source_door_stage_number == 0, 
+    check(test_game.source_door_stage_number == 0, 
           "source_door_stage_number should be 0 (origin stage)");
-    check(current_stage_number == 1, 
+    check(test_game.current_stage_number == 1, 
           "current_stage_number should be 1 (target stage)");
-    check(current_level_number == 1, 
+    check(test_game.current_level_number == 1, 
           "current_level_number should remain 1 (same level)");
 }
 
@@ -425,31 +503,31 @@ void test_door_state_update_different_level() {
     reset_physics_state();
     reset_door_state();
     level_t* level = create_test_level_with_door(10, 8, 2, 1);  // Target different level
-    current_level_ptr = level;
-    current_level_number = 1;
-    current_stage_number = 0;
-    comic_has_door_key = 1;
-    comic_x = 10;
-    comic_y = 8;
-    key_state_open = 1;
+    test_game.current_level_ptr = level;
+    test_game.current_level_number = 1;
+    test_game.current_stage_number = 0;
+    test_game.comic_has_door_key = 1;
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.key_state_open = 1;
     
     // Before activation
-    check(source_door_level_number == -1, "source_door_level_number should start as -1");
-    check(source_door_stage_number == -1, "source_door_stage_number should start as -1");
-    check(current_level_number == 1, "current_level_number should start as 1");
+    check(test_game.source_door_level_number == -1, "source_door_level_number should start as -1");
+    check(test_game.source_door_stage_number == -1, "source_door_stage_number should start as -1");
+    check(test_game.current_level_number == 1, "current_level_number should start as 1");
     
     // Activate door (will call load_new_level due to different level)
-    uint8_t result = check_door_activation();
+    uint8_t result = check_door_activation(test_game);
     check(result == 1, "door activation to different level should succeed");
     
     // After activation, verify state was set
-    check(source_door_level_number == 1, 
+    check(test_game.source_door_level_number == 1, 
           "source_door_level_number should be 1 (origin level)");
-    check(source_door_stage_number == 0, 
+    check(test_game.source_door_stage_number == 0, 
           "source_door_stage_number should be 0 (origin stage)");
-    check(current_level_number == 2, 
+    check(test_game.current_level_number == 2, 
           "current_level_number should be 2 (target level)");
-    check(current_stage_number == 1, 
+    check(test_game.current_stage_number == 1, 
           "current_stage_number should be 1 (target stage)");
 }
 
@@ -465,7 +543,7 @@ static void check_door_render_state(
     bool draw_overlay_in_front = false;
     bool player_visible = false;
 
-    bool has_render_state = get_door_animation_render_state(
+    bool has_render_state = get_door_animation_render_state(test_game, 
       &world_x,
       &world_y,
       &mode,
@@ -485,12 +563,12 @@ void test_door_animation_phase_progression_and_render_state() {
     reset_door_state();
     initialize_level_data();
 
-    current_level_number = LEVEL_NUMBER_FOREST;
-    current_stage_number = 0;
-    current_level_ptr = get_level_by_number(current_level_number);
-    comic_x = 10;
-    comic_y = 8;
-    g_skip_load_on_door = false;
+    test_game.current_level_number = LEVEL_NUMBER_FOREST;
+    test_game.current_stage_number = 0;
+    test_game.current_level_ptr = get_level_by_number(test_game.current_level_number);
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.skip_load_on_door = false;
 
     door_t door{};
     door.x = 10;
@@ -498,11 +576,11 @@ void test_door_animation_phase_progression_and_render_state() {
     door.target_level = LEVEL_NUMBER_LAKE;
     door.target_stage = 1;
 
-    activate_door(&door);
+    activate_door(test_game, &door);
 
-    check(g_door_anim_phase == DoorAnimationPhase::ENTERING,
+    check(test_game.door_anim_phase == DoorAnimationPhase::ENTERING,
         "door_anim_progression: phase should start in ENTERING");
-    check(g_door_anim_frame == 0,
+    check(test_game.door_anim_frame == 0,
         "door_anim_progression: frame should start at 0");
     check_door_render_state(
       DoorAnimationRenderMode::HALF_OPEN,
@@ -510,10 +588,10 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression entering frame 0");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::ENTERING,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::ENTERING,
         "door_anim_progression: phase should remain ENTERING at frame 1");
-    check(g_door_anim_frame == 1,
+    check(test_game.door_anim_frame == 1,
         "door_anim_progression: frame should advance to 1");
     check_door_render_state(
       DoorAnimationRenderMode::FULL_OPEN,
@@ -521,10 +599,10 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression entering frame 1");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::ENTERING,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::ENTERING,
         "door_anim_progression: phase should remain ENTERING at frame 2");
-    check(g_door_anim_frame == 2,
+    check(test_game.door_anim_frame == 2,
         "door_anim_progression: frame should advance to 2");
     check_door_render_state(
       DoorAnimationRenderMode::HALF_CLOSED,
@@ -532,10 +610,10 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression entering frame 2");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::ENTERING,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::ENTERING,
         "door_anim_progression: phase should remain ENTERING at frame 3");
-    check(g_door_anim_frame == 3,
+    check(test_game.door_anim_frame == 3,
         "door_anim_progression: frame should advance to 3");
     check_door_render_state(
       DoorAnimationRenderMode::NONE,
@@ -543,10 +621,10 @@ void test_door_animation_phase_progression_and_render_state() {
       false,
       "door_anim_progression entering frame 3");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
         "door_anim_progression: phase should transition to EXIT_DELAY");
-    check(g_door_anim_frame == 0,
+    check(test_game.door_anim_frame == 0,
         "door_anim_progression: frame should reset to 0 at EXIT_DELAY");
     check_door_render_state(
       DoorAnimationRenderMode::NONE,
@@ -554,18 +632,18 @@ void test_door_animation_phase_progression_and_render_state() {
       false,
       "door_anim_progression exit delay");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
         "door_anim_progression: phase should remain EXIT_DELAY tick 1");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
         "door_anim_progression: phase should remain EXIT_DELAY tick 2");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::EXITING,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::EXITING,
         "door_anim_progression: phase should transition to EXITING");
-    check(g_door_anim_frame == 0,
+    check(test_game.door_anim_frame == 0,
         "door_anim_progression: EXITING should start at frame 0");
     check_door_render_state(
       DoorAnimationRenderMode::NONE,
@@ -573,8 +651,8 @@ void test_door_animation_phase_progression_and_render_state() {
       false,
       "door_anim_progression exiting frame 0");
 
-    update_door_animation_tick();
-    check(g_door_anim_frame == 1,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_frame == 1,
         "door_anim_progression: EXITING frame should advance to 1");
     check_door_render_state(
       DoorAnimationRenderMode::HALF_OPEN,
@@ -582,8 +660,8 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression exiting frame 1");
 
-    update_door_animation_tick();
-    check(g_door_anim_frame == 2,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_frame == 2,
         "door_anim_progression: EXITING frame should advance to 2");
     check_door_render_state(
       DoorAnimationRenderMode::FULL_OPEN,
@@ -591,8 +669,8 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression exiting frame 2");
 
-    update_door_animation_tick();
-    check(g_door_anim_frame == 3,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_frame == 3,
         "door_anim_progression: EXITING frame should advance to 3");
     check_door_render_state(
       DoorAnimationRenderMode::HALF_CLOSED,
@@ -600,8 +678,8 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression exiting frame 3");
 
-    update_door_animation_tick();
-    check(g_door_anim_frame == 4,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_frame == 4,
         "door_anim_progression: EXITING frame should advance to 4");
     check_door_render_state(
       DoorAnimationRenderMode::NONE,
@@ -609,10 +687,10 @@ void test_door_animation_phase_progression_and_render_state() {
       true,
       "door_anim_progression exiting frame 4");
 
-    update_door_animation_tick();
-    check(g_door_anim_phase == DoorAnimationPhase::NONE,
+    update_door_animation_tick(test_game);
+    check(test_game.door_anim_phase == DoorAnimationPhase::NONE,
         "door_anim_progression: phase should end at NONE");
-    check(g_door_anim_frame == 0,
+    check(test_game.door_anim_frame == 0,
         "door_anim_progression: frame should reset to 0 when complete");
 
     uint8_t world_x = 0;
@@ -620,7 +698,7 @@ void test_door_animation_phase_progression_and_render_state() {
     DoorAnimationRenderMode mode = DoorAnimationRenderMode::NONE;
     bool draw_overlay_in_front = false;
     bool player_visible = false;
-    check(!get_door_animation_render_state(
+    check(!get_door_animation_render_state(test_game, 
           &world_x,
           &world_y,
           &mode,
@@ -628,7 +706,7 @@ void test_door_animation_phase_progression_and_render_state() {
           &player_visible),
         "door_anim_progression: render state should be inactive after completion");
 
-    g_skip_load_on_door = true;
+    test_game.skip_load_on_door = true;
 }
 
 void test_door_destination_load_deferred_until_entering_complete() {
@@ -636,12 +714,12 @@ void test_door_destination_load_deferred_until_entering_complete() {
     reset_door_state();
     initialize_level_data();
 
-    current_level_number = LEVEL_NUMBER_FOREST;
-    current_stage_number = 0;
-    current_level_ptr = get_level_by_number(current_level_number);
-    comic_x = 10;
-    comic_y = 8;
-    g_skip_load_on_door = false;
+    test_game.current_level_number = LEVEL_NUMBER_FOREST;
+    test_game.current_stage_number = 0;
+    test_game.current_level_ptr = get_level_by_number(test_game.current_level_number);
+    test_game.comic_x = 10;
+    test_game.comic_y = 8;
+    test_game.skip_load_on_door = false;
 
     door_t door{};
     door.x = 10;
@@ -649,131 +727,162 @@ void test_door_destination_load_deferred_until_entering_complete() {
     door.target_level = LEVEL_NUMBER_LAKE;
     door.target_stage = 1;
 
-    activate_door(&door);
+    activate_door(test_game, &door);
 
-    check(current_level_number == LEVEL_NUMBER_FOREST,
+    check(test_game.current_level_number == LEVEL_NUMBER_FOREST,
         "door_deferred_load: target level should not load immediately");
-    check(current_stage_number == 0,
+    check(test_game.current_stage_number == 0,
         "door_deferred_load: target stage should not load immediately");
 
-    update_door_animation_tick();
-    check(current_level_number == LEVEL_NUMBER_FOREST,
+    update_door_animation_tick(test_game);
+    check(test_game.current_level_number == LEVEL_NUMBER_FOREST,
         "door_deferred_load: level should remain source during entering frame 1");
-    check(current_stage_number == 0,
+    check(test_game.current_stage_number == 0,
         "door_deferred_load: stage should remain source during entering frame 1");
 
-    update_door_animation_tick();
-    check(current_level_number == LEVEL_NUMBER_FOREST,
+    update_door_animation_tick(test_game);
+    check(test_game.current_level_number == LEVEL_NUMBER_FOREST,
         "door_deferred_load: level should remain source during entering frame 2");
-    check(current_stage_number == 0,
+    check(test_game.current_stage_number == 0,
         "door_deferred_load: stage should remain source during entering frame 2");
 
-    update_door_animation_tick();
-    check(current_level_number == LEVEL_NUMBER_FOREST,
+    update_door_animation_tick(test_game);
+    check(test_game.current_level_number == LEVEL_NUMBER_FOREST,
         "door_deferred_load: level should remain source during entering frame 3");
-    check(current_stage_number == 0,
+    check(test_game.current_stage_number == 0,
         "door_deferred_load: stage should remain source during entering frame 3");
 
-    update_door_animation_tick();
-    check(current_level_number == LEVEL_NUMBER_LAKE,
+    update_door_animation_tick(test_game);
+    check(test_game.current_level_number == LEVEL_NUMBER_LAKE,
         "door_deferred_load: target level should load after entering completes");
-    check(current_stage_number == 1,
+    check(test_game.current_stage_number == 1,
         "door_deferred_load: target stage should load after entering completes");
-    check(g_door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
+    check(test_game.door_anim_phase == DoorAnimationPhase::EXIT_DELAY,
         "door_deferred_load: phase should move to EXIT_DELAY after deferred load");
 
-    g_skip_load_on_door = true;
+    test_game.skip_load_on_door = true;
 }
 
 void test_door_entry_sets_checkpoint_for_respawn() {
     reset_physics_state();
     initialize_level_data();
 
-    current_level_number = LEVEL_NUMBER_LAKE;
-    current_stage_number = 0;
-    source_door_level_number = LEVEL_NUMBER_FOREST;
-    source_door_stage_number = 2;
+    test_game.current_level_number = LEVEL_NUMBER_LAKE;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = LEVEL_NUMBER_FOREST;
+    test_game.source_door_stage_number = 2;
 
-    comic_x_checkpoint = 14;
-    comic_y_checkpoint = 12;
+    test_game.comic_x_checkpoint = 14;
+    test_game.comic_y_checkpoint = 12;
 
-    load_new_level();
+    load_new_level(test_game);
 
-    check(comic_x == 119 && comic_y == 10,
+    check(test_game.comic_x == 119 && test_game.comic_y == 10,
         "door_entry_checkpoint: player should spawn at reciprocal door position");
 
-    check(comic_x_checkpoint == 119 && comic_y_checkpoint == 10,
+    check(test_game.comic_x_checkpoint == 119 && test_game.comic_y_checkpoint == 10,
         "door_entry_checkpoint: checkpoint should update to reciprocal door spawn");
 
-    check(source_door_level_number == -1 && source_door_stage_number == -1,
+    check(test_game.source_door_level_number == -1 && test_game.source_door_stage_number == -1,
         "door_entry_checkpoint: source door markers should reset after stage load");
 }
 
+void test_stage_prefetch_covers_exits_and_doors() {
+    reset_physics_state();
+    initialize_level_data();
+
+    test_game.current_level_number = LEVEL_NUMBER_FOREST;
+    test_game.current_stage_number = 0;
+    const stage_t& stage = get_level_data("forest")->stages[0];
+
+    uint32_t expected = 0;
+    if (stage.exit_l != EXIT_UNUSED) expected++;
+    if (stage.exit_r != EXIT_UNUSED) expected++;
+    for (int i = 0; i < MAX_NUM_DOORS; i++) {
+        if (stage.doors[i].x != DOOR_UNUSED && stage.doors[i].y != DOOR_UNUSED) {
+            expected++;
+        }
+    }
+
+    reset_prefetch_stats();
+    prefetch_stage_neighbours(test_game);
+    prefetch_door_destination(test_game, LEVEL_NUMBER_LAKE, 1);
+
+    const PrefetchStats stats = get_prefetch_stats();
+    check(expected > 0, "stage_prefetch: forest stage 0 should have neighbours");
+    check(stats.stages_requested == expected,
+        "stage_prefetch: every exit and used door should be queued");
+    check(stats.escalations == 1,
+        "stage_prefetch: door activation should count one escalation");
+
+    reset_prefetch_stats();
+}
+
 void test_stage_left_exit_blocked() {
     reset_physics_state();
-    comic_x = 10;
-    comic_y = 12;
-    comic_x_momentum = 0;
-    move_left();
-    check(comic_x == 9, "Comic should move left normally when not at edge");
+    test_game.comic_x = 10;
+    test_game.comic_y = 12;
+    test_game.comic_x_momentum = 0;
+    move_left(test_game);
+    check(test_game.comic_x == 9, "Comic should move left normally when not at edge");
 }
 
 void test_stage_right_exit_blocked() {
     reset_physics_state();
-    comic_x = MAP_WIDTH - 10;
-    comic_y = 12;
-    comic_x_momentum = 0;
-    move_right();
-    check(comic_x == MAP_WIDTH - 9, "Comic should move right normally when not at edge");
+    test_game.comic_x = MAP_WIDTH - 10;
+    test_game.comic_y = 12;
+    test_game.comic_x_momentum = 0;
+    move_right(test_game);
+    check(test_game.comic_x == MAP_WIDTH - 9, "Comic should move right normally when not at edge");
 }
 
 void test_stage_left_edge_detection() {
     reset_physics_state();
-    comic_x = 0;
-    comic_y = 12;
-    comic_x_momentum = -1;
-    current_level_ptr = nullptr;
-    uint8_t initial_stage = current_stage_number;
-    move_left();
-    check(current_stage_number == initial_stage, 
+    test_game.comic_x = 0;
+    test_game.comic_y = 12;
+    test_game.comic_x_momentum = -1;
+    test_game.current_level_ptr = nullptr;
+    uint8_t initial_stage = test_game.current_stage_number;
+    move_left(test_game);
+    check(test_game.current_stage_number == initial_stage, 
           "stage should not change when current_level_ptr is null");
-    check(comic_x_momentum == 0, "momentum should be cleared when blocked at edge");
+    check(test_game.comic_x_momentum == 0, "momentum should be cleared when blocked at edge");
 }
 
 void test_stage_right_edge_detection() {
     reset_physics_state();
-    comic_x = MAP_WIDTH - 2;
-    comic_y = 12;
-    comic_x_momentum = 1;
-    current_level_ptr = nullptr;
-    uint8_t initial_stage = current_stage_number;
-    move_right();
-    check(current_stage_number == initial_stage, 
+    test_game.comic_x = MAP_WIDTH - 2;
+    test_game.comic_y = 12;
+    test_game.comic_x_momentum = 1;
+    test_game.current_level_ptr = nullptr;
+    uint8_t initial_stage = test_game.current_stage_number;
+    move_right(test_game);
+    check(test_game.current_stage_number == initial_stage, 
           "stage should not change when current_level_ptr is null");
-    check(comic_x_momentum == 0, "momentum should be cleared when blocked at edge");
+    check(test_game.comic_x_momentum == 0, "momentum should be cleared when blocked at edge");
 }
 
 void test_cave_level_solidity() {
     reset_physics_state();
     initialize_level_data();
-    current_level_number = LEVEL_NUMBER_CAVE;
-    current_stage_number = 0;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    current_level_ptr = nullptr;
-
-    load_new_level();
-    check(current_level_ptr != nullptr, "current_level_ptr should be set after load_new_level");
-    check(current_level_ptr->tileset_last_passable == 0x09, 
+    test_game.current_level_number = LEVEL_NUMBER_CAVE;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.current_level_ptr = nullptr;
+
+    load_new_level(test_game);
+    check(test_game.current_level_ptr != nullptr, "current_level_ptr should be set after load_new_level");
+    check(test_game.current_level_ptr->tileset_last_passable == 0x09, 
           "cave level tileset_last_passable should be 0x09");
     
-    check(is_tile_solid(0x0a), "cave tile 0x0a should be solid");
-    check(is_tile_solid(0x14), "cave tile 0x14 should be solid");
-    check(!is_tile_solid(0x09), "cave tile 0x09 should be passable");
-    check(!is_tile_solid(0x00), "cave tile 0x00 should be passable");
+    check(is_tile_solid(test_game, 0x0a), "cave tile 0x0a should be solid");
+    check(is_tile_solid(test_game, 0x14), "cave tile 0x14 should be solid");
+    check(!is_tile_solid(test_game, 0x09), "cave tile 0x09 should be passable");
+    check(!is_tile_solid(test_game, 0x00), "cave tile 0x00 should be passable");
     
     reset_door_state();
-    reset_level_tiles();
+    reset_level_tiles(test_game);
 }
 
 void test_problematic_levels_have_solid_tiles() {
@@ -784,55 +893,149 @@ void test_problematic_levels_have_solid_tiles() {
     check(shed != nullptr, "shed level should exist");
     check(shed->tileset_last_passable == 0x17, "shed level tileset_last_passable should be 0x17");
     
-    current_level_number = LEVEL_NUMBER_SHED;
-    current_stage_number = 0;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    current_level_ptr = nullptr;
-    load_new_level();
-    check(is_tile_solid(0x18), "shed tile 0x18 should be solid (> 0x17)");
-    check(!is_tile_solid(0x17), "shed tile 0x17 should be passable (<= 0x17)");
-    reset_level_tiles();
+    test_game.current_level_number = LEVEL_NUMBER_SHED;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.current_level_ptr = nullptr;
+    load_new_level(test_game);
+    check(is_tile_solid(test_game, 0x18), "shed tile 0x18 should be solid (> 0x17)");
+    check(!is_tile_solid(test_game, 0x17), "shed tile 0x17 should be passable (<= 0x17)");
+    reset_level_tiles(test_game);
     
     const level_t* base = get_level_by_number(LEVEL_NUMBER_BASE);
     check(base != nullptr, "base level should exist");
     check(base->tileset_last_passable == 0x3b, "base level tileset_last_passable should be 0x3b");
     
-    current_level_number = LEVEL_NUMBER_BASE;
-    current_stage_number = 0;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    current_level_ptr = nullptr;
-    load_new_level();
-    check(is_tile_solid(0x3c), "base tile 0x3c should be solid (> 0x3b)");
-    check(!is_tile_solid(0x3b), "base tile 0x3b should be passable (<= 0x3b)");
-    reset_level_tiles();
+    test_game.current_level_number = LEVEL_NUMBER_BASE;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.current_level_ptr = nullptr;
+    load_new_level(test_game);
+    check(is_tile_solid(test_game, 0x3c), "base tile 0x3c should be solid (> 0x3b)");
+    check(!is_tile_solid(test_game, 0x3b), "base tile 0x3b should be passable (<= 0x3b)");
+    reset_level_tiles(test_game);
     
     const level_t* comp = get_level_by_number(LEVEL_NUMBER_COMP);
     check(comp != nullptr, "comp level should exist");
     check(comp->tileset_last_passable == 0x1d, "comp level tileset_last_passable should be 0x1d");
     
-    current_level_number = LEVEL_NUMBER_COMP;
-    current_stage_number = 0;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    current_level_ptr = nullptr;
-    load_new_level();
-    check(is_tile_solid(0x1e), "comp tile 0x1e should be solid (> 0x1d)");
-    check(!is_tile_solid(0x1d), "comp tile 0x1d should be passable (<= 0x1d)");
-    reset_level_tiles();
+    test_game.current_level_number = LEVEL_NUMBER_COMP;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.current_level_ptr = nullptr;
+    load_new_level(test_game);
+    check(is_tile_solid(test_game, 0x1e), "comp tile 0x1e should be solid (> 0x1d)");
+    check(!is_tile_solid(test_game, 0x1d), "comp tile 0x1d should be passable (<= 0x1d)");
+    reset_level_tiles(test_game);
     
     const level_t* cave = get_level_by_number(LEVEL_NUMBER_CAVE);
     check(cave != nullptr, "cave level should exist");
     check(cave->tileset_last_passable == 0x09, "cave level tileset_last_passable should be 0x09");
     
-    current_level_number = LEVEL_NUMBER_CAVE;
-    current_stage_number = 0;
-    source_door_level_number = -1;
-    source_door_stage_number = -1;
-    current_level_ptr = nullptr;
-    load_new_level();
-    check(is_tile_solid(0x0a), "cave tile 0x0a should be solid (> 0x09)");
-    check(!is_tile_solid(0x09), "cave tile 0x09 should be passable (<= 0x09)");
-    reset_level_tiles();
+    test_game.current_level_number = LEVEL_NUMBER_CAVE;
+    test_game.current_stage_number = 0;
+    test_game.source_door_level_number = -1;
+    test_game.source_door_stage_number = -1;
+    test_game.current_level_ptr = nullptr;
+    load_new_level(test_game);
+    check(is_tile_solid(test_game, 0x0a), "cave tile 0x0a should be solid (> 0x09)");
+    check(!is_tile_solid(test_game, 0x09), "cave tile 0x09 should be passable (<= 0x09)");
+    reset_level_tiles(test_game);
+}
+
+void test_streamed_stage_map_window_follows_comic() {
+    initialize_level_data();
+    const level_t& forest = level_data_forest;
+    const SolidityTable solidity = build_solidity_table(forest.tileset_last_passable, &forest);
+    uint8_t floor_tile = static_cast<uint8_t>(forest.tileset_last_passable + 1);
+    while (!solidity.is_solid(floor_tile)) {
+        floor_tile++;
+    }
+
+    // Ten chunks: a floor all the way, and a passable marker per column in row 0
+    constexpr MapCoord width = 10 * TILE_MAP_CHUNK_WIDTH;
+    auto marker = [&forest](MapCoord tile_x) { return static_cast<uint8_t>(tile_x % (forest.tileset_last_passable + 1)); };
+    std::vector<uint8_t> tiles(static_cast<size_t>(width) * MAP_HEIGHT_TILES, 0);
+    for (MapCoord x = 0; x < width; x++) {
+        tiles[x] = marker(x);
+        tiles[9 * width + x] = floor_tile;
+    }
+    const std::string path = "test_streamed_stage.cctm";
+    check(!write_tile_map(path, tiles.data(), width + 1), "tile_map: a width of part of a chunk should be refused");
+    check(write_tile_map(path, tiles.data(), width), "tile_map: the map should be written");
+
+    TileMap map;
+    check(map.open(path) && map.get_width_tiles() == width && map.get_chunk_count() == 10,
+          "tile_map: the header should read back");
+    uint8_t chunk[TILE_MAP_CHUNK_TILES];
+    check(map.read_chunk(7, chunk) && chunk[5] == marker(7 * TILE_MAP_CHUNK_WIDTH + 5) &&
+              chunk[9 * TILE_MAP_CHUNK_WIDTH + 31] == floor_tile,
+          "tile_map: a chunk should decode to its tiles");
+    check(!map.read_chunk(10, chunk) && chunk[0] == 0, "tile_map: a chunk past the end should read as empty");
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    std::fseek(file, 0, SEEK_END);
+    check(std::ftell(file) < width * MAP_HEIGHT_TILES / 2, "tile_map: chunks should be compressed");
+    std::fclose(file);
+    map.close();
+
+    // Forest stage 0 streams from the file; no enemies, so Comic only walks
+    check(attach_stage_tile_map(LEVEL_NUMBER_FOREST, 0, path), "tile_map: the stage map should attach");
+    static GameContext game;  // Static: a context is too large for some test thread stacks
+    game = GameContext();
+    game.actors.initialize();
+    reset_counters();
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    const enemy_record_t no_enemy = {0, ENEMY_BEHAVIOR_UNUSED};
+    for (int i = 0; i < MAX_NUM_ENEMIES; i++) {
+        game.actors.setup_enemy_slot(i, game.current_level_ptr, no_enemy, nullptr);
+    }
+    game.actors.reset_for_stage();
+    clear_gameplay_key_states(game);
+    check(game.tile_map != nullptr && game.map_origin_x == 0, "tile_map: the stage should start at the map's left");
+    check(get_map_tile(game, TILE_MAP_CHUNK_WIDTH * TILE_MAP_WINDOW_CHUNKS, 9) == 0,
+          "tile_map: columns past the window should not be resident");
+
+    GameSnapshot midway;
+    bool captured = false;
+    bool tiles_match = true;
+    bool steady = true;
+    MapCoord furthest_origin = 0;
+    int map_x = game.comic_x;
+    for (int tick = 0; tick < 2000 && game.tile_map != nullptr; tick++) {
+        apply_input_keys(game, INPUT_RIGHT);
+        run_gameplay_tick(game);
+        if (game.tile_map == nullptr) {
+            break;
+        }
+        const int next_map_x = game.map_origin_x * 2 + game.comic_x;
+        steady = steady && next_map_x >= map_x && next_map_x <= map_x + 1;
+        map_x = next_map_x;
+        tiles_match = tiles_match && get_tile_at(game, game.comic_x, 0) == marker(map_x / 2) &&
+                      get_tile_at(game, game.comic_x, 18) == floor_tile;
+        furthest_origin = std::max(furthest_origin, game.map_origin_x);
+        if (!captured && game.map_origin_x >= 3 * TILE_MAP_CHUNK_WIDTH) {
+            capture_snapshot(game, midway);
+            captured = true;
+        }
+    }
+    check(steady, "tile_map: Comic should keep his place on the map as the window moves");
+    check(tiles_match, "tile_map: tiles should read from the map at Comic's map position");
+    check(furthest_origin == width - MAP_WIDTH_TILES, "tile_map: the window should reach the map's right end");
+    check(get_counter(Counter::MAP_CHUNKS_READ) == 10, "tile_map: each chunk should be read once on the way");
+    check(game.tile_map == nullptr && game.current_stage_number == 1 && game.map_origin_x == 0,
+          "tile_map: the right exit should lead to the next compiled-in stage");
+
+    restore_snapshot(game, midway);
+    check(captured && game.tile_map != nullptr && game.map_origin_x == midway.map_origin_x &&
+              get_tile_at(game, game.comic_x, 0) == marker(game.map_origin_x + game.comic_x / 2),
+          "tile_map: a snapshot should restore the window it was taken in");
+
+    detach_stage_tile_maps();
+    game = GameContext();
+    std::remove(path.c_str());
+    reset_counters();
 }
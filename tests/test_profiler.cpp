@@ -0,0 +1,90 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/profiler.h"
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include <fstream>
+
+#if defined(COMIC_FRAME_PROFILER)
+
+// A frame with a marker for the tick loop and, inside it, the actor update
+static void run_profiled_frame(uint32_t ticks) {
+    profiler_begin_frame();
+    {
+        PROFILE_SCOPE(ProfilePhase::TICKS);
+        {
+            PROFILE_SCOPE(ProfilePhase::ACTORS);
+            SDL_Delay(1);
+        }
+        profiler_add_ticks(ticks);
+    }
+    PROFILE_BEGIN(ProfilePhase::PRESENT);
+    PROFILE_END();
+}
+
+void test_profiler_records_exclusive_phase_times() {
+    enable_frame_profiler(true);
+    for (uint32_t frame = 0; frame < 4; ++frame) {
+        run_profiled_frame(frame);
+    }
+    profiler_begin_frame();  // Publishes the fourth frame
+    enable_frame_profiler(false);
+
+    ProfileFrame frames[PROFILE_RING_FRAMES];
+    const size_t count = copy_recent_profile_frames(frames, 4);
+    check(count == 4, "profiler: the four finished frames should be in the ring");
+    for (size_t i = 1; i < count; ++i) {
+        check(frames[i].frame_number == frames[i - 1].frame_number + 1, "profiler: frames should be oldest first");
+    }
+    const ProfileFrame& last = frames[count - 1];
+    check(last.ticks == 3, "profiler: the frame should count the ticks it ran");
+    check(last.phase_ms[static_cast<size_t>(ProfilePhase::ACTORS)] >= 0.5f,
+          "profiler: the nested marker should get the time spent inside it");
+    check(last.phase_ms[static_cast<size_t>(ProfilePhase::TICKS)] <
+              last.phase_ms[static_cast<size_t>(ProfilePhase::ACTORS)],
+          "profiler: the outer marker should not be charged for the inner one");
+    float sum = 0.0f;
+    for (float ms : last.phase_ms) {
+        sum += ms;
+    }
+    check(sum == last.total_ms(), "profiler: phase times should add up to the frame time");
+
+    // Disabled, markers record nothing
+    const size_t before = copy_recent_profile_frames(frames, PROFILE_RING_FRAMES);
+    run_profiled_frame(1);
+    check(copy_recent_profile_frames(frames, PROFILE_RING_FRAMES) == before,
+          "profiler: a disabled profiler should publish no frames");
+}
+
+void test_profiler_perf_log_writes_csv() {
+    const std::string path = "test_perf_log.csv";
+    check(start_perf_log(path), "profiler: perf log should open");
+    for (uint32_t frame = 0; frame < 10; ++frame) {
+        run_profiled_frame(1);
+    }
+    profiler_begin_frame();
+    stop_perf_log();
+    enable_frame_profiler(false);
+
+    std::ifstream csv(path);
+    std::string header;
+    std::getline(csv, header);
+    check(header.rfind("frame,total_ms,ticks,other_ms,events_ms,ticks_ms,actors_ms", 0) == 0,
+          "profiler: perf log should start with the column header");
+    int rows = 0;
+    for (std::string line; std::getline(csv, line);) {
+        rows += line.empty() ? 0 : 1;
+    }
+    check(rows == 10, "profiler: perf log should have a row per finished frame");
+    csv.close();
+    std::remove(path.c_str());
+}
+
+#else
+
+void test_profiler_records_exclusive_phase_times() {}
+void test_profiler_perf_log_writes_csv() {
+    check(!start_perf_log("test_perf_log.csv"), "profiler: perf log should refuse when compiled out");
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+
+static ReplayRecording make_sample_recording() {
+    ReplayRecording recording;
+    recording.debug_mode = true;
+    recording.start_level = 3;
+    recording.start_stage = 1;
+    // Hold right for a while, jump, release, then a cleared-state tick
+    for (int tick = 0; tick < 600; ++tick) {
+        uint8_t keys = 0;
+        if (tick >= 10) {
+            keys |= INPUT_RIGHT;
+        }
+        if (tick >= 200 && tick < 205) {
+            keys |= INPUT_JUMP;
+        }
+        if (tick == 400) {
+            keys = INPUT_KEYS_CLEARED;
+        }
+        if (tick > 400) {
+            keys = INPUT_LEFT | INPUT_FIRE;
+        }
+        recording.record_tick(keys);
+        if (ReplayRecording::is_checksum_tick(tick)) {
+            recording.record_checksum(0x1234567890ABCDEFull + tick);
+        }
+    }
+    recording.final_checksum = 0xFEDCBA0987654321ull;
+    return recording;
+}
+
+void test_replay_round_trip() {
+    const ReplayRecording recording = make_sample_recording();
+    const std::vector<uint8_t> bytes = recording.encode();
+
+    // Six key changes over 600 ticks should not cost a byte per tick
+    check(bytes.size() < 80, "replay: held keys should be run-length encoded");
+
+    ReplayRecording decoded;
+    check(decoded.decode(bytes.data(), bytes.size()), "replay: encoded recording should decode");
+    check(decoded.debug_mode && decoded.start_level == 3 && decoded.start_stage == 1,
+          "replay: start conditions should round-trip");
+    check(decoded.keys == recording.keys, "replay: per-tick keys should round-trip");
+    check(decoded.checksums == recording.checksums, "replay: checksums should round-trip");
+    check(decoded.final_checksum == recording.final_checksum, "replay: final checksum should round-trip");
+
+    uint64_t checksum = 0;
+    check(decoded.checksum_after(255, &checksum) && checksum == 0x1234567890ABCDEFull + 255,
+          "replay: checksum after tick 255 should be the first recorded checksum");
+    check(!decoded.checksum_after(256, &checksum), "replay: tick 256 is not a checksum tick");
+    check(!decoded.checksum_after(767, &checksum), "replay: no checksum past the recording");
+
+    ReplayRecording empty;
+    const std::vector<uint8_t> empty_bytes = empty.encode();
+    ReplayRecording decoded_empty = make_sample_recording();
+    check(decoded_empty.decode(empty_bytes.data(), empty_bytes.size()) && decoded_empty.tick_count() == 0 &&
+          decoded_empty.checksums.empty() && !decoded_empty.debug_mode,
+          "replay: empty recording should decode and replace previous contents");
+}
+
+void test_replay_rejects_corrupt_data() {
+    const ReplayRecording recording = make_sample_recording();
+    const std::vector<uint8_t> bytes = recording.encode();
+
+    // Every truncation must be rejected without touching the target
+    bool all_rejected = true;
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        ReplayRecording decoded;
+        decoded.start_level = 7;
+        if (decoded.decode(bytes.data(), size) || decoded.start_level != 7) {
+            all_rejected = false;
+        }
+    }
+    check(all_rejected, "replay: truncated data should be rejected");
+
+    std::vector<uint8_t> bad_magic = bytes;
+    bad_magic[0] = 'X';
+    ReplayRecording decoded;
+    check(!decoded.decode(bad_magic.data(), bad_magic.size()), "replay: wrong magic should be rejected");
+
+    std::vector<uint8_t> bad_version = bytes;
+    bad_version[4] = 99;
+    check(!decoded.decode(bad_version.data(), bad_version.size()), "replay: unknown version should be rejected");
+
+    // An empty recording whose tick count claims 2^56 ticks: it must be
+    // rejected by its checksum count, not by failing to allocate the keys
+    const std::vector<uint8_t> empty_bytes = ReplayRecording().encode();
+    std::vector<uint8_t> huge_ticks(empty_bytes.begin(), empty_bytes.begin() + 8);
+    huge_ticks.insert(huge_ticks.end(), {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01});
+    huge_ticks.insert(huge_ticks.end(), empty_bytes.begin() + 9, empty_bytes.end());
+    decoded = make_sample_recording();
+    check(!decoded.decode(huge_ticks.data(), huge_ticks.size()) && decoded.tick_count() == 600,
+          "replay: a tick count the checksums do not cover should be rejected");
+
+    // One tick more than the checksums cover is as wrong as 2^56
+    ReplayRecording short_checksums = make_sample_recording();
+    short_checksums.checksums.pop_back();
+    const std::vector<uint8_t> short_bytes = short_checksums.encode();
+    check(!decoded.decode(short_bytes.data(), short_bytes.size()),
+          "replay: a recording missing a checksum should be rejected");
+}
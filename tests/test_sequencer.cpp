@@ -0,0 +1,100 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/sequencer.h"
+#include <string>
+
+void test_sequencer_waits_and_keys() {
+    Sequencer sequencer(100.0);
+    std::string log;
+    int drawn_scene = 0;
+
+    sequencer.run([&log]() { log += 'a'; });
+    sequencer.show([&drawn_scene]() { drawn_scene = 1; });
+    sequencer.wait_ticks(1);
+    sequencer.run([&log]() { log += 'b'; });
+    sequencer.wait_ticks(2);
+    sequencer.run([&log]() { log += 'c'; });
+    sequencer.show([&drawn_scene]() { drawn_scene = 2; });
+    sequencer.wait_for_key();
+    sequencer.run([&log]() { log += 'd'; });
+
+    check(sequencer.update(1000) && log == "a", "sequencer: steps up to the first wait should run at once");
+    sequencer.draw();
+    check(drawn_scene == 1, "sequencer: draw should show the latest scene");
+    check(sequencer.update(1099) && log == "a", "sequencer: a one-tick wait should last a whole tick");
+    check(sequencer.update(1130) && log == "ab", "sequencer: the step after a wait should run once it is over");
+    // Timed from the last deadline (1100), not from the frame at 1130
+    check(sequencer.update(1299) && log == "ab", "sequencer: waits should not end early");
+    sequencer.on_key_down();  // Before the key wait: does not count
+    check(sequencer.update(1300) && log == "abc", "sequencer: waits should follow on from the last deadline");
+    sequencer.draw();
+    check(drawn_scene == 2, "sequencer: a later scene should replace the earlier one");
+    check(sequencer.update(5000) && log == "abc", "sequencer: a key wait should ignore earlier presses and time");
+    sequencer.on_key_down();
+    check(!sequencer.update(5001) && log == "abcd", "sequencer: a fresh key should end the wait");
+    check(!sequencer.is_active(), "sequencer: a finished sequence should be inactive");
+    drawn_scene = 0;
+    sequencer.draw();
+    check(drawn_scene == 0, "sequencer: the scene should go with the last step");
+
+    // A stall longer than the next wait restarts timing instead of skipping steps
+    sequencer.wait_ticks(1);
+    sequencer.run([&log]() { log += 'e'; });
+    sequencer.wait_ticks(1);
+    sequencer.run([&log]() { log += 'f'; });
+    sequencer.update(0);
+    check(sequencer.update(400) && log == "abcde", "sequencer: a late frame should end one wait, not several");
+    check(!sequencer.update(500) && log == "abcdef", "sequencer: timing should restart from the late frame");
+
+    // Actions may queue more steps; clear drops the rest
+    sequencer.run([&sequencer, &log]() {
+        sequencer.run([&log]() { log += 'g'; });
+        sequencer.wait_ms(50.0);
+        sequencer.run([&log]() { log += 'h'; });
+    });
+    check(sequencer.update(600) && log == "abcdefg", "sequencer: steps queued by an action should run after it");
+    sequencer.clear();
+    check(!sequencer.is_active() && !sequencer.update(1000) && log == "abcdefg",
+          "sequencer: clear should drop the queued steps");
+
+    // A loop checks its condition each time round and runs ahead of later steps
+    int passes = 3;
+    sequencer.repeat_while([&passes]() { return passes > 0; }, [&sequencer, &log, &passes]() {
+        sequencer.run([&log, &passes]() {
+            log += 'r';
+            passes--;
+            if (log == "abcdefgrr") {
+                passes += 2;  // A pass may add more
+            }
+        });
+        sequencer.wait_ticks(1);
+    });
+    sequencer.run([&log]() { log += 'z'; });
+    uint32_t now = 2000;
+    while (sequencer.update(now)) {
+        now += 100;
+    }
+    check(log == "abcdefgrrrrrz", "sequencer: a loop should run until its condition fails, then go on");
+}
+
+void test_victory_tally_pays_awarded_lives() {
+    GameContext game;
+    game.score_bytes[0] = 0;
+    game.score_bytes[1] = 0;
+    game.score_bytes[2] = 0;
+    game.comic_num_lives = 2;
+    game.score_10000_counter = 4;  // The bonus's first 10,000 points award a life
+
+    Sequencer sequencer(100.0);
+    queue_victory_tally(sequencer, game);
+    uint32_t now = 0;
+    while (sequencer.update(now)) {
+        now += 100;
+    }
+
+    // 20,000 for the victory, then 10,000 for each of three lives
+    check(game.comic_num_lives == 0, "victory tally: every life should be counted off, the awarded one too");
+    check(game.score_bytes[0] == 0 && game.score_bytes[1] == 5 && game.score_bytes[2] == 0,
+          "victory tally: the awarded life should be paid 10,000 points");
+    check(game.score_10000_counter == 4, "victory tally: each 10,000 points should advance the life counter");
+}
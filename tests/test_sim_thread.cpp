@@ -0,0 +1,83 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/sim_thread.h"
+
+void test_sim_thread_queue_and_triple_buffer() {
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) {
+        check(queue.push(i), "sim_thread: the queue should take items up to its capacity");
+    }
+    check(!queue.push(4), "sim_thread: a full queue should refuse items");
+    int item = -1;
+    check(queue.pop(&item) && item == 0, "sim_thread: the queue should be first in, first out");
+    check(queue.push(4), "sim_thread: a popped slot should be reused");
+    for (int expected = 1; expected <= 4; ++expected) {
+        check(queue.pop(&item) && item == expected, "sim_thread: the queue should keep its order across the wrap");
+    }
+    check(!queue.pop(&item), "sim_thread: an empty queue should have nothing to pop");
+
+    TripleBuffer<int> buffer;
+    check(!buffer.consume(), "sim_thread: nothing to consume before a publish");
+    for (int value = 1; value <= 3; ++value) {
+        buffer.back_buffer() = value;
+        buffer.publish();
+    }
+    check(buffer.consume() && buffer.front_buffer() == 3, "sim_thread: the reader should get the newest state");
+    check(!buffer.consume() && buffer.front_buffer() == 3, "sim_thread: a consumed state should stay readable");
+    buffer.back_buffer() = 4;
+    buffer.publish();
+    check(buffer.consume() && buffer.front_buffer() == 4, "sim_thread: later publishes should still arrive");
+}
+
+void test_sim_thread_matches_sequential_ticks() {
+    constexpr uint64_t TICKS = 60;
+    GameContext start;
+    start.actors.initialize();
+    load_starting_level(start);
+    sync_stage_enemies(start);
+    clear_gameplay_key_states(start);
+
+    GameContext sequential = start;
+    sequential.key_state_right = 1;
+    for (uint64_t tick = 0; tick < TICKS; ++tick) {
+        run_gameplay_tick(sequential);
+    }
+
+    SimulationThread sim_thread;
+    check(sim_thread.send({SimInputType::KEY_DOWN, INPUT_RIGHT, SDLK_UNKNOWN}),
+          "sim_thread: inputs may be queued before the thread starts");
+    uint64_t ticks_run = 0;
+    sim_thread.start(start, 1.0, [&ticks_run](GameContext& game, TickOutcome* outcome) {
+        if (ticks_run == TICKS) {
+            return false;
+        }
+        ++ticks_run;
+        *outcome = run_gameplay_tick(game);
+        return true;
+    });
+    check(sim_thread.is_running(), "sim_thread: the thread should be running after start");
+
+    bool finished = false;
+    uint64_t last_tick = 0;
+    bool ticks_in_order = true;
+    for (int wait_ms = 0; wait_ms < 5000 && !finished; ++wait_ms) {
+        if (sim_thread.consume_state()) {
+            const SimRenderState& state = sim_thread.get_state();
+            ticks_in_order = ticks_in_order && state.tick >= last_tick;
+            last_tick = state.tick;
+            finished = state.finished;
+        } else {
+            SDL_Delay(1);
+        }
+    }
+    sim_thread.stop();
+    check(finished, "sim_thread: the simulation should publish its final state");
+    check(ticks_in_order, "sim_thread: published states should never go back in time");
+    const SimRenderState& state = sim_thread.get_state();
+    check(state.tick == TICKS, "sim_thread: every tick should run");
+    check(state.game.graphics == nullptr, "sim_thread: published games have no graphics system");
+    check(gameplay_checksum(state.game) == gameplay_checksum(sequential),
+          "sim_thread: the threaded game should match the same ticks run in order");
+    check(gameplay_checksum(*sim_thread.get_game()) == gameplay_checksum(sequential),
+          "sim_thread: the game is readable after stop");
+}
@@ -0,0 +1,216 @@
+#include "test_helpers.h"
+#include "test_cases.h"
+#include "../include/snapshot.h"
+#include <cstdio>
+
+// Run right and left across the stage, jumping and firing now and then
+static uint8_t snapshot_route_keys(uint64_t tick) {
+    uint8_t keys = (tick / 120) % 2 == 0 ? INPUT_RIGHT : INPUT_LEFT;
+    if (tick % 25 < 3) {
+        keys |= INPUT_JUMP;
+    }
+    if (tick % 7 == 0) {
+        keys |= INPUT_FIRE;
+    }
+    return keys;
+}
+
+static void start_snapshot_game(GameContext& game) {
+    game.actors.initialize();
+    load_starting_level(game);
+    sync_stage_enemies(game);
+    clear_gameplay_key_states(game);
+}
+
+static void run_snapshot_ticks(GameContext& game, uint64_t first_tick, uint64_t last_tick) {
+    for (uint64_t tick = first_tick; tick < last_tick; ++tick) {
+        apply_input_keys(game, snapshot_route_keys(tick));
+        run_gameplay_tick(game);
+    }
+}
+
+void test_snapshot_restore_reproduces_game() {
+    GameContext game;
+    start_snapshot_game(game);
+    run_snapshot_ticks(game, 0, 400);
+    GameSnapshot at_400;
+    capture_snapshot(game, at_400);
+    run_snapshot_ticks(game, 400, 1200);
+    const uint64_t expected = gameplay_checksum(game);
+
+    // Into a fresh game
+    GameContext restored;
+    start_snapshot_game(restored);
+    restore_snapshot(restored, at_400);
+    GameSnapshot recaptured;
+    capture_snapshot(restored, recaptured);
+    check(recaptured == at_400, "snapshot: capture after restore should give the same bytes");
+    run_snapshot_ticks(restored, 400, 1200);
+    check(gameplay_checksum(restored) == expected, "snapshot: restored game should play out the same");
+
+    // Into the game it came from, rewinding it
+    restore_snapshot(game, at_400);
+    run_snapshot_ticks(game, 400, 1200);
+    check(gameplay_checksum(game) == expected, "snapshot: rewound game should play out the same");
+
+    // Through a save state file
+    const std::vector<uint8_t> bytes = at_400.encode();
+    check(bytes.size() < sizeof(GameSnapshot) / 2, "snapshot: save state should be compressed");
+    GameSnapshot decoded;
+    check(decoded.decode(bytes.data(), bytes.size()) && decoded == at_400,
+          "snapshot: save state should decode to the same snapshot");
+    const std::string path = "test_snapshot.state";
+    check(at_400.save(path), "snapshot: save state should be written");
+    GameSnapshot loaded;
+    check(loaded.load(path) && loaded == at_400, "snapshot: save state should load back");
+    std::remove(path.c_str());
+}
+
+void test_snapshot_ring_rewind() {
+    // Small enough to wrap several times
+    SnapshotRing ring(500, 16 * 1024, 32);
+    GameContext game;
+    start_snapshot_game(game);
+    std::vector<GameSnapshot> history;
+    for (uint64_t tick = 0; tick < 3000; ++tick) {
+        apply_input_keys(game, snapshot_route_keys(tick));
+        run_gameplay_tick(game);
+        GameSnapshot snapshot;
+        capture_snapshot(game, snapshot);
+        history.push_back(snapshot);
+        ring.push(tick, snapshot);
+    }
+    check(ring.newest_tick() == 2999, "snapshot ring: newest tick should be the last pushed");
+    check(ring.size() <= 500 && ring.size() > 400, "snapshot ring: should hold close to its tick capacity");
+    check(ring.bytes_used() <= 16 * 1024, "snapshot ring: should stay within its byte budget");
+    check(!ring.contains(ring.oldest_tick() - 1), "snapshot ring: dropped ticks should be gone");
+
+    bool all_match = true;
+    GameSnapshot snapshot;
+    for (uint64_t tick = ring.oldest_tick(); tick <= ring.newest_tick(); ++tick) {
+        all_match = all_match && ring.get(tick, snapshot) && snapshot == history[tick];
+    }
+    check(all_match, "snapshot ring: every held tick should decode to its snapshot");
+
+    // Rewind 100 ticks and play on with different input
+    const uint64_t rewind_tick = ring.newest_tick() - 100;
+    check(ring.get(rewind_tick, snapshot), "snapshot ring: rewind target should be held");
+    restore_snapshot(game, snapshot);
+    ring.truncate_after(rewind_tick);
+    check(ring.newest_tick() == rewind_tick, "snapshot ring: truncate should drop the later ticks");
+    for (uint64_t tick = rewind_tick + 1; tick < rewind_tick + 50; ++tick) {
+        apply_input_keys(game, INPUT_JUMP);
+        run_gameplay_tick(game);
+        capture_snapshot(game, snapshot);
+        history[tick] = snapshot;
+        ring.push(tick, snapshot);
+    }
+    check(ring.get(rewind_tick + 49, snapshot) && snapshot == history[rewind_tick + 49],
+          "snapshot ring: ticks pushed after a rewind should decode");
+    check(ring.get(rewind_tick - 10, snapshot) && snapshot == history[rewind_tick - 10],
+          "snapshot ring: ticks before a rewind should be kept");
+}
+
+void test_snapshot_ring_hour_budget() {
+    // An hour of ~9.1 Hz ticks at the default capacity
+    constexpr uint64_t HOUR_TICKS = 32760;
+    SnapshotRing ring;
+    GameContext game;
+    start_snapshot_game(game);
+    GameSnapshot snapshot;
+    for (uint64_t tick = 0; tick < HOUR_TICKS; ++tick) {
+        if (run_gameplay_tick(game) != TickOutcome::Continue) {
+            start_snapshot_game(game);
+        }
+        apply_input_keys(game, snapshot_route_keys(tick));
+        capture_snapshot(game, snapshot);
+        ring.push(tick, snapshot);
+    }
+    check(ring.size() == HOUR_TICKS, "snapshot ring: an hour of ticks should fit");
+    check(ring.bytes_used() < SNAPSHOT_RING_DEFAULT_BYTES, "snapshot ring: an hour should take less than the budget");
+    GameSnapshot oldest;
+    check(ring.get(0, oldest) && oldest.current_level_number == LEVEL_NUMBER_FOREST,
+          "snapshot ring: the first tick of the hour should still decode");
+}
+
+void test_snapshot_ring_finds_divergence() {
+    SnapshotRing reference(4096);
+    SnapshotRing diverged(4096);
+    GameContext a;
+    GameContext b;
+    start_snapshot_game(a);
+    start_snapshot_game(b);
+    GameSnapshot snapshot;
+    for (uint64_t tick = 0; tick < 1500; ++tick) {
+        apply_input_keys(a, snapshot_route_keys(tick));
+        apply_input_keys(b, snapshot_route_keys(tick));
+        if (tick == 777) {
+            b.score_bytes[0] = static_cast<uint8_t>(b.score_bytes[0] + 1);  // The "bug"
+        }
+        run_gameplay_tick(a);
+        run_gameplay_tick(b);
+        capture_snapshot(a, snapshot);
+        reference.push(tick, snapshot);
+        capture_snapshot(b, snapshot);
+        diverged.push(tick, snapshot);
+    }
+
+    uint64_t first = 0;
+    check(SnapshotRing::find_first_difference(reference, diverged, &first) && first == 777,
+          "snapshot ring: bisection should find the first diverging tick");
+    check(!SnapshotRing::find_first_difference(reference, reference, &first),
+          "snapshot ring: a ring should not differ from itself");
+
+    GameSnapshot expected;
+    GameSnapshot actual;
+    reference.get(first, expected);
+    diverged.get(first, actual);
+    const std::vector<std::string> differences = describe_snapshot_differences(expected, actual);
+    check(differences.size() == 1 && differences[0].find("score_bytes") == 0,
+          "snapshot: differences should name the changed field");
+}
+
+void test_snapshot_rejects_corrupt_state() {
+    GameContext game;
+    start_snapshot_game(game);
+    GameSnapshot snapshot;
+    capture_snapshot(game, snapshot);
+    std::vector<uint8_t> bytes = snapshot.encode();
+
+    GameSnapshot decoded;
+    std::vector<uint8_t> bad_magic = bytes;
+    bad_magic[0] = 'X';
+    check(!decoded.decode(bad_magic.data(), bad_magic.size()), "snapshot: wrong magic should be rejected");
+    std::vector<uint8_t> bad_size = bytes;
+    bad_size[5] = static_cast<uint8_t>(bad_size[5] ^ 0x01);
+    check(!decoded.decode(bad_size.data(), bad_size.size()), "snapshot: another state layout should be rejected");
+    std::vector<uint8_t> overrun = bytes;
+    overrun.push_back(0x7F);
+    overrun.push_back(0x7F);
+    overrun.push_back(0x7F);
+    overrun.push_back(0x7F);
+    check(!decoded.decode(overrun.data(), overrun.size()), "snapshot: a run past the end should be rejected");
+    check(!decoded.decode(bytes.data(), 3), "snapshot: truncated header should be rejected");
+}
+
+void test_snapshot_refuses_enlarged_pool() {
+    GameContext game;
+    start_snapshot_game(game);
+    run_snapshot_ticks(game, 0, 50);
+    GameSnapshot snapshot;
+    check(capture_snapshot(game, snapshot), "snapshot: the original pool should be captured");
+
+    // Enemies past MAX_NUM_ENEMIES would be lost, so neither direction works
+    GameContext enlarged;
+    enlarged.actors.set_pool_limits(MAX_NUM_ENEMIES * 2, MAX_NUM_FIREBALLS);
+    start_snapshot_game(enlarged);
+    GameSnapshot refused;
+    check(!capture_snapshot(enlarged, refused), "snapshot: a larger enemy pool should not be captured");
+    check(refused == GameSnapshot(), "snapshot: a refused capture should leave the snapshot cleared");
+    const uint64_t before = gameplay_checksum(enlarged);
+    check(!restore_snapshot(enlarged, snapshot), "snapshot: a larger enemy pool should not be restored");
+    check(gameplay_checksum(enlarged) == before, "snapshot: a refused restore should leave the game as it is");
+
+    enlarged.actors.set_pool_limits(MAX_NUM_ENEMIES, MAX_NUM_FIREBALLS * 2);
+    check(!capture_snapshot(enlarged, refused), "snapshot: a larger fireball pool should not be captured");
+}
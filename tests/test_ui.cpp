@@ -1,5 +1,6 @@
 #include "test_helpers.h"
 #include "test_cases.h"
+#include <array>
 
 void test_ui_score_base100_encoding() {
     reset_physics_state();
@@ -138,61 +139,101 @@ void test_ui_meter_all_states() {
 }
 
 static void reset_score_bytes() {
-    score_bytes[0] = 0;
-    score_bytes[1] = 0;
-    score_bytes[2] = 0;
+    test_game.score_bytes[0] = 0;
+    test_game.score_bytes[1] = 0;
+    test_game.score_bytes[2] = 0;
+}
+
+void test_ui_hud_state_change_detection() {
+    reset_physics_state();
+    const uint8_t score[3] = {12, 34, 0};
+    const HudState base = UISystem::make_hud_state(
+        score, 3, 6, 12, 0, false, false, false, false, false, false, false, 4, 0);
+    const HudState same = UISystem::make_hud_state(
+        score, 3, 6, 12, 0, false, false, false, false, false, false, false, 4, 0);
+    check(base == same, "ui_hud_state: identical inputs should compare equal");
+
+    // Empty inventory: the blink frame has nothing to animate
+    const HudState next_tick = UISystem::make_hud_state(
+        score, 3, 6, 12, 0, false, false, false, false, false, false, false, 4, 1);
+    check(base == next_tick, "ui_hud_state: animation tick without items should not redraw");
+
+    const uint8_t bumped_score[3] = {13, 34, 0};
+    check(base != UISystem::make_hud_state(
+              bumped_score, 3, 6, 12, 0, false, false, false, false, false, false, false, 4, 0),
+          "ui_hud_state: score change should redraw");
+    check(base != UISystem::make_hud_state(
+              score, 2, 6, 12, 0, false, false, false, false, false, false, false, 4, 0),
+          "ui_hud_state: lives change should redraw");
+    check(base != UISystem::make_hud_state(
+              score, 3, 5, 12, 0, false, false, false, false, false, false, false, 4, 0),
+          "ui_hud_state: hp change should redraw");
+    check(base != UISystem::make_hud_state(
+              score, 3, 6, 11, 0, false, false, false, false, false, false, false, 4, 0),
+          "ui_hud_state: fireball meter change should redraw");
+    check(base != UISystem::make_hud_state(
+              score, 3, 6, 12, 0, false, false, false, false, false, false, false, 5, 0),
+          "ui_hud_state: gaining boots should redraw");
+
+    // Any visible item makes the even/odd frame significant
+    const HudState key_even = UISystem::make_hud_state(
+        score, 3, 6, 12, 0, false, true, false, false, false, false, false, 4, 0);
+    const HudState key_odd = UISystem::make_hud_state(
+        score, 3, 6, 12, 0, false, true, false, false, false, false, false, 4, 1);
+    check(base != key_even, "ui_hud_state: gaining the door key should redraw");
+    check(key_even != key_odd, "ui_hud_state: inventory blink should redraw while items are shown");
 }
 
 void test_award_points_no_carry() {
     reset_physics_state();
     reset_score_bytes();
-    award_points(50);
-    check(score_bytes[0] == 50 && score_bytes[1] == 0 && score_bytes[2] == 0,
+    award_points(test_game, 50);
+    check(test_game.score_bytes[0] == 50 && test_game.score_bytes[1] == 0 && test_game.score_bytes[2] == 0,
           "award_points: simple add no carry should be 50,0,0");
 }
 
 void test_award_points_accumulates_in_byte0() {
     reset_physics_state();
     reset_score_bytes();
-    award_points(20);
-    award_points(30);
-    check(score_bytes[0] == 50 && score_bytes[1] == 0 && score_bytes[2] == 0,
+    award_points(test_game, 20);
+    award_points(test_game, 30);
+    check(test_game.score_bytes[0] == 50 && test_game.score_bytes[1] == 0 && test_game.score_bytes[2] == 0,
           "award_points: accumulation in byte 0 should be 50");
 }
 
 void test_award_points_carry_into_byte1() {
     reset_physics_state();
     reset_score_bytes();
-    award_points(80);
-    award_points(40);
+    award_points(test_game, 80);
+    award_points(test_game, 40);
     // 80+40 = 120 = 20 + 1*100
-    check(score_bytes[0] == 20 && score_bytes[1] == 1 && score_bytes[2] == 0,
+    check(test_game.score_bytes[0] == 20 && test_game.score_bytes[1] == 1 && test_game.score_bytes[2] == 0,
           "award_points: carry into byte 1 should be 20,1,0");
 }
 
 void test_award_points_full_carry_amount() {
     reset_physics_state();
     reset_score_bytes();
-    award_points(150);
-    check(score_bytes[0] == 50 && score_bytes[1] == 1 && score_bytes[2] == 0,
+    award_points(test_game, 150);
+    check(test_game.score_bytes[0] == 50 && test_game.score_bytes[1] == 1 && test_game.score_bytes[2] == 0,
           "award_points: 150 points should carry to 50,1,0");
 }
 
 void test_award_points_large_value_above_255() {
     reset_physics_state();
     reset_score_bytes();
-    award_points(350);
-    check(score_bytes[0] == 50 && score_bytes[1] == 3 && score_bytes[2] == 0,
+    award_points(test_game, 350);
+    check(test_game.score_bytes[0] == 50 && test_game.score_bytes[1] == 3 && test_game.score_bytes[2] == 0,
           "award_points: 350 points should be 50,3,0");
 }
 
 void test_award_points_max_score_saturation() {
     reset_physics_state();
-    score_bytes[0] = 90;
-    score_bytes[1] = 99;
-    score_bytes[2] = 99;
-    award_points(20); // Should hit 999999
-    check(score_bytes[0] == 99 && score_bytes[1] == 99 && score_bytes[2] == 99,
+    test_game.score_bytes[0] = 90;
+    test_game.score_bytes[1] = 99;
+    test_game.score_bytes[2] = 99;
+    award_points(test_game, 20); // Should hit 999999
+    check(test_game.score_bytes[0] == 99 && test_game.score_bytes[1] == 99 && test_game.score_bytes[2] == 99,
           "award_points: should saturate at 99,99,99");
 }
 
@@ -200,47 +241,47 @@ void test_award_points_large_carry_saturation() {
     reset_physics_state();
     // Large carry against a full top byte must saturate to max score.
     reset_score_bytes();
-    score_bytes[0] = 99;
-    score_bytes[1] = 99;
-    score_bytes[2] = 99;
-    award_points(300);
-    check(score_bytes[0] == 99 && score_bytes[1] == 99 && score_bytes[2] == 99,
+    test_game.score_bytes[0] = 99;
+    test_game.score_bytes[1] = 99;
+    test_game.score_bytes[2] = 99;
+    award_points(test_game, 300);
+    check(test_game.score_bytes[0] == 99 && test_game.score_bytes[1] == 99 && test_game.score_bytes[2] == 99,
           "award_points: massive award should saturate at max");
 }
 
 void test_award_points_awards_extra_life_every_50000() {
     reset_physics_state();
-    score_bytes[0] = 99;
-    score_bytes[1] = 99;
-    score_bytes[2] = 0;
-    score_10000_counter = 4;
-    comic_num_lives = 2;
+    test_game.score_bytes[0] = 99;
+    test_game.score_bytes[1] = 99;
+    test_game.score_bytes[2] = 0;
+    test_game.score_10000_counter = 4;
+    test_game.comic_num_lives = 2;
 
     // This causes carry into the ten-thousands byte and should roll
     // score_10000_counter 4->5->0, awarding one life.
-    award_points(1);
+    award_points(test_game, 1);
 
-    check(score_bytes[0] == 0 && score_bytes[1] == 0 && score_bytes[2] == 1,
+    check(test_game.score_bytes[0] == 0 && test_game.score_bytes[1] == 0 && test_game.score_bytes[2] == 1,
           "award_points_50000: score should carry into ten-thousands byte");
-    check(score_10000_counter == 0,
+    check(test_game.score_10000_counter == 0,
           "award_points_50000: score_10000_counter should reset after extra life award");
-    check(comic_num_lives == 3,
+    check(test_game.comic_num_lives == 3,
           "award_points_50000: extra life should be awarded every 50000 points");
 }
 
 void test_award_points_awards_extra_life_after_500_internal_units() {
     reset_physics_state();
-    comic_num_lives = 2;
+    test_game.comic_num_lives = 2;
 
     for (int i = 0; i < 5; i++) {
-        award_points(100);
+        award_points(test_game, 100);
     }
 
-    check(score_bytes[0] == 0 && score_bytes[1] == 5 && score_bytes[2] == 0,
+    check(test_game.score_bytes[0] == 0 && test_game.score_bytes[1] == 5 && test_game.score_bytes[2] == 0,
           "award_points_500_internal: score should reach 500 internal units");
-    check(score_10000_counter == 0,
+    check(test_game.score_10000_counter == 0,
           "award_points_500_internal: counter should reset after 500 internal units");
-    check(comic_num_lives == 3,
+    check(test_game.comic_num_lives == 3,
           "award_points_500_internal: extra life should trigger at 500 internal units");
 }
 
@@ -275,3 +316,35 @@ void test_high_score_bytes_conversion() {
     check(score_bytes_to_uint32(s6) == 200u,
           "high_score: bytes={0,2,0} should be 200");
 }
+
+void test_title_fade_layers_split() {
+    // 3x2 indexed image with a padded pitch: indices 0, 2, 10 / 12, 5, 40
+    const uint8_t pixels[2][4] = {{0, 2, 10, 99}, {12, 5, 40, 99}};
+    SDL_Color palette[16] = {};
+    for (int i = 0; i < 16; ++i) {
+        palette[i] = {static_cast<uint8_t>(i * 10), static_cast<uint8_t>(i * 10 + 1),
+                      static_cast<uint8_t>(i * 10 + 2), 255};
+    }
+    const uint8_t registers[FADE_REGISTER_COUNT] = {2, 10, 12};
+    PaletteFadeLayers layers;
+    split_palette_fade_layers(&pixels[0][0], 3, 2, 4, palette, 16, registers, &layers);
+
+    check(layers.base.size() == 3 * 2 * 4, "title_fade: the base should hold RGBA32 for every pixel");
+    auto pixel = [](const std::vector<uint8_t>& rgba, int index) {
+        return std::array<uint8_t, 4>{rgba[index * 4], rgba[index * 4 + 1], rgba[index * 4 + 2], rgba[index * 4 + 3]};
+    };
+    check((pixel(layers.base, 4) == std::array<uint8_t, 4>{50, 51, 52, 255}),
+          "title_fade: other registers should keep their palette color in the base");
+    check((pixel(layers.base, 1) == std::array<uint8_t, 4>{0, 0, 0, 255}) &&
+          (pixel(layers.base, 3) == std::array<uint8_t, 4>{0, 0, 0, 255}),
+          "title_fade: fading registers should be black in the base");
+    check((pixel(layers.base, 5) == std::array<uint8_t, 4>{0, 0, 0, 255}),
+          "title_fade: indices outside the palette should be black");
+    check((pixel(layers.masks[0], 1) == std::array<uint8_t, 4>{255, 255, 255, 255}) &&
+          (pixel(layers.masks[1], 2) == std::array<uint8_t, 4>{255, 255, 255, 255}) &&
+          (pixel(layers.masks[2], 3) == std::array<uint8_t, 4>{255, 255, 255, 255}),
+          "title_fade: each mask should be opaque white on its register");
+    check(pixel(layers.masks[0], 2)[3] == 0 && pixel(layers.masks[1], 1)[3] == 0 &&
+          pixel(layers.masks[2], 0)[3] == 0,
+          "title_fade: masks should be clear on every other pixel");
+}
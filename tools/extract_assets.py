@@ -15,6 +15,8 @@ Usage:
 
     ./tools/extract_assets.py --orig original
 
+    ./tools/extract_assets.py --orig original --pack [--pack-rgba]
+
 The output layout mirrors the existing `deriv/R5sw1991` tree:
 
     assets/
@@ -24,6 +26,7 @@ The output layout mirrors the existing `deriv/R5sw1991` tree:
         maps/           (base0.pt.png, ...)
         sounds/         (sound-*.wav)
         tiles/          (tt2 tiles as PNGs)
+        assets.pak      (with --pack: every PNG above in one indexed file)
 
 Currently the script only knows about R5sw1991; the metadata is hard-coded
 but structured so additional versions can be added later.
@@ -904,6 +907,94 @@ def extract_maps(exe_data, orig_dir, out_dir):
                 continue
             im.save(dest)
 
+# -----------------------------------------------------------------------------
+# asset pack (see include/asset_pack.h for the layout)
+# -----------------------------------------------------------------------------
+
+PACK_MAGIC = b"CCPK"
+PACK_VERSION = 1
+PACK_FORMAT_RAW = 0
+PACK_FORMAT_RGBA32 = 1
+PACK_HEADER = struct.Struct("<4sIII")
+PACK_ENTRY = struct.Struct("<QQIIHHHH")
+PACK_ALIGN = 16
+
+# Subdirectories whose images may be stored pre-decoded.  Full-screen images
+# (graphics/) stay PNG because the title sequence relies on their palettes.
+PACK_RGBA_DIRS = ("tiles", "sprites", "shp")
+
+
+def fnv1a64(data: bytes) -> int:
+    h = 0xcbf29ce484222325
+    for b in data:
+        h ^= b
+        h = (h * 0x100000001b3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def write_asset_pack(out_root: str, pack_path: str, rgba: bool = False) -> int:
+    """Bundle every PNG under out_root into one pack file keyed by file name.
+
+    Returns the number of entries written.  With rgba=True, tiles, sprites
+    and shp frames are stored as raw RGBA pixels so the game can upload them
+    without decoding.
+    """
+    entries = []  # (hash, name, format, width, height, data)
+    seen = {}
+    for dirpath, _dirnames, filenames in sorted(os.walk(out_root)):
+        for fname in sorted(filenames):
+            if not fname.lower().endswith(".png"):
+                continue
+            if fname in seen:
+                raise ValueError(f"duplicate asset name {fname!r} in "
+                                 f"{seen[fname]} and {dirpath}")
+            seen[fname] = dirpath
+            path = os.path.join(dirpath, fname)
+            subdir = os.path.basename(dirpath)
+            fmt, width, height = PACK_FORMAT_RAW, 0, 0
+            if rgba and subdir in PACK_RGBA_DIRS:
+                with Image.open(path) as im:
+                    rgba_im = im.convert("RGBA")
+                    width, height = rgba_im.size
+                    data = rgba_im.tobytes()
+                fmt = PACK_FORMAT_RGBA32
+            else:
+                with open(path, "rb") as f:
+                    data = f.read()
+                with Image.open(io.BytesIO(data)) as im:
+                    width, height = im.size
+            name = fname.encode("utf-8")
+            entries.append((fnv1a64(name), name, fmt, width, height, data))
+
+    entries.sort(key=lambda e: (e[0], e[1]))
+
+    names_offset = PACK_HEADER.size + PACK_ENTRY.size * len(entries)
+    name_offsets = []
+    cursor = names_offset
+    for entry in entries:
+        name_offsets.append(cursor)
+        cursor += len(entry[1])
+
+    data_offsets = []
+    for entry in entries:
+        cursor = (cursor + PACK_ALIGN - 1) // PACK_ALIGN * PACK_ALIGN
+        data_offsets.append(cursor)
+        cursor += len(entry[5])
+
+    os.makedirs(os.path.dirname(os.path.abspath(pack_path)), exist_ok=True)
+    with open(pack_path, "wb") as f:
+        f.write(PACK_HEADER.pack(PACK_MAGIC, PACK_VERSION, len(entries), 0))
+        for entry, name_off, data_off in zip(entries, name_offsets, data_offsets):
+            h, name, fmt, width, height, data = entry
+            f.write(PACK_ENTRY.pack(h, data_off, len(data), name_off, len(name),
+                                    fmt, width, height))
+        for entry in entries:
+            f.write(entry[1])
+        for entry, data_off in zip(entries, data_offsets):
+            f.write(b"\0" * (data_off - f.tell()))
+            f.write(entry[5])
+    return len(entries)
+
 # -----------------------------------------------------------------------------
 # update main() to call the new routines
 # -----------------------------------------------------------------------------
@@ -923,6 +1014,12 @@ def main():
                         help="force regeneration of output files")
     parser.add_argument("--clean", action="store_true",
                         help="remove existing output directory before extracting")
+    parser.add_argument("--pack", nargs="?", const="", default=None, metavar="PATH",
+                        help="also bundle the extracted images into one asset pack "
+                             "(default PATH: <out>/assets.pak)")
+    parser.add_argument("--pack-rgba", action="store_true",
+                        help="store tiles, sprites and shp frames in the pack as "
+                             "pre-decoded RGBA instead of PNG")
     args = parser.parse_args()
 
     global FORCE
@@ -987,6 +1084,12 @@ def main():
     print("Extracting shp files...")
     extract_shp(orig_dir, exe_data, os.path.join(out_root, "shp"))
 
+    if args.pack is not None:
+        pack_path = args.pack or os.path.join(out_root, "assets.pak")
+        print(f"Writing asset pack {pack_path}...")
+        count = write_asset_pack(out_root, pack_path, rgba=args.pack_rgba)
+        print(f"  {count} entries")
+
 
 if __name__ == "__main__":
     main()
@@ -221,5 +221,43 @@ class ExtractAssetsTest(unittest.TestCase):
             self.assertEqual(entry["height"], 16, f"{name} height should be 16")
             self.assertTrue(entry["mask"], f"{name} should use mask data")
 
+    def test_write_asset_pack_index(self):
+        mod = self.extract_mod
+        # FNV-1a 64 must match asset_pack_hash() in src/asset_pack.cpp
+        self.assertEqual(mod.fnv1a64(b"a"), 0xaf63dc4c8601ec8c)
+
+        os.makedirs(os.path.join(self.outdir, "tiles"))
+        os.makedirs(os.path.join(self.outdir, "graphics"))
+        Image.new("RGBA", (16, 16), (255, 0, 0, 255)).save(
+            os.path.join(self.outdir, "tiles", "lake.tt2-00.png"))
+        Image.new("P", (4, 2)).save(
+            os.path.join(self.outdir, "graphics", "sys000.ega.png"))
+
+        pack = os.path.join(self.outdir, "assets.pak")
+        self.assertEqual(mod.write_asset_pack(self.outdir, pack, rgba=True), 2)
+        with open(pack, "rb") as f:
+            blob = f.read()
+
+        magic, version, count, _ = mod.PACK_HEADER.unpack_from(blob, 0)
+        self.assertEqual((magic, version, count), (b"CCPK", 1, 2))
+        entries = {}
+        hashes = []
+        for i in range(count):
+            h, data_off, size, name_off, name_len, fmt, w, hgt = mod.PACK_ENTRY.unpack_from(
+                blob, mod.PACK_HEADER.size + i * mod.PACK_ENTRY.size)
+            name = blob[name_off:name_off + name_len]
+            self.assertEqual(h, mod.fnv1a64(name))
+            self.assertEqual(data_off % mod.PACK_ALIGN, 0)
+            hashes.append(h)
+            entries[name] = (fmt, w, hgt, blob[data_off:data_off + size])
+        self.assertEqual(hashes, sorted(hashes))
+
+        fmt, w, hgt, data = entries[b"lake.tt2-00.png"]
+        self.assertEqual((fmt, w, hgt), (mod.PACK_FORMAT_RGBA32, 16, 16))
+        self.assertEqual(data[:4], bytes([255, 0, 0, 255]))
+        fmt, w, hgt, data = entries[b"sys000.ega.png"]
+        self.assertEqual((fmt, w, hgt), (mod.PACK_FORMAT_RAW, 4, 2))
+        self.assertEqual(data[:8], b"\x89PNG\r\n\x1a\n")
+
 if __name__ == "__main__":
     unittest.main()